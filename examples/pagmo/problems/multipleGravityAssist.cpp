@@ -56,26 +56,52 @@ void MultipleGravityAssist::getDecomposedDecisionVector(
 //! Implementation of the fitness function (return delta-v)
 std::vector<double> MultipleGravityAssist::fitness( const std::vector<double> &xv ) const
 {
-    std::vector< double > currentNodeTimes_;
-    std::vector< Eigen::VectorXd > currentLegFreeParameters_;
-    std::vector< Eigen::VectorXd > currentNodeFreeParameters_;
-
-    getDecomposedDecisionVector(
-                tudat::utilities::convertStlVectorToEigenVector( xv ),
-                currentNodeTimes_, currentLegFreeParameters_, currentNodeFreeParameters_ );
-    if( transferTrajectory_ != nullptr )
-    {
-        transferTrajectory_->evaluateTrajectory(
-                    currentNodeTimes_, currentLegFreeParameters_,currentNodeFreeParameters_ );
-    }
-    else
+    // Create trajectory on first call (with separate environment if possible, since the environment is shared by copies)
+    if( transferTrajectory_ == nullptr )
     {
         transferTrajectory_ = createTransferTrajectory(
-                    bodyMap_, legSettings_, nodeSettings_, nodeIds_, centralBody_,
-                    currentNodeTimes_, currentLegFreeParameters_, currentNodeFreeParameters_);
+                    ( bodiesCreationFunction_ == nullptr ) ? bodyMap_ : bodiesCreationFunction_( ),
+                    legSettings_, nodeSettings_, nodeIds_, centralBody_ );
     }
 
+    // Convert start date and times of flight from days to seconds
+    Eigen::VectorXd trajectoryParameters = tudat::utilities::convertStlVectorToEigenVector( xv );
+    trajectoryParameters.segment( 0, numberOfNodes_ ) *= tudat::physical_constants::JULIAN_DAY;
+
+    transferTrajectory_->evaluateTrajectory( trajectoryParameters );
     return { transferTrajectory_->getTotalDeltaV( ) };
 }
 
+//! Implementation of the batch fitness function (return delta-v of each individual)
+std::vector<double> MultipleGravityAssist::batch_fitness( const std::vector<double> &xs ) const
+{
+    if( bodiesCreationFunction_ == nullptr )
+    {
+        std::vector< double > fitnesses;
+        unsigned int numberOfParameters = problemBounds_.at( 0 ).size( );
+        for( unsigned int i = 0; i < xs.size( ) / numberOfParameters; i++ )
+        {
+            fitnesses.push_back( fitness( std::vector< double >(
+                                              xs.begin( ) + i * numberOfParameters,
+                                              xs.begin( ) + ( i + 1 ) * numberOfParameters ) ).at( 0 ) );
+        }
+        return fitnesses;
+    }
 
+    // Create trajectory (with separate environment) for each thread on first call
+    if( transferTrajectoriesPerThread_.size( ) == 0 )
+    {
+        transferTrajectoriesPerThread_ = createTransferTrajectoriesPerThread(
+                    bodiesCreationFunction_, legSettings_, nodeSettings_, nodeIds_, centralBody_, numberOfThreads_ );
+    }
+
+    // Map concatenated decision vectors to matrix with one column per individual
+    unsigned int numberOfParameters = problemBounds_.at( 0 ).size( );
+    Eigen::MatrixXd trajectoryParameters = Eigen::Map< const Eigen::MatrixXd >(
+                xs.data( ), numberOfParameters, xs.size( ) / numberOfParameters );
+    trajectoryParameters.topRows( numberOfNodes_ ) *= tudat::physical_constants::JULIAN_DAY;
+
+    Eigen::VectorXd totalDeltaV;
+    evaluateTransferTrajectoryPopulation( transferTrajectoriesPerThread_, trajectoryParameters, totalDeltaV );
+    return std::vector< double >( totalDeltaV.data( ), totalDeltaV.data( ) + totalDeltaV.size( ) );
+}
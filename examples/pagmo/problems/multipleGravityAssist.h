@@ -11,7 +11,7 @@
 #ifndef TUDAT_EXAMPLE_PAGMO_MULTIPLE_GRAVITY_ASSIST_H
 #define TUDAT_EXAMPLE_PAGMO_MULTIPLE_GRAVITY_ASSIST_H
 
-#include <tudat/simulation/environment/body.h>
+#include <tudat/simulation/environment_setup/body.h>
 #include <tudat/astro/mission_segments/createTransferTrajectory.h>
 
 typedef Eigen::Matrix< double, 6, 1 > StateType;
@@ -34,9 +34,12 @@ struct MultipleGravityAssist
             const std::vector< std::shared_ptr< TransferNodeSettings > >& nodeSettings,
             const std::vector< std::string >& nodeIds,
             const std::string& centralBody,
-            const std::vector< std::vector< double > > problemBounds_ ):
+            const std::vector< std::vector< double > > problemBounds_,
+            const std::function< SystemOfBodies( ) > bodiesCreationFunction = nullptr,
+            const unsigned int numberOfThreads = 1 ):
         bodyMap_( bodyMap ), legSettings_( legSettings ), nodeSettings_( nodeSettings ),
-        nodeIds_( nodeIds ), centralBody_( centralBody ), problemBounds_( problemBounds_ )
+        nodeIds_( nodeIds ), centralBody_( centralBody ), problemBounds_( problemBounds_ ),
+        bodiesCreationFunction_( bodiesCreationFunction ), numberOfThreads_( numberOfThreads )
     {
         numberOfNodes_ = nodeIds_.size( );
 
@@ -44,6 +47,19 @@ struct MultipleGravityAssist
                legSettings_,  nodeSettings_, legParameterIndices_, nodeParameterIndices_ );
     }
 
+    // Copy constructor. The transfer trajectories (which store the evaluated trajectory) are not copied, but created
+    // by each copy on its first evaluation, so that copies made by pagmo (e.g. for each island) can be evaluated
+    // concurrently
+    MultipleGravityAssist( const MultipleGravityAssist& otherProblem ):
+        bodyMap_( otherProblem.bodyMap_ ), legSettings_( otherProblem.legSettings_ ),
+        nodeSettings_( otherProblem.nodeSettings_ ), nodeIds_( otherProblem.nodeIds_ ),
+        centralBody_( otherProblem.centralBody_ ), problemBounds_( otherProblem.problemBounds_ ),
+        nodeParameterIndices_( otherProblem.nodeParameterIndices_ ),
+        legParameterIndices_( otherProblem.legParameterIndices_ ), numberOfNodes_( otherProblem.numberOfNodes_ ),
+        bodiesCreationFunction_( otherProblem.bodiesCreationFunction_ ),
+        numberOfThreads_( otherProblem.numberOfThreads_ ),
+        transferTrajectory_( nullptr ), transferTrajectoriesPerThread_( ){ }
+
     void getDecomposedDecisionVector(
             const Eigen::VectorXd rawDecisionVariables,
             std::vector< double >& currentNodeTimes,
@@ -53,6 +69,15 @@ struct MultipleGravityAssist
     // Calculates the fitness
     std::vector< double > fitness( const std::vector< double > &x ) const;
 
+    // Calculates the fitness of a population (concatenated decision vectors), distributed over numberOfThreads_ threads
+    // if a bodiesCreationFunction_ is provided
+    std::vector< double > batch_fitness( const std::vector< double > &xs ) const;
+
+    bool has_batch_fitness( ) const
+    {
+        return true;
+    }
+
     std::pair< std::vector< double >, std::vector< double > > get_bounds() const;
 
     std::string get_name( ) const;
@@ -82,7 +107,13 @@ private:
 
     unsigned int numberOfNodes_;
 
+    std::function< SystemOfBodies( ) > bodiesCreationFunction_;
+
+    unsigned int numberOfThreads_;
+
     mutable std::shared_ptr< TransferTrajectory > transferTrajectory_;
+
+    mutable std::vector< std::shared_ptr< TransferTrajectory > > transferTrajectoriesPerThread_;
 };
 
 #endif // TUDAT_EXAMPLE_PAGMO_MULTIPLE_GRAVITY_ASSIST_H
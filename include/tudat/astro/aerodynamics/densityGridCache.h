@@ -0,0 +1,270 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_DENSITY_GRID_CACHE_H
+#define TUDAT_DENSITY_GRID_CACHE_H
+
+#include <functional>
+#include <vector>
+
+#include "tudat/math/basic/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace aerodynamics
+{
+
+//! Types of interpolation that can be used to reconstruct the density from a DensityGridCache
+enum DensityGridInterpolationType
+{
+    linear_density_grid_interpolation,
+    cubic_density_grid_interpolation
+};
+
+//! Settings for a grid of precomputed atmospheric densities (see DensityGridCache)
+struct DensityGridCacheSettings
+{
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param minimumAltitude Lowest altitude of the grid [m]
+     *  \param maximumAltitude Highest altitude of the grid [m]
+     *  \param numberOfAltitudePoints Number of (equidistant) altitude grid points
+     *  \param numberOfLocalSolarTimePoints Number of (equidistant) local solar time grid points in [0,24) hours
+     *  \param numberOfLatitudePoints Number of (equidistant) latitude grid points in [-90,90] degrees
+     *  \param interpolationType Type of interpolation (in each of the three grid directions) of the logarithm of the density
+     *  \param maximumRelativeError Maximum allowed (estimated) relative interpolation error of the density (see
+     *  DensityGridCache::computeGrid); not checked if NaN.
+     *  \param inputUpdateInterval Interval (in seconds, starting at 0h UT) at which the atmosphere model input (e.g. solar
+     *  and geomagnetic activity) is checked for changes, after which the grid is recomputed if the input has changed.
+     *  \param numberOfErrorSamples Number of points at which the interpolated density is compared to the model density to
+     *  estimate the maximum interpolation error (see DensityGridCache::computeGrid); if 0, the number of grid cells is
+     *  used.
+     */
+    DensityGridCacheSettings(
+            const double minimumAltitude,
+            const double maximumAltitude,
+            const int numberOfAltitudePoints,
+            const int numberOfLocalSolarTimePoints = 24,
+            const int numberOfLatitudePoints = 37,
+            const DensityGridInterpolationType interpolationType = cubic_density_grid_interpolation,
+            const double maximumRelativeError = TUDAT_NAN,
+            const double inputUpdateInterval = 3.0 * 3600.0,
+            const int numberOfErrorSamples = 0 ):
+        minimumAltitude( minimumAltitude ), maximumAltitude( maximumAltitude ),
+        numberOfAltitudePoints( numberOfAltitudePoints ), numberOfLocalSolarTimePoints( numberOfLocalSolarTimePoints ),
+        numberOfLatitudePoints( numberOfLatitudePoints ), interpolationType( interpolationType ),
+        maximumRelativeError( maximumRelativeError ), inputUpdateInterval( inputUpdateInterval ),
+        numberOfErrorSamples( numberOfErrorSamples ){ }
+
+    //! Lowest altitude of the grid [m]
+    double minimumAltitude;
+
+    //! Highest altitude of the grid [m]
+    double maximumAltitude;
+
+    //! Number of (equidistant) altitude grid points
+    int numberOfAltitudePoints;
+
+    //! Number of (equidistant) local solar time grid points in [0,24) hours
+    int numberOfLocalSolarTimePoints;
+
+    //! Number of (equidistant) latitude grid points in [-90,90] degrees
+    int numberOfLatitudePoints;
+
+    //! Type of interpolation of the logarithm of the density
+    DensityGridInterpolationType interpolationType;
+
+    //! Maximum allowed (estimated) relative interpolation error of the density (not checked if NaN)
+    double maximumRelativeError;
+
+    //! Interval (in seconds, starting at 0h UT) at which the atmosphere model input is checked for changes
+    double inputUpdateInterval;
+
+    //! Number of points used to estimate the maximum interpolation error (number of grid cells if 0)
+    int numberOfErrorSamples;
+};
+
+//! Function to compute an element of the Halton sequence (low-discrepancy sequence in [0,1))
+/*!
+ *  Function to compute an element of the Halton sequence (low-discrepancy sequence in [0,1)), i.e. the radical inverse of
+ *  the index in the given base. Sequences with different (prime) bases are used for different dimensions.
+ *  \param index Index of the element
+ *  \param base Base of the sequence (typically a prime number)
+ *  \return Element of the Halton sequence
+ */
+double getHaltonSequenceElement( int index, const int base );
+
+//! Class for a grid of precomputed atmospheric densities, as a function of altitude, local solar time and latitude
+/*!
+ *  Class for a grid of precomputed atmospheric densities, as a function of altitude, local solar time and latitude, from
+ *  which the density is reconstructed by (tri-)linear or (tri-)cubic interpolation of the logarithm of the density. The
+ *  grid is equidistant in each direction, so that the grid cell of an evaluation point is found without a search, and is
+ *  periodic in local solar time. It is used to replace the evaluation of an expensive empirical atmosphere model (e.g.
+ *  NRLMSISE00Atmosphere) by an interpolation, for a fixed solar and geomagnetic activity. The grid is computed at a single
+ *  epoch, and may be used during a time interval around it. When computing the grid, the maximum error is estimated by
+ *  comparing the interpolated density to the model density at a set of quasi-random (Halton sequence) points, which
+ *  cover the interior of the grid cells, and the time interval in which the grid is used. Since the error is sampled,
+ *  the true maximum error may (slightly) exceed this estimate.
+ */
+class DensityGridCache
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor, checks the settings, but does not yet compute the grid (see computeGrid).
+     *  \param settings Settings for the grid
+     */
+    DensityGridCache( const DensityGridCacheSettings& settings );
+
+    //! Function to (re)compute the density at all grid points
+    /*!
+     *  Function to (re)compute the density at all grid points from a density model, and estimate the maximum relative
+     *  error. The grid points are computed at a time offset of 0. The error is estimated from the model density at a
+     *  number of quasi-random points (see DensityGridCacheSettings::numberOfErrorSamples), distributed over the altitude,
+     *  local solar time and latitude range of the grid, and over the time offsets at which the grid is used, so that both
+     *  the interpolation error and the error due to the variation of the model at constant local solar time are included.
+     *  An exception is thrown if the estimated error exceeds the maximum relative error given in the settings.
+     *  \param densityFunction Function returning the density [kg/m^3] as a function of altitude [m], local solar time
+     *  [hours], latitude [rad] and time offset [s] w.r.t. the epoch at which the grid is computed.
+     *  \param timeOffsetRange Length of the time interval (centered on a time offset of 0) in which the grid is used [s]
+     */
+    void computeGrid(
+            const std::function< double( const double, const double, const double, const double ) >& densityFunction,
+            const double timeOffsetRange );
+
+    //! Function to (re)compute the density at all grid points, for a density model that does not depend on time
+    /*!
+     *  Function to (re)compute the density at all grid points, for a density model that does not depend on time (at
+     *  constant local solar time), and estimate the maximum relative interpolation error (see other overload).
+     *  \param densityFunction Function returning the density [kg/m^3] as a function of altitude [m], local solar time
+     *  [hours] and latitude [rad].
+     */
+    void computeGrid( const std::function< double( const double, const double, const double ) >& densityFunction );
+
+    //! Function to check whether an altitude is inside the grid
+    /*!
+     *  Function to check whether an altitude is inside the grid
+     *  \param altitude Altitude that is to be checked [m]
+     *  \return True if the altitude is inside the grid
+     */
+    bool isAltitudeInGrid( const double altitude ) const
+    {
+        return ( altitude >= settings_.minimumAltitude && altitude <= settings_.maximumAltitude );
+    }
+
+    //! Function to interpolate the density from the grid
+    /*!
+     *  Function to interpolate the density from the grid. The grid must have been computed, and the altitude must be
+     *  inside the grid (not checked by this function).
+     *  \param altitude Altitude [m]
+     *  \param localSolarTime Local solar time [hours] (any value; is wrapped to [0,24) )
+     *  \param latitude Latitude [rad]
+     *  \return Interpolated density [kg/m^3]
+     */
+    double getDensity( const double altitude, const double localSolarTime, const double latitude ) const;
+
+    //! Function to retrieve the estimated maximum relative error of the density, determined when computing the grid
+    /*!
+     *  Function to retrieve the estimated maximum relative error of the density, determined when computing the grid (as
+     *  the maximum error at the sample points, see computeGrid)
+     *  \return Estimated maximum relative error of the density
+     */
+    double getEstimatedMaximumRelativeError( ) const
+    {
+        return estimatedMaximumRelativeError_;
+    }
+
+    //! Function to check whether the grid has been computed
+    /*!
+     *  Function to check whether the grid has been computed
+     *  \return True if the grid has been computed
+     */
+    bool isGridComputed( ) const
+    {
+        return ( logarithmOfDensity_.size( ) > 0 );
+    }
+
+    //! Function to retrieve the number of times the grid has been computed
+    /*!
+     *  Function to retrieve the number of times the grid has been computed
+     *  \return Number of times the grid has been computed
+     */
+    unsigned int getNumberOfGridComputations( ) const
+    {
+        return numberOfGridComputations_;
+    }
+
+    //! Function to retrieve the settings for the grid
+    /*!
+     *  Function to retrieve the settings for the grid
+     *  \return Settings for the grid
+     */
+    const DensityGridCacheSettings& getSettings( ) const
+    {
+        return settings_;
+    }
+
+private:
+
+    //! Function to compute the interpolation of the logarithm of the density at a (fractional) grid point
+    /*!
+     *  Function to compute the interpolation of the logarithm of the density at a (fractional) grid point
+     *  \param altitudeCoordinate Fractional index of altitude
+     *  \param localSolarTimeCoordinate Fractional index of local solar time
+     *  \param latitudeCoordinate Fractional index of latitude
+     *  \return Interpolated logarithm of the density
+     */
+    double interpolateLogarithmOfDensity( const double altitudeCoordinate,
+                                          const double localSolarTimeCoordinate,
+                                          const double latitudeCoordinate ) const;
+
+    //! Function to compute the indices and weights of the grid points used for interpolation in a single direction
+    /*!
+     *  Function to compute the indices and weights of the grid points used for interpolation in a single direction
+     *  \param coordinate Fractional index of the evaluation point
+     *  \param numberOfPoints Number of grid points in current direction
+     *  \param isPeriodic Boolean denoting whether the grid is periodic in current direction
+     *  \param indices Indices of the grid points used for interpolation (returned by reference)
+     *  \param weights Weights of the grid points used for interpolation (returned by reference)
+     *  \return Number of grid points used for interpolation
+     */
+    int getInterpolationStencil( const double coordinate, const int numberOfPoints, const bool isPeriodic,
+                                 int indices[ 4 ], double weights[ 4 ] ) const;
+
+    //! Settings for the grid
+    DensityGridCacheSettings settings_;
+
+    //! Distance between altitude grid points [m]
+    double altitudeStep_;
+
+    //! Distance between local solar time grid points [hours]
+    double localSolarTimeStep_;
+
+    //! Distance between latitude grid points [rad]
+    double latitudeStep_;
+
+    //! Logarithm of the density at each grid point, with index (altitude, local solar time, latitude) in row-major order
+    std::vector< double > logarithmOfDensity_;
+
+    //! Estimated maximum relative error of the density, determined when computing the grid
+    double estimatedMaximumRelativeError_;
+
+    //! Number of times the grid has been computed
+    unsigned int numberOfGridComputations_;
+};
+
+} // namespace aerodynamics
+
+} // namespace tudat
+
+#endif // TUDAT_DENSITY_GRID_CACHE_H
@@ -100,6 +100,8 @@ public:
      *  \param referenceLength Reference length used to non-dimensionalize aerodynamic moments.
      *  \param momentReferencePoint Reference point wrt which aerodynamic moments are calculated.
      *  \param savePressureCoefficients Boolean denoting whether to save the pressure coefficients that are computed to files
+     *  \param numberOfThreads Number of threads over which the computation of the coefficients at the independent variable
+     *  data points is distributed (0 denotes all available threads).
      */
     HypersonicLocalInclinationAnalysis(
             const std::vector< std::vector< double > >& dataPointsOfIndependentVariables,
@@ -111,7 +113,8 @@ public:
             const double referenceArea,
             const double referenceLength,
             const Eigen::Vector3d& momentReferencePoint,
-            const bool savePressureCoefficients = false );
+            const bool savePressureCoefficients = false,
+            const unsigned int numberOfThreads = 1 );
 
     //! Default destructor.
     /*!
@@ -133,7 +136,8 @@ public:
 
     //! Determine inclination angles of panels on a given part.
     /*!
-     * Determines panel inclinations for all panels on all parts for given attitude.
+     * Determines panel inclinations for all panels on all parts for given attitude, and stores them in
+     * previouslyComputedInclinations_ (if not yet computed for this attitude).
      * Outward pointing surface-normals are assumed!
      * \param angleOfAttack Angle of attack at which to determine inclination angles.
      * \param angleOfSideslip Angle of sideslip at which to determine inclination angles.
@@ -141,6 +145,50 @@ public:
     void determineInclinations( const double angleOfAttack,
                                 const double angleOfSideslip );
 
+    //! Function to reset the Mach number data points, and regenerate the aerodynamic coefficients.
+    /*!
+     * Function to reset the Mach number data points, and regenerate the aerodynamic coefficients and interpolator.
+     * The panel inclinations are only dependent on the attitude, so that those computed for the existing angle of
+     * attack and sideslip data points are reused, and only the (Mach number-dependent) pressure coefficients are
+     * recomputed.
+     * \param machNumberPoints New Mach number data points, sorted in ascending order.
+     */
+    void resetMachNumberPoints( const std::vector< double >& machNumberPoints );
+
+    //! Function to retrieve the number of attitudes for which the panel inclinations have been computed.
+    /*!
+     * Function to retrieve the number of attitudes (angle of attack and sideslip pairs) for which the panel
+     * inclinations have been computed.
+     * \return Number of attitudes for which the panel inclinations have been computed.
+     */
+    unsigned int getNumberOfComputedInclinationSets( ) const
+    {
+        return previouslyComputedInclinations_.size( );
+    }
+
+    //! Function to retrieve the number of threads over which the coefficient computation is distributed.
+    /*!
+     * Function to retrieve the number of threads over which the coefficient computation is distributed.
+     * \return Number of threads over which the coefficient computation is distributed (0 denotes all available
+     * threads).
+     */
+    unsigned int getNumberOfThreads( ) const
+    {
+        return numberOfThreads_;
+    }
+
+    //! Function to set the number of threads over which the coefficient computation is distributed.
+    /*!
+     * Function to set the number of threads over which the coefficient computation is distributed (used for
+     * subsequent calls of resetMachNumberPoints).
+     * \param numberOfThreads Number of threads over which the coefficient computation is distributed (0 denotes all
+     * available threads).
+     */
+    void setNumberOfThreads( const unsigned int numberOfThreads )
+    {
+        numberOfThreads_ = numberOfThreads;
+    }
+
     //! Get the number of vehicle parts.
     /*!
      *  Returns the number of vehicle parts.
@@ -206,11 +254,15 @@ public:
         return paneSurfaceNormalList;
     }
 
+    //! Function to retrieve the pressure coefficients of all panels at a given set of independent variables.
+    /*!
+     * Function to retrieve the pressure coefficients of all panels at a given set of independent variables. Only
+     * available if savePressureCoefficients was set to true in the constructor.
+     * \param independentVariables Array of indices of independent variables.
+     * \return Pressure coefficients of all panels, with indices part-line-point.
+     */
     std::vector< std::vector< std::vector< double > > > getPressureCoefficientList(
-            const boost::array< int, 3 > independentVariables )
-    {
-        return pressureCoefficientList_.at( independentVariables );
-    }
+            const boost::array< int, 3 > independentVariables );
 
     void clearData( )
     {
@@ -226,19 +278,11 @@ public:
         numberOfPointsPerIndependentVariables[ 2 ] = 0;
 
         isCoefficientGenerated_.resize( numberOfPointsPerIndependentVariables );
+        savedPressureCoefficients_.resize( numberOfPointsPerIndependentVariables );
 
-        for( unsigned int i = 0; i < inclination_.size( ); i++ )
-        {
-            for( unsigned int j = 0; j < inclination_.at( i ).size( ); j++ )
-            {
-                inclination_.at( i ).at( j ).clear( );
-                pressureCoefficient_.at( i ).at( j ).clear( );
-            }
-            inclination_.at( i ).clear( );
-            pressureCoefficient_.at( i ).clear( );
-        }
-        inclination_.clear( );
-        pressureCoefficient_.clear( );
+        panelSurfaceNormals_.clear( );
+        panelAreas_.clear( );
+        panelMomentArmNormalProducts_.clear( );
 
         for( unsigned int i = 0; i < selectedMethods_.size( ); i++ )
         {
@@ -265,41 +309,63 @@ private:
     //! Generate aerodynamic coefficients at a single set of independent variables.
     /*!
      * Generates aerodynamic coefficients at a single set of independent variables.
-     * Determines values and sets corresponding entry in vehicleCoefficients_ array.
+     * Determines values and sets corresponding entry in aerodynamicCoefficients_ array, computing the panel
+     * inclinations at the associated attitude first, if required.
      * \param independentVariableIndices Array of indices from lists of Mach number,
      *          angle of attack and angle of sideslip points at which to perform analysis.
      */
     void determineVehicleCoefficients( const boost::array< int, 3 > independentVariableIndices );
 
+    //! Compute aerodynamic coefficients at a single set of independent variables.
+    /*!
+     * Computes aerodynamic coefficients at a single set of independent variables, without modifying the object (so
+     * that it may be called concurrently for different independent variables). The panel inclinations at the
+     * associated attitude must have been computed (see determineInclinations).
+     * \param independentVariableIndices Array of indices from lists of Mach number,
+     *          angle of attack and angle of sideslip points at which to perform analysis.
+     * \param pressureCoefficients Pressure coefficients of the panels on each part (returned by reference)
+     * \return Force and moment coefficients of the vehicle.
+     */
+    Eigen::Vector6d computeVehicleCoefficients( const boost::array< int, 3 > independentVariableIndices,
+                                                std::vector< Eigen::VectorXd >& pressureCoefficients ) const;
+
     //! Determine aerodynamic coefficients for a single LaWGS part.
     /*!
      * Determines aerodynamic coefficients for a single LaWGS part,
-     * calls determinepressureCoefficient_ function for given vehicle part.
+     * calls determinePressureCoefficients function for given vehicle part.
      * \param partNumber Index from vehicleParts_ array for which to determine coefficients.
-     * \param independentVariableIndices Array of indices of independent variables.
+     * \param machNumber Mach number at which to perform analysis.
+     * \param inclinations Inclination angles of the panels on the part.
+     * \param pressureCoefficients Pressure coefficients of the panels on the part (returned by reference)
      * \return Force and moment coefficients for requested vehicle part.
      */
     Eigen::Vector6d determinePartCoefficients(
-            const int partNumber, const boost::array< int, 3 > independentVariableIndices );
+            const int partNumber, const double machNumber, const Eigen::VectorXd& inclinations,
+            Eigen::VectorXd& pressureCoefficients ) const;
 
     //! Determine pressure coefficients on a given part.
     /*!
      * Determines pressure coefficients on a single vehicle part.
      * Calls the updateExpansionPressures and updateCompressionPressures for given vehicle part.
      * \param partNumber Index from vehicleParts_ array for which to determine coefficients.
-     * \param independentVariableIndices Array of indices of independent variables.
+     * \param machNumber Mach number at which to perform analysis.
+     * \param inclinations Inclination angles of the panels on the part.
+     * \param pressureCoefficients Pressure coefficients of the panels on the part (returned by reference)
      */
-    void determinePressureCoefficients( const int partNumber,
-                                        const boost::array< int, 3 > independentVariableIndices );
+    void determinePressureCoefficients( const int partNumber, const double machNumber,
+                                        const Eigen::VectorXd& inclinations,
+                                        Eigen::VectorXd& pressureCoefficients ) const;
 
     //! Determine force coefficients of a part.
     /*!
      * Sums the pressure coefficients of given part and determines force coefficients from it by
      * non-dimensionalization with reference area.
      * \param partNumber Index from vehicleParts_ array for which determine coefficients.
+     * \param pressureCoefficients Pressure coefficients of the panels on the part.
      * \return Force coefficients for requested vehicle part.
      */
-    Eigen::Vector3d calculateForceCoefficients( const int partNumber );
+    Eigen::Vector3d calculateForceCoefficients( const int partNumber,
+                                                const Eigen::VectorXd& pressureCoefficients ) const;
 
     //! Determine moment coefficients of a part.
     /*!
@@ -307,27 +373,50 @@ private:
      * panels on the part. Moment arms are taken from panel centroid to momentReferencePoint. Non-
      * dimensionalization is performed by product of referenceLength and referenceArea.
      * \param partNumber Index from vehicleParts_ array for which to determine coefficients.
+     * \param pressureCoefficients Pressure coefficients of the panels on the part.
      * \return Moment coefficients for requested vehicle part.
      */
-    Eigen::Vector3d calculateMomentCoefficients( const int partNumber );
+    Eigen::Vector3d calculateMomentCoefficients( const int partNumber,
+                                                 const Eigen::VectorXd& pressureCoefficients ) const;
 
     //! Determine the compression pressure coefficients of a given part.
     /*!
-     * Sets the values of pressureCoefficient_ on given part and at given Mach number for which
+     * Sets the pressure coefficients of the panels on given part and at given Mach number for which
      * inclination > 0.
      * \param machNumber Mach number at which to perform analysis.
      * \param partNumber of part from vehicleParts_ which is to be analyzed.
+     * \param inclinations Inclination angles of the panels on the part.
+     * \param pressureCoefficients Pressure coefficients of the panels on the part (modified by reference)
      */
-    void updateCompressionPressures( const double machNumber, const int partNumber );
+    void updateCompressionPressures( const double machNumber, const int partNumber,
+                                     const Eigen::VectorXd& inclinations,
+                                     Eigen::VectorXd& pressureCoefficients ) const;
 
     //! Determine the expansion pressure coefficients of a given part.
     /*!
-     * Determine the values of pressureCoefficient_ on given part and at given Mach number for
+     * Determine the pressure coefficients of the panels on given part and at given Mach number for
      * which inclination <= 0.
      * \param machNumber Mach number at which to perform analysis.
      * \param partNumber of part from vehicleParts_ which is to be analyzed.
+     * \param inclinations Inclination angles of the panels on the part.
+     * \param pressureCoefficients Pressure coefficients of the panels on the part (modified by reference)
      */
-    void updateExpansionPressures( const double machNumber, const int partNumber );
+    void updateExpansionPressures( const double machNumber, const int partNumber,
+                                   const Eigen::VectorXd& inclinations,
+                                   Eigen::VectorXd& pressureCoefficients ) const;
+
+    //! Compute inclination angles of the panels on all parts.
+    /*!
+     * Computes inclination angles of the panels on all parts for given attitude, without modifying the object.
+     * \param angleOfAttack Angle of attack at which to determine inclination angles.
+     * \param angleOfSideslip Angle of sideslip at which to determine inclination angles.
+     * \return Inclination angles of the panels on each part.
+     */
+    std::vector< Eigen::VectorXd > computeInclinations( const double angleOfAttack,
+                                                       const double angleOfSideslip ) const;
+
+    //! Function to (re)set the size of the containers with data at each set of independent variables.
+    void resetIndependentVariableContainers( );
 
     //! Array of vehicle parts.
     /*!
@@ -335,6 +424,20 @@ private:
      */
     std::vector< std::shared_ptr< geometric_shapes::LawgsPartGeometry > > vehicleParts_;
 
+    //! Surface normals of the panels on each part.
+    /*!
+     * Surface normals of the panels on each part, with one row per panel (panel index is line index times number
+     * of panels per line plus point index), so that each component is stored contiguously.
+     */
+    std::vector< Eigen::Matrix< double, Eigen::Dynamic, 3 > > panelSurfaceNormals_;
+
+    //! Areas of the panels on each part (same panel ordering as panelSurfaceNormals_).
+    std::vector< Eigen::VectorXd > panelAreas_;
+
+    //! Cross products of moment arms (from momentReferencePoint to panel centroid) and surface normals of the panels
+    //! on each part (same panel ordering as panelSurfaceNormals_).
+    std::vector< Eigen::Matrix< double, Eigen::Dynamic, 3 > > panelMomentArmNormalProducts_;
+
     //! Multi-array as which indicates which coefficients have been calculated already.
     /*!
      * Multi-array as which indicates which coefficients have been calculated already. Indices of
@@ -342,42 +445,27 @@ private:
      */
     boost::multi_array< bool, 3 > isCoefficientGenerated_;
 
-    //! Three-dimensional array of panel inclination angles.
-    /*!
-     * Three-dimensional array of panel inclination angles at current values of
-     * independent variables. Indices indicate part-line-point.
-     */
-    std::vector< std::vector< std::vector< double > > > inclination_;
-
     //! Map of angle of attack and -sideslip pair and associated panel inclinations.
     /*!
-     * Map of angle of attack and -sideslip pair and associated panel inclinations.
+     * Map of angle of attack and -sideslip pair and associated panel inclinations (for each part, same panel
+     * ordering as panelSurfaceNormals_).
      */
-    std::map< std::pair< double, double >, std::vector< std::vector< std::vector< double > > > >
-    previouslyComputedInclinations_;
+    std::map< std::pair< double, double >, std::vector< Eigen::VectorXd > > previouslyComputedInclinations_;
 
-    //! Three-dimensional array of panel pressure coefficients.
+    //! Panel pressure coefficients at each set of independent variables (only set if savePressureCoefficients_ is true).
     /*!
-     * Three-dimensional array of panel pressure coefficients at current values
-     * of independent variables. Indices indicate part-line-point.
+     * Panel pressure coefficients at each set of independent variables (only set if savePressureCoefficients_ is true).
+     * Indices of entries coincide with indices of aerodynamicCoefficients_, each entry contains the pressure
+     * coefficients of the panels on each part (same panel ordering as panelSurfaceNormals_).
      */
-    std::vector< std::vector< std::vector< double > > > pressureCoefficient_;
-
-    std::map< boost::array< int, 3 >,  std::vector< std::vector< std::vector< double > > > > pressureCoefficientList_;
-
-    //! Stagnation pressure coefficient.
-    /*!
-     * Stagnation pressure coefficient for flow which has passed through a
-     * normal shock wave at current Mach number.
-     */
-    double stagnationPressureCoefficient;
+    boost::multi_array< std::vector< Eigen::VectorXd >, 3 > savedPressureCoefficients_;
 
     //! Ratio of specific heats.
     /*!
      * Ratio of specific heat at constant pressure to specific heat at constant pressure.
      */
     double ratioOfSpecificHeats;
-    \
+
     //! Array of selected methods.
     /*!
      * Array of selected methods, first index represents compression/expansion,
@@ -386,6 +474,9 @@ private:
     std::vector< std::vector< int > > selectedMethods_;
 
     bool savePressureCoefficients_;
+
+    //! Number of threads over which the coefficient computation is distributed (0 denotes all available threads).
+    unsigned int numberOfThreads_;
 };
 
 
@@ -15,6 +15,7 @@
 #include <utility>
 #include <cmath>
 #include <algorithm>
+#include <memory>
 
 #include <functional>
 #include <boost/functional/hash.hpp>
@@ -22,6 +23,7 @@
 #include "tudat/astro/basic_astro/physicalConstants.h"
 #include "tudat/astro/aerodynamics/atmosphereModel.h"
 #include "tudat/astro/aerodynamics/aerodynamics.h"
+#include "tudat/astro/aerodynamics/densityGridCache.h"
 #include "tudat/math/basic/mathematicalConstants.h"
 
 extern "C"
@@ -242,7 +244,8 @@ class NRLMSISE00Atmosphere : public AtmosphereModel
 
     //! Get local density.
     /*!
-     * Returns the local density of the atmosphere in kg per meter^3.
+     * Returns the local density of the atmosphere in kg per meter^3. If a density grid cache is used (see
+     * setDensityGridCache), and the altitude is inside the grid, the density is interpolated from the grid.
     * \param altitude Altitude at which density is to be computed [m].
     * \param longitude Longitude at which density is to be computed [rad].
     * \param latitude Latitude at which density is to be computed [rad].
@@ -252,10 +255,55 @@ class NRLMSISE00Atmosphere : public AtmosphereModel
     double getDensity( const double altitude, const double longitude,
                        const double latitude, const double time )
     {
+        if( densityGridCache_ != nullptr && densityGridCache_->isAltitudeInGrid( altitude ) )
+        {
+            return getDensityFromGrid( altitude, longitude, latitude, time );
+        }
         computeProperties( altitude, longitude, latitude, time );
         return density_;
     }
 
+    //! Get local density from the NRLMSISE00 model.
+    /*!
+     * Returns the local density of the atmosphere in kg per meter^3, computed directly from the NRLMSISE00 model (also if a
+     * density grid cache is used), for instance to validate the density grid.
+    * \param altitude Altitude at which density is to be computed [m].
+    * \param longitude Longitude at which density is to be computed [rad].
+    * \param latitude Latitude at which density is to be computed [rad].
+    * \param time Time at which density is to be computed (seconds since J2000).
+     * \return Atmospheric density [kg/m^3].
+     */
+    double getReferenceDensity( const double altitude, const double longitude,
+                                const double latitude, const double time )
+    {
+        computeProperties( altitude, longitude, latitude, time );
+        return density_;
+    }
+
+    //! Set grid of precomputed densities, from which the density is interpolated.
+    /*!
+     * Sets a grid of precomputed densities (as a function of altitude, local solar time and latitude), from which the
+     * density is interpolated by getDensity (other properties are always computed from the NRLMSISE00 model). The model input
+     * is retrieved once per input update interval (see DensityGridCacheSettings), and the grid is recomputed only if the
+     * input (other than the time of day) has changed. The grid is computed for the time of day at which the model input
+     * was retrieved, so that the (small) dependency of the model on longitude and universal time at constant local solar
+     * time is not included in the grid, but it is included (for all times of day) in the estimated maximum error of the
+     * grid (see DensityGridCache::computeGrid). The local solar time is computed from the longitude and time, as in
+     * nrlmsiseInputFunction.
+     * \param densityGridCacheSettings Settings for the grid (nullptr to compute all densities from the NRLMSISE00 model).
+     */
+    void setDensityGridCache( const std::shared_ptr< DensityGridCacheSettings > densityGridCacheSettings );
+
+    //! Get grid of precomputed densities.
+    /*!
+     * Gets the grid of precomputed densities (nullptr if none), for instance to retrieve its interpolation error.
+     * \return Grid of precomputed densities
+     */
+    std::shared_ptr< DensityGridCache > getDensityGridCache( )
+    {
+        return densityGridCache_;
+    }
+
     //! Get local pressure.
     /*!
      * Returns the local pressure of the atmosphere in Newton per meter^2.
@@ -587,8 +635,41 @@ class NRLMSISE00Atmosphere : public AtmosphereModel
     void computeProperties( const double altitude, const double longitude,
                             const double latitude, const double time );
 
+    //! Get density interpolated from the density grid cache.
+    /*!
+     * Returns the density interpolated from the density grid cache, after updating the grid if the model input has changed.
+    * \param altitude Altitude at which density is to be computed [m].
+    * \param longitude Longitude at which density is to be computed [rad].
+    * \param latitude Latitude at which density is to be computed [rad].
+    * \param time Time at which density is to be computed (seconds since J2000).
+     * \return Atmospheric density [kg/m^3].
+     */
+    double getDensityFromGrid( const double altitude, const double longitude,
+                               const double latitude, const double time );
+
+    //! Compute the density from the NRLMSISE00 model for given input data, without modifying the current properties.
+    /*!
+     * Computes the density from the NRLMSISE00 model for given input data, without modifying the current properties.
+     * \param inputData Input data to NRLMSISE00 atmosphere model (local solar time and second of the day are used).
+     * \param altitude Altitude at which density is to be computed [m].
+     * \param longitude Longitude at which density is to be computed [rad].
+     * \param latitude Latitude at which density is to be computed [rad].
+     * \return Atmospheric density [kg/m^3].
+     */
+    double computeDensityFromInput( const NRLMSISE00Input& inputData, const double altitude,
+                                    const double longitude, const double latitude );
+
     //! Input data to NRLMSISE00 atmosphere model
     NRLMSISE00Input inputData_;
+
+    //! Grid of precomputed densities (nullptr if none)
+    std::shared_ptr< DensityGridCache > densityGridCache_;
+
+    //! Input data to NRLMSISE00 atmosphere model with which the density grid was computed
+    NRLMSISE00Input densityGridInputData_;
+
+    //! Index of input update interval in which the model input for the density grid was last retrieved
+    double densityGridInputInterval_ = TUDAT_NAN;
 };
 
 }  // namespace aerodynamics
@@ -24,7 +24,7 @@ using Eigen::Vector6d;
 using mathematical_constants::PI;
 using namespace aerodynamics;
 
-std::shared_ptr< HypersonicLocalInclinationAnalysis > getApolloCoefficientInterface( )
+std::shared_ptr< HypersonicLocalInclinationAnalysis > getApolloCoefficientInterface( const unsigned int numberOfThreads = 1 )
 {
 
     // Create test capsule.
@@ -90,7 +90,7 @@ std::shared_ptr< HypersonicLocalInclinationAnalysis > getApolloCoefficientInterf
     return std::make_shared< HypersonicLocalInclinationAnalysis >(
                 independentVariableDataPoints, capsule, numberOfLines, numberOfPoints,
                 invertOrders, selectedMethods, PI * pow( capsule->getMiddleRadius( ), 2.0 ),
-                3.9116, momentReference );
+                3.9116, momentReference, false, numberOfThreads );
 }
 
 } // namespace unit_tests
@@ -20,6 +20,7 @@
 #include "tudat/astro/gravitation/mutualSphericalHarmonicGravityModel.h"
 #include "tudat/astro/gravitation/thirdBodyPerturbation.h"
 #include "tudat/astro/gravitation/directTidalDissipationAcceleration.h"
+#include "tudat/astro/gravitation/manyBodyPointMassGravityModel.h"
 #include "tudat/astro/aerodynamics/aerodynamicAcceleration.h"
 #include "tudat/astro/basic_astro/massRateModel.h"
 #include "tudat/astro/propulsion/thrustAccelerationModel.h"
@@ -61,7 +62,8 @@ enum AvailableAcceleration
     panelled_radiation_pressure_acceleration,
     momentum_wheel_desaturation_acceleration,
     solar_sail_acceleration,
-    custom_acceleration
+    custom_acceleration,
+    many_body_point_mass_gravity
 };
 
 // Function to get a string representing a 'named identification' of an acceleration type
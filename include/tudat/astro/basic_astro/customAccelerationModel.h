@@ -12,12 +12,21 @@
 #ifndef TUDAT_CUSTOM_ACCELERATION_MODEL_H
 #define TUDAT_CUSTOM_ACCELERATION_MODEL_H
 
+#include "tudat/basics/basicTypedefs.h"
 #include "tudat/astro/basic_astro/accelerationModel.h"
+#include "tudat/math/basic/dualNumber.h"
 
 namespace tudat
 {  
 namespace basic_astrodynamics
 {
+
+//! Typedef for Cartesian state with dual numbers (derivatives w.r.t. the state itself) as scalar type
+typedef Eigen::Matrix< automatic_differentiation::StateDualNumber, 6, 1 > DualCartesianState;
+
+//! Typedef for acceleration with dual numbers (derivatives w.r.t. the Cartesian state) as scalar type
+typedef Eigen::Matrix< automatic_differentiation::StateDualNumber, 3, 1 > DualAcceleration;
+
 class CustomAccelerationModel: public basic_astrodynamics::AccelerationModel3d
 {
 public:
@@ -27,17 +36,94 @@ public:
     {
     }
 
+    //! Constructor for acceleration depending on time and relative state of body undergoing acceleration.
+    /*!
+     *  Constructor for acceleration depending on time and relative state of body undergoing acceleration, for which the
+     *  partial derivatives w.r.t. this state can be computed by automatic differentiation.
+     *  \param stateDependentAccelerationFunction Function returning acceleration as a function of time and relative state
+     *  \param differentiableAccelerationFunction Same as stateDependentAccelerationFunction, but with dual numbers as scalar
+     *  type, used to compute the partial derivatives of the acceleration w.r.t. the relative state (may be empty).
+     *  \param relativeStateFunction Function returning the current state of the body undergoing acceleration, w.r.t. the
+     *  body exerting it.
+     */
+    CustomAccelerationModel(
+            const std::function< Eigen::Vector3d( const double, const Eigen::Vector6d& ) > stateDependentAccelerationFunction,
+            const std::function< DualAcceleration( const double, const DualCartesianState& ) >
+            differentiableAccelerationFunction,
+            const std::function< Eigen::Vector6d( ) > relativeStateFunction ):
+        stateDependentAccelerationFunction_( stateDependentAccelerationFunction ),
+        differentiableAccelerationFunction_( differentiableAccelerationFunction ),
+        relativeStateFunction_( relativeStateFunction ),
+        currentRelativeState_( Eigen::Vector6d::Constant( TUDAT_NAN ) ),
+        currentEvaluationTime_( TUDAT_NAN )
+    {
+    }
+
     virtual void updateMembers( const double currentTime = TUDAT_NAN )
     {
         if( !( this->currentTime_ == currentTime ) )
         {
-            currentAcceleration_ = accelerationFunction_( currentTime );
+            if( stateDependentAccelerationFunction_ == nullptr )
+            {
+                currentAcceleration_ = accelerationFunction_( currentTime );
+            }
+            else
+            {
+                currentRelativeState_ = relativeStateFunction_( );
+                currentEvaluationTime_ = currentTime;
+                currentAcceleration_ = stateDependentAccelerationFunction_( currentTime, currentRelativeState_ );
+            }
         }
 
     }
 
+    //! Function to check whether the partial derivatives of the acceleration w.r.t. the relative state can be computed.
+    /*!
+     *  Function to check whether the partial derivatives of the acceleration w.r.t. the relative state can be computed.
+     *  \return True if a differentiable acceleration function was provided.
+     */
+    bool isAccelerationDifferentiable( )
+    {
+        return ( differentiableAccelerationFunction_ != nullptr );
+    }
+
+    //! Function to compute the partial derivatives of the acceleration w.r.t. the relative state.
+    /*!
+     *  Function to compute the partial derivatives of the acceleration w.r.t. the relative state of the body undergoing
+     *  acceleration, by forward-mode automatic differentiation (single evaluation of the differentiable acceleration
+     *  function). Uses the time and state at which the acceleration was last updated.
+     *  \param accelerationStatePartial Partial derivatives of the acceleration w.r.t. the relative state (returned by
+     *  reference)
+     */
+    void computeAccelerationStatePartial( Eigen::Matrix< double, 3, 6 >& accelerationStatePartial )
+    {
+        if( !isAccelerationDifferentiable( ) )
+        {
+            throw std::runtime_error( "Error when computing partial of custom acceleration, no differentiable function provided" );
+        }
+
+        DualAcceleration dualAcceleration = differentiableAccelerationFunction_(
+                    currentEvaluationTime_, automatic_differentiation::createIndependentVariables< 6 >( currentRelativeState_ ) );
+        accelerationStatePartial = automatic_differentiation::getJacobian( dualAcceleration );
+    }
+
 private:
     std::function< Eigen::Vector3d( const double ) > accelerationFunction_;
+
+    //! Function returning acceleration as a function of time and relative state
+    std::function< Eigen::Vector3d( const double, const Eigen::Vector6d& ) > stateDependentAccelerationFunction_;
+
+    //! Function returning acceleration as a function of time and relative state, with dual numbers as scalar type
+    std::function< DualAcceleration( const double, const DualCartesianState& ) > differentiableAccelerationFunction_;
+
+    //! Function returning the current state of the body undergoing acceleration, w.r.t. the body exerting it.
+    std::function< Eigen::Vector6d( ) > relativeStateFunction_;
+
+    //! Relative state at which acceleration was last computed
+    Eigen::Vector6d currentRelativeState_;
+
+    //! Time at which acceleration was last computed
+    double currentEvaluationTime_;
 };
 
 
@@ -17,6 +17,7 @@
 #include "earth_orientation/precessionNutationCalculator.h"
 #include "earth_orientation/readAmplitudeAndArgumentMultipliers.h"
 #include "earth_orientation/shortPeriodEarthOrientationCorrectionCalculator.h"
+#include "earth_orientation/tabulatedEarthOrientationCalculator.h"
 #include "earth_orientation/terrestrialTimeScaleConverter.h"
 
 #endif // TUDAT_EARTH_ORIENTATION_H
@@ -70,6 +70,25 @@ Eigen::Quaterniond calculateRotationFromTirsToCirs( const double earthRotationAn
 Eigen::Quaterniond calculateRotationFromItrsToTirs(
         const double xPolePosition, const double yPolePosition, const double tioLocator );
 
+//! Calculate rotation matrix from ITRS to GCRS
+/*!
+ * Calculate rotation matrix from ITRS to GCRS, composing the matrices of Eqs. (5.3), (5.5) and (5.10) of IERS 2010
+ * Conventions directly (with the three rotations about the z-axis by -s, ERA and s' combined into a single rotation).
+ * Equal to within round-off to the (quaternion) rotation computed by calculateRotationFromItrsToGcrs, but requires fewer
+ * operations.
+ * \param celestialPoleXPosition Parameter X in  IERS Conventions 2010, Section 5.4.4
+ * \param celestialPoleYPosition Parameter X in  IERS Conventions 2010, Section 5.4.4
+ * \param cioLocator Celestial intermediate origin locator; parameter s in  IERS Conventions 2010, Section 5.4.4
+ * \param earthRotationAngle Current Earth Rotation angle
+ * \param xPolePosition Polar motion parameter in x-direction (typically denoted x_{p})
+ * \param yPolePosition Polar motion parameter in y-direction (typically denoted x_{p})
+ * \param tioLocator TIO locator.
+ * \return Rotation matrix from ITRS to GCRS
+ */
+Eigen::Matrix3d calculateRotationMatrixFromItrsToGcrs(
+        const double celestialPoleXPosition, const double celestialPoleYPosition, const double cioLocator,
+        const double earthRotationAngle, const double xPolePosition, const double yPolePosition, const double tioLocator );
+
 //! Calculate time-derivative of rotation matrix from ITRS to GCRS
 /*!
  * Calculate time-derivative of rotation matrix from ITRS to GCRS. Function approximates derivative by only including derivative
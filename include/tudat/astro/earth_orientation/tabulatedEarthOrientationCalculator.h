@@ -0,0 +1,263 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_TABULATEDEARTHORIENTATIONCALCULATOR_H
+#define TUDAT_TABULATEDEARTHORIENTATIONCALCULATOR_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/earth_orientation/earthOrientationCalculator.h"
+#include "tudat/interface/sofa/sofaTimeConversions.h"
+
+namespace tudat
+{
+
+namespace earth_orientation
+{
+
+//! Class to calculate the earth orientation angles from precomputed tables, interpolated in time
+/*!
+ *  Class to calculate the earth orientation angles (X, Y, s, x_p, y_p and UT1, as computed by
+ *  EarthOrientationAnglesCalculator::getRotationAnglesFromItrsToGcrs), and the TIO locator s', from tables that are
+ *  precomputed over a given time interval, to prevent the IAU precession-nutation series (and the TDB-TT and short-period
+ *  EOP series) from being evaluated for each query. Only the smooth contributions to the angles are tabulated, on an
+ *  equidistant grid in the input time scale, and interpolated with Lagrange polynomials:
+ *  the nominal precession-nutation (X, Y, s), the short-period (ocean tide and libration) polar motion and UT1
+ *  variations, the TIO locator, and the difference between TAI and the input time scale (from TDB-TT). The daily IERS
+ *  corrections to X, Y, x_p, y_p and UT1-UTC are (linearly) interpolated at each query with the interpolators of the
+ *  EarthOrientationAnglesCalculator, as these are not smooth at the data points. UT1 is computed from UTC (computed
+ *  from the interpolated TAI) in the same manner as by the TerrestrialTimeScaleConverter.
+ *
+ *  For a grid of N points (spacing h) and quantities of which the dominant short-period term has amplitude A and angular
+ *  frequency w, the interpolation error is bounded by approximately C_N A (w h)^N, with C_N = 1.1E-3 for N = 8 (query
+ *  in the central grid interval). With the default settings (h = 1 hour, N = 8), the semi-diurnal terms of the
+ *  short-period polar motion (A < 0.5 mas) give an error below 0.005 microarcseconds, and those of UT1 (A < 0.1 ms)
+ *  an error below 1 ns (< 0.02 microarcseconds in Earth rotation angle). The nutation terms (periods > 4.7 days)
+ *  and TDB-TT give errors several orders of magnitude smaller. The total interpolation error is therefore well below
+ *  1 microarcsecond. The difference w.r.t. the direct computation is dominated by the round-off in the time
+ *  representation: UT1 in double precision has a resolution of ~6E-8 s at current epochs, or ~1 microarcsecond in
+ *  Earth rotation angle, which also applies to the direct computation.
+ *
+ *  Outside the tabulated interval, the angles are computed directly by the EarthOrientationAnglesCalculator. Only
+ *  input time scales for which the difference with TAI is smooth are supported (TDB, TT and TAI), and the interpolators
+ *  of the EarthOrientationAnglesCalculator are evaluated, so that this class is not thread-safe.
+ */
+class TabulatedEarthOrientationAnglesCalculator
+{
+public:
+
+    //! Constructor, computes the tables of the earth orientation angles
+    /*!
+     *  Constructor, computes the tables of the earth orientation angles over the given time interval (extended by half
+     *  the number of interpolation points at either side, so that the interpolation is centered over the full interval)
+     *  \param earthOrientationCalculator Object calculating the earth orientation angles directly
+     *  \param intervalStart Start of time interval over which the angles are tabulated
+     *  \param intervalEnd End of time interval over which the angles are tabulated
+     *  \param timeStep Time step between tabulated values
+     *  \param inputTimeScale Time scale in which the input times are provided (TDB, TT or TAI)
+     *  \param numberOfInterpolationPoints Number of points used for the Lagrange interpolation (even number)
+     */
+    TabulatedEarthOrientationAnglesCalculator(
+            const std::shared_ptr< EarthOrientationAnglesCalculator > earthOrientationCalculator,
+            const double intervalStart,
+            const double intervalEnd,
+            const double timeStep = 3600.0,
+            const basic_astrodynamics::TimeScales inputTimeScale = basic_astrodynamics::tdb_scale,
+            const int numberOfInterpolationPoints = 8 );
+
+    //! Calculate rotation angles from ITRS to GCRS at given time value.
+    /*!
+     *  Calculate rotation angles from ITRS to GCRS at given time value, from the tabulated angles (see class
+     *  description), or directly if the time is outside of the tabulated interval.
+     *  \param timeValue Number of seconds since J2000 at which orientation is to be evaluated (in input time scale)
+     *  \return Rotation angles for ITRS<->GCRS transformation at given epoch. First pair entry is: X, Y, s, x_p, y_p.
+     *  Second defines UT1.
+     */
+    template< typename TimeType >
+    std::pair< Eigen::Vector5d, TimeType > getRotationAnglesFromItrsToGcrs( const double timeValue )
+    {
+        double tioLocator;
+        return getRotationAnglesAndTioLocatorFromItrsToGcrs< TimeType >( timeValue, tioLocator );
+    }
+
+    //! Calculate rotation angles from ITRS to GCRS, and the TIO locator, at given time value.
+    /*!
+     *  Calculate rotation angles from ITRS to GCRS, and the TIO locator, at given time value, from the tabulated angles
+     *  (see class description), or directly if the time is outside of the tabulated interval.
+     *  \param timeValue Number of seconds since J2000 at which orientation is to be evaluated (in input time scale)
+     *  \param tioLocator TIO locator at given time (returned by reference)
+     *  \return Rotation angles for ITRS<->GCRS transformation at given epoch. First pair entry is: X, Y, s, x_p, y_p.
+     *  Second defines UT1.
+     */
+    template< typename TimeType >
+    std::pair< Eigen::Vector5d, TimeType > getRotationAnglesAndTioLocatorFromItrsToGcrs(
+            const double timeValue, double& tioLocator )
+    {
+        if( !interpolateTabulatedValues( timeValue ) )
+        {
+            tioLocator = getApproximateTioLocator( timeValue );
+            return earthOrientationCalculator_->getRotationAnglesFromItrsToGcrs< TimeType >( timeValue, inputTimeScale_ );
+        }
+
+        // Compute UTC from interpolated TAI
+        TimeType tai = static_cast< TimeType >( timeValue ) + static_cast< TimeType >( currentValues_( 5 ) );
+        TimeType utc = sofa_interface::convertTAItoUTC< TimeType >( tai );
+        double utcValue = static_cast< double >( utc );
+
+        // Add daily IERS corrections to interpolated values
+        Eigen::Vector5d rotationAngles = currentValues_.segment( 0, 5 );
+        rotationAngles.segment( 0, 2 ) += cipInGcrsCorrectionInterpolator_->interpolate( utcValue );
+        rotationAngles.segment( 3, 2 ) += cipInItrsInterpolator_->interpolate( utcValue );
+
+        TimeType ut1 = static_cast< TimeType >( dailyUtcUt1CorrectionInterpolator_->interpolate( utcValue ) ) + utc;
+        ut1 += static_cast< TimeType >( currentValues_( 6 ) );
+
+        tioLocator = currentValues_( 7 );
+        return std::make_pair( rotationAngles, ut1 );
+    }
+
+    //! Calculate rotation matrix from ITRS to GCRS at given time value.
+    /*!
+     *  Calculate rotation matrix from ITRS to GCRS at given time value, from the tabulated angles (see class
+     *  description), using calculateRotationMatrixFromItrsToGcrs
+     *  \param timeValue Number of seconds since J2000 at which orientation is to be evaluated (in input time scale)
+     *  \return Rotation matrix from ITRS to GCRS
+     */
+    template< typename TimeType >
+    Eigen::Matrix3d getRotationMatrixFromItrsToGcrs( const double timeValue )
+    {
+        double tioLocator;
+        std::pair< Eigen::Vector5d, TimeType > rotationAnglesAndUt1 =
+                getRotationAnglesAndTioLocatorFromItrsToGcrs< TimeType >( timeValue, tioLocator );
+        return calculateRotationMatrixFromItrsToGcrs(
+                    rotationAnglesAndUt1.first( 0 ), rotationAnglesAndUt1.first( 1 ), rotationAnglesAndUt1.first( 2 ),
+                    sofa_interface::calculateEarthRotationAngleTemplated< TimeType >( rotationAnglesAndUt1.second ),
+                    rotationAnglesAndUt1.first( 3 ), rotationAnglesAndUt1.first( 4 ), tioLocator );
+    }
+
+    //! Calculate time-derivative of rotation matrix from ITRS to GCRS at given time value.
+    /*!
+     *  Calculate time-derivative of rotation matrix from ITRS to GCRS at given time value, from the tabulated angles (see
+     *  class description), using calculateRotationRateFromItrsToGcrs
+     *  \param timeValue Number of seconds since J2000 at which orientation is to be evaluated (in input time scale)
+     *  \return Time-derivative of rotation matrix from ITRS to GCRS
+     */
+    template< typename TimeType >
+    Eigen::Matrix3d getRotationRateFromItrsToGcrs( const double timeValue )
+    {
+        double tioLocator;
+        std::pair< Eigen::Vector5d, TimeType > rotationAnglesAndUt1 =
+                getRotationAnglesAndTioLocatorFromItrsToGcrs< TimeType >( timeValue, tioLocator );
+        return calculateRotationRateFromItrsToGcrs< TimeType >(
+                    rotationAnglesAndUt1.first( 0 ), rotationAnglesAndUt1.first( 1 ), rotationAnglesAndUt1.first( 2 ),
+                    rotationAnglesAndUt1.second,
+                    rotationAnglesAndUt1.first( 3 ), rotationAnglesAndUt1.first( 4 ), tioLocator );
+    }
+
+    //! Function to retrieve the object calculating the earth orientation angles directly
+    std::shared_ptr< EarthOrientationAnglesCalculator > getEarthOrientationCalculator( )
+    {
+        return earthOrientationCalculator_;
+    }
+
+    //! Function to retrieve the time scale in which the input times are provided
+    basic_astrodynamics::TimeScales getInputTimeScale( )
+    {
+        return inputTimeScale_;
+    }
+
+    //! Function to retrieve the start of the time interval over which the angles are tabulated
+    double getIntervalStart( )
+    {
+        return intervalStart_;
+    }
+
+    //! Function to retrieve the end of the time interval over which the angles are tabulated
+    double getIntervalEnd( )
+    {
+        return intervalEnd_;
+    }
+
+    //! Function to retrieve the time step between tabulated values
+    double getTimeStep( )
+    {
+        return timeStep_;
+    }
+
+private:
+
+    //! Function to interpolate the tabulated values at the given time
+    /*!
+     *  Function to interpolate the tabulated values at the given time, and set them in currentValues_.
+     *  \param timeValue Time at which values are to be interpolated
+     *  \return True if time is in tabulated interval (and values are interpolated), false otherwise.
+     */
+    bool interpolateTabulatedValues( const double timeValue );
+
+    //! Object calculating the earth orientation angles directly
+    std::shared_ptr< EarthOrientationAnglesCalculator > earthOrientationCalculator_;
+
+    //! Interpolator for daily measured values of precession-nutation corrections (input UTC)
+    std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector2d > > cipInGcrsCorrectionInterpolator_;
+
+    //! Interpolator for daily measured values of pole offsets (input UTC)
+    std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector2d > > cipInItrsInterpolator_;
+
+    //! Interpolator for daily measured values of UT1-UTC (input UTC)
+    std::shared_ptr< interpolators::OneDimensionalInterpolator< double, double > > dailyUtcUt1CorrectionInterpolator_;
+
+    //! Time scale in which the input times are provided
+    basic_astrodynamics::TimeScales inputTimeScale_;
+
+    //! Start of the time interval over which the angles are tabulated
+    double intervalStart_;
+
+    //! End of the time interval over which the angles are tabulated
+    double intervalEnd_;
+
+    //! Time step between tabulated values
+    double timeStep_;
+
+    //! Number of points used for the Lagrange interpolation
+    int numberOfInterpolationPoints_;
+
+    //! Time of first tabulated value
+    double firstTabulatedTime_;
+
+    //! Tabulated values (one column per time).
+    /*!
+     *  Tabulated values (one column per time), with rows: X, Y, s (without daily corrections), x_p, y_p (short-period
+     *  variations only), TAI minus input time, short-period UT1 variations, TIO locator.
+     */
+    Eigen::Matrix< double, 8, Eigen::Dynamic > tabulatedValues_;
+
+    //! Denominators of the Lagrange polynomials (in units of time step)
+    std::vector< double > lagrangeDenominators_;
+
+    //! Pre-allocated Lagrange polynomial values at the current time
+    Eigen::VectorXd lagrangeWeights_;
+
+    //! Pre-allocated products of (u - j) for j smaller than each node index
+    std::vector< double > leftProducts_;
+
+    //! Values interpolated at the current time, as set by last call to interpolateTabulatedValues
+    Eigen::Matrix< double, 8, 1 > currentValues_;
+};
+
+} // namespace earth_orientation
+
+} // namespace tudat
+
+#endif // TUDAT_TABULATEDEARTHORIENTATIONCALCULATOR_H
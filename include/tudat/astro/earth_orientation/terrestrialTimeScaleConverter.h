@@ -278,6 +278,12 @@ public:
         return dailyUtcUt1CorrectionInterpolator_;
     }
 
+    //! Object to compute the short-period variations in UT1
+    std::shared_ptr< ShortPeriodEarthOrientationCorrectionCalculator< double > > getShortPeriodUt1CorrectionCalculator( )
+    {
+        return shortPeriodUt1CorrectionCalculator_;
+    }
+
 private:
 
     //! Function to get current time list at requested numerical precision
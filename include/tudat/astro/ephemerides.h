@@ -15,6 +15,7 @@
 #include "ephemerides/approximatePlanetPositionsBase.h"
 #include "ephemerides/approximatePlanetPositionsCircularCoplanar.h"
 #include "ephemerides/approximatePlanetPositionsDataContainer.h"
+#include "ephemerides/cachedEphemeris.h"
 #include "ephemerides/cartesianStateExtractor.h"
 #include "ephemerides/compositeEphemeris.h"
 #include "ephemerides/constantEphemeris.h"
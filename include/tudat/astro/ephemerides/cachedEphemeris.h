@@ -0,0 +1,158 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_CACHEDEPHEMERIS_H
+#define TUDAT_CACHEDEPHEMERIS_H
+
+#include <memory>
+#include <unordered_map>
+
+#include "tudat/astro/ephemerides/ephemeris.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace ephemerides
+{
+
+//! Ephemeris class that caches the states computed by another ephemeris.
+/*!
+ *  Ephemeris class that caches the states computed by another ephemeris. This is used when many independent
+ *  propagations are performed in a single environment (see propagateSingleArcBatch), in which the states of the
+ *  perturbing bodies (e.g. Sun, Moon) are requested by many objects. Two modes are available:
+ *  - Without a grid spacing, the states are cached keyed by (exact) time. When the state is requested at a time for
+ *    which it was computed before (since the last call to clearCache), it is retrieved from the cache. Results are
+ *    identical to those of the wrapped ephemeris, but states are only shared at exactly coincident epochs (e.g. by
+ *    objects propagated with the same fixed step size and initial time).
+ *  - With a grid spacing, the wrapped ephemeris is evaluated only at the epochs k * gridSpacing (k integer), which are
+ *    cached, and the state at any other epoch is computed by Lagrange interpolation of the states at the surrounding
+ *    grid epochs. The cached states are then shared by all requests, regardless of the epochs at which they are made
+ *    (e.g. by objects propagated with variable step size integrators). The interpolation error must be kept well below
+ *    the integration tolerances of the objects by the choice of grid spacing and number of interpolation nodes.
+ *  The cache holds at most a given number of entries, and is cleared when it is full. This class is not thread-safe.
+ */
+class CachedEphemeris : public Ephemeris
+{
+public:
+
+    using Ephemeris::getCartesianState;
+
+    //! Constructor
+    /*!
+     *  Constructor, sets the reference frame to that of the wrapped ephemeris.
+     *  \param baseEphemeris Ephemeris of which the states are to be cached.
+     *  \param maximumCacheSize Maximum number of states that are stored in the cache.
+     *  \param gridSpacing Spacing of the epochs at which the wrapped ephemeris is evaluated and cached (NaN by default,
+     *  in which case states are cached at the exact epochs at which they are requested, and not interpolated).
+     *  \param numberOfInterpolationNodes Number of grid epochs used for the Lagrange interpolation of the states (if a
+     *  grid spacing is provided).
+     */
+    CachedEphemeris( const std::shared_ptr< Ephemeris > baseEphemeris,
+                     const unsigned int maximumCacheSize = 100000,
+                     const double gridSpacing = TUDAT_NAN,
+                     const unsigned int numberOfInterpolationNodes = 8 );
+
+    //! Get state from ephemeris.
+    /*!
+     * Returns state from ephemeris at given time, retrieved from the cache if it was computed before, or interpolated
+     * from the cached states at the surrounding grid epochs (if a grid spacing is used).
+     * \param secondsSinceEpoch Seconds since epoch at which ephemeris is to be evaluated.
+     * \return State from ephemeris.
+     */
+    Eigen::Vector6d getCartesianState( const double secondsSinceEpoch );
+
+    //! Function to clear the cache
+    void clearCache( )
+    {
+        stateCache_.clear( );
+        gridStateCache_.clear( );
+    }
+
+    //! Function to retrieve the ephemeris of which the states are cached
+    std::shared_ptr< Ephemeris > getBaseEphemeris( )
+    {
+        return baseEphemeris_;
+    }
+
+    //! Function to retrieve the number of states that are currently stored in the cache
+    unsigned int getCurrentCacheSize( )
+    {
+        return stateCache_.size( ) + gridStateCache_.size( );
+    }
+
+    //! Function to retrieve the spacing of the epochs at which the wrapped ephemeris is evaluated (NaN if not used)
+    double getGridSpacing( )
+    {
+        return gridSpacing_;
+    }
+
+    //! Function to retrieve the number of requests for which the state was computed without evaluating the wrapped
+    //! ephemeris
+    unsigned long getNumberOfCacheHits( )
+    {
+        return numberOfCacheHits_;
+    }
+
+    //! Function to retrieve the number of evaluations of the wrapped ephemeris
+    unsigned long getNumberOfCacheMisses( )
+    {
+        return numberOfCacheMisses_;
+    }
+
+    //! Function to reset the number of cache hits and misses to zero
+    void resetCacheStatistics( )
+    {
+        numberOfCacheHits_ = 0;
+        numberOfCacheMisses_ = 0;
+    }
+
+private:
+
+    //! Function to retrieve the state at a grid epoch from the cache, evaluating the wrapped ephemeris if needed
+    /*!
+     *  Function to retrieve the state at a grid epoch from the cache, evaluating the wrapped ephemeris if needed
+     *  \param gridIndex Index of the grid epoch (epoch = gridIndex * gridSpacing)
+     *  \param isStateCached Variable that is set to false if the wrapped ephemeris had to be evaluated (unchanged
+     *  otherwise) [output]
+     *  \return State at the grid epoch
+     */
+    const Eigen::Vector6d& getGridState( const long long gridIndex, bool& isStateCached );
+
+    //! Ephemeris of which the states are cached
+    std::shared_ptr< Ephemeris > baseEphemeris_;
+
+    //! Maximum number of states that are stored in the cache
+    unsigned int maximumCacheSize_;
+
+    //! States computed since last clearing of cache (key: time)
+    std::unordered_map< double, Eigen::Vector6d > stateCache_;
+
+    //! Spacing of the epochs at which the wrapped ephemeris is evaluated (NaN if states are cached at exact epochs)
+    double gridSpacing_;
+
+    //! Number of grid epochs used for the Lagrange interpolation of the states
+    unsigned int numberOfInterpolationNodes_;
+
+    //! States computed at grid epochs since last clearing of cache (key: index of grid epoch)
+    std::unordered_map< long long, Eigen::Vector6d > gridStateCache_;
+
+    //! Number of requests for which the state was computed without evaluating the wrapped ephemeris
+    unsigned long numberOfCacheHits_;
+
+    //! Number of evaluations of the wrapped ephemeris
+    unsigned long numberOfCacheMisses_;
+};
+
+} // namespace ephemerides
+
+} // namespace tudat
+
+#endif // TUDAT_CACHEDEPHEMERIS_H
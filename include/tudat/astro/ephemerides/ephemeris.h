@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <functional>
+#include <vector>
 
 #include "tudat/astro/ephemerides/ephemeris.h"
 #include "tudat/math/basic/linearAlgebra.h"
@@ -75,6 +76,28 @@ public:
     virtual Eigen::Vector6d getCartesianState(
             const double secondsSinceEpoch ) = 0;
 
+    //! Get states from ephemeris at a list of times.
+    /*!
+     * Computes states from ephemeris at a list of times, and writes them into a buffer (one column per time). This
+     * function calls getCartesianState for each time by default, and is overridden by derived classes for which the
+     * states can be computed more efficiently for a list of times. Since the overriding implementations may exploit
+     * the order of the times (e.g. by sweeping forward through tabulated data), the times should be sorted in
+     * ascending order for best performance (results do not depend on the order).
+     * \param times List of seconds since epoch at which ephemeris is to be evaluated.
+     * \param states States from ephemeris at each of the times (returned by reference). Resized to 6 x number of
+     * times, which does not reallocate memory if the buffer already has this size.
+     */
+    virtual void getCartesianStates(
+            const std::vector< double >& times,
+            Eigen::Matrix< double, 6, Eigen::Dynamic >& states )
+    {
+        states.resize( 6, times.size( ) );
+        for( unsigned int i = 0; i < times.size( ); i++ )
+        {
+            states.col( i ) = getCartesianState( times[ i ] );
+        }
+    }
+
     //! Get position from ephemeris.
     /*!
      * Returns position from ephemeris at given time.
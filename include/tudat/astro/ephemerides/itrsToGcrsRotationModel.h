@@ -20,6 +20,7 @@
 #include "tudat/math/interpolators/interpolator.h"
 #include "tudat/astro/ephemerides/rotationalEphemeris.h"
 #include "tudat/astro/earth_orientation/earthOrientationCalculator.h"
+#include "tudat/astro/earth_orientation/tabulatedEarthOrientationCalculator.h"
 
 using namespace boost::placeholders;
 
@@ -96,6 +97,11 @@ public:
      */
     Eigen::Quaterniond getRotationToBaseFrame( const double ephemerisTime )
     {
+        if( tabulatedAnglesCalculator_ != nullptr )
+        {
+            return Eigen::Quaterniond(
+                        frameBias_ * tabulatedAnglesCalculator_->getRotationMatrixFromItrsToGcrs< double >( ephemerisTime ) );
+        }
         return Eigen::Quaterniond( frameBias_ ) * earth_orientation::calculateRotationFromItrsToGcrs< double >(
                     anglesCalculator_->getRotationAnglesFromItrsToGcrs< double >( ephemerisTime, inputTimeScale_ ),
                     ephemerisTime );
@@ -110,6 +116,11 @@ public:
      */
     Eigen::Quaterniond getRotationToBaseFrameFromExtendedTime( const Time ephemerisTime )
     {
+        if( tabulatedAnglesCalculator_ != nullptr )
+        {
+            return Eigen::Quaterniond(
+                        frameBias_ * tabulatedAnglesCalculator_->getRotationMatrixFromItrsToGcrs< Time >( ephemerisTime ) );
+        }
         return Eigen::Quaterniond( frameBias_ ) * earth_orientation::calculateRotationFromItrsToGcrs< Time >(
                     anglesCalculator_->getRotationAnglesFromItrsToGcrs< Time >( ephemerisTime, inputTimeScale_ ),
                     ephemerisTime );
@@ -149,6 +160,10 @@ public:
      */
     Eigen::Matrix3d getDerivativeOfRotationToBaseFrame( const double ephemerisTime )
     {
+        if( tabulatedAnglesCalculator_ != nullptr )
+        {
+            return frameBias_ * tabulatedAnglesCalculator_->getRotationRateFromItrsToGcrs< double >( ephemerisTime );
+        }
         return frameBias_ * earth_orientation::calculateRotationRateFromItrsToGcrs< double >( functionToGetRotationAngles( ephemerisTime ),
                                                                                  ephemerisTime );
     }
@@ -184,6 +199,34 @@ public:
         return inputTimeScale_;
     }
 
+    //! Function to set tabulated earth orientation angles, to be used instead of computing the angles directly
+    /*!
+     * Function to set tabulated earth orientation angles, which are used instead of computing the angles directly
+     * (within the tabulated interval; see TabulatedEarthOrientationAnglesCalculator). The rotation matrices are then
+     * computed directly from the interpolated angles.
+     * \param tabulatedAnglesCalculator Object interpolating the tabulated angles (nullptr to compute angles directly).
+     */
+    void setTabulatedAnglesCalculator(
+            const std::shared_ptr< earth_orientation::TabulatedEarthOrientationAnglesCalculator > tabulatedAnglesCalculator )
+    {
+        if( tabulatedAnglesCalculator != nullptr )
+        {
+            if( tabulatedAnglesCalculator->getEarthOrientationCalculator( ) != anglesCalculator_ ||
+                    tabulatedAnglesCalculator->getInputTimeScale( ) != inputTimeScale_ )
+            {
+                throw std::runtime_error( "Error when setting tabulated angles in GCRS<->ITRS model, angles calculator or "
+                                          "time scale is inconsistent" );
+            }
+        }
+        tabulatedAnglesCalculator_ = tabulatedAnglesCalculator;
+    }
+
+    //! Function to retrieve the object interpolating tabulated earth orientation angles (nullptr if not used)
+    std::shared_ptr< earth_orientation::TabulatedEarthOrientationAnglesCalculator > getTabulatedAnglesCalculator( )
+    {
+        return tabulatedAnglesCalculator_;
+    }
+
 
 private:
 
@@ -210,6 +253,9 @@ private:
      * Frame rotation from GCRS to base frame. If base frame is J2000, this is the standard frame bias, as computed from Spice.
      */
     Eigen::Matrix3d frameBias_;
+
+    //! Object interpolating tabulated earth orientation angles (nullptr if angles are computed directly)
+    std::shared_ptr< earth_orientation::TabulatedEarthOrientationAnglesCalculator > tabulatedAnglesCalculator_;
 };
 
 }
@@ -76,6 +76,20 @@ public:
     Eigen::Vector6d getCartesianState(
             const double secondsSinceEpoch );
 
+    //! Function to get states from ephemeris at a list of times.
+    /*!
+     *  Returns states from ephemeris at a list of times, assuming a purely Keplerian orbit. For elliptical orbits, Kepler's
+     *  equation is solved for blocks of times simultaneously (Newton-Raphson iterations on arrays of eccentric
+     *  anomalies, using the same initial guess and tolerance as convertMeanAnomalyToEccentricAnomaly), and the Cartesian
+     *  states are computed directly from the eccentric anomalies. For hyperbolic orbits, getCartesianState is called
+     *  for each time.
+     *  \param times List of seconds since epoch at which ephemeris is to be evaluated.
+     *  \param states Keplerian orbit Cartesian states at each of the times (returned by reference)
+     */
+    void getCartesianStates(
+            const std::vector< double >& times,
+            Eigen::Matrix< double, 6, Eigen::Dynamic >& states );
+
 private:
 
     //! Kepler elements at time epochOfInitialState.
@@ -17,6 +17,7 @@
 #include <memory>
 
 #include <functional>
+#include <vector>
 
 #include <Eigen/Core>
 #include <Eigen/Geometry>
@@ -210,6 +211,28 @@ public:
             const double secondsSinceEpoch ) = 0;
 
 
+    //! Get rotation quaternions from target frame to base frame at a list of times.
+    /*!
+     * Computes rotation quaternions from target frame to base frame at a list of times, and writes them into a buffer
+     * (one column per time, in the vector format of linear_algebra::convertQuaternionToVectorFormat). This function
+     * calls getRotationToBaseFrame for each time by default, and may be overridden by derived classes for which the
+     * rotations can be computed more efficiently for a list of times. The times should be sorted in ascending order
+     * for best performance (results do not depend on the order).
+     * \param times List of seconds since epoch at which ephemeris is to be evaluated.
+     * \param rotations Rotation quaternions at each of the times (returned by reference). Resized to 4 x number of
+     * times, which does not reallocate memory if the buffer already has this size.
+     */
+    virtual void getRotationsToBaseFrame(
+            const std::vector< double >& times,
+            Eigen::Matrix< double, 4, Eigen::Dynamic >& rotations )
+    {
+        rotations.resize( 4, times.size( ) );
+        for( unsigned int i = 0; i < times.size( ); i++ )
+        {
+            rotations.col( i ) = linear_algebra::convertQuaternionToVectorFormat( getRotationToBaseFrame( times[ i ] ) );
+        }
+    }
+
     Eigen::Matrix3d getRotationMatrixToBaseFrame( const double secondsSinceEpoch )
     {
         return Eigen::Matrix3d( getRotationToBaseFrame( secondsSinceEpoch ) );
@@ -12,15 +12,18 @@
 #ifndef TUDAT_TABULATEDEPHEMERIS_H
 #define TUDAT_TABULATEDEPHEMERIS_H
 
+#include <array>
 #include <map>
 #include <boost/make_shared.hpp>
 
 #include <Eigen/Core>
 
+#include "tudat/basics/columnarHistory.h"
 #include "tudat/astro/basic_astro/timeConversions.h"
 #include "tudat/astro/ephemerides/ephemeris.h"
 #include "tudat/math/interpolators/createInterpolator.h"
 #include "tudat/math/interpolators/lagrangeInterpolator.h"
+#include "tudat/math/interpolators/stridedLagrangeInterpolator.h"
 
 namespace tudat
 {
@@ -96,6 +99,7 @@ public:
     void resetInterpolator( const StateInterpolatorPointer interpolator )
     {
         interpolator_ = interpolator;
+        clearQueryCache( );
     }
 
     void resetInterpolator( const VariableStateInterpolatorPointer interpolator )
@@ -103,6 +107,30 @@ public:
         interpolator_ = interpolators::convertBetweenStaticDynamicEigenTypeInterpolators<
                 TimeType, StateScalarType, Eigen::Dynamic, 1, 6, 1 >(
                     interpolator );
+        clearQueryCache( );
+    }
+
+    //! Function to reset the state interpolator from a columnar state history
+    /*!
+     *  Function to reset the state interpolator from a columnar state history (for instance, the result of a numerical
+     *  propagation), using a Lagrange interpolator. The states are not copied: the interpolator reads them directly from
+     *  the contiguous storage of the history, which is kept alive by the interpolator. Only the times are copied (as
+     *  required by the lookup scheme). The history may be sorted in either increasing or decreasing order of time, and
+     *  must not be modified after calling this function.
+     *  \param stateHistory State history from which the interpolator is to be created.
+     *  \param numberOfLagrangePoints Number of data points used by the Lagrange interpolator
+     *  \param startIndex Index in the history entries at which the Cartesian state of this body starts.
+     */
+    void resetInterpolatorFromHistory(
+            const std::shared_ptr< const utilities::ColumnarHistory< TimeType, StateScalarType > > stateHistory,
+            const int numberOfLagrangePoints = 6,
+            const int startIndex = 0 )
+    {
+        typedef typename std::conditional< std::is_same< TimeType, double >::value, double, long double >::type
+                InterpolationScalarType;
+        interpolator_ = interpolators::createStridedLagrangeInterpolatorFromHistory<
+                TimeType, StateScalarType, 6, InterpolationScalarType >( stateHistory, startIndex, numberOfLagrangePoints );
+        clearQueryCache( );
     }
 
     //! Get cartesian state from ephemeris.
@@ -145,6 +173,30 @@ public:
     Eigen::Matrix< long double, 6, 1 > getCartesianLongStateFromExtendedTime(
             const Time& time );
 
+    //! Get cartesian states from ephemeris at a list of times.
+    /*!
+     * Returns cartesian states from ephemeris at a list of times, as calculated from interpolator_. The interpolator is
+     * evaluated directly (bypassing the query cache), so that for times in ascending order the (hunting) look-up of the
+     * interpolation interval sweeps forward through the tabulated data, starting from the interval of the previous time.
+     * \param times List of times at which ephemeris is to be evaluated.
+     * \param states States in Cartesian elements from ephemeris at each of the times (returned by reference)
+     */
+    void getCartesianStates(
+            const std::vector< double >& times,
+            Eigen::Matrix< double, 6, Eigen::Dynamic >& states )
+    {
+        if( interpolator_ == nullptr )
+        {
+            throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
+        }
+
+        states.resize( 6, times.size( ) );
+        for( unsigned int i = 0; i < times.size( ); i++ )
+        {
+            states.col( i ) = interpolator_->interpolate( TimeType( times[ i ] ) ).template cast< double >( );
+        }
+    }
+
 
     //! Function to return the interpolator
     /*!
@@ -163,6 +215,62 @@ public:
                     interpolator_ );
     }
 
+    //! Function to set whether the states of the most recent queries are to be cached
+    /*!
+     *  Function to set whether the states of the most recent queries are to be cached. When the cache is used, the
+     *  states at the last few (distinct) times at which this ephemeris was queried are stored, and a query at exactly one
+     *  of these times returns the stored state, without evaluating the interpolator. This is typically the case when
+     *  several link ends, frames or observables request the state of the same body at the same time (for instance,
+     *  during the light-time iterations of multiple links). Note that the cache is specific to this object, and this
+     *  object should therefore not be used concurrently from multiple threads (one environment should be created per
+     *  thread instead).
+     *  \param useQueryCache Boolean denoting whether the states of the most recent queries are to be cached.
+     */
+    void setUseQueryCache( const bool useQueryCache )
+    {
+        useQueryCache_ = useQueryCache;
+        clearQueryCache( );
+    }
+
+    //! Function to retrieve whether the states of the most recent queries are cached
+    /*!
+     *  Function to retrieve whether the states of the most recent queries are cached
+     *  \return Boolean denoting whether the states of the most recent queries are cached
+     */
+    bool getUseQueryCache( )
+    {
+        return useQueryCache_;
+    }
+
+    //! Function to retrieve the number of queries for which the state was retrieved from the cache
+    /*!
+     *  Function to retrieve the number of queries for which the state was retrieved from the cache, since the cache
+     *  was last turned on, or the counters were last reset.
+     *  \return Number of queries for which the state was retrieved from the cache
+     */
+    unsigned long getNumberOfQueryCacheHits( )
+    {
+        return numberOfQueryCacheHits_;
+    }
+
+    //! Function to retrieve the number of queries for which the state was not in the cache
+    /*!
+     *  Function to retrieve the number of queries for which the state was not in the cache (and the interpolator was
+     *  evaluated), since the cache was last turned on, or the counters were last reset.
+     *  \return Number of queries for which the state was not in the cache
+     */
+    unsigned long getNumberOfQueryCacheMisses( )
+    {
+        return numberOfQueryCacheMisses_;
+    }
+
+    //! Function to reset the counters of the number of cache hits and misses to zero
+    void resetQueryCacheStatistics( )
+    {
+        numberOfQueryCacheHits_ = 0;
+        numberOfQueryCacheMisses_ = 0;
+    }
+
     //! Function that retrieves the time interval at which this ephemeris can be safely interrogated
     /*!
      * Function that retrieves the time interval at which this ephemeris can be safely interrogated. The interval
@@ -172,12 +280,16 @@ public:
     std::pair< double, double > getSafeInterpolationInterval( )
     {
         std::pair< double, double > safeInterpolationInterval;
+        typedef interpolators::StridedLagrangeInterpolator< TimeType, StateScalarType, 6, double > StridedInterpolator;
+        typedef interpolators::StridedLagrangeInterpolator< TimeType, StateScalarType, 6, long double > LongStridedInterpolator;
 
         // Check interpolator type. If interpolator is not a Lagrange interpolator, return full domain
         if( std::dynamic_pointer_cast< interpolators::LagrangeInterpolator< TimeType, StateType, double > >(
                     interpolator_ ) == nullptr &&
                 std::dynamic_pointer_cast< interpolators::LagrangeInterpolator< TimeType, StateType, long double > >(
-                    interpolator_ ) == nullptr )
+                    interpolator_ ) == nullptr &&
+                std::dynamic_pointer_cast< StridedInterpolator >( interpolator_ ) == nullptr &&
+                std::dynamic_pointer_cast< LongStridedInterpolator >( interpolator_ ) == nullptr )
         {
             safeInterpolationInterval.first = interpolator_->getIndependentValues( ).at( 0 );
             safeInterpolationInterval.second = interpolator_->getIndependentValues( ).at(
@@ -205,17 +317,97 @@ public:
             safeInterpolationInterval.second = interpolator_->getIndependentValues( ).at(
                         interpolator_->getIndependentValues( ).size( ) - 1 - ( + numberOfNodes / 2 + 1 ) );
         }
+        // If interpolator is a strided Lagrange interpolator, remove edges where the interpolant is not centered
+        else
+        {
+            int numberOfNodes = ( std::dynamic_pointer_cast< StridedInterpolator >( interpolator_ ) != nullptr ) ?
+                        std::dynamic_pointer_cast< StridedInterpolator >( interpolator_ )->getNumberOfStages( ) :
+                        std::dynamic_pointer_cast< LongStridedInterpolator >( interpolator_ )->getNumberOfStages( );
+            safeInterpolationInterval.first = interpolator_->getIndependentValues( ).at( 0 + numberOfNodes / 2 + 1 );
+            safeInterpolationInterval.second = interpolator_->getIndependentValues( ).at(
+                        interpolator_->getIndependentValues( ).size( ) - 1 - ( + numberOfNodes / 2 + 1 ) );
+        }
         return safeInterpolationInterval;
     }
 
 private:
 
+    //! Function to compute the state from the interpolator, or retrieve it from the query cache (if used).
+    /*!
+     *  Function to compute the state from the interpolator, or retrieve it from the query cache (if used).
+     *  \param time Time at which the state is to be computed
+     *  \return State at requested time
+     */
+    StateType interpolateState( const TimeType& time )
+    {
+        if( interpolator_ == nullptr )
+        {
+            throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
+        }
+
+        if( !useQueryCache_ )
+        {
+            return interpolator_->interpolate( time );
+        }
+
+        for( int i = 0; i < numberOfCachedQueries_; i++ )
+        {
+            if( cachedQueryTimes_[ i ] == time )
+            {
+                numberOfQueryCacheHits_++;
+                return cachedQueryStates_[ i ];
+            }
+        }
+
+        // Compute state, and replace oldest entry in cache
+        numberOfQueryCacheMisses_++;
+        cachedQueryTimes_[ nextCacheEntry_ ] = time;
+        cachedQueryStates_[ nextCacheEntry_ ] = interpolator_->interpolate( time );
+
+        int currentCacheEntry = nextCacheEntry_;
+        nextCacheEntry_ = ( nextCacheEntry_ + 1 ) % queryCacheSize;
+        numberOfCachedQueries_ = std::min( numberOfCachedQueries_ + 1, queryCacheSize );
+        return cachedQueryStates_[ currentCacheEntry ];
+    }
+
+    //! Function to remove all entries from the query cache, and reset the hit/miss counters
+    void clearQueryCache( )
+    {
+        numberOfCachedQueries_ = 0;
+        nextCacheEntry_ = 0;
+        resetQueryCacheStatistics( );
+    }
+
     //! Interpolator that returns body state as a function of time.
     /*!
      *  Interpolator that returns body state as a function of time by calling the interpolate
      *  function (i.e. time as independent variable and states as dependent variables ).
      */
     StateInterpolatorPointer interpolator_;
+
+    //! Number of entries in query cache
+    static constexpr int queryCacheSize = 4;
+
+    //! Boolean denoting whether the states of the most recent queries are cached
+    bool useQueryCache_ = false;
+
+    //! Times of the most recent queries
+    std::array< TimeType, queryCacheSize > cachedQueryTimes_;
+
+    //! States at the times of the most recent queries
+    std::array< StateType, queryCacheSize > cachedQueryStates_;
+
+    //! Number of valid entries in query cache
+    int numberOfCachedQueries_ = 0;
+
+    //! Index of entry in query cache that is to be replaced by the next query that is not in the cache
+    int nextCacheEntry_ = 0;
+
+    //! Number of queries for which the state was retrieved from the cache
+    unsigned long numberOfQueryCacheHits_ = 0;
+
+    //! Number of queries for which the state was not in the cache
+    unsigned long numberOfQueryCacheMisses_ = 0;
 };
 
 
@@ -238,6 +430,16 @@ bool isTabulatedEphemeris( const std::shared_ptr< Ephemeris > ephemeris );
  */
 std::pair< double, double > getTabulatedEphemerisSafeInterval( const std::shared_ptr< Ephemeris > ephemeris );
 
+//! Function to set whether a tabulated ephemeris caches the states of its most recent queries
+/*!
+ * Function to set whether a tabulated ephemeris caches the states of its most recent queries (see
+ * TabulatedCartesianEphemeris::setUseQueryCache).
+ * \param ephemeris Ephemeris model for which the query cache is to be set. An exception is thrown if this is not
+ * a tabulated ephemeris
+ * \param useQueryCache Boolean denoting whether the states of the most recent queries are to be cached.
+ */
+void setTabulatedEphemerisQueryCache( const std::shared_ptr< Ephemeris > ephemeris, const bool useQueryCache );
+
 //! Function to create an empty (dummy) tabulated ephemeris
 /*!
  *  Function to create an empty (dummy) tabulated ephemeris. This is used when for instance propagating a body for which
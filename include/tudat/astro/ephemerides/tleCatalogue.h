@@ -0,0 +1,192 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Hoots, F.R., Roehrich, R.L. Models for Propagation of NORAD Element Sets, Spacetrack Report No. 3, 1980.
+ *      Vallado, D.A., Crawford, P., Hujsak, R., Kelso, T.S. Revisiting Spacetrack Report #3, AIAA 2006-6753, 2006.
+ *
+ */
+
+#ifndef TUDAT_TLE_CATALOGUE_H
+#define TUDAT_TLE_CATALOGUE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/ephemerides/tleEphemeris.h"
+
+namespace tudat
+{
+namespace ephemerides
+{
+
+//! Number of objects that are propagated simultaneously (in SIMD registers) by the TLE catalogue propagator.
+constexpr int SGP4_BATCH_LANE_WIDTH = 4;
+
+//! Class for the simultaneous propagation of the two-line elements of a catalogue of Earth-orbiting objects.
+/*!
+ * Class for the simultaneous propagation of the two-line elements (TLEs) of a catalogue of Earth-orbiting objects, as
+ * required for conjunction screening and catalogue-wide visibility computations. The SGP4 initialization (recovery of
+ * the un-Kozai'd mean motion and computation of the secular and drag coefficients) is performed once per object upon
+ * construction, and the results are stored in structure-of-arrays format (one contiguous array per coefficient), with
+ * the near-Earth objects stored in one contiguous block. The states of all objects at a given epoch are then computed
+ * SGP4_BATCH_LANE_WIDTH objects at a time, with all operations performed on fixed-size arrays (one entry, or lane, per
+ * object) so that they are vectorized by the compiler. Blocks of objects are distributed over the requested number of
+ * threads. The SGP4 model, and the WGS-72 constants, are identical to those used by the TleEphemeris class.
+ * Objects with an orbital period of 225 minutes or more require the deep-space SDP4 model, which is not yet
+ * implemented (as for TleEphemeris). These objects are identified and kept separate from the near-Earth objects upon
+ * construction, and their states are set to NaN.
+ */
+class TleCatalogue
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, classifies the objects as near-Earth or deep-space and initializes the SGP4 model of all near-Earth
+     * objects.
+     * \param tles List of two-line element sets of the objects in the catalogue.
+     * \param objectIds Identifiers (e.g. NORAD catalogue numbers) of the objects in the catalogue (default none, in which
+     * case the index in the list of TLEs is used).
+     * \param referenceFrameOrientation Orientation of the frame in which the states are provided (TEME, J2000 or
+     * ECLIPJ2000; default J2000). The frame origin is always the center of the Earth.
+     */
+    TleCatalogue( const std::vector< std::shared_ptr< Tle > >& tles,
+                  const std::vector< int >& objectIds = std::vector< int >( ),
+                  const std::string& referenceFrameOrientation = "J2000" );
+
+    //! Function to compute the Cartesian states of all objects in the catalogue at a given epoch.
+    /*!
+     * Function to compute the Cartesian states of all objects in the catalogue at a given epoch, in the order in which
+     * the objects were provided to the constructor. The rotation from the TEME frame to the requested frame is computed
+     * only once for all objects. The states of deep-space objects and of objects for which the SGP4 model failed
+     * (e.g. because the object has decayed, or the propagated eccentricity is invalid) are set to NaN.
+     * \param secondsSinceEpoch Seconds since J2000 epoch at which the states are to be computed.
+     * \param cartesianStates Cartesian states of all objects (N x 6, resized by function). Each component of the states
+     * of all objects is stored contiguously in one column. [Output]
+     * \param numberOfThreads Number of threads over which the objects are distributed (0 for all available threads).
+     * \return Number of objects for which no state could be computed (states set to NaN).
+     */
+    unsigned int getCartesianStates( const double secondsSinceEpoch,
+                                     Eigen::Matrix< double, Eigen::Dynamic, 6 >& cartesianStates,
+                                     const unsigned int numberOfThreads = 1 );
+
+    //! Function to retrieve the number of objects in the catalogue.
+    /*!
+     * Function to retrieve the number of objects in the catalogue.
+     * \return Number of objects in the catalogue.
+     */
+    int getNumberOfObjects( ) const
+    {
+        return static_cast< int >( tles_.size( ) );
+    }
+
+    //! Function to retrieve the two-line element sets of the objects in the catalogue.
+    /*!
+     * Function to retrieve the two-line element sets of the objects in the catalogue.
+     * \return Two-line element sets of the objects in the catalogue.
+     */
+    const std::vector< std::shared_ptr< Tle > >& getTles( ) const
+    {
+        return tles_;
+    }
+
+    //! Function to retrieve the identifiers of the objects in the catalogue.
+    /*!
+     * Function to retrieve the identifiers of the objects in the catalogue.
+     * \return Identifiers of the objects in the catalogue.
+     */
+    const std::vector< int >& getObjectIds( ) const
+    {
+        return objectIds_;
+    }
+
+    //! Function to retrieve the indices of the near-Earth objects, propagated with SGP4.
+    /*!
+     * Function to retrieve the indices (in the list of TLEs provided to the constructor) of the near-Earth objects,
+     * propagated with SGP4.
+     * \return Indices of the near-Earth objects.
+     */
+    const std::vector< int >& getNearEarthObjectIndices( ) const
+    {
+        return nearEarthObjectIndices_;
+    }
+
+    //! Function to retrieve the indices of the deep-space objects, which require SDP4.
+    /*!
+     * Function to retrieve the indices (in the list of TLEs provided to the constructor) of the deep-space objects,
+     * which require SDP4 and are not propagated.
+     * \return Indices of the deep-space objects.
+     */
+    const std::vector< int >& getDeepSpaceObjectIndices( ) const
+    {
+        return deepSpaceObjectIndices_;
+    }
+
+    //! Function to retrieve the orientation of the frame in which the states are provided.
+    /*!
+     * Function to retrieve the orientation of the frame in which the states are provided.
+     * \return Orientation of the frame in which the states are provided.
+     */
+    std::string getReferenceFrameOrientation( ) const
+    {
+        return referenceFrameOrientation_;
+    }
+
+private:
+
+    //! Function to perform the SGP4 initialization of all near-Earth objects.
+    void initializeNearEarthObjects( );
+
+    //! Two-line element sets of the objects in the catalogue.
+    std::vector< std::shared_ptr< Tle > > tles_;
+
+    //! Identifiers of the objects in the catalogue.
+    std::vector< int > objectIds_;
+
+    //! Orientation of the frame in which the states are provided.
+    std::string referenceFrameOrientation_;
+
+    //! Indices of the near-Earth objects (in the order in which they are stored in sgp4Coefficients_).
+    std::vector< int > nearEarthObjectIndices_;
+
+    //! Indices of the deep-space objects.
+    std::vector< int > deepSpaceObjectIndices_;
+
+    //! SGP4 elements and coefficients of the near-Earth objects, one object per row and one coefficient per column.
+    /*!
+     * SGP4 elements and coefficients of the near-Earth objects, one object per row and one coefficient per column
+     * (ordered as defined in the source file). The number of rows is padded to a multiple of SGP4_BATCH_LANE_WIDTH
+     * with copies of the last object, so that the lanes can be loaded directly from the (contiguous) columns.
+     */
+    Eigen::ArrayXXd sgp4Coefficients_;
+
+};
+
+//! Function to read a catalogue of two-line element sets from a text file.
+/*!
+ * Function to read a catalogue of two-line element sets from a text file, as distributed by e.g. CelesTrak and
+ * Space-Track, and parse the elements directly into a TleCatalogue. Both the two-line format and the three-line
+ * format (in which each element set is preceded by a line with the object name) are supported. The NORAD catalogue
+ * number of each object (columns 3-7 of the first line) is used as its identifier.
+ * \param fileName Name of the file containing the two-line element sets.
+ * \param referenceFrameOrientation Orientation of the frame in which the states are provided (TEME, J2000 or
+ * ECLIPJ2000; default J2000).
+ * \return Catalogue containing all element sets in the file.
+ */
+std::shared_ptr< TleCatalogue > readTleCatalogue( const std::string& fileName,
+                                                  const std::string& referenceFrameOrientation = "J2000" );
+
+} // namespace ephemerides
+} // namespace tudat
+
+#endif // TUDAT_TLE_CATALOGUE_H
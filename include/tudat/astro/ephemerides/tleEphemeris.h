@@ -175,6 +175,16 @@ private:
 
 };
 
+//! Function to compute the rotation matrix from the TEME frame to the J2000 frame.
+/*!
+ *  Function to compute the rotation matrix from the True Equator, Mean Equinox (TEME) frame, in which SGP4/SDP4 states are
+ *  expressed, to the J2000 frame. The TEME frame is first rotated to the True Of Date (TOD) frame by the equation of the
+ *  equinoxes, after which the inverse of the IAU 1976/1980 precession-nutation matrix is applied (Vallado, 2013).
+ *  \param secondsSinceEpoch Seconds since J2000 epoch at which the rotation matrix is to be evaluated.
+ *  \return Rotation matrix from TEME to J2000.
+ */
+Eigen::Matrix3d getRotationMatrixFromTemeToJ2000( const double secondsSinceEpoch );
+
 }
 }
 #endif //TUDAT_TLEEPHEMERIS_H
@@ -0,0 +1,273 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_MANY_BODY_POINT_MASS_GRAVITY_MODEL_H
+#define TUDAT_MANY_BODY_POINT_MASS_GRAVITY_MODEL_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/basic_astro/accelerationModel.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Class to compute the point-mass gravitational accelerations exerted by a set of bodies on a set of bodies in one pass.
+/*!
+ *  Class to compute the point-mass gravitational accelerations exerted by a set of bodies on a (large) set of bodies,
+ *  for instance the central body and third-body (Sun, Moon) accelerations on a constellation or debris cloud. The
+ *  positions of all bodies undergoing acceleration are retrieved once per update into a structure-of-arrays block
+ *  (one column per Cartesian component), and the positions and gravitational parameters of the bodies exerting
+ *  acceleration are retrieved once per update. The acceleration due to each body exerting acceleration is then
+ *  evaluated for all bodies undergoing acceleration with (vectorized) array operations. The results are identical (to
+ *  within round-off) to those of CentralGravitationalAccelerationModel3d and ThirdBodyCentralGravityAcceleration.
+ *  The accelerations on a single body due to a single body are retrieved through the
+ *  ManyBodyPointMassGravityAcceleration class.
+ */
+class ManyBodyPointMassGravityKernel
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param undergoingBodyPositionsFunction Function that sets the positions of all bodies undergoing acceleration
+     * (one row per body) into the input matrix.
+     * \param numberOfUndergoingBodies Number of bodies undergoing acceleration
+     * \param exertingBodyPositionFunctions List of functions returning the position of the bodies exerting acceleration
+     * \param exertingBodyGravitationalParameterFunctions List of functions returning the gravitational parameter of the
+     * bodies exerting acceleration
+     * \param isThirdBodyAcceleration List of booleans denoting whether the acceleration due to each body exerting
+     * acceleration is a third-body acceleration, i.e. whether the acceleration of the central body due to this body is
+     * to be subtracted.
+     * \param centralBodyPositionFunction Function returning the position of the central body (only used for
+     * third-body accelerations).
+     * \param centralBodyIndex Index of the central body in the list of bodies exerting acceleration (-1 if not
+     * in the list)
+     * \param undergoingBodyGravitationalParameterFunctions List of functions returning the gravitational parameter of
+     * the bodies undergoing acceleration, which is added to that of the central body for the acceleration due to the
+     * central body (empty function if body has no gravity field; list may be empty)
+     */
+    ManyBodyPointMassGravityKernel(
+            const std::function< void( Eigen::MatrixX3d& ) > undergoingBodyPositionsFunction,
+            const int numberOfUndergoingBodies,
+            const std::vector< std::function< void( Eigen::Vector3d& ) > >& exertingBodyPositionFunctions,
+            const std::vector< std::function< double( ) > >& exertingBodyGravitationalParameterFunctions,
+            const std::vector< bool >& isThirdBodyAcceleration,
+            const std::function< void( Eigen::Vector3d& ) > centralBodyPositionFunction =
+            [ ]( Eigen::Vector3d& input ){ input = Eigen::Vector3d::Zero( ); },
+            const int centralBodyIndex = -1,
+            const std::vector< std::function< double( ) > >& undergoingBodyGravitationalParameterFunctions =
+            std::vector< std::function< double( ) > >( ) );
+
+    //! Destructor
+    ~ManyBodyPointMassGravityKernel( ){ }
+
+    //! Function to update the accelerations on all bodies due to all bodies
+    /*!
+     * Function to update the accelerations on all bodies due to all bodies, if the model has not yet been updated to
+     * the current time.
+     * \param currentTime Time at which acceleration model is to be updated.
+     */
+    void updateMembers( const double currentTime = TUDAT_NAN );
+
+    //! Function to reset the current time
+    /*!
+     * Function to reset the current time of the model.
+     * \param currentTime Current time (default NaN).
+     */
+    void resetTime( const double currentTime = TUDAT_NAN )
+    {
+        currentTime_ = currentTime;
+    }
+
+    //! Function to retrieve the accelerations on all bodies due to a single body exerting acceleration
+    /*!
+     * Function to retrieve the accelerations on all bodies due to a single body exerting acceleration, as computed by
+     * last call to updateMembers
+     * \param exertingBodyIndex Index of body exerting acceleration
+     * \return Accelerations on all bodies undergoing acceleration (one row per body)
+     */
+    const Eigen::MatrixX3d& getAccelerations( const int exertingBodyIndex )
+    {
+        return currentAccelerations_.at( exertingBodyIndex );
+    }
+
+    //! Function to retrieve the current positions of all bodies undergoing acceleration (one row per body)
+    const Eigen::MatrixX3d& getUndergoingBodyPositions( )
+    {
+        return undergoingBodyPositions_;
+    }
+
+    //! Function to retrieve the number of bodies undergoing acceleration
+    int getNumberOfUndergoingBodies( )
+    {
+        return numberOfUndergoingBodies_;
+    }
+
+    //! Function to retrieve the number of bodies exerting acceleration
+    int getNumberOfExertingBodies( )
+    {
+        return static_cast< int >( exertingBodyPositionFunctions_.size( ) );
+    }
+
+    //! Function to retrieve whether the acceleration due to a given body exerting acceleration is a third-body acceleration
+    bool getIsThirdBodyAcceleration( const int exertingBodyIndex )
+    {
+        return isThirdBodyAcceleration_.at( exertingBodyIndex );
+    }
+
+private:
+
+    //! Function that sets the positions of all bodies undergoing acceleration (one row per body) into the input matrix.
+    std::function< void( Eigen::MatrixX3d& ) > undergoingBodyPositionsFunction_;
+
+    //! Number of bodies undergoing acceleration
+    int numberOfUndergoingBodies_;
+
+    //! List of functions returning the position of the bodies exerting acceleration
+    std::vector< std::function< void( Eigen::Vector3d& ) > > exertingBodyPositionFunctions_;
+
+    //! List of functions returning the gravitational parameter of the bodies exerting acceleration
+    std::vector< std::function< double( ) > > exertingBodyGravitationalParameterFunctions_;
+
+    //! List of booleans denoting whether the acceleration due to each body exerting acceleration is a third-body
+    //! acceleration.
+    std::vector< bool > isThirdBodyAcceleration_;
+
+    //! Function returning the position of the central body
+    std::function< void( Eigen::Vector3d& ) > centralBodyPositionFunction_;
+
+    //! Index of the central body in the list of bodies exerting acceleration (-1 if not in the list)
+    int centralBodyIndex_;
+
+    //! List of functions returning the gravitational parameter of the bodies undergoing acceleration
+    std::vector< std::function< double( ) > > undergoingBodyGravitationalParameterFunctions_;
+
+    //! Boolean denoting whether any of the bodies undergoing acceleration has a gravitational parameter to be added to
+    //! that of the central body
+    bool useMutualAttraction_;
+
+    //! Time to which model was last updated
+    double currentTime_;
+
+    //! Current positions of all bodies undergoing acceleration (one row per body)
+    Eigen::MatrixX3d undergoingBodyPositions_;
+
+    //! Current accelerations on all bodies undergoing acceleration, per body exerting acceleration
+    std::vector< Eigen::MatrixX3d > currentAccelerations_;
+
+    //! Pre-allocated relative positions of bodies undergoing acceleration w.r.t. body exerting acceleration
+    Eigen::MatrixX3d relativePositions_;
+
+    //! Pre-allocated cubed distances of bodies undergoing acceleration to body exerting acceleration
+    Eigen::ArrayXd cubedDistances_;
+
+    //! Pre-allocated gravitational parameters (including that of body undergoing acceleration) of central body
+    Eigen::ArrayXd mutualGravitationalParameters_;
+};
+
+//! Class for the point-mass gravitational acceleration on a single body, due to a single body, computed by a
+//! ManyBodyPointMassGravityKernel.
+/*!
+ *  Class for the point-mass gravitational acceleration on a single body, due to a single body, computed by a
+ *  ManyBodyPointMassGravityKernel, which is shared between all accelerations it computes. The kernel is updated
+ *  (for all bodies) by the first of these accelerations that is updated to a new time.
+ */
+class ManyBodyPointMassGravityAcceleration: public basic_astrodynamics::AccelerationModel< Eigen::Vector3d >
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param accelerationKernel Object computing the accelerations on all bodies due to all bodies
+     * \param undergoingBodyIndex Index of the body undergoing acceleration in kernel
+     * \param exertingBodyIndex Index of the body exerting acceleration in kernel
+     * \param centralBodyName Name of the central body w.r.t. which the acceleration is computed.
+     */
+    ManyBodyPointMassGravityAcceleration(
+            const std::shared_ptr< ManyBodyPointMassGravityKernel > accelerationKernel,
+            const int undergoingBodyIndex,
+            const int exertingBodyIndex,
+            const std::string& centralBodyName ):
+        accelerationKernel_( accelerationKernel ), undergoingBodyIndex_( undergoingBodyIndex ),
+        exertingBodyIndex_( exertingBodyIndex ), centralBodyName_( centralBodyName ){ }
+
+    //! Update member variables to current state.
+    /*!
+     *  Update member variables to current state.
+     * \param currentTime Time at which acceleration model is to be updated.
+     */
+    void updateMembers( const double currentTime = TUDAT_NAN )
+    {
+        if( !( this->currentTime_ == currentTime ) )
+        {
+            accelerationKernel_->updateMembers( currentTime );
+            currentAcceleration_ = accelerationKernel_->getAccelerations( exertingBodyIndex_ ).row(
+                        undergoingBodyIndex_ ).transpose( );
+            this->currentTime_ = currentTime;
+        }
+    }
+
+    //! Function to reset the current time
+    /*!
+     * Function to reset the current time of the acceleration model and the kernel
+     * \param currentTime Current time (default NaN).
+     */
+    void resetTime( const double currentTime = TUDAT_NAN )
+    {
+        this->currentTime_ = currentTime;
+        accelerationKernel_->resetTime( currentTime );
+    }
+
+    //! Function to retrieve object computing the accelerations on all bodies due to all bodies
+    std::shared_ptr< ManyBodyPointMassGravityKernel > getAccelerationKernel( )
+    {
+        return accelerationKernel_;
+    }
+
+    //! Function to retrieve whether the acceleration is a third-body acceleration
+    bool getIsThirdBodyAcceleration( )
+    {
+        return accelerationKernel_->getIsThirdBodyAcceleration( exertingBodyIndex_ );
+    }
+
+    //! Function to retrieve the name of the central body w.r.t. which the acceleration is computed.
+    std::string getCentralBodyName( )
+    {
+        return centralBodyName_;
+    }
+
+private:
+
+    //! Object computing the accelerations on all bodies due to all bodies
+    std::shared_ptr< ManyBodyPointMassGravityKernel > accelerationKernel_;
+
+    //! Index of the body undergoing acceleration in kernel
+    int undergoingBodyIndex_;
+
+    //! Index of the body exerting acceleration in kernel
+    int exertingBodyIndex_;
+
+    //! Name of the central body w.r.t. which the acceleration is computed.
+    std::string centralBodyName_;
+};
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_MANY_BODY_POINT_MASS_GRAVITY_MODEL_H
@@ -0,0 +1,317 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Heiskanen, W.A., Moritz, H. Physical geodesy. Freeman, 1967.
+ *      Holmes, S.A., Featherstone, W.E. A unified approach to the Clenshaw summation and the recursive computation of
+ *        very high degree and order normalised associated Legendre functions. Journal of Geodesy, 76, 2002.
+ *
+ */
+
+#ifndef TUDAT_SPHERICAL_HARMONICS_ACCELERATION_KERNEL_H
+#define TUDAT_SPHERICAL_HARMONICS_ACCELERATION_KERNEL_H
+
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace gravitation
+{
+
+//! Class to evaluate the acceleration due to a geodesy-normalized spherical harmonic gravity field, using an order-major
+//! coefficient layout.
+/*!
+ *  Class to evaluate the acceleration due to a geodesy-normalized spherical harmonic gravity field (same definition as
+ *  used in computeGeodesyNormalizedGravitationalAccelerationSum, which remains the reference implementation). Instead
+ *  of evaluating the field term-by-term through a LegendreCache/SphericalHarmonicsCache, the coefficients (and all
+ *  degree/order-dependent recursion multipliers) are stored contiguously per order, ordered by degree. The associated
+ *  Legendre functions are then computed order-by-order (column-wise, as described by Holmes & Featherstone, 2002) into
+ *  contiguous buffers, so that the summation over degree for each order reduces to a small number of dot products over
+ *  contiguous memory, which the compiler/Eigen can vectorize. The class holds its own scratch buffers, so that no memory
+ *  is allocated during an evaluation; consequently, a single object should not be used concurrently from multiple
+ *  threads. Contributions of separate degrees/orders are not available from this class.
+ */
+class SphericalHarmonicsAccelerationKernel
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor, sets the coefficients of the gravity field
+     *  \param cosineHarmonicCoefficients Geodesy-normalized cosine coefficients (entry (n,m) is degree n, order m).
+     *  \param sineHarmonicCoefficients Geodesy-normalized sine coefficients (entry (n,m) is degree n, order m).
+     */
+    SphericalHarmonicsAccelerationKernel(
+            const Eigen::MatrixXd& cosineHarmonicCoefficients,
+            const Eigen::MatrixXd& sineHarmonicCoefficients );
+
+    //! Function to reset the coefficients of the gravity field
+    /*!
+     *  Function to reset the coefficients of the gravity field. If the size of the coefficient matrices is unchanged
+     *  w.r.t. the current settings, only the packed coefficients are updated; otherwise all recursion multipliers and
+     *  scratch buffers are recomputed as well.
+     *  \param cosineHarmonicCoefficients Geodesy-normalized cosine coefficients (entry (n,m) is degree n, order m).
+     *  \param sineHarmonicCoefficients Geodesy-normalized sine coefficients (entry (n,m) is degree n, order m).
+     */
+    void resetCoefficients(
+            const Eigen::MatrixXd& cosineHarmonicCoefficients,
+            const Eigen::MatrixXd& sineHarmonicCoefficients );
+
+    //! Function to compute the gravitational acceleration at a single position
+    /*!
+     *  Function to compute the gravitational acceleration at a single position, equivalent to
+     *  computeGeodesyNormalizedGravitationalAccelerationSum (without saving separate terms).
+     *  \param bodyFixedPosition Position, in the frame in which the coefficients are defined, at which the acceleration
+     *  is to be computed.
+     *  \param gravitationalParameter Gravitational parameter of the gravity field
+     *  \param referenceRadius Reference radius of the gravity field
+     *  \param accelerationRotation Rotation matrix applied to the acceleration before it is returned (typically from
+     *  body-fixed to integration frame).
+     *  \return Gravitational acceleration, rotated by accelerationRotation
+     */
+    Eigen::Vector3d computeAcceleration(
+            const Eigen::Vector3d& bodyFixedPosition,
+            const double gravitationalParameter,
+            const double referenceRadius,
+            const Eigen::Matrix3d& accelerationRotation = Eigen::Matrix3d::Identity( ) );
+
+    //! Function to compute the gravitational acceleration at a list of positions
+    /*!
+     *  Function to compute the gravitational acceleration at a list of positions, with each column of the input
+     *  containing a single position. The positions are processed in blocks of BATCH_BLOCK_SIZE, for which the Legendre
+     *  recursion is evaluated simultaneously (with all positions of a block stored contiguously for each degree), and
+     *  the sum over degree for each order is computed as a matrix-vector product with the packed coefficients. In
+     *  this manner, the coefficients are loaded once per block, instead of once per position, and the inner loops are
+     *  vectorized over positions.
+     *  \param bodyFixedPositions Positions (one per column), in the frame in which the coefficients are defined, at which
+     *  the accelerations are to be computed.
+     *  \param gravitationalParameter Gravitational parameter of the gravity field
+     *  \param referenceRadius Reference radius of the gravity field
+     *  \param accelerations Gravitational accelerations (one per column) at the input positions (returned by reference)
+     */
+    void computeAccelerations(
+            const Eigen::Matrix3Xd& bodyFixedPositions,
+            const double gravitationalParameter,
+            const double referenceRadius,
+            Eigen::Matrix3Xd& accelerations );
+
+    //! Function to compute the gravitational acceleration at a list of positions
+    /*!
+     *  Function to compute the gravitational acceleration at a list of positions, with each column of the input
+     *  containing a single position.
+     *  \param bodyFixedPositions Positions (one per column), in the frame in which the coefficients are defined, at which
+     *  the accelerations are to be computed.
+     *  \param gravitationalParameter Gravitational parameter of the gravity field
+     *  \param referenceRadius Reference radius of the gravity field
+     *  \return Gravitational accelerations (one per column) at the input positions
+     */
+    Eigen::Matrix3Xd computeAccelerations(
+            const Eigen::Matrix3Xd& bodyFixedPositions,
+            const double gravitationalParameter,
+            const double referenceRadius );
+
+    //! Function to retrieve the number of degrees (maximum degree + 1) of the field
+    /*!
+     *  Function to retrieve the number of degrees (maximum degree + 1) of the field, i.e. number of rows of coefficient
+     *  matrices
+     *  \return Number of degrees (maximum degree + 1) of the field
+     */
+    int getNumberOfDegrees( )
+    {
+        return numberOfDegrees_;
+    }
+
+    //! Function to retrieve the number of orders (maximum order + 1) of the field
+    /*!
+     *  Function to retrieve the number of orders (maximum order + 1) of the field, i.e. number of columns of
+     *  coefficient matrices
+     *  \return Number of orders (maximum order + 1) of the field
+     */
+    int getNumberOfOrders( )
+    {
+        return numberOfOrders_;
+    }
+
+    //! Number of positions that are processed simultaneously by computeAccelerations
+    static constexpr int BATCH_BLOCK_SIZE = 16;
+
+private:
+
+    //! Function to compute the gradient of the potential in spherical coordinates (radius, latitude, longitude)
+    /*!
+     *  Function to compute the gradient of the potential in spherical coordinates (radius, latitude, longitude), in the
+     *  same form as computed by basic_mathematics::computePotentialGradient
+     *  \param radius Distance from origin
+     *  \param sineOfLatitude Sine of latitude
+     *  \param cosineOfLatitude Cosine of latitude
+     *  \param cosineOfLongitude Cosine of longitude
+     *  \param sineOfLongitude Sine of longitude
+     *  \param preMultiplier Gravitational parameter divided by reference radius
+     *  \param radiusRatio Reference radius divided by radius
+     *  \return Gradient of the potential in spherical coordinates
+     */
+    Eigen::Vector3d computeSphericalGradient(
+            const double radius,
+            const double sineOfLatitude,
+            const double cosineOfLatitude,
+            const double cosineOfLongitude,
+            const double sineOfLongitude,
+            const double preMultiplier,
+            const double radiusRatio );
+
+    //! Function to compute the gradients of the potential in spherical coordinates for a block of positions
+    /*!
+     *  Function to compute the gradients of the potential in spherical coordinates (radius, latitude, longitude) for a
+     *  block of BATCH_BLOCK_SIZE positions, in the same form as computeSphericalGradient. The spherical coordinates of
+     *  the positions must have been set in the batch buffers (batchRadii_, etc.) before calling this function.
+     *  \param preMultiplier Gravitational parameter divided by reference radius
+     *  \param sphericalGradients Gradients of the potential (one per column) for the block of positions [returned]
+     */
+    void computeSphericalGradientBlock(
+            const double preMultiplier,
+            Eigen::Matrix< double, 3, BATCH_BLOCK_SIZE >& sphericalGradients );
+
+    //! Function to compute the (geodesy-normalized) associated Legendre functions of a single order, for all degrees
+    /*!
+     *  Function to compute the (geodesy-normalized) associated Legendre functions of a single order, for all degrees
+     *  (starting at the sectoral term), using the column-wise recursion. The values are stored in the input buffer,
+     *  indexed by degree.
+     *  \param order Order of Legendre functions that are to be computed
+     *  \param sectoralValue Value of sectoral term (degree = order)
+     *  \param sineOfLatitude Sine of latitude
+     *  \param legendreFunctions Buffer (indexed by degree) in which the Legendre functions are stored
+     */
+    void computeLegendreFunctionsOfOrder(
+            const int order,
+            const double sectoralValue,
+            const double sineOfLatitude,
+            Eigen::VectorXd& legendreFunctions );
+
+    //! Function to compute the (geodesy-normalized) associated Legendre functions of a single order for a block of
+    //! positions
+    /*!
+     *  Function to compute the (geodesy-normalized) associated Legendre functions of a single order, for all degrees
+     *  (starting at the sectoral term), for a block of positions, using the column-wise recursion. The values are
+     *  stored in the input buffer, with one column per degree, and one row per position.
+     *  \param order Order of Legendre functions that are to be computed
+     *  \param sectoralValues Values of sectoral term (degree = order), per position
+     *  \param legendreFunctions Buffer (one column per degree) in which the Legendre functions are stored
+     */
+    void computeLegendreFunctionsOfOrderBlock(
+            const int order,
+            const Eigen::Array< double, BATCH_BLOCK_SIZE, 1 >& sectoralValues,
+            Eigen::Array< double, BATCH_BLOCK_SIZE, Eigen::Dynamic >& legendreFunctions );
+
+    //! Function to compute the recursion multipliers and allocate the scratch buffers for the current field size
+    void resetRecursionMultipliers( );
+
+    //! Number of degrees (maximum degree + 1) of the field
+    int numberOfDegrees_;
+
+    //! Number of orders (maximum order + 1) of the field
+    int numberOfOrders_;
+
+    //! Number of orders for which the Legendre function recursion multipliers are stored
+    int numberOfRecursionOrders_;
+
+    //! Start index of the data of each order in the packed vectors (with one additional entry for the final order + 1)
+    std::vector< int > orderStartIndices_;
+
+    //! Packed cosine coefficients (per order, for all degrees >= order)
+    Eigen::VectorXd packedCosineCoefficients_;
+
+    //! Packed sine coefficients (per order, for all degrees >= order)
+    Eigen::VectorXd packedSineCoefficients_;
+
+    //! Packed multipliers of degree n-1 term in column-wise Legendre recursion
+    Eigen::VectorXd packedFirstRecursionMultipliers_;
+
+    //! Packed multipliers of degree n-2 term in column-wise Legendre recursion
+    Eigen::VectorXd packedSecondRecursionMultipliers_;
+
+    //! Packed multipliers of P_{n,m+1} in Legendre function derivative
+    Eigen::VectorXd packedDerivativeMultipliers_;
+
+    //! Packed values of degree + 1 (multiplier for radial component of gradient)
+    Eigen::VectorXd packedDegreePlusOne_;
+
+    //! Multipliers for sectoral recursion P_{m,m} = f_m * cos(latitude) * P_{m-1,m-1}
+    std::vector< double > sectoralRecursionMultipliers_;
+
+    //! Buffer (indexed by degree) for powers (degree + 1) of reference radius divided by radius
+    Eigen::VectorXd radiusRatioPowers_;
+
+    //! Buffer (indexed by degree) for Legendre functions of current order
+    Eigen::VectorXd currentOrderLegendreFunctions_;
+
+    //! Buffer (indexed by degree) for Legendre functions of current order + 1
+    Eigen::VectorXd nextOrderLegendreFunctions_;
+
+    //! Buffer (per degree of current order) for Legendre functions, multiplied by radius ratio powers
+    Eigen::VectorXd weightedLegendreFunctions_;
+
+    //! Buffer (per degree of current order) for Legendre functions, multiplied by radius ratio powers and degree + 1
+    Eigen::VectorXd radialWeightedLegendreFunctions_;
+
+    //! Buffer (per degree of current order) for latitude derivatives of Legendre functions, multiplied by radius
+    //! ratio powers
+    Eigen::VectorXd weightedLegendreDerivatives_;
+
+    //! Typedef for a block of per-position values for computeAccelerations
+    typedef Eigen::Array< double, BATCH_BLOCK_SIZE, 1 > BlockValues;
+
+    //! Typedef for a block of per-position, per-degree values for computeAccelerations
+    typedef Eigen::Array< double, BATCH_BLOCK_SIZE, Eigen::Dynamic > BlockDegreeValues;
+
+    //! Distances from origin of current block of positions
+    BlockValues batchRadii_;
+
+    //! Sines of latitude of current block of positions
+    BlockValues batchSinesOfLatitude_;
+
+    //! Cosines of latitude of current block of positions
+    BlockValues batchCosinesOfLatitude_;
+
+    //! Cosines of longitude of current block of positions
+    BlockValues batchCosinesOfLongitude_;
+
+    //! Sines of longitude of current block of positions
+    BlockValues batchSinesOfLongitude_;
+
+    //! Reference radius divided by radius for current block of positions
+    BlockValues batchRadiusRatios_;
+
+    //! Block equivalent of radiusRatioPowers_ (one column per degree)
+    BlockDegreeValues batchRadiusRatioPowers_;
+
+    //! Block equivalent of currentOrderLegendreFunctions_ (one column per degree)
+    BlockDegreeValues batchCurrentOrderLegendreFunctions_;
+
+    //! Block equivalent of nextOrderLegendreFunctions_ (one column per degree)
+    BlockDegreeValues batchNextOrderLegendreFunctions_;
+
+    //! Block equivalent of weightedLegendreFunctions_ (one column per degree of current order)
+    BlockDegreeValues batchWeightedLegendreFunctions_;
+
+    //! Block equivalent of radialWeightedLegendreFunctions_ (one column per degree of current order)
+    BlockDegreeValues batchRadialWeightedLegendreFunctions_;
+
+    //! Block equivalent of weightedLegendreDerivatives_ (one column per degree of current order)
+    BlockDegreeValues batchWeightedLegendreDerivatives_;
+
+};
+
+} // namespace gravitation
+
+} // namespace tudat
+
+#endif // TUDAT_SPHERICAL_HARMONICS_ACCELERATION_KERNEL_H
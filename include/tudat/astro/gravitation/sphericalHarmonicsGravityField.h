@@ -139,6 +139,7 @@ public:
     void setCosineCoefficients( const Eigen::MatrixXd& cosineCoefficients )
     {
         cosineCoefficients_ = cosineCoefficients;
+        coefficientUpdateCounter_++;
 
         if( !( updateInertiaTensor_ == nullptr ) )
         {
@@ -154,6 +155,7 @@ public:
     void setSineCoefficients( const Eigen::MatrixXd& sineCoefficients )
     {
         sineCoefficients_ = sineCoefficients;
+        coefficientUpdateCounter_++;
         if( !( updateInertiaTensor_ == nullptr ) )
         {
             updateInertiaTensor_( );
@@ -188,6 +190,18 @@ public:
         return sineCoefficients_.block( 0, 0, maximumDegree + 1, maximumOrder + 1 );
     }
 
+    //! Function to get the number of times the coefficients have been modified
+    /*!
+     *  Function to get the number of times the coefficients have been modified since the creation of this object. Used by
+     *  models that preprocess the coefficients (e.g. SphericalHarmonicsAccelerationKernel) to detect whether this
+     *  preprocessing needs to be redone.
+     *  \return Number of times the coefficients have been modified
+     */
+    unsigned int getCoefficientUpdateCounter( )
+    {
+        return coefficientUpdateCounter_;
+    }
+
     //! Get maximum degree of spherical harmonics gravity field expansion.
     /*!
      *  Returns the maximum degree of the spherical harmonics gravity field expansion.
@@ -335,6 +349,9 @@ protected:
      */
     Eigen::MatrixXd sineCoefficients_;
 
+    //! Number of times the coefficients have been modified (to be incremented by any function modifying them)
+    unsigned int coefficientUpdateCounter_ = 0;
+
     //! Identifier for body-fixed reference frame
     /*!
      *  Identifier for body-fixed reference frame
@@ -25,6 +25,7 @@
 #include <Eigen/Geometry>
 
 #include "tudat/astro/basic_astro/accelerationModel.h"
+#include "tudat/astro/gravitation/sphericalHarmonicsAccelerationKernel.h"
 #include "tudat/astro/gravitation/sphericalHarmonicsGravityModelBase.h"
 #include "tudat/math/basic/sphericalHarmonics.h"
 
@@ -219,7 +220,8 @@ public:
           rotationFromBodyFixedToIntegrationFrameFunction_(
               rotationFromBodyFixedToIntegrationFrameFunction ),
           sphericalHarmonicsCache_( sphericalHarmonicsCache ),
-          saveSphericalHarmonicTermsSeparately_( false )
+          saveSphericalHarmonicTermsSeparately_( false ),
+          coefficientUpdateCounterFunction_( [ ]( ){ return 0u; } )
     {
         maximumDegree_ = static_cast< int >( getCosineHarmonicsCoefficients( ).rows( ) );
         maximumOrder_ = static_cast< int >( getCosineHarmonicsCoefficients( ).cols( ) );
@@ -315,9 +317,6 @@ public:
         if( !( this->currentTime_ == currentTime ) )
         {
 
-            cosineHarmonicCoefficients = getCosineHarmonicsCoefficients( );
-            sineHarmonicCoefficients = getSineHarmonicsCoefficients( );
-
             rotationToIntegrationFrame_ = rotationFromBodyFixedToIntegrationFrameFunction_( );
             this->updateBaseMembers( );
 
@@ -327,16 +326,44 @@ public:
             currentRelativePosition_ = rotationToIntegrationFrame_.inverse( ) * (
                         currentInertialRelativePosition_ );
 
-            currentAcceleration_ =
-                    computeGeodesyNormalizedGravitationalAccelerationSum(
-                        currentRelativePosition_,
-                        gravitationalParameter,
-                        equatorialRadius,
-                        cosineHarmonicCoefficients,
-                        sineHarmonicCoefficients, sphericalHarmonicsCache_,
-                        accelerationPerTerm_,
-                        saveSphericalHarmonicTermsSeparately_,
-                        rotationToIntegrationFrame_.toRotationMatrix( ) );
+            if( accelerationKernel_ != nullptr && !saveSphericalHarmonicTermsSeparately_ )
+            {
+                // Repack coefficients into kernel only if they (may) have changed since the last repack
+                if( coefficientUpdateCounterFunction_ == nullptr || !areKernelCoefficientsSet_ ||
+                        coefficientUpdateCounterFunction_( ) != kernelCoefficientUpdateCounter_ )
+                {
+                    if( coefficientUpdateCounterFunction_ != nullptr )
+                    {
+                        kernelCoefficientUpdateCounter_ = coefficientUpdateCounterFunction_( );
+                    }
+                    accelerationKernel_->resetCoefficients(
+                                getCosineHarmonicsCoefficients( ), getSineHarmonicsCoefficients( ) );
+                    areKernelCoefficientsSet_ = true;
+                }
+
+                currentAcceleration_ =
+                        accelerationKernel_->computeAcceleration(
+                            currentRelativePosition_,
+                            gravitationalParameter,
+                            equatorialRadius,
+                            rotationToIntegrationFrame_.toRotationMatrix( ) );
+            }
+            else
+            {
+                cosineHarmonicCoefficients = getCosineHarmonicsCoefficients( );
+                sineHarmonicCoefficients = getSineHarmonicsCoefficients( );
+
+                currentAcceleration_ =
+                        computeGeodesyNormalizedGravitationalAccelerationSum(
+                            currentRelativePosition_,
+                            gravitationalParameter,
+                            equatorialRadius,
+                            cosineHarmonicCoefficients,
+                            sineHarmonicCoefficients, sphericalHarmonicsCache_,
+                            accelerationPerTerm_,
+                            saveSphericalHarmonicTermsSeparately_,
+                            rotationToIntegrationFrame_.toRotationMatrix( ) );
+            }
             currentAccelerationInBodyFixedFrame_ = rotationToIntegrationFrame_.inverse( ) * currentAcceleration_;
         }
     }
@@ -493,6 +520,55 @@ public:
         saveSphericalHarmonicTermsSeparately_ = saveSphericalHarmonicTermsSeparately;
     }
 
+    //! Function to set whether the acceleration is to be computed using the SphericalHarmonicsAccelerationKernel
+    /*!
+     * Function to set whether the acceleration is to be computed using the SphericalHarmonicsAccelerationKernel (which
+     * uses an order-major coefficient layout and is significantly faster for high degree/order fields), instead of the
+     * (reference) computeGeodesyNormalizedGravitationalAccelerationSum function. The kernel is not used if the separate
+     * spherical harmonic terms are to be saved. Note that, when using the kernel, the sphericalHarmonicsCache_ is not
+     * updated when updating this acceleration model.
+     * \param useAccelerationKernel Boolean denoting whether the SphericalHarmonicsAccelerationKernel is to be used
+     */
+    void setUseAccelerationKernel( const bool useAccelerationKernel )
+    {
+        if( useAccelerationKernel && accelerationKernel_ == nullptr )
+        {
+            accelerationKernel_ = std::make_shared< SphericalHarmonicsAccelerationKernel >(
+                        getCosineHarmonicsCoefficients( ), getSineHarmonicsCoefficients( ) );
+        }
+        else if( !useAccelerationKernel )
+        {
+            accelerationKernel_ = nullptr;
+        }
+        areKernelCoefficientsSet_ = false;
+        this->resetTime( );
+    }
+
+    //! Function to set the function returning the number of times the gravity field coefficients have been modified
+    /*!
+     * Function to set the function returning the number of times the gravity field coefficients have been modified
+     * (typically SphericalHarmonicsGravityField::getCoefficientUpdateCounter). When set, the coefficients are only
+     * retrieved and repacked into the SphericalHarmonicsAccelerationKernel when this number changes, instead of at each
+     * update of this acceleration model. The function must be consistent with the coefficient functions of this
+     * model, i.e. the returned number must change whenever the retrieved coefficients change.
+     * \param coefficientUpdateCounterFunction Function returning the number of times the coefficients have been modified
+     */
+    void setCoefficientUpdateCounterFunction( const std::function< unsigned int( ) > coefficientUpdateCounterFunction )
+    {
+        coefficientUpdateCounterFunction_ = coefficientUpdateCounterFunction;
+        areKernelCoefficientsSet_ = false;
+    }
+
+    //! Function to retrieve whether the acceleration is computed using the SphericalHarmonicsAccelerationKernel
+    /*!
+     * Function to retrieve whether the acceleration is computed using the SphericalHarmonicsAccelerationKernel
+     * \return Boolean denoting whether the SphericalHarmonicsAccelerationKernel is used
+     */
+    bool getUseAccelerationKernel( )
+    {
+        return ( accelerationKernel_ != nullptr );
+    }
+
     //! Function to retrieve the contributions of separate degrees/ordesr to the acceleration, concatenated in a single vector
     /*!
      * Function to retrieve the contributions of specific separate degree/order to the acceleration, concatenated in a single
@@ -633,6 +709,18 @@ private:
     //! Boolean that denotes whether each of the separate spherical harmonic terms should be saved (in accelerationPerTerm_)
     bool saveSphericalHarmonicTermsSeparately_;
 
+    //! Kernel used to compute the acceleration (if nullptr, computeGeodesyNormalizedGravitationalAccelerationSum is used)
+    std::shared_ptr< SphericalHarmonicsAccelerationKernel > accelerationKernel_;
+
+    //! Function returning the number of times the gravity field coefficients have been modified (empty if not known)
+    std::function< unsigned int( ) > coefficientUpdateCounterFunction_;
+
+    //! Value of coefficientUpdateCounterFunction_ when the coefficients were last repacked into accelerationKernel_
+    unsigned int kernelCoefficientUpdateCounter_ = 0;
+
+    //! Boolean denoting whether coefficients have been packed into accelerationKernel_ since its (re)creation
+    bool areKernelCoefficientsSet_ = false;
+
     //! Maximum degree of gravity field expansion
     int maximumDegree_;
 
@@ -0,0 +1,108 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Izzo, D. Revisiting Lambert's problem, Celestial Mechanics and Dynamical Astronomy, 121:1-15, 2015.
+ *      Izzo, D. lambert_problem.cpp, pykep.
+ *
+ */
+
+#ifndef TUDAT_BATCH_LAMBERT_ROUTINES_H
+#define TUDAT_BATCH_LAMBERT_ROUTINES_H
+
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/ephemerides/ephemeris.h"
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+//! Number of Lambert problems that are solved simultaneously (in SIMD registers) by the batch Lambert solver.
+constexpr int LAMBERT_BATCH_LANE_WIDTH = 4;
+
+//! Solve a batch of zero-revolution Lambert problems using Izzo's (2015) algorithm.
+/*!
+ * Solves a batch of zero-revolution Lambert problems using the algorithm of Izzo (2015), in which the time-of-flight
+ * equation is solved for the universal x-variable by Householder (third-order) iterations. The problems are solved
+ * LAMBERT_BATCH_LANE_WIDTH at a time, with all operations performed on fixed-size arrays (one entry, or lane, per
+ * problem) so that they are vectorized by the compiler. The iterations of each lane are stopped (masked) when it has
+ * converged, and the block terminates when all lanes have converged. Blocks of problems are distributed over the
+ * requested number of threads. The input and output are provided in structure-of-arrays format: one row per problem,
+ * with the x, y and z components of all problems stored contiguously in the three columns.
+ * The transfer direction is determined as in solveLambertProblemIzzo: prograde w.r.t. the z-axis (unless isRetrograde
+ * is true). Rather than throwing an exception, the velocities of problems with invalid input (non-positive
+ * time-of-flight, or collinear position vectors) or for which the iterations did not converge are set to NaN.
+ * \param cartesianPositionsAtDeparture Cartesian positions at departure (N x 3). [Input]
+ * \param cartesianPositionsAtArrival Cartesian positions at arrival (N x 3). [Input]
+ * \param timesOfFlight Times-of-flight between departure and arrival (size N). [Input]
+ * \param gravitationalParameters Gravitational parameters of the central body (size N, or size 1 if equal for all
+ *          problems). [Input]
+ * \param cartesianVelocitiesAtDeparture Velocities at departure (N x 3, resized by function). [Output]
+ * \param cartesianVelocitiesAtArrival Velocities at arrival (N x 3, resized by function). [Output]
+ * \param isRetrograde Boolean flag to indicate direction of motion. [Input, Optional]
+ * \param convergenceTolerance Convergence tolerance on the change in x-variable per iteration. Due to the third-order
+ *          convergence, the error in x after convergence is much smaller than this tolerance. [Input, Optional]
+ * \param maximumNumberOfIterations Maximum number of Householder iterations. [Input, Optional]
+ * \param numberOfThreads Number of threads over which the problems are distributed (0 for all available threads).
+ *          [Input, Optional]
+ * \return Number of problems for which no solution was found (velocities set to NaN).
+ */
+unsigned int solveLambertProblemsIzzo(
+        const Eigen::Ref< const Eigen::Matrix< double, Eigen::Dynamic, 3 > >& cartesianPositionsAtDeparture,
+        const Eigen::Ref< const Eigen::Matrix< double, Eigen::Dynamic, 3 > >& cartesianPositionsAtArrival,
+        const Eigen::Ref< const Eigen::VectorXd >& timesOfFlight,
+        const Eigen::Ref< const Eigen::VectorXd >& gravitationalParameters,
+        Eigen::Matrix< double, Eigen::Dynamic, 3 >& cartesianVelocitiesAtDeparture,
+        Eigen::Matrix< double, Eigen::Dynamic, 3 >& cartesianVelocitiesAtArrival,
+        const bool isRetrograde = false,
+        const double convergenceTolerance = 1.0E-5,
+        const unsigned int maximumNumberOfIterations = 15,
+        const unsigned int numberOfThreads = 1 );
+
+//! Compute the departure and arrival excess velocities of Lambert transfers for a grid of departure and arrival times.
+/*!
+ * Computes the departure and arrival excess velocities (magnitude of velocity w.r.t. the departure and arrival body)
+ * of the zero-revolution Lambert transfers between two bodies for each combination of departure and arrival time, as
+ * used for porkchop plots and launch window scans. The states of the departure and arrival bodies are computed only
+ * once per epoch (using the batched Ephemeris::getCartesianStates), after which the Lambert problems are solved with
+ * the same SIMD-wide algorithm as solveLambertProblemsIzzo, without storing the intermediate positions of all pairs.
+ * Each departure time is a separate task for the thread pool. Combinations for which the arrival time does not exceed
+ * the departure time, or for which no solution is found, have NaN excess velocities.
+ * \param departureBodyEphemeris Ephemeris of departure body w.r.t. the central body. [Input]
+ * \param arrivalBodyEphemeris Ephemeris of arrival body w.r.t. the central body. [Input]
+ * \param departureTimes Departure times (size N). [Input]
+ * \param arrivalTimes Arrival times (size M). [Input]
+ * \param centralBodyGravitationalParameter Gravitational parameter of the central body. [Input]
+ * \param departureExcessVelocities Departure excess velocities (N x M, resized by function). [Output]
+ * \param arrivalExcessVelocities Arrival excess velocities (N x M, resized by function). [Output]
+ * \param numberOfThreads Number of threads over which the departure times are distributed (0 for all available
+ *          threads). [Input, Optional]
+ * \param isRetrograde Boolean flag to indicate direction of motion. [Input, Optional]
+ * \return Number of combinations with arrival after departure for which no solution was found.
+ */
+unsigned int computeLambertTransferGridExcessVelocities(
+        const std::shared_ptr< ephemerides::Ephemeris > departureBodyEphemeris,
+        const std::shared_ptr< ephemerides::Ephemeris > arrivalBodyEphemeris,
+        const std::vector< double >& departureTimes,
+        const std::vector< double >& arrivalTimes,
+        const double centralBodyGravitationalParameter,
+        Eigen::MatrixXd& departureExcessVelocities,
+        Eigen::MatrixXd& arrivalExcessVelocities,
+        const unsigned int numberOfThreads = 1,
+        const bool isRetrograde = false );
+
+} // namespace mission_segments
+} // namespace tudat
+
+#endif // TUDAT_BATCH_LAMBERT_ROUTINES_H
@@ -23,6 +23,7 @@
 #ifndef TUDAT_CREATE_TRANSFER_TRAJECTORY_H
 #define TUDAT_CREATE_TRANSFER_TRAJECTORY_H
 
+#include <functional>
 #include <map>
 
 #include <boost/make_shared.hpp>
@@ -228,6 +229,48 @@ std::shared_ptr< TransferTrajectory > createTransferTrajectory(const simulation_
         const std::vector< std::string >& nodeIds,
         const std::string& centralBody);
 
+//! Function to create a transfer trajectory object for each thread, for concurrent evaluation of a population
+/*!
+ * Function to create a transfer trajectory object for each thread, for use in evaluateTransferTrajectoryPopulation.
+ * Since ephemerides may store their current state, each trajectory is created from a separate environment.
+ * \param bodiesCreationFunction Function creating a new environment, called once per thread
+ * \param legSettings Settings for the legs of the trajectory
+ * \param nodeSettings Settings for the nodes of the trajectory
+ * \param nodeIds Names of the bodies at the nodes of the trajectory
+ * \param centralBody Name of the central body of the transfer
+ * \param numberOfThreads Number of threads (0 denotes all available threads)
+ * \return Transfer trajectory object for each thread
+ */
+std::vector< std::shared_ptr< TransferTrajectory > > createTransferTrajectoriesPerThread(
+        const std::function< simulation_setup::SystemOfBodies( ) > bodiesCreationFunction,
+        const std::vector< std::shared_ptr< TransferLegSettings > >& legSettings,
+        const std::vector< std::shared_ptr< TransferNodeSettings > >& nodeSettings,
+        const std::vector< std::string >& nodeIds,
+        const std::string& centralBody,
+        const unsigned int numberOfThreads );
+
+//! Function to determine, for each node of a transfer trajectory, whether it computes its outgoing velocity
+/*!
+ * Function to determine, for each node of a transfer trajectory, whether it computes its outgoing velocity (from its
+ * free parameters). This is the case for nodes of which the outgoing leg requires the departure velocity as input, and
+ * for the final node, unless it is a capture node.
+ * \param legSettings Settings for each leg
+ * \param nodeSettings Settings for each node
+ * \return Boolean denoting for each node whether it computes its outgoing velocity
+ */
+std::vector< bool > getTransferNodesComputingOutgoingVelocity(
+        const std::vector< std::shared_ptr< TransferLegSettings > >& legSettings,
+        const std::vector< std::shared_ptr< TransferNodeSettings > >& nodeSettings );
+
+//! Function to compute the indices of the free parameters of each node and leg in the full vector of trajectory parameters
+/*!
+ * Function to compute the indices of the free parameters of each node and leg in the full vector of trajectory parameters,
+ * from the leg and node settings (see overload taking leg types, which defines the layout).
+ * \param legSettings Settings for each leg
+ * \param nodeSettings Settings for each node
+ * \param legParameterIndices Start index and size of free parameters of each leg (returned by reference)
+ * \param nodeParameterIndices Start index and size of free parameters of each node (returned by reference)
+ */
 void getParameterVectorDecompositionIndices(
         const std::vector< std::shared_ptr< TransferLegSettings > >& legSettings,
         const std::vector< std::shared_ptr< TransferNodeSettings > >& nodeSettings,
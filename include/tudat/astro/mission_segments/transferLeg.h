@@ -97,7 +97,7 @@ public:
 
     virtual ~TransferLeg( ){ }
 
-    void updateLegParameters( const Eigen::VectorXd legParameters );
+    void updateLegParameters( const Eigen::VectorXd& legParameters );
 
     double getLegDeltaV( );
 
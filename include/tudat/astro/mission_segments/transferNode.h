@@ -54,7 +54,7 @@ public:
 
     virtual ~TransferNode( ){ }
 
-    void updateNodeParameters( const Eigen::VectorXd nodeParameters );
+    void updateNodeParameters( const Eigen::VectorXd& nodeParameters );
 
     double getNodeDeltaV( );
 
@@ -23,6 +23,10 @@
 #ifndef TUDAT_TRANSFER_TRAJECTORY_H
 #define TUDAT_TRANSFER_TRAJECTORY_H
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include <boost/make_shared.hpp>
 
 #include <Eigen/Core>
@@ -36,6 +40,34 @@ namespace tudat
 namespace mission_segments
 {
 
+//! Function to retrieve the number of free parameters of a transfer leg of a given type
+/*!
+ * Function to retrieve the number of free parameters of a transfer leg of a given type (in addition to its departure and
+ * arrival times).
+ * \param legType Type of transfer leg
+ * \return Number of free parameters of the transfer leg
+ */
+int getNumberOfTransferLegFreeParameters( const TransferLegTypes legType );
+
+//! Function to compute the indices of the free parameters of each node and leg in the full vector of trajectory parameters
+/*!
+ * Function to compute the indices of the free parameters of each node and leg in the full vector of trajectory parameters.
+ * The first entries of this vector are the time of the first node and the time of flight of each leg (one entry per
+ * node), followed by the free parameters of each node and leg, ordered as node 0, leg 0, node 1, leg 1, ... A node has
+ * three free parameters if it computes its outgoing velocity, and none otherwise. This function defines the layout used
+ * by both TransferTrajectory::evaluateTrajectory and the settings-based getParameterVectorDecompositionIndices.
+ * \param legTypes Type of each leg
+ * \param nodesComputeOutgoingVelocity Boolean denoting for each node whether it computes its outgoing velocity
+ * \param legParameterIndices Start index and size of free parameters of each leg (returned by reference)
+ * \param nodeParameterIndices Start index and size of free parameters of each node (returned by reference)
+ * \return Size of the full vector of trajectory parameters
+ */
+int getParameterVectorDecompositionIndices(
+        const std::vector< TransferLegTypes >& legTypes,
+        const std::vector< bool >& nodesComputeOutgoingVelocity,
+        std::vector< std::pair< int, int > >& legParameterIndices,
+        std::vector< std::pair< int, int > >& nodeParameterIndices );
+
 class TransferTrajectory
 {
 public:
@@ -47,6 +79,7 @@ public:
         legs_( legs ), nodes_( nodes ), isComputed_( false )
     {
         totalDeltaV_ = 0.0;
+        setTrajectoryParameterIndices( );
     }
 
     //! Update trajectory with new independent variables
@@ -55,6 +88,18 @@ public:
             const std::vector< Eigen::VectorXd >& legFreeParameters,
             const std::vector< Eigen::VectorXd >& nodeFreeParameters );
 
+    //! Update trajectory with new independent variables, provided as a single vector
+    /*!
+     * Update trajectory with new independent variables, provided as a single vector (e.g. the decision vector of an
+     * optimizer). The first entry is the time of the first node, followed by the time of flight of each leg, followed by
+     * the free parameters of each node and leg, ordered as node 0, leg 0, node 1, leg 1, ..., as defined by
+     * getParameterVectorDecompositionIndices. The evaluation uses buffers created at construction, so it does not
+     * allocate memory. Since the legs and nodes store the evaluated trajectory, a single object must not be evaluated by
+     * multiple threads concurrently (see evaluateTransferTrajectoryPopulation).
+     * \param trajectoryParameters Full vector of trajectory parameters (size getNumberOfTrajectoryParameters( ))
+     */
+    void evaluateTrajectory( const Eigen::Ref< const Eigen::VectorXd >& trajectoryParameters );
+
     //! Retrieve total trajectory Delta V
     double getTotalDeltaV( );
 
@@ -78,6 +123,12 @@ public:
         return legs_.size( );
     }
 
+    //! Function to retrieve the size of the full vector of trajectory parameters (see evaluateTrajectory)
+    int getNumberOfTrajectoryParameters( )
+    {
+        return numberOfTrajectoryParameters_;
+    }
+
     //! Get Cartesian position and velocity along full trajectory
     void getStatesAlongTrajectoryPerLeg( std::vector< std::map< double, Eigen::Vector6d > >& statesAlongTrajectoryPerLeg,
                                         const int numberOfDataPointsPerLeg );
@@ -136,17 +187,23 @@ public:
 
 private:
 
+    //! Set the indices and sizes of the free parameters of each node and leg in the full vector of trajectory parameters
+    void setTrajectoryParameterIndices( );
+
+    //! Update legs and nodes with full set of parameters (legTotalParameters_ and nodeTotalParameters_)
+    void updateLegsAndNodes( );
+
     //! Retrieve full set of parameters for single leg
     void getLegTotalParameters(
             const std::vector< double >& nodeTimes,
-            const Eigen::VectorXd& legFreeParameters,
+            const Eigen::Ref< const Eigen::VectorXd >& legFreeParameters,
             const int legIndex,
             Eigen::VectorXd& legTotalParameters );
 
     //! Retrieve full set of parameters for single node
     void getNodeTotalParameters(
             const std::vector< double >& nodeTimes,
-            const Eigen::VectorXd& nodeFreeParameters,
+            const Eigen::Ref< const Eigen::VectorXd >& nodeFreeParameters,
             const int nodeIndex,
             Eigen::VectorXd& nodeTotalParameters );
 
@@ -164,8 +221,44 @@ private:
 
     //! Boolean defining whether the object is in a valid state (trajectory parameters have been set)
     bool isComputed_;
+
+    //! Start index and size of free parameters of each leg in full vector of trajectory parameters
+    std::vector< std::pair< int, int > > legFreeParameterIndices_;
+
+    //! Start index and size of free parameters of each node in full vector of trajectory parameters
+    std::vector< std::pair< int, int > > nodeFreeParameterIndices_;
+
+    //! Size of full vector of trajectory parameters
+    int numberOfTrajectoryParameters_;
+
+    //! Node times of current evaluation (buffer for evaluation from full vector of trajectory parameters)
+    std::vector< double > nodeTimes_;
+
+    //! Full set of parameters of each leg for current evaluation
+    std::vector< Eigen::VectorXd > legTotalParameters_;
+
+    //! Full set of parameters of each node for current evaluation
+    std::vector< Eigen::VectorXd > nodeTotalParameters_;
 };
 
+//! Function to evaluate the total Delta V of a population of transfer trajectories, distributed over a number of threads
+/*!
+ * Function to evaluate the total Delta V of a population of transfer trajectories (e.g. a population of an evolutionary
+ * optimizer), distributed over a number of threads. Since a TransferTrajectory object stores the evaluated trajectory
+ * (and its ephemerides may store their current state), each thread uses its own TransferTrajectory object, with its
+ * own ephemerides, which are created once (see createTransferTrajectoriesPerThread) and reused for all evaluations.
+ * Each individual is evaluated from its full vector of trajectory parameters (see TransferTrajectory::evaluateTrajectory),
+ * and the results are identical to those of a sequential evaluation.
+ * \param transferTrajectoriesPerThread Transfer trajectory object for each thread (defining the number of threads);
+ * all objects must be created from the same settings
+ * \param trajectoryParameters Full vector of trajectory parameters of each individual (one column per individual)
+ * \param totalDeltaV Total Delta V of each individual (resized by function) (returned by reference)
+ */
+void evaluateTransferTrajectoryPopulation(
+        const std::vector< std::shared_ptr< TransferTrajectory > >& transferTrajectoriesPerThread,
+        const Eigen::Ref< const Eigen::MatrixXd >& trajectoryParameters,
+        Eigen::VectorXd& totalDeltaV );
+
 
 } // namespace mission_segments
 
@@ -14,6 +14,7 @@
 #include "orbit_determination/acceleration_partials/accelerationPartial.h"
 #include "orbit_determination/acceleration_partials/aerodynamicAccelerationPartial.h"
 #include "orbit_determination/acceleration_partials/centralGravityAccelerationPartial.h"
+#include "orbit_determination/acceleration_partials/customAccelerationPartial.h"
 #include "orbit_determination/acceleration_partials/directTidalDissipationAccelerationPartial.h"
 #include "orbit_determination/acceleration_partials/empiricalAccelerationPartial.h"
 #include "orbit_determination/acceleration_partials/mutualSphericalHarmonicGravityPartial.h"
@@ -0,0 +1,219 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_CUSTOMACCELERATIONPARTIAL_H
+#define TUDAT_CUSTOMACCELERATIONPARTIAL_H
+
+#include "tudat/astro/basic_astro/customAccelerationModel.h"
+
+#include "tudat/astro/orbit_determination/acceleration_partials/accelerationPartial.h"
+
+namespace tudat
+{
+
+namespace acceleration_partials
+{
+
+//! Class to calculate the partials of a state-dependent custom acceleration w.r.t. states.
+/*!
+ * Class to calculate the partials of a state-dependent custom acceleration w.r.t. the states of the bodies undergoing and
+ * exerting the acceleration. The partials w.r.t. the relative state are computed exactly (to round-off) by forward-mode
+ * automatic differentiation of the user-defined acceleration function, in a single evaluation of this function with dual
+ * numbers, replacing the numerical differentiation (12 evaluations for central differences) that would otherwise be needed.
+ */
+class CustomAccelerationPartial: public AccelerationPartial
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param customAcceleration State-dependent custom acceleration model, with differentiable acceleration function.
+     * \param acceleratedBody Body undergoing acceleration.
+     * \param acceleratingBody Body exerting acceleration.
+     */
+    CustomAccelerationPartial(
+            const std::shared_ptr< basic_astrodynamics::CustomAccelerationModel > customAcceleration,
+            const std::string acceleratedBody,
+            const std::string acceleratingBody );
+
+    //! Function for calculating the partial of the acceleration w.r.t. the position of body undergoing acceleration..
+    /*!
+     *  Function for calculating the partial of the acceleration w.r.t. the position of body undergoing acceleration
+     *  and adding it to the existing partial block
+     *  Update( ) function must have been called during current time step before calling this function.
+     *  \param partialMatrix Block of partial derivatives of acceleration w.r.t. Cartesian position of body
+     *  undergoing acceleration where current partial is to be added.
+     *  \param addContribution Variable denoting whether to return the partial itself (true) or the negative partial (false).
+     *  \param startRow First row in partialMatrix block where the computed partial is to be added.
+     *  \param startColumn First column in partialMatrix block where the computed partial is to be added.
+     */
+    void wrtPositionOfAcceleratedBody(
+            Eigen::Block< Eigen::MatrixXd > partialMatrix,
+            const bool addContribution = 1, const int startRow = 0, const int startColumn = 0 )
+    {
+        if( addContribution )
+        {
+            partialMatrix.block( startRow, startColumn, 3, 3 ) += currentAccelerationStatePartials_.block( 0, 0, 3, 3 );
+        }
+        else
+        {
+            partialMatrix.block( startRow, startColumn, 3, 3 ) -= currentAccelerationStatePartials_.block( 0, 0, 3, 3 );
+        }
+    }
+
+    //! Function for calculating the partial of the acceleration w.r.t. the velocity of body undergoing acceleration..
+    /*!
+     *  Function for calculating the partial of the acceleration w.r.t. the velocity of body undergoing acceleration
+     *  and adding it to the existing partial block
+     *  Update( ) function must have been called during current time step before calling this function.
+     *  \param partialMatrix Block of partial derivatives of acceleration w.r.t. Cartesian velocity of body
+     *  undergoing acceleration where current partial is to be added.
+     *  \param addContribution Variable denoting whether to return the partial itself (true) or the negative partial (false).
+     *  \param startRow First row in partialMatrix block where the computed partial is to be added.
+     *  \param startColumn First column in partialMatrix block where the computed partial is to be added.
+     */
+    void wrtVelocityOfAcceleratedBody(
+            Eigen::Block< Eigen::MatrixXd > partialMatrix,
+            const bool addContribution = 1, const int startRow = 0, const int startColumn = 0 )
+    {
+        if( addContribution )
+        {
+            partialMatrix.block( startRow, startColumn, 3, 3 ) += currentAccelerationStatePartials_.block( 0, 3, 3, 3 );
+        }
+        else
+        {
+            partialMatrix.block( startRow, startColumn, 3, 3 ) -= currentAccelerationStatePartials_.block( 0, 3, 3, 3 );
+        }
+    }
+
+    //! Function for calculating the partial of the acceleration w.r.t. the position of body exerting acceleration..
+    /*!
+     *  Function for calculating the partial of the acceleration w.r.t. the position of body exerting acceleration and
+     *  adding it to the existing partial block.
+     *  The update( ) function must have been called during current time step before calling this function.
+     *  \param partialMatrix Block of partial derivatives of acceleration w.r.t. Cartesian position of body
+     *  exerting acceleration where current partial is to be added.
+     *  \param addContribution Variable denoting whether to return the partial itself (true) or the negative partial (false).
+     *  \param startRow First row in partialMatrix block where the computed partial is to be added.
+     *  \param startColumn First column in partialMatrix block where the computed partial is to be added.
+     */
+    void wrtPositionOfAcceleratingBody( Eigen::Block< Eigen::MatrixXd > partialMatrix,
+                                        const bool addContribution = 1, const int startRow = 0, const int startColumn = 0 )
+    {
+        if( addContribution )
+        {
+            partialMatrix.block( startRow, startColumn, 3, 3 ) -= currentAccelerationStatePartials_.block( 0, 0, 3, 3 );
+        }
+        else
+        {
+            partialMatrix.block( startRow, startColumn, 3, 3 ) += currentAccelerationStatePartials_.block( 0, 0, 3, 3 );
+        }
+    }
+
+    //! Function for calculating the partial of the acceleration w.r.t. the velocity of body exerting acceleration..
+    /*!
+     *  Function for calculating the partial of the acceleration w.r.t. the velocity of body exerting acceleration and
+     *  adding it to the existing partial block.
+     *  The update( ) function must have been called during current time step before calling this function.
+     *  \param partialMatrix Block of partial derivatives of acceleration w.r.t. Cartesian velocity of body
+     *  exerting acceleration where current partial is to be added.
+     *  \param addContribution Variable denoting whether to return the partial itself (true) or the negative partial (false).
+     *  \param startRow First row in partialMatrix block where the computed partial is to be added.
+     *  \param startColumn First column in partialMatrix block where the computed partial is to be added.
+     */
+    void wrtVelocityOfAcceleratingBody( Eigen::Block< Eigen::MatrixXd > partialMatrix,
+                                        const bool addContribution = 1, const int startRow = 0, const int startColumn = 0 )
+    {
+        if( addContribution )
+        {
+            partialMatrix.block( startRow, startColumn, 3, 3 ) -= currentAccelerationStatePartials_.block( 0, 3, 3, 3 );
+        }
+        else
+        {
+            partialMatrix.block( startRow, startColumn, 3, 3 ) += currentAccelerationStatePartials_.block( 0, 3, 3, 3 );
+        }
+    }
+
+    //! Function for determining if the acceleration is dependent on a non-translational integrated state.
+    /*!
+     *  Function for determining if the acceleration is dependent on a non-translational integrated state.
+     *  No dependency is implemented, as the custom acceleration is only a function of time and relative state.
+     *  \param stateReferencePoint Reference point id of propagated state
+     *  \param integratedStateType Type of propagated state for which dependency is to be determined.
+     *  \return True if dependency exists (non-zero partial), false otherwise.
+     */
+    bool isStateDerivativeDependentOnIntegratedAdditionalStateTypes(
+            const std::pair< std::string, std::string >& stateReferencePoint,
+            const propagators::IntegratedStateType integratedStateType )
+    {
+        return 0;
+    }
+
+    //! Function for setting up and retrieving a function returning a partial w.r.t. a double parameter.
+    /*!
+     *  Function for setting up and retrieving a function returning a partial w.r.t. a double parameter.
+     *  No parameter dependencies are implemented, function returns empty function and zero size indicator.
+     *  \param parameter Parameter w.r.t. which partial is to be taken.
+     *  \return Pair of parameter partial function and number of columns in partial (0 for no dependency).
+     */
+    std::pair< std::function< void( Eigen::MatrixXd& ) >, int >
+    getParameterPartialFunction( std::shared_ptr< estimatable_parameters::EstimatableParameter< double > > parameter )
+    {
+        std::function< void( Eigen::MatrixXd& ) > partialFunction;
+        return std::make_pair( partialFunction, 0 );
+    }
+
+    //! Function for setting up and retrieving a function returning a partial w.r.t. a vector parameter.
+    /*!
+     *  Function for setting up and retrieving a function returning a partial w.r.t. a vector parameter.
+     *  No parameter dependencies are implemented, function returns empty function and zero size indicator.
+     *  \param parameter Parameter w.r.t. which partial is to be taken.
+     *  \return Pair of parameter partial function and number of columns in partial (0 for no dependency).
+     */
+    std::pair< std::function< void( Eigen::MatrixXd& ) >, int > getParameterPartialFunction(
+            std::shared_ptr< estimatable_parameters::EstimatableParameter< Eigen::VectorXd > > parameter )
+    {
+        std::function< void( Eigen::MatrixXd& ) > partialFunction;
+        return std::make_pair( partialFunction, 0 );
+    }
+
+    //! Function for updating partial w.r.t. the bodies' states
+    /*!
+     *  Function for updating partial w.r.t. the bodies' states, evaluating the custom acceleration function once with dual
+     *  numbers at the current relative state.
+     *  \param currentTime Time at which partials are to be calculated
+     */
+    void update( const double currentTime = TUDAT_NAN );
+
+    //! Function to retrieve current partial derivatives of acceleration w.r.t. relative state
+    /*!
+     *  Function to retrieve current partial derivatives of acceleration w.r.t. relative state
+     *  \return Current partial derivatives of acceleration w.r.t. relative state
+     */
+    Eigen::Matrix< double, 3, 6 > getCurrentAccelerationStatePartials( )
+    {
+        return currentAccelerationStatePartials_;
+    }
+
+protected:
+
+    //! State-dependent custom acceleration model
+    std::shared_ptr< basic_astrodynamics::CustomAccelerationModel > customAcceleration_;
+
+    //! Partial derivative of custom acceleration w.r.t. current relative state, computed by update function
+    Eigen::Matrix< double, 3, 6 > currentAccelerationStatePartials_;
+};
+
+} // namespace acceleration_partials
+
+} // namespace tudat
+
+#endif // TUDAT_CUSTOMACCELERATIONPARTIAL_H
@@ -388,6 +388,43 @@ std::vector< double > getMultiArcStateEstimationArcStartTimes(
     return arcStartTimes;
 }
 
+//! Function to retrieve the indices of the arc-wise initial state parameters, sorted per arc
+/*!
+ *  Function to retrieve the indices of the arc-wise initial state parameters, sorted per arc. For each arc, the list of
+ *  (start index, size) of the initial states of all bodies in that arc is provided. Function throws an error if multiple
+ *  arc-wise estimations are found, but arc times are not compatible
+ *  \param estimatableParameters List of estimated parameters
+ *  \return Indices of the arc-wise initial state parameters (start index and size), sorted per arc (empty if no arc-wise
+ *  initial states are estimated)
+ */
+template< typename InitialStateParameterType >
+std::vector< std::vector< std::pair< int, int > > > getArcWiseInitialStateParameterIndices(
+        const std::shared_ptr< EstimatableParameterSet< InitialStateParameterType > > estimatableParameters )
+{
+    // Check arc consistency
+    const int numberOfArcs = getMultiArcStateEstimationArcStartTimes( estimatableParameters, false ).size( );
+
+    std::vector< std::vector< std::pair< int, int > > > parameterIndicesPerArc( numberOfArcs );
+    std::vector< std::shared_ptr< EstimatableParameter<
+            Eigen::Matrix< InitialStateParameterType, Eigen::Dynamic, 1 > > > > initialDynamicalParameters =
+            estimatableParameters->getEstimatedInitialStateParameters( );
+    for( unsigned int i = 0; i < initialDynamicalParameters.size( ); i++ )
+    {
+        if( initialDynamicalParameters.at( i )->getParameterName( ).first == arc_wise_initial_body_state )
+        {
+            const int parameterStartIndex = estimatableParameters->getIndicesForParameterType(
+                        initialDynamicalParameters.at( i )->getParameterName( ) ).at( 0 ).first;
+            const int singleArcSize = initialDynamicalParameters.at( i )->getParameterSize( ) / numberOfArcs;
+            for( int j = 0; j < numberOfArcs; j++ )
+            {
+                parameterIndicesPerArc[ j ].push_back(
+                            std::make_pair( parameterStartIndex + j * singleArcSize, singleArcSize ) );
+            }
+        }
+    }
+
+    return parameterIndicesPerArc;
+}
 
 } // namespace estimatable_parameters
 
@@ -22,6 +22,7 @@
 #include "tudat/basics/timeType.h"
 #include "tudat/astro/observation_models/linkTypeDefs.h"
 #include "tudat/astro/observation_models/observableTypes.h"
+#include "tudat/math/basic/leastSquaresEstimation.h"
 #include "tudat/simulation/estimation_setup/observations.h"
 
 namespace tudat
@@ -58,7 +59,11 @@ public:
         saveInformationMatrix_( true ),
         printOutput_( true ),
         saveResidualsAndParametersFromEachIteration_( true ),
-        saveStateHistoryForEachIteration_( false )
+        saveStateHistoryForEachIteration_( false ),
+        accumulateNormalEquations_( false ),
+        normalEquationsSolutionMethod_( linear_algebra::svd_normal_equations_solution ),
+        reduceArcWiseInitialStates_( false ),
+        maximumNumberOfObservationTimesPerBlock_( 10000 )
     {
         if( inverseOfAprioriCovariance_.rows( ) == 0 )
         {
@@ -229,6 +234,38 @@ public:
         saveStateHistoryForEachIteration_ = saveStateHistoryForEachIteration;
     }
 
+    //! Function to define settings for the computation and solution of the normal equations
+    /*!
+     *  Function to define settings for the computation and solution of the normal equations. By default, the full matrix
+     *  of observation partials (information matrix) is computed and stored, and the normal equations are solved using an
+     *  SVD. Alternatively, the normal equations may be accumulated per block of observations, so that the full information
+     *  matrix is never stored (in which case it is also not saved in the PodOutput, irrespective of the
+     *  saveInformationMatrix setting).
+     *  \param accumulateNormalEquations Boolean denoting whether the normal equations are to be accumulated per block of
+     *  observations, instead of being computed from the full information matrix
+     *  \param solutionMethod Decomposition that is to be used to solve the normal equations
+     *  \param reduceArcWiseInitialStates Boolean denoting whether the arc-wise initial states are to be eliminated from the
+     *  normal equations (by means of a Schur complement) before solving for the other parameters. Only used if
+     *  accumulateNormalEquations is true, and requires each observation to depend on the initial state of a single arc
+     *  \param maximumNumberOfObservationTimesPerBlock Maximum number of observation times for which the partials are computed
+     *  in a single block (only used if accumulateNormalEquations is true)
+     */
+    void defineNormalEquationsSettings(
+            const bool accumulateNormalEquations,
+            const linear_algebra::NormalEquationsSolutionMethod solutionMethod = linear_algebra::svd_normal_equations_solution,
+            const bool reduceArcWiseInitialStates = false,
+            const int maximumNumberOfObservationTimesPerBlock = 10000 )
+    {
+        if( maximumNumberOfObservationTimesPerBlock <= 0 )
+        {
+            throw std::runtime_error( "Error when defining normal equations settings, number of observation times per block must be positive" );
+        }
+        accumulateNormalEquations_ = accumulateNormalEquations;
+        normalEquationsSolutionMethod_ = solutionMethod;
+        reduceArcWiseInitialStates_ = reduceArcWiseInitialStates;
+        maximumNumberOfObservationTimesPerBlock_ = maximumNumberOfObservationTimesPerBlock;
+    }
+
     //! Function to return the total data structure of observations and associated times/link ends/type (by reference)
     /*!
      * Function to return the total data structure of observations and associated times/link ends/type (by reference)
@@ -331,6 +368,46 @@ public:
         return saveStateHistoryForEachIteration_;
     }
 
+    //! Function to return the boolean denoting whether the normal equations are accumulated per block of observations
+    /*!
+     * Function to return the boolean denoting whether the normal equations are accumulated per block of observations
+     * \return Boolean denoting whether the normal equations are accumulated per block of observations
+     */
+    bool getAccumulateNormalEquations( )
+    {
+        return accumulateNormalEquations_;
+    }
+
+    //! Function to return the decomposition that is to be used to solve the normal equations
+    /*!
+     * Function to return the decomposition that is to be used to solve the normal equations
+     * \return Decomposition that is to be used to solve the normal equations
+     */
+    linear_algebra::NormalEquationsSolutionMethod getNormalEquationsSolutionMethod( )
+    {
+        return normalEquationsSolutionMethod_;
+    }
+
+    //! Function to return the boolean denoting whether the arc-wise initial states are eliminated from the normal equations
+    /*!
+     * Function to return the boolean denoting whether the arc-wise initial states are eliminated from the normal equations
+     * \return Boolean denoting whether the arc-wise initial states are eliminated from the normal equations
+     */
+    bool getReduceArcWiseInitialStates( )
+    {
+        return reduceArcWiseInitialStates_;
+    }
+
+    //! Function to return the maximum number of observation times for which the partials are computed in a single block
+    /*!
+     * Function to return the maximum number of observation times for which the partials are computed in a single block
+     * \return Maximum number of observation times for which the partials are computed in a single block
+     */
+    int getMaximumNumberOfObservationTimesPerBlock( )
+    {
+        return maximumNumberOfObservationTimesPerBlock_;
+    }
+
 private:
     //! Total data structure of observations and associated times/link ends/type
     std::shared_ptr< observation_models::ObservationCollection< ObservationScalarType, TimeType > > observationCollection_;
@@ -362,6 +439,18 @@ private:
     //! Boolean denoting whether the state history is to be saved on each iteration.
     bool saveStateHistoryForEachIteration_;
 
+    //! Boolean denoting whether the normal equations are accumulated per block of observations
+    bool accumulateNormalEquations_;
+
+    //! Decomposition that is to be used to solve the normal equations
+    linear_algebra::NormalEquationsSolutionMethod normalEquationsSolutionMethod_;
+
+    //! Boolean denoting whether the arc-wise initial states are eliminated from the normal equations
+    bool reduceArcWiseInitialStates_;
+
+    //! Maximum number of observation times for which the partials are computed in a single block
+    int maximumNumberOfObservationTimesPerBlock_;
+
 };
 
 //! Class that is used during the orbit determination/parameter estimation to determine whether the estimation is converged.
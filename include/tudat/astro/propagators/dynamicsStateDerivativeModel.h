@@ -13,6 +13,7 @@
 
 #include <map>
 #include <utility>
+#include <vector>
 
 #include <functional>
 #include <memory>
@@ -22,6 +23,8 @@
 
 #include <Eigen/Core>
 
+#include "tudat/basics/columnarHistory.h"
+#include "tudat/basics/propagationProfiler.h"
 #include "tudat/astro/basic_astro/torqueModelTypes.h"
 #include "tudat/astro/propagators/bodyMassStateDerivative.h"
 #include "tudat/astro/propagators/singleStateTypeDerivative.h"
@@ -128,6 +131,14 @@ public:
             currentStatesPerTypeInConventionalRepresentation_[ stateDerivativeModels.at( i )->getIntegratedStateType( )  ] =
                     Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >::Zero(
                         conventionalStateTypeSize_.at( stateDerivativeModels.at( i )->getIntegratedStateType( )  ), 1 );
+
+            // Pre-allocate propagated state of current model
+            currentPropagatedStatesPerModel_[ stateDerivativeModels.at( i )->getIntegratedStateType( ) ].push_back(
+                        Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >::Zero(
+                            stateDerivativeModels.at( i )->getPropagatedStateSize( ), 1 ) );
+
+            // No profiling scope is set until a profiler is provided
+            stateDerivativeModelProfilingScopes_[ stateDerivativeModels.at( i )->getIntegratedStateType( ) ].push_back( -1 );
         }
     }
 
@@ -145,107 +156,44 @@ public:
      */
     StateType computeStateDerivative( const TimeType time, const StateType& state )
     {
-        if( !( time == time ) )
-        {
-            throw std::invalid_argument( "Error when computing system state derivative. Input time is NaN" );
-        }
-
-        if( state.hasNaN( ) )
-        {
-            throw std::invalid_argument( "Error when computing system state derivative. State vector contains NaN" );
-        }
-
-        if( !state.allFinite( ) )
-        {
-            throw std::invalid_argument( "Error when computing system state derivative. State vector contains Inf" );
-        }
-//        std::cout << "Computing state derivative: " <<time<<" "<<state.transpose( ) << std::endl;
-
-        // Initialize state derivative
-        if( stateDerivative_.rows( ) != state.rows( ) || stateDerivative_.cols( ) != state.cols( )  )
-        {
-            stateDerivative_.resize( state.rows( ), state.cols( ) );
-        }
-
-        // If dynamical equations are integrated, update the environment with the current state.
-        if( evaluateDynamicsEquations_ )
-        {
-            // Iterate over all types of equations.
-            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
-                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
-                 stateDerivativeModelsIterator_++ )
-            {
-                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
-                {
-                    stateDerivativeModelsIterator_->second.at( i )->clearStateDerivativeModel( );
-                }
-            }
-
-            convertCurrentStateToGlobalRepresentationPerType( state, time, evaluateVariationalEquations_ );
-            environmentUpdateFunction_( time, currentStatesPerTypeInConventionalRepresentation_,
-                                        integratedStatesFromEnvironment_ );
-        }
-        else
-        {
-            environmentUpdateFunction_(
-                        time, std::unordered_map<
-                        IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >( ),
-                        integratedStatesFromEnvironment_ );
-        }
-
-        if( evaluateVariationalEquations_ )
-        {
-            variationalEquations_->clearPartials( );
-        }
-
-        // If dynamical equations are integrated, evaluate dynamics state derivatives.
-        std::pair< int, int > currentIndices;
-        if( evaluateDynamicsEquations_ )
-        {
-            // Iterate over all types of equations.
-            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
-                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
-                 stateDerivativeModelsIterator_++ )
-            {
-                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
-                {
-                    // Update state derivative models
-                    stateDerivativeModelsIterator_->second.at( i )->updateStateDerivativeModel( time );
-                }
-            }
-
-            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
-                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
-                 stateDerivativeModelsIterator_++ )
-            {
-                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
-                {
-                    // Evaluate and set current dynamical state derivative
-                    currentIndices = propagatedStateIndices_.at( stateDerivativeModelsIterator_->first ).at( i );
-
-                    stateDerivativeModelsIterator_->second.at( i )->calculateSystemStateDerivative(
-                                time, state.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 ),
-                                stateDerivative_.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 ) );
-                }
-            }
-        }
-
-        // If variational equations are to be integrated: evaluate and set.
-        if( evaluateVariationalEquations_ )
-        {
-            variationalEquations_->updatePartials( time, currentStatesPerTypeInConventionalRepresentation_ );
-
-            variationalEquations_->evaluateVariationalEquations< StateScalarType >(
-                        time, state.block( 0, 0, totalConventionalStateSize_, variationalEquations_->getNumberOfParameterValues( ) ),
-                        stateDerivative_.block( 0, 0, totalConventionalStateSize_, variationalEquations_->getNumberOfParameterValues( ) ) );
-        }
-
-        // Update counters
-        functionEvaluationCounter_++;
-        cumulativeFunctionEvaluationCounter_[ time ] = functionEvaluationCounter_;
+        updateStateDerivative( time, state );
+        return stateDerivative_;
+    }
 
+    //! Function to calculate the system state derivative, for a state of which the size is known at compile time
+    /*!
+     *  Function to calculate the system state derivative, for a state of which the size is known at compile time (e.g. a
+     *  single Cartesian state, or a single Cartesian state and its state transition matrix). This allows the
+     *  numerical integrator to operate on fixed-size Eigen types, avoiding heap allocations in the integration
+     *  steps. The state is copied to a pre-allocated member buffer, after which the computation is identical to that of
+     *  computeStateDerivative.
+     *  \param time Current time.
+     *  \param state Current complete state.
+     *  \return Calculated state derivative.
+     */
+    template< int NumberOfRows, int NumberOfColumns >
+    Eigen::Matrix< StateScalarType, NumberOfRows, NumberOfColumns > computeFixedSizeStateDerivative(
+            const TimeType time, const Eigen::Matrix< StateScalarType, NumberOfRows, NumberOfColumns >& state )
+    {
+        fixedSizeState_ = state;
+        updateStateDerivative( time, fixedSizeState_ );
         return stateDerivative_;
+    }
 
+    //! Function to check whether the state may be propagated using fixed-size Eigen types.
+    /*!
+     *  Function to check whether the state may be propagated using fixed-size Eigen types, which is the case if a single
+     *  translational state of size 6 (e.g. Cowell propagator for a single body) is propagated, which does not require
+     *  post-processing.
+     *  \return True if the state may be propagated using fixed-size Eigen types.
+     */
+    bool isFixedSizeStatePropagationSupported( )
+    {
+        return ( stateDerivativeModels_.size( ) == 1 ) &&
+                ( stateDerivativeModels_.count( translational_state ) > 0 ) &&
+                ( stateDerivativeModels_.at( translational_state ).size( ) == 1 ) &&
+                ( totalPropagatedStateSize_ == 6 ) &&
+                ( !stateDerivativeModels_.at( translational_state ).at( 0 )->isStateToBePostProcessed( ) );
     }
 
     //! Function to calculate the system state derivative with double precision, regardless of template arguments.
@@ -369,6 +317,28 @@ public:
         }
     }
 
+    //! Function to convert a columnar state history from propagator-specific form to the conventional form.
+    /*!
+     * Function to convert a columnar state history from propagator-specific form to the conventional form
+     * (not necessarily in inertial frame). The converted history retains the entry order of the raw history.
+     * \sa DynamicsStateDerivativeModel::convertToOutputSolution
+     * \param convertedSolution State history (rawSolution), converted to the 'conventional form' (by reference)
+     * \param rawSolution State history in propagator-specific form (i.e. form that is used in
+     *        numerical integration).
+     */
+    void convertNumericalStateSolutionsToOutputSolutions(
+            utilities::ColumnarHistory< TimeType, StateScalarType >& convertedSolution,
+            const utilities::ColumnarHistory< TimeType, StateScalarType >& rawSolution )
+    {
+        convertedSolution = utilities::ColumnarHistory< TimeType, StateScalarType >( );
+        convertedSolution.reserve( rawSolution.size( ) );
+        for( unsigned int i = 0; i < rawSolution.size( ); i++ )
+        {
+            convertedSolution.addEntry( rawSolution.getTime( i ), convertToOutputSolution(
+                                            rawSolution.getEntry( i ), rawSolution.getTime( i ) ) );
+        }
+    }
+
     //! Function to process the state vector during propagation.
     /*!
      * Function to process the state vector during propagation.
@@ -567,16 +537,36 @@ public:
         functionEvaluationCounter_ = 0;
     }
 
+    //! Function to save the current number of calls to the computeStateDerivative function at a given time step
+    /*!
+     * Function to save the current number of calls to the computeStateDerivative function at a given time step, for
+     * retrieval by getCumulativeNumberOfFunctionEvaluations. Called once per integration step (automatically by
+     * DynamicsSimulator), so that no entry is added on each call of the computeStateDerivative function.
+     * \param time Time at the end of the current integration step
+     */
+    void saveCumulativeNumberOfFunctionEvaluations( const TimeType time )
+    {
+        cumulativeFunctionEvaluationCounter_.push_back( std::make_pair( time, functionEvaluationCounter_ ) );
+    }
+
     //! Function to retrieve number of calls to the computeStateDerivative function per time step
     /*!
      * Function to retrieve number of calls to the computeStateDerivative function per time step since object
-     * reation/last call to resetFunctionEvaluationCounter function
+     * reation/last call to resetFunctionEvaluationCounter function, as saved by
+     * saveCumulativeNumberOfFunctionEvaluations
      * \return Number of calls to the computeStateDerivative function since object creation/last call to
      * resetFunctionEvaluationCounter function
      */
     std::map< TimeType, unsigned int > getCumulativeNumberOfFunctionEvaluations( )
     {
-        return cumulativeFunctionEvaluationCounter_;
+        // Later evaluations at the same time overwrite earlier ones
+        std::map< TimeType, unsigned int > cumulativeNumberOfFunctionEvaluations;
+        for( unsigned int i = 0; i < cumulativeFunctionEvaluationCounter_.size( ); i++ )
+        {
+            cumulativeNumberOfFunctionEvaluations[ cumulativeFunctionEvaluationCounter_.at( i ).first ] =
+                    cumulativeFunctionEvaluationCounter_.at( i ).second;
+        }
+        return cumulativeNumberOfFunctionEvaluations;
     }
 
     //! Function to reset the number of calls to the computeStateDerivative function to zero.
@@ -599,9 +589,197 @@ public:
         return variationalEquations_;
     }
 
+    //! Function to set the profiler in which the evaluation time of the state derivative is to be recorded
+    /*!
+     * Function to set the profiler in which the evaluation time of the state derivative is to be recorded. Scopes are
+     * created for the full state derivative, the environment update, each single state derivative model (with
+     * nested scopes per acceleration/torque model) and the variational equations. Timing is only performed if
+     * TUDAT_BUILD_WITH_PROFILING is enabled.
+     * \param profiler Profiler in which the evaluation time is to be recorded (nullptr to disable)
+     */
+    void setPropagationProfiler( const std::shared_ptr< utilities::PropagationProfiler > profiler )
+    {
+        profiler_ = profiler;
+        stateDerivativeModelProfilingScopes_.clear( );
+        if( profiler_ != nullptr )
+        {
+            stateDerivativeProfilingScope_ = profiler_->addScope( "state_derivative" );
+            environmentUpdateProfilingScope_ = profiler_->addScope( "environment_update", stateDerivativeProfilingScope_ );
+            variationalEquationsProfilingScope_ = profiler_->addScope(
+                        "variational_equations", stateDerivativeProfilingScope_ );
+        }
+        else
+        {
+            stateDerivativeProfilingScope_ = -1;
+            environmentUpdateProfilingScope_ = -1;
+            variationalEquationsProfilingScope_ = -1;
+        }
+
+        for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
+             stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
+             stateDerivativeModelsIterator_++ )
+        {
+            for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
+            {
+                int currentScope = -1;
+                if( profiler_ != nullptr )
+                {
+                    currentScope = profiler_->addScope(
+                                getIntegratedStateTypeName( stateDerivativeModelsIterator_->first ) + "_" +
+                                std::to_string( i ), stateDerivativeProfilingScope_ );
+                }
+                stateDerivativeModelProfilingScopes_[ stateDerivativeModelsIterator_->first ].push_back( currentScope );
+                stateDerivativeModelsIterator_->second.at( i )->setPropagationProfiler( profiler_, currentScope );
+            }
+        }
+    }
+
+    //! Function to retrieve the profiler in which the evaluation time of the state derivative is recorded
+    /*!
+     * Function to retrieve the profiler in which the evaluation time of the state derivative is recorded
+     * \return Profiler in which the evaluation time of the state derivative is recorded (nullptr if none)
+     */
+    std::shared_ptr< utilities::PropagationProfiler > getPropagationProfiler( )
+    {
+        return profiler_;
+    }
+
+    //! Function to retrieve the index of the profiler scope of the environment update
+    /*!
+     * Function to retrieve the index of the profiler scope of the environment update, in which the scopes of the separate
+     * environment update functions are to be nested.
+     * \return Index of the profiler scope of the environment update (-1 if no profiler is set)
+     */
+    int getEnvironmentUpdateProfilingScope( )
+    {
+        return environmentUpdateProfilingScope_;
+    }
+
 
 private:
 
+    //! Function to calculate the system state derivative, and set it in the stateDerivative_ member variable
+    /*!
+     *  Function to calculate the system state derivative, and set it in the stateDerivative_ member variable
+     *  \param time Current time.
+     *  \param state Current complete state.
+     *  \sa computeStateDerivative
+     */
+    void updateStateDerivative( const TimeType time, const StateType& state )
+    {
+        if( !( time == time ) )
+        {
+            throw std::invalid_argument( "Error when computing system state derivative. Input time is NaN" );
+        }
+
+        if( state.hasNaN( ) )
+        {
+            throw std::invalid_argument( "Error when computing system state derivative. State vector contains NaN" );
+        }
+
+        if( !state.allFinite( ) )
+        {
+            throw std::invalid_argument( "Error when computing system state derivative. State vector contains Inf" );
+        }
+//        std::cout << "Computing state derivative: " <<time<<" "<<state.transpose( ) << std::endl;
+        TUDAT_PROFILE_SCOPE( profiler_.get( ), stateDerivativeProfilingScope_ );
+
+        // Initialize state derivative
+        if( stateDerivative_.rows( ) != state.rows( ) || stateDerivative_.cols( ) != state.cols( )  )
+        {
+            stateDerivative_.resize( state.rows( ), state.cols( ) );
+        }
+
+        // If dynamical equations are integrated, update the environment with the current state.
+        if( evaluateDynamicsEquations_ )
+        {
+            // Iterate over all types of equations.
+            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
+                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
+                 stateDerivativeModelsIterator_++ )
+            {
+                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
+                {
+                    stateDerivativeModelsIterator_->second.at( i )->clearStateDerivativeModel( );
+                }
+            }
+
+            convertCurrentStateToGlobalRepresentationPerType( state, time, evaluateVariationalEquations_ );
+            TUDAT_PROFILE_SCOPE( profiler_.get( ), environmentUpdateProfilingScope_ );
+            environmentUpdateFunction_( time, currentStatesPerTypeInConventionalRepresentation_,
+                                        integratedStatesFromEnvironment_ );
+        }
+        else
+        {
+            TUDAT_PROFILE_SCOPE( profiler_.get( ), environmentUpdateProfilingScope_ );
+            environmentUpdateFunction_(
+                        time, std::unordered_map<
+                        IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >( ),
+                        integratedStatesFromEnvironment_ );
+        }
+
+        if( evaluateVariationalEquations_ )
+        {
+            variationalEquations_->clearPartials( );
+        }
+
+        // If dynamical equations are integrated, evaluate dynamics state derivatives.
+        std::pair< int, int > currentIndices;
+        if( evaluateDynamicsEquations_ )
+        {
+            // Iterate over all types of equations.
+            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
+                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
+                 stateDerivativeModelsIterator_++ )
+            {
+                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
+                {
+                    // Update state derivative models
+                    TUDAT_PROFILE_SCOPE(
+                                profiler_.get( ),
+                                stateDerivativeModelProfilingScopes_.at( stateDerivativeModelsIterator_->first ).at( i ) );
+                    stateDerivativeModelsIterator_->second.at( i )->updateStateDerivativeModel( time );
+                }
+            }
+
+            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
+                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
+                 stateDerivativeModelsIterator_++ )
+            {
+                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
+                {
+                    // Evaluate and set current dynamical state derivative
+                    TUDAT_PROFILE_SCOPE_WITHOUT_CALL(
+                                profiler_.get( ),
+                                stateDerivativeModelProfilingScopes_.at( stateDerivativeModelsIterator_->first ).at( i ) );
+                    currentIndices = propagatedStateIndices_.at( stateDerivativeModelsIterator_->first ).at( i );
+                    Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& currentPropagatedState =
+                            currentPropagatedStatesPerModel_.at( stateDerivativeModelsIterator_->first ).at( i );
+                    currentPropagatedState = state.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 );
+
+                    stateDerivativeModelsIterator_->second.at( i )->calculateSystemStateDerivative(
+                                time, currentPropagatedState,
+                                stateDerivative_.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 ) );
+                }
+            }
+        }
+
+        // If variational equations are to be integrated: evaluate and set.
+        if( evaluateVariationalEquations_ )
+        {
+            TUDAT_PROFILE_SCOPE( profiler_.get( ), variationalEquationsProfilingScope_ );
+            variationalEquations_->updatePartials( time, currentStatesPerTypeInConventionalRepresentation_ );
+
+            variationalEquations_->evaluateVariationalEquations< StateScalarType >(
+                        time, state.block( 0, 0, totalConventionalStateSize_, variationalEquations_->getNumberOfParameterValues( ) ),
+                        stateDerivative_.block( 0, 0, totalConventionalStateSize_, variationalEquations_->getNumberOfParameterValues( ) ) );
+        }
+
+        // Update counter
+        functionEvaluationCounter_++;
+    }
+
+
     //! Function to convert the to the conventional form in the global frame per dynamics type.
     /*!
      * Function to convert the propagator-specific form of the state to the conventional form in the global frame, split
@@ -646,8 +824,12 @@ private:
                 currentConventionalIndices = conventionalStateIndices_.at( stateDerivativeModelsIterator_->first ).at( i );
 
                 // Set current block in split state (in global form)
+                Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& currentPropagatedState =
+                        currentPropagatedStatesPerModel_.at( stateDerivativeModelsIterator_->first ).at( i );
+                currentPropagatedState = state.block(
+                            currentPropagatedIndices.first, startColumn, currentPropagatedIndices.second, 1 );
                 stateDerivativeModelsIterator_->second.at( i )->convertCurrentStateToGlobalRepresentation(
-                            state.block( currentPropagatedIndices.first, startColumn, currentPropagatedIndices.second, 1 ), time,
+                            currentPropagatedState, time,
                             currentStatesPerTypeInConventionalRepresentation_.at(
                                 stateDerivativeModelsIterator_->first ).block(
                                 currentStateTypeSize, 0, currentConventionalIndices.second, 1 ) );
@@ -716,6 +898,14 @@ private:
     //! Current state derivative, as computed by computeStateDerivative.
     StateType stateDerivative_;
 
+    //! Pre-allocated copy of the current state, used by computeFixedSizeStateDerivative
+    StateType fixedSizeState_;
+
+    //! Pre-allocated propagated state of each state derivative model (in same order as stateDerivativeModels_), used
+    //! to pass the current state block to the models without allocating temporaries.
+    std::unordered_map< IntegratedStateType, std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
+    currentPropagatedStatesPerModel_;
+
     //! Current state in 'conventional' representation, computed from current propagated state by
     //! convertCurrentStateToGlobalRepresentationPerType
     std::unordered_map< IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >
@@ -725,7 +915,27 @@ private:
     unsigned int functionEvaluationCounter_ = 0;
 
     //! Variable to keep track of the number of calls to the computeStateDerivative function per time step
-    std::map< TimeType, unsigned int > cumulativeFunctionEvaluationCounter_;
+    /*!
+     *  Variable to keep track of the number of calls to the computeStateDerivative function per time step, with one
+     *  entry per integration step (set by saveCumulativeNumberOfFunctionEvaluations). Stored as a vector (of which the
+     *  capacity is retained when it is reset), and converted to a map by getCumulativeNumberOfFunctionEvaluations.
+     */
+    std::vector< std::pair< TimeType, unsigned int > > cumulativeFunctionEvaluationCounter_;
+
+    //! Profiler in which the evaluation time of the state derivative is recorded (nullptr if none)
+    std::shared_ptr< utilities::PropagationProfiler > profiler_;
+
+    //! Index of the profiler scope of the full state derivative
+    int stateDerivativeProfilingScope_ = -1;
+
+    //! Index of the profiler scope of the environment update
+    int environmentUpdateProfilingScope_ = -1;
+
+    //! Index of the profiler scope of the variational equations
+    int variationalEquationsProfilingScope_ = -1;
+
+    //! Index of the profiler scope of each state derivative model (in same order as stateDerivativeModels_)
+    std::unordered_map< IntegratedStateType, std::vector< int > > stateDerivativeModelProfilingScopes_;
 };
 
 extern template class DynamicsStateDerivativeModel< double, double >;
@@ -46,6 +46,14 @@ void addEnvironmentUpdates(
         const std::map< propagators::EnvironmentModelsToUpdate, std::vector< std::string > >
         updatesToAdd );
 
+//! Function to get a string representing a 'named identification' of an environment update type
+/*!
+ * Function to get a string representing a 'named identification' of an environment update type
+ * \param environmentModelToUpdate Environment update type for which name is to be retrieved
+ * \return Name of environment update type
+ */
+std::string getEnvironmentModelToUpdateName( const EnvironmentModelsToUpdate environmentModelToUpdate );
+
 } // namespace propagators
 
 } // namespace tudat
@@ -28,10 +28,13 @@
 
 #include "tudat/astro/basic_astro/timeConversions.h"
 #include "tudat/basics/timeType.h"
+#include "tudat/basics/columnarHistory.h"
+#include "tudat/astro/propagators/propagationOutputSink.h"
 #include "tudat/astro/propagators/singleStateTypeDerivative.h"
 #include "tudat/math/integrators/createNumericalIntegrator.h"
 #include "tudat/math/interpolators/lagrangeInterpolator.h"
 #include "tudat/math/root_finders/createRootFinder.h"
+#include "tudat/simulation/propagation_setup/propagationEvents.h"
 #include "tudat/simulation/propagation_setup/propagationTermination.h"
 
 namespace tudat
@@ -72,6 +75,33 @@ TimeStepType getTerminationDependentVariableErrorForGivenTimeStep(
     return dependentVariableError;
 }
 
+//! Function to determine, for a given time step, the error in termination dependent variable from the dense output
+/*!
+ *  Function to determine, for a given time step from the start of the last integration step, the error in termination
+ *  dependent variable, where the state is computed from the dense output of the numerical integrator (instead of by
+ *  performing an integration step). This function is used as input for the root finder when the propagation must
+ *  terminate exactly on a dependent variable value, and the integrator uses dense output.
+ *  \param timeStep Time step w.r.t. start of last integration step
+ *  \param integrator Numerical integrator used for propagation
+ *  \param dependentVariableTerminationCondition Settings used to determine value/type of dependent variable at which propagation
+ *  is to terminate
+ *  \param stepStartTime Time at the start of the last integration step
+ *  \return The difference between the reached and required value of the termination dependent variable
+ */
+template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType  >
+TimeStepType getTerminationDependentVariableErrorFromDenseOutput(
+        TimeStepType timeStep,
+        const std::shared_ptr< numerical_integrators::NumericalIntegrator< TimeType, StateType, StateType, TimeStepType > >
+        integrator,
+        const std::shared_ptr< SingleVariableLimitPropagationTerminationCondition > dependentVariableTerminationCondition,
+        const TimeType stepStartTime )
+{
+    // Retrieve value of dependent variable at interpolated state
+    TimeType currentTime = stepStartTime + timeStep;
+    integrator->getStateDerivativeFunction( )( currentTime, integrator->getDenseOutputState( currentTime ) );
+    return static_cast< TimeStepType >( dependentVariableTerminationCondition->getStopConditionError( ) );
+}
+
 //! Function that propagates to an exact final condition (within tolerance) for dependent variable termination condition
 /*!
  * Function that propagates to an exact final condition (within tolerance) for dependent variable termination condition.
@@ -86,6 +116,10 @@ TimeStepType getTerminationDependentVariableErrorForGivenTimeStep(
  * \param lastState State at time where integration first exceeded termination condition
  * \param endTime Time at which exact termination condition is met (returned by reference).
  * \param endState State at time where exact termination condition is met (returned by reference).
+ * \param isOnlyTerminationCondition Boolean denoting whether this is the only termination condition (if false, no warning
+ * is printed if no root is found)
+ * \param useDenseOutput Boolean denoting whether the final time is found from the dense output of the integrator (in which
+ * case the integrator is not rolled back upon input to this function), instead of by repeating the last step
  */
 template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType  >
 void getFinalStateForExactDependentVariableTerminationCondition(
@@ -98,14 +132,25 @@ void getFinalStateForExactDependentVariableTerminationCondition(
         const StateType& lastState,
         TimeType& endTime,
         StateType& endState,
-        const bool isOnlyTerminationCondition = true )
+        const bool isOnlyTerminationCondition = true,
+        const bool useDenseOutput = false )
 {
     TUDAT_UNUSED_PARAMETER( secondToLastState );
 
     // Function for which the root (zero value) occurs at the required end time/state
-    std::function< TimeStepType( TimeStepType ) > dependentVariableErrorFunction =
-            std::bind( &getTerminationDependentVariableErrorForGivenTimeStep< StateType, TimeType, TimeStepType >, std::placeholders::_1,
-                       integrator, dependentVariableTerminationCondition );
+    std::function< TimeStepType( TimeStepType ) > dependentVariableErrorFunction;
+    if( useDenseOutput )
+    {
+        dependentVariableErrorFunction =
+                std::bind( &getTerminationDependentVariableErrorFromDenseOutput< StateType, TimeType, TimeStepType >,
+                           std::placeholders::_1, integrator, dependentVariableTerminationCondition, secondToLastTime );
+    }
+    else
+    {
+        dependentVariableErrorFunction =
+                std::bind( &getTerminationDependentVariableErrorForGivenTimeStep< StateType, TimeType, TimeStepType >,
+                           std::placeholders::_1, integrator, dependentVariableTerminationCondition );
+    }
 
     // Create root finder.
     bool increasingTime = static_cast< double >( lastTime - secondToLastTime ) > 0.0;
@@ -136,8 +181,16 @@ void getFinalStateForExactDependentVariableTerminationCondition(
                     std::make_shared< basic_mathematics::FunctionProxy< TimeStepType, TimeStepType > >(
                         dependentVariableErrorFunction ), ( lastTime - secondToLastTime ) / 2.0 );
 
-        endState = integrator->performIntegrationStep( finalTimeStep );
-        endTime = integrator->getCurrentIndependentVariable( );
+        if( useDenseOutput )
+        {
+            endTime = secondToLastTime + finalTimeStep;
+            endState = integrator->getDenseOutputState( endTime );
+        }
+        else
+        {
+            endState = integrator->performIntegrationStep( finalTimeStep );
+            endTime = integrator->getCurrentIndependentVariable( );
+        }
     }
     // If dependent variable has no root in given interval, set end time and state at NaN
     catch( std::runtime_error& caughtException )
@@ -167,6 +220,7 @@ void getFinalStateForExactDependentVariableTerminationCondition(
  * \param lastState State at time where integration first exceeded termination condition
  * \param endTime Time at which exact termination condition is met (returned by reference).
  * \param endState State at time where exact termination condition is met (returned by reference).
+ * \param useDenseOutput Boolean denoting whether the final time is found from the dense output of the integrator
  */
 template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType  >
 bool getFinalStateForExactHybridVariableTerminationCondition(
@@ -178,7 +232,8 @@ bool getFinalStateForExactHybridVariableTerminationCondition(
         const StateType& secondToLastState,
         const StateType& lastState,
         TimeType& endTime,
-        StateType& endState )
+        StateType& endState,
+        const bool useDenseOutput = false )
 {
 
     std::vector< std::shared_ptr< PropagationTerminationCondition > > terminationConditionList =
@@ -201,7 +256,7 @@ bool getFinalStateForExactHybridVariableTerminationCondition(
             // Determine single termination condition
             getFinalStateForExactTerminationCondition(
                         integrator, terminationConditionList.at( i ),secondToLastTime, lastTime, secondToLastState, lastState,
-                        endTimes[ i ], endStates[ i ], false );
+                        endTimes[ i ], endStates[ i ], false, useDenseOutput );
 
             // If converged time is found, check if it is smallest/highest converged time
             if( endTimes[ i ] == endTimes[ i ] )
@@ -277,6 +332,10 @@ bool getFinalStateForExactHybridVariableTerminationCondition(
  * \param lastState State at time where integration first exceeded termination condition
  * \param endTime Time at which exact termination condition is met (returned by reference).
  * \param endState State at time where exact termination condition is met (returned by reference).
+ * \param isOnlyTerminationCondition Boolean denoting whether this is the only termination condition
+ * \param useDenseOutput Boolean denoting whether the final time/state is found from the dense output of the integrator,
+ * which requires no additional integration steps, and leaves the integrator at lastTime/lastState.
+ * \return Boolean denoting whether the final time/state were determined
  */
 template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType  >
 bool getFinalStateForExactTerminationCondition(
@@ -288,7 +347,8 @@ bool getFinalStateForExactTerminationCondition(
         const StateType& lastState,
         TimeType& endTime,
         StateType& endState,
-        const bool isOnlyTerminationCondition = true )
+        const bool isOnlyTerminationCondition = true,
+        const bool useDenseOutput = false )
 {
     bool useNewSolution = true;
     // Check type of termination condition
@@ -303,9 +363,17 @@ bool getFinalStateForExactTerminationCondition(
         // Determine final time step and propagate
         TimeStepType finalTimeStep = timeTerminationCondition->getStopTime( ) - secondToLastTime;
 
-        integrator->rollbackToPreviousState( );
-        endState = integrator->performIntegrationStep( finalTimeStep );
-        endTime = integrator->getCurrentIndependentVariable( );
+        if( useDenseOutput )
+        {
+            endTime = secondToLastTime + finalTimeStep;
+            endState = integrator->getDenseOutputState( endTime );
+        }
+        else
+        {
+            integrator->rollbackToPreviousState( );
+            endState = integrator->performIntegrationStep( finalTimeStep );
+            endTime = integrator->getCurrentIndependentVariable( );
+        }
 
         break;
     }
@@ -320,13 +388,16 @@ bool getFinalStateForExactTerminationCondition(
     }
     case dependent_variable_stopping_condition:
     {
-        integrator->rollbackToPreviousState( );
+        if( !useDenseOutput )
+        {
+            integrator->rollbackToPreviousState( );
+        }
 
         std::shared_ptr< SingleVariableLimitPropagationTerminationCondition > dependentVariableTerminationCondition =
                 std::dynamic_pointer_cast< SingleVariableLimitPropagationTerminationCondition >( terminationCondition );
         getFinalStateForExactDependentVariableTerminationCondition(
                     integrator, dependentVariableTerminationCondition, secondToLastTime, lastTime,
-                    secondToLastState, lastState, endTime, endState, isOnlyTerminationCondition );
+                    secondToLastState, lastState, endTime, endState, isOnlyTerminationCondition, useDenseOutput );
 
         break;
     }
@@ -346,7 +417,7 @@ bool getFinalStateForExactTerminationCondition(
 
         useNewSolution = getFinalStateForExactHybridVariableTerminationCondition(
                     integrator, hyrbidTerminationCondition, secondToLastTime, lastTime,
-                    secondToLastState, lastState, endTime, endState );
+                    secondToLastState, lastState, endTime, endState, useDenseOutput );
         break;
     }
     default:
@@ -364,20 +435,26 @@ bool getFinalStateForExactTerminationCondition(
  * \param timeStep Last time step taken by integrator.
  * \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
  * derivative model).
+ * \param statePostProcessingFunction Function to post-process state after numerical integration, applied to the final
+ * state if it is computed from the dense output (which is not post-processed by the integrator)
  * \param solutionHistory History of state variables that are to be saved given as map
  * (time as key; returned by reference)
  * \param dependentVariableHistory History of dependent variables that are to be saved given as map
  * (time as key; returned by reference)
  * \param currentCpuTime Current run time of propagation.
+ * If the integrator uses dense output, the final time/state is determined from the dense output of the last step.
  */
-template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType  >
+template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType,
+          typename StateHistoryType = std::map< TimeType, StateType >,
+          typename DependentVariableHistoryType = std::map< TimeType, Eigen::VectorXd > >
 void propagateToExactTerminationCondition(
         const std::shared_ptr< numerical_integrators::NumericalIntegrator< TimeType, StateType, StateType, TimeStepType > > integrator,
         const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
         const TimeStepType timeStep,
         const std::function< Eigen::VectorXd( ) > dependentVariableFunction,
-        std::map< TimeType, StateType >& solutionHistory,
-        std::map< TimeType, Eigen::VectorXd >& dependentVariableHistory,
+        const std::function< void( StateType& ) > statePostProcessingFunction,
+        StateHistoryType& solutionHistory,
+        DependentVariableHistoryType& dependentVariableHistory,
         const double currentCpuTime )
 {
     // Turn off step size control
@@ -392,44 +469,34 @@ void propagateToExactTerminationCondition(
                 integrator->getCurrentIndependentVariable( ),
                 integrator->getPreviousState( ),
                 integrator->getCurrentState( ),
-                endTime, endState ) )
+                endTime, endState, true, integrator->getUseDenseOutput( ) ) )
     {
+        if( integrator->getUseDenseOutput( ) && statePostProcessingFunction != nullptr )
+        {
+            statePostProcessingFunction( endState );
+        }
 
         // Check if any dependent variables are saved. If so, remove last entry
         bool recomputeDependentVariables = false;
-        if( dependentVariableHistory.size( ) > 0 )
+        if( utilities::getHistorySize( dependentVariableHistory ) > 0 )
         {
-            if( dependentVariableHistory.rbegin( )->first == solutionHistory.rbegin( )->first )
+            if( utilities::getLastAddedHistoryTime( dependentVariableHistory, timeStep > 0 ) ==
+                    utilities::getLastAddedHistoryTime( solutionHistory, timeStep > 0 ) )
             {
-                if( timeStep > 0 )
-                {
-                    dependentVariableHistory.erase( std::prev( dependentVariableHistory.end() ) );
-                }
-                else
-                {
-                    dependentVariableHistory.erase(  dependentVariableHistory.begin( ) );
-                }
+                utilities::removeLastAddedHistoryEntry( dependentVariableHistory, timeStep > 0 );
                 recomputeDependentVariables = true;
             }
         }
 
         // Remove state entry last added, and enter converged final state
-        if( timeStep > 0 )
-        {
-            solutionHistory.erase( std::prev( solutionHistory.end() ) );
-            solutionHistory[ endTime ] = endState;
-        }
-        else
-        {
-            solutionHistory.erase( solutionHistory.begin( ) );
-            solutionHistory[ endTime ] = endState;
-        }
+        utilities::removeLastAddedHistoryEntry( solutionHistory, timeStep > 0 );
+        utilities::addHistoryEntry( solutionHistory, endTime, endState );
 
         // Recompute final dependent variables, if required
         if( recomputeDependentVariables )
         {
             integrator->getStateDerivativeFunction( )( endTime, endState );
-            dependentVariableHistory[ endTime ] = dependentVariableFunction( );
+            utilities::addHistoryEntry( dependentVariableHistory, endTime, dependentVariableFunction( ) );
 
             // Check stopping conditions to be able to save details
             propagationTerminationCondition->checkStopCondition( endTime, currentCpuTime );
@@ -446,6 +513,267 @@ void propagateToExactTerminationCondition(
     integrator->setStepSizeControl( true );
 }
 
+//! Function to retrieve the epoch of the dense output with the given index
+/*!
+ * Function to retrieve the epoch of the dense output with the given index, which is an integer multiple of the dense output
+ * interval.
+ * \param denseOutputIndex Index of the dense output epoch
+ * \param denseOutputInterval Interval between dense output epochs
+ * \return Epoch of dense output
+ */
+template< typename TimeType >
+TimeType getDenseOutputEpoch( const long long denseOutputIndex, const double denseOutputInterval )
+{
+    return TimeType( static_cast< long double >( denseOutputIndex ) * static_cast< long double >( denseOutputInterval ) );
+}
+
+//! Function to save the propagation results at all dense output epochs up to a given time
+/*!
+ * Function to save the propagation results at all dense output epochs up to (and including) a given time, which must be
+ * within the last integration step, using the dense output of the numerical integrator.
+ * \param integrator Numerical integrator that is used for propagation.
+ * \param finalTime Time up to which dense output epochs are to be saved
+ * \param denseOutputInterval Interval between dense output epochs
+ * \param propagationDirection Direction of propagation (1 for forward, -1 for backward)
+ * \param denseOutputIndex Index of the next dense output epoch (updated by reference)
+ * \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
+ * derivative model).
+ * \param statePostProcessingFunction Function to post-process state after numerical integration, applied to the states
+ * computed from the dense output (which are not post-processed by the integrator)
+ * \param solutionHistory History of state variables that are to be saved (returned by reference)
+ * \param dependentVariableHistory History of dependent variables that are to be saved (returned by reference)
+ * \return Boolean denoting whether any dense output epochs were saved
+ */
+template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType,
+          typename StateHistoryType = std::map< TimeType, StateType >,
+          typename DependentVariableHistoryType = std::map< TimeType, Eigen::VectorXd > >
+bool saveDenseOutputHistory(
+        const std::shared_ptr< numerical_integrators::NumericalIntegrator< TimeType, StateType, StateType, TimeStepType > > integrator,
+        const TimeType finalTime,
+        const double denseOutputInterval,
+        const int propagationDirection,
+        long long& denseOutputIndex,
+        const std::function< Eigen::VectorXd( ) > dependentVariableFunction,
+        const std::function< void( StateType& ) > statePostProcessingFunction,
+        StateHistoryType& solutionHistory,
+        DependentVariableHistoryType& dependentVariableHistory )
+{
+    bool isOutputSaved = false;
+    TimeType outputTime = getDenseOutputEpoch< TimeType >( denseOutputIndex, denseOutputInterval );
+    while( propagationDirection * static_cast< double >( outputTime - finalTime ) <= 0.0 )
+    {
+        StateType outputState = integrator->getDenseOutputState( outputTime );
+        if( statePostProcessingFunction != nullptr )
+        {
+            statePostProcessingFunction( outputState );
+        }
+        utilities::addHistoryEntry( solutionHistory, outputTime, outputState );
+        if( !( dependentVariableFunction == nullptr ) )
+        {
+            integrator->getStateDerivativeFunction( )( outputTime, outputState );
+            utilities::addHistoryEntry( dependentVariableHistory, outputTime, dependentVariableFunction( ) );
+        }
+        isOutputSaved = true;
+
+        denseOutputIndex += propagationDirection;
+        outputTime = getDenseOutputEpoch< TimeType >( denseOutputIndex, denseOutputInterval );
+    }
+    return isOutputSaved;
+}
+
+//! Function to save the propagation results of the final integration step when using dense output
+/*!
+ * Function to save the propagation results of the final integration step when using dense output. The results are
+ * saved at all dense output epochs within the final step, up to the final time of the propagation, as well as at the
+ * final time itself. If required, the final time/state is first determined exactly from the termination condition,
+ * using the dense output.
+ * \param integrator Numerical integrator that is used for propagation. Upon input to this function, the integrator is at
+ * the final time/state encountered by the propagation
+ * \param propagationTerminationCondition Termination condition that is to be used
+ * \param denseOutputInterval Interval between dense output epochs
+ * \param propagationDirection Direction of propagation (1 for forward, -1 for backward)
+ * \param denseOutputIndex Index of the next dense output epoch (updated by reference)
+ * \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
+ * derivative model).
+ * \param statePostProcessingFunction Function to post-process state after numerical integration, applied to the states
+ * computed from the dense output (which are not post-processed by the integrator)
+ * \param solutionHistory History of state variables that are to be saved (returned by reference)
+ * \param dependentVariableHistory History of dependent variables that are to be saved (returned by reference)
+ * \param currentCpuTime Current run time of propagation.
+ */
+template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType,
+          typename StateHistoryType = std::map< TimeType, StateType >,
+          typename DependentVariableHistoryType = std::map< TimeType, Eigen::VectorXd > >
+void saveFinalStepDenseOutputHistory(
+        const std::shared_ptr< numerical_integrators::NumericalIntegrator< TimeType, StateType, StateType, TimeStepType > > integrator,
+        const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
+        const double denseOutputInterval,
+        const int propagationDirection,
+        long long& denseOutputIndex,
+        const std::function< Eigen::VectorXd( ) > dependentVariableFunction,
+        const std::function< void( StateType& ) > statePostProcessingFunction,
+        StateHistoryType& solutionHistory,
+        DependentVariableHistoryType& dependentVariableHistory,
+        const double currentCpuTime )
+{
+    TimeType endTime = integrator->getCurrentIndependentVariable( );
+    StateType endState = integrator->getCurrentState( );
+
+    // Determine exact final time/state from dense output, if required
+    if( propagationTerminationCondition->getcheckTerminationToExactCondition( ) )
+    {
+        TimeType exactEndTime;
+        StateType exactEndState;
+        if( getFinalStateForExactTerminationCondition(
+                    integrator, propagationTerminationCondition,
+                    integrator->getPreviousIndependentVariable( ),
+                    integrator->getCurrentIndependentVariable( ),
+                    integrator->getPreviousState( ),
+                    integrator->getCurrentState( ),
+                    exactEndTime, exactEndState, true, true ) )
+        {
+            endTime = exactEndTime;
+            endState = exactEndState;
+            if( statePostProcessingFunction != nullptr )
+            {
+                statePostProcessingFunction( endState );
+            }
+        }
+    }
+
+    // Save results at dense output epochs up to final time, and at final time
+    TimeType outputTime = getDenseOutputEpoch< TimeType >( denseOutputIndex, denseOutputInterval );
+    while( propagationDirection * static_cast< double >( outputTime - endTime ) < 0.0 )
+    {
+        StateType outputState = integrator->getDenseOutputState( outputTime );
+        if( statePostProcessingFunction != nullptr )
+        {
+            statePostProcessingFunction( outputState );
+        }
+        utilities::addHistoryEntry( solutionHistory, outputTime, outputState );
+        if( !( dependentVariableFunction == nullptr ) )
+        {
+            integrator->getStateDerivativeFunction( )( outputTime, outputState );
+            utilities::addHistoryEntry( dependentVariableHistory, outputTime, dependentVariableFunction( ) );
+        }
+
+        denseOutputIndex += propagationDirection;
+        outputTime = getDenseOutputEpoch< TimeType >( denseOutputIndex, denseOutputInterval );
+    }
+
+    utilities::addHistoryEntry( solutionHistory, endTime, endState );
+    integrator->getStateDerivativeFunction( )( endTime, endState );
+    if( !( dependentVariableFunction == nullptr ) )
+    {
+        utilities::addHistoryEntry( dependentVariableHistory, endTime, dependentVariableFunction( ) );
+    }
+
+    // Check stopping conditions to be able to save details
+    propagationTerminationCondition->checkStopCondition( static_cast< double >( endTime ), currentCpuTime );
+}
+
+//! Function to detect the events that occur within the last integration step
+/*!
+ * Function to detect the events that occur within the last integration step. The event functions are evaluated at the
+ * end of the step, and for each event function that has crossed zero (in the required direction) since the previous step,
+ * the event is located by a root finder, evaluating the event function at states computed from the dense output of the
+ * integrator. The detected events are stored in the event detector, in order of occurrence. If the root finder fails to
+ * locate an event, the event is stored as unresolved, with the time and state at the end of the step, and the step as
+ * the interval that brackets the event (see PropagationEventOccurrence).
+ * \param integrator Numerical integrator that is used for propagation, which must use dense output. Upon input to this
+ * function, the integrator is at the end of the last integration step.
+ * \param eventDetector Object used to detect the events, and in which the detected events are stored
+ * \param propagationIsForwards Boolean denoting whether the propagation is forwards in time
+ */
+template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType >
+void detectPropagationEvents(
+        const std::shared_ptr< numerical_integrators::NumericalIntegrator< TimeType, StateType, StateType, TimeStepType > > integrator,
+        const std::shared_ptr< PropagationEventDetector > eventDetector,
+        const bool propagationIsForwards )
+{
+    const TimeType stepStartTime = integrator->getPreviousIndependentVariable( );
+    const TimeStepType stepSize = static_cast< TimeStepType >( integrator->getCurrentIndependentVariable( ) - stepStartTime );
+
+    // Compute event functions at end of step
+    integrator->evaluateCurrentStateDerivative( );
+    std::vector< double > currentEventFunctionValues = eventDetector->getEventFunctionValues( );
+    std::vector< double > previousEventFunctionValues = eventDetector->getPreviousEventFunctionValues( );
+    std::vector< std::shared_ptr< PropagationEventCondition > > eventConditions = eventDetector->getEventConditions( );
+
+    std::vector< PropagationEventOccurrence > stepEventOccurrences;
+    for( unsigned int i = 0; i < eventConditions.size( ); i++ )
+    {
+        std::shared_ptr< PropagationEventCondition > eventCondition = eventConditions.at( i );
+        if( eventCondition->isEventCrossing(
+                    previousEventFunctionValues.at( i ), currentEventFunctionValues.at( i ), propagationIsForwards ) )
+        {
+            // Function for which the root (zero value) occurs at the event
+            std::function< TimeStepType( TimeStepType ) > eventFunction = [ & ]( const TimeStepType timeStep )
+            {
+                TimeType currentTime = stepStartTime + timeStep;
+                integrator->getStateDerivativeFunction( )( currentTime, integrator->getDenseOutputState( currentTime ) );
+                return static_cast< TimeStepType >( eventCondition->getEventFunctionValue( ) );
+            };
+
+            // Create root finder.
+            std::shared_ptr< root_finders::RootFinder< TimeStepType > > eventRootFinder;
+            if( propagationIsForwards )
+            {
+                eventRootFinder = root_finders::createRootFinder< TimeStepType >(
+                            eventCondition->getEventRootFinderSettings( ),
+                            static_cast< TimeStepType >( std::numeric_limits< double >::min( ) ),
+                            stepSize,
+                            static_cast< TimeStepType >( std::numeric_limits< double >::min( ) ) );
+            }
+            else
+            {
+                eventRootFinder = root_finders::createRootFinder< TimeStepType >(
+                            eventCondition->getEventRootFinderSettings( ),
+                            stepSize,
+                            static_cast< TimeStepType >( -std::numeric_limits< double >::min( ) ),
+                            stepSize );
+            }
+
+            // Locate event, and store time and state (or store event as unresolved, at end of step, if root finder fails)
+            const bool isEventFunctionIncreasing =
+                    ( currentEventFunctionValues.at( i ) > previousEventFunctionValues.at( i ) ) == propagationIsForwards;
+            const std::pair< double, double > bracketingInterval = std::make_pair(
+                        static_cast< double >( stepStartTime ),
+                        static_cast< double >( integrator->getCurrentIndependentVariable( ) ) );
+            try
+            {
+                TimeStepType eventTimeStep = eventRootFinder->execute(
+                            std::make_shared< basic_mathematics::FunctionProxy< TimeStepType, TimeStepType > >(
+                                eventFunction ), stepSize / 2.0 );
+                TimeType eventTime = stepStartTime + eventTimeStep;
+                StateType eventState = integrator->getDenseOutputState( eventTime );
+                stepEventOccurrences.push_back(
+                            PropagationEventOccurrence(
+                                i, eventCondition->getEventName( ), static_cast< double >( eventTime ),
+                                isEventFunctionIncreasing, eventState.template cast< double >( ), true,
+                                bracketingInterval ) );
+            }
+            catch( std::runtime_error& caughtException )
+            {
+                std::cerr << "Warning when locating propagation event " << eventCondition->getEventName( )
+                          << ", root finder could not find a root to the function, event is saved as unresolved at t="
+                          << bracketingInterval.second << ". Caught exception: " << caughtException.what( ) << std::endl;
+
+                const TimeType stepEndTime = integrator->getCurrentIndependentVariable( );
+                StateType stepEndState = integrator->getDenseOutputState( stepEndTime );
+                stepEventOccurrences.push_back(
+                            PropagationEventOccurrence(
+                                i, eventCondition->getEventName( ), static_cast< double >( stepEndTime ),
+                                isEventFunctionIncreasing, stepEndState.template cast< double >( ), false,
+                                bracketingInterval ) );
+            }
+        }
+    }
+
+    eventDetector->addEventOccurrences( stepEventOccurrences, propagationIsForwards );
+    eventDetector->setPreviousEventFunctionValues( currentEventFunctionValues );
+}
+
 //! Function to numerically integrate a given first order differential equation
 /*!
  *  Function to numerically integrate a given first order differential equation, with the state derivative a function of
@@ -453,12 +781,12 @@ void propagateToExactTerminationCondition(
  *  \param integrator Numerical integrator used for propagation
  *  \param initialTimeStep Time step to use for first step of numerical integration
  *  \param propagationTerminationCondition Object to determine when/how the propagation is to be stopped at the current time.
- *  \param solutionHistory History of state variables that are to be saved given as map
- *  (time as key; returned by reference)
- *  \param dependentVariableHistory History of dependent variables that are to be saved given as map
- *  (time as key; returned by reference)
+ *  \param solutionHistory History of state variables that are to be saved given as map (time as key) or
+ *  ColumnarHistory (returned by reference)
+ *  \param dependentVariableHistory History of dependent variables that are to be saved given as map (time as key) or
+ *  ColumnarHistory (returned by reference)
  *  \param cumulativeComputationTimeHistory History of cumulative computation times that are to be saved given
- *  as map (time as key; returned by reference)
+ *  as map (time as key) or ColumnarHistory (returned by reference)
  *  \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
  *  derivative model).
  *  \param statePostProcessingFunction Function to post-process state after numerical integration (obtained from state derivative model).
@@ -467,21 +795,34 @@ void propagateToExactTerminationCondition(
  *  \param printInterval Frequency with which to print progress to console (nan = never).
  *  \param initialClockTime Initial clock time from which to determine cumulative computation time.
  *  By default now(), i.e. the moment at which this function is called.
+ *  \param denseOutputInterval Interval between epochs at which the results are saved using the dense output of the
+ *  integrator (nan = results are saved at integration steps, using saveFrequency). If used, the results are saved at
+ *  integer multiples of the interval, as well as at the initial and final time of the propagation.
+ *  \param eventDetector Object used to detect events during the propagation, in which the detected events are stored
+ *  (nullptr = no events are detected). If used, the integrator must support dense output.
+ *  \param stepCompletionFunction Function that is called with the current time at the initial time and after each
+ *  integration step, e.g. to save the number of state derivative evaluations per step (empty = none).
  *  \return Event that triggered the termination of the propagation
  */
-template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType  >
+template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType,
+          typename StateHistoryType = std::map< TimeType, StateType >,
+          typename DependentVariableHistoryType = std::map< TimeType, Eigen::VectorXd >,
+          typename ComputationTimeHistoryType = std::map< TimeType, double > >
 std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrator(
         const std::shared_ptr< numerical_integrators::NumericalIntegrator< TimeType, StateType, StateType, TimeStepType > > integrator,
         const TimeStepType initialTimeStep,
         const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
-        std::map< TimeType, StateType >& solutionHistory,
-        std::map< TimeType, Eigen::VectorXd >& dependentVariableHistory,
-        std::map< TimeType, double >& cumulativeComputationTimeHistory,
+        StateHistoryType& solutionHistory,
+        DependentVariableHistoryType& dependentVariableHistory,
+        ComputationTimeHistoryType& cumulativeComputationTimeHistory,
         const std::function< Eigen::VectorXd( ) > dependentVariableFunction = std::function< Eigen::VectorXd( ) >( ),
         const std::function< void( StateType& ) > statePostProcessingFunction = std::function< void( StateType& ) >( ),
         const int saveFrequency = TUDAT_NAN,
         const TimeType printInterval = TUDAT_NAN,
-        const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ) )
+        const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ),
+        const double denseOutputInterval = TUDAT_NAN,
+        const std::shared_ptr< PropagationEventDetector > eventDetector = nullptr,
+        const std::function< void( const TimeType ) > stepCompletionFunction = std::function< void( const TimeType ) >( ) )
 {
     std::shared_ptr< PropagationTerminationDetails > propagationTerminationReason;
 
@@ -491,21 +832,25 @@ std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrato
     StateType newState = integrator->getCurrentState( );
 
     // Initialization of numerical solutions for variational equations
-    solutionHistory.clear( );
-    solutionHistory[ currentTime ] = newState;
+    utilities::clearHistory( solutionHistory );
+    utilities::addHistoryEntry( solutionHistory, currentTime, newState );
 
-    dependentVariableHistory.clear( );
+    utilities::clearHistory( dependentVariableHistory );
     if( !( dependentVariableFunction == nullptr ) )
     {
         integrator->getStateDerivativeFunction( )( currentTime, newState );
-        dependentVariableHistory[ currentTime ] = dependentVariableFunction( );
+        utilities::addHistoryEntry( dependentVariableHistory, currentTime, dependentVariableFunction( ) );
     }
 
     // CPU time
-    cumulativeComputationTimeHistory.clear( );
+    utilities::clearHistory( cumulativeComputationTimeHistory );
     double currentCPUTime = std::chrono::duration_cast< std::chrono::nanoseconds >(
                 std::chrono::steady_clock::now( ) - initialClockTime ).count( ) * 1.0e-9;
-    cumulativeComputationTimeHistory[ currentTime ] = currentCPUTime;
+    utilities::addHistoryEntry( cumulativeComputationTimeHistory, currentTime, currentCPUTime );
+    if( stepCompletionFunction != nullptr )
+    {
+        stepCompletionFunction( currentTime );
+    }
 
     // Set initial time step and total integration time.
     TimeStepType timeStep = initialTimeStep;
@@ -514,6 +859,33 @@ std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrato
 
     int saveIndex = 0;
 
+    // Set first epoch at which dense output is saved (after initial time), if required
+    const bool useDenseOutput = ( denseOutputInterval == denseOutputInterval );
+    const int propagationDirection = ( static_cast< double >( initialTimeStep ) > 0.0 ) ? 1 : -1;
+    long long denseOutputIndex = 0;
+    if( useDenseOutput || eventDetector != nullptr )
+    {
+        integrator->setUseDenseOutput( true );
+    }
+    if( useDenseOutput )
+    {
+        if( !( denseOutputInterval > 0.0 ) )
+        {
+            throw std::runtime_error( "Error when propagating with dense output, output interval must be positive" );
+        }
+
+        long double initialOutputIndex = static_cast< long double >( currentTime ) / denseOutputInterval;
+        denseOutputIndex = static_cast< long long >(
+                    ( propagationDirection > 0 ) ? std::floor( initialOutputIndex ) + 1 : std::ceil( initialOutputIndex ) - 1 );
+    }
+
+    // Compute event functions at initial state, if required
+    if( eventDetector != nullptr )
+    {
+        integrator->evaluateCurrentStateDerivative( );
+        eventDetector->resetEventFunctionValues( );
+    }
+
     propagationTerminationReason = std::make_shared< PropagationTerminationDetails >(
                 unknown_propagation_termination_reason );
     bool breakPropagation = 0;
@@ -551,17 +923,17 @@ std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrato
                 currentTime = integrator->getCurrentIndependentVariable( );
                 timeStep = integrator->getNextStepSize( );
 
-                // Save integration result in map
+                // Save integration result in map (when using dense output, results are saved after checking termination)
                 saveIndex++;
                 saveIndex = saveIndex % saveFrequency;
-                if( saveIndex == 0 )
+                if( !useDenseOutput && saveIndex == 0 )
                 {
-                    solutionHistory[ currentTime ] = newState;
+                    utilities::addHistoryEntry( solutionHistory, currentTime, newState );
 
                     if( !( dependentVariableFunction == nullptr ) )
                     {
                         integrator->getStateDerivativeFunction( )( currentTime, newState );
-                        dependentVariableHistory[ currentTime ] = dependentVariableFunction( );
+                        utilities::addHistoryEntry( dependentVariableHistory, currentTime, dependentVariableFunction( ) );
                     }
                 }
             }
@@ -576,7 +948,11 @@ std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrato
 
             currentCPUTime = std::chrono::duration_cast< std::chrono::nanoseconds >(
                         std::chrono::steady_clock::now( ) - initialClockTime ).count( ) * 1.0e-9;
-            cumulativeComputationTimeHistory[ currentTime ] = currentCPUTime;
+            utilities::addHistoryEntry( cumulativeComputationTimeHistory, currentTime, currentCPUTime );
+            if( stepCompletionFunction != nullptr )
+            {
+                stepCompletionFunction( currentTime );
+            }
 
             // Print solutions
             if( printInterval == printInterval )
@@ -593,14 +969,36 @@ std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrato
 
             if( propagationTerminationCondition->checkStopCondition( static_cast< double >( currentTime ), currentCPUTime ) )
             {
-                if( propagationTerminationCondition->getcheckTerminationToExactCondition( ) )
+                if( eventDetector != nullptr && !breakPropagation )
+                {
+                    detectPropagationEvents( integrator, eventDetector, propagationDirection > 0 );
+                }
+
+                if( useDenseOutput )
+                {
+                    saveFinalStepDenseOutputHistory(
+                                integrator, propagationTerminationCondition, denseOutputInterval, propagationDirection,
+                                denseOutputIndex, dependentVariableFunction, statePostProcessingFunction,
+                                solutionHistory, dependentVariableHistory, currentCPUTime );
+                }
+                else if( propagationTerminationCondition->getcheckTerminationToExactCondition( ) )
                 {
                     propagateToExactTerminationCondition(
                                 integrator, propagationTerminationCondition,
-                                timeStep, dependentVariableFunction,
+                                timeStep, dependentVariableFunction, statePostProcessingFunction,
                                 solutionHistory, dependentVariableHistory, currentCPUTime );
                 }
 
+                // Remove events detected after exact final time
+                if( eventDetector != nullptr && propagationTerminationCondition->getcheckTerminationToExactCondition( ) &&
+                        utilities::getHistorySize( solutionHistory ) > 0 )
+                {
+                    eventDetector->removeEventOccurrencesAfterTime(
+                                static_cast< double >( utilities::getLastAddedHistoryTime(
+                                                           solutionHistory, propagationDirection > 0 ) ),
+                                propagationDirection > 0 );
+                }
+
                 // Set termination details
                 if( propagationTerminationCondition->getTerminationType( ) != hybrid_stopping_condition )
                 {
@@ -622,6 +1020,23 @@ std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrato
                 }
                 breakPropagation = true;
             }
+            else if( !breakPropagation )
+            {
+                // Detect events within the current step
+                if( eventDetector != nullptr )
+                {
+                    detectPropagationEvents( integrator, eventDetector, propagationDirection > 0 );
+                }
+
+                // Save results at dense output epochs within the current step
+                if( useDenseOutput )
+                {
+                    saveDenseOutputHistory(
+                                integrator, currentTime, denseOutputInterval, propagationDirection, denseOutputIndex,
+                                dependentVariableFunction, statePostProcessingFunction, solutionHistory,
+                                dependentVariableHistory );
+                }
+            }
         }
         catch( const std::exception& caughtException )
         {
@@ -650,7 +1065,10 @@ Eigen::MatrixXd, double, double >(
         const std::function< void( Eigen::MatrixXd& ) > statePostProcessingFunction,
         const int saveFrequency,
         const double printInterval,
-        const std::chrono::steady_clock::time_point initialClockTime );
+        const std::chrono::steady_clock::time_point initialClockTime,
+        const double denseOutputInterval,
+        const std::shared_ptr< PropagationEventDetector > eventDetector,
+        const std::function< void( const double ) > stepCompletionFunction );
 
 
 extern template std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrator<
@@ -665,7 +1083,10 @@ Eigen::VectorXd, double, double >(
         const std::function< void( Eigen::VectorXd& ) > statePostProcessingFunction,
         const int saveFrequency,
         const double printInterval,
-        const std::chrono::steady_clock::time_point initialClockTime );
+        const std::chrono::steady_clock::time_point initialClockTime,
+        const double denseOutputInterval,
+        const std::shared_ptr< PropagationEventDetector > eventDetector,
+        const std::function< void( const double ) > stepCompletionFunction );
 
 
 //! Interface class for integrating some state derivative function.
@@ -685,34 +1106,43 @@ public:
      *  Function to numerically integrate a given first order differential equation, with the state derivative a function of
      *  a single independent variable and the current state
      *  \param stateDerivativeFunction Function returning the state derivative from current time and state.
-     *  \param solutionHistory History of numerical states given as map (time as key; returned by reference)
+     *  \param solutionHistory History of numerical states given as map (time as key) or ColumnarHistory
+     *  (returned by reference)
      *  \param initialState Initial state
      *  \param integratorSettings Settings for numerical integrator.
      *  \param propagationTerminationCondition Object to determine when/how the propagation is to be stopped at the current time.
-     *  \param dependentVariableHistory History of dependent variables that are to be saved given as map
-     *  (time as key; returned by reference)
+     *  \param dependentVariableHistory History of dependent variables that are to be saved given as map (time as key)
+     *  or ColumnarHistory (returned by reference)
      *  \param cumulativeComputationTimeHistory History of cumulative computation times that are to be saved given
-     *  as map (time as key; returned by reference)
+     *  as map (time as key) or ColumnarHistory (returned by reference)
      *  \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
      *  derivative model).
      *  \param statePostProcessingFunction Function to post-process state after numerical integration (obtained from state derivative model).
      *  \param printInterval Frequency with which to print progress to console (nan = never).
      *  \param initialClockTime Initial clock time from which to determine cumulative computation time.
      *  By default now(), i.e. the moment at which this function is called.
+     *  \param eventDetector Object used to detect events during the propagation (nullptr = no events are detected).
+     *  \param stepCompletionFunction Function that is called with the current time at the initial time and after each
+     *  integration step (empty = none).
      *  \return Event that triggered the termination of the propagation
      */
+    template< typename StateHistoryType = std::map< TimeType, StateType >,
+              typename DependentVariableHistoryType = std::map< TimeType, Eigen::VectorXd >,
+              typename ComputationTimeHistoryType = std::map< TimeType, double > >
     static std::shared_ptr< PropagationTerminationDetails > integrateEquations(
             std::function< StateType( const TimeType, const StateType& ) > stateDerivativeFunction,
-            std::map< TimeType, StateType >& solutionHistory,
+            StateHistoryType& solutionHistory,
             const StateType initialState,
             const std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > integratorSettings,
             const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
-            std::map< TimeType, Eigen::VectorXd >& dependentVariableHistory,
-            std::map< TimeType, double >& cumulativeComputationTimeHistory,
+            DependentVariableHistoryType& dependentVariableHistory,
+            ComputationTimeHistoryType& cumulativeComputationTimeHistory,
             const std::function< Eigen::VectorXd( ) > dependentVariableFunction = std::function< Eigen::VectorXd( ) >( ),
             const std::function< void( StateType& ) > statePostProcessingFunction = std::function< void( StateType& ) >( ),
             const TimeType printInterval = TUDAT_NAN,
-            const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ) );
+            const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ),
+            const std::shared_ptr< PropagationEventDetector > eventDetector = nullptr,
+            const std::function< void( const TimeType ) > stepCompletionFunction = std::function< void( const TimeType ) >( ) );
 
 };
 
@@ -727,34 +1157,43 @@ public:
      *  Function to numerically integrate a given first order differential equation, with the state derivative a function of
      *  a single independent variable and the current state
      *  \param stateDerivativeFunction Function returning the state derivative from current time and state.
-     *  \param solutionHistory History of numerical states given as map (time as key; returned by reference)
+     *  \param solutionHistory History of numerical states given as map (time as key) or ColumnarHistory
+     *  (returned by reference)
      *  \param initialState Initial state
      *  \param integratorSettings Settings for numerical integrator.
      *  \param propagationTerminationCondition Object to determine when/how the propagation is to be stopped at the current time.
-     *  \param dependentVariableHistory History of dependent variables that are to be saved given as map
-     *  (time as key; returned by reference)
+     *  \param dependentVariableHistory History of dependent variables that are to be saved given as map (time as key)
+     *  or ColumnarHistory (returned by reference)
      *  \param cumulativeComputationTimeHistory History of cumulative computation times that are to be saved given
-     *  as map (time as key; returned by reference)
+     *  as map (time as key) or ColumnarHistory (returned by reference)
      *  \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
      *  derivative model).
      *  \param statePostProcessingFunction Function to post-process state after numerical integration (obtained from state derivative model).
      *  \param printInterval Frequency with which to print progress to console (nan = never).
      *  \param initialClockTime Initial clock time from which to determine cumulative computation time.
      *  By default now(), i.e. the moment at which this function is called.
+     *  \param eventDetector Object used to detect events during the propagation (nullptr = no events are detected).
+     *  \param stepCompletionFunction Function that is called with the current time at the initial time and after each
+     *  integration step (empty = none).
      *  \return Event that triggered the termination of the propagation
      */
+    template< typename StateHistoryType = std::map< double, StateType >,
+              typename DependentVariableHistoryType = std::map< double, Eigen::VectorXd >,
+              typename ComputationTimeHistoryType = std::map< double, double > >
     static std::shared_ptr< PropagationTerminationDetails > integrateEquations(
             std::function< StateType( const double, const StateType& ) > stateDerivativeFunction,
-            std::map< double, StateType >& solutionHistory,
+            StateHistoryType& solutionHistory,
             const StateType initialState,
             const std::shared_ptr< numerical_integrators::IntegratorSettings< double > > integratorSettings,
             const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
-            std::map< double, Eigen::VectorXd >& dependentVariableHistory,
-            std::map< double, double >& cumulativeComputationTimeHistory,
+            DependentVariableHistoryType& dependentVariableHistory,
+            ComputationTimeHistoryType& cumulativeComputationTimeHistory,
             const std::function< Eigen::VectorXd( ) > dependentVariableFunction = std::function< Eigen::VectorXd( ) >( ),
             const std::function< void( StateType& ) > statePostProcessingFunction = std::function< void( StateType& ) >( ),
             const double printInterval = TUDAT_NAN,
-            const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ) )
+            const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ),
+            const std::shared_ptr< PropagationEventDetector > eventDetector = nullptr,
+            const std::function< void( const double ) > stepCompletionFunction = std::function< void( const double ) >( ) )
     {
         std::function< bool( const double, const double ) > stopPropagationFunction =
                 std::bind( &PropagationTerminationCondition::checkStopCondition, propagationTerminationCondition, std::placeholders::_1, std::placeholders::_2 );
@@ -769,6 +1208,11 @@ public:
             integrator->setPropagationTerminationFunction( stopPropagationFunction );
         }
 
+        if( integratorSettings->locateTerminationUsingDenseOutput_ )
+        {
+            integrator->setUseDenseOutput( true );
+        }
+
         return integrateEquationsFromIntegrator< StateType, double >(
                     integrator, integratorSettings->initialTimeStep_, propagationTerminationCondition, solutionHistory,
                     dependentVariableHistory,
@@ -777,7 +1221,10 @@ public:
                     statePostProcessingFunction,
                     integratorSettings->saveFrequency_,
                     printInterval,
-                    initialClockTime );
+                    initialClockTime,
+                    integratorSettings->denseOutputInterval_,
+                    eventDetector,
+                    stepCompletionFunction );
     }
 
 };
@@ -793,34 +1240,43 @@ public:
      *  Function to numerically integrate a given first order differential equation, with the state derivative a function of
      *  a single independent variable and the current state
      *  \param stateDerivativeFunction Function returning the state derivative from current time and state.
-     *  \param solutionHistory History of numerical states given as map (time as key; returned by reference)
+     *  \param solutionHistory History of numerical states given as map (time as key) or ColumnarHistory
+     *  (returned by reference)
      *  \param initialState Initial state
      *  \param integratorSettings Settings for numerical integrator.
      *  \param propagationTerminationCondition Object to determine when/how the propagation is to be stopped at the current time.
-     *  \param dependentVariableHistory History of dependent variables that are to be saved given as map
-     *  (time as key; returned by reference)
+     *  \param dependentVariableHistory History of dependent variables that are to be saved given as map (time as key)
+     *  or ColumnarHistory (returned by reference)
      *  \param cumulativeComputationTimeHistory History of cumulative computation times that are to be saved given
-     *  as map (time as key; returned by reference)
+     *  as map (time as key) or ColumnarHistory (returned by reference)
      *  \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
      *  derivative model).
      *  \param statePostProcessingFunction Function to post-process state after numerical integration (obtained from state derivative model).
      *  \param printInterval Frequency with which to print progress to console (nan = never).
      *  \param initialClockTime Initial clock time from which to determine cumulative computation time.
      *  By default now(), i.e. the moment at which this function is called.
+     *  \param eventDetector Object used to detect events during the propagation (nullptr = no events are detected).
+     *  \param stepCompletionFunction Function that is called with the current time at the initial time and after each
+     *  integration step (empty = none).
      *  \return Event that triggered the termination of the propagation
      */
+    template< typename StateHistoryType = std::map< Time, StateType >,
+              typename DependentVariableHistoryType = std::map< Time, Eigen::VectorXd >,
+              typename ComputationTimeHistoryType = std::map< Time, double > >
     static std::shared_ptr< PropagationTerminationDetails > integrateEquations(
             std::function< StateType( const Time, const StateType& ) > stateDerivativeFunction,
-            std::map< Time, StateType >& solutionHistory,
+            StateHistoryType& solutionHistory,
             const StateType initialState,
             const std::shared_ptr< numerical_integrators::IntegratorSettings< Time > > integratorSettings,
             const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
-            std::map< Time, Eigen::VectorXd >& dependentVariableHistory,
-            std::map< Time, double >& cumulativeComputationTimeHistory,
+            DependentVariableHistoryType& dependentVariableHistory,
+            ComputationTimeHistoryType& cumulativeComputationTimeHistory,
             const std::function< Eigen::VectorXd( ) > dependentVariableFunction = std::function< Eigen::VectorXd( ) >( ),
             const std::function< void( StateType& ) > statePostProcessingFunction = std::function< void( StateType& ) >( ),
             const Time printInterval = TUDAT_NAN,
-            const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ) )
+            const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ),
+            const std::shared_ptr< PropagationEventDetector > eventDetector = nullptr,
+            const std::function< void( const Time ) > stepCompletionFunction = std::function< void( const Time ) >( ) )
     {
         std::function< bool( const double, const double ) > stopPropagationFunction =
                 std::bind( &PropagationTerminationCondition::checkStopCondition, propagationTerminationCondition, std::placeholders::_1, std::placeholders::_2 );
@@ -835,6 +1291,11 @@ public:
             integrator->setPropagationTerminationFunction( stopPropagationFunction );
         }
 
+        if( integratorSettings->locateTerminationUsingDenseOutput_ )
+        {
+            integrator->setUseDenseOutput( true );
+        }
+
         return integrateEquationsFromIntegrator< StateType, Time, long double >(
                     integrator, integratorSettings->initialTimeStep_, propagationTerminationCondition, solutionHistory,
                     dependentVariableHistory,
@@ -843,7 +1304,10 @@ public:
                     statePostProcessingFunction,
                     integratorSettings->saveFrequency_,
                     printInterval,
-                    initialClockTime );
+                    initialClockTime,
+                    integratorSettings->denseOutputInterval_,
+                    eventDetector,
+                    stepCompletionFunction );
     }
 
 };
@@ -209,6 +209,7 @@ public:
     {
         for( unsigned int i = 0; i < accelerationModelList_.size( ); i++ )
         {
+            TUDAT_PROFILE_SCOPE( profiler_.get( ), accelerationModelProfilingScopes_.at( i ) );
             accelerationModelList_.at( i )->updateMembers( currentTime );
         }
 
@@ -369,6 +370,22 @@ public:
         }
     }
 
+    // Function to set the profiler in which the evaluation time of the acceleration models is to be recorded
+    /*
+     * Function to set the profiler in which the evaluation time of the acceleration models is to be recorded. A scope is
+     * created for each acceleration model, named by the acceleration type and the bodies exerting and undergoing the
+     * acceleration. Timing is only performed if TUDAT_BUILD_WITH_PROFILING is enabled.
+     * \param profiler Profiler in which the evaluation time is to be recorded (nullptr to disable)
+     * \param parentScopeIndex Index of the profiler scope of this state derivative model
+     */
+    void setPropagationProfiler( const std::shared_ptr< utilities::PropagationProfiler > profiler,
+                                 const int parentScopeIndex )
+    {
+        profiler_ = profiler;
+        profilingScopeIndex_ = parentScopeIndex;
+        createAccelerationModelList( );
+    }
+
 
 
 protected:
@@ -405,6 +422,7 @@ protected:
     {
         // Iterate over all accelerations and update their internal state.
         accelerationModelList_.clear( );
+        accelerationModelProfilingScopes_.clear( );
         for( outerAccelerationIterator = accelerationModelsPerBody_.begin( );
              outerAccelerationIterator != accelerationModelsPerBody_.end( ); outerAccelerationIterator++ )
         {
@@ -417,6 +435,18 @@ protected:
                 for( unsigned int j = 0; j < innerAccelerationIterator->second.size( ); j++ )
                 {
                     accelerationModelList_.push_back( innerAccelerationIterator->second.at( j ) );
+
+                    // Register profiling scope for acceleration
+                    accelerationModelProfilingScopes_.push_back( -1 );
+                    if( profiler_ != nullptr )
+                    {
+                        accelerationModelProfilingScopes_.back( ) = profiler_->addScope(
+                                    basic_astrodynamics::getAccelerationModelName(
+                                        basic_astrodynamics::getAccelerationModelType(
+                                            innerAccelerationIterator->second.at( j ) ) ) + ":" +
+                                    innerAccelerationIterator->first + "->" + outerAccelerationIterator->first,
+                                    profilingScopeIndex_ );
+                    }
                 }
             }
         }
@@ -516,6 +546,15 @@ protected:
     // Vector of acceleration models, containing all entries of accelerationModelsPerBody_.
     std::vector< std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > > accelerationModelList_;
 
+    // Profiler in which the evaluation time of the acceleration models is recorded (nullptr if none)
+    std::shared_ptr< utilities::PropagationProfiler > profiler_;
+
+    // Index of the profiler scope of this state derivative model
+    int profilingScopeIndex_ = -1;
+
+    // Index of the profiler scope of each entry of accelerationModelList_ (-1 if no profiler is set)
+    std::vector< int > accelerationModelProfilingScopes_;
+
     // Object responsible for providing the current integration origins from the global origins.
     std::shared_ptr< CentralBodyData< StateScalarType, TimeType > > centralBodyData_;
 
@@ -0,0 +1,1122 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_PROPAGATIONOUTPUTSINK_H
+#define TUDAT_PROPAGATIONOUTPUTSINK_H
+
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/timeType.h"
+#include "tudat/io/binaryHistoryFile.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Base class for objects to which the propagation output is streamed during the propagation
+/*!
+ *  Base class for objects to which the propagation output is streamed during the propagation, without template arguments, so
+ *  that it can be stored in the (single-arc) propagator settings. All output sinks must derive from PropagationOutputSink.
+ */
+class PropagationOutputSinkBase
+{
+public:
+
+    //! Virtual destructor
+    virtual ~PropagationOutputSinkBase( ){ }
+};
+
+//! Base class for objects to which the state and dependent variables are streamed during a single-arc propagation
+/*!
+ *  Base class for objects to which the state and dependent variables are streamed during a single-arc propagation (see
+ *  SingleArcPropagatorSettings::addOutputSink), so that the propagation output can be processed without storing the full
+ *  history in memory. The processStep function is called for each epoch at which the propagation results are saved (see
+ *  IntegratorSettings::saveFrequency_), in the order in which they are propagated, with the state in the conventional form
+ *  (e.g. Cartesian elements for translational dynamics). Each epoch is passed to the sink one step after it was
+ *  propagated, so that the final epoch can still be replaced when propagating to an exact termination condition. The
+ *  TimeType and StateScalarType must be equal to those of the propagation.
+ */
+template< typename TimeType = double, typename StateScalarType = double >
+class PropagationOutputSink: public PropagationOutputSinkBase
+{
+public:
+
+    //! Virtual destructor
+    virtual ~PropagationOutputSink( ){ }
+
+    //! Function called at the start of each propagation
+    /*!
+     *  Function called at the start of each propagation, before any step is processed.
+     *  \param dependentVariableIds Map listing starting entry of dependent variables in output vector, along with associated
+     *  ID (empty if no dependent variables are saved)
+     */
+    virtual void initialize( const std::map< int, std::string >& dependentVariableIds ){ }
+
+    //! Function to process the propagation output at a single epoch
+    /*!
+     *  Function to process the propagation output at a single epoch
+     *  \param time Current time
+     *  \param state Current state, in conventional form
+     *  \param dependentVariables Current dependent variables (empty if no dependent variables are saved)
+     */
+    virtual void processStep( const TimeType& time,
+                              const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& state,
+                              const Eigen::VectorXd& dependentVariables ) = 0;
+
+    //! Function called at the end of each propagation, after the last step has been processed
+    virtual void finalize( ){ }
+};
+
+//! Output sink that calls a user-defined function for each epoch
+template< typename TimeType = double, typename StateScalarType = double >
+class CustomOutputSink: public PropagationOutputSink< TimeType, StateScalarType >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param stepFunction Function called for each epoch, with time, state and dependent variables as input
+     *  \param finalizeFunction Function called at the end of each propagation (none if empty)
+     */
+    CustomOutputSink( const std::function< void( const TimeType&, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >&,
+                                                 const Eigen::VectorXd& ) > stepFunction,
+                      const std::function< void( ) > finalizeFunction = std::function< void( ) >( ) ):
+        stepFunction_( stepFunction ), finalizeFunction_( finalizeFunction ){ }
+
+    //! Function to process the propagation output at a single epoch (see base class)
+    void processStep( const TimeType& time,
+                      const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& state,
+                      const Eigen::VectorXd& dependentVariables )
+    {
+        stepFunction_( time, state, dependentVariables );
+    }
+
+    //! Function called at the end of each propagation
+    void finalize( )
+    {
+        if( finalizeFunction_ != nullptr )
+        {
+            finalizeFunction_( );
+        }
+    }
+
+private:
+
+    //! Function called for each epoch
+    std::function< void( const TimeType&, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >&,
+                         const Eigen::VectorXd& ) > stepFunction_;
+
+    //! Function called at the end of each propagation
+    std::function< void( ) > finalizeFunction_;
+};
+
+//! Output sink that retains the propagation output of (at most) a given number of most recent epochs
+template< typename TimeType = double, typename StateScalarType = double >
+class RingBufferOutputSink: public PropagationOutputSink< TimeType, StateScalarType >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param capacity Maximum number of epochs that is retained (older epochs are discarded)
+     */
+    RingBufferOutputSink( const unsigned int capacity ):
+        capacity_( capacity )
+    {
+        if( capacity_ == 0 )
+        {
+            throw std::runtime_error( "Error when creating ring buffer output sink, capacity must be non-zero" );
+        }
+    }
+
+    //! Function called at the start of each propagation, discards the output of the previous propagation
+    void initialize( const std::map< int, std::string >& dependentVariableIds )
+    {
+        times_.clear( );
+        states_.clear( );
+        dependentVariables_.clear( );
+    }
+
+    //! Function to process the propagation output at a single epoch (see base class)
+    void processStep( const TimeType& time,
+                      const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& state,
+                      const Eigen::VectorXd& dependentVariables )
+    {
+        if( times_.size( ) == capacity_ )
+        {
+            times_.pop_front( );
+            states_.pop_front( );
+            dependentVariables_.pop_front( );
+        }
+        times_.push_back( time );
+        states_.push_back( state );
+        dependentVariables_.push_back( dependentVariables );
+    }
+
+    //! Function to retrieve the retained state history
+    std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > getStateHistory( ) const
+    {
+        std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > stateHistory;
+        for( unsigned int i = 0; i < times_.size( ); i++ )
+        {
+            stateHistory[ times_.at( i ) ] = states_.at( i );
+        }
+        return stateHistory;
+    }
+
+    //! Function to retrieve the retained dependent variable history
+    std::map< TimeType, Eigen::VectorXd > getDependentVariableHistory( ) const
+    {
+        std::map< TimeType, Eigen::VectorXd > dependentVariableHistory;
+        for( unsigned int i = 0; i < times_.size( ); i++ )
+        {
+            dependentVariableHistory[ times_.at( i ) ] = dependentVariables_.at( i );
+        }
+        return dependentVariableHistory;
+    }
+
+    //! Function to retrieve the number of retained epochs
+    unsigned int size( ) const
+    {
+        return times_.size( );
+    }
+
+private:
+
+    //! Maximum number of epochs that is retained
+    unsigned int capacity_;
+
+    //! Times of the retained epochs
+    std::deque< TimeType > times_;
+
+    //! States at the retained epochs
+    std::deque< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > states_;
+
+    //! Dependent variables at the retained epochs
+    std::deque< Eigen::VectorXd > dependentVariables_;
+};
+
+//! Output sink that computes running statistics of all state and dependent variable entries
+/*!
+ *  Output sink that computes running statistics (mean, standard deviation, minimum and maximum) of all state and
+ *  dependent variable entries, over all epochs passed to it. The entries are ordered as the state, followed by the
+ *  dependent variables. Note that the statistics are computed per epoch, so that they are only representative of a time
+ *  average if the epochs are (approximately) equidistant (e.g. when combined with a FixedIntervalOutputSink).
+ */
+template< typename TimeType = double, typename StateScalarType = double >
+class RunningStatisticsOutputSink: public PropagationOutputSink< TimeType, StateScalarType >
+{
+public:
+
+    //! Constructor
+    RunningStatisticsOutputSink( ): numberOfSteps_( 0 ){ }
+
+    //! Function called at the start of each propagation, resets the statistics
+    void initialize( const std::map< int, std::string >& dependentVariableIds )
+    {
+        numberOfSteps_ = 0;
+    }
+
+    //! Function to process the propagation output at a single epoch (see base class)
+    void processStep( const TimeType& time,
+                      const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& state,
+                      const Eigen::VectorXd& dependentVariables )
+    {
+        currentValues_.resize( state.rows( ) + dependentVariables.rows( ) );
+        currentValues_.segment( 0, state.rows( ) ) = state.template cast< double >( );
+        currentValues_.segment( state.rows( ), dependentVariables.rows( ) ) = dependentVariables;
+
+        if( numberOfSteps_ == 0 )
+        {
+            mean_ = currentValues_;
+            sumOfSquaredDeviations_ = Eigen::VectorXd::Zero( currentValues_.rows( ) );
+            minimum_ = currentValues_;
+            maximum_ = currentValues_;
+        }
+        else if( currentValues_.rows( ) != mean_.rows( ) )
+        {
+            throw std::runtime_error( "Error in running statistics output sink, size of output changed during propagation" );
+        }
+        else
+        {
+            // Update mean and sum of squared deviations using Welford's algorithm
+            Eigen::VectorXd previousDeviation = currentValues_ - mean_;
+            mean_ += previousDeviation / static_cast< double >( numberOfSteps_ + 1 );
+            sumOfSquaredDeviations_ += previousDeviation.cwiseProduct( currentValues_ - mean_ );
+            minimum_ = minimum_.cwiseMin( currentValues_ );
+            maximum_ = maximum_.cwiseMax( currentValues_ );
+        }
+        numberOfSteps_++;
+    }
+
+    //! Function to retrieve the number of epochs over which the statistics are computed
+    unsigned int getNumberOfSteps( ) const
+    {
+        return numberOfSteps_;
+    }
+
+    //! Function to retrieve the mean value of each entry
+    Eigen::VectorXd getMean( ) const
+    {
+        return mean_;
+    }
+
+    //! Function to retrieve the (sample) standard deviation of each entry
+    Eigen::VectorXd getStandardDeviation( ) const
+    {
+        if( numberOfSteps_ < 2 )
+        {
+            throw std::runtime_error( "Error in running statistics output sink, standard deviation requires at least 2 steps" );
+        }
+        return ( sumOfSquaredDeviations_ / static_cast< double >( numberOfSteps_ - 1 ) ).cwiseSqrt( );
+    }
+
+    //! Function to retrieve the minimum value of each entry
+    Eigen::VectorXd getMinimum( ) const
+    {
+        return minimum_;
+    }
+
+    //! Function to retrieve the maximum value of each entry
+    Eigen::VectorXd getMaximum( ) const
+    {
+        return maximum_;
+    }
+
+private:
+
+    //! Number of epochs over which the statistics are computed
+    unsigned int numberOfSteps_;
+
+    //! Mean value of each entry
+    Eigen::VectorXd mean_;
+
+    //! Sum of squared deviations from the mean of each entry
+    Eigen::VectorXd sumOfSquaredDeviations_;
+
+    //! Minimum value of each entry
+    Eigen::VectorXd minimum_;
+
+    //! Maximum value of each entry
+    Eigen::VectorXd maximum_;
+
+    //! Pre-allocated vector of state and dependent variables at current epoch
+    Eigen::VectorXd currentValues_;
+};
+
+//! Output sink that writes the state and dependent variables to a binary history file
+/*!
+ *  Output sink that writes the state and dependent variables to a binary history file (see
+ *  input_output::BinaryHistoryFileWriter), with the state entries followed by the dependent variable entries as columns.
+ *  The columns are named after the state entries and the dependent variable IDs. The file is (re)created at the first epoch
+ *  of each propagation, and closed at the end of each propagation.
+ */
+template< typename TimeType = double, typename StateScalarType = double >
+class BinaryFileOutputSink: public PropagationOutputSink< TimeType, StateScalarType >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param fileName Name of the file to which the output is written
+     *  \param numberOfBufferedEpochs Number of epochs that are collected in memory before being written to the file
+     */
+    BinaryFileOutputSink( const std::string& fileName, const unsigned int numberOfBufferedEpochs = 1024 ):
+        fileName_( fileName ), numberOfBufferedEpochs_( numberOfBufferedEpochs ){ }
+
+    //! Function called at the start of each propagation
+    void initialize( const std::map< int, std::string >& dependentVariableIds )
+    {
+        dependentVariableIds_ = dependentVariableIds;
+        fileWriter_ = nullptr;
+    }
+
+    //! Function to process the propagation output at a single epoch (see base class)
+    void processStep( const TimeType& time,
+                      const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& state,
+                      const Eigen::VectorXd& dependentVariables )
+    {
+        if( fileWriter_ == nullptr )
+        {
+            fileWriter_ = std::make_shared< input_output::BinaryHistoryFileWriter< TimeType, StateScalarType > >(
+                        fileName_, state.rows( ) + dependentVariables.rows( ),
+                        getColumnNames( state.rows( ), dependentVariables.rows( ) ),
+                        std::vector< std::string >( ), numberOfBufferedEpochs_ );
+        }
+
+        currentValues_.resize( state.rows( ) + dependentVariables.rows( ) );
+        currentValues_.segment( 0, state.rows( ) ) = state;
+        currentValues_.segment( state.rows( ), dependentVariables.rows( ) ) =
+                dependentVariables.template cast< StateScalarType >( );
+        fileWriter_->writeEpoch( time, currentValues_ );
+    }
+
+    //! Function called at the end of each propagation, closes the file
+    void finalize( )
+    {
+        if( fileWriter_ != nullptr )
+        {
+            fileWriter_->close( );
+        }
+    }
+
+private:
+
+    //! Function to create the name of each column of the file
+    std::vector< std::string > getColumnNames( const int stateSize, const int dependentVariableSize )
+    {
+        std::vector< std::string > columnNames;
+        for( int i = 0; i < stateSize; i++ )
+        {
+            columnNames.push_back( "State [" + std::to_string( i ) + "]" );
+        }
+
+        for( auto variableIterator = dependentVariableIds_.begin( ); variableIterator != dependentVariableIds_.end( );
+             variableIterator++ )
+        {
+            auto nextVariableIterator = std::next( variableIterator );
+            int variableSize = ( nextVariableIterator == dependentVariableIds_.end( ) ) ?
+                        dependentVariableSize - variableIterator->first :
+                        nextVariableIterator->first - variableIterator->first;
+            for( int i = 0; i < variableSize; i++ )
+            {
+                columnNames.push_back( variableIterator->second + " [" + std::to_string( i ) + "]" );
+            }
+        }
+        columnNames.resize( stateSize + dependentVariableSize );
+        return columnNames;
+    }
+
+    //! Name of the file to which the output is written
+    std::string fileName_;
+
+    //! Number of epochs that are collected in memory before being written to the file
+    unsigned int numberOfBufferedEpochs_;
+
+    //! Map listing starting entry of dependent variables in output vector, along with associated ID
+    std::map< int, std::string > dependentVariableIds_;
+
+    //! Object writing the current output file
+    std::shared_ptr< input_output::BinaryHistoryFileWriter< TimeType, StateScalarType > > fileWriter_;
+
+    //! Pre-allocated vector of state and dependent variables at current epoch
+    Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > currentValues_;
+};
+
+//! Output sink that passes only every N-th epoch to another output sink
+/*!
+ *  Output sink that passes only every N-th epoch (starting with the first) to another output sink, and (optionally) the
+ *  final epoch of the propagation.
+ */
+template< typename TimeType = double, typename StateScalarType = double >
+class DecimatingOutputSink: public PropagationOutputSink< TimeType, StateScalarType >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param decimationFactor Number N, such that every N-th epoch is passed to the output sink
+     *  \param outputSink Output sink to which the selected epochs are passed
+     *  \param includeFinalStep Boolean denoting whether the final epoch of the propagation is always passed to the output sink
+     */
+    DecimatingOutputSink( const unsigned int decimationFactor,
+                          const std::shared_ptr< PropagationOutputSink< TimeType, StateScalarType > > outputSink,
+                          const bool includeFinalStep = true ):
+        decimationFactor_( decimationFactor ), outputSink_( outputSink ), includeFinalStep_( includeFinalStep ),
+        stepIndex_( 0 ), isLastStepPassed_( true )
+    {
+        if( decimationFactor_ == 0 )
+        {
+            throw std::runtime_error( "Error when creating decimating output sink, decimation factor must be non-zero" );
+        }
+    }
+
+    //! Function called at the start of each propagation
+    void initialize( const std::map< int, std::string >& dependentVariableIds )
+    {
+        stepIndex_ = 0;
+        isLastStepPassed_ = true;
+        outputSink_->initialize( dependentVariableIds );
+    }
+
+    //! Function to process the propagation output at a single epoch (see base class)
+    void processStep( const TimeType& time,
+                      const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& state,
+                      const Eigen::VectorXd& dependentVariables )
+    {
+        isLastStepPassed_ = ( stepIndex_ % decimationFactor_ == 0 );
+        if( isLastStepPassed_ )
+        {
+            outputSink_->processStep( time, state, dependentVariables );
+        }
+        else if( includeFinalStep_ )
+        {
+            lastTime_ = time;
+            lastState_ = state;
+            lastDependentVariables_ = dependentVariables;
+        }
+        stepIndex_++;
+    }
+
+    //! Function called at the end of each propagation, passes final epoch to output sink (if required)
+    void finalize( )
+    {
+        if( includeFinalStep_ && !isLastStepPassed_ )
+        {
+            outputSink_->processStep( lastTime_, lastState_, lastDependentVariables_ );
+        }
+        outputSink_->finalize( );
+    }
+
+private:
+
+    //! Number N, such that every N-th epoch is passed to the output sink
+    unsigned int decimationFactor_;
+
+    //! Output sink to which the selected epochs are passed
+    std::shared_ptr< PropagationOutputSink< TimeType, StateScalarType > > outputSink_;
+
+    //! Boolean denoting whether the final epoch of the propagation is always passed to the output sink
+    bool includeFinalStep_;
+
+    //! Index of the current epoch in the propagation
+    unsigned int stepIndex_;
+
+    //! Boolean denoting whether the last processed epoch was passed to the output sink
+    bool isLastStepPassed_;
+
+    //! Time of the last processed epoch
+    TimeType lastTime_;
+
+    //! State at the last processed epoch
+    Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > lastState_;
+
+    //! Dependent variables at the last processed epoch
+    Eigen::VectorXd lastDependentVariables_;
+};
+
+//! Output sink that interpolates the propagation output to a fixed output interval, and passes it to another output sink
+/*!
+ *  Output sink that interpolates the propagation output to epochs that are integer multiples of a fixed output interval,
+ *  and passes the interpolated output to another output sink. This decouples the output cadence from the (variable) step
+ *  size of the integrator. The state and dependent variables are interpolated using Lagrange interpolation over a sliding
+ *  window of the most recent propagated epochs, which is (as far as possible) centered on the output epoch, so that only
+ *  this window needs to be retained in memory. Note that dependent variables that are discontinuous (e.g. angles that are
+ *  wrapped to a fixed interval) are not interpolated meaningfully close to the discontinuity. The output epochs lie within
+ *  the propagated interval.
+ */
+template< typename TimeType = double, typename StateScalarType = double >
+class FixedIntervalOutputSink: public PropagationOutputSink< TimeType, StateScalarType >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param outputInterval Interval between output epochs
+     *  \param outputSink Output sink to which the interpolated output is passed
+     *  \param numberOfInterpolationPoints Number of propagated epochs used for the Lagrange interpolation (at least 2)
+     */
+    FixedIntervalOutputSink( const double outputInterval,
+                             const std::shared_ptr< PropagationOutputSink< TimeType, StateScalarType > > outputSink,
+                             const unsigned int numberOfInterpolationPoints = 8 ):
+        outputInterval_( outputInterval ), outputSink_( outputSink ),
+        numberOfInterpolationPoints_( numberOfInterpolationPoints ), propagationDirection_( 0 ), outputIndex_( 0 )
+    {
+        if( !( outputInterval_ > 0.0 ) )
+        {
+            throw std::runtime_error( "Error when creating fixed interval output sink, output interval must be positive" );
+        }
+        if( numberOfInterpolationPoints_ < 2 )
+        {
+            throw std::runtime_error( "Error when creating fixed interval output sink, at least 2 interpolation points are required" );
+        }
+    }
+
+    //! Function called at the start of each propagation
+    void initialize( const std::map< int, std::string >& dependentVariableIds )
+    {
+        times_.clear( );
+        states_.clear( );
+        dependentVariables_.clear( );
+        propagationDirection_ = 0;
+        outputSink_->initialize( dependentVariableIds );
+    }
+
+    //! Function to process the propagation output at a single epoch (see base class)
+    void processStep( const TimeType& time,
+                      const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& state,
+                      const Eigen::VectorXd& dependentVariables )
+    {
+        times_.push_back( time );
+        states_.push_back( state );
+        dependentVariables_.push_back( dependentVariables );
+        if( times_.size( ) > numberOfInterpolationPoints_ )
+        {
+            times_.pop_front( );
+            states_.pop_front( );
+            dependentVariables_.pop_front( );
+        }
+
+        // Determine direction of propagation and first output epoch
+        if( propagationDirection_ == 0 && times_.size( ) == 2 )
+        {
+            propagationDirection_ = ( times_.at( 1 ) > times_.at( 0 ) ) ? 1 : -1;
+            long double firstOutputIndex = static_cast< long double >( times_.at( 0 ) ) / outputInterval_;
+            outputIndex_ = static_cast< long long >(
+                        ( propagationDirection_ > 0 ) ? std::ceil( firstOutputIndex ) : std::floor( firstOutputIndex ) );
+        }
+
+        // Interpolate to all output epochs up to center of interpolation window
+        if( times_.size( ) == numberOfInterpolationPoints_ )
+        {
+            while( isOutputEpochBefore( times_.at( numberOfInterpolationPoints_ / 2 ) ) )
+            {
+                passInterpolatedOutput( );
+            }
+        }
+    }
+
+    //! Function called at the end of each propagation, passes output epochs up to the final propagated epoch
+    void finalize( )
+    {
+        if( propagationDirection_ != 0 )
+        {
+            while( isOutputEpochBefore( times_.back( ) ) )
+            {
+                passInterpolatedOutput( );
+            }
+        }
+        outputSink_->finalize( );
+    }
+
+private:
+
+    //! Function to retrieve the current output epoch
+    TimeType getCurrentOutputTime( )
+    {
+        return TimeType( static_cast< long double >( outputIndex_ ) * static_cast< long double >( outputInterval_ ) );
+    }
+
+    //! Function to check whether the current output epoch is at or before (in propagation direction) a given time
+    bool isOutputEpochBefore( const TimeType& time )
+    {
+        return ( propagationDirection_ * static_cast< long double >( getCurrentOutputTime( ) - time ) <= 0.0L );
+    }
+
+    //! Function to interpolate the output to the current output epoch, pass it to the output sink, and go to the next epoch
+    void passInterpolatedOutput( )
+    {
+        TimeType outputTime = getCurrentOutputTime( );
+        interpolatedState_.setZero( states_.at( 0 ).rows( ) );
+        interpolatedDependentVariables_.setZero( dependentVariables_.at( 0 ).rows( ) );
+
+        for( unsigned int i = 0; i < times_.size( ); i++ )
+        {
+            long double weight = 1.0L;
+            for( unsigned int j = 0; j < times_.size( ); j++ )
+            {
+                if( i != j )
+                {
+                    weight *= static_cast< long double >( outputTime - times_.at( j ) ) /
+                            static_cast< long double >( times_.at( i ) - times_.at( j ) );
+                }
+            }
+            interpolatedState_ += static_cast< StateScalarType >( weight ) * states_.at( i );
+            interpolatedDependentVariables_ += static_cast< double >( weight ) * dependentVariables_.at( i );
+        }
+
+        outputSink_->processStep( outputTime, interpolatedState_, interpolatedDependentVariables_ );
+        outputIndex_ += propagationDirection_;
+    }
+
+    //! Interval between output epochs
+    double outputInterval_;
+
+    //! Output sink to which the interpolated output is passed
+    std::shared_ptr< PropagationOutputSink< TimeType, StateScalarType > > outputSink_;
+
+    //! Number of propagated epochs used for the Lagrange interpolation
+    unsigned int numberOfInterpolationPoints_;
+
+    //! Direction of propagation (1 forward, -1 backward, 0 not yet known)
+    int propagationDirection_;
+
+    //! Index of the next output epoch (which is at outputIndex_ * outputInterval_)
+    long long outputIndex_;
+
+    //! Times of the propagated epochs in the current interpolation window
+    std::deque< TimeType > times_;
+
+    //! States at the propagated epochs in the current interpolation window
+    std::deque< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > states_;
+
+    //! Dependent variables at the propagated epochs in the current interpolation window
+    std::deque< Eigen::VectorXd > dependentVariables_;
+
+    //! Pre-allocated interpolated state
+    Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > interpolatedState_;
+
+    //! Pre-allocated interpolated dependent variables
+    Eigen::VectorXd interpolatedDependentVariables_;
+};
+
+//! Class that collects the propagation output during a single-arc propagation, and streams it to a list of output sinks
+/*!
+ *  Class that collects the propagation output (raw state, dependent variables and computation time) during a single-arc
+ *  propagation, and streams it to a list of output sinks, and (optionally) to in-memory history maps. It is used by the
+ *  numerical integration through the StreamedStateHistory, StreamedDependentVariableHistory and
+ *  StreamedComputationTimeHistory history types. The state and dependent variables of the most recent epoch are retained
+ *  until the next epoch is added (or the propagation is finalized), since the most recent epoch may be replaced when
+ *  propagating to an exact termination condition.
+ */
+template< typename TimeType = double, typename StateScalarType = double >
+class PropagationOutputStreamer
+{
+public:
+
+    //! Typedef for the state vector
+    typedef Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > StateVectorType;
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param outputSinks List of output sinks to which the output is streamed
+     *  \param outputSolutionFunction Function converting the propagated (raw) state to the conventional state
+     *  \param rawStateHistory Map to which the raw state history is added (none if nullptr)
+     *  \param dependentVariableHistory Map to which the dependent variable history is added (none if nullptr)
+     *  \param computationTimeHistory Map to which the cumulative computation time history is added (none if nullptr)
+     */
+    PropagationOutputStreamer(
+            const std::vector< std::shared_ptr< PropagationOutputSink< TimeType, StateScalarType > > >& outputSinks,
+            const std::function< StateVectorType( const StateVectorType&, const TimeType& ) > outputSolutionFunction,
+            std::map< TimeType, StateVectorType >* rawStateHistory = nullptr,
+            std::map< TimeType, Eigen::VectorXd >* dependentVariableHistory = nullptr,
+            std::map< TimeType, double >* computationTimeHistory = nullptr ):
+        outputSinks_( outputSinks ), outputSolutionFunction_( outputSolutionFunction ),
+        rawStateHistory_( rawStateHistory ), dependentVariableHistory_( dependentVariableHistory ),
+        computationTimeHistory_( computationTimeHistory ),
+        hasPendingState_( false ), hasPendingDependentVariables_( false ), numberOfPassedEpochs_( 0 ),
+        numberOfPassedDependentVariableEpochs_( 0 ), numberOfComputationTimeEntries_( 0 ){ }
+
+    //! Function to initialize all output sinks, to be called before the propagation
+    /*!
+     *  Function to initialize all output sinks, to be called before the propagation
+     *  \param dependentVariableIds Map listing starting entry of dependent variables in output vector, along with
+     *  associated ID
+     */
+    void initialize( const std::map< int, std::string >& dependentVariableIds )
+    {
+        clearStates( );
+        numberOfComputationTimeEntries_ = 0;
+        for( unsigned int i = 0; i < outputSinks_.size( ); i++ )
+        {
+            outputSinks_.at( i )->initialize( dependentVariableIds );
+        }
+    }
+
+    //! Function to pass the most recent epoch to the output sinks, and finalize all output sinks, to be called after the
+    //! propagation
+    void finalize( )
+    {
+        passPendingEpoch( );
+        for( unsigned int i = 0; i < outputSinks_.size( ); i++ )
+        {
+            outputSinks_.at( i )->finalize( );
+        }
+    }
+
+    //! Function to discard the states and dependent variables that have not yet been passed to the output sinks
+    void clearStates( )
+    {
+        hasPendingState_ = false;
+        hasPendingDependentVariables_ = false;
+        numberOfPassedEpochs_ = 0;
+        numberOfPassedDependentVariableEpochs_ = 0;
+    }
+
+    //! Function to add the (raw) state at a new epoch, passing the previous epoch to the output sinks
+    template< typename Derived >
+    void addState( const TimeType& time, const Eigen::MatrixBase< Derived >& rawState )
+    {
+        if( !hasPendingState_ || !( time == pendingTime_ ) )
+        {
+            passPendingEpoch( );
+            hasPendingDependentVariables_ = false;
+        }
+        pendingTime_ = time;
+        pendingRawState_ = rawState;
+        hasPendingState_ = true;
+    }
+
+    //! Function to add the dependent variables at the most recently added epoch
+    void addDependentVariables( const TimeType& time, const Eigen::VectorXd& dependentVariables )
+    {
+        if( !hasPendingState_ || !( time == pendingTime_ ) )
+        {
+            throw std::runtime_error( "Error when streaming propagation output, dependent variables must be added at the epoch "
+                                      "of the most recently added state" );
+        }
+        pendingDependentVariables_ = dependentVariables;
+        hasPendingDependentVariables_ = true;
+    }
+
+    //! Function to add the cumulative computation time at an epoch
+    void addComputationTime( const TimeType& time, const double computationTime )
+    {
+        if( computationTimeHistory_ != nullptr )
+        {
+            ( *computationTimeHistory_ )[ time ] = computationTime;
+        }
+        lastComputationTimeEpoch_ = time;
+        numberOfComputationTimeEntries_++;
+    }
+
+    //! Function to remove the state at the most recently added epoch (which has not yet been passed to the output sinks)
+    void removeLastState( )
+    {
+        if( !hasPendingState_ )
+        {
+            throw std::runtime_error( "Error when streaming propagation output, state has already been passed to output sinks, "
+                                      "and cannot be removed" );
+        }
+        hasPendingState_ = false;
+    }
+
+    //! Function to remove the dependent variables at the most recently added epoch
+    void removeLastDependentVariables( )
+    {
+        if( !hasPendingDependentVariables_ )
+        {
+            throw std::runtime_error( "Error when streaming propagation output, no dependent variables available for removal" );
+        }
+        hasPendingDependentVariables_ = false;
+    }
+
+    //! Function to retrieve the number of epochs at which the state has been added
+    unsigned int getNumberOfStateEpochs( )
+    {
+        return numberOfPassedEpochs_ + hasPendingState_;
+    }
+
+    //! Function to retrieve the number of epochs at which the dependent variables have been added
+    unsigned int getNumberOfDependentVariableEpochs( )
+    {
+        return numberOfPassedDependentVariableEpochs_ + hasPendingDependentVariables_;
+    }
+
+    //! Function to retrieve the number of epochs at which the computation time has been added
+    unsigned int getNumberOfComputationTimeEpochs( )
+    {
+        return numberOfComputationTimeEntries_;
+    }
+
+    //! Function to retrieve the most recent epoch at which the state has been added
+    TimeType getLastStateTime( )
+    {
+        if( hasPendingState_ )
+        {
+            return pendingTime_;
+        }
+        else if( numberOfPassedEpochs_ > 0 )
+        {
+            return lastPassedTime_;
+        }
+        else
+        {
+            throw std::runtime_error( "Error when streaming propagation output, no state has been added" );
+        }
+    }
+
+    //! Function to retrieve the most recent epoch at which the dependent variables have been added
+    TimeType getLastDependentVariableTime( )
+    {
+        if( hasPendingDependentVariables_ )
+        {
+            return pendingTime_;
+        }
+        else if( numberOfPassedDependentVariableEpochs_ > 0 )
+        {
+            return lastPassedDependentVariableTime_;
+        }
+        else
+        {
+            throw std::runtime_error( "Error when streaming propagation output, no dependent variables have been added" );
+        }
+    }
+
+    //! Function to retrieve the most recent epoch at which the computation time has been added
+    TimeType getLastComputationTimeEpoch( )
+    {
+        return lastComputationTimeEpoch_;
+    }
+
+private:
+
+    //! Function to pass the most recent epoch to the output sinks and in-memory histories
+    void passPendingEpoch( )
+    {
+        if( hasPendingState_ )
+        {
+            if( hasPendingDependentVariables_ )
+            {
+                numberOfPassedDependentVariableEpochs_++;
+                lastPassedDependentVariableTime_ = pendingTime_;
+            }
+            else
+            {
+                pendingDependentVariables_.resize( 0 );
+            }
+
+            if( rawStateHistory_ != nullptr )
+            {
+                ( *rawStateHistory_ )[ pendingTime_ ] = pendingRawState_;
+            }
+            if( dependentVariableHistory_ != nullptr && hasPendingDependentVariables_ )
+            {
+                ( *dependentVariableHistory_ )[ pendingTime_ ] = pendingDependentVariables_;
+            }
+
+            if( outputSinks_.size( ) > 0 )
+            {
+                StateVectorType outputState = outputSolutionFunction_( pendingRawState_, pendingTime_ );
+                for( unsigned int i = 0; i < outputSinks_.size( ); i++ )
+                {
+                    outputSinks_.at( i )->processStep( pendingTime_, outputState, pendingDependentVariables_ );
+                }
+            }
+
+            numberOfPassedEpochs_++;
+            lastPassedTime_ = pendingTime_;
+            hasPendingState_ = false;
+            hasPendingDependentVariables_ = false;
+        }
+    }
+
+    //! List of output sinks to which the output is streamed
+    std::vector< std::shared_ptr< PropagationOutputSink< TimeType, StateScalarType > > > outputSinks_;
+
+    //! Function converting the propagated (raw) state to the conventional state
+    std::function< StateVectorType( const StateVectorType&, const TimeType& ) > outputSolutionFunction_;
+
+    //! Map to which the raw state history is added (none if nullptr)
+    std::map< TimeType, StateVectorType >* rawStateHistory_;
+
+    //! Map to which the dependent variable history is added (none if nullptr)
+    std::map< TimeType, Eigen::VectorXd >* dependentVariableHistory_;
+
+    //! Map to which the cumulative computation time history is added (none if nullptr)
+    std::map< TimeType, double >* computationTimeHistory_;
+
+    //! Most recent epoch (not yet passed to the output sinks)
+    TimeType pendingTime_;
+
+    //! Raw state at most recent epoch
+    StateVectorType pendingRawState_;
+
+    //! Dependent variables at most recent epoch
+    Eigen::VectorXd pendingDependentVariables_;
+
+    //! Boolean denoting whether a state has been added at the most recent epoch
+    bool hasPendingState_;
+
+    //! Boolean denoting whether dependent variables have been added at the most recent epoch
+    bool hasPendingDependentVariables_;
+
+    //! Number of epochs that have been passed to the output sinks
+    unsigned int numberOfPassedEpochs_;
+
+    //! Number of epochs with dependent variables that have been passed to the output sinks
+    unsigned int numberOfPassedDependentVariableEpochs_;
+
+    //! Number of epochs at which the computation time has been added
+    unsigned int numberOfComputationTimeEntries_;
+
+    //! Most recent epoch that has been passed to the output sinks
+    TimeType lastPassedTime_;
+
+    //! Most recent epoch with dependent variables that has been passed to the output sinks
+    TimeType lastPassedDependentVariableTime_;
+
+    //! Most recent epoch at which the computation time has been added
+    TimeType lastComputationTimeEpoch_;
+};
+
+//! History type that passes the propagated states to a PropagationOutputStreamer (see integrateEquationsFromIntegrator)
+template< typename TimeType = double, typename StateScalarType = double >
+class StreamedStateHistory
+{
+public:
+
+    //! Constructor
+    StreamedStateHistory( const std::shared_ptr< PropagationOutputStreamer< TimeType, StateScalarType > > outputStreamer ):
+        outputStreamer_( outputStreamer ){ }
+
+    //! Object to which the states are passed
+    std::shared_ptr< PropagationOutputStreamer< TimeType, StateScalarType > > outputStreamer_;
+};
+
+//! History type that passes the dependent variables to a PropagationOutputStreamer (see integrateEquationsFromIntegrator)
+template< typename TimeType = double, typename StateScalarType = double >
+class StreamedDependentVariableHistory
+{
+public:
+
+    //! Constructor
+    StreamedDependentVariableHistory(
+            const std::shared_ptr< PropagationOutputStreamer< TimeType, StateScalarType > > outputStreamer ):
+        outputStreamer_( outputStreamer ){ }
+
+    //! Object to which the dependent variables are passed
+    std::shared_ptr< PropagationOutputStreamer< TimeType, StateScalarType > > outputStreamer_;
+};
+
+//! History type that passes the computation times to a PropagationOutputStreamer (see integrateEquationsFromIntegrator)
+template< typename TimeType = double, typename StateScalarType = double >
+class StreamedComputationTimeHistory
+{
+public:
+
+    //! Constructor
+    StreamedComputationTimeHistory(
+            const std::shared_ptr< PropagationOutputStreamer< TimeType, StateScalarType > > outputStreamer ):
+        outputStreamer_( outputStreamer ){ }
+
+    //! Object to which the computation times are passed
+    std::shared_ptr< PropagationOutputStreamer< TimeType, StateScalarType > > outputStreamer_;
+};
+
+} // namespace propagators
+
+namespace utilities
+{
+
+//! Function to remove all entries from a streamed state history
+template< typename TimeType, typename StateScalarType >
+void clearHistory( propagators::StreamedStateHistory< TimeType, StateScalarType >& history )
+{
+    history.outputStreamer_->clearStates( );
+}
+
+//! Function to remove all entries from a streamed dependent variable history (cleared with the state history)
+template< typename TimeType, typename StateScalarType >
+void clearHistory( propagators::StreamedDependentVariableHistory< TimeType, StateScalarType >& history )
+{ }
+
+//! Function to remove all entries from a streamed computation time history
+template< typename TimeType, typename StateScalarType >
+void clearHistory( propagators::StreamedComputationTimeHistory< TimeType, StateScalarType >& history )
+{ }
+
+//! Function to add an entry to a streamed state history
+template< typename TimeType, typename StateScalarType, typename InputType >
+void addHistoryEntry( propagators::StreamedStateHistory< TimeType, StateScalarType >& history,
+                      const TimeType& time, const InputType& value )
+{
+    history.outputStreamer_->addState( time, value );
+}
+
+//! Function to add an entry to a streamed dependent variable history
+template< typename TimeType, typename StateScalarType, typename InputType >
+void addHistoryEntry( propagators::StreamedDependentVariableHistory< TimeType, StateScalarType >& history,
+                      const TimeType& time, const InputType& value )
+{
+    history.outputStreamer_->addDependentVariables( time, value );
+}
+
+//! Function to add an entry to a streamed computation time history
+template< typename TimeType, typename StateScalarType, typename InputType >
+void addHistoryEntry( propagators::StreamedComputationTimeHistory< TimeType, StateScalarType >& history,
+                      const TimeType& time, const InputType& value )
+{
+    history.outputStreamer_->addComputationTime( time, value );
+}
+
+//! Function to retrieve the number of entries in a streamed state history
+template< typename TimeType, typename StateScalarType >
+unsigned int getHistorySize( const propagators::StreamedStateHistory< TimeType, StateScalarType >& history )
+{
+    return history.outputStreamer_->getNumberOfStateEpochs( );
+}
+
+//! Function to retrieve the number of entries in a streamed dependent variable history
+template< typename TimeType, typename StateScalarType >
+unsigned int getHistorySize( const propagators::StreamedDependentVariableHistory< TimeType, StateScalarType >& history )
+{
+    return history.outputStreamer_->getNumberOfDependentVariableEpochs( );
+}
+
+//! Function to retrieve the number of entries in a streamed computation time history
+template< typename TimeType, typename StateScalarType >
+unsigned int getHistorySize( const propagators::StreamedComputationTimeHistory< TimeType, StateScalarType >& history )
+{
+    return history.outputStreamer_->getNumberOfComputationTimeEpochs( );
+}
+
+//! Function to retrieve the time of the last entry added to a streamed state history
+template< typename TimeType, typename StateScalarType >
+TimeType getLastAddedHistoryTime( const propagators::StreamedStateHistory< TimeType, StateScalarType >& history,
+                                  const bool isTimeIncreasing )
+{
+    return history.outputStreamer_->getLastStateTime( );
+}
+
+//! Function to retrieve the time of the last entry added to a streamed dependent variable history
+template< typename TimeType, typename StateScalarType >
+TimeType getLastAddedHistoryTime( const propagators::StreamedDependentVariableHistory< TimeType, StateScalarType >& history,
+                                  const bool isTimeIncreasing )
+{
+    return history.outputStreamer_->getLastDependentVariableTime( );
+}
+
+//! Function to retrieve the time of the last entry added to a streamed computation time history
+template< typename TimeType, typename StateScalarType >
+TimeType getLastAddedHistoryTime( const propagators::StreamedComputationTimeHistory< TimeType, StateScalarType >& history,
+                                  const bool isTimeIncreasing )
+{
+    return history.outputStreamer_->getLastComputationTimeEpoch( );
+}
+
+//! Function to remove the last entry added to a streamed state history
+template< typename TimeType, typename StateScalarType >
+void removeLastAddedHistoryEntry( propagators::StreamedStateHistory< TimeType, StateScalarType >& history,
+                                  const bool isTimeIncreasing )
+{
+    history.outputStreamer_->removeLastState( );
+}
+
+//! Function to remove the last entry added to a streamed dependent variable history
+template< typename TimeType, typename StateScalarType >
+void removeLastAddedHistoryEntry( propagators::StreamedDependentVariableHistory< TimeType, StateScalarType >& history,
+                                  const bool isTimeIncreasing )
+{
+    history.outputStreamer_->removeLastDependentVariables( );
+}
+
+} // namespace utilities
+
+} // namespace tudat
+
+#endif // TUDAT_PROPAGATIONOUTPUTSINK_H
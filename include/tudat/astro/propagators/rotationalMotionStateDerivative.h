@@ -20,6 +20,7 @@
 #include <functional>
 
 #include "tudat/astro/basic_astro/torqueModel.h"
+#include "tudat/astro/basic_astro/torqueModelTypes.h"
 
 #include "tudat/astro/propagators/singleStateTypeDerivative.h"
 #include "tudat/simulation/environment_setup/body.h"
@@ -180,6 +181,9 @@ public:
      */
     void updateStateDerivativeModel( const TimeType currentTime )
     {
+#if( TUDAT_BUILD_WITH_PROFILING )
+        unsigned int torqueModelIndex = 0;
+#endif
         for( torqueModelMapIterator = torqueModelsPerBody_.begin( );
              torqueModelMapIterator != torqueModelsPerBody_.end( ); torqueModelMapIterator++ )
         {
@@ -188,12 +192,52 @@ public:
             {
                 for( unsigned int j = 0; j < innerTorqueIterator->second.size( ); j++ )
                 {
+#if( TUDAT_BUILD_WITH_PROFILING )
+                    TUDAT_PROFILE_SCOPE( ( profiler_ == nullptr ) ? nullptr : profiler_.get( ),
+                                         ( profiler_ == nullptr ) ? -1 : torqueModelProfilingScopes_.at( torqueModelIndex ) );
+                    torqueModelIndex++;
+#endif
                     innerTorqueIterator->second[ j ]->updateMembers( currentTime );
                 }
             }
         }
     }
 
+    // Function to set the profiler in which the evaluation time of the torque models is to be recorded
+    /*
+     * Function to set the profiler in which the evaluation time of the torque models is to be recorded. A scope is
+     * created for each torque model, named by the torque type and the bodies exerting and undergoing the torque. Timing
+     * is only performed if TUDAT_BUILD_WITH_PROFILING is enabled.
+     * \param profiler Profiler in which the evaluation time is to be recorded (nullptr to disable)
+     * \param parentScopeIndex Index of the profiler scope of this state derivative model
+     */
+    void setPropagationProfiler( const std::shared_ptr< utilities::PropagationProfiler > profiler,
+                                 const int parentScopeIndex )
+    {
+        profiler_ = profiler;
+        torqueModelProfilingScopes_.clear( );
+        if( profiler_ != nullptr )
+        {
+            for( torqueModelMapIterator = torqueModelsPerBody_.begin( );
+                 torqueModelMapIterator != torqueModelsPerBody_.end( ); torqueModelMapIterator++ )
+            {
+                for( innerTorqueIterator = torqueModelMapIterator->second.begin( ); innerTorqueIterator !=
+                     torqueModelMapIterator->second.end( ); innerTorqueIterator++ )
+                {
+                    for( unsigned int j = 0; j < innerTorqueIterator->second.size( ); j++ )
+                    {
+                        torqueModelProfilingScopes_.push_back(
+                                    profiler_->addScope(
+                                        basic_astrodynamics::getTorqueModelName(
+                                            basic_astrodynamics::getTorqueModelType( innerTorqueIterator->second[ j ] ) ) +
+                                        ":" + innerTorqueIterator->first + "->" + torqueModelMapIterator->first,
+                                        parentScopeIndex ) );
+                    }
+                }
+            }
+        }
+    }
+
     // Function to convert the propagator-specific form of the state to the conventional form in the global frame.
     /*
      * Function to convert the propagator-specific form of the state to the conventional form in the
@@ -366,6 +410,12 @@ protected:
      */
     basic_astrodynamics::TorqueModelMap torqueModelsPerBody_;
 
+    // Profiler in which the evaluation time of the torque models is recorded (nullptr if none)
+    std::shared_ptr< utilities::PropagationProfiler > profiler_;
+
+    // Index of the profiler scope of each torque model, in order of iteration over torqueModelsPerBody_
+    std::vector< int > torqueModelProfilingScopes_;
+
     // Type of propagator that is to be used (i.e., quaternions, etc.)
     RotationalPropagatorType propagatorType_;
 
@@ -12,11 +12,14 @@
 #define TUDAT_STATEDERIVATIVE_H
 
 #include <map>
+#include <memory>
+#include <string>
 
 #include <Eigen/Core>
 
 #include "tudat/basics/timeType.h"
 #include <tudat/basics/utilityMacros.h>
+#include "tudat/basics/propagationProfiler.h"
 
 namespace tudat
 {
@@ -61,6 +64,15 @@ int getSingleIntegrationDifferentialEquationOrder( const IntegratedStateType sta
  */
 int getGeneralizedAccelerationSize( const IntegratedStateType stateType );
 
+// Function to get a string representing a 'named identification' of a state type
+/*
+ * Function to get a string representing a 'named identification' of a state type (e.g. for identification of the model in
+ * profiling output)
+ * \param stateType State type for which name is to be retrieved
+ * \return Name of state type
+ */
+std::string getIntegratedStateTypeName( const IntegratedStateType stateType );
+
 // Base class for calculating the state derivative model for a single type of dynamics.
 /*
  *  Base class for calculating the state derivative model for a single
@@ -231,6 +243,21 @@ public:
         return false;
     }
 
+    // Function to set the profiler in which the evaluation time of the constituent models is to be recorded
+    /*
+     * Function to set the profiler in which the evaluation time of the constituent models (e.g. acceleration models) of
+     * this state derivative is to be recorded. Timing is only performed if TUDAT_BUILD_WITH_PROFILING is enabled. Default
+     * implementation is empty (no timing of constituent models).
+     * \param profiler Profiler in which the evaluation time is to be recorded (nullptr to disable)
+     * \param parentScopeIndex Index of the profiler scope of this state derivative model
+     */
+    virtual void setPropagationProfiler( const std::shared_ptr< utilities::PropagationProfiler > profiler,
+                                         const int parentScopeIndex )
+    {
+        TUDAT_UNUSED_PARAMETER( profiler );
+        TUDAT_UNUSED_PARAMETER( parentScopeIndex );
+    }
+
 protected:
 
     // Type of dynamics for which the state derivative is calculated.
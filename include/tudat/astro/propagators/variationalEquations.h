@@ -10,6 +10,7 @@
 #ifndef TUDAT_VARIATIONALEQUATIONS_H
 #define TUDAT_VARIATIONALEQUATIONS_H
 
+#include <array>
 #include <map>
 #include <string>
 #include <vector>
@@ -102,12 +103,15 @@ public:
         variationalMatrix_ = Eigen::MatrixXd::Zero( totalDynamicalStateSize_, totalDynamicalStateSize_ );
         variationalParameterMatrix_ =
                 Eigen::MatrixXd::Zero( totalDynamicalStateSize_, numberOfParameterValues_ - totalDynamicalStateSize_ );
+        scaledStatePartials_ = Eigen::MatrixXd::Zero( 3, totalDynamicalStateSize_ );
+        scaledParameterPartials_ = Eigen::MatrixXd::Zero( 3, numberOfParameterValues_ - totalDynamicalStateSize_ );
 
         // Set parameter partial functions.
         setStatePartialFunctionList( );
         setTranslationalStatePartialFrameScalingFunctions( parametersToEstimate, currentArcIndex );
         setRotationalStatePartialScalingFunctions( parametersToEstimate );
         setParameterPartialFunctionList( parametersToEstimate );
+        setVariationalMatrixSparsity( );
     }
 
     //! Calculates matrix containing partial derivatives of state derivatives w.r.t. body state.
@@ -128,7 +132,8 @@ public:
      */
     template< typename StateScalarType >
     void getBodyInitialStatePartialMatrix(
-            const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic >& stateTransitionAndSensitivityMatrices,
+            const Eigen::Ref< const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > >
+            stateTransitionAndSensitivityMatrices,
             Eigen::Block< Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > > currentMatrixDerivative );
 
     //! Calculates matrix containing partial derivatives of state derivatives w.r.t. parameters.
@@ -142,53 +147,38 @@ public:
     void getParameterPartialMatrix(
             Eigen::Block< Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > > currentMatrixDerivative )
     {
-        // Initialize matrix to zeros
-        variationalParameterMatrix_.setZero( );
-
-        // Iterate over all bodies undergoing accelerations for which initial condition is to be estimated.
-        for( std::map< IntegratedStateType, std::vector< std::multimap< std::pair< int, int >,
-             std::function< void( Eigen::Block< Eigen::MatrixXd > ) > > > >::iterator typeIterator =
-             parameterPartialList_.begin( ); typeIterator != parameterPartialList_.end( ); typeIterator++ )
+        // Set blocks to which partials are added to zero
+        for( unsigned int i = 0; i < parameterPartialFunctionList_.size( ); i++ )
         {
-            int startIndex = stateTypeStartIndices_.at( typeIterator->first );
-            int currentStateSize = getSingleIntegrationSize( typeIterator->first );
-            int entriesToSkipPerEntry = currentStateSize - getGeneralizedAccelerationSize( typeIterator->first );
+            const std::array< int, 4 >& blockIndices = parameterPartialFunctionList_[ i ].first;
+            variationalParameterMatrix_.block(
+                        blockIndices[ 0 ], blockIndices[ 1 ], blockIndices[ 2 ], blockIndices[ 3 ] ).setZero( );
+        }
 
-            // Iterate over all bodies being estimated.
-            for( unsigned int i = 0; i < typeIterator->second.size( ); i++ )
-            {
-                // Iterate over all parameter partial functions determined by setParameterPartialFunctionList( )
-                for( functionIterator = typeIterator->second[ i ].begin( );
-                     functionIterator != typeIterator->second[ i ].end( );
-                     functionIterator++ )
-                {
-                    functionIterator->second(
-                                variationalParameterMatrix_.block(
-                                    startIndex + entriesToSkipPerEntry + currentStateSize * i,
-                                    functionIterator->first.first - totalDynamicalStateSize_,
-                                    currentStateSize - entriesToSkipPerEntry,
-                                    functionIterator->first.second ) );
-                }
-            }
+        // Add partials w.r.t. parameters, as determined by setParameterPartialFunctionList( )
+        for( unsigned int i = 0; i < parameterPartialFunctionList_.size( ); i++ )
+        {
+            const std::array< int, 4 >& blockIndices = parameterPartialFunctionList_[ i ].first;
+            parameterPartialFunctionList_[ i ].second(
+                        variationalParameterMatrix_.block(
+                            blockIndices[ 0 ], blockIndices[ 1 ], blockIndices[ 2 ], blockIndices[ 3 ] ) );
         }
 
         for( unsigned int i = 0; i < inertiaTensorsForMultiplication_.size( ); i++ )
         {
-            variationalParameterMatrix_.block( inertiaTensorsForMultiplication_.at( i ).first, 0, 3,
-                                               numberOfParameterValues_ - totalDynamicalStateSize_ ) =
+            scaledParameterPartials_.noalias( ) =
                     ( inertiaTensorsForMultiplication_.at( i ).second( ).inverse( ) ) *
                     variationalParameterMatrix_.block(
                         inertiaTensorsForMultiplication_.at( i ).first, 0, 3,
-                        numberOfParameterValues_ - totalDynamicalStateSize_ ).eval( );
+                        numberOfParameterValues_ - totalDynamicalStateSize_ );
+            variationalParameterMatrix_.block( inertiaTensorsForMultiplication_.at( i ).first, 0, 3,
+                                               numberOfParameterValues_ - totalDynamicalStateSize_ ) =
+                    scaledParameterPartials_;
         }
 
         currentMatrixDerivative.block( 0, totalDynamicalStateSize_, totalDynamicalStateSize_,
                                        numberOfParameterValues_ - totalDynamicalStateSize_ ) +=
                 variationalParameterMatrix_.template cast< StateScalarType >( );
-
-
-
-
     }
     
     //! Evaluates the complete variational equations.
@@ -201,7 +191,7 @@ public:
      */
     template< typename StateScalarType >
     void evaluateVariationalEquations(
-            const double time, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic >&
+            const double time, const Eigen::Ref< const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > >
             stateTransitionAndSensitivityMatrices,
             Eigen::Block< Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > > currentMatrixDerivative )
     {
@@ -213,9 +203,6 @@ public:
             // Add partials of parameters.
             getParameterPartialMatrix< StateScalarType >( currentMatrixDerivative );
         }
-//        currentMatrixDerivative.block( 0, 6, 6, 7 ).setZero( );
-//        currentMatrixDerivative.block( 6, 0, 7, 6 ).setZero( );
-
     }
 
     //! Function to clear reference/cached values of state derivative partials.
@@ -233,7 +220,7 @@ public:
      */
     template< typename StateScalarType >
     void updatePartials( const double currentTime,
-                         const std::unordered_map< IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >
+                         const std::unordered_map< IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >&
                          currentStatesPerTypeInConventionalRepresentation )
     {
         for( auto stateIterator = currentStatesPerTypeInConventionalRepresentation.begin( );
@@ -295,17 +282,73 @@ public:
         couplingEntriesToSuppress_ = couplingEntriesToSuppress;
     }
 
+    //! Function to retrieve the matrix of partial derivatives of state derivatives w.r.t. current states.
+    /*!
+     *  Function to retrieve the matrix of partial derivatives of state derivatives w.r.t. current states, as computed
+     *  during the last call to setBodyStatePartialMatrix (directly, or through evaluateVariationalEquations).
+     *  \return Matrix of partial derivatives of state derivatives w.r.t. current states.
+     */
+    const Eigen::MatrixXd& getVariationalMatrix( )
+    {
+        return variationalMatrix_;
+    }
+
+    //! Function to retrieve the matrix of partial derivatives of state derivatives w.r.t. parameters.
+    /*!
+     *  Function to retrieve the matrix of partial derivatives of state derivatives w.r.t. (non-dynamical) parameters, as
+     *  computed during the last call to evaluateVariationalEquations.
+     *  \return Matrix of partial derivatives of state derivatives w.r.t. parameters.
+     */
+    const Eigen::MatrixXd& getVariationalParameterMatrix( )
+    {
+        return variationalParameterMatrix_;
+    }
+
+    //! Function to retrieve the blocks of rows of the variational matrix that are rows of the identity matrix.
+    /*!
+     *  Function to retrieve the blocks of rows of the variational matrix that are rows of the identity matrix (e.g.
+     *  the partials of the time derivative of the position w.r.t. the velocity), for which the product with the state
+     *  transition and sensitivity matrix is a copy of its rows.
+     *  \return List of identity row blocks: start row, start column and number of rows
+     */
+    std::vector< std::array< int, 3 > > getIdentityRowBlocks( )
+    {
+        return identityRowBlocks_;
+    }
+
+    //! Function to retrieve the blocks of rows of the variational matrix, with their potentially non-zero columns.
+    /*!
+     *  Function to retrieve the blocks of rows of the variational matrix (excluding identity row blocks), with their
+     *  potentially non-zero columns, which are used to evaluate the product with the state transition and sensitivity
+     *  matrix.
+     *  \return List of row blocks: start row and number of rows (first), and list of start column and number of columns
+     *  of all potentially non-zero column ranges (second).
+     */
+    std::vector< std::pair< std::pair< int, int >, std::vector< std::pair< int, int > > > > getSparseRowBlocks( )
+    {
+        return sparseRowBlocks_;
+    }
+
 protected:
     
 private:
     
-    //! Function (called by constructor) to set up the statePartialList_ member from the state derivative partials
+    //! Function (called by constructor) to set up the statePartialFunctionList_ member from the state derivative partials
     /*!
      * Function (called by constructor) to set up the functions to evaluate the partial derivatives of the state derivatives
-     * w.r.t. a current state (stored in the statePartialList_ member) from the state derivative partials.
+     * w.r.t. a current state (stored in the statePartialFunctionList_ member) from the state derivative partials.
      */
     void setStatePartialFunctionList( );
 
+    //! Function (called by constructor) to determine the sparsity structure of the variational matrix.
+    /*!
+     * Function (called by constructor) to determine which entries of the variational matrix may be non-zero, from the
+     * partial derivative functions, the kinematic blocks of the translational and rotational dynamics, and the frame and
+     * inertia tensor scaling. The rows of the matrix are divided into blocks of rows with identical sparsity, which are
+     * stored in the sparseRowBlocks_ (with their non-zero column ranges) and identityRowBlocks_ members.
+     */
+    void setVariationalMatrixSparsity( );
+
     //! Function to add parameter partial functions for single state derivative model, and set of parameter objects.
     /*!
      *  Function to add parameter partial functions for single state derivative model, and set of parameter objects.
@@ -394,9 +437,10 @@ private:
              stateDerivativeTypeIterator++ )
         {
             
-            // Initialize vector of lists to correct size.
-            parameterPartialList_[ stateDerivativeTypeIterator->first ].resize(
-                        stateDerivativeTypeIterator->second.size( ) );
+            int startIndex = stateTypeStartIndices_.at( stateDerivativeTypeIterator->first );
+            int currentStateSize = getSingleIntegrationSize( stateDerivativeTypeIterator->first );
+            int entriesToSkipPerEntry = currentStateSize -
+                    getGeneralizedAccelerationSize( stateDerivativeTypeIterator->first );
             
             // Iterate over all bodies of which initial position is being estimated.
             for( unsigned int i = 0; i < stateDerivativeTypeIterator->second.size( ); i++ )
@@ -416,8 +460,18 @@ private:
                                 functionListOfBody, totalParameterVectorIndicesToSubtract );
                 }
 
-                // Add generated parameter partial list of current body.
-                parameterPartialList_[ stateDerivativeTypeIterator->first ][ i ] = functionListOfBody;
+                // Add generated parameter partial functions of current body, with the block of the partial matrix to
+                // which they are to be added.
+                for( auto functionIterator = functionListOfBody.begin( ); functionIterator != functionListOfBody.end( );
+                     functionIterator++ )
+                {
+                    parameterPartialFunctionList_.push_back(
+                                std::make_pair( std::array< int, 4 >(
+                                { startIndex + entriesToSkipPerEntry + currentStateSize * static_cast< int >( i ),
+                                  functionIterator->first.first - totalDynamicalStateSize_,
+                                  currentStateSize - entriesToSkipPerEntry, functionIterator->first.second } ),
+                                                functionIterator->second ) );
+                }
             }
         }
     }
@@ -537,21 +591,28 @@ private:
     //! Map of start entry in sensitivity matrix of each type of estimated dynamics.
     std::map< IntegratedStateType, int > stateTypeStartIndices_;
     
-    //! List of all functions returning current partial derivative w.r.t. a current dynamical state
+    //! List of all functions adding current partial derivative w.r.t. a current dynamical state to the variational matrix
     /*!
-     *  List of all functions returning current partial derivative w.r.t. a current dynamical state (map key). The
-     *  vector entries correspond to the entries in the outer vector of StateDerivativePartialsMaps in
-     *  stateDerivativePartialList_. The multimaps inside the vector provide the functions (as values) adding the
-     *  partials to a given matrix block and the start column and number of columns in matrix partial (as keys).
+     *  List of all functions adding current partial derivative w.r.t. a current dynamical state to the variational
+     *  matrix (second), with the block of the variational matrix to which they are to be applied (first: start row,
+     *  start column, number of rows, number of columns). The list is set once by setStatePartialFunctionList, so that no
+     *  map lookups are needed during the evaluation of the variational equations.
      */
-    std::map< IntegratedStateType,
-    std::vector< std::multimap< std::pair< int, int >, std::function< void( Eigen::Block< Eigen::MatrixXd > ) > > > >
-    statePartialList_;
-    
-    //! Pre-defined iterator for efficiency.
-    std::multimap< std::pair< int, int >, std::function< void( Eigen::Block< Eigen::MatrixXd > ) > >::iterator
-    statePartialIterator_;
-    
+    std::vector< std::pair< std::array< int, 4 >, std::function< void( Eigen::Block< Eigen::MatrixXd > ) > > >
+    statePartialFunctionList_;
+
+    //! Blocks of rows of the variational matrix with identical sparsity, excluding identity row blocks
+    /*!
+     *  Blocks of rows of the variational matrix with identical sparsity, excluding identity row blocks. The first pair
+     *  denotes the start row and number of rows, the second entry the start column and number of columns of all column
+     *  ranges in which entries may be non-zero.
+     *  \sa setVariationalMatrixSparsity
+     */
+    std::vector< std::pair< std::pair< int, int >, std::vector< std::pair< int, int > > > > sparseRowBlocks_;
+
+    //! Blocks of rows of the variational matrix that are rows of the identity matrix (start row, start column, size)
+    std::vector< std::array< int, 3 > > identityRowBlocks_;
+
     //! Vector of pair providing indices of column blocks of variational equations to add to other column blocks
     /*!
      * Vector of pair providing indices of column blocks of variational equations to add to other column blocks,
@@ -564,20 +625,14 @@ private:
     //! Functions returning inertia tensors of bodies, to be used for rotational variational equations
     std::vector< std::pair< int, std::function< Eigen::Matrix3d( ) > > > inertiaTensorsForMultiplication_;
     
-    //! List of all functions returning current partial derivative w.r.t. a parameter
+    //! List of all functions adding current partial derivative w.r.t. a parameter to the parameter partial matrix
     /*!
-     *  List of all functions returning current partial derivative w.r.t. a parameter.
-     *  Map key denotes associated dynamics type w.r.t which partial is taken. The
-     *  vector entries correspond to the entries in the outer vector of StateDerivativePartialsMaps in
-     *  stateDerivativePartialList_. The multimaps inside the vector provide the functions (as values) adding the
-     *  partials to a given matrix block and the start column and number of columns in matrix partial (as keys).
+     *  List of all functions adding current partial derivative w.r.t. a parameter to the parameter partial matrix
+     *  (second), with the block of variationalParameterMatrix_ to which they are to be applied (first: start row,
+     *  start column, number of rows, number of columns). The list is set once by setParameterPartialFunctionList.
      */
-    std::map< IntegratedStateType, std::vector< std::multimap< std::pair< int, int >,
-    std::function< void( Eigen::Block< Eigen::MatrixXd > ) > > > > parameterPartialList_;
-    
-    //! Pre-declared iterator over all parameter partial functions.
-    std::multimap< std::pair< int, int >, std::function< void( Eigen::Block< Eigen::MatrixXd > ) > >
-    ::iterator functionIterator;
+    std::vector< std::pair< std::array< int, 4 >, std::function< void( Eigen::Block< Eigen::MatrixXd > ) > > >
+    parameterPartialFunctionList_;
 
     //! Pre-declared iterator over all state types
     std::map< propagators::IntegratedStateType, orbit_determination::StateDerivativePartialsMap >
@@ -602,17 +657,23 @@ private:
     //! Total matrix of partial derivatives of state derivatives w.r.t. parameter vectors.
     Eigen::MatrixXd variationalParameterMatrix_;
 
+    //! Pre-allocated matrix for rotational state partials, pre-multiplied by inverse inertia tensor.
+    Eigen::MatrixXd scaledStatePartials_;
+
+    //! Pre-allocated matrix for rotational parameter partials, pre-multiplied by inverse inertia tensor.
+    Eigen::MatrixXd scaledParameterPartials_;
+
     //! Current states, in conventional representation (e.g. transformed from specific propagator) sorted per state type.
     std::unordered_map< IntegratedStateType, Eigen::VectorXd > currentStatesPerTypeInConventionalRepresentation_;
 };
 
 extern template void VariationalEquations::getBodyInitialStatePartialMatrix< double >(
-        const Eigen::Matrix< double, Eigen::Dynamic, Eigen::Dynamic >& stateTransitionAndSensitivityMatrices,
+        const Eigen::Ref< const Eigen::Matrix< double, Eigen::Dynamic, Eigen::Dynamic > > stateTransitionAndSensitivityMatrices,
         Eigen::Block< Eigen::Matrix< double, Eigen::Dynamic, Eigen::Dynamic > > currentMatrixDerivative );
 
 //#if( TUDAT_BUILD_WITH_EXTENDED_PRECISION_PROPAGATION_TOOLS )
 extern template void VariationalEquations::getBodyInitialStatePartialMatrix< long double >(
-        const Eigen::Matrix< long double, Eigen::Dynamic, Eigen::Dynamic >& stateTransitionAndSensitivityMatrices,
+        const Eigen::Ref< const Eigen::Matrix< long double, Eigen::Dynamic, Eigen::Dynamic > > stateTransitionAndSensitivityMatrices,
         Eigen::Block< Eigen::Matrix< long double, Eigen::Dynamic, Eigen::Dynamic > > currentMatrixDerivative );
 //#endif
 
@@ -0,0 +1,402 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_COLUMNAR_HISTORY_H
+#define TUDAT_COLUMNAR_HISTORY_H
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Class to store a history of (equally sized) matrices as a function of time in contiguous memory.
+/*!
+ *  Class to store a history of (equally sized) matrices as a function of time in contiguous memory, as an alternative to a
+ *  std::map< TimeType, Eigen::Matrix >. The times are stored in a single vector, and the matrices are stored as
+ *  consecutive (column-major) blocks in a single data vector, so that entry i of the history occupies columns
+ *  [ i * numberOfColumns, ( i + 1 ) * numberOfColumns ) of the data block returned by getDataBlock. Storage is grown in
+ *  chunks (of at least chunkSize entries), so that no memory is allocated when adding most entries.
+ *  Entries are stored in the order in which they are added (typically the order in which they are produced by a numerical
+ *  propagation, which is decreasing in time for backwards propagation). Adding an entry with the same time as the last entry
+ *  overwrites the last entry (consistent with the behaviour of a std::map).
+ */
+template< typename TimeType = double, typename ScalarType = double >
+class ColumnarHistory
+{
+public:
+
+    //! Typedef for the matrix type of a single entry
+    typedef Eigen::Matrix< ScalarType, Eigen::Dynamic, Eigen::Dynamic > EntryType;
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param numberOfRows Number of rows of each entry (if 0, it is set from the first entry that is added).
+     *  \param numberOfColumns Number of columns of each entry (if 0, it is set from the first entry that is added).
+     *  \param chunkSize Minimum number of entries for which memory is allocated when the storage is to be grown.
+     */
+    ColumnarHistory( const int numberOfRows = 0, const int numberOfColumns = 0, const unsigned int chunkSize = 1024 ):
+        numberOfRows_( numberOfRows ), numberOfColumns_( numberOfColumns ), chunkSize_( std::max( chunkSize, 1U ) ){ }
+
+    //! Function to remove all entries (retaining the allocated memory, and the size of the entries).
+    void clear( )
+    {
+        times_.clear( );
+        data_.clear( );
+    }
+
+    //! Function to reserve memory for a given number of entries.
+    /*!
+     *  Function to reserve memory for a given number of entries. Requires the entry size to be known.
+     *  \param numberOfEntries Number of entries for which memory is to be reserved.
+     */
+    void reserve( const unsigned int numberOfEntries )
+    {
+        times_.reserve( numberOfEntries );
+        data_.reserve( numberOfEntries * getEntrySize( ) );
+    }
+
+    //! Function to add an entry to the end of the history
+    /*!
+     *  Function to add an entry to the end of the history. If the time is equal to that of the last entry, the last entry is
+     *  overwritten.
+     *  \param time Time of the entry
+     *  \param value Matrix that is to be stored (must be of the size defined for this object)
+     */
+    template< typename Derived >
+    void addEntry( const TimeType& time, const Eigen::MatrixBase< Derived >& value )
+    {
+        if( numberOfRows_ == 0 && numberOfColumns_ == 0 && times_.size( ) == 0 )
+        {
+            numberOfRows_ = value.rows( );
+            numberOfColumns_ = value.cols( );
+        }
+        else if( value.rows( ) != numberOfRows_ || value.cols( ) != numberOfColumns_ )
+        {
+            throw std::runtime_error( "Error when adding entry to columnar history, entry size (" +
+                                      std::to_string( value.rows( ) ) + ", " + std::to_string( value.cols( ) ) +
+                                      ") is inconsistent with history entry size (" + std::to_string( numberOfRows_ ) + ", " +
+                                      std::to_string( numberOfColumns_ ) + ")" );
+        }
+
+        // Overwrite last entry if time is unchanged
+        if( times_.size( ) > 0 && times_.back( ) == time )
+        {
+            getEntry( times_.size( ) - 1 ) = value.template cast< ScalarType >( );
+            return;
+        }
+
+        // Grow storage, if required
+        if( times_.size( ) == times_.capacity( ) )
+        {
+            reserve( times_.size( ) + std::max( static_cast< unsigned int >( times_.size( ) / 2 ), chunkSize_ ) );
+        }
+
+        times_.push_back( time );
+        data_.resize( data_.size( ) + getEntrySize( ) );
+        getEntry( times_.size( ) - 1 ) = value.template cast< ScalarType >( );
+    }
+
+    //! Function to add a scalar entry to the end of the history (for histories with 1x1 entries)
+    /*!
+     *  Function to add a scalar entry to the end of the history (for histories with 1x1 entries).
+     *  \param time Time of the entry
+     *  \param value Value that is to be stored
+     */
+    void addEntry( const TimeType& time, const ScalarType value )
+    {
+        addEntry( time, Eigen::Matrix< ScalarType, 1, 1 >::Constant( value ) );
+    }
+
+    //! Function to remove the last entry that was added to the history.
+    void removeLastEntry( )
+    {
+        if( times_.size( ) == 0 )
+        {
+            throw std::runtime_error( "Error, cannot remove last entry of empty columnar history" );
+        }
+        times_.pop_back( );
+        data_.resize( data_.size( ) - getEntrySize( ) );
+    }
+
+    //! Function to retrieve the number of entries in the history
+    unsigned int size( ) const
+    {
+        return times_.size( );
+    }
+
+    //! Function to retrieve whether the history is empty
+    bool empty( ) const
+    {
+        return times_.empty( );
+    }
+
+    //! Function to retrieve the number of rows of each entry
+    int getNumberOfRows( ) const
+    {
+        return numberOfRows_;
+    }
+
+    //! Function to retrieve the number of columns of each entry
+    int getNumberOfColumns( ) const
+    {
+        return numberOfColumns_;
+    }
+
+    //! Function to retrieve the times of all entries, in the order in which they were added
+    const std::vector< TimeType >& getTimes( ) const
+    {
+        return times_;
+    }
+
+    //! Function to retrieve the time of a given entry
+    TimeType getTime( const unsigned int index ) const
+    {
+        return times_.at( index );
+    }
+
+    //! Function to retrieve the time of the last entry that was added
+    TimeType getLastTime( ) const
+    {
+        return times_.back( );
+    }
+
+    //! Function to retrieve a (modifiable) view of a single entry of the history
+    Eigen::Map< EntryType > getEntry( const unsigned int index )
+    {
+        return Eigen::Map< EntryType >( data_.data( ) + index * getEntrySize( ), numberOfRows_, numberOfColumns_ );
+    }
+
+    //! Function to retrieve a view of a single entry of the history
+    Eigen::Map< const EntryType > getEntry( const unsigned int index ) const
+    {
+        return Eigen::Map< const EntryType >( data_.data( ) + index * getEntrySize( ), numberOfRows_, numberOfColumns_ );
+    }
+
+    //! Function to retrieve a (modifiable) view of the full data block
+    /*!
+     *  Function to retrieve a (modifiable) view of the full data block, with numberOfRows rows, and
+     *  ( numberOfColumns * size( ) ) columns.
+     *  \return View of the full data block
+     */
+    Eigen::Map< EntryType > getDataBlock( )
+    {
+        return Eigen::Map< EntryType >( data_.data( ), numberOfRows_, numberOfColumns_ * times_.size( ) );
+    }
+
+    //! Function to retrieve a view of the full data block
+    /*!
+     *  Function to retrieve a view of the full data block, with numberOfRows rows, and ( numberOfColumns * size( ) ) columns.
+     *  \return View of the full data block
+     */
+    Eigen::Map< const EntryType > getDataBlock( ) const
+    {
+        return Eigen::Map< const EntryType >( data_.data( ), numberOfRows_, numberOfColumns_ * times_.size( ) );
+    }
+
+    //! Function to sort the entries of the history in order of increasing time.
+    /*!
+     *  Function to sort the entries of the history in order of increasing time. Histories that are in decreasing order
+     *  (e.g. from a backwards propagation) are reversed in place.
+     */
+    void sortByTime( )
+    {
+        if( std::is_sorted( times_.begin( ), times_.end( ) ) )
+        {
+            return;
+        }
+        else if( std::is_sorted( times_.rbegin( ), times_.rend( ) ) )
+        {
+            unsigned int numberOfEntries = times_.size( );
+            std::reverse( times_.begin( ), times_.end( ) );
+            for( unsigned int i = 0; i < numberOfEntries / 2; i++ )
+            {
+                getEntry( i ).swap( getEntry( numberOfEntries - 1 - i ) );
+            }
+        }
+        else
+        {
+            std::vector< unsigned int > sortOrder( times_.size( ) );
+            for( unsigned int i = 0; i < sortOrder.size( ); i++ )
+            {
+                sortOrder[ i ] = i;
+            }
+            std::stable_sort( sortOrder.begin( ), sortOrder.end( ),
+                              [ & ]( const unsigned int first, const unsigned int second )
+            { return times_.at( first ) < times_.at( second ); } );
+
+            ColumnarHistory< TimeType, ScalarType > sortedHistory( numberOfRows_, numberOfColumns_, chunkSize_ );
+            sortedHistory.reserve( times_.size( ) );
+            for( unsigned int i = 0; i < sortOrder.size( ); i++ )
+            {
+                sortedHistory.addEntry( times_.at( sortOrder.at( i ) ), getEntry( sortOrder.at( i ) ) );
+            }
+            *this = std::move( sortedHistory );
+        }
+    }
+
+    //! Function to convert the history to a map
+    /*!
+     *  Function to convert the history to a map, with time as key, and the entry (of type MatrixType) as value.
+     *  \return Map containing all entries of this history.
+     */
+    template< typename MatrixType = Eigen::Matrix< ScalarType, Eigen::Dynamic, 1 > >
+    std::map< TimeType, MatrixType > convertToMap( ) const
+    {
+        std::map< TimeType, MatrixType > historyMap;
+        for( unsigned int i = 0; i < times_.size( ); i++ )
+        {
+            historyMap[ times_.at( i ) ] = getEntry( i );
+        }
+        return historyMap;
+    }
+
+    //! Function to convert the history of a 1x1 entry to a map of scalars
+    /*!
+     *  Function to convert the history of a 1x1 entry to a map of scalars, with time as key.
+     *  \return Map containing all entries of this history.
+     */
+    std::map< TimeType, ScalarType > convertToScalarMap( ) const
+    {
+        std::map< TimeType, ScalarType > historyMap;
+        for( unsigned int i = 0; i < times_.size( ); i++ )
+        {
+            historyMap[ times_.at( i ) ] = data_.at( i * getEntrySize( ) );
+        }
+        return historyMap;
+    }
+
+private:
+
+    //! Function to retrieve the number of scalars in each entry
+    unsigned int getEntrySize( ) const
+    {
+        return numberOfRows_ * numberOfColumns_;
+    }
+
+    //! Number of rows of each entry
+    int numberOfRows_;
+
+    //! Number of columns of each entry
+    int numberOfColumns_;
+
+    //! Minimum number of entries for which memory is allocated when the storage is to be grown.
+    unsigned int chunkSize_;
+
+    //! Times of the entries, in the order in which they were added
+    std::vector< TimeType > times_;
+
+    //! Contiguous (column-major) data of all entries
+    std::vector< ScalarType > data_;
+};
+
+//! Function to remove all entries from a history map
+template< typename TimeType, typename ValueType >
+void clearHistory( std::map< TimeType, ValueType >& history )
+{
+    history.clear( );
+}
+
+//! Function to remove all entries from a columnar history
+template< typename TimeType, typename ScalarType >
+void clearHistory( ColumnarHistory< TimeType, ScalarType >& history )
+{
+    history.clear( );
+}
+
+//! Function to add an entry to a history map
+template< typename TimeType, typename ValueType, typename InputType >
+void addHistoryEntry( std::map< TimeType, ValueType >& history, const TimeType& time, const InputType& value )
+{
+    history[ time ] = value;
+}
+
+//! Function to add an entry to a columnar history
+template< typename TimeType, typename ScalarType, typename InputType >
+void addHistoryEntry( ColumnarHistory< TimeType, ScalarType >& history, const TimeType& time, const InputType& value )
+{
+    history.addEntry( time, value );
+}
+
+//! Function to retrieve the number of entries in a history map
+template< typename TimeType, typename ValueType >
+unsigned int getHistorySize( const std::map< TimeType, ValueType >& history )
+{
+    return history.size( );
+}
+
+//! Function to retrieve the number of entries in a columnar history
+template< typename TimeType, typename ScalarType >
+unsigned int getHistorySize( const ColumnarHistory< TimeType, ScalarType >& history )
+{
+    return history.size( );
+}
+
+//! Function to retrieve the time of the last entry added to a history map
+/*!
+ *  Function to retrieve the time of the last entry added to a history map, assuming that entries are added in order
+ *  \param history History of which the last time is to be retrieved
+ *  \param isTimeIncreasing Boolean denoting whether the entries were added in increasing (or decreasing) time order
+ *  \return Time of the last entry added to the history
+ */
+template< typename TimeType, typename ValueType >
+TimeType getLastAddedHistoryTime( const std::map< TimeType, ValueType >& history, const bool isTimeIncreasing )
+{
+    return isTimeIncreasing ? history.rbegin( )->first : history.begin( )->first;
+}
+
+//! Function to retrieve the time of the last entry added to a columnar history
+template< typename TimeType, typename ScalarType >
+TimeType getLastAddedHistoryTime( const ColumnarHistory< TimeType, ScalarType >& history, const bool isTimeIncreasing )
+{
+    return history.getLastTime( );
+}
+
+//! Function to remove the last entry added to a history map
+/*!
+ *  Function to remove the last entry added to a history map, assuming that entries are added in order
+ *  \param history History of which the last entry is to be removed
+ *  \param isTimeIncreasing Boolean denoting whether the entries were added in increasing (or decreasing) time order
+ */
+template< typename TimeType, typename ValueType >
+void removeLastAddedHistoryEntry( std::map< TimeType, ValueType >& history, const bool isTimeIncreasing )
+{
+    if( isTimeIncreasing )
+    {
+        history.erase( std::prev( history.end( ) ) );
+    }
+    else
+    {
+        history.erase( history.begin( ) );
+    }
+}
+
+//! Function to remove the last entry added to a columnar history
+template< typename TimeType, typename ScalarType >
+void removeLastAddedHistoryEntry( ColumnarHistory< TimeType, ScalarType >& history, const bool isTimeIncreasing )
+{
+    history.removeLastEntry( );
+}
+
+} // namespace utilities
+
+} // namespace tudat
+
+#endif // TUDAT_COLUMNAR_HISTORY_H
@@ -0,0 +1,121 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_PARALLEL_EXECUTION_H
+#define TUDAT_PARALLEL_EXECUTION_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Function to retrieve the number of concurrent threads supported by the hardware
+/*!
+ *  Function to retrieve the number of concurrent threads supported by the hardware. If this number cannot be determined,
+ *  a single thread is returned.
+ *  \return Number of concurrent threads supported by the hardware (at least 1).
+ */
+inline unsigned int getNumberOfAvailableThreads( )
+{
+    return std::max( std::thread::hardware_concurrency( ), 1U );
+}
+
+//! Function to execute a list of independent tasks on a number of worker threads.
+/*!
+ *  Function to execute a list of independent tasks on a number of worker threads. The tasks are distributed dynamically:
+ *  each worker retrieves the next unprocessed task index when it has finished its current task, so that tasks of unequal
+ *  cost are balanced over the workers. The task function is called as task( taskIndex, threadIndex ), where threadIndex
+ *  (in [0, numberOfThreads) ) identifies the worker, and can be used to access per-thread scratch data. If the
+ *  number of threads is 1 (or the number of tasks is at most 1) all tasks are executed, in order, on the calling thread.
+ *  If any task throws an exception, no new tasks are started, and the first exception that was caught is rethrown on
+ *  the calling thread after all workers have finished.
+ *  \param numberOfTasks Number of tasks that are to be executed
+ *  \param numberOfThreads Maximum number of worker threads that is to be used (0 denotes all available threads)
+ *  \param task Function executing a single task, with the task index and thread index as input.
+ */
+template< typename TaskFunction >
+void executeTasksInParallel( const unsigned int numberOfTasks,
+                             const unsigned int numberOfThreads,
+                             const TaskFunction& task )
+{
+    unsigned int numberOfWorkers = ( numberOfThreads == 0 ) ? getNumberOfAvailableThreads( ) : numberOfThreads;
+    numberOfWorkers = std::min( numberOfWorkers, numberOfTasks );
+
+    // Execute tasks sequentially if no concurrency is requested/possible
+    if( numberOfWorkers <= 1 )
+    {
+        for( unsigned int i = 0; i < numberOfTasks; i++ )
+        {
+            task( i, 0 );
+        }
+        return;
+    }
+
+    std::atomic< unsigned int > nextTaskIndex( 0 );
+    std::atomic< bool > isExceptionCaught( false );
+    std::exception_ptr firstException;
+    std::mutex exceptionMutex;
+
+    // Define function executed by each worker
+    auto workerFunction = [ & ]( const unsigned int threadIndex )
+    {
+        unsigned int currentTaskIndex;
+        while( !isExceptionCaught && ( currentTaskIndex = nextTaskIndex++ ) < numberOfTasks )
+        {
+            try
+            {
+                task( currentTaskIndex, threadIndex );
+            }
+            catch( ... )
+            {
+                std::lock_guard< std::mutex > exceptionLock( exceptionMutex );
+                if( !isExceptionCaught )
+                {
+                    firstException = std::current_exception( );
+                    isExceptionCaught = true;
+                }
+            }
+        }
+    };
+
+    // Start workers (calling thread acts as worker 0) and wait for them to finish
+    std::vector< std::thread > workerThreads;
+    workerThreads.reserve( numberOfWorkers - 1 );
+    for( unsigned int i = 1; i < numberOfWorkers; i++ )
+    {
+        workerThreads.push_back( std::thread( workerFunction, i ) );
+    }
+    workerFunction( 0 );
+
+    for( unsigned int i = 0; i < workerThreads.size( ); i++ )
+    {
+        workerThreads.at( i ).join( );
+    }
+
+    if( isExceptionCaught )
+    {
+        std::rethrow_exception( firstException );
+    }
+}
+
+} // namespace utilities
+
+} // namespace tudat
+
+#endif // TUDAT_PARALLEL_EXECUTION_H
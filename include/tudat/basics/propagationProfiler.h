@@ -0,0 +1,219 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_PROPAGATION_PROFILER_H
+#define TUDAT_PROPAGATION_PROFILER_H
+
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Class to collect wall-clock time and number of calls of the models that are evaluated during a propagation
+/*!
+ *  Class to collect wall-clock time and number of calls of the models that are evaluated during a propagation (e.g. state
+ *  derivative models, acceleration models, environment updates). Each timed entity is registered as a scope, which may
+ *  be nested in a parent scope, so that the results form a call tree. Scopes are identified by their full path (the names
+ *  of the scope and all its parents, separated by ';'). The results can be written as 'folded stacks', the input format
+ *  used by the common flame graph tools (e.g. flamegraph.pl, speedscope). The instrumentation in the propagation
+ *  framework is only compiled when TUDAT_BUILD_WITH_PROFILING is enabled (see TUDAT_PROFILE_SCOPE), so that it has no
+ *  overhead in regular builds. An object of this class should not be used concurrently from multiple threads.
+ */
+class PropagationProfiler
+{
+public:
+
+    //! Constructor
+    PropagationProfiler( ){ }
+
+    //! Function to register a scope that is to be timed
+    /*!
+     *  Function to register a scope that is to be timed. If a scope with the same full path is already registered, no new
+     *  scope is created, and the index of the existing scope is returned.
+     *  \param scopeName Name of the scope (';' and space characters are replaced by '_')
+     *  \param parentScopeIndex Index of scope in which the new scope is nested (-1 if none)
+     *  \return Index of the scope, used to add calls to it
+     */
+    int addScope( const std::string& scopeName, const int parentScopeIndex = -1 );
+
+    //! Function to add a single timed call to a scope
+    /*!
+     *  Function to add a single timed call to a scope
+     *  \param scopeIndex Index of scope, as returned by addScope
+     *  \param wallTime Wall-clock time (in seconds) of the call
+     */
+    void addCall( const int scopeIndex, const double wallTime )
+    {
+        numberOfCalls_[ scopeIndex ]++;
+        totalWallTimes_[ scopeIndex ] += wallTime;
+    }
+
+    //! Function to add wall-clock time to a scope, without incrementing its number of calls
+    /*!
+     *  Function to add wall-clock time to a scope, without incrementing its number of calls. Used when a single call
+     *  of a model is timed in separate parts.
+     *  \param scopeIndex Index of scope, as returned by addScope
+     *  \param wallTime Wall-clock time (in seconds) that is to be added
+     */
+    void addWallTime( const int scopeIndex, const double wallTime )
+    {
+        totalWallTimes_[ scopeIndex ] += wallTime;
+    }
+
+    //! Function to reset the number of calls and wall-clock times of all scopes to zero
+    void resetStatistics( );
+
+    //! Function to retrieve the full path of a scope
+    /*!
+     *  Function to retrieve the full path of a scope
+     *  \param scopeIndex Index of scope, as returned by addScope
+     *  \return Full path of the scope (names of all parent scopes and the scope, separated by ';')
+     */
+    std::string getScopePath( const int scopeIndex ) const
+    {
+        return scopePaths_.at( scopeIndex );
+    }
+
+    //! Function to retrieve the number of registered scopes
+    /*!
+     *  Function to retrieve the number of registered scopes
+     *  \return Number of registered scopes
+     */
+    int getNumberOfScopes( ) const
+    {
+        return static_cast< int >( scopePaths_.size( ) );
+    }
+
+    //! Function to retrieve the number of calls and total wall-clock time of all scopes
+    /*!
+     *  Function to retrieve the number of calls and total wall-clock time (including time spent in nested scopes) of all
+     *  scopes
+     *  \return Map with full path of each scope as key, and (number of calls, total wall-clock time in seconds) as value
+     */
+    std::map< std::string, std::pair< unsigned long, double > > getProfilingResults( ) const;
+
+    //! Function to write the profiling results as folded stacks
+    /*!
+     *  Function to write the profiling results as folded stacks: one line per scope, containing the full path of the
+     *  scope, followed by its self time (total time minus time of directly nested scopes) in integer microseconds.
+     *  \param outputStream Stream to which the folded stacks are to be written
+     */
+    void writeFoldedStacks( std::ostream& outputStream ) const;
+
+    //! Function to write the profiling results as folded stacks to a file
+    /*!
+     *  Function to write the profiling results as folded stacks to a file (see writeFoldedStacks( std::ostream& ) )
+     *  \param fileName Name of file to which the folded stacks are to be written
+     */
+    void writeFoldedStacks( const std::string& fileName ) const;
+
+private:
+
+    //! Full path of each scope
+    std::vector< std::string > scopePaths_;
+
+    //! Index of parent of each scope (-1 if none)
+    std::vector< int > parentScopeIndices_;
+
+    //! Number of calls of each scope
+    std::vector< unsigned long > numberOfCalls_;
+
+    //! Total wall-clock time (in seconds) of each scope
+    std::vector< double > totalWallTimes_;
+
+};
+
+//! Class that adds the wall-clock time between its construction and destruction to a scope of a PropagationProfiler
+class ProfiledScope
+{
+public:
+
+    //! Constructor, starts the timer
+    /*!
+     *  Constructor, starts the timer
+     *  \param profiler Profiler to which the time is to be added (no timing is done if nullptr)
+     *  \param scopeIndex Index of scope in profiler to which the time is to be added
+     *  \param countCall Boolean denoting whether the number of calls of the scope is to be incremented
+     */
+    ProfiledScope( PropagationProfiler* profiler, const int scopeIndex, const bool countCall = true ):
+        profiler_( profiler ), scopeIndex_( scopeIndex ), countCall_( countCall )
+    {
+        if( profiler_ != nullptr )
+        {
+            startTime_ = std::chrono::steady_clock::now( );
+        }
+    }
+
+    //! Destructor, adds the elapsed time to the profiler
+    ~ProfiledScope( )
+    {
+        if( profiler_ != nullptr )
+        {
+            double wallTime = std::chrono::duration< double >( std::chrono::steady_clock::now( ) - startTime_ ).count( );
+            if( countCall_ )
+            {
+                profiler_->addCall( scopeIndex_, wallTime );
+            }
+            else
+            {
+                profiler_->addWallTime( scopeIndex_, wallTime );
+            }
+        }
+    }
+
+    ProfiledScope( const ProfiledScope& ) = delete;
+
+    ProfiledScope& operator=( const ProfiledScope& ) = delete;
+
+private:
+
+    //! Profiler to which the time is to be added (no timing is done if nullptr)
+    PropagationProfiler* profiler_;
+
+    //! Index of scope in profiler to which the time is to be added
+    int scopeIndex_;
+
+    //! Boolean denoting whether the number of calls of the scope is to be incremented
+    bool countCall_;
+
+    //! Time at which the timer was started
+    std::chrono::steady_clock::time_point startTime_;
+
+};
+
+} // namespace utilities
+
+} // namespace tudat
+
+#define TUDAT_PROFILE_CONCATENATE_IMPL( first, second ) first##second
+#define TUDAT_PROFILE_CONCATENATE( first, second ) TUDAT_PROFILE_CONCATENATE_IMPL( first, second )
+
+//! Macro to time the remainder of the enclosing block in a scope of a PropagationProfiler (pointer, may be nullptr).
+//! Expands to nothing if TUDAT_BUILD_WITH_PROFILING is disabled.
+#if( TUDAT_BUILD_WITH_PROFILING )
+#define TUDAT_PROFILE_SCOPE( profiler, scopeIndex ) \
+    tudat::utilities::ProfiledScope TUDAT_PROFILE_CONCATENATE( profiledScope, __LINE__ )( profiler, scopeIndex )
+#define TUDAT_PROFILE_SCOPE_WITHOUT_CALL( profiler, scopeIndex ) \
+    tudat::utilities::ProfiledScope TUDAT_PROFILE_CONCATENATE( profiledScope, __LINE__ )( profiler, scopeIndex, false )
+#else
+#define TUDAT_PROFILE_SCOPE( profiler, scopeIndex )
+#define TUDAT_PROFILE_SCOPE_WITHOUT_CALL( profiler, scopeIndex )
+#endif
+
+#endif // TUDAT_PROPAGATION_PROFILER_H
@@ -44,6 +44,16 @@ public:
     //! @get_docstring(SpiceEphemeris.get_cartesian_state)
     Eigen::Vector6d getCartesianState(const double secondsSinceEpoch );
 
+    //! Get Cartesian states from ephemeris at a list of times.
+    /*!
+     * Returns Cartesian states from ephemeris at a list of times, retrieved from Spice in a single call to
+     * spice_interface::getBodyCartesianStatesAtEpochs.
+     * \param times List of seconds since epoch at which ephemeris is to be evaluated.
+     * \param states Cartesian states from ephemeris at each of the times (returned by reference)
+     */
+    void getCartesianStates( const std::vector< double >& times,
+                             Eigen::Matrix< double, 6, Eigen::Dynamic >& states );
+
 private:
 
     //! Name of body of which ephemeris is to be determined
@@ -59,6 +59,23 @@ Eigen::Vector6d getBodyCartesianStateAtEpoch(
     const std::string &referenceFrameName, const std::string &aberrationCorrections,
     const double ephemerisTime);
 
+//! Get Cartesian states of a body at a list of epochs, as observed from another body.
+/*!
+ * Get Cartesian states of a body at a list of epochs, as observed from another body, writing the states directly into a
+ * buffer (one column per epoch). The Spice function is called once per epoch, but with the string arguments, input
+ * checks and unit conversion handled once for the full list of epochs.
+ * \param targetBodyName Name of the body of which the states are to be obtained.
+ * \param observerBodyName Name of the body relative to which the states are to be obtained.
+ * \param referenceFrameName The Spice name of the reference frame in which the states are to be returned.
+ * \param aberrationCorrections Setting for correction for setting corrections (see getBodyCartesianStateAtEpoch).
+ * \param ephemerisTimes List of ephemeris times at which the states are to be determined.
+ * \param states Cartesian states of the body at each of the epochs, in m and m/s (returned by reference).
+ */
+void getBodyCartesianStatesAtEpochs(
+    const std::string &targetBodyName, const std::string &observerBodyName,
+    const std::string &referenceFrameName, const std::string &aberrationCorrections,
+    const std::vector< double > &ephemerisTimes, Eigen::Matrix< double, 6, Eigen::Dynamic > &states);
+
 //! @get_docstring(get_body_cartesian_position_at_epoch)
 Eigen::Vector3d getBodyCartesianPositionAtEpoch(const std::string &targetBodyName,
                                                 const std::string &observerBodyName,
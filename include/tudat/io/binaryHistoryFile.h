@@ -0,0 +1,727 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_BINARYHISTORYFILE_H
+#define TUDAT_BINARYHISTORYFILE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/timeType.h"
+#include "tudat/math/interpolators/stridedLagrangeInterpolator.h"
+
+namespace tudat
+{
+
+namespace input_output
+{
+
+//! Types of the time and value entries that can be stored in a binary history file
+enum BinaryHistoryDataType
+{
+    double_history_data = 0,
+    long_double_history_data = 1,
+    tudat_time_history_data = 2
+};
+
+//! Function to retrieve the identifier of a time or value type in a binary history file
+/*!
+ *  Function to retrieve the identifier of a time or value type in a binary history file, specialized for double, long double
+ *  and Time (the latter only for the time entries).
+ *  \return Identifier of the type in a binary history file
+ */
+template< typename DataType >
+BinaryHistoryDataType getBinaryHistoryDataType( );
+
+//! Function to retrieve the identifier of double type in a binary history file
+template< >
+BinaryHistoryDataType getBinaryHistoryDataType< double >( );
+
+//! Function to retrieve the identifier of long double type in a binary history file
+template< >
+BinaryHistoryDataType getBinaryHistoryDataType< long double >( );
+
+//! Function to retrieve the identifier of Time type in a binary history file
+template< >
+BinaryHistoryDataType getBinaryHistoryDataType< Time >( );
+
+//! Function to retrieve the name of a time or value type in a binary history file (for error messages)
+/*!
+ *  Function to retrieve the name of a time or value type in a binary history file (for error messages)
+ *  \param dataType Identifier of the type
+ *  \return Name of the type
+ */
+std::string getBinaryHistoryDataTypeName( const BinaryHistoryDataType dataType );
+
+//! Function to retrieve the number of bytes used to store a single time or value entry in a binary history file
+/*!
+ *  Function to retrieve the number of bytes used to store a single time or value entry in a binary history file. A Time
+ *  entry is stored as a 64-bit integer (number of full periods), followed by a long double (seconds into period).
+ *  \param dataType Identifier of the type
+ *  \return Number of bytes used to store a single entry
+ */
+unsigned int getBinaryHistoryDataTypeSize( const BinaryHistoryDataType dataType );
+
+//! Header of a binary history file, describing the layout of the data in the file
+/*!
+ *  Header of a binary history file, describing the layout of the data in the file. A binary history file stores a time
+ *  history of vectors or matrices (e.g. a state or dependent variable history) as a header, followed by one fixed-size record
+ *  per epoch. Each record contains the time, followed by all value entries (called columns) of the epoch, in native byte
+ *  order, and is padded such that all entries are aligned in memory, so that the data can be accessed directly in a
+ *  memory-mapped file (see BinaryHistoryFileReader). The entries of a column are stored at a fixed stride (the record size),
+ *  so that the time history of a single column can also be accessed without copying the data. The number of epochs is not
+ *  stored, but is determined from the file size, so that the file remains readable if writing it was interrupted.
+ */
+struct BinaryHistoryFileHeader
+{
+    //! Default constructor
+    BinaryHistoryFileHeader( ):
+        timeDataType( double_history_data ), valueDataType( double_history_data ), numberOfColumns( 0 ),
+        dataOffset( 0 ), recordSize( 0 ), valueOffset( 0 ){ }
+
+    //! Constructor
+    /*!
+     *  Constructor, computes the layout of the records in the file from the types and number of columns.
+     *  \param timeDataType Type of the time entries
+     *  \param valueDataType Type of the value entries (double or long double)
+     *  \param numberOfColumns Number of value entries per epoch
+     *  \param columnNames Name of each column (may be empty, in which case no names are stored)
+     *  \param columnUnits Unit of each column (may be empty, in which case no units are stored)
+     */
+    BinaryHistoryFileHeader( const BinaryHistoryDataType timeDataType,
+                             const BinaryHistoryDataType valueDataType,
+                             const unsigned int numberOfColumns,
+                             const std::vector< std::string >& columnNames = std::vector< std::string >( ),
+                             const std::vector< std::string >& columnUnits = std::vector< std::string >( ) );
+
+    //! Type of the time entries
+    BinaryHistoryDataType timeDataType;
+
+    //! Type of the value entries
+    BinaryHistoryDataType valueDataType;
+
+    //! Number of value entries per epoch
+    unsigned int numberOfColumns;
+
+    //! Name of each column (empty strings if no names are provided)
+    std::vector< std::string > columnNames;
+
+    //! Unit of each column (empty strings if no units are provided)
+    std::vector< std::string > columnUnits;
+
+    //! Offset (in bytes) of the first record from the start of the file
+    std::uint64_t dataOffset;
+
+    //! Size (in bytes) of a single record
+    std::uint64_t recordSize;
+
+    //! Offset (in bytes) of the first value entry from the start of a record
+    std::uint64_t valueOffset;
+};
+
+//! Function to write the header of a binary history file to a stream
+/*!
+ *  Function to write the header of a binary history file to a stream, padded with zeros up to the start of the first record.
+ *  \param fileStream Binary stream to which the header is written
+ *  \param header Header that is to be written
+ */
+void writeBinaryHistoryFileHeader( std::ostream& fileStream, const BinaryHistoryFileHeader& header );
+
+//! Function to parse the header of a binary history file
+/*!
+ *  Function to parse the header of a binary history file, and check its consistency with the current platform (byte order
+ *  and size of long double). An exception is thrown if the data is not a (valid) binary history file.
+ *  \param fileData Pointer to start of file contents
+ *  \param fileSize Size of the file (in bytes)
+ *  \param fileName Name of the file (for error messages)
+ *  \return Header of the file
+ */
+BinaryHistoryFileHeader parseBinaryHistoryFileHeader(
+        const char* fileData, const std::uint64_t fileSize, const std::string& fileName );
+
+//! Function to write a single time entry to a record of a binary history file
+/*!
+ *  Function to write a single time entry to a record of a binary history file
+ *  \param time Time that is to be written
+ *  \param recordData Pointer to start of record
+ */
+inline void writeBinaryHistoryTime( const double time, char* recordData )
+{
+    std::memcpy( recordData, &time, sizeof( double ) );
+}
+
+//! Function to write a single time entry to a record of a binary history file
+/*!
+ *  Function to write a single time entry to a record of a binary history file
+ *  \param time Time that is to be written
+ *  \param recordData Pointer to start of record
+ */
+inline void writeBinaryHistoryTime( const long double time, char* recordData )
+{
+    std::memcpy( recordData, &time, sizeof( long double ) );
+}
+
+//! Function to write a single time entry to a record of a binary history file
+/*!
+ *  Function to write a single time entry to a record of a binary history file
+ *  \param time Time that is to be written
+ *  \param recordData Pointer to start of record
+ */
+inline void writeBinaryHistoryTime( const Time& time, char* recordData )
+{
+    std::int64_t fullPeriods = time.getFullPeriods( );
+    long double secondsIntoFullPeriod = time.getSecondsIntoFullPeriod( );
+    std::memcpy( recordData, &fullPeriods, sizeof( std::int64_t ) );
+    std::memcpy( recordData + sizeof( std::int64_t ), &secondsIntoFullPeriod, sizeof( long double ) );
+}
+
+//! Class for writing a time history to a binary history file, one epoch at a time
+/*!
+ *  Class for writing a time history to a binary history file (see BinaryHistoryFileHeader), one epoch at a time, so that it
+ *  can be used to stream output to a file during a propagation, without retaining the history in memory. The records are
+ *  collected in a buffer, which is written to the file when it is full, when calling flush, and when closing the file.
+ *  The epochs must be written in chronological order for the file to be usable as input for an interpolator (not checked).
+ */
+template< typename TimeType = double, typename ScalarType = double >
+class BinaryHistoryFileWriter
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor, opens the file and writes the header.
+     *  \param fileName Name of the file that is to be written (overwritten if it exists)
+     *  \param numberOfColumns Number of value entries per epoch
+     *  \param columnNames Name of each column (empty if no names are to be stored)
+     *  \param columnUnits Unit of each column (empty if no units are to be stored)
+     *  \param numberOfBufferedEpochs Number of epochs that are collected in memory before being written to the file
+     */
+    BinaryHistoryFileWriter( const std::string& fileName,
+                             const unsigned int numberOfColumns,
+                             const std::vector< std::string >& columnNames = std::vector< std::string >( ),
+                             const std::vector< std::string >& columnUnits = std::vector< std::string >( ),
+                             const unsigned int numberOfBufferedEpochs = 1024 ):
+        fileName_( fileName ),
+        header_( getBinaryHistoryDataType< TimeType >( ), getBinaryHistoryDataType< ScalarType >( ),
+                 numberOfColumns, columnNames, columnUnits ),
+        numberOfBufferedEpochs_( std::max( numberOfBufferedEpochs, 1U ) ), numberOfEpochsInBuffer_( 0 ),
+        numberOfWrittenEpochs_( 0 )
+    {
+        fileStream_.open( fileName_, std::ios::out | std::ios::binary | std::ios::trunc );
+        if( !fileStream_.is_open( ) )
+        {
+            throw std::runtime_error( "Error when creating binary history file, could not open " + fileName_ );
+        }
+        writeBinaryHistoryFileHeader( fileStream_, header_ );
+        buffer_.resize( numberOfBufferedEpochs_ * header_.recordSize );
+    }
+
+    //! Destructor, writes remaining buffered epochs and closes the file
+    ~BinaryHistoryFileWriter( )
+    {
+        try
+        {
+            close( );
+        }
+        catch( const std::exception& )
+        { }
+    }
+
+    //! Function to write the values at a single epoch
+    /*!
+     *  Function to write the values at a single epoch. Matrices are written in column-major order.
+     *  \param time Current time
+     *  \param values Values at current time (must have as many entries as the number of columns of the file)
+     */
+    template< typename Derived >
+    void writeEpoch( const TimeType& time, const Eigen::MatrixBase< Derived >& values )
+    {
+        if( !fileStream_.is_open( ) )
+        {
+            throw std::runtime_error( "Error when writing to binary history file " + fileName_ + ", file is closed" );
+        }
+        if( static_cast< unsigned int >( values.size( ) ) != header_.numberOfColumns )
+        {
+            throw std::runtime_error( "Error when writing to binary history file " + fileName_ + ", expected " +
+                                      std::to_string( header_.numberOfColumns ) + " values, but got " +
+                                      std::to_string( values.size( ) ) );
+        }
+
+        char* recordData = buffer_.data( ) + numberOfEpochsInBuffer_ * header_.recordSize;
+        writeBinaryHistoryTime( time, recordData );
+        ScalarType* valueData = reinterpret_cast< ScalarType* >( recordData + header_.valueOffset );
+        for( int j = 0; j < values.cols( ); j++ )
+        {
+            for( int i = 0; i < values.rows( ); i++ )
+            {
+                *valueData = static_cast< ScalarType >( values( i, j ) );
+                valueData++;
+            }
+        }
+
+        numberOfEpochsInBuffer_++;
+        if( numberOfEpochsInBuffer_ == numberOfBufferedEpochs_ )
+        {
+            flush( );
+        }
+    }
+
+    //! Function to write a full time history
+    /*!
+     *  Function to write a full time history (appended to the epochs that have already been written)
+     *  \param history Time history that is to be written
+     */
+    template< typename MatrixType >
+    void writeHistory( const std::map< TimeType, MatrixType >& history )
+    {
+        for( auto historyIterator : history )
+        {
+            writeEpoch( historyIterator.first, historyIterator.second );
+        }
+    }
+
+    //! Function to write all buffered epochs to the file
+    void flush( )
+    {
+        if( numberOfEpochsInBuffer_ > 0 )
+        {
+            fileStream_.write( buffer_.data( ), numberOfEpochsInBuffer_ * header_.recordSize );
+            fileStream_.flush( );
+            if( !fileStream_ )
+            {
+                throw std::runtime_error( "Error when writing to binary history file " + fileName_ );
+            }
+            numberOfWrittenEpochs_ += numberOfEpochsInBuffer_;
+            numberOfEpochsInBuffer_ = 0;
+        }
+    }
+
+    //! Function to write all buffered epochs and close the file. No more epochs can be written afterwards.
+    void close( )
+    {
+        if( fileStream_.is_open( ) )
+        {
+            flush( );
+            fileStream_.close( );
+        }
+    }
+
+    //! Function to retrieve the number of epochs that have been written (including those in the buffer)
+    /*!
+     *  Function to retrieve the number of epochs that have been written (including those in the buffer)
+     *  \return Number of epochs that have been written
+     */
+    unsigned int getNumberOfEpochs( ) const
+    {
+        return numberOfWrittenEpochs_ + numberOfEpochsInBuffer_;
+    }
+
+    //! Function to retrieve the header of the file
+    /*!
+     *  Function to retrieve the header of the file
+     *  \return Header of the file
+     */
+    const BinaryHistoryFileHeader& getHeader( ) const
+    {
+        return header_;
+    }
+
+private:
+
+    //! Name of the file
+    std::string fileName_;
+
+    //! Header of the file
+    BinaryHistoryFileHeader header_;
+
+    //! Stream to which the file is written
+    std::ofstream fileStream_;
+
+    //! Buffer in which records are collected before being written to the file
+    std::vector< char > buffer_;
+
+    //! Maximum number of epochs that are collected in the buffer
+    unsigned int numberOfBufferedEpochs_;
+
+    //! Current number of epochs in the buffer
+    unsigned int numberOfEpochsInBuffer_;
+
+    //! Number of epochs that have been written to the file (excluding those in the buffer)
+    unsigned int numberOfWrittenEpochs_;
+};
+
+//! Function to write a time history to a binary history file
+/*!
+ *  Function to write a time history to a binary history file (see BinaryHistoryFileWriter)
+ *  \param history Time history that is to be written (must be non-empty)
+ *  \param fileName Name of the file that is to be written (overwritten if it exists)
+ *  \param columnNames Name of each column (empty if no names are to be stored)
+ *  \param columnUnits Unit of each column (empty if no units are to be stored)
+ */
+template< typename TimeType, typename ScalarType, int Rows, int Columns >
+void writeHistoryToBinaryFile( const std::map< TimeType, Eigen::Matrix< ScalarType, Rows, Columns > >& history,
+                               const std::string& fileName,
+                               const std::vector< std::string >& columnNames = std::vector< std::string >( ),
+                               const std::vector< std::string >& columnUnits = std::vector< std::string >( ) )
+{
+    if( history.size( ) == 0 )
+    {
+        throw std::runtime_error( "Error when writing binary history file " + fileName + ", history is empty" );
+    }
+    BinaryHistoryFileWriter< TimeType, ScalarType > fileWriter(
+                fileName, history.begin( )->second.size( ), columnNames, columnUnits );
+    fileWriter.writeHistory( history );
+    fileWriter.close( );
+}
+
+//! Class for reading a binary history file through a memory-mapped view of the file
+/*!
+ *  Class for reading a binary history file (see BinaryHistoryFileHeader) through a memory-mapped view of the file, so that
+ *  the data is loaded from disk on demand by the operating system, and no parsing of the data is required. The values at an
+ *  epoch, the time history of a single column, and the values at all epochs, are accessed as Eigen::Map objects that
+ *  refer directly to the mapped data, which remain valid as long as the reader exists. An interpolator (and from it, a
+ *  TabulatedCartesianEphemeris) that reads directly from the mapped data is created by
+ *  createLagrangeInterpolatorFromBinaryHistoryFile. The time history can also be copied into (a pair of vectors for) a
+ *  map.
+ */
+class BinaryHistoryFileReader
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor, maps the file into memory and parses the header.
+     *  \param fileName Name of the file that is to be read
+     */
+    BinaryHistoryFileReader( const std::string& fileName );
+
+    //! Function to retrieve the number of epochs in the file
+    /*!
+     *  Function to retrieve the number of epochs in the file (a final incomplete record is ignored)
+     *  \return Number of epochs in the file
+     */
+    unsigned int getNumberOfEpochs( ) const
+    {
+        return numberOfEpochs_;
+    }
+
+    //! Function to retrieve the number of value entries per epoch
+    /*!
+     *  Function to retrieve the number of value entries per epoch
+     *  \return Number of value entries per epoch
+     */
+    unsigned int getNumberOfColumns( ) const
+    {
+        return header_.numberOfColumns;
+    }
+
+    //! Function to retrieve the header of the file
+    /*!
+     *  Function to retrieve the header of the file
+     *  \return Header of the file
+     */
+    const BinaryHistoryFileHeader& getHeader( ) const
+    {
+        return header_;
+    }
+
+    //! Function to retrieve the time at a given epoch
+    /*!
+     *  Function to retrieve the time at a given epoch, converted to the requested time type
+     *  \param epochIndex Index of the epoch
+     *  \return Time at the epoch
+     */
+    template< typename TimeType >
+    TimeType getTime( const unsigned int epochIndex ) const
+    {
+        const char* recordData = getRecordData( epochIndex );
+        switch( header_.timeDataType )
+        {
+        case double_history_data:
+        {
+            double time;
+            std::memcpy( &time, recordData, sizeof( double ) );
+            return static_cast< TimeType >( time );
+        }
+        case long_double_history_data:
+        {
+            long double time;
+            std::memcpy( &time, recordData, sizeof( long double ) );
+            return static_cast< TimeType >( time );
+        }
+        case tudat_time_history_data:
+        {
+            std::int64_t fullPeriods;
+            long double secondsIntoFullPeriod;
+            std::memcpy( &fullPeriods, recordData, sizeof( std::int64_t ) );
+            std::memcpy( &secondsIntoFullPeriod, recordData + sizeof( std::int64_t ), sizeof( long double ) );
+            return static_cast< TimeType >( Time( static_cast< int >( fullPeriods ), secondsIntoFullPeriod ) );
+        }
+        default:
+            throw std::runtime_error( "Error when reading time from binary history file " + fileName_ +
+                                      ", time type not recognized" );
+        }
+    }
+
+    //! Function to retrieve the times at all epochs
+    /*!
+     *  Function to retrieve the times at all epochs, converted to the requested time type
+     *  \return Times at all epochs
+     */
+    template< typename TimeType >
+    std::vector< TimeType > getTimes( ) const
+    {
+        std::vector< TimeType > times;
+        times.reserve( numberOfEpochs_ );
+        for( unsigned int i = 0; i < numberOfEpochs_; i++ )
+        {
+            times.push_back( getTime< TimeType >( i ) );
+        }
+        return times;
+    }
+
+    //! Function to retrieve the values at a given epoch, without copying the data
+    /*!
+     *  Function to retrieve the values at a given epoch, without copying the data. The requested scalar type must be equal to
+     *  the value type in the file.
+     *  \param epochIndex Index of the epoch
+     *  \return Values at the epoch, referring to the mapped file data
+     */
+    template< typename ScalarType >
+    Eigen::Map< const Eigen::Matrix< ScalarType, Eigen::Dynamic, 1 > > getValues( const unsigned int epochIndex ) const
+    {
+        checkValueDataType< ScalarType >( );
+        return Eigen::Map< const Eigen::Matrix< ScalarType, Eigen::Dynamic, 1 > >(
+                    reinterpret_cast< const ScalarType* >( getRecordData( epochIndex ) + header_.valueOffset ),
+                    header_.numberOfColumns );
+    }
+
+    //! Function to retrieve the time history of a single column, without copying the data
+    /*!
+     *  Function to retrieve the time history of a single column, without copying the data. The requested scalar type must be
+     *  equal to the value type in the file.
+     *  \param columnIndex Index of the column
+     *  \return Values of the column at all epochs, referring to the mapped file data
+     */
+    template< typename ScalarType >
+    Eigen::Map< const Eigen::Matrix< ScalarType, Eigen::Dynamic, 1 >, 0, Eigen::InnerStride< Eigen::Dynamic > >
+    getColumn( const unsigned int columnIndex ) const
+    {
+        checkValueDataType< ScalarType >( );
+        if( columnIndex >= header_.numberOfColumns )
+        {
+            throw std::runtime_error( "Error when reading column " + std::to_string( columnIndex ) +
+                                      " from binary history file " + fileName_ + ", file has " +
+                                      std::to_string( header_.numberOfColumns ) + " columns" );
+        }
+        return Eigen::Map< const Eigen::Matrix< ScalarType, Eigen::Dynamic, 1 >, 0, Eigen::InnerStride< Eigen::Dynamic > >(
+                    reinterpret_cast< const ScalarType* >( fileData_ + header_.dataOffset + header_.valueOffset ) +
+                    columnIndex, numberOfEpochs_,
+                    Eigen::InnerStride< Eigen::Dynamic >( header_.recordSize / sizeof( ScalarType ) ) );
+    }
+
+    //! Function to retrieve the values at all epochs, without copying the data
+    /*!
+     *  Function to retrieve the values at all epochs, without copying the data, as a matrix with one column per epoch (with
+     *  an outer stride equal to the record size). The requested scalar type must be equal to the value type in the file.
+     *  \return Values at all epochs, referring to the mapped file data
+     */
+    template< typename ScalarType >
+    Eigen::Map< const Eigen::Matrix< ScalarType, Eigen::Dynamic, Eigen::Dynamic >, 0, Eigen::OuterStride< Eigen::Dynamic > >
+    getValueBlock( ) const
+    {
+        checkValueDataType< ScalarType >( );
+        return Eigen::Map< const Eigen::Matrix< ScalarType, Eigen::Dynamic, Eigen::Dynamic >, 0,
+                Eigen::OuterStride< Eigen::Dynamic > >(
+                    reinterpret_cast< const ScalarType* >( fileData_ + header_.dataOffset + header_.valueOffset ),
+                    header_.numberOfColumns, numberOfEpochs_,
+                    Eigen::OuterStride< Eigen::Dynamic >( header_.recordSize / sizeof( ScalarType ) ) );
+    }
+
+    //! Function to retrieve the time history in the file as vectors of times and values
+    /*!
+     *  Function to retrieve the time history in the file as vectors of times and values, copying (and converting) all
+     *  values. The values are converted to the scalar type of the requested StateType, and stored in column-major order if
+     *  StateType is a matrix. To interpolate the values without copying them, use
+     *  createLagrangeInterpolatorFromBinaryHistoryFile.
+     *  \param times Times at all epochs (returned by reference)
+     *  \param values Values at all epochs (returned by reference)
+     */
+    template< typename TimeType, typename StateType >
+    void getHistoryVectors( std::vector< TimeType >& times, std::vector< StateType >& values ) const
+    {
+        times = getTimes< TimeType >( );
+        values.clear( );
+        values.reserve( numberOfEpochs_ );
+        for( unsigned int i = 0; i < numberOfEpochs_; i++ )
+        {
+            values.push_back( getConvertedValues< StateType >( i ) );
+        }
+    }
+
+    //! Function to retrieve the time history in the file as a map
+    /*!
+     *  Function to retrieve the time history in the file as a map, copying (and converting) all values (see
+     *  getHistoryVectors).
+     *  \return Time history in the file
+     */
+    template< typename TimeType, typename StateType >
+    std::map< TimeType, StateType > getHistory( ) const
+    {
+        std::map< TimeType, StateType > history;
+        for( unsigned int i = 0; i < numberOfEpochs_; i++ )
+        {
+            history[ getTime< TimeType >( i ) ] = getConvertedValues< StateType >( i );
+        }
+        return history;
+    }
+
+private:
+
+    //! Function to retrieve a pointer to the start of the record of a given epoch
+    const char* getRecordData( const unsigned int epochIndex ) const
+    {
+        if( epochIndex >= numberOfEpochs_ )
+        {
+            throw std::runtime_error( "Error when reading epoch " + std::to_string( epochIndex ) +
+                                      " from binary history file " + fileName_ + ", file has " +
+                                      std::to_string( numberOfEpochs_ ) + " epochs" );
+        }
+        return fileData_ + header_.dataOffset + epochIndex * header_.recordSize;
+    }
+
+    //! Function to check whether the value type in the file is equal to the requested type
+    template< typename ScalarType >
+    void checkValueDataType( ) const
+    {
+        if( getBinaryHistoryDataType< ScalarType >( ) != header_.valueDataType )
+        {
+            throw std::runtime_error( "Error when reading binary history file " + fileName_ + ", values are stored as " +
+                                      getBinaryHistoryDataTypeName( header_.valueDataType ) + ", but requested as " +
+                                      getBinaryHistoryDataTypeName( getBinaryHistoryDataType< ScalarType >( ) ) );
+        }
+    }
+
+    //! Function to retrieve the values at a given epoch, converted to the requested (vector or matrix) type
+    template< typename StateType >
+    StateType getConvertedValues( const unsigned int epochIndex ) const
+    {
+        typedef typename StateType::Scalar ScalarType;
+        StateType values;
+        if( StateType::SizeAtCompileTime == Eigen::Dynamic )
+        {
+            values.resize( header_.numberOfColumns, 1 );
+        }
+        else if( StateType::SizeAtCompileTime != static_cast< int >( header_.numberOfColumns ) )
+        {
+            throw std::runtime_error( "Error when reading binary history file " + fileName_ + ", file has " +
+                                      std::to_string( header_.numberOfColumns ) + " columns, but requested " +
+                                      std::to_string( StateType::SizeAtCompileTime ) );
+        }
+
+        const char* valueData = getRecordData( epochIndex ) + header_.valueOffset;
+        if( header_.valueDataType == double_history_data )
+        {
+            values = Eigen::Map< const Eigen::Matrix< double, StateType::RowsAtCompileTime, StateType::ColsAtCompileTime > >(
+                        reinterpret_cast< const double* >( valueData ), values.rows( ), values.cols( ) ).
+                    template cast< ScalarType >( );
+        }
+        else
+        {
+            values = Eigen::Map< const Eigen::Matrix< long double, StateType::RowsAtCompileTime,
+                    StateType::ColsAtCompileTime > >(
+                        reinterpret_cast< const long double* >( valueData ), values.rows( ), values.cols( ) ).
+                    template cast< ScalarType >( );
+        }
+        return values;
+    }
+
+    //! Name of the file
+    std::string fileName_;
+
+    //! Mapping of the file
+    boost::interprocess::file_mapping fileMapping_;
+
+    //! Mapped view of the full file
+    boost::interprocess::mapped_region mappedRegion_;
+
+    //! Pointer to start of the mapped file data
+    const char* fileData_;
+
+    //! Header of the file
+    BinaryHistoryFileHeader header_;
+
+    //! Number of (complete) epochs in the file
+    unsigned int numberOfEpochs_;
+};
+
+//! Function to create a Lagrange interpolator that reads the values directly from a binary history file
+/*!
+ *  Function to create a Lagrange interpolator of (a block of consecutive columns of) the values in a binary history file,
+ *  which reads the values directly from the memory-mapped file data through a StridedLagrangeInterpolator, so that only
+ *  the times are copied (and converted to the requested time type). The interpolator keeps the file reader (and its
+ *  mapping of the file) alive. The times in the file must be strictly ascending or strictly descending (e.g. for a backward
+ *  propagation), and the scalar type must be equal to the value type in the file.
+ *  \param fileReader Reader of the binary history file
+ *  \param numberOfStages Number of data points that are used to construct each interpolant (must be even)
+ *  \param startColumn Index of first column of the file that is interpolated (default 0)
+ *  \return Interpolator of NumberOfRows columns of the file, starting at startColumn
+ */
+template< typename TimeType, typename ScalarType, int NumberOfRows, typename InterpolationScalarType = TimeType >
+std::shared_ptr< interpolators::StridedLagrangeInterpolator< TimeType, ScalarType, NumberOfRows, InterpolationScalarType > >
+createLagrangeInterpolatorFromBinaryHistoryFile(
+        const std::shared_ptr< const BinaryHistoryFileReader > fileReader,
+        const int numberOfStages,
+        const unsigned int startColumn = 0 )
+{
+    if( fileReader->getNumberOfColumns( ) < startColumn + NumberOfRows )
+    {
+        throw std::runtime_error( "Error when creating interpolator from binary history file, file has " +
+                                  std::to_string( fileReader->getNumberOfColumns( ) ) + " columns, but " +
+                                  std::to_string( NumberOfRows ) + " requested, starting at column " +
+                                  std::to_string( startColumn ) );
+    }
+
+    std::vector< TimeType > times = fileReader->template getTimes< TimeType >( );
+    auto valueBlock = fileReader->template getValueBlock< ScalarType >( );
+    const ScalarType* dataPointer = valueBlock.data( ) + startColumn;
+    Eigen::Index entryStride = valueBlock.outerStride( );
+
+    // Read descending history (e.g. from backward propagation) in reverse order
+    if( times.size( ) > 1 && times.at( 1 ) < times.at( 0 ) )
+    {
+        std::reverse( times.begin( ), times.end( ) );
+        dataPointer += static_cast< Eigen::Index >( times.size( ) - 1 ) * entryStride;
+        entryStride = -entryStride;
+    }
+
+    return std::make_shared< interpolators::StridedLagrangeInterpolator<
+            TimeType, ScalarType, NumberOfRows, InterpolationScalarType > >(
+                times, dataPointer, entryStride, numberOfStages, fileReader );
+}
+
+} // namespace input_output
+
+} // namespace tudat
+
+#endif // TUDAT_BINARYHISTORYFILE_H
@@ -15,6 +15,7 @@
 #include "basic/basicMathematicsFunctions.h"
 #include "basic/convergenceException.h"
 #include "basic/coordinateConversions.h"
+#include "basic/dualNumber.h"
 #include "basic/function.h"
 #include "basic/functionProxy.h"
 #include "basic/leastSquaresEstimation.h"
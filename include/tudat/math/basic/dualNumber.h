@@ -0,0 +1,557 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Griewank, A. and Walther, A., "Evaluating Derivatives: Principles and Techniques of Algorithmic
+ *          Differentiation", 2nd edition, SIAM, 2008.
+ *
+ */
+
+#ifndef TUDAT_DUAL_NUMBER_H
+#define TUDAT_DUAL_NUMBER_H
+
+#include <cmath>
+#include <iostream>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace automatic_differentiation
+{
+
+//! Scalar type for forward-mode automatic differentiation w.r.t. a fixed number of independent variables.
+/*!
+ *  Scalar type for forward-mode automatic differentiation w.r.t. a fixed number of independent variables (the seed width),
+ *  consisting of a value and the vector of its partial derivatives w.r.t. the independent variables (Griewank and Walther,
+ *  2008). All arithmetic operations and the mathematical functions defined below propagate the partial derivatives by the
+ *  chain rule, so that a function templated on its scalar type, and evaluated with this type, returns its value and exact
+ *  (to round-off) Jacobian in a single evaluation. The type can be used as scalar type of Eigen matrices (see NumTraits
+ *  specialization below). Comparison operators compare values only, so that branches are evaluated as for the value.
+ */
+template< int NumberOfDerivatives >
+class DualNumber
+{
+public:
+
+    //! Typedef for vector of partial derivatives.
+    typedef Eigen::Matrix< double, NumberOfDerivatives, 1, Eigen::DontAlign > DerivativeVector;
+
+    //! Constructor for constant (all partial derivatives zero).
+    /*!
+     *  Constructor for constant (all partial derivatives zero).
+     *  \param value Value of number
+     */
+    DualNumber( const double value = 0.0 ):
+        value_( value ), derivatives_( DerivativeVector::Zero( ) ){ }
+
+    //! Constructor for given value and partial derivatives.
+    /*!
+     *  Constructor for given value and partial derivatives.
+     *  \param value Value of number
+     *  \param derivatives Partial derivatives of number w.r.t. independent variables
+     */
+    DualNumber( const double value, const DerivativeVector& derivatives ):
+        value_( value ), derivatives_( derivatives ){ }
+
+    //! Constructor for independent variable.
+    /*!
+     *  Constructor for independent variable, for which the partial derivative w.r.t. itself is one, and all other partial
+     *  derivatives are zero.
+     *  \param value Value of number
+     *  \param derivativeIndex Index of independent variable
+     */
+    DualNumber( const double value, const int derivativeIndex ):
+        value_( value ), derivatives_( DerivativeVector::Unit( derivativeIndex ) ){ }
+
+    //! Function to retrieve value of number.
+    /*!
+     *  Function to retrieve value of number.
+     *  \return Value of number.
+     */
+    double getValue( ) const
+    {
+        return value_;
+    }
+
+    //! Function to retrieve partial derivatives of number w.r.t. independent variables.
+    /*!
+     *  Function to retrieve partial derivatives of number w.r.t. independent variables.
+     *  \return Partial derivatives of number w.r.t. independent variables.
+     */
+    const DerivativeVector& getDerivatives( ) const
+    {
+        return derivatives_;
+    }
+
+    DualNumber& operator+=( const DualNumber& other )
+    {
+        value_ += other.value_;
+        derivatives_ += other.derivatives_;
+        return *this;
+    }
+
+    DualNumber& operator-=( const DualNumber& other )
+    {
+        value_ -= other.value_;
+        derivatives_ -= other.derivatives_;
+        return *this;
+    }
+
+    DualNumber& operator*=( const DualNumber& other )
+    {
+        derivatives_ = derivatives_ * other.value_ + other.derivatives_ * value_;
+        value_ *= other.value_;
+        return *this;
+    }
+
+    DualNumber& operator/=( const DualNumber& other )
+    {
+        double inverseOtherValue = 1.0 / other.value_;
+        value_ *= inverseOtherValue;
+        derivatives_ = ( derivatives_ - other.derivatives_ * value_ ) * inverseOtherValue;
+        return *this;
+    }
+
+    DualNumber& operator+=( const double other )
+    {
+        value_ += other;
+        return *this;
+    }
+
+    DualNumber& operator-=( const double other )
+    {
+        value_ -= other;
+        return *this;
+    }
+
+    DualNumber& operator*=( const double other )
+    {
+        value_ *= other;
+        derivatives_ *= other;
+        return *this;
+    }
+
+    DualNumber& operator/=( const double other )
+    {
+        value_ /= other;
+        derivatives_ /= other;
+        return *this;
+    }
+
+    DualNumber operator-( ) const
+    {
+        return DualNumber( -value_, -derivatives_ );
+    }
+
+    DualNumber operator+( ) const
+    {
+        return *this;
+    }
+
+private:
+
+    //! Value of number.
+    double value_;
+
+    //! Partial derivatives of number w.r.t. independent variables.
+    DerivativeVector derivatives_;
+};
+
+//! Typedef for dual number with derivatives w.r.t. a Cartesian state.
+typedef DualNumber< 6 > StateDualNumber;
+
+template< int N >
+DualNumber< N > operator+( DualNumber< N > first, const DualNumber< N >& second ){ return first += second; }
+
+template< int N >
+DualNumber< N > operator+( DualNumber< N > first, const double second ){ return first += second; }
+
+template< int N >
+DualNumber< N > operator+( const double first, DualNumber< N > second ){ return second += first; }
+
+template< int N >
+DualNumber< N > operator-( DualNumber< N > first, const DualNumber< N >& second ){ return first -= second; }
+
+template< int N >
+DualNumber< N > operator-( DualNumber< N > first, const double second ){ return first -= second; }
+
+template< int N >
+DualNumber< N > operator-( const double first, const DualNumber< N >& second ){ return -second + first; }
+
+template< int N >
+DualNumber< N > operator*( DualNumber< N > first, const DualNumber< N >& second ){ return first *= second; }
+
+template< int N >
+DualNumber< N > operator*( DualNumber< N > first, const double second ){ return first *= second; }
+
+template< int N >
+DualNumber< N > operator*( const double first, DualNumber< N > second ){ return second *= first; }
+
+template< int N >
+DualNumber< N > operator/( DualNumber< N > first, const DualNumber< N >& second ){ return first /= second; }
+
+template< int N >
+DualNumber< N > operator/( DualNumber< N > first, const double second ){ return first /= second; }
+
+template< int N >
+DualNumber< N > operator/( const double first, const DualNumber< N >& second )
+{
+    double value = first / second.getValue( );
+    return DualNumber< N >( value, second.getDerivatives( ) * ( -value / second.getValue( ) ) );
+}
+
+template< int N >
+bool operator==( const DualNumber< N >& first, const DualNumber< N >& second ){ return first.getValue( ) == second.getValue( ); }
+
+template< int N >
+bool operator!=( const DualNumber< N >& first, const DualNumber< N >& second ){ return first.getValue( ) != second.getValue( ); }
+
+template< int N >
+bool operator<( const DualNumber< N >& first, const DualNumber< N >& second ){ return first.getValue( ) < second.getValue( ); }
+
+template< int N >
+bool operator>( const DualNumber< N >& first, const DualNumber< N >& second ){ return first.getValue( ) > second.getValue( ); }
+
+template< int N >
+bool operator<=( const DualNumber< N >& first, const DualNumber< N >& second ){ return first.getValue( ) <= second.getValue( ); }
+
+template< int N >
+bool operator>=( const DualNumber< N >& first, const DualNumber< N >& second ){ return first.getValue( ) >= second.getValue( ); }
+
+template< int N >
+bool operator==( const DualNumber< N >& first, const double second ){ return first.getValue( ) == second; }
+
+template< int N >
+bool operator!=( const DualNumber< N >& first, const double second ){ return first.getValue( ) != second; }
+
+template< int N >
+bool operator<( const DualNumber< N >& first, const double second ){ return first.getValue( ) < second; }
+
+template< int N >
+bool operator>( const DualNumber< N >& first, const double second ){ return first.getValue( ) > second; }
+
+template< int N >
+bool operator<=( const DualNumber< N >& first, const double second ){ return first.getValue( ) <= second; }
+
+template< int N >
+bool operator>=( const DualNumber< N >& first, const double second ){ return first.getValue( ) >= second; }
+
+template< int N >
+bool operator==( const double first, const DualNumber< N >& second ){ return first == second.getValue( ); }
+
+template< int N >
+bool operator!=( const double first, const DualNumber< N >& second ){ return first != second.getValue( ); }
+
+template< int N >
+bool operator<( const double first, const DualNumber< N >& second ){ return first < second.getValue( ); }
+
+template< int N >
+bool operator>( const double first, const DualNumber< N >& second ){ return first > second.getValue( ); }
+
+template< int N >
+bool operator<=( const double first, const DualNumber< N >& second ){ return first <= second.getValue( ); }
+
+template< int N >
+bool operator>=( const double first, const DualNumber< N >& second ){ return first >= second.getValue( ); }
+
+template< int N >
+std::ostream& operator<<( std::ostream& stream, const DualNumber< N >& number )
+{
+    stream << number.getValue( );
+    return stream;
+}
+
+//! Function to apply the chain rule to a scalar function, from its value and derivative at the value of the argument.
+template< int N >
+DualNumber< N > applyChainRule( const DualNumber< N >& argument, const double functionValue, const double functionDerivative )
+{
+    return DualNumber< N >( functionValue, argument.getDerivatives( ) * functionDerivative );
+}
+
+template< int N >
+DualNumber< N > sqrt( const DualNumber< N >& argument )
+{
+    double value = std::sqrt( argument.getValue( ) );
+    return applyChainRule( argument, value, 0.5 / value );
+}
+
+template< int N >
+DualNumber< N > cbrt( const DualNumber< N >& argument )
+{
+    double value = std::cbrt( argument.getValue( ) );
+    return applyChainRule( argument, value, 1.0 / ( 3.0 * value * value ) );
+}
+
+template< int N >
+DualNumber< N > exp( const DualNumber< N >& argument )
+{
+    double value = std::exp( argument.getValue( ) );
+    return applyChainRule( argument, value, value );
+}
+
+template< int N >
+DualNumber< N > log( const DualNumber< N >& argument )
+{
+    return applyChainRule( argument, std::log( argument.getValue( ) ), 1.0 / argument.getValue( ) );
+}
+
+template< int N >
+DualNumber< N > log10( const DualNumber< N >& argument )
+{
+    return applyChainRule( argument, std::log10( argument.getValue( ) ), 1.0 / ( argument.getValue( ) * std::log( 10.0 ) ) );
+}
+
+template< int N >
+DualNumber< N > sin( const DualNumber< N >& argument )
+{
+    return applyChainRule( argument, std::sin( argument.getValue( ) ), std::cos( argument.getValue( ) ) );
+}
+
+template< int N >
+DualNumber< N > cos( const DualNumber< N >& argument )
+{
+    return applyChainRule( argument, std::cos( argument.getValue( ) ), -std::sin( argument.getValue( ) ) );
+}
+
+template< int N >
+DualNumber< N > tan( const DualNumber< N >& argument )
+{
+    double value = std::tan( argument.getValue( ) );
+    return applyChainRule( argument, value, 1.0 + value * value );
+}
+
+template< int N >
+DualNumber< N > asin( const DualNumber< N >& argument )
+{
+    return applyChainRule( argument, std::asin( argument.getValue( ) ),
+                           1.0 / std::sqrt( 1.0 - argument.getValue( ) * argument.getValue( ) ) );
+}
+
+template< int N >
+DualNumber< N > acos( const DualNumber< N >& argument )
+{
+    return applyChainRule( argument, std::acos( argument.getValue( ) ),
+                           -1.0 / std::sqrt( 1.0 - argument.getValue( ) * argument.getValue( ) ) );
+}
+
+template< int N >
+DualNumber< N > atan( const DualNumber< N >& argument )
+{
+    return applyChainRule( argument, std::atan( argument.getValue( ) ),
+                           1.0 / ( 1.0 + argument.getValue( ) * argument.getValue( ) ) );
+}
+
+template< int N >
+DualNumber< N > atan2( const DualNumber< N >& y, const DualNumber< N >& x )
+{
+    double inverseSquaredRadius = 1.0 / ( x.getValue( ) * x.getValue( ) + y.getValue( ) * y.getValue( ) );
+    return DualNumber< N >( std::atan2( y.getValue( ), x.getValue( ) ),
+                            ( y.getDerivatives( ) * x.getValue( ) - x.getDerivatives( ) * y.getValue( ) ) *
+                            inverseSquaredRadius );
+}
+
+template< int N >
+DualNumber< N > sinh( const DualNumber< N >& argument )
+{
+    return applyChainRule( argument, std::sinh( argument.getValue( ) ), std::cosh( argument.getValue( ) ) );
+}
+
+template< int N >
+DualNumber< N > cosh( const DualNumber< N >& argument )
+{
+    return applyChainRule( argument, std::cosh( argument.getValue( ) ), std::sinh( argument.getValue( ) ) );
+}
+
+template< int N >
+DualNumber< N > tanh( const DualNumber< N >& argument )
+{
+    double value = std::tanh( argument.getValue( ) );
+    return applyChainRule( argument, value, 1.0 - value * value );
+}
+
+template< int N >
+DualNumber< N > abs( const DualNumber< N >& argument )
+{
+    return ( argument.getValue( ) < 0.0 ) ? -argument : argument;
+}
+
+template< int N >
+DualNumber< N > fabs( const DualNumber< N >& argument )
+{
+    return abs( argument );
+}
+
+template< int N >
+DualNumber< N > pow( const DualNumber< N >& base, const double exponent )
+{
+    double value = std::pow( base.getValue( ), exponent );
+    return applyChainRule( base, value, exponent * std::pow( base.getValue( ), exponent - 1.0 ) );
+}
+
+template< int N >
+DualNumber< N > pow( const DualNumber< N >& base, const DualNumber< N >& exponent )
+{
+    double value = std::pow( base.getValue( ), exponent.getValue( ) );
+    return DualNumber< N >(
+                value, base.getDerivatives( ) * ( exponent.getValue( ) * std::pow( base.getValue( ), exponent.getValue( ) - 1.0 ) ) +
+                exponent.getDerivatives( ) * ( value * std::log( base.getValue( ) ) ) );
+}
+
+template< int N >
+DualNumber< N > pow( const double base, const DualNumber< N >& exponent )
+{
+    double value = std::pow( base, exponent.getValue( ) );
+    return applyChainRule( exponent, value, value * std::log( base ) );
+}
+
+template< int N >
+bool isnan( const DualNumber< N >& argument )
+{
+    return std::isnan( argument.getValue( ) );
+}
+
+template< int N >
+bool isfinite( const DualNumber< N >& argument )
+{
+    return std::isfinite( argument.getValue( ) );
+}
+
+//! Function to retrieve the value of a double (for use in functions templated on scalar type).
+inline double getValue( const double number )
+{
+    return number;
+}
+
+//! Function to retrieve the value of a dual number (for use in functions templated on scalar type).
+template< int N >
+double getValue( const DualNumber< N >& number )
+{
+    return number.getValue( );
+}
+
+//! Function to create a vector of independent variables for automatic differentiation.
+/*!
+ *  Function to create a vector of independent variables for automatic differentiation, with the partial derivative of
+ *  each entry w.r.t. itself set to one.
+ *  \param values Values of independent variables.
+ *  \return Vector of independent variables, with seeded partial derivatives.
+ */
+template< int N >
+Eigen::Matrix< DualNumber< N >, N, 1 > createIndependentVariables( const Eigen::Matrix< double, N, 1 >& values )
+{
+    Eigen::Matrix< DualNumber< N >, N, 1 > independentVariables;
+    for( int i = 0; i < N; i++ )
+    {
+        independentVariables( i ) = DualNumber< N >( values( i ), i );
+    }
+    return independentVariables;
+}
+
+//! Function to retrieve the values of a vector of dual numbers.
+/*!
+ *  Function to retrieve the values of a vector of dual numbers.
+ *  \param dualVector Vector of dual numbers
+ *  \return Values of vector of dual numbers
+ */
+template< int N, int Rows >
+Eigen::Matrix< double, Rows, 1 > getValues( const Eigen::Matrix< DualNumber< N >, Rows, 1 >& dualVector )
+{
+    Eigen::Matrix< double, Rows, 1 > values( dualVector.rows( ) );
+    for( int i = 0; i < dualVector.rows( ); i++ )
+    {
+        values( i ) = dualVector( i ).getValue( );
+    }
+    return values;
+}
+
+//! Function to retrieve the Jacobian of a vector of dual numbers w.r.t. the independent variables.
+/*!
+ *  Function to retrieve the Jacobian of a vector of dual numbers w.r.t. the independent variables.
+ *  \param dualVector Vector of dual numbers
+ *  \return Jacobian of vector of dual numbers w.r.t. the independent variables (with row i the partial derivatives of
+ *  entry i).
+ */
+template< int N, int Rows >
+Eigen::Matrix< double, Rows, N > getJacobian( const Eigen::Matrix< DualNumber< N >, Rows, 1 >& dualVector )
+{
+    Eigen::Matrix< double, Rows, N > jacobian( dualVector.rows( ), N );
+    for( int i = 0; i < dualVector.rows( ); i++ )
+    {
+        jacobian.row( i ) = dualVector( i ).getDerivatives( ).transpose( );
+    }
+    return jacobian;
+}
+
+//! Function to compute the value and Jacobian of a vector function using forward-mode automatic differentiation.
+/*!
+ *  Function to compute the value and Jacobian of a vector function using forward-mode automatic differentiation, in a
+ *  single evaluation of the function with dual numbers.
+ *  \param function Function, with dual numbers as scalar type, of which the Jacobian is to be computed.
+ *  \param input Value of independent variables at which the Jacobian is to be computed.
+ *  \param value Value of function (returned by reference).
+ *  \param jacobian Jacobian of function w.r.t. input (returned by reference).
+ */
+template< int N, int Rows, typename FunctionType >
+void computeValueAndJacobian( const FunctionType& function,
+                              const Eigen::Matrix< double, N, 1 >& input,
+                              Eigen::Matrix< double, Rows, 1 >& value,
+                              Eigen::Matrix< double, Rows, N >& jacobian )
+{
+    Eigen::Matrix< DualNumber< N >, Rows, 1 > dualValue = function( createIndependentVariables< N >( input ) );
+    value = getValues( dualValue );
+    jacobian = getJacobian( dualValue );
+}
+
+} // namespace automatic_differentiation
+
+} // namespace tudat
+
+namespace Eigen
+{
+
+//! Specialization of Eigen numerical traits, to allow dual numbers as scalar type of Eigen matrices.
+template< int N >
+struct NumTraits< tudat::automatic_differentiation::DualNumber< N > >: NumTraits< double >
+{
+    typedef tudat::automatic_differentiation::DualNumber< N > Real;
+    typedef tudat::automatic_differentiation::DualNumber< N > NonInteger;
+    typedef tudat::automatic_differentiation::DualNumber< N > Nested;
+    typedef tudat::automatic_differentiation::DualNumber< N > Literal;
+
+    enum
+    {
+        IsComplex = 0,
+        IsInteger = 0,
+        IsSigned = 1,
+        RequireInitialization = 1,
+        ReadCost = N + 1,
+        AddCost = N + 1,
+        MulCost = 2 * N + 1
+    };
+};
+
+//! Specialization of Eigen scalar operation traits, to allow operations between dual numbers and doubles.
+template< int N, typename BinaryOperation >
+struct ScalarBinaryOpTraits< tudat::automatic_differentiation::DualNumber< N >, double, BinaryOperation >
+{
+    typedef tudat::automatic_differentiation::DualNumber< N > ReturnType;
+};
+
+//! Specialization of Eigen scalar operation traits, to allow operations between doubles and dual numbers.
+template< int N, typename BinaryOperation >
+struct ScalarBinaryOpTraits< double, tudat::automatic_differentiation::DualNumber< N >, BinaryOperation >
+{
+    typedef tudat::automatic_differentiation::DualNumber< N > ReturnType;
+};
+
+} // namespace Eigen
+
+#endif // TUDAT_DUAL_NUMBER_H
@@ -28,6 +28,14 @@ namespace tudat
 namespace linear_algebra
 {
 
+//! Enum defining the method by which the normal equations of a least squares problem are solved
+enum NormalEquationsSolutionMethod
+{
+    svd_normal_equations_solution,
+    cholesky_normal_equations_solution,
+    ldlt_normal_equations_solution
+};
+
 //! Function to get condition number of matrix (using SVD decomposition)
 /*!
  *  Function to get condition number of matrix (using SVD decomposition)
@@ -61,6 +69,28 @@ Eigen::VectorXd solveSystemOfEquationsWithSvd( const Eigen::MatrixXd matrixToInv
                                                const bool checkConditionNumber = 1,
                                                const double maximumAllowedConditionNumber = 1.0E-8 );
 
+//! Solve system of normal equations, using a given decomposition, checking condition number in the process
+/*!
+ * Solve system of normal equations, using a given decomposition, checking condition number in the process. This function
+ * solves A*x = b for the vector x. For the Cholesky (LLT) and LDLT decompositions, the condition number that is checked
+ * is the estimate of the (L1) condition number from the decomposition, and an exception is thrown if the decomposition
+ * fails (e.g. if the matrix is not positive definite for the Cholesky decomposition). Note that the Cholesky
+ * decomposition requires the matrix to be symmetric positive definite, and only uses its lower triangular part.
+ * \param matrixToInvert Matrix A that is to be inverted to solve the equation
+ * \param rightHandSideVector Vector on the righthandside of the matrix equation that is to be solved
+ * \param solutionMethod Decomposition that is to be used to solve the system of equations
+ * \param checkConditionNumber Boolean to denote whether the condition number is checked when estimating (warning is printed
+ * when value exceeds maximumAllowedConditionNumber)
+ * \param maximumAllowedConditionNumber Maximum value of the condition number of the covariance matrix that is allowed
+ * (warning printed when exceeded)
+ * \return Solution x of matrix equation A*x=b
+ */
+Eigen::VectorXd solveNormalEquations( const Eigen::MatrixXd& matrixToInvert,
+                                      const Eigen::VectorXd& rightHandSideVector,
+                                      const NormalEquationsSolutionMethod solutionMethod,
+                                      const bool checkConditionNumber = 1,
+                                      const double maximumAllowedConditionNumber = 1.0E8 );
+
 //! Function to multiply information matrix by diagonal weights matrix
 /*!
  * Function to multiply information matrix by diagonal weights matrix
@@ -100,6 +130,34 @@ Eigen::MatrixXd calculateInverseOfUpdatedCovarianceMatrix(
         const Eigen::MatrixXd& informationMatrix,
         const Eigen::VectorXd& diagonalOfWeightMatrix );
 
+//! Function to perform an iteration of least squares estimation from the normal equations and a priori information
+/*!
+ * Function to perform an iteration of least squares estimation from the normal equations (H^T*W*H and H^T*W*y, with H the
+ * information matrix, W the weights matrix and y the residuals), and a priori information. This function can be used when
+ * the normal equations have been accumulated directly (e.g. per block of observations), without the full information
+ * matrix being available.
+ * \param normalMatrix Normal matrix H^T*W*H (excluding a priori information)
+ * \param normalRightHandSide Right-hand side vector H^T*W*y of normal equations
+ * \param inverseOfAPrioriCovarianceMatrix Inverse of a priori covariance matrix
+ * \param solutionMethod Decomposition that is to be used to solve the normal equations. If constraints are provided, the
+ * resulting system is not positive definite, and a Cholesky decomposition is replaced by an LDLT decomposition.
+ * \param checkConditionNumber Boolean to denote whether the condition number is checked when estimating (warning is printed
+ * when value exceeds maximumAllowedConditionNumber)
+ * \param maximumAllowedConditionNumber Maximum value of the condition number of the covariance matrix that is allowed
+ * \param constraintMultiplier Multiplier for estimated parameter that defines linear constraint
+ * \param constraintRightHandside Right-hand side estimation linear constraint
+ * \return Pair containing: (first: parameter adjustment, second: inverse covariance)
+ */
+std::pair< Eigen::VectorXd, Eigen::MatrixXd > performLeastSquaresAdjustmentFromNormalEquations(
+        const Eigen::MatrixXd& normalMatrix,
+        const Eigen::VectorXd& normalRightHandSide,
+        const Eigen::MatrixXd& inverseOfAPrioriCovarianceMatrix,
+        const NormalEquationsSolutionMethod solutionMethod = svd_normal_equations_solution,
+        const bool checkConditionNumber = 1,
+        const double maximumAllowedConditionNumber = 1.0E8,
+        const Eigen::MatrixXd& constraintMultiplier = Eigen::MatrixXd( 0, 0 ),
+        const Eigen::VectorXd& constraintRightHandside = Eigen::VectorXd( 0 ) );
+
 //! Function to perform an iteration least squares estimation from information matrix, weights and residuals and a priori
 //! information
 /*!
@@ -117,6 +175,7 @@ Eigen::MatrixXd calculateInverseOfUpdatedCovarianceMatrix(
  * \param maximumAllowedConditionNumber Maximum value of the condition number of the covariance matrix that is allowed
  * \param constraintMultiplier Multiplier for estimated parameter that defines linear constraint
  * \param constraintRightHandside Right-hand side estimation linear constraint
+ * \param solutionMethod Decomposition that is to be used to solve the normal equations (SVD by default)
  * \return Pair containing: (first: parameter adjustment, second: inverse covariance)
  */
 std::pair< Eigen::VectorXd, Eigen::MatrixXd > performLeastSquaresAdjustmentFromInformationMatrix(
@@ -127,7 +186,8 @@ std::pair< Eigen::VectorXd, Eigen::MatrixXd > performLeastSquaresAdjustmentFromI
         const bool checkConditionNumber = 1,
         const double maximumAllowedConditionNumber = 1.0E8,
         const Eigen::MatrixXd& constraintMultiplier = Eigen::MatrixXd( 0, 0 ),
-        const Eigen::VectorXd& constraintRightHandside = Eigen::VectorXd( 0 ) );
+        const Eigen::VectorXd& constraintRightHandside = Eigen::VectorXd( 0 ),
+        const NormalEquationsSolutionMethod solutionMethod = svd_normal_equations_solution );
 
 //! Function to perform an iteration of least squares estimation from information matrix, weights and residuals
 /*!
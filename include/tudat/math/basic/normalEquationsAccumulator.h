@@ -0,0 +1,242 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_NORMALEQUATIONSACCUMULATOR_H
+#define TUDAT_NORMALEQUATIONSACCUMULATOR_H
+
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/math/basic/leastSquaresEstimation.h"
+
+namespace tudat
+{
+
+namespace linear_algebra
+{
+
+//! Class to accumulate the normal equations of a (weighted) least squares problem from blocks of observations
+/*!
+ *  Class to accumulate the normal equations H^T*W*H and H^T*W*y of a (weighted, with diagonal weights matrix W) least
+ *  squares problem, from blocks of rows of the information matrix H and associated residuals y. This allows a least
+ *  squares adjustment to be performed without the full information matrix being stored in memory. Optionally, sets of
+ *  'local' parameters (e.g. the initial states of a single arc in a multi-arc estimation) may be defined. Each row of the
+ *  information matrix may then only have non-zero partials w.r.t. one of these sets of local parameters (in addition to the
+ *  'global' parameters, which are all parameters not in any of the local sets). The normal matrix is then stored in
+ *  block-sparse form, and the local parameters are eliminated from the normal equations (by means of a Schur complement)
+ *  before solving for the global parameters, after which the local parameters are obtained by back-substitution.
+ */
+class NormalEquationsAccumulator
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param numberOfParameters Total number of estimated parameters (number of columns of information matrix)
+     *  \param localParameterBlocks List of sets of local parameters. Each entry defines a single set, as a list of
+     *  (start index, size) of parameter indices. By default, no local parameters are used, and the full normal matrix is
+     *  stored as a dense matrix.
+     */
+    NormalEquationsAccumulator(
+            const int numberOfParameters,
+            const std::vector< std::vector< std::pair< int, int > > >& localParameterBlocks =
+            std::vector< std::vector< std::pair< int, int > > >( ) );
+
+    //! Function to reset the accumulated normal equations to zero
+    void resetNormalEquations( );
+
+    //! Function to add the contribution of a block of observations to the normal equations
+    /*!
+     *  Function to add the contribution of a block of observations to the normal equations, as well as update the
+     *  maximum/minimum values of the partials (used for normalization of the normal equations).
+     *  \param partials Partial derivatives of the observations (rows) w.r.t. the estimated parameters (columns)
+     *  \param residuals Difference between measured and simulated observations
+     *  \param diagonalOfWeightMatrix Diagonal of observation weights matrix for current observations
+     */
+    void addObservations( const Eigen::MatrixXd& partials,
+                          const Eigen::VectorXd& residuals,
+                          const Eigen::VectorXd& diagonalOfWeightMatrix );
+
+    //! Function to retrieve the terms by which the parameters are normalized
+    /*!
+     *  Function to retrieve the terms by which the parameters are normalized, such that each column of the information
+     *  matrix (of all observations added to this object) is in the range [-1,1]. For each parameter, the value is the
+     *  partial with the largest absolute value (with its sign), or 1 if all partials are zero.
+     *  \return Terms by which the parameters are normalized
+     */
+    Eigen::VectorXd getParameterNormalization( );
+
+    //! Function to retrieve the full (dense) normal equations
+    /*!
+     *  Function to retrieve the full (dense) normal equations, with the parameters optionally normalized by a set of
+     *  normalization terms (i.e. the normal equations are computed as if each column of the information matrix is
+     *  divided by its normalization term).
+     *  \param normalMatrix Normal matrix H^T*W*H (returned by reference)
+     *  \param normalRightHandSide Right-hand side H^T*W*y of normal equations (returned by reference)
+     *  \param parameterNormalization Terms by which the parameters are normalized (none if size is zero)
+     */
+    void getNormalEquations( Eigen::MatrixXd& normalMatrix,
+                             Eigen::VectorXd& normalRightHandSide,
+                             const Eigen::VectorXd& parameterNormalization = Eigen::VectorXd( 0 ) );
+
+    //! Function to perform an iteration of least squares estimation from the accumulated normal equations
+    /*!
+     *  Function to perform an iteration of least squares estimation from the accumulated normal equations, including a priori
+     *  information. If local parameters are defined, the local parameters are eliminated from the normal equations by means of
+     *  a Schur complement. This is not possible when constraints are used, or when the a priori covariance correlates
+     *  different sets of local parameters, in which case the full normal equations are solved.
+     *  \param parameterNormalization Terms by which the parameters are normalized (none if size is zero)
+     *  \param inverseOfAPrioriCovarianceMatrix Inverse of a priori covariance matrix (of normalized parameters)
+     *  \param solutionMethod Decomposition that is to be used to solve the normal equations
+     *  \param checkConditionNumber Boolean to denote whether the condition number is checked when estimating (warning is
+     *  printed when value exceeds maximumAllowedConditionNumber)
+     *  \param maximumAllowedConditionNumber Maximum value of the condition number of the covariance matrix that is allowed
+     *  \param constraintMultiplier Multiplier for estimated parameter that defines linear constraint
+     *  \param constraintRightHandside Right-hand side estimation linear constraint
+     *  \return Pair containing: (first: (normalized) parameter adjustment, second: inverse (normalized) covariance)
+     */
+    std::pair< Eigen::VectorXd, Eigen::MatrixXd > performLeastSquaresAdjustment(
+            const Eigen::VectorXd& parameterNormalization,
+            const Eigen::MatrixXd& inverseOfAPrioriCovarianceMatrix,
+            const NormalEquationsSolutionMethod solutionMethod = svd_normal_equations_solution,
+            const bool checkConditionNumber = 1,
+            const double maximumAllowedConditionNumber = 1.0E8,
+            const Eigen::MatrixXd& constraintMultiplier = Eigen::MatrixXd( 0, 0 ),
+            const Eigen::VectorXd& constraintRightHandside = Eigen::VectorXd( 0 ) );
+
+    //! Function to retrieve the total number of estimated parameters
+    /*!
+     *  Function to retrieve the total number of estimated parameters
+     *  \return Total number of estimated parameters
+     */
+    int getNumberOfParameters( )
+    {
+        return numberOfParameters_;
+    }
+
+    //! Function to retrieve the number of observations (rows of information matrix) that have been added
+    /*!
+     *  Function to retrieve the number of observations (rows of information matrix) that have been added
+     *  \return Number of observations (rows of information matrix) that have been added
+     */
+    int getNumberOfObservations( )
+    {
+        return numberOfObservations_;
+    }
+
+    //! Function to retrieve the number of sets of local parameters
+    /*!
+     *  Function to retrieve the number of sets of local parameters
+     *  \return Number of sets of local parameters
+     */
+    int getNumberOfLocalParameterSets( )
+    {
+        return static_cast< int >( localParameterIndices_.size( ) );
+    }
+
+private:
+
+    //! Function to add the contribution of a range of rows, all with the same set of local parameters, to the normal equations
+    /*!
+     *  Function to add the contribution of a range of rows, all with the same set of local parameters, to the normal equations
+     *  \param partials Partial derivatives of the observations (rows) w.r.t. the estimated parameters (columns)
+     *  \param residuals Difference between measured and simulated observations
+     *  \param diagonalOfWeightMatrix Diagonal of observation weights matrix for current observations
+     *  \param startRow First row that is to be added
+     *  \param numberOfRows Number of rows that are to be added
+     *  \param localParameterSet Index of set of local parameters on which the rows depend (-1 if none)
+     */
+    void addObservationRows( const Eigen::MatrixXd& partials,
+                             const Eigen::VectorXd& residuals,
+                             const Eigen::VectorXd& diagonalOfWeightMatrix,
+                             const int startRow,
+                             const int numberOfRows,
+                             const int localParameterSet );
+
+    //! Function to retrieve the normalized normal equations in block form, including a priori information
+    /*!
+     *  Function to retrieve the normalized normal equations in block form, including a priori information
+     *  \param parameterNormalization Terms by which the parameters are normalized
+     *  \param inverseOfAPrioriCovarianceMatrix Inverse of a priori covariance matrix (of normalized parameters)
+     *  \param globalNormalMatrix Global-global block of normal matrix (returned by reference)
+     *  \param globalRightHandSide Global part of right-hand side of normal equations (returned by reference)
+     *  \param mixedNormalMatrices Global-local blocks of normal matrix, per set (returned by reference)
+     *  \param localNormalMatrices Local-local blocks of normal matrix, per set (returned by reference)
+     *  \param localRightHandSides Local parts of right-hand side of normal equations, per set (returned by reference)
+     *  \return True if the a priori information is compatible with the block form (i.e. does not correlate different
+     *  sets of local parameters), false otherwise.
+     */
+    bool getNormalizedBlockNormalEquations( const Eigen::VectorXd& parameterNormalization,
+                                            const Eigen::MatrixXd& inverseOfAPrioriCovarianceMatrix,
+                                            Eigen::MatrixXd& globalNormalMatrix,
+                                            Eigen::VectorXd& globalRightHandSide,
+                                            std::vector< Eigen::MatrixXd >& mixedNormalMatrices,
+                                            std::vector< Eigen::MatrixXd >& localNormalMatrices,
+                                            std::vector< Eigen::VectorXd >& localRightHandSides );
+
+    //! Total number of estimated parameters
+    int numberOfParameters_;
+
+    //! Number of observations (rows of information matrix) that have been added
+    int numberOfObservations_;
+
+    //! Indices of global parameters in full parameter vector
+    std::vector< int > globalParameterIndices_;
+
+    //! Indices of local parameters in full parameter vector, per set of local parameters
+    std::vector< std::vector< int > > localParameterIndices_;
+
+    //! Index of set of local parameters for each parameter (-1 for global parameters)
+    std::vector< int > localParameterSetPerParameter_;
+
+    //! Index of each parameter in the list of global parameters, or in its set of local parameters
+    std::vector< int > blockIndexPerParameter_;
+
+    //! Global-global block of normal matrix
+    Eigen::MatrixXd globalNormalMatrix_;
+
+    //! Global part of right-hand side of normal equations
+    Eigen::VectorXd globalRightHandSide_;
+
+    //! Global-local blocks of normal matrix, per set of local parameters
+    std::vector< Eigen::MatrixXd > mixedNormalMatrices_;
+
+    //! Local-local blocks of normal matrix, per set of local parameters
+    std::vector< Eigen::MatrixXd > localNormalMatrices_;
+
+    //! Local parts of right-hand side of normal equations, per set of local parameters
+    std::vector< Eigen::VectorXd > localRightHandSides_;
+
+    //! Minimum value of the partials w.r.t. each parameter
+    Eigen::VectorXd minimumPartials_;
+
+    //! Maximum value of the partials w.r.t. each parameter
+    Eigen::VectorXd maximumPartials_;
+
+    //! Scratch matrix for partials w.r.t. global parameters of current rows
+    Eigen::MatrixXd globalPartials_;
+
+    //! Scratch matrix for weighted partials w.r.t. global parameters of current rows
+    Eigen::MatrixXd weightedGlobalPartials_;
+
+    //! Scratch matrix for partials w.r.t. local parameters of current rows
+    Eigen::MatrixXd localPartials_;
+
+};
+
+} // namespace linear_algebra
+
+} // namespace tudat
+
+#endif // TUDAT_NORMALEQUATIONSACCUMULATOR_H
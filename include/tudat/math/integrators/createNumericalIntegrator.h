@@ -114,6 +114,24 @@ public:
      */
     bool assessTerminationOnMinorSteps_;
 
+    // Interval at which to save numerical integration result using dense output of the integrator.
+    /*
+     * Interval at which to save the numerical integrated states, using the dense output of the integrator. If set, the
+     * states are saved at integer multiples of this interval (as well as at the initial and final time), independently of
+     * the step size, and saveFrequency_ is not used. Only supported by variable step-size Runge-Kutta integrators. By
+     * default (NaN), the states are saved at the integration steps.
+     */
+    double denseOutputInterval_ = TUDAT_NAN;
+
+    // Whether the exact termination conditions are located using the dense output of the integrator.
+    /*
+     * Whether the exact final time/state of the propagation (for termination conditions with exact termination) are
+     * located using the dense output of the integrator, instead of by repeating the last integration step. Only supported
+     * by variable step-size Runge-Kutta integrators. Dense output is also used if denseOutputInterval_ is set, or if
+     * events are to be detected during the propagation.
+     */
+    bool locateTerminationUsingDenseOutput_ = false;
+
 };
 
 // Base class to define settings of variable step RK numerical integrator.
@@ -197,6 +197,56 @@ public:
      */
     virtual void setStepSizeControl( const bool useStepSizeControl ) { }
 
+    //! Function to toggle the use of dense output
+    /*!
+     * Function to toggle the use of dense output, i.e. the computation of the state at arbitrary values of the independent
+     * variable within the last integration step (see getDenseOutputState). To be implemented in derived classes that
+     * support dense output; throws an error otherwise.
+     * \param useDenseOutput Boolean denoting whether dense output is to be used
+     */
+    virtual void setUseDenseOutput( const bool useDenseOutput )
+    {
+        if( useDenseOutput )
+        {
+            throw std::runtime_error( "Error in numerical integrator, dense output is not implemented in this integrator" );
+        }
+    }
+
+    //! Function to retrieve whether dense output is used
+    /*!
+     * Function to retrieve whether dense output is used (see setUseDenseOutput).
+     * \return Boolean denoting whether dense output is used
+     */
+    virtual bool getUseDenseOutput( )
+    {
+        return false;
+    }
+
+    //! Function to evaluate the state derivative at the current independent variable and state
+    /*!
+     * Function to evaluate the state derivative at the current independent variable and state, such that any models
+     * updated by the state derivative function are set to the current state. Derived classes using dense output may
+     * store the result, so that it is not recomputed for the dense output or the next integration step.
+     * \return State derivative at the current independent variable and state
+     */
+    virtual StateDerivativeType evaluateCurrentStateDerivative( )
+    {
+        return stateDerivativeFunction_( getCurrentIndependentVariable( ), getCurrentState( ) );
+    }
+
+    //! Function to compute the state at a given value of the independent variable within the last integration step.
+    /*!
+     * Function to compute the state at a given value of the independent variable within the last integration step, by
+     * evaluating the interpolating polynomial of the integrator (dense output), which must be enabled using
+     * setUseDenseOutput. To be implemented in derived classes that support dense output; throws an error otherwise.
+     * \param independentVariable Value of the independent variable at which the state is to be computed
+     * \return State at the requested value of the independent variable
+     */
+    virtual StateType getDenseOutputState( const IndependentVariableType independentVariable )
+    {
+        throw std::runtime_error( "Error in numerical integrator, dense output is not implemented in this integrator" );
+    }
+
     //! Replace the state with a new value.
     /*!
      * Replace the state with a new value. This allows for discrete jumps in the state, often
@@ -9,6 +9,7 @@
  *
  *    References
  *      Burden, R.L., Faires, J.D. Numerical Analysis, 7th Edition, Books/Cole, 2001.
+ *      Hairer, E., Norsett, S.P., Wanner, G. Solving Ordinary Differential Equations I, 2nd Edition, Springer, 1993.
  *
  */
 
@@ -51,6 +52,30 @@ struct RungeKuttaCoefficients
     // Order estimate to integrate.
     OrderEstimateToIntegrate orderEstimateToIntegrate;
 
+    // Order of the dense output (0 if no dense output coefficients are defined).
+    unsigned int denseOutputOrder;
+
+    // Main table of the Butcher tableau of the additional stages used for the dense output.
+    /*
+     * Main table of the Butcher tableau of the additional stages used for the dense output, with one row per additional
+     * stage, and one column per preceding stage (regular stages followed by additional stages). The additional stages
+     * are only evaluated if the state within an accepted step is requested. The first additional stage is the state
+     * derivative at the end of the step (with the b-coefficients of the integrated estimate as row), which is reused as
+     * the first stage of the next step.
+     */
+    Eigen::MatrixXd denseOutputACoefficients;
+
+    // First column of the Butcher tableau of the additional stages used for the dense output.
+    Eigen::VectorXd denseOutputCCoefficients;
+
+    // Coefficients of the polynomial weights of the dense output.
+    /*
+     * Coefficients of the polynomial weights b_i( theta ) of the dense output, with one row per stage (regular stages
+     * followed by additional stages), and column j containing the coefficient of theta^( j + 1 ). The state at a
+     * fraction theta of a step h from state y_0 is y_0 + h sum_i b_i( theta ) k_i, with k_i the stage state derivatives.
+     */
+    Eigen::MatrixXd denseOutputBCoefficients;
+
     // Default constructor.
     /*
      * Default constructor that initializes coefficients to 0.
@@ -61,7 +86,8 @@ struct RungeKuttaCoefficients
         cCoefficients( ),
         higherOrder( 0 ),
         lowerOrder( 0 ),
-        orderEstimateToIntegrate( lower )
+        orderEstimateToIntegrate( lower ),
+        denseOutputOrder( 0 )
     { }
 
     // Constructor.
@@ -86,7 +112,8 @@ struct RungeKuttaCoefficients
         cCoefficients( cCoefficients_ ),
         higherOrder( higherOrder_ ),
         lowerOrder( lowerOrder_ ),
-        orderEstimateToIntegrate( order )
+        orderEstimateToIntegrate( order ),
+        denseOutputOrder( 0 )
     { }
 
     // Enum of predefined coefficient sets.
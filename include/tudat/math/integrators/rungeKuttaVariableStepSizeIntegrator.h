@@ -10,6 +10,7 @@
  *    References
  *      Burden, R.L., Faires, J.D. Numerical Analysis, 7th Edition, Books/Cole, 2001.
  *      Montenbruck, O., Gill, E. Satellite Orbits: Models, Methods, Applications, Springer, 2005.
+ *      Hairer, E., Norsett, S.P., Wanner, G. Solving Ordinary Differential Equations I, 2nd Edition, Springer, 1993.
  *
  */
 
@@ -19,6 +20,7 @@
 #include <boost/bind/bind.hpp>
 using namespace boost::placeholders;
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 
@@ -290,6 +292,7 @@ public:
 
         this->currentIndependentVariable_ = this->lastIndependentVariable_;
         this->currentState_ = this->lastState_;
+        isDenseOutputStepAvailable_ = false;
         return true;
     }
 
@@ -329,6 +332,7 @@ public:
         if ( !allowRollback )
         {
             this->lastIndependentVariable_ = currentIndependentVariable_;
+            isDenseOutputStepAvailable_ = false;
         }
     }
 
@@ -348,6 +352,7 @@ public:
         {
             this->lastIndependentVariable_ = currentIndependentVariable_;
         }
+        isDenseOutputStepAvailable_ = false;
     }
 
     //! Function to toggle the use of step-size control
@@ -360,8 +365,88 @@ public:
         useStepSizeControl_ = useStepSizeControl;
     }
 
+    //! Function to toggle the use of dense output
+    /*!
+     * Function to toggle the use of dense output. If used, the stages of the last accepted step are retained, and the
+     * state within that step is computed from the continuous extension of the Runge-Kutta method (see
+     * getDenseOutputState). The additional stages of the continuous extension are only evaluated when the state within
+     * a step is requested. The first additional stage is the state derivative at the end of the step, which is reused
+     * as the first stage of the next step (if the state has not been modified in between), so that the use of dense
+     * output only requires the evaluation of the remaining additional stages. Dense output is only available for
+     * coefficient sets for which dense output coefficients are defined (see RungeKuttaCoefficients).
+     * \param useDenseOutput Boolean denoting whether dense output is to be used
+     */
+    void setUseDenseOutput( const bool useDenseOutput )
+    {
+        if( useDenseOutput && coefficients_.denseOutputOrder == 0 )
+        {
+            throw std::runtime_error( "Error in RK integrator, dense output is not defined for this coefficient set" );
+        }
+        useDenseOutput_ = useDenseOutput;
+        isDenseOutputStepAvailable_ = false;
+        numberOfEvaluatedDenseOutputStages_ = 0;
+        denseOutputStageDerivatives_.resize( coefficients_.denseOutputCCoefficients.rows( ) );
+    }
+
+    //! Function to retrieve whether dense output is used
+    /*!
+     * Function to retrieve whether dense output is used (see setUseDenseOutput).
+     * \return Boolean denoting whether dense output is used
+     */
+    bool getUseDenseOutput( )
+    {
+        return useDenseOutput_;
+    }
+
+    //! Function to evaluate the state derivative at the current independent variable and state
+    /*!
+     * Function to evaluate the state derivative at the current independent variable and state, such that any models
+     * updated by the state derivative function are set to the current state. If dense output is used, and the current
+     * state is the (unmodified) state at the end of the last accepted step, the result is stored as the first
+     * additional stage of the continuous extension, and reused for the dense output and the next step.
+     * \return State derivative at the current independent variable and state
+     */
+    StateDerivativeType evaluateCurrentStateDerivative( )
+    {
+        StateDerivativeType currentStateDerivative =
+                this->stateDerivativeFunction_( currentIndependentVariable_, currentState_ );
+        if( useDenseOutput_ && isDenseOutputStepAvailable_ && numberOfEvaluatedDenseOutputStages_ == 0 &&
+                isCurrentStateDenseOutputStepEnd( ) )
+        {
+            denseOutputStageDerivatives_[ 0 ] = currentStateDerivative;
+            numberOfEvaluatedDenseOutputStages_ = 1;
+        }
+        return currentStateDerivative;
+    }
+
+    //! Function to compute the state at a given value of the independent variable within the last integration step.
+    /*!
+     * Function to compute the state at a given value of the independent variable within the last accepted integration
+     * step, using the continuous extension of the Runge-Kutta method (Hairer et al., 1993, Section II.6). The state at
+     * a fraction theta of the step is computed as y_0 + h sum_i b_i( theta ) k_i, from the state y_0 at the start of
+     * the step, the step size h, and the state derivatives k_i of the regular and additional stages of the step, with
+     * polynomial weights b_i( theta ). At the end of the step (theta = 1), this reproduces the state computed by the
+     * integration step, before any modification of the current state (e.g. by modifyCurrentState).
+     * \param independentVariable Value of the independent variable at which the state is to be computed
+     * \return State at the requested value of the independent variable
+     */
+    StateType getDenseOutputState( const IndependentVariableType independentVariable );
+
 protected:
 
+    //! Function to check whether the current state is the (unmodified) state at the end of the last accepted step
+    bool isCurrentStateDenseOutputStepEnd( )
+    {
+        return ( currentIndependentVariable_ == denseOutputStepEnd_ && currentState_ == denseOutputEndState_ );
+    }
+
+    //! Function to evaluate the additional stages of the continuous extension of the last accepted step
+    /*!
+     * Function to evaluate the additional stages of the continuous extension of the last accepted step (see
+     * RungeKuttaCoefficients::denseOutputACoefficients), if these have not yet been evaluated.
+     */
+    void evaluateDenseOutputStages( );
+
     //! Computes the next step size and validates the result.
     /*!
      * Computes the next step size based on a higher and lower order estimate, determines if the
@@ -499,11 +584,54 @@ protected:
      */
     std::vector< StateDerivativeType > currentStateDerivatives_;
 
+    //! Intermediate state at the current stage (member variable to prevent re-allocation on each stage).
+    StateType intermediateState_;
+
+    //! Lower order estimate of the state at the end of the current step (member variable to prevent re-allocation).
+    StateType lowerOrderEstimate_;
+
+    //! Higher order estimate of the state at the end of the current step (member variable to prevent re-allocation).
+    StateType higherOrderEstimate_;
+
     bool exceptionIfMinimumStepExceeded_;
 
     //! Boolean denoting whether step size control is to be used
     bool useStepSizeControl_;
 
+    //! Boolean denoting whether dense output is to be used
+    bool useDenseOutput_ = false;
+
+    //! Boolean denoting whether the stages of the last accepted step are available for the dense output
+    /*!
+     * Boolean denoting whether the stages of the last accepted step are available for the dense output. Set to false
+     * when a new step is started (overwriting the stages), when the state is rolled back, and when the state is modified
+     * without allowing roll-back.
+     */
+    bool isDenseOutputStepAvailable_ = false;
+
+    //! Independent variable at the start of the last accepted step (used for dense output)
+    IndependentVariableType denseOutputStepStart_;
+
+    //! Independent variable at the end of the last accepted step (used for dense output)
+    IndependentVariableType denseOutputStepEnd_;
+
+    //! Size of the last accepted step (used for dense output)
+    TimeStepType denseOutputStepSize_;
+
+    //! State computed by the last accepted step, before any modification of the current state (used for dense output)
+    StateType denseOutputEndState_;
+
+    //! State derivatives of the additional stages of the continuous extension of the last accepted step.
+    /*!
+     * State derivatives of the additional stages of the continuous extension of the last accepted step, of which only
+     * the first numberOfEvaluatedDenseOutputStages_ entries have been evaluated. The first entry is the state derivative
+     * at the end of the step, which is also used as the first stage of the next step.
+     */
+    std::vector< StateDerivativeType > denseOutputStageDerivatives_;
+
+    //! Number of additional stages of the continuous extension of the last accepted step that have been evaluated
+    int numberOfEvaluatedDenseOutputStages_ = 0;
+
 };
 
 extern template class RungeKuttaVariableStepSizeIntegrator < double, Eigen::VectorXd, Eigen::VectorXd >;
@@ -522,30 +650,45 @@ RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateD
         throw std::invalid_argument( "Error in RKF integrator, step size is NaN" );
     }
 
-    // Define and allocated vector for the number of stages.
-    currentStateDerivatives_.clear( );
-    currentStateDerivatives_.reserve( this->coefficients_.cCoefficients.rows( ) );
+    // Allocate state derivatives for the number of stages (only done on first step; entries are overwritten afterwards).
+    if( static_cast< int >( currentStateDerivatives_.size( ) ) != this->coefficients_.cCoefficients.rows( ) )
+    {
+        currentStateDerivatives_.resize( this->coefficients_.cCoefficients.rows( ) );
+    }
+
+    // Check if the state derivative at the end of the previous step can be reused as first stage (for dense output,
+    // this derivative is the first additional stage, which is only valid if the state has not been modified since).
+    const bool reuseFirstStage = useDenseOutput_ && numberOfEvaluatedDenseOutputStages_ > 0 &&
+            this->coefficients_.cCoefficients( 0 ) == 0.0 && isCurrentStateDenseOutputStepEnd( );
+    isDenseOutputStepAvailable_ = false;
 
-    // Define lower and higher order estimates.
-    StateType lowerOrderEstimate( this->currentState_ ), higherOrderEstimate( this->currentState_ );
+    // Initialize lower and higher order estimates (re-using member storage).
+    lowerOrderEstimate_ = this->currentState_;
+    higherOrderEstimate_ = this->currentState_;
 
     // Compute the k_i state derivatives per stage.
     for ( int stage = 0; stage < this->coefficients_.cCoefficients.rows( ); stage++ )
     {
         // Compute the intermediate state to pass to the state derivative for this stage.
-        StateType intermediateState( this->currentState_ );
-
-        // Compute the intermediate state.
+        intermediateState_ = this->currentState_;
         for ( int column = 0; column < stage; column++ )
         {
-            intermediateState += stepSize * this->coefficients_.aCoefficients( stage, column ) *
+            intermediateState_ += stepSize * this->coefficients_.aCoefficients( stage, column ) *
                     currentStateDerivatives_[ column ];
         }
 
-        // Compute the state derivative.
+        // Compute the state derivative (reusing the state derivative at the start of the step for dense output, if
+        // available).
         const IndependentVariableType time = this->currentIndependentVariable_ +
                 this->coefficients_.cCoefficients( stage ) * stepSize;
-        currentStateDerivatives_.push_back( this->stateDerivativeFunction_( time, intermediateState ) );
+        if( reuseFirstStage && stage == 0 )
+        {
+            currentStateDerivatives_[ stage ] = denseOutputStageDerivatives_[ 0 ];
+        }
+        else
+        {
+            currentStateDerivatives_[ stage ] = this->stateDerivativeFunction_( time, intermediateState_ );
+        }
 
         // Check if propagation should terminate because the propagation termination condition has been reached
         // while computing the intermediate state.
@@ -557,15 +700,15 @@ RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateD
         }
 
         // Update the estimate.
-        lowerOrderEstimate += this->coefficients_.bCoefficients( 0, stage ) * stepSize *
+        lowerOrderEstimate_ += this->coefficients_.bCoefficients( 0, stage ) * stepSize *
                 currentStateDerivatives_[ stage ];
-        higherOrderEstimate += this->coefficients_.bCoefficients( 1, stage ) * stepSize *
+        higherOrderEstimate_ += this->coefficients_.bCoefficients( 1, stage ) * stepSize *
                 currentStateDerivatives_[ stage ];
     }
 
     // Determine if the error was within bounds and compute a new step size.
-    if ( computeNextStepSizeAndValidateResult( lowerOrderEstimate,
-                                               higherOrderEstimate, stepSize ) )
+    if ( computeNextStepSizeAndValidateResult( lowerOrderEstimate_,
+                                               higherOrderEstimate_, stepSize ) )
     {
         // Accept the current step.
         this->lastIndependentVariable_ = this->currentIndependentVariable_;
@@ -575,16 +718,28 @@ RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateD
         switch ( this->coefficients_.orderEstimateToIntegrate )
         {
         case RungeKuttaCoefficients::lower:
-            this->currentState_ = lowerOrderEstimate;
-            return this->currentState_;
+            this->currentState_ = lowerOrderEstimate_;
+            break;
 
         case RungeKuttaCoefficients::higher:
-            this->currentState_ = higherOrderEstimate;
-            return this->currentState_;
+            this->currentState_ = higherOrderEstimate_;
+            break;
 
         default: // The default case will never occur because OrderEstimateToIntegrate is an enum.
             throw std::runtime_error( "Order estimate to integrate is invalid." );
         }
+
+        // Retain step for dense output (additional stages are evaluated when required)
+        if( useDenseOutput_ )
+        {
+            denseOutputStepStart_ = this->lastIndependentVariable_;
+            denseOutputStepEnd_ = this->currentIndependentVariable_;
+            denseOutputStepSize_ = stepSize;
+            denseOutputEndState_ = this->currentState_;
+            numberOfEvaluatedDenseOutputStages_ = 0;
+            isDenseOutputStepAvailable_ = true;
+        }
+        return this->currentState_;
     }
     else
     {
@@ -593,6 +748,102 @@ RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateD
     }
 }
 
+//! Compute the state at a given value of the independent variable within the last integration step.
+template< typename IndependentVariableType, typename StateType, typename StateDerivativeType, typename TimeStepType >
+StateType
+RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType >
+::getDenseOutputState( const IndependentVariableType independentVariable )
+{
+    if( !useDenseOutput_ )
+    {
+        throw std::runtime_error( "Error in RK integrator, dense output requested, but dense output is not used" );
+    }
+    else if( !isDenseOutputStepAvailable_ )
+    {
+        throw std::runtime_error( "Error in RK integrator, dense output requested, but no integration step is available" );
+    }
+
+    // Check if requested value is within last step
+    const TimeStepType normalizedOffset =
+            static_cast< TimeStepType >( independentVariable - denseOutputStepStart_ ) / denseOutputStepSize_;
+    if( normalizedOffset < -1.0E-12 || normalizedOffset > 1.0 + 1.0E-12 )
+    {
+        throw std::runtime_error( "Error in RK integrator, dense output requested outside of last integration step" );
+    }
+    else if( independentVariable == denseOutputStepEnd_ )
+    {
+        return denseOutputEndState_;
+    }
+    else if( independentVariable == denseOutputStepStart_ )
+    {
+        return this->lastState_;
+    }
+
+    evaluateDenseOutputStages( );
+
+    // Add contribution of each stage, with weight h b_i( theta ) evaluated using Horner's scheme
+    const int numberOfStages = this->coefficients_.cCoefficients.rows( );
+    const int polynomialDegree = this->coefficients_.denseOutputBCoefficients.cols( );
+    StateType denseOutputState = this->lastState_;
+    for( int stage = 0; stage < this->coefficients_.denseOutputBCoefficients.rows( ); stage++ )
+    {
+        TimeStepType weight = this->coefficients_.denseOutputBCoefficients( stage, polynomialDegree - 1 );
+        for( int power = polynomialDegree - 2; power >= 0; power-- )
+        {
+            weight = weight * normalizedOffset + this->coefficients_.denseOutputBCoefficients( stage, power );
+        }
+        weight *= normalizedOffset * denseOutputStepSize_;
+
+        if( stage < numberOfStages )
+        {
+            denseOutputState += weight * currentStateDerivatives_[ stage ];
+        }
+        else
+        {
+            denseOutputState += weight * denseOutputStageDerivatives_[ stage - numberOfStages ];
+        }
+    }
+    return denseOutputState;
+}
+
+//! Evaluate the additional stages of the continuous extension of the last accepted step.
+template< typename IndependentVariableType, typename StateType, typename StateDerivativeType, typename TimeStepType >
+void
+RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType >
+::evaluateDenseOutputStages( )
+{
+    const int numberOfStages = this->coefficients_.cCoefficients.rows( );
+    const int numberOfAdditionalStages = this->coefficients_.denseOutputCCoefficients.rows( );
+    for( int stage = numberOfEvaluatedDenseOutputStages_; stage < numberOfAdditionalStages; stage++ )
+    {
+        // The first additional stage is evaluated at the state computed by the step
+        if( stage == 0 )
+        {
+            denseOutputStageDerivatives_[ stage ] = this->stateDerivativeFunction_(
+                        denseOutputStepEnd_, denseOutputEndState_ );
+        }
+        else
+        {
+            intermediateState_ = this->lastState_;
+            for( int column = 0; column < numberOfStages; column++ )
+            {
+                intermediateState_ += denseOutputStepSize_ *
+                        this->coefficients_.denseOutputACoefficients( stage, column ) * currentStateDerivatives_[ column ];
+            }
+            for( int column = 0; column < stage; column++ )
+            {
+                intermediateState_ += denseOutputStepSize_ *
+                        this->coefficients_.denseOutputACoefficients( stage, numberOfStages + column ) *
+                        denseOutputStageDerivatives_[ column ];
+            }
+            denseOutputStageDerivatives_[ stage ] = this->stateDerivativeFunction_(
+                        denseOutputStepStart_ + this->coefficients_.denseOutputCCoefficients( stage ) *
+                        denseOutputStepSize_, intermediateState_ );
+        }
+        numberOfEvaluatedDenseOutputStages_ = stage + 1;
+    }
+}
+
 //! Compute the next step size and validate the result.
 template< typename IndependentVariableType, typename StateType, typename StateDerivativeType, typename TimeStepType >
 bool
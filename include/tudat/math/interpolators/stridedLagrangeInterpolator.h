@@ -0,0 +1,294 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      http://mathworld.wolfram.com/LagrangeInterpolatingPolynomial.html
+ *
+ */
+
+#ifndef TUDAT_STRIDEDLAGRANGEINTERPOLATOR_H
+#define TUDAT_STRIDEDLAGRANGEINTERPOLATOR_H
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/columnarHistory.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+
+#include "tudat/math/interpolators/oneDimensionalInterpolator.h"
+#include "tudat/math/interpolators/lookupScheme.h"
+
+namespace tudat
+{
+
+namespace interpolators
+{
+
+//! Class to perform Lagrange polynomial interpolation of vectors that are read from external, strided storage.
+/*!
+ *  Class to perform Lagrange polynomial interpolation of fixed-size vectors, where the dependent variable values are not
+ *  copied into the interpolator, but are read directly from externally owned storage, such as the contiguous buffer of a
+ *  utilities::ColumnarHistory or a memory-mapped binary history file. Entry i of the dependent variables consists of
+ *  NumberOfRows consecutive scalars, starting at dataPointer + i * entryStride. The stride may be negative, so that
+ *  storage that is sorted in decreasing order of time (e.g. from a backwards propagation) can be used without reordering.
+ *  The owner of the storage may be provided to the constructor, in which case it is kept alive for the lifetime of the
+ *  interpolator.
+ *
+ *  The independent variable values are copied, since they are required by the lookup scheme. Contrary to the
+ *  LagrangeInterpolator, the denominators of the interpolants are not pre-computed (which would require numberOfStages
+ *  scalars per data point), but are computed upon each call to interpolate. Near the edges of the domain, the interpolant
+ *  is constructed from the first (or last) numberOfStages data points, instead of being replaced by a cubic spline.
+ *  Since the dependent values are not stored in the dependentValues_ member, getDependentValues returns an empty vector.
+ *  \tparam IndependentVariableType Type of independent variable
+ *  \tparam ScalarType Scalar type of the dependent variable entries in the external storage
+ *  \tparam NumberOfRows Size of a single dependent variable entry
+ *  \tparam InterpolationScalarType Scalar type used to compute the interpolating polynomial
+ */
+template< typename IndependentVariableType, typename ScalarType, int NumberOfRows,
+          typename InterpolationScalarType = IndependentVariableType >
+class StridedLagrangeInterpolator : public OneDimensionalInterpolator< IndependentVariableType,
+        Eigen::Matrix< ScalarType, NumberOfRows, 1 > >
+{
+public:
+
+    //! Typedef for the dependent variable type.
+    typedef Eigen::Matrix< ScalarType, NumberOfRows, 1 > DependentVariableType;
+
+    //! Using statements to prevent having to put 'this' everywhere in the code.
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::independentValues_;
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::lookUpScheme_;
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::boundaryHandling_;
+
+    //! Constructor.
+    /*!
+     *  Constructor, sets the (copied) independent variable values and the view of the dependent variable values.
+     *  \param independentValues Vector of values of independent variables that are used, must be sorted in ascending
+     *  order.
+     *  \param dataPointer Pointer to the first scalar of the first dependent variable entry.
+     *  \param entryStride Number of scalars between the start of two subsequent dependent variable entries.
+     *  \param numberOfStages Number of data points that are used to construct each interpolant (must be even).
+     *  \param dataOwner Object that owns the storage pointed to by dataPointer, kept alive by the interpolator (default
+     *  none, in which case the user must ensure that the storage outlives the interpolator).
+     *  \param selectedLookupScheme Identifier of lookupscheme from which the nearest lower data point is found.
+     *  \param boundaryHandling Boundary handling method in case the independent variable is outside the specified range.
+     *  \param defaultExtrapolationValue Default value to be used for extrapolation, in case of use_default_value or
+     *  use_default_value_with_warning as methods for boundaryHandling.
+     */
+    StridedLagrangeInterpolator(
+            const std::vector< IndependentVariableType >& independentValues,
+            const ScalarType* dataPointer,
+            const Eigen::Index entryStride,
+            const int numberOfStages,
+            const std::shared_ptr< const void > dataOwner = nullptr,
+            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm,
+            const BoundaryInterpolationType boundaryHandling = extrapolate_at_boundary_with_warning,
+            const DependentVariableType& defaultExtrapolationValue =
+            IdentityElement::getAdditionIdentity< DependentVariableType >( ) ):
+        OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >(
+            boundaryHandling, defaultExtrapolationValue ),
+        dataPointer_( dataPointer ), entryStride_( entryStride ), numberOfStages_( numberOfStages ),
+        dataOwner_( dataOwner )
+    {
+        if( numberOfStages_ % 2 != 0 || numberOfStages_ < 2 )
+        {
+            throw std::runtime_error(
+                        "Error: strided Lagrange interpolator currently only handles even orders larger than 0." );
+        }
+
+        if( static_cast< int >( independentValues.size( ) ) < numberOfStages_ )
+        {
+            throw std::runtime_error(
+                        "Error: strided Lagrange interpolator has " + std::to_string( independentValues.size( ) ) +
+                        " data points, which is insufficient for requested order " + std::to_string( numberOfStages_ ) );
+        }
+
+        for( unsigned int i = 1; i < independentValues.size( ); i++ )
+        {
+            if( !( independentValues.at( i ) > independentValues.at( i - 1 ) ) )
+            {
+                throw std::runtime_error(
+                            "Error: strided Lagrange interpolator requires independent values in ascending order." );
+            }
+        }
+
+        independentValues_ = independentValues;
+        numberOfIndependentValues_ = static_cast< int >( independentValues_.size( ) );
+        offsetEntries_ = numberOfStages_ / 2 - 1;
+        independentVariableDifferenceCache_.resize( numberOfStages_ );
+
+        this->makeLookupScheme( selectedLookupScheme );
+    }
+
+    //! Destructor
+    ~StridedLagrangeInterpolator( ){ }
+
+    // Using statement to prevent compiler warning.
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::interpolate;
+
+    //! Function interpolates dependent variable value at given independent variable value.
+    /*!
+     *  Function interpolates dependent variable value at given independent variable value.
+     *  \param targetIndependentVariableValue Value of independent variable at which interpolation is to take place.
+     *  \return Interpolated value of dependent variable.
+     */
+    DependentVariableType interpolate( const IndependentVariableType targetIndependentVariableValue )
+    {
+        // Check whether boundary handling needs to be applied, if independent variable is beyond its defined range. The
+        // boundary values are handled here, since they are not stored in dependentValues_.
+        int isAtBoundary = this->checkInterpolationBoundary( targetIndependentVariableValue );
+        if( isAtBoundary != 0 &&
+                ( boundaryHandling_ == use_boundary_value || boundaryHandling_ == use_boundary_value_with_warning ) )
+        {
+            if( boundaryHandling_ == use_boundary_value_with_warning )
+            {
+                std::cerr << "Warning in strided Lagrange interpolator, requested independent variable value is outside "
+                             "the range of data points, taking boundary value instead." << std::endl;
+            }
+            return getEntry( isAtBoundary < 0 ? 0 : numberOfIndependentValues_ - 1 );
+        }
+
+        DependentVariableType interpolatedValue = DependentVariableType::Zero( );
+        bool useValue = false;
+        this->checkBoundaryCase( interpolatedValue, useValue, targetIndependentVariableValue );
+        if( useValue )
+        {
+            return interpolatedValue;
+        }
+
+        // Determine the first data point of the interpolant, shifting the stencil inwards near the edges of the domain.
+        int lowerEntry = lookUpScheme_->findNearestLowerNeighbour( targetIndependentVariableValue );
+        int firstEntry = std::min( std::max( lowerEntry - offsetEntries_, 0 ), numberOfIndependentValues_ - numberOfStages_ );
+
+        // Compute differences w.r.t. data points, and return data point if it coincides with the requested value.
+        for( int i = 0; i < numberOfStages_; i++ )
+        {
+            independentVariableDifferenceCache_[ i ] = static_cast< InterpolationScalarType >(
+                        targetIndependentVariableValue - independentValues_[ firstEntry + i ] );
+            if( independentVariableDifferenceCache_[ i ] ==
+                    mathematical_constants::getFloatingInteger< InterpolationScalarType >( 0 ) )
+            {
+                return getEntry( firstEntry + i );
+            }
+        }
+
+        // Evaluate interpolating polynomial at requested data point.
+        for( int i = 0; i < numberOfStages_; i++ )
+        {
+            InterpolationScalarType numerator = mathematical_constants::getFloatingInteger< InterpolationScalarType >( 1 );
+            InterpolationScalarType denominator = mathematical_constants::getFloatingInteger< InterpolationScalarType >( 1 );
+            for( int j = 0; j < numberOfStages_; j++ )
+            {
+                if( j != i )
+                {
+                    numerator *= independentVariableDifferenceCache_[ j ];
+                    denominator *= static_cast< InterpolationScalarType >(
+                                independentValues_[ firstEntry + i ] - independentValues_[ firstEntry + j ] );
+                }
+            }
+            interpolatedValue += getEntry( firstEntry + i ) * static_cast< ScalarType >( numerator / denominator );
+        }
+
+        return interpolatedValue;
+    }
+
+    //! Function to retrieve a view of a single dependent variable entry.
+    /*!
+     *  Function to retrieve a view of a single dependent variable entry in the external storage.
+     *  \param index Index of the entry that is to be retrieved.
+     *  \return View of the entry.
+     */
+    Eigen::Map< const DependentVariableType > getEntry( const int index ) const
+    {
+        return Eigen::Map< const DependentVariableType >( dataPointer_ + index * entryStride_ );
+    }
+
+    //! Function to retrieve the number of stages of interpolator
+    /*!
+     *  Function to retrieve the number of stages of interpolator
+     *  \return Number of stages of interpolator
+     */
+    int getNumberOfStages( )
+    {
+        return numberOfStages_;
+    }
+
+    InterpolatorTypes getInterpolatorType( ){ return lagrange_interpolator; }
+
+private:
+
+    //! Pointer to the first scalar of the first dependent variable entry.
+    const ScalarType* dataPointer_;
+
+    //! Number of scalars between the start of two subsequent dependent variable entries.
+    Eigen::Index entryStride_;
+
+    //! Number of data points that are used to construct each interpolant.
+    int numberOfStages_;
+
+    //! Object that owns the storage pointed to by dataPointer_ (may be nullptr).
+    std::shared_ptr< const void > dataOwner_;
+
+    //! Number of data points.
+    int numberOfIndependentValues_;
+
+    //! Number of data points before the nearest lower data point that are used in the interpolant.
+    int offsetEntries_;
+
+    //! Pre-allocated vector of differences between the requested independent variable and the data points.
+    std::vector< InterpolationScalarType > independentVariableDifferenceCache_;
+
+};
+
+//! Function to create a strided Lagrange interpolator that reads a segment of the entries of a columnar history.
+/*!
+ *  Function to create a strided Lagrange interpolator that reads a segment of NumberOfRows rows of the (single-column)
+ *  entries of a columnar history directly from its contiguous storage, without copying the data. The history is kept
+ *  alive by the interpolator, and must not be modified after calling this function. Histories that are sorted in
+ *  decreasing order of time (e.g. from a backwards propagation) are read in reverse order.
+ *  \param history History from which the interpolator is to be created.
+ *  \param startIndex Index in the history entries at which the interpolated segment starts.
+ *  \param numberOfStages Number of data points that are used to construct each interpolant.
+ *  \return Interpolator that reads the requested segment of the history entries.
+ */
+template< typename TimeType, typename ScalarType, int NumberOfRows, typename InterpolationScalarType = TimeType >
+std::shared_ptr< StridedLagrangeInterpolator< TimeType, ScalarType, NumberOfRows, InterpolationScalarType > >
+createStridedLagrangeInterpolatorFromHistory(
+        const std::shared_ptr< const utilities::ColumnarHistory< TimeType, ScalarType > > history,
+        const int startIndex,
+        const int numberOfStages )
+{
+    if( history->getNumberOfColumns( ) != 1 || history->getNumberOfRows( ) < startIndex + NumberOfRows )
+    {
+        throw std::runtime_error( "Error when creating interpolator from columnar history, entry size is incompatible" );
+    }
+
+    // Create view of entries in increasing order of time
+    std::vector< TimeType > times = history->getTimes( );
+    const ScalarType* dataPointer = history->getDataBlock( ).data( ) + startIndex;
+    Eigen::Index entryStride = static_cast< Eigen::Index >( history->getNumberOfRows( ) );
+    if( times.size( ) > 1 && times.at( 1 ) < times.at( 0 ) )
+    {
+        std::reverse( times.begin( ), times.end( ) );
+        dataPointer += static_cast< Eigen::Index >( times.size( ) - 1 ) * entryStride;
+        entryStride = -entryStride;
+    }
+
+    return std::make_shared< StridedLagrangeInterpolator< TimeType, ScalarType, NumberOfRows, InterpolationScalarType > >(
+                times, dataPointer, entryStride, numberOfStages, history );
+}
+
+} // namespace interpolators
+
+} // namespace tudat
+
+#endif // TUDAT_STRIDEDLAGRANGEINTERPOLATOR_H
@@ -20,6 +20,7 @@
 #include "tudat/astro/aerodynamics/atmosphereModel.h"
 #include "tudat/astro/aerodynamics/exponentialAtmosphere.h"
 #include "tudat/astro/aerodynamics/customConstantTemperatureAtmosphere.h"
+#include "tudat/astro/aerodynamics/densityGridCache.h"
 #include "tudat/astro/basic_astro/physicalConstants.h"
 #include "tudat/math/interpolators/interpolator.h"
 #include "tudat/basics/identityElements.h"
@@ -507,9 +508,14 @@ public:
      *  Constructor.
      *  \param spaceWeatherFile File containing space weather data, as in
      *  https://celestrak.com/SpaceData/sw19571001.txt
+     *  \param densityGridCacheSettings Settings for grid of precomputed densities, from which the density is interpolated
+     *  (nullptr if density is to be computed directly from the model).
      */
-    NRLMSISE00AtmosphereSettings( const std::string& spaceWeatherFile ):
-        AtmosphereSettings( nrlmsise00 ), spaceWeatherFile_( spaceWeatherFile ){ }
+    NRLMSISE00AtmosphereSettings( const std::string& spaceWeatherFile,
+                                  const std::shared_ptr< aerodynamics::DensityGridCacheSettings > densityGridCacheSettings =
+            nullptr ):
+        AtmosphereSettings( nrlmsise00 ), spaceWeatherFile_( spaceWeatherFile ),
+        densityGridCacheSettings_( densityGridCacheSettings ){ }
 
     //  Function to return file containing space weather data.
     /* 
@@ -518,6 +524,27 @@ public:
      */
     std::string getSpaceWeatherFile( ){ return spaceWeatherFile_; }
 
+    //  Function to return settings for grid of precomputed densities.
+    /*
+     *  Function to return settings for grid of precomputed densities.
+     *  \return Settings for grid of precomputed densities (nullptr if none).
+     */
+    std::shared_ptr< aerodynamics::DensityGridCacheSettings > getDensityGridCacheSettings( )
+    {
+        return densityGridCacheSettings_;
+    }
+
+    //  Function to reset settings for grid of precomputed densities.
+    /*
+     *  Function to reset settings for grid of precomputed densities.
+     *  \param densityGridCacheSettings Settings for grid of precomputed densities (nullptr if none).
+     */
+    void setDensityGridCacheSettings(
+            const std::shared_ptr< aerodynamics::DensityGridCacheSettings > densityGridCacheSettings )
+    {
+        densityGridCacheSettings_ = densityGridCacheSettings;
+    }
+
 private:
 
     //  File containing space weather data.
@@ -525,6 +552,9 @@ private:
      *  File containing space weather data, as in https://celestrak.com/SpaceData/sw19571001.txt
      */
     std::string spaceWeatherFile_;
+
+    //  Settings for grid of precomputed densities (nullptr if none).
+    std::shared_ptr< aerodynamics::DensityGridCacheSettings > densityGridCacheSettings_;
 };
 
 
@@ -931,9 +961,10 @@ inline std::shared_ptr< AtmosphereSettings > exponentialAtmosphereSettings(
 
 //! @get_docstring(nrlmsise00AtmosphereSettings)
 inline std::shared_ptr< AtmosphereSettings > nrlmsise00AtmosphereSettings(
-        const std::string dataFile = paths::getSpaceWeatherDataPath( ) + "/sw19571001.txt" )
+        const std::string dataFile = paths::getSpaceWeatherDataPath( ) + "/sw19571001.txt",
+        const std::shared_ptr< aerodynamics::DensityGridCacheSettings > densityGridCacheSettings = nullptr )
 {
-    return std::make_shared< NRLMSISE00AtmosphereSettings >( dataFile );
+    return std::make_shared< NRLMSISE00AtmosphereSettings >( dataFile, densityGridCacheSettings );
 }
 
 typedef std::function< double( const double, const double, const double, const double ) > DensityFunction;
@@ -262,7 +262,9 @@ public:
         RotationModelSettings( gcrs_to_itrs_rotation_model, baseFrameName, "ITRS" ),
         inputTimeScale_( inputTimeScale ), nutationTheory_( nutationTheory ), eopFile_( eopFile ),
         eopFileFormat_( "C04" ), ut1CorrectionSettings_( ut1CorrectionSettings ),
-        polarMotionCorrectionSettings_( polarMotionCorrectionSettings ){ }
+        polarMotionCorrectionSettings_( polarMotionCorrectionSettings ),
+        tabulateEarthOrientationAngles_( false ), tabulationStartTime_( TUDAT_NAN ), tabulationEndTime_( TUDAT_NAN ),
+        tabulationTimeStep_( TUDAT_NAN ), numberOfInterpolationPoints_( 8 ){ }
 
     //Destructor
     ~GcrsToItrsRotationModelSettings( ){ }
@@ -326,6 +328,57 @@ public:
         return polarMotionCorrectionSettings_;
     }
 
+    //Function to set the rotation model to use tabulated (interpolated) earth orientation angles
+    /*
+     * Function to set the rotation model to use earth orientation angles that are tabulated over a given interval and
+     * interpolated, instead of computing the IAU precession-nutation (and other) series for each time (see
+     * TabulatedEarthOrientationAnglesCalculator). The input time scale must be TDB, TT or TAI.
+     * \param tabulationStartTime Start of time interval over which the angles are tabulated
+     * \param tabulationEndTime End of time interval over which the angles are tabulated
+     * \param tabulationTimeStep Time step between tabulated values
+     * \param numberOfInterpolationPoints Number of points used for the Lagrange interpolation
+     */
+    void setTabulatedEarthOrientationAngles(
+            const double tabulationStartTime, const double tabulationEndTime, const double tabulationTimeStep = 3600.0,
+            const int numberOfInterpolationPoints = 8 )
+    {
+        tabulateEarthOrientationAngles_ = true;
+        tabulationStartTime_ = tabulationStartTime;
+        tabulationEndTime_ = tabulationEndTime;
+        tabulationTimeStep_ = tabulationTimeStep;
+        numberOfInterpolationPoints_ = numberOfInterpolationPoints;
+    }
+
+    //Function to retrieve whether the rotation model uses tabulated earth orientation angles
+    bool getTabulateEarthOrientationAngles( )
+    {
+        return tabulateEarthOrientationAngles_;
+    }
+
+    //Function to retrieve the start of time interval over which the angles are tabulated
+    double getTabulationStartTime( )
+    {
+        return tabulationStartTime_;
+    }
+
+    //Function to retrieve the end of time interval over which the angles are tabulated
+    double getTabulationEndTime( )
+    {
+        return tabulationEndTime_;
+    }
+
+    //Function to retrieve the time step between tabulated values
+    double getTabulationTimeStep( )
+    {
+        return tabulationTimeStep_;
+    }
+
+    //Function to retrieve the number of points used for the Lagrange interpolation of tabulated values
+    int getNumberOfInterpolationPoints( )
+    {
+        return numberOfInterpolationPoints_;
+    }
+
 private:
 
     //Time scale in which input to the rotation model class is provided
@@ -346,6 +399,21 @@ private:
     //Settings for short-period polar motion variations
     std::shared_ptr< EopCorrectionSettings > polarMotionCorrectionSettings_;
 
+    //Boolean denoting whether the rotation model uses tabulated earth orientation angles
+    bool tabulateEarthOrientationAngles_;
+
+    //Start of time interval over which the angles are tabulated
+    double tabulationStartTime_;
+
+    //End of time interval over which the angles are tabulated
+    double tabulationEndTime_;
+
+    //Time step between tabulated values
+    double tabulationTimeStep_;
+
+    //Number of points used for the Lagrange interpolation of tabulated values
+    int numberOfInterpolationPoints_;
+
 };
 //#endif
 
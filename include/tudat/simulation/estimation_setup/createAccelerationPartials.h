@@ -28,6 +28,7 @@
 #include "tudat/astro/orbit_determination/acceleration_partials/directTidalDissipationAccelerationPartial.h"
 #include "tudat/astro/orbit_determination/acceleration_partials/panelledRadiationPressureAccelerationPartial.h"
 #include "tudat/astro/orbit_determination/acceleration_partials/thrustAccelerationPartial.h"
+#include "tudat/astro/orbit_determination/acceleration_partials/customAccelerationPartial.h"
 #include "tudat/astro/orbit_determination/observation_partials/rotationMatrixPartial.h"
 #include "tudat/simulation/estimation_setup/createCartesianStatePartials.h"
 #include "tudat/astro/basic_astro/accelerationModelTypes.h"
@@ -418,8 +419,27 @@ std::shared_ptr< acceleration_partials::AccelerationPartial > createAnalyticalAc
         break;
     }
     case custom_acceleration:
-        std::cerr<<"Warning, custom acceleration partials implicitly set to zero - depending on thrust guidance model, this may provide biased results for variational equations"<<std::endl;
+    {
+        // Check if identifier is consistent with type.
+        std::shared_ptr< CustomAccelerationModel > customAcceleration =
+                std::dynamic_pointer_cast< CustomAccelerationModel >( accelerationModel );
+        if( customAcceleration == nullptr )
+        {
+            std::cerr << "Acceleration class type does not match acceleration type enum (custom) "
+                         "set when making acceleration partial." << std::endl;
+        }
+        else if( customAcceleration->isAccelerationDifferentiable( ) )
+        {
+            // Create partial-calculating object, using automatic differentiation of acceleration function.
+            accelerationPartial = std::make_shared< CustomAccelerationPartial >(
+                        customAcceleration, acceleratedBody.first, acceleratingBody.first );
+        }
+        else
+        {
+            std::cerr<<"Warning, custom acceleration partials implicitly set to zero - depending on thrust guidance model, this may provide biased results for variational equations"<<std::endl;
+        }
         break;
+    }
     case thrust_acceleration:
         std::cerr<<"Warning, thrust acceleration partials implicitly set to zero - depending on thrust guidance model, this may provide biased results for variational equations"<<std::endl;
         break;
@@ -17,6 +17,7 @@
 
 #include "tudat/io/basicInputOutput.h"
 #include "tudat/math/basic/leastSquaresEstimation.h"
+#include "tudat/math/basic/normalEquationsAccumulator.h"
 #include "tudat/astro/observation_models/observationManager.h"
 #include "tudat/astro/orbit_determination/podInputOutputTypes.h"
 #include "tudat/astro/orbit_determination/estimatable_parameters/initialTranslationalState.h"
@@ -315,6 +316,94 @@ public:
 
 
 
+    //! Function to calculate the residuals, and accumulate the normal equations, without storing the observation partials matrix
+    /*!
+     *  This function calculates the observation residuals, and accumulates the normal equations, based on the state transition
+     *  matrix, sensitivity matrix and body states resulting from the previous numerical integration iteration. Contrary to the
+     *  calculateObservationMatrixAndResiduals function, the full matrix of observation partials is never stored: the partials
+     *  are computed for blocks of at most maximumNumberOfObservationTimesPerBlock observation times, and directly added to the
+     *  normal equations.
+     *  \param observationsCollection Observable values and associated time tags, per observable type and set of link ends.
+     *  \param weightsMatrixDiagonals Diagonal of observation weights matrix
+     *  \param totalObservationSize Total number of observations in observationsCollection.
+     *  \param maximumNumberOfObservationTimesPerBlock Maximum number of observation times for which the partials are computed
+     *  in a single block
+     *  \param normalEquations Object in which the normal equations are accumulated (reset by this function)
+     *  \param residuals Residuals of computed w.r.t. input observable values (return by reference).
+     */
+    void calculateNormalEquationsAndResiduals(
+            const std::shared_ptr< observation_models::ObservationCollection< ObservationScalarType, TimeType > > observationsCollection,
+            const Eigen::VectorXd& weightsMatrixDiagonals,
+            const int totalObservationSize,
+            const int maximumNumberOfObservationTimesPerBlock,
+            linear_algebra::NormalEquationsAccumulator& normalEquations,
+            Eigen::VectorXd& residuals )
+    {
+        // Initialize return data.
+        normalEquations.resetNormalEquations( );
+        residuals = Eigen::VectorXd::Zero( totalObservationSize );
+
+        typename observation_models::ObservationCollection< ObservationScalarType, TimeType >::SortedObservationSets
+                sortedObservations = observationsCollection->getObservations( );
+
+        // Iterate over all observable types in observationsAndTimes
+        for( auto observablesIterator : sortedObservations )
+        {
+            observation_models::ObservableType currentObservableType = observablesIterator.first;
+
+            // Iterate over all link ends for current observable type in observationsAndTimes
+            for( auto dataIterator : observablesIterator.second )
+            {
+                observation_models::LinkEnds currentLinkEnds = dataIterator.first;
+                for( unsigned int i = 0; i < dataIterator.second.size( ); i++ )
+                {
+                    std::shared_ptr< observation_models::SingleObservationSet< ObservationScalarType, TimeType > > currentObservations =
+                            dataIterator.second.at( i );
+                    std::pair< int, int > observationIndices = observationsCollection->getObservationSetStartAndSize( ).at(
+                                currentObservableType ).at( currentLinkEnds ).at( i );
+
+                    std::vector< TimeType > observationTimes = currentObservations->getObservationTimes( );
+                    ObservationVectorType observationsVector = currentObservations->getObservationsVector( );
+                    if( observationTimes.size( ) == 0 )
+                    {
+                        continue;
+                    }
+                    const int observableSize = observationIndices.second / static_cast< int >( observationTimes.size( ) );
+
+                    // Compute residuals and partials per block of observation times, and add to normal equations
+                    for( unsigned int blockStart = 0; blockStart < observationTimes.size( );
+                         blockStart += maximumNumberOfObservationTimesPerBlock )
+                    {
+                        const unsigned int blockEnd = std::min< unsigned int >(
+                                    blockStart + maximumNumberOfObservationTimesPerBlock, observationTimes.size( ) );
+                        std::vector< TimeType > currentObservationTimes(
+                                    observationTimes.begin( ) + blockStart, observationTimes.begin( ) + blockEnd );
+
+                        std::pair< ObservationVectorType, Eigen::MatrixXd > observationsWithPartials =
+                                observationManagers_[ currentObservableType ]->computeObservationsWithPartials(
+                                    currentObservationTimes, currentLinkEnds, currentObservations->getReferenceLinkEnd( ) );
+
+                        const int blockStartIndex = observationIndices.first + blockStart * observableSize;
+                        const int blockSize = ( blockEnd - blockStart ) * observableSize;
+                        residuals.segment( blockStartIndex, blockSize ) =
+                                ( observationsVector.segment( blockStart * observableSize, blockSize ) -
+                                  observationsWithPartials.first ).template cast< double >( );
+
+                        normalEquations.addObservations(
+                                    observationsWithPartials.second, residuals.segment( blockStartIndex, blockSize ),
+                                    weightsMatrixDiagonals.segment( blockStartIndex, blockSize ) );
+                    }
+                }
+            }
+
+            std::pair< int, int > observableStartAndSize = observationsCollection->getObservationTypeStartAndSize( ).at( currentObservableType );
+
+            observation_models::checkObservationResidualDiscontinuities(
+                        residuals.block( observableStartAndSize.first, 0, observableStartAndSize.second, 1 ),
+                        currentObservableType );
+        }
+    }
+
     //! Function to normalize the matrix of partial derivatives so that each column is in the range [-1,1]
     /*!
      * Function to normalize the matrix of partial derivatives so that each column is in the range [-1,1]
@@ -404,7 +493,8 @@ public:
         ParameterVectorType bestParameterEstimate = ParameterVectorType::Constant( parameterVectorSize, TUDAT_NAN );
         Eigen::VectorXd bestTransformationData = Eigen::VectorXd::Constant( parameterVectorSize, TUDAT_NAN );
         Eigen::VectorXd bestResiduals = Eigen::VectorXd::Constant( totalNumberOfObservations, TUDAT_NAN );
-        Eigen::MatrixXd bestInformationMatrix = Eigen::MatrixXd::Constant( totalNumberOfObservations, parameterVectorSize, TUDAT_NAN );
+        Eigen::MatrixXd bestInformationMatrix = Eigen::MatrixXd::Constant(
+                    podInput->getAccumulateNormalEquations( ) ? 0 : totalNumberOfObservations, parameterVectorSize, TUDAT_NAN );
         Eigen::VectorXd bestWeightsMatrixDiagonal = Eigen::VectorXd::Constant( totalNumberOfObservations, TUDAT_NAN );
         Eigen::MatrixXd bestInverseNormalizedCovarianceMatrix = Eigen::MatrixXd::Constant( parameterVectorSize, parameterVectorSize, TUDAT_NAN );
 
@@ -426,6 +516,19 @@ public:
 
         int numberOfEstimatedParameters = parameterVectorSize;
 
+        // Create object to accumulate normal equations, if required
+        std::shared_ptr< linear_algebra::NormalEquationsAccumulator > normalEquations;
+        if( podInput->getAccumulateNormalEquations( ) )
+        {
+            std::vector< std::vector< std::pair< int, int > > > localParameterIndices;
+            if( podInput->getReduceArcWiseInitialStates( ) )
+            {
+                localParameterIndices = estimatable_parameters::getArcWiseInitialStateParameterIndices( parametersToEstimate_ );
+            }
+            normalEquations = std::make_shared< linear_algebra::NormalEquationsAccumulator >(
+                        parameterVectorSize, localParameterIndices );
+        }
+
         bool exceptionDuringPropagation = false, exceptionDuringInversion = false;
         // Iterate until convergence (at least once)
         int numberOfIterations = 0;
@@ -485,12 +588,23 @@ public:
             {
                 std::cout << "Calculating residuals and partials " << totalNumberOfObservations << std::endl;
             }
-            // Calculate residuals and observation matrix for current parameter estimate.
+            // Calculate residuals and observation matrix (or normal equations) for current parameter estimate.
             std::pair< Eigen::VectorXd, Eigen::MatrixXd > residualsAndPartials;
-            calculateObservationMatrixAndResiduals(
-                        podInput->getObservationCollection( ), parameterVectorSize, totalNumberOfObservations, residualsAndPartials );
-
-            Eigen::VectorXd transformationData = normalizeObservationMatrix( residualsAndPartials.second );
+            Eigen::VectorXd transformationData;
+            if( podInput->getAccumulateNormalEquations( ) )
+            {
+                calculateNormalEquationsAndResiduals(
+                            podInput->getObservationCollection( ), podInput->getWeightsMatrixDiagonals( ),
+                            totalNumberOfObservations, podInput->getMaximumNumberOfObservationTimesPerBlock( ),
+                            *normalEquations, residualsAndPartials.first );
+                transformationData = normalEquations->getParameterNormalization( );
+            }
+            else
+            {
+                calculateObservationMatrixAndResiduals(
+                            podInput->getObservationCollection( ), parameterVectorSize, totalNumberOfObservations, residualsAndPartials );
+                transformationData = normalizeObservationMatrix( residualsAndPartials.second );
+            }
 
             Eigen::MatrixXd normalizedInverseAprioriCovarianceMatrix = Eigen::MatrixXd::Zero(
                         numberOfEstimatedParameters, numberOfEstimatedParameters );
@@ -512,11 +626,22 @@ public:
                 Eigen::MatrixXd constraintStateMultiplier;
                 Eigen::VectorXd constraintRightHandSide;
                 parametersToEstimate_->getConstraints( constraintStateMultiplier, constraintRightHandSide );
-                leastSquaresOutput =
-                        std::move( linear_algebra::performLeastSquaresAdjustmentFromInformationMatrix(
-                                       residualsAndPartials.second.block( 0, 0, residualsAndPartials.second.rows( ), numberOfEstimatedParameters ),
-                                       residualsAndPartials.first, podInput->getWeightsMatrixDiagonals( ),
-                                       normalizedInverseAprioriCovarianceMatrix, 1, 1.0E8, constraintStateMultiplier, constraintRightHandSide ) );
+                if( podInput->getAccumulateNormalEquations( ) )
+                {
+                    leastSquaresOutput = normalEquations->performLeastSquaresAdjustment(
+                                transformationData, normalizedInverseAprioriCovarianceMatrix,
+                                podInput->getNormalEquationsSolutionMethod( ), 1, 1.0E8,
+                                constraintStateMultiplier, constraintRightHandSide );
+                }
+                else
+                {
+                    leastSquaresOutput =
+                            std::move( linear_algebra::performLeastSquaresAdjustmentFromInformationMatrix(
+                                           residualsAndPartials.second.block( 0, 0, residualsAndPartials.second.rows( ), numberOfEstimatedParameters ),
+                                           residualsAndPartials.first, podInput->getWeightsMatrixDiagonals( ),
+                                           normalizedInverseAprioriCovarianceMatrix, 1, 1.0E8, constraintStateMultiplier, constraintRightHandSide,
+                                           podInput->getNormalEquationsSolutionMethod( ) ) );
+                }
 
                 if( constraintStateMultiplier.rows( ) > 0 )
                 {
@@ -577,7 +702,7 @@ public:
                 bestResidual = residualRms;
                 bestParameterEstimate = std::move( oldParameterEstimate );
                 bestResiduals = std::move( residualsAndPartials.first );
-                if( podInput->getSaveInformationMatrix( ) )
+                if( podInput->getSaveInformationMatrix( ) && !podInput->getAccumulateNormalEquations( ) )
                 {
                     bestInformationMatrix = std::move( residualsAndPartials.second );
                 }
@@ -16,6 +16,7 @@
 #include <functional>
 
 #include "tudat/astro/observation_models/observationSimulator.h"
+#include "tudat/basics/parallelExecution.h"
 #include "tudat/simulation/estimation_setup/observations.h"
 #include "tudat/basics/utilities.h"
 #include "tudat/math/statistics/randomVariableGenerator.h"
@@ -312,15 +313,88 @@ simulateSingleObservationSet(
                 bodies );
 }
 
+//! Function to simulate observations for single observable and single set of link ends, from a list of observation simulators
+/*!
+ *  Function to simulate observations for single observable and single set of link ends, from a list of observation simulators
+ *  (of which the one for the observable type in observationsToSimulate is used).
+ *  \param observationsToSimulate Object that computes/defines settings for observation times/reference link end
+ *  \param observationSimulators List of Observation simulators per observable type.
+ *  \param bodies Map of Body objects that comprise the environment
+ *  \return Simulated observations for single observable and single set of link ends
+ */
+template< typename ObservationScalarType = double, typename TimeType = double >
+std::shared_ptr< observation_models::SingleObservationSet< ObservationScalarType, TimeType > >
+simulateSingleObservationSet(
+        const std::shared_ptr< ObservationSimulationSettings< TimeType > > observationsToSimulate,
+        const std::vector< std::shared_ptr< observation_models::ObservationSimulatorBase< ObservationScalarType, TimeType > > >& observationSimulators,
+        const SystemOfBodies& bodies )
+{
+    observation_models::ObservableType observableType = observationsToSimulate->getObservableType( );
+    int observationSize = observation_models::getObservableSize( observableType );
+
+    std::shared_ptr< observation_models::SingleObservationSet< ObservationScalarType, TimeType > > simulatedObservations;
+    switch( observationSize )
+    {
+    case 1:
+    {
+        std::shared_ptr< observation_models::ObservationSimulator< 1, ObservationScalarType, TimeType > > derivedObservationSimulator =
+                observation_models::getObservationSimulatorOfType< 1 >( observationSimulators, observableType );
+
+        if( derivedObservationSimulator == nullptr )
+        {
+            throw std::runtime_error( "Error when simulating observation: dynamic cast to size 1 is nullptr" );
+        }
+
+        // Simulate observations for current observable and link ends set.
+        simulatedObservations = simulateSingleObservationSet< ObservationScalarType, TimeType, 1 >(
+                    observationsToSimulate, derivedObservationSimulator, bodies );
+        break;
+    }
+    case 2:
+    {
+        std::shared_ptr< observation_models::ObservationSimulator< 2, ObservationScalarType, TimeType > > derivedObservationSimulator =
+                observation_models::getObservationSimulatorOfType< 2 >( observationSimulators, observableType );
+
+        if( derivedObservationSimulator == nullptr )
+        {
+            throw std::runtime_error( "Error when simulating observation: dynamic cast to size 2 is nullptr" );
+        }
+
+        // Simulate observations for current observable and link ends set.
+        simulatedObservations = simulateSingleObservationSet< ObservationScalarType, TimeType, 2 >(
+                    observationsToSimulate, derivedObservationSimulator, bodies );
+        break;
+    }
+    case 3:
+    {
+        std::shared_ptr< observation_models::ObservationSimulator< 3, ObservationScalarType, TimeType > > derivedObservationSimulator =
+                observation_models::getObservationSimulatorOfType< 3 >( observationSimulators, observableType );
+
+        if( derivedObservationSimulator == nullptr )
+        {
+            throw std::runtime_error( "Error when simulating observation: dynamic cast to size 3 is nullptr" );
+        }
+
+        // Simulate observations for current observable and link ends set.
+        simulatedObservations = simulateSingleObservationSet< ObservationScalarType, TimeType, 3 >(
+                    observationsToSimulate, derivedObservationSimulator, bodies );
+        break;
+    }
+    default:
+        throw std::runtime_error( "Error, simulation of observations not yet implemented for size " +
+                                  std::to_string( observationSize ) );
+
+    }
+    return simulatedObservations;
+}
+
 //! Function to simulate observations from set of observables and link and sets
 /*!
  *  Function to simulate observations from set of observables, link ends and observation time settings
  *  Iterates over all observables and link ends and simulates observations.
  *  \param observationsToSimulate List of observation time settings per link end set per observable type.
  *  \param observationSimulators List of Observation simulators per link end set per observable type.
- *  \param viabilityCalculatorList List (per observable type and per link ends) of observation viability calculators, which
- *  are used to reject simulated observation if they dont fulfill a given (set of) conditions, e.g. minimum elevation angle
- *  (default none).
+ *  \param bodies Map of Body objects that comprise the environment
  *  \return Simulated observatoon values and associated times for requested observable types and link end sets.
  */
 template< typename ObservationScalarType = double, typename TimeType = double >
@@ -335,72 +409,273 @@ std::shared_ptr< observation_models::ObservationCollection< ObservationScalarTyp
     // Iterate over all observables.
     for( unsigned int i = 0; i < observationsToSimulate.size( ); i++ )
     {
-        observation_models::ObservableType observableType = observationsToSimulate.at( i )->getObservableType( );
-        observation_models::LinkEnds linkEnds = observationsToSimulate.at( i )->getLinkEnds( );
+        sortedObservations[ observationsToSimulate.at( i )->getObservableType( ) ][
+                observationsToSimulate.at( i )->getLinkEnds( ) ].push_back(
+                    simulateSingleObservationSet< ObservationScalarType, TimeType >(
+                        observationsToSimulate.at( i ), observationSimulators, bodies ) );
+    }
+    std::shared_ptr< observation_models::ObservationCollection< ObservationScalarType, TimeType > > observationCollection =
+            std::make_shared< observation_models::ObservationCollection< ObservationScalarType, TimeType > >( sortedObservations );
 
-        int observationSize = observation_models::getObservableSize( observableType );
+    return observationCollection;
+}
+
+//! Function to simulate noise-free observations at a range of observation times, and determine their viability
+/*!
+ *  Function to simulate noise-free observations at a range of observation times, and determine their viability, for a
+ *  single set of link ends
+ *  \param observationTimes Full list of observation times of current set of link ends
+ *  \param startIndex Index in observationTimes of first observation that is to be simulated
+ *  \param numberOfObservationTimes Number of observation times that are to be simulated
+ *  \param observationModel Model used to compute observables
+ *  \param referenceLinkEnd Model Reference link end for observables
+ *  \param linkViabilityCalculators List of observation viability calculators
+ *  \param observations Simulated (noise-free) observations, one per observation time (returned by reference)
+ *  \param observationViability Viability of each simulated observation (returned by reference)
+ */
+template< int ObservationSize = 1, typename ObservationScalarType = double, typename TimeType = double >
+void simulateObservationsAndViability(
+        const std::vector< TimeType >& observationTimes,
+        const unsigned int startIndex,
+        const unsigned int numberOfObservationTimes,
+        const std::shared_ptr< observation_models::ObservationModel< ObservationSize, ObservationScalarType, TimeType > > observationModel,
+        const observation_models::LinkEndType referenceLinkEnd,
+        const std::vector< std::shared_ptr< observation_models::ObservationViabilityCalculator > >& linkViabilityCalculators,
+        std::vector< Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > >& observations,
+        std::vector< bool >& observationViability )
+{
+    observations.resize( numberOfObservationTimes );
+    observationViability.resize( numberOfObservationTimes );
+
+    std::tuple< Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 >, bool, Eigen::VectorXd > simulatedObservation;
+    for( unsigned int i = 0; i < numberOfObservationTimes; i++ )
+    {
+        simulatedObservation = simulateObservationWithCheck< ObservationSize, ObservationScalarType, TimeType >(
+                    observationTimes.at( startIndex + i ), observationModel, referenceLinkEnd, linkViabilityCalculators );
+        observations[ i ] = std::get< 0 >( simulatedObservation );
+        observationViability[ i ] = std::get< 1 >( simulatedObservation );
+    }
+}
+
+//! Function to simulate noise-free observations at a range of observation times, and determine their viability
+/*!
+ *  Function to simulate noise-free observations at a range of observation times, and determine their viability, for the
+ *  observable and link ends defined by observation simulation settings, using a given environment and list of observation
+ *  simulators (which must have been created from that environment).
+ *  \param observationsToSimulate Settings for observable type, link ends, times and reference link end (must be tabulated)
+ *  \param startIndex Index in list of observation times of first observation that is to be simulated
+ *  \param numberOfObservationTimes Number of observation times that are to be simulated
+ *  \param observationSimulators List of Observation simulators per observable type.
+ *  \param bodies Map of Body objects that comprise the environment
+ *  \param observations Simulated (noise-free) observations, one per observation time (returned by reference)
+ *  \param observationViability Viability of each simulated observation (returned by reference)
+ */
+template< typename ObservationScalarType = double, typename TimeType = double >
+void simulateObservationsAndViability(
+        const std::shared_ptr< TabulatedObservationSimulationSettings< TimeType > > observationsToSimulate,
+        const unsigned int startIndex,
+        const unsigned int numberOfObservationTimes,
+        const std::vector< std::shared_ptr< observation_models::ObservationSimulatorBase< ObservationScalarType, TimeType > > >& observationSimulators,
+        const SystemOfBodies& bodies,
+        std::vector< Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > >& observations,
+        std::vector< bool >& observationViability )
+{
+    observation_models::ObservableType observableType = observationsToSimulate->getObservableType( );
+    observation_models::LinkEnds linkEnds = observationsToSimulate->getLinkEnds( );
+
+    std::vector< std::shared_ptr< observation_models::ObservationViabilityCalculator > > currentObservationViabilityCalculators =
+            observation_models::createObservationViabilityCalculators(
+                bodies, linkEnds, observableType, observationsToSimulate->getViabilitySettingsList( ) );
 
-        switch( observationSize )
+    int observationSize = observation_models::getObservableSize( observableType );
+    switch( observationSize )
+    {
+    case 1:
+    {
+        std::shared_ptr< observation_models::ObservationSimulator< 1, ObservationScalarType, TimeType > > derivedObservationSimulator =
+                observation_models::getObservationSimulatorOfType< 1 >( observationSimulators, observableType );
+        if( derivedObservationSimulator == nullptr )
         {
-        case 1:
+            throw std::runtime_error( "Error when simulating observation: dynamic cast to size 1 is nullptr" );
+        }
+        simulateObservationsAndViability< 1, ObservationScalarType, TimeType >(
+                    observationsToSimulate->simulationTimes_, startIndex, numberOfObservationTimes,
+                    derivedObservationSimulator->getObservationModel( linkEnds ), observationsToSimulate->getReferenceLinkEndType( ),
+                    currentObservationViabilityCalculators, observations, observationViability );
+        break;
+    }
+    case 2:
+    {
+        std::shared_ptr< observation_models::ObservationSimulator< 2, ObservationScalarType, TimeType > > derivedObservationSimulator =
+                observation_models::getObservationSimulatorOfType< 2 >( observationSimulators, observableType );
+        if( derivedObservationSimulator == nullptr )
         {
-            std::shared_ptr< observation_models::ObservationSimulator< 1, ObservationScalarType, TimeType > > derivedObservationSimulator =
-                    observation_models::getObservationSimulatorOfType< 1 >( observationSimulators, observableType );
+            throw std::runtime_error( "Error when simulating observation: dynamic cast to size 2 is nullptr" );
+        }
+        simulateObservationsAndViability< 2, ObservationScalarType, TimeType >(
+                    observationsToSimulate->simulationTimes_, startIndex, numberOfObservationTimes,
+                    derivedObservationSimulator->getObservationModel( linkEnds ), observationsToSimulate->getReferenceLinkEndType( ),
+                    currentObservationViabilityCalculators, observations, observationViability );
+        break;
+    }
+    case 3:
+    {
+        std::shared_ptr< observation_models::ObservationSimulator< 3, ObservationScalarType, TimeType > > derivedObservationSimulator =
+                observation_models::getObservationSimulatorOfType< 3 >( observationSimulators, observableType );
+        if( derivedObservationSimulator == nullptr )
+        {
+            throw std::runtime_error( "Error when simulating observation: dynamic cast to size 3 is nullptr" );
+        }
+        simulateObservationsAndViability< 3, ObservationScalarType, TimeType >(
+                    observationsToSimulate->simulationTimes_, startIndex, numberOfObservationTimes,
+                    derivedObservationSimulator->getObservationModel( linkEnds ), observationsToSimulate->getReferenceLinkEndType( ),
+                    currentObservationViabilityCalculators, observations, observationViability );
+        break;
+    }
+    default:
+        throw std::runtime_error( "Error, simulation of observations not yet implemented for size " +
+                                  std::to_string( observationSize ) );
+    }
+}
 
-            if( derivedObservationSimulator == nullptr )
-            {
-                throw std::runtime_error( "Error when simulating observation: dynamic cast to size 1 is nullptr" );
-            }
+//! Function to simulate observations from set of observables and link and sets, distributing the work over multiple threads
+/*!
+ *  Function to simulate observations from set of observables, link ends and observation time settings, distributing the
+ *  work over multiple threads. Each thread uses its own environment (SystemOfBodies) and its own observation simulators
+ *  (which must have been created from that environment), so that the states of the bodies, the light-time calculators and
+ *  the observation models are never accessed concurrently. The observation times of each set of link ends are split into
+ *  blocks of at most numberOfObservationTimesPerTask, and each (observable, link ends, block of times) combination is
+ *  dynamically assigned to one of the threads. Note that the environment models used must be safe to evaluate from
+ *  different threads for different SystemOfBodies objects (in particular, ephemerides and rotation models that directly
+ *  call Spice are not).
+ *  After the noise-free observations and their viability have been computed, the noise is added on the calling thread,
+ *  in the same order as done by the sequential simulateObservations function, so that the results are identical to
+ *  those of the sequential function (also for noise functions that depend on the number of calls, such as random
+ *  noise generators). Observation sets for which dependent variables are to be computed are simulated sequentially,
+ *  using the first environment.
+ *  \param observationsToSimulate List of observation time settings per link end set per observable type (must be tabulated).
+ *  \param threadObservationSimulators List of observation simulators for each thread
+ *  \param threadBodies List of environments for each thread (number of entries defines number of threads).
+ *  \param numberOfObservationTimesPerTask Maximum number of observation times that are simulated in a single task.
+ *  \return Simulated observatoon values and associated times for requested observable types and link end sets.
+ */
+template< typename ObservationScalarType = double, typename TimeType = double >
+std::shared_ptr< observation_models::ObservationCollection< ObservationScalarType, TimeType > > simulateObservations(
+        const std::vector< std::shared_ptr< ObservationSimulationSettings< TimeType > > >& observationsToSimulate,
+        const std::vector< std::vector< std::shared_ptr< observation_models::ObservationSimulatorBase< ObservationScalarType, TimeType > > > >&
+        threadObservationSimulators,
+        const std::vector< SystemOfBodies >& threadBodies,
+        const unsigned int numberOfObservationTimesPerTask = 1000 )
+{
+    if( threadBodies.size( ) == 0 || threadObservationSimulators.size( ) != threadBodies.size( ) )
+    {
+        throw std::runtime_error( "Error when simulating observations in parallel, number of environments (" +
+                                  std::to_string( threadBodies.size( ) ) + ") and lists of observation simulators (" +
+                                  std::to_string( threadObservationSimulators.size( ) ) + ") is incompatible" );
+    }
+    if( numberOfObservationTimesPerTask == 0 )
+    {
+        throw std::runtime_error( "Error when simulating observations in parallel, number of observation times per task must be positive" );
+    }
 
-            // Simulate observations for current observable and link ends set.
-            sortedObservations[ observableType ][ linkEnds ].push_back(
-                        simulateSingleObservationSet< ObservationScalarType, TimeType, 1 >(
-                            observationsToSimulate.at( i ), derivedObservationSimulator, bodies ) );
-            break;
-        }
-        case 2:
+    // Define tasks: ( index of observation settings, ( index of first observation time, number of observation times ) )
+    std::vector< std::shared_ptr< TabulatedObservationSimulationSettings< TimeType > > > tabulatedObservationSettings;
+    std::vector< std::pair< unsigned int, std::pair< unsigned int, unsigned int > > > tasks;
+    std::vector< std::vector< unsigned int > > tasksPerObservationSet;
+    for( unsigned int i = 0; i < observationsToSimulate.size( ); i++ )
+    {
+        tabulatedObservationSettings.push_back(
+                    std::dynamic_pointer_cast< TabulatedObservationSimulationSettings< TimeType > >( observationsToSimulate.at( i ) ) );
+        tasksPerObservationSet.push_back( std::vector< unsigned int >( ) );
+        if( tabulatedObservationSettings.at( i ) == nullptr )
         {
-            std::shared_ptr< observation_models::ObservationSimulator< 2, ObservationScalarType, TimeType > > derivedObservationSimulator =
-                    observation_models::getObservationSimulatorOfType< 2 >( observationSimulators, observableType );
+            throw std::runtime_error( "Error when simulating observations in parallel, only tabulated observation simulation settings are supported" );
+        }
 
-            if( derivedObservationSimulator == nullptr )
+        // Observation sets with dependent variables are simulated sequentially
+        if( observationsToSimulate.at( i )->getDependentVariableCalculator( ) == nullptr )
+        {
+            unsigned int numberOfObservationTimes = tabulatedObservationSettings.at( i )->simulationTimes_.size( );
+            for( unsigned int j = 0; j < numberOfObservationTimes; j += numberOfObservationTimesPerTask )
             {
-                throw std::runtime_error( "Error when simulating observation: dynamic cast to size 2 is nullptr" );
+                tasksPerObservationSet.at( i ).push_back( tasks.size( ) );
+                tasks.push_back( std::make_pair(
+                                     i, std::make_pair( j, std::min( numberOfObservationTimesPerTask, numberOfObservationTimes - j ) ) ) );
             }
+        }
+    }
+
+    // Simulate noise-free observations, and their viability, for all tasks
+    std::vector< std::vector< Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > > > taskObservations( tasks.size( ) );
+    std::vector< std::vector< bool > > taskObservationViability( tasks.size( ) );
+    utilities::executeTasksInParallel(
+                tasks.size( ), threadBodies.size( ),
+                [ & ]( const unsigned int taskIndex, const unsigned int threadIndex )
+    {
+        simulateObservationsAndViability< ObservationScalarType, TimeType >(
+                    tabulatedObservationSettings.at( tasks.at( taskIndex ).first ),
+                    tasks.at( taskIndex ).second.first, tasks.at( taskIndex ).second.second,
+                    threadObservationSimulators.at( threadIndex ), threadBodies.at( threadIndex ),
+                    taskObservations.at( taskIndex ), taskObservationViability.at( taskIndex ) );
+    } );
+
+    // Add noise to viable observations, and create observation sets, in the same order as the sequential simulation
+    typename observation_models::ObservationCollection< ObservationScalarType, TimeType >::SortedObservationSets sortedObservations;
+    for( unsigned int i = 0; i < observationsToSimulate.size( ); i++ )
+    {
+        observation_models::ObservableType observableType = observationsToSimulate.at( i )->getObservableType( );
+        observation_models::LinkEnds linkEnds = observationsToSimulate.at( i )->getLinkEnds( );
 
-            // Simulate observations for current observable and link ends set.
+        if( observationsToSimulate.at( i )->getDependentVariableCalculator( ) != nullptr )
+        {
             sortedObservations[ observableType ][ linkEnds ].push_back(
-                        simulateSingleObservationSet< ObservationScalarType, TimeType, 2 >(
-                            observationsToSimulate.at( i ), derivedObservationSimulator, bodies ) );
-            break;
+                        simulateSingleObservationSet< ObservationScalarType, TimeType >(
+                            observationsToSimulate.at( i ), threadObservationSimulators.at( 0 ), threadBodies.at( 0 ) ) );
+            continue;
         }
-        case 3:
-        {
-            std::shared_ptr< observation_models::ObservationSimulator< 3, ObservationScalarType, TimeType > > derivedObservationSimulator =
-                    observation_models::getObservationSimulatorOfType< 3 >( observationSimulators, observableType );
 
-            if( derivedObservationSimulator == nullptr )
+        int observationSize = observation_models::getObservableSize( observableType );
+        std::function< Eigen::VectorXd( const double ) > noiseFunction = observationsToSimulate.at( i )->getObservationNoiseFunction( );
+        const std::vector< TimeType >& observationTimes = tabulatedObservationSettings.at( i )->simulationTimes_;
+
+        std::map< TimeType, Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > > observations;
+        std::vector< Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > > dependentVariables;
+        for( unsigned int j = 0; j < tasksPerObservationSet.at( i ).size( ); j++ )
+        {
+            unsigned int taskIndex = tasksPerObservationSet.at( i ).at( j );
+            unsigned int startIndex = tasks.at( taskIndex ).second.first;
+            for( unsigned int k = 0; k < taskObservations.at( taskIndex ).size( ); k++ )
             {
-                throw std::runtime_error( "Error when simulating observation: dynamic cast to size 3 is nullptr" );
+                if( taskObservationViability.at( taskIndex ).at( k ) )
+                {
+                    Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > currentObservation =
+                            taskObservations.at( taskIndex ).at( k );
+                    if( noiseFunction != nullptr )
+                    {
+                        Eigen::VectorXd noiseToAdd = noiseFunction( observationTimes.at( startIndex + k ) );
+                        if( noiseToAdd.rows( ) != observationSize )
+                        {
+                            throw std::runtime_error(
+                                        "Error wen simulating observation noise, size of noise (" + std::to_string( noiseToAdd.rows( ) ) +
+                                        ") and size of observable (" + std::to_string( observationSize ) +
+                                        ") are not compatible for observable type: " + observation_models::getObservableName( observableType ) );
+                        }
+                        currentObservation += noiseToAdd.template cast< ObservationScalarType >( );
+                    }
+                    observations[ observationTimes.at( startIndex + k ) ] = currentObservation;
+                    dependentVariables.push_back( Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 >::Zero( 0 ) );
+                }
             }
-
-            // Simulate observations for current observable and link ends set.
-            sortedObservations[ observableType ][ linkEnds ].push_back(
-                        simulateSingleObservationSet< ObservationScalarType, TimeType, 3 >(
-                            observationsToSimulate.at( i ), derivedObservationSimulator, bodies ) );
-
-            break;
         }
-        default:
-            throw std::runtime_error( "Error, simulation of observations not yet implemented for size " +
-                                      std::to_string( observationSize ) );
 
-        }
+        sortedObservations[ observableType ][ linkEnds ].push_back(
+                    std::make_shared< observation_models::SingleObservationSet< ObservationScalarType, TimeType > >(
+                        observableType, linkEnds, utilities::createVectorFromMapValues( observations ),
+                        utilities::createVectorFromMapKeys( observations ), observationsToSimulate.at( i )->getReferenceLinkEndType( ),
+                        dependentVariables ) );
     }
-    std::shared_ptr< observation_models::ObservationCollection< ObservationScalarType, TimeType > > observationCollection =
-            std::make_shared< observation_models::ObservationCollection< ObservationScalarType, TimeType > >( sortedObservations );
 
-    return observationCollection;
+    return std::make_shared< observation_models::ObservationCollection< ObservationScalarType, TimeType > >( sortedObservations );
 }
 
 Eigen::VectorXd getIdenticallyAndIndependentlyDistributedNoise(
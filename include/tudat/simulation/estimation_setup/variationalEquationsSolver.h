@@ -770,16 +770,42 @@ public:
             std::map< TimeType, double > cumulativeComputationTimeHistory;
 
             simulation_setup::setAreBodiesInPropagation( bodies_, true );
-            std::shared_ptr< PropagationTerminationDetails > propagationTerminationReason =
-                    EquationIntegrationInterface< MatrixType, TimeType >::integrateEquations(
-                        dynamicsSimulator_->getStateDerivativeFunction( ), rawNumericalSolution,
-                        initialVariationalState, integratorSettings_,
-                        dynamicsSimulator_->getPropagationTerminationCondition( ),
-                        dependentVariableHistory,
-                        cumulativeComputationTimeHistory,
-                        dynamicsSimulator_->getDependentVariablesFunctions( ),
-                        statePostProcessingFunction_,
-                        propagatorSettings_->getPrintInterval( ) );
+            std::shared_ptr< PropagationTerminationDetails > propagationTerminationReason;
+            if( propagatorSettings_->getUseFixedSizeStatePropagation( ) &&
+                    dynamicsStateDerivative_->isFixedSizeStatePropagationSupported( ) &&
+                    stateTransitionMatrixSize_ == 6 && parameterVectorSize_ == 6 )
+            {
+                // Propagate state and state transition matrix w.r.t. initial state only as fixed-size matrix
+                typedef Eigen::Matrix< StateScalarType, 6, 7 > FixedSizeStateType;
+                std::function< FixedSizeStateType( const TimeType, const FixedSizeStateType& ) >
+                        fixedSizeStateDerivativeFunction = std::bind(
+                            &DynamicsStateDerivativeModel< TimeType, StateScalarType >::template
+                            computeFixedSizeStateDerivative< 6, 7 >,
+                            dynamicsStateDerivative_, std::placeholders::_1, std::placeholders::_2 );
+                propagationTerminationReason =
+                        EquationIntegrationInterface< FixedSizeStateType, TimeType >::integrateEquations(
+                            fixedSizeStateDerivativeFunction, rawNumericalSolution,
+                            FixedSizeStateType( initialVariationalState ), integratorSettings_,
+                            dynamicsSimulator_->getPropagationTerminationCondition( ),
+                            dependentVariableHistory,
+                            cumulativeComputationTimeHistory,
+                            dynamicsSimulator_->getDependentVariablesFunctions( ),
+                            std::function< void( FixedSizeStateType& ) >( ),
+                            propagatorSettings_->getPrintInterval( ) );
+            }
+            else
+            {
+                propagationTerminationReason =
+                        EquationIntegrationInterface< MatrixType, TimeType >::integrateEquations(
+                            dynamicsSimulator_->getStateDerivativeFunction( ), rawNumericalSolution,
+                            initialVariationalState, integratorSettings_,
+                            dynamicsSimulator_->getPropagationTerminationCondition( ),
+                            dependentVariableHistory,
+                            cumulativeComputationTimeHistory,
+                            dynamicsSimulator_->getDependentVariablesFunctions( ),
+                            statePostProcessingFunction_,
+                            propagatorSettings_->getPrintInterval( ) );
+            }
             dynamicsSimulator_->setPropagationTerminationReason( propagationTerminationReason );
             simulation_setup::setAreBodiesInPropagation( bodies_, false );
 
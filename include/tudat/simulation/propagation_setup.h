@@ -12,6 +12,7 @@
 #define TUDAT_PROPAGATION_SETUP_H
 
 #include "propagation_setup/accelerationSettings.h"
+#include "propagation_setup/batchPropagation.h"
 #include "propagation_setup/createAccelerationModels.h"
 #include "propagation_setup/createEnvironmentUpdater.h"
 #include "propagation_setup/createMassRateModels.h"
@@ -20,6 +21,7 @@
 #include "propagation_setup/createTorqueModel.h"
 #include "propagation_setup/dynamicsSimulator.h"
 #include "propagation_setup/environmentUpdater.h"
+#include "propagation_setup/monteCarloPropagation.h"
 #include "propagation_setup/propagationCR3BPFullProblem.h"
 //#include "propagation_setup/propagationLambertTargeterFullProblem.h"
 #include "propagation_setup/propagationOutput.h"
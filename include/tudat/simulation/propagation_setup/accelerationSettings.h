@@ -73,6 +73,20 @@ inline std::shared_ptr< AccelerationSettings > pointMassGravityAcceleration( )
     return std::make_shared< AccelerationSettings >( basic_astrodynamics::point_mass_gravity );
 }
 
+// Function to create settings for a point mass gravity acceleration, evaluated together with all other such accelerations
+/*
+ *  Function to create settings for a point mass gravity acceleration (direct or third-body, as for
+ *  pointMassGravityAcceleration), which is evaluated in a single pass with all other accelerations of this type
+ *  (using a ManyBodyPointMassGravityKernel) acting on bodies with the same central body and the same list of bodies
+ *  exerting this acceleration type. This is typically used to propagate a large number of bodies (e.g. a constellation
+ *  or debris cloud) under the central and third-body point mass gravity of the same bodies.
+ *  \return Acceleration settings
+ */
+inline std::shared_ptr< AccelerationSettings > manyBodyPointMassGravityAcceleration( )
+{
+    return std::make_shared< AccelerationSettings >( basic_astrodynamics::many_body_point_mass_gravity );
+}
+
 //! @get_docstring(aerodynamicAcceleration)
 inline std::shared_ptr< AccelerationSettings > aerodynamicAcceleration( )
 {
@@ -648,7 +662,31 @@ public:
             std::bind( &applyAccelerationScalingFunction, accelerationFunction, scalingFunction,
                        std::placeholders::_1 ) ){ }
 
+    //! Constructor for acceleration depending on time and state of body undergoing acceleration
+    /*!
+     *  Constructor for acceleration depending on time and state of body undergoing acceleration, w.r.t. the body exerting
+     *  the acceleration.
+     *  \param stateDependentAccelerationFunction Function returning acceleration as a function of time and relative state
+     *  \param differentiableAccelerationFunction Same as stateDependentAccelerationFunction, but with dual numbers as scalar
+     *  type. If provided, the partial derivatives of the acceleration w.r.t. the relative state are computed from this
+     *  function by automatic differentiation (for the variational equations). If empty, these partials are set to zero.
+     */
+    CustomAccelerationSettings(
+            const std::function< Eigen::Vector3d( const double, const Eigen::Vector6d& ) > stateDependentAccelerationFunction,
+            const std::function< basic_astrodynamics::DualAcceleration(
+                const double, const basic_astrodynamics::DualCartesianState& ) > differentiableAccelerationFunction ):
+        AccelerationSettings( basic_astrodynamics::custom_acceleration ),
+        stateDependentAccelerationFunction_( stateDependentAccelerationFunction ),
+        differentiableAccelerationFunction_( differentiableAccelerationFunction ){ }
+
     std::function< Eigen::Vector3d( const double ) > accelerationFunction_;
+
+    //! Function returning acceleration as a function of time and relative state
+    std::function< Eigen::Vector3d( const double, const Eigen::Vector6d& ) > stateDependentAccelerationFunction_;
+
+    //! Function returning acceleration as a function of time and relative state, with dual numbers as scalar type
+    std::function< basic_astrodynamics::DualAcceleration(
+        const double, const basic_astrodynamics::DualCartesianState& ) > differentiableAccelerationFunction_;
 };
 
 //! @get_docstring(customAccelerationSettings)
@@ -668,6 +706,50 @@ inline std::shared_ptr< AccelerationSettings > customAccelerationSettings(
     }
 }
 
+//! Function to create settings for a custom acceleration depending on time and state of the body undergoing acceleration
+/*!
+ *  Function to create settings for a custom acceleration depending on time and state of the body undergoing acceleration,
+ *  w.r.t. the body exerting the acceleration.
+ *  \param stateDependentAccelerationFunction Function returning acceleration as a function of time and relative state
+ *  \param differentiableAccelerationFunction Same as stateDependentAccelerationFunction, but with dual numbers as scalar
+ *  type, used to compute the partials of the acceleration w.r.t. the relative state by automatic differentiation (optional).
+ *  \return Custom acceleration settings
+ */
+inline std::shared_ptr< AccelerationSettings > stateDependentCustomAccelerationSettings(
+        const std::function< Eigen::Vector3d( const double, const Eigen::Vector6d& ) > stateDependentAccelerationFunction,
+        const std::function< basic_astrodynamics::DualAcceleration(
+            const double, const basic_astrodynamics::DualCartesianState& ) > differentiableAccelerationFunction = nullptr )
+{
+    return std::make_shared< CustomAccelerationSettings >(
+                stateDependentAccelerationFunction, differentiableAccelerationFunction );
+}
+
+//! Function to create settings for a differentiable custom acceleration depending on time and state
+/*!
+ *  Function to create settings for a custom acceleration depending on time and state of the body undergoing acceleration,
+ *  w.r.t. the body exerting the acceleration, from a single function that is templated on its scalar type (e.g. a generic
+ *  lambda taking the state as const auto&). The function is instantiated both for doubles, to compute the acceleration,
+ *  and for dual numbers, to compute its partials w.r.t. the relative state by automatic differentiation. The function
+ *  must return a 3-dimensional Eigen vector with the same scalar type as the state (not an unevaluated expression).
+ *  \param accelerationFunction Function, templated on scalar type, returning acceleration as a function of time and
+ *  relative state
+ *  \return Custom acceleration settings
+ */
+template< typename AccelerationFunctionType >
+std::shared_ptr< AccelerationSettings > differentiableCustomAccelerationSettings(
+        const AccelerationFunctionType& accelerationFunction )
+{
+    return stateDependentCustomAccelerationSettings(
+                [ = ]( const double time, const Eigen::Vector6d& state ) -> Eigen::Vector3d
+    {
+        return accelerationFunction( time, state );
+    },
+    [ = ]( const double time, const basic_astrodynamics::DualCartesianState& state ) -> basic_astrodynamics::DualAcceleration
+    {
+        return accelerationFunction( time, state );
+    } );
+}
+
 // Class for providing settings for a direct tidal acceleration model, with approach of Lainey et al. (2007, 2009, ..)
 /*
  *  Class for providing settings for a direct tidal acceleration model, with approach of Lainey et al. (2007, 2009, ..).
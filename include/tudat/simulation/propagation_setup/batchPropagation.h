@@ -0,0 +1,202 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_BATCHPROPAGATION_H
+#define TUDAT_BATCHPROPAGATION_H
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/ephemerides/cachedEphemeris.h"
+#include "tudat/basics/parallelExecution.h"
+#include "tudat/simulation/propagation_setup/dynamicsSimulator.h"
+#include "tudat/simulation/propagation_setup/monteCarloPropagation.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Function to replace the ephemerides of a list of bodies by ephemerides that cache their states
+/*!
+ *  Function to replace the ephemerides of a list of bodies by ephemerides that cache their states (see
+ *  CachedEphemeris), so that the states of these bodies are shared when many objects are propagated in the same
+ *  environment (see propagateSingleArcBatch). Ephemerides that are already cached are not wrapped again.
+ *  \param bodies Environment in which the ephemerides are to be replaced
+ *  \param bodiesWithCachedEphemeris Names of bodies of which the ephemerides are to be replaced
+ *  \param maximumCacheSize Maximum number of states that are stored in each cache
+ *  \param gridSpacing Spacing of the epochs at which the ephemerides are evaluated, and from which the states at other
+ *  epochs are interpolated (NaN by default, in which case states are cached at exact epochs only)
+ *  \return List of cached ephemerides (in the order of bodiesWithCachedEphemeris)
+ */
+inline std::vector< std::shared_ptr< ephemerides::CachedEphemeris > > setCachedEphemerides(
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::vector< std::string >& bodiesWithCachedEphemeris,
+        const unsigned int maximumCacheSize = 100000,
+        const double gridSpacing = TUDAT_NAN )
+{
+    std::vector< std::shared_ptr< ephemerides::CachedEphemeris > > cachedEphemerides;
+    for( unsigned int i = 0; i < bodiesWithCachedEphemeris.size( ); i++ )
+    {
+        if( bodies.count( bodiesWithCachedEphemeris.at( i ) ) == 0 )
+        {
+            throw std::runtime_error( "Error when setting cached ephemeris of body " + bodiesWithCachedEphemeris.at( i ) +
+                                      ", body not found" );
+        }
+
+        std::shared_ptr< simulation_setup::Body > currentBody = bodies.at( bodiesWithCachedEphemeris.at( i ) );
+        std::shared_ptr< ephemerides::CachedEphemeris > cachedEphemeris =
+                std::dynamic_pointer_cast< ephemerides::CachedEphemeris >( currentBody->getEphemeris( ) );
+        if( cachedEphemeris == nullptr )
+        {
+            if( currentBody->getEphemeris( ) == nullptr )
+            {
+                throw std::runtime_error( "Error when setting cached ephemeris of body " +
+                                          bodiesWithCachedEphemeris.at( i ) + ", body has no ephemeris" );
+            }
+            cachedEphemeris = std::make_shared< ephemerides::CachedEphemeris >(
+                        currentBody->getEphemeris( ), maximumCacheSize, gridSpacing );
+            currentBody->setEphemeris( cachedEphemeris );
+        }
+        cachedEphemerides.push_back( cachedEphemeris );
+    }
+    return cachedEphemerides;
+}
+
+//! Function to propagate a large number of independent objects (e.g. a catalogue of satellites), distributed over a
+//! number of threads in blocks of objects.
+/*!
+ *  Function to propagate a large number of independent objects (e.g. a catalogue of satellites), each with its own
+ *  integrator settings, so that each object has its own (adaptive) step size and error control. As for a Monte Carlo
+ *  propagation (see propagateMonteCarloSamples), an environment is created once for each thread, and reused for all
+ *  objects propagated on that thread. The objects are divided into blocks of consecutive objects, which are
+ *  dynamically distributed over the threads, and the objects in a block are propagated one after the other on the
+ *  same thread. A dynamics simulator (with the object's state derivative models) is created for each object.
+ *  Only the ephemerides of the bodies in sharedEphemerisBodies (typically the perturbing bodies, such as the Sun and
+ *  Moon) are shared between objects: they are replaced in each thread's environment by ephemerides that cache their
+ *  states (see CachedEphemeris). All other environment models (e.g. rotation models, including Earth orientation
+ *  corrections, and atmospheres) are evaluated separately for each object. Two modes are available:
+ *  - If no grid spacing is provided, the states are cached at the exact epochs at which they are requested, and the
+ *    caches are cleared at the start of each block. States are then shared only at coincident epochs, which is the
+ *    case for all integrator stages of objects propagated with the same fixed step size and initial time, and for
+ *    (at most) the first steps of objects with variable step size integrators. Results are equal to those of a
+ *    sequential propagation of each object in a newly created environment.
+ *  - If a grid spacing is provided, the ephemerides are evaluated only at epochs on a grid with this spacing, common to
+ *    all objects, and the states at the epochs requested by the integrators are interpolated from these. The states
+ *    are then shared by all objects on a thread, also when their step sizes differ, and the caches are retained
+ *    between blocks. The grid spacing must be chosen such that the interpolation error is well below the tolerances
+ *    of the objects' integrators, which control the error of each object separately.
+ *  For each object, the objectSettingsFunction is called with the index of the object and the environment of the
+ *  current thread. It must set all object-specific properties of the environment (e.g. drag coefficient), and return
+ *  the integrator and propagator settings (with its own IntegratorSettings object) for the object. Calls to this
+ *  function are serialized, so that it may use models that are not thread-safe (e.g. Spice). The environment models
+ *  that are evaluated during the propagation must be safe to evaluate concurrently.
+ *  \param numberOfObjects Number of objects that are to be propagated
+ *  \param bodiesCreationFunction Function creating a new environment, called once per thread
+ *  \param objectSettingsFunction Function that sets the properties of an object (index given by input 1) in the
+ *  environment (input 2), and returns the integrator and propagator settings for the object
+ *  \param sharedEphemerisBodies Names of bodies for which the ephemeris evaluations are shared between the objects
+ *  \param sharedEphemerisGridSpacing Spacing of the epochs at which the shared ephemerides are evaluated (NaN by
+ *  default, in which case the ephemeris evaluations are only shared at coincident epochs within a block)
+ *  \param numberOfThreads Number of threads over which the blocks are distributed (0 denotes all available threads)
+ *  \param blockSize Number of (consecutive) objects that are propagated one after the other on the same thread
+ *  \param resultFunction Function that computes the result of a single propagation, with the index of the object and the
+ *  simulator with which it was propagated as input (final propagated state by default). Called on the worker thread.
+ *  \return Result for each object (in the order of the objects)
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+std::vector< Eigen::VectorXd > propagateSingleArcBatch(
+        const unsigned int numberOfObjects,
+        const std::function< simulation_setup::SystemOfBodies( ) > bodiesCreationFunction,
+        const std::function< std::pair< std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > >,
+        std::shared_ptr< SingleArcPropagatorSettings< StateScalarType > > >(
+            const unsigned int, const simulation_setup::SystemOfBodies& ) > objectSettingsFunction,
+        const std::vector< std::string >& sharedEphemerisBodies = std::vector< std::string >( ),
+        const double sharedEphemerisGridSpacing = TUDAT_NAN,
+        const unsigned int numberOfThreads = 0,
+        const unsigned int blockSize = 64,
+        const std::function< Eigen::VectorXd( const unsigned int,
+                                              SingleArcDynamicsSimulator< StateScalarType, TimeType >& ) > resultFunction =
+        [ ]( const unsigned int, SingleArcDynamicsSimulator< StateScalarType, TimeType >& dynamicsSimulator )
+{ return getFinalPropagatedState( dynamicsSimulator ); } )
+{
+    if( blockSize == 0 )
+    {
+        throw std::runtime_error( "Error in batch propagation, block size must be positive" );
+    }
+
+    unsigned int numberOfBlocks = ( numberOfObjects + blockSize - 1 ) / blockSize;
+    unsigned int numberOfWorkers = ( numberOfThreads == 0 ) ? utilities::getNumberOfAvailableThreads( ) : numberOfThreads;
+    numberOfWorkers = std::max( std::min( numberOfWorkers, numberOfBlocks ), 1U );
+
+    // Create environment for each thread, with cached ephemerides of bodies shared by objects
+    std::vector< simulation_setup::SystemOfBodies > threadBodies;
+    std::vector< std::vector< std::shared_ptr< ephemerides::CachedEphemeris > > > threadCachedEphemerides;
+    for( unsigned int i = 0; i < numberOfWorkers; i++ )
+    {
+        threadBodies.push_back( bodiesCreationFunction( ) );
+        threadCachedEphemerides.push_back( setCachedEphemerides(
+                                               threadBodies.at( i ), sharedEphemerisBodies, 100000,
+                                               sharedEphemerisGridSpacing ) );
+    }
+
+    std::vector< Eigen::VectorXd > results;
+    results.resize( numberOfObjects );
+
+    std::mutex settingsMutex;
+    utilities::executeTasksInParallel(
+                numberOfBlocks, numberOfWorkers,
+                [ & ]( const unsigned int blockIndex, const unsigned int threadIndex )
+    {
+        // Remove states of previous block from caches (states at grid epochs remain valid for all objects)
+        if( !( sharedEphemerisGridSpacing == sharedEphemerisGridSpacing ) )
+        {
+            for( unsigned int i = 0; i < threadCachedEphemerides.at( threadIndex ).size( ); i++ )
+            {
+                threadCachedEphemerides.at( threadIndex ).at( i )->clearCache( );
+            }
+        }
+
+        unsigned int blockEnd = std::min( ( blockIndex + 1 ) * blockSize, numberOfObjects );
+        for( unsigned int objectIndex = blockIndex * blockSize; objectIndex < blockEnd; objectIndex++ )
+        {
+            // Set properties of object in environment of current thread, and retrieve settings
+            std::pair< std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > >,
+                    std::shared_ptr< SingleArcPropagatorSettings< StateScalarType > > > objectSettings;
+            {
+                std::lock_guard< std::mutex > settingsLock( settingsMutex );
+                objectSettings = objectSettingsFunction( objectIndex, threadBodies.at( threadIndex ) );
+            }
+
+            // Propagate object and compute result
+            SingleArcDynamicsSimulator< StateScalarType, TimeType > dynamicsSimulator(
+                        threadBodies.at( threadIndex ), objectSettings.first, objectSettings.second, true, false, false );
+            results[ objectIndex ] = resultFunction( objectIndex, dynamicsSimulator );
+        }
+    } );
+
+    return results;
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_BATCHPROPAGATION_H
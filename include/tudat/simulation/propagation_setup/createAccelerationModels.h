@@ -27,6 +27,7 @@
 #include "tudat/astro/basic_astro/empiricalAcceleration.h"
 #include "tudat/astro/ephemerides/frameManager.h"
 #include "tudat/astro/gravitation/directTidalDissipationAcceleration.h"
+#include "tudat/astro/gravitation/manyBodyPointMassGravityModel.h"
 
 namespace tudat
 {
@@ -433,6 +434,46 @@ std::shared_ptr< basic_astrodynamics::EmpiricalAcceleration > createEmpiricalAcc
         const std::string& nameOfBodyExertingAcceleration,
         const std::shared_ptr< AccelerationSettings > accelerationSettings );
 
+//! Function to create point mass gravity accelerations on a set of bodies due to a set of bodies, evaluated in one pass
+/*!
+ *  Function to create point mass gravity accelerations on a set of bodies due to a set of bodies (all w.r.t. the same
+ *  central body), which share a single ManyBodyPointMassGravityKernel that evaluates all accelerations in one pass.
+ *  For each body exerting acceleration, a direct acceleration is created if it is the central body, or if the central
+ *  body is an inertial frame origin, and a third-body acceleration otherwise (as for point_mass_gravity settings).
+ *  \param bodiesUndergoingAcceleration Pointers to objects of bodies that are being accelerated.
+ *  \param bodiesExertingAcceleration Pointers to objects of bodies that are exerting acceleration.
+ *  \param namesOfBodiesUndergoingAcceleration Names of bodies that are being accelerated.
+ *  \param namesOfBodiesExertingAcceleration Names of bodies that are exerting acceleration.
+ *  \param centralBody Pointer to central body in frame centered at which accelerations are to be calculated (only
+ *  relevant for third body accelerations).
+ *  \param nameOfCentralBody Name of central body in frame centered at which accelerations are to be calculated.
+ *  \return Acceleration models, with outer index the body undergoing acceleration, and inner index the body exerting
+ *  acceleration
+ */
+std::vector< std::vector< std::shared_ptr< gravitation::ManyBodyPointMassGravityAcceleration > > >
+createManyBodyPointMassGravityAccelerationModels(
+        const std::vector< std::shared_ptr< Body > >& bodiesUndergoingAcceleration,
+        const std::vector< std::shared_ptr< Body > >& bodiesExertingAcceleration,
+        const std::vector< std::string >& namesOfBodiesUndergoingAcceleration,
+        const std::vector< std::string >& namesOfBodiesExertingAcceleration,
+        const std::shared_ptr< Body > centralBody,
+        const std::string& nameOfCentralBody );
+
+//! Function to create all many-body point mass gravity accelerations from a list of acceleration settings
+/*!
+ *  Function to create all many-body point mass gravity accelerations (settings of type many_body_point_mass_gravity)
+ *  from a list of acceleration settings. All bodies with the same central body, and the same list of bodies exerting
+ *  this acceleration type, share a single ManyBodyPointMassGravityKernel.
+ *  \param bodies List of pointers to bodies required for the creation of the acceleration model objects.
+ *  \param orderedAccelerationPerBody List of acceleration settings per body (settings of other types are ignored).
+ *  \param centralBodies Map of central bodies for each body undergoing acceleration.
+ *  \return Acceleration models, with key the names of the bodies undergoing and exerting acceleration, respectively.
+ */
+std::map< std::pair< std::string, std::string >, std::shared_ptr< gravitation::ManyBodyPointMassGravityAcceleration > >
+createManyBodyPointMassGravityAccelerationModels(
+        const SystemOfBodies& bodies,
+        const SelectedAccelerationList& orderedAccelerationPerBody,
+        const std::map< std::string, std::string >& centralBodies );
 
 //! Function to create acceleration model object.
 /*!
@@ -498,6 +539,11 @@ inline basic_astrodynamics::AccelerationMap createAccelerationModelsMap(
     SelectedAccelerationList orderedAccelerationPerBody =
             orderSelectedAccelerationMap( selectedAccelerationPerBody );
 
+    // Create all many-body point mass gravity accelerations at once, so that they share kernels
+    std::map< std::pair< std::string, std::string >, std::shared_ptr< gravitation::ManyBodyPointMassGravityAcceleration > >
+            manyBodyPointMassGravityAccelerations = createManyBodyPointMassGravityAccelerationModels(
+                bodies, orderedAccelerationPerBody, centralBodies );
+
     // Iterate over all bodies which are undergoing acceleration
     for( SelectedAccelerationList::const_iterator bodyIterator =
          orderedAccelerationPerBody.begin( ); bodyIterator != orderedAccelerationPerBody.end( );
@@ -562,7 +608,13 @@ inline basic_astrodynamics::AccelerationMap createAccelerationModelsMap(
                             ", but no such body found in map of bodies" );
             }
 
-            if( !( accelerationsForBody.at( i ).second->accelerationType_ == basic_astrodynamics::thrust_acceleration ) )
+            if( accelerationsForBody.at( i ).second->accelerationType_ == basic_astrodynamics::many_body_point_mass_gravity )
+            {
+                mapOfAccelerationsForBody[ bodyExertingAcceleration ].push_back(
+                            manyBodyPointMassGravityAccelerations.at(
+                                std::make_pair( bodyUndergoingAcceleration, bodyExertingAcceleration ) ) );
+            }
+            else if( !( accelerationsForBody.at( i ).second->accelerationType_ == basic_astrodynamics::thrust_acceleration ) )
             {
                 currentAcceleration = createAccelerationModel( bodies.at( bodyUndergoingAcceleration ),
                                                                bodies.at( bodyExertingAcceleration ),
@@ -19,6 +19,7 @@
 
 #include "tudat/basics/tudatTypeTraits.h"
 #include "tudat/basics/utilities.h"
+#include "tudat/basics/parallelExecution.h"
 #include "tudat/astro/propagators/nBodyStateDerivative.h"
 #include "tudat/astro/ephemerides/frameManager.h"
 #include "tudat/simulation/propagation_setup/propagationSettings.h"
@@ -467,6 +468,21 @@ public:
 
         checkPropagatedStatesFeasibility( propagatorSettings_, bodies_, setIntegratedResult_ );
 
+        if( isPropagationOutputStreamed( ) )
+        {
+            if( setIntegratedResult_ && !propagatorSettings_->getStoreHistoryInMemory( ) )
+            {
+                throw std::runtime_error( "Error in dynamics simulator, cannot set integrated result when propagation history "
+                                          "is not stored in memory." );
+            }
+
+            if( propagatorSettings_->getUseColumnarHistoryStorage( ) )
+            {
+                throw std::runtime_error( "Error in dynamics simulator, columnar history storage cannot be combined with "
+                                          "streaming of propagation output." );
+            }
+        }
+
         if( setIntegratedResult_ )
         {
             createAndSetIntegratedStateProcessors( );
@@ -582,6 +598,9 @@ public:
         // Empty solution maps
         equationsOfMotionNumericalSolution_.clear( );
         equationsOfMotionNumericalSolutionRaw_.clear( );
+        dependentVariableHistory_.clear( );
+        cumulativeComputationTimeHistory_.clear( );
+        clearColumnarHistories( );
 
         // Reset functions
         dynamicsStateDerivative_->setPropagationSettings( std::vector< IntegratedStateType >( ), 1, 0 );
@@ -591,26 +610,62 @@ public:
         // Reset initial time to ensure consistency with multi-arc propagation.
         integratorSettings_->initialTime_ = this->initialPropagationTime_;
 
+        // Ensure that environment is fully re-evaluated (environment models may have changed since last propagation)
+        environmentUpdater_->resetUpdateTimes( );
+
+        // Create profiler for current propagation, if required
+        if( propagatorSettings_->getUsePropagationProfiling( ) )
+        {
+#if( TUDAT_BUILD_WITH_PROFILING )
+            propagationProfiler_ = std::make_shared< utilities::PropagationProfiler >( );
+            dynamicsStateDerivative_->setPropagationProfiler( propagationProfiler_ );
+            environmentUpdater_->setPropagationProfiler(
+                        propagationProfiler_, dynamicsStateDerivative_->getEnvironmentUpdateProfilingScope( ) );
+#else
+            throw std::runtime_error( "Error, propagation profiling requested, but Tudat was compiled without "
+                                      "TUDAT_BUILD_WITH_PROFILING" );
+#endif
+        }
+
         // Integrate equations of motion numerically.
         resetPropagationTerminationConditions( );
+        propagationEventDetector_ = createPropagationEventDetector< StateScalarType, TimeType >(
+                    propagatorSettings_->getEventSettings( ), bodies_, dynamicsStateDerivative_->getStateDerivativeModels( ) );
         simulation_setup::setAreBodiesInPropagation( bodies_, true );
-        propagationTerminationReason_ =
-                EquationIntegrationInterface< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >, TimeType >::integrateEquations(
-                    stateDerivativeFunction_, equationsOfMotionNumericalSolutionRaw_,
-                    dynamicsStateDerivative_->convertFromOutputSolution(
-                        initialStates, this->initialPropagationTime_ ), integratorSettings_,
-                    propagationTerminationCondition_,
-                    dependentVariableHistory_,
-                    cumulativeComputationTimeHistory_,
-                    dependentVariablesFunctions_,
-                    statePostProcessingFunction_,
-                    propagatorSettings_->getPrintInterval( ),
-                    initialClockTime_ );
+        if( propagatorSettings_->getUseFixedSizeStatePropagation( ) &&
+                dynamicsStateDerivative_->isFixedSizeStatePropagationSupported( ) )
+        {
+            typedef Eigen::Matrix< StateScalarType, 6, 1 > FixedSizeStateType;
+            std::function< FixedSizeStateType( const TimeType, const FixedSizeStateType& ) > fixedSizeStateDerivativeFunction =
+                    std::bind( &DynamicsStateDerivativeModel< TimeType, StateScalarType >::template
+                               computeFixedSizeStateDerivative< 6, 1 >,
+                               dynamicsStateDerivative_, std::placeholders::_1, std::placeholders::_2 );
+            integratePropagatedState< FixedSizeStateType >(
+                        fixedSizeStateDerivativeFunction,
+                        dynamicsStateDerivative_->convertFromOutputSolution( initialStates, this->initialPropagationTime_ ),
+                        std::function< void( FixedSizeStateType& ) >( ) );
+        }
+        else
+        {
+            integratePropagatedState< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >(
+                        stateDerivativeFunction_,
+                        dynamicsStateDerivative_->convertFromOutputSolution( initialStates, this->initialPropagationTime_ ),
+                        statePostProcessingFunction_ );
+        }
         simulation_setup::setAreBodiesInPropagation( bodies_, false );
 
         // Convert numerical solution to conventional state
-        dynamicsStateDerivative_->convertNumericalStateSolutionsToOutputSolutions(
-                    equationsOfMotionNumericalSolution_, equationsOfMotionNumericalSolutionRaw_ );
+        if( propagatorSettings_->getUseColumnarHistoryStorage( ) )
+        {
+            dynamicsStateDerivative_->convertNumericalStateSolutionsToOutputSolutions(
+                        *equationsOfMotionColumnarSolution_, *equationsOfMotionColumnarSolutionRaw_ );
+            areMapHistoriesUpToDate_ = false;
+        }
+        else
+        {
+            dynamicsStateDerivative_->convertNumericalStateSolutionsToOutputSolutions(
+                        equationsOfMotionNumericalSolution_, equationsOfMotionNumericalSolutionRaw_ );
+        }
 
         // Retrieve number of cumulative function evaluations
         cumulativeNumberOfFunctionEvaluations_ = dynamicsStateDerivative_->getCumulativeNumberOfFunctionEvaluations( );
@@ -635,6 +690,7 @@ public:
      */
     const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& getEquationsOfMotionNumericalSolution( )
     {
+        updateMapHistoriesFromColumnarHistories( );
         return equationsOfMotionNumericalSolution_;
     }
 
@@ -645,6 +701,7 @@ public:
      */
     const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& getEquationsOfMotionNumericalSolutionRaw( )
     {
+        updateMapHistoriesFromColumnarHistories( );
         return equationsOfMotionNumericalSolutionRaw_;
     }
 
@@ -655,6 +712,7 @@ public:
      */
     const std::map< TimeType, Eigen::VectorXd >& getDependentVariableHistory( )
     {
+        updateMapHistoriesFromColumnarHistories( );
         return dependentVariableHistory_;
     }
 
@@ -665,9 +723,55 @@ public:
      */
     std::map< TimeType, double > getCumulativeComputationTimeHistory( )
     {
+        updateMapHistoriesFromColumnarHistories( );
         return cumulativeComputationTimeHistory_;
     }
 
+    //! Function to return the columnar state history of numerically integrated bodies.
+    /*!
+     * Function to return the columnar state history of numerically integrated bodies, in the order in which the epochs
+     * were propagated. Only set if the propagator settings define the use of columnar history storage.
+     * \return Columnar state history of numerically integrated bodies.
+     */
+    const utilities::ColumnarHistory< TimeType, StateScalarType >& getEquationsOfMotionColumnarSolution( )
+    {
+        return *equationsOfMotionColumnarSolution_;
+    }
+
+    //! Function to return the columnar state history of numerically integrated bodies, in propagation coordinates.
+    /*!
+     * Function to return the columnar state history of numerically integrated bodies, in propagation coordinates, in the
+     * order in which the epochs were propagated. Only set if the propagator settings define the use of columnar history
+     * storage.
+     * \return Columnar state history of numerically integrated bodies, in propagation coordinates.
+     */
+    const utilities::ColumnarHistory< TimeType, StateScalarType >& getEquationsOfMotionColumnarSolutionRaw( )
+    {
+        return *equationsOfMotionColumnarSolutionRaw_;
+    }
+
+    //! Function to return the columnar dependent variable history that was saved during numerical propagation.
+    /*!
+     * Function to return the columnar dependent variable history that was saved during numerical propagation. Only set if
+     * the propagator settings define the use of columnar history storage.
+     * \return Columnar dependent variable history that was saved during numerical propagation.
+     */
+    const utilities::ColumnarHistory< TimeType, double >& getDependentVariableColumnarHistory( )
+    {
+        return *dependentVariableColumnarHistory_;
+    }
+
+    //! Function to return the columnar cumulative computation time history that was saved during numerical propagation.
+    /*!
+     * Function to return the columnar cumulative computation time history that was saved during numerical propagation.
+     * Only set if the propagator settings define the use of columnar history storage.
+     * \return Columnar cumulative computation time history that was saved during numerical propagation.
+     */
+    const utilities::ColumnarHistory< TimeType, double >& getCumulativeComputationTimeColumnarHistory( )
+    {
+        return *cumulativeComputationTimeColumnarHistory_;
+    }
+
     //! Function to return the map of number of cumulative function evaluations that was saved during numerical propagation.
     /*!
      * Function to return the map of cumulative number of function evaluations that was saved during numerical propagation.
@@ -724,6 +828,7 @@ public:
             const std::map< TimeType, Eigen::VectorXd >& dependentVariableHistory,
             const bool processSolution = true )
     {
+        clearColumnarHistories( );
         equationsOfMotionNumericalSolution_ = equationsOfMotionNumericalSolution;
         if( processSolution )
         {
@@ -787,6 +892,17 @@ public:
         return environmentUpdater_;
     }
 
+    //! Function to get the object containing the evaluation time of the models used in the last propagation
+    /*!
+     * Function to get the object containing the wall-clock time and number of calls of the models used in the last
+     * propagation, which is created if SingleArcPropagatorSettings::setUsePropagationProfiling was set to true.
+     * \return Object containing the evaluation time of the models used in the last propagation (nullptr if not profiled)
+     */
+    std::shared_ptr< utilities::PropagationProfiler > getPropagationProfiler( )
+    {
+        return propagationProfiler_;
+    }
+
     //! Function to get the object that updates and returns state derivative
     /*!
      * Function to get the object that updates current environment and returns state derivative from single function call
@@ -834,6 +950,21 @@ public:
         propagationTerminationReason_ = propagationTerminationReason;
     }
 
+    //! Function to retrieve the events detected during the last propagation
+    /*!
+     * Function to retrieve the events detected during the last propagation (see
+     * SingleArcPropagatorSettings::addEventSettings), in order of occurrence.
+     * \return Events detected during the last propagation
+     */
+    std::vector< PropagationEventOccurrence > getPropagationEvents( )
+    {
+        if( propagationEventDetector_ == nullptr )
+        {
+            return std::vector< PropagationEventOccurrence >( );
+        }
+        return propagationEventDetector_->getEventOccurrences( );
+    }
+
     //! Get whether the integration was completed successfully.
     /*!
      * Get whether the integration was completed successfully.
@@ -906,24 +1037,37 @@ public:
      */
     void processNumericalEquationsOfMotionSolution( )
     {
+        // Use columnar history directly, if propagation results are stored in columnar form
+        bool useColumnarHistory = ( equationsOfMotionColumnarSolution_->size( ) > 0 );
         try
         {
             // Create and set interpolators for ephemerides
-            resetIntegratedStates( equationsOfMotionNumericalSolution_, integratedStateProcessors_ );
+            if( useColumnarHistory )
+            {
+                resetIntegratedStates< TimeType, StateScalarType >(
+                            equationsOfMotionColumnarSolution_, integratedStateProcessors_ );
+            }
+            else
+            {
+                resetIntegratedStates( equationsOfMotionNumericalSolution_, integratedStateProcessors_ );
+            }
         }
         catch( const std::exception& caughtException )
         {
             std::cerr << "Error occured when post-processing single-arc integration results, and seting integrated states in environment, caught error is: " << std::endl << std::endl;
             std::cerr << caughtException.what( ) << std::endl << std::endl;
             std::cerr << "The problem may be that there is an insufficient number of data points (epochs) at which propagation results are produced. Integrated results are given at" +
-                         std::to_string( equationsOfMotionNumericalSolution_.size( ) ) + " epochs"<< std::endl;
+                         std::to_string( useColumnarHistory ? equationsOfMotionColumnarSolution_->size( ) :
+                                                              equationsOfMotionNumericalSolution_.size( ) ) + " epochs"<< std::endl;
         }
 
-        // Clear numerical solution if so required.
+        // Clear numerical solution if so required (ephemerides retain the columnar history they read from).
         if( clearNumericalSolutions_ )
         {
             equationsOfMotionNumericalSolution_.clear( );
             equationsOfMotionNumericalSolutionRaw_.clear( );
+            equationsOfMotionColumnarSolution_ = std::make_shared< utilities::ColumnarHistory< TimeType, StateScalarType > >( );
+            equationsOfMotionColumnarSolutionRaw_ = std::make_shared< utilities::ColumnarHistory< TimeType, StateScalarType > >( );
         }
 
         for( auto bodyIterator : bodies_.getMap( )  )
@@ -952,6 +1096,145 @@ public:
 
 protected:
 
+    //! Function to numerically integrate the equations of motion, using the given state type in the integrator
+    /*!
+     *  Function to numerically integrate the equations of motion, using the given state type in the integrator. The
+     *  raw numerical solution, dependent variables and computation times are stored in the map or columnar histories,
+     *  depending on the propagator settings.
+     *  \param stateDerivativeFunction Function returning the state derivative from current time and state.
+     *  \param initialState Initial state, in propagator-specific form
+     *  \param statePostProcessingFunction Function to post-process state after numerical integration
+     */
+    template< typename PropagatedStateType >
+    void integratePropagatedState(
+            const std::function< PropagatedStateType( const TimeType, const PropagatedStateType& ) >& stateDerivativeFunction,
+            const PropagatedStateType& initialState,
+            const std::function< void( PropagatedStateType& ) >& statePostProcessingFunction )
+    {
+        // Save number of function evaluations once per integration step
+        std::function< void( const TimeType ) > stepCompletionFunction =
+                std::bind( &DynamicsStateDerivativeModel< TimeType, StateScalarType >::
+                           saveCumulativeNumberOfFunctionEvaluations, dynamicsStateDerivative_, std::placeholders::_1 );
+
+        if( isPropagationOutputStreamed( ) )
+        {
+            std::shared_ptr< PropagationOutputStreamer< TimeType, StateScalarType > > outputStreamer =
+                    createPropagationOutputStreamer( );
+            StreamedStateHistory< TimeType, StateScalarType > streamedStateHistory( outputStreamer );
+            StreamedDependentVariableHistory< TimeType, StateScalarType > streamedDependentVariableHistory( outputStreamer );
+            StreamedComputationTimeHistory< TimeType, StateScalarType > streamedComputationTimeHistory( outputStreamer );
+
+            outputStreamer->initialize( dependentVariableIds_ );
+            propagationTerminationReason_ =
+                    EquationIntegrationInterface< PropagatedStateType, TimeType >::integrateEquations(
+                        stateDerivativeFunction, streamedStateHistory,
+                        initialState, integratorSettings_,
+                        propagationTerminationCondition_,
+                        streamedDependentVariableHistory,
+                        streamedComputationTimeHistory,
+                        dependentVariablesFunctions_,
+                        statePostProcessingFunction,
+                        propagatorSettings_->getPrintInterval( ),
+                        initialClockTime_,
+                        propagationEventDetector_,
+                        stepCompletionFunction );
+            outputStreamer->finalize( );
+        }
+        else if( propagatorSettings_->getUseColumnarHistoryStorage( ) )
+        {
+            propagationTerminationReason_ =
+                    EquationIntegrationInterface< PropagatedStateType, TimeType >::integrateEquations(
+                        stateDerivativeFunction, *equationsOfMotionColumnarSolutionRaw_,
+                        initialState, integratorSettings_,
+                        propagationTerminationCondition_,
+                        *dependentVariableColumnarHistory_,
+                        *cumulativeComputationTimeColumnarHistory_,
+                        dependentVariablesFunctions_,
+                        statePostProcessingFunction,
+                        propagatorSettings_->getPrintInterval( ),
+                        initialClockTime_,
+                        propagationEventDetector_,
+                        stepCompletionFunction );
+        }
+        else
+        {
+            propagationTerminationReason_ =
+                    EquationIntegrationInterface< PropagatedStateType, TimeType >::integrateEquations(
+                        stateDerivativeFunction, equationsOfMotionNumericalSolutionRaw_,
+                        initialState, integratorSettings_,
+                        propagationTerminationCondition_,
+                        dependentVariableHistory_,
+                        cumulativeComputationTimeHistory_,
+                        dependentVariablesFunctions_,
+                        statePostProcessingFunction,
+                        propagatorSettings_->getPrintInterval( ),
+                        initialClockTime_,
+                        propagationEventDetector_,
+                        stepCompletionFunction );
+        }
+    }
+
+    //! Function to check whether the propagation output is streamed to output sinks, or not stored in memory
+    bool isPropagationOutputStreamed( )
+    {
+        return ( propagatorSettings_->getOutputSinks( ).size( ) > 0 ) || !propagatorSettings_->getStoreHistoryInMemory( );
+    }
+
+    //! Function to create the object that streams the propagation output to the output sinks (and in-memory histories)
+    std::shared_ptr< PropagationOutputStreamer< TimeType, StateScalarType > > createPropagationOutputStreamer( )
+    {
+        std::vector< std::shared_ptr< PropagationOutputSinkBase > > outputSinks = propagatorSettings_->getOutputSinks( );
+        std::vector< std::shared_ptr< PropagationOutputSink< TimeType, StateScalarType > > > typedOutputSinks;
+        for( unsigned int i = 0; i < outputSinks.size( ); i++ )
+        {
+            std::shared_ptr< PropagationOutputSink< TimeType, StateScalarType > > typedOutputSink =
+                    std::dynamic_pointer_cast< PropagationOutputSink< TimeType, StateScalarType > >( outputSinks.at( i ) );
+            if( typedOutputSink == nullptr )
+            {
+                throw std::runtime_error( "Error in dynamics simulator, output sink " + std::to_string( i ) +
+                                          " is not compatible with time and state scalar type of propagation." );
+            }
+            typedOutputSinks.push_back( typedOutputSink );
+        }
+
+        bool storeHistoryInMemory = propagatorSettings_->getStoreHistoryInMemory( );
+        return std::make_shared< PropagationOutputStreamer< TimeType, StateScalarType > >(
+                    typedOutputSinks,
+                    std::bind( &DynamicsStateDerivativeModel< TimeType, StateScalarType >::convertToOutputSolution,
+                               dynamicsStateDerivative_, std::placeholders::_1, std::placeholders::_2 ),
+                    storeHistoryInMemory ? &equationsOfMotionNumericalSolutionRaw_ : nullptr,
+                    storeHistoryInMemory ? &dependentVariableHistory_ : nullptr,
+                    storeHistoryInMemory ? &cumulativeComputationTimeHistory_ : nullptr );
+    }
+
+    //! Function to clear the columnar histories (if any) of the last propagation
+    /*!
+     *  Function to clear the columnar histories (if any) of the last propagation. New (empty) histories are created, so
+     *  that the histories of the last propagation remain valid for any object (such as an ephemeris interpolator) that
+     *  still reads them.
+     */
+    void clearColumnarHistories( )
+    {
+        equationsOfMotionColumnarSolution_ = std::make_shared< utilities::ColumnarHistory< TimeType, StateScalarType > >( );
+        equationsOfMotionColumnarSolutionRaw_ = std::make_shared< utilities::ColumnarHistory< TimeType, StateScalarType > >( );
+        dependentVariableColumnarHistory_ = std::make_shared< utilities::ColumnarHistory< TimeType, double > >( );
+        cumulativeComputationTimeColumnarHistory_ = std::make_shared< utilities::ColumnarHistory< TimeType, double > >( );
+        areMapHistoriesUpToDate_ = true;
+    }
+
+    //! Function to create the map representation of the history from the columnar history, if it is not yet up to date.
+    void updateMapHistoriesFromColumnarHistories( )
+    {
+        if( !areMapHistoriesUpToDate_ )
+        {
+            equationsOfMotionNumericalSolution_ = equationsOfMotionColumnarSolution_->convertToMap( );
+            equationsOfMotionNumericalSolutionRaw_ = equationsOfMotionColumnarSolutionRaw_->convertToMap( );
+            dependentVariableHistory_ = dependentVariableColumnarHistory_->template convertToMap< Eigen::VectorXd >( );
+            cumulativeComputationTimeHistory_ = cumulativeComputationTimeColumnarHistory_->convertToScalarMap( );
+            areMapHistoriesUpToDate_ = true;
+        }
+    }
+
     //! List of object (per dynamics type) that process the integrated numerical solution by updating the environment
     std::map< IntegratedStateType, std::vector< std::shared_ptr<
     IntegratedStateProcessor< TimeType, StateScalarType > > > > integratedStateProcessors_;
@@ -963,6 +1246,9 @@ protected:
      */
     std::shared_ptr< EnvironmentUpdater< StateScalarType, TimeType > > environmentUpdater_;
 
+    //! Object containing the evaluation time of the models used in the last propagation (nullptr if not profiled)
+    std::shared_ptr< utilities::PropagationProfiler > propagationProfiler_;
+
     //! Interface object that updates current environment and returns state derivative from single function call.
     std::shared_ptr< DynamicsStateDerivativeModel< TimeType, StateScalarType > > dynamicsStateDerivative_;
 
@@ -994,6 +1280,9 @@ protected:
     //! Object defining when the propagation is to be terminated.
     std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition_;
 
+    //! Object used to detect events during the propagation (nullptr if no events are defined).
+    std::shared_ptr< PropagationEventDetector > propagationEventDetector_;
+
     //! Function returning dependent variables (during numerical propagation)
     std::function< Eigen::VectorXd( ) > dependentVariablesFunctions_;
 
@@ -1033,6 +1322,30 @@ protected:
     //! Map of cumulative number of function evaluations that was saved during numerical propagation.
     std::map< TimeType, unsigned int > cumulativeNumberOfFunctionEvaluations_;
 
+    //! Columnar state history of numerically integrated bodies (only used if set in propagator settings)
+    /*!
+     *  Columnar state history of numerically integrated bodies (only used if set in propagator settings). The ephemerides
+     *  that are reset from this history share ownership of it.
+     */
+    std::shared_ptr< utilities::ColumnarHistory< TimeType, StateScalarType > > equationsOfMotionColumnarSolution_ =
+            std::make_shared< utilities::ColumnarHistory< TimeType, StateScalarType > >( );
+
+    //! Columnar state history of numerically integrated bodies, in propagation coordinates (only used if set in
+    //! propagator settings)
+    std::shared_ptr< utilities::ColumnarHistory< TimeType, StateScalarType > > equationsOfMotionColumnarSolutionRaw_ =
+            std::make_shared< utilities::ColumnarHistory< TimeType, StateScalarType > >( );
+
+    //! Columnar dependent variable history (only used if set in propagator settings)
+    std::shared_ptr< utilities::ColumnarHistory< TimeType, double > > dependentVariableColumnarHistory_ =
+            std::make_shared< utilities::ColumnarHistory< TimeType, double > >( );
+
+    //! Columnar cumulative computation time history (only used if set in propagator settings)
+    std::shared_ptr< utilities::ColumnarHistory< TimeType, double > > cumulativeComputationTimeColumnarHistory_ =
+            std::make_shared< utilities::ColumnarHistory< TimeType, double > >( );
+
+    //! Boolean denoting whether the map histories are consistent with the columnar histories
+    bool areMapHistoriesUpToDate_ = true;
+
     //! Initial time of propagation
     double initialPropagationTime_;
 
@@ -1197,6 +1510,8 @@ public:
                                 bodies, integratorSettings, singleArcSettings.at( i ), false, false, false ) );
                 singleArcDynamicsSimulators_[ i ]->createAndSetIntegratedStateProcessors( );
             }
+            integratedStateProcessors_ = singleArcDynamicsSimulators_.at( 0 )->getIntegratedStateProcessors( );
+            setArcResourceIdentifiers( std::vector< simulation_setup::SystemOfBodies >( singleArcSettings.size( ), bodies ) );
 
             equationsOfMotionNumericalSolution_.resize( arcStartTimes.size( ) );
             dependentVariableHistory_.resize( arcStartTimes.size( ) );
@@ -1260,6 +1575,89 @@ public:
                                 bodies, integratorSettings.at( i ), singleArcSettings.at( i ), false, false, false ) );
                 singleArcDynamicsSimulators_[ i ]->createAndSetIntegratedStateProcessors( );
             }
+            integratedStateProcessors_ = singleArcDynamicsSimulators_.at( 0 )->getIntegratedStateProcessors( );
+            setArcResourceIdentifiers( std::vector< simulation_setup::SystemOfBodies >( singleArcSettings.size( ), bodies ) );
+
+            equationsOfMotionNumericalSolution_.resize( singleArcSettings.size( ) );
+            dependentVariableHistory_.resize( singleArcSettings.size( ) );
+            cumulativeComputationTimeHistory_.resize( singleArcSettings.size( ) );
+            propagationTerminationReasons_.resize( singleArcSettings.size( ) );
+
+            // Integrate equations of motion if required.
+            if( areEquationsOfMotionToBeIntegrated )
+            {
+                integrateEquationsOfMotion( multiArcPropagatorSettings_->getInitialStates( ) );
+            }
+        }
+    }
+
+    //! Constructor of multi-arc simulator with a separate environment per arc, allowing arcs to be propagated concurrently.
+    /*!
+     *  Constructor of multi-arc simulator with a separate environment per arc, allowing arcs to be propagated concurrently.
+     *  Each arc is propagated using its own SystemOfBodies (and therefore its own body states and EnvironmentUpdater), which
+     *  must be the SystemOfBodies with which the models in the associated single-arc propagator settings were created. Arcs
+     *  that share any Body object or IntegratorSettings object are never propagated concurrently, so that passing the same
+     *  environment for several arcs is allowed (but will limit the concurrency). Arcs for which the initial state is taken
+     *  from the previous arc are propagated after that arc, by the same thread. The results of each arc are identical to
+     *  those obtained from a sequential propagation. Note that the environment models used during propagation must be safe
+     *  to evaluate concurrently (in particular, ephemerides that directly call Spice are not).
+     *  After propagation, the results are processed in the environment defined by the bodies input.
+     *  \param bodies Map of bodies (with names) in which the propagation results are to be set.
+     *  \param arcBodies List of bodies (one SystemOfBodies per arc) in which each arc is to be propagated.
+     *  \param integratorSettings List of integrator settings for numerical integrator, defined per arc.
+     *  \param propagatorSettings Propagator settings for dynamics (must be of multi arc type)
+     *  \param numberOfThreads Maximum number of threads over which the arcs are distributed (0 denotes all available threads).
+     *  \param areEquationsOfMotionToBeIntegrated Boolean to denote whether equations of motion should be integrated at
+     *  the end of the contructor or not.
+     *  \param clearNumericalSolutions Boolean to determine whether to clear the raw numerical solution member variables
+     *  after propagation and resetting ephemerides (default true).
+     *  \param setIntegratedResult Boolean to determine whether to automatically use the integrated results to set
+     *  ephemerides (default true).
+     */
+    MultiArcDynamicsSimulator(
+            const simulation_setup::SystemOfBodies& bodies,
+            const std::vector< simulation_setup::SystemOfBodies >& arcBodies,
+            const std::vector< std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > > integratorSettings,
+            const std::shared_ptr< PropagatorSettings< StateScalarType > > propagatorSettings,
+            const unsigned int numberOfThreads,
+            const bool areEquationsOfMotionToBeIntegrated = true,
+            const bool clearNumericalSolutions = true,
+            const bool setIntegratedResult = true ):
+        DynamicsSimulator< StateScalarType, TimeType >(
+            bodies, clearNumericalSolutions, setIntegratedResult ),
+        numberOfThreads_( numberOfThreads )
+    {
+        multiArcPropagatorSettings_ =
+                std::dynamic_pointer_cast< MultiArcPropagatorSettings< StateScalarType > >( propagatorSettings );
+        if( multiArcPropagatorSettings_ == nullptr )
+        {
+            throw std::runtime_error( "Error when creating multi-arc dynamics simulator, input is not multi arc" );
+        }
+        else
+        {
+            std::vector< std::shared_ptr< SingleArcPropagatorSettings< StateScalarType > > > singleArcSettings =
+                    multiArcPropagatorSettings_->getSingleArcSettings( );
+
+            if( ( singleArcSettings.size( ) != integratorSettings.size( ) ) ||
+                    ( singleArcSettings.size( ) != arcBodies.size( ) ) )
+            {
+                throw std::runtime_error( "Error when creating multi-arc dynamics simulator, input sizes are inconsistent" );
+            }
+
+            arcStartTimes_.resize( singleArcSettings.size( ) );
+
+            // Create dynamics simulators, each operating on its own environment
+            for( unsigned int i = 0; i < singleArcSettings.size( ); i++ )
+            {
+                singleArcDynamicsSimulators_.push_back(
+                            std::make_shared< SingleArcDynamicsSimulator< StateScalarType, TimeType > >(
+                                arcBodies.at( i ), integratorSettings.at( i ), singleArcSettings.at( i ), false, false, false ) );
+            }
+
+            // Create objects to set propagation results in (main) environment
+            integratedStateProcessors_ = createIntegratedStateProcessors< TimeType, StateScalarType >(
+                        singleArcSettings.at( 0 ), bodies_, simulation_setup::createFrameManager( bodies_.getMap( ) ) );
+            setArcResourceIdentifiers( arcBodies );
 
             equationsOfMotionNumericalSolution_.resize( singleArcSettings.size( ) );
             dependentVariableHistory_.resize( singleArcSettings.size( ) );
@@ -1336,41 +1734,55 @@ public:
         }
 
 
-        Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > currentArcInitialState;
         std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > arcInitialStateList;
-        bool updateInitialStates = false;
+        arcInitialStateList.resize( singleArcDynamicsSimulators_.size( ) );
 
-        // Propagate dynamics for each arc
+        // Check which arcs have their initial state taken from the previous arc (signalled by NaN initial state), this
+        // indicates that the initial states in propagator settings need to be updated.
+        std::vector< bool > isInitialStateFromPreviousArc;
+        bool updateInitialStates = false;
         for( unsigned int i = 0; i < singleArcDynamicsSimulators_.size( ); i++ )
         {
-            // Get arc initial state. If initial state is NaN, this signals that the initial state is to be taken from previous
-            // arc
-            if( ( i == 0 ) || ( !linear_algebra::doesMatrixHaveNanEntries( initialStatesList.at( i ) ) ) )
+            isInitialStateFromPreviousArc.push_back(
+                        ( i > 0 ) && linear_algebra::doesMatrixHaveNanEntries( initialStatesList.at( i ) ) );
+            if( isInitialStateFromPreviousArc.at( i ) )
             {
-                currentArcInitialState = initialStatesList.at( i );
+                updateInitialStates = true;
             }
-            else
+        }
+
+        // Propagate dynamics for each group of arcs that can be propagated independently of the others, arcs in a single
+        // group are propagated in order.
+        std::vector< std::vector< unsigned int > > arcGroups = getIndependentArcGroups( isInitialStateFromPreviousArc );
+        utilities::executeTasksInParallel(
+                    arcGroups.size( ), numberOfThreads_,
+                    [ & ]( const unsigned int groupIndex, const unsigned int )
+        {
+            for( unsigned int i : arcGroups.at( groupIndex ) )
             {
-                currentArcInitialState = getArcInitialStateFromPreviousArcResult(
-                            equationsOfMotionNumericalSolution_.at( i - 1 ),
-                            singleArcDynamicsSimulators_.at( i )->getInitialPropagationTime( ) );
+                // Get arc initial state.
+                if( !isInitialStateFromPreviousArc.at( i ) )
+                {
+                    arcInitialStateList[ i ] = initialStatesList.at( i );
+                }
+                else
+                {
+                    arcInitialStateList[ i ] = getArcInitialStateFromPreviousArcResult(
+                                equationsOfMotionNumericalSolution_.at( i - 1 ),
+                                singleArcDynamicsSimulators_.at( i )->getInitialPropagationTime( ) );
+                }
 
-                // If arc initial state is taken from previous arc, this indicates that the initial states in propagator settings
-                // need to be updated.
-                updateInitialStates = true;
+                singleArcDynamicsSimulators_.at( i )->integrateEquationsOfMotion( arcInitialStateList[ i ] );
+                equationsOfMotionNumericalSolution_[ i ] =
+                        std::move( singleArcDynamicsSimulators_.at( i )->getEquationsOfMotionNumericalSolution( ) );
+                dependentVariableHistory_[ i ] =
+                        std::move( singleArcDynamicsSimulators_.at( i )->getDependentVariableHistory( ) );
+                cumulativeComputationTimeHistory_[ i ] =
+                        std::move( singleArcDynamicsSimulators_.at( i )->getCumulativeComputationTimeHistory( ) );
+                propagationTerminationReasons_[ i ] = singleArcDynamicsSimulators_.at( i )->getPropagationTerminationReason( );
+                arcStartTimes_[ i ] = equationsOfMotionNumericalSolution_[ i ].begin( )->first;
             }
-            arcInitialStateList.push_back( currentArcInitialState );
-
-            singleArcDynamicsSimulators_.at( i )->integrateEquationsOfMotion( currentArcInitialState );
-            equationsOfMotionNumericalSolution_[ i ] =
-                    std::move( singleArcDynamicsSimulators_.at( i )->getEquationsOfMotionNumericalSolution( ) );
-            dependentVariableHistory_[ i ] =
-                    std::move( singleArcDynamicsSimulators_.at( i )->getDependentVariableHistory( ) );
-            cumulativeComputationTimeHistory_[ i ] =
-                    std::move( singleArcDynamicsSimulators_.at( i )->getCumulativeComputationTimeHistory( ) );
-            propagationTerminationReasons_[ i ] = singleArcDynamicsSimulators_.at( i )->getPropagationTerminationReason( );
-            arcStartTimes_[ i ] = equationsOfMotionNumericalSolution_[ i ].begin( )->first;
-        }
+        } );
 
         if( updateInitialStates )
         {
@@ -1547,8 +1959,7 @@ public:
         {
             // Create and set interpolators for ephemerides
             resetIntegratedMultiArcStatesWithEqualArcDynamics(
-                        equationsOfMotionNumericalSolution_,
-                        singleArcDynamicsSimulators_.at( 0 )->getIntegratedStateProcessors( ), arcStartTimes_ );
+                        equationsOfMotionNumericalSolution_, integratedStateProcessors_, arcStartTimes_ );
         }
         catch( const std::exception& caughtException )
         {
@@ -1584,8 +1995,117 @@ public:
         propagationTerminationReasons_[ arcIndex ] = propagationTerminationReason;
     }
 
+    //! Function to retrieve the maximum number of threads over which the arcs are distributed during propagation
+    /*!
+     * Function to retrieve the maximum number of threads over which the arcs are distributed during propagation
+     * \return Maximum number of threads over which the arcs are distributed (0 denotes all available threads)
+     */
+    unsigned int getNumberOfThreads( )
+    {
+        return numberOfThreads_;
+    }
+
+    //! Function to reset the maximum number of threads over which the arcs are distributed during propagation
+    /*!
+     * Function to reset the maximum number of threads over which the arcs are distributed during propagation. Note that
+     * arcs that share an environment (Body objects) or integrator settings are always propagated sequentially.
+     * \param numberOfThreads Maximum number of threads over which the arcs are distributed (0 denotes all available threads)
+     */
+    void setNumberOfThreads( const unsigned int numberOfThreads )
+    {
+        numberOfThreads_ = numberOfThreads;
+    }
+
 protected:
 
+    //! Function to set the list of objects that each arc modifies during its propagation
+    /*!
+     * Function to set the list of objects that each arc modifies during its propagation (its Body and IntegratorSettings
+     * objects), used to determine which arcs can be propagated concurrently.
+     * \param arcBodies List of bodies (one SystemOfBodies per arc) in which each arc is propagated.
+     */
+    void setArcResourceIdentifiers( const std::vector< simulation_setup::SystemOfBodies >& arcBodies )
+    {
+        arcResourceIdentifiers_.clear( );
+        for( unsigned int i = 0; i < arcBodies.size( ); i++ )
+        {
+            std::vector< const void* > currentArcResources;
+            for( auto bodyIterator : arcBodies.at( i ).getMap( ) )
+            {
+                currentArcResources.push_back( bodyIterator.second.get( ) );
+            }
+            currentArcResources.push_back( singleArcDynamicsSimulators_.at( i )->getIntegratorSettings( ).get( ) );
+            arcResourceIdentifiers_.push_back( currentArcResources );
+        }
+    }
+
+    //! Function to split the arcs into groups that can be propagated independently of one another.
+    /*!
+     * Function to split the arcs into groups that can be propagated independently of one another. Two arcs are put in the
+     * same group if they share a Body or IntegratorSettings object, or if the initial state of one is taken from the
+     * propagation result of the other. The arcs in each group are sorted in increasing order.
+     * \param isInitialStateFromPreviousArc List of booleans denoting, per arc, whether its initial state is taken from the
+     * previous arc.
+     * \return List of groups of arc indices that can be propagated independently of one another.
+     */
+    std::vector< std::vector< unsigned int > > getIndependentArcGroups(
+            const std::vector< bool >& isInitialStateFromPreviousArc )
+    {
+        unsigned int numberOfArcs = singleArcDynamicsSimulators_.size( );
+
+        // Define group of each arc as a disjoint-set forest
+        std::vector< unsigned int > arcGroupParent( numberOfArcs );
+        for( unsigned int i = 0; i < numberOfArcs; i++ )
+        {
+            arcGroupParent[ i ] = i;
+        }
+        auto getGroupRoot = [ & ]( unsigned int arcIndex )
+        {
+            while( arcGroupParent.at( arcIndex ) != arcIndex )
+            {
+                arcGroupParent[ arcIndex ] = arcGroupParent.at( arcGroupParent.at( arcIndex ) );
+                arcIndex = arcGroupParent.at( arcIndex );
+            }
+            return arcIndex;
+        };
+        auto mergeGroups = [ & ]( const unsigned int firstArc, const unsigned int secondArc )
+        {
+            unsigned int firstRoot = getGroupRoot( firstArc );
+            unsigned int secondRoot = getGroupRoot( secondArc );
+            arcGroupParent[ std::max( firstRoot, secondRoot ) ] = std::min( firstRoot, secondRoot );
+        };
+
+        // Merge arcs with shared resources, and arcs that require results of the previous arc.
+        std::map< const void*, unsigned int > resourceOwners;
+        for( unsigned int i = 0; i < numberOfArcs; i++ )
+        {
+            for( const void* currentResource : arcResourceIdentifiers_.at( i ) )
+            {
+                if( resourceOwners.count( currentResource ) == 0 )
+                {
+                    resourceOwners[ currentResource ] = i;
+                }
+                else
+                {
+                    mergeGroups( resourceOwners.at( currentResource ), i );
+                }
+            }
+
+            if( isInitialStateFromPreviousArc.at( i ) )
+            {
+                mergeGroups( i - 1, i );
+            }
+        }
+
+        // Collect arcs per group
+        std::map< unsigned int, std::vector< unsigned int > > arcsPerGroup;
+        for( unsigned int i = 0; i < numberOfArcs; i++ )
+        {
+            arcsPerGroup[ getGroupRoot( i ) ].push_back( i );
+        }
+        return utilities::createVectorFromMapValues( arcsPerGroup );
+    }
+
     //! List of maps of state history of numerically integrated states.
     /*!
      *  List of maps of state history of numerically integrated states. Each entry in the list contains data on a single arc.
@@ -1609,6 +2129,16 @@ protected:
 
     //! Propagator settings used by this objec
     std::shared_ptr< MultiArcPropagatorSettings< StateScalarType > > multiArcPropagatorSettings_;
+
+    //! List of object (per dynamics type) that process the integrated numerical solution by updating the environment
+    std::map< IntegratedStateType, std::vector< std::shared_ptr<
+    IntegratedStateProcessor< TimeType, StateScalarType > > > > integratedStateProcessors_;
+
+    //! List (per arc) of identifiers of the objects that are modified when propagating the arc
+    std::vector< std::vector< const void* > > arcResourceIdentifiers_;
+
+    //! Maximum number of threads over which the arcs are distributed (0 denotes all available threads)
+    unsigned int numberOfThreads_ = 1;
 };
 
 //! Class for performing full numerical integration of a dynamical system, with a compbination of single and multi-arc propagations
@@ -14,6 +14,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <set>
 
 #include <boost/bind/bind.hpp>
 using namespace boost::placeholders;
@@ -23,6 +24,7 @@ using namespace boost::placeholders;
 #include <boost/tuple/tuple_comparison.hpp>
 #include <boost/tuple/tuple_io.hpp>
 
+#include "tudat/basics/propagationProfiler.h"
 #include "tudat/simulation/environment_setup/body.h"
 #include "tudat/astro/gravitation/timeDependentSphericalHarmonicsGravityField.h"
 #include "tudat/simulation/propagation_setup/propagationSettings.h"
@@ -72,6 +74,10 @@ public:
         // Set update function to be evaluated as dependent variables of state and time during each
         // integration time step.
         setUpdateFunctions( updateSettings );
+        setIntegratedStateBodies( );
+
+        // No profiling scopes are set until a profiler is provided
+        updateFunctionProfilingScopes_.resize( updateSteps_.size( ), -1 );
     }
 
     //! Function to update the environment to the current state and time.
@@ -111,21 +117,139 @@ public:
         }
 
         // Set integrated state variables in environment.
-        setIntegratedStatesInEnvironment( integratedStatesToSet );
+        {
+            TUDAT_PROFILE_SCOPE( profiler_.get( ), integratedStateProfilingScope_ );
+            setIntegratedStatesInEnvironment( integratedStatesToSet );
 
-        // Set current state from environment for override settings setIntegratedStatesFromEnvironment
-        setStatesFromEnvironment( setIntegratedStatesFromEnvironment, currentTime );
+            // Set current state from environment for override settings setIntegratedStatesFromEnvironment
+            setStatesFromEnvironment( setIntegratedStatesFromEnvironment, currentTime );
+        }
 
-        // Evaluate time-dependent update functions (dependent variables of state and time)
-        // determined by setUpdateFunctions
-        for( unsigned int i = 0; i < updateFunctionVector_.size( ); i++ )
+        // Evaluate time-dependent updates (dependent variables of state and time) determined by setUpdateFunctions
+        for( unsigned int i = 0; i < updateSteps_.size( ); i++ )
         {
-            updateFunctionVector_.at( i ).template get< 2 >( )( currentTime );
+            TUDAT_PROFILE_SCOPE( profiler_.get( ), updateFunctionProfilingScopes_.at( i ) );
+            EnvironmentUpdateStep& currentUpdateStep = updateSteps_[ i ];
+            switch( currentUpdateStep.updateType )
+            {
+            case body_translational_state_update:
+            {
+                // Only force recomputation of ephemeris state if time has changed (body retains the state at the time of
+                // the last computation)
+                if( !( currentUpdateStep.previousUpdateTime == currentTime ) )
+                {
+                    currentUpdateStep.body->recomputeStateOnNextCall( );
+                    currentUpdateStep.previousUpdateTime = currentTime;
+                }
+                currentUpdateStep.body->template setStateFromEphemeris< StateScalarType, TimeType >( currentTime );
+                break;
+            }
+            case body_rotational_state_update:
+            {
+                if( !currentUpdateStep.isTimeDependentOnly || !( currentUpdateStep.previousUpdateTime == currentTime ) )
+                {
+                    currentUpdateStep.body->template setCurrentRotationalStateToLocalFrameFromEphemeris< TimeType >(
+                                currentTime );
+                    currentUpdateStep.previousUpdateTime = currentTime;
+                }
+                break;
+            }
+            case body_mass_update:
+            {
+                currentUpdateStep.body->updateMass( currentTime );
+                break;
+            }
+            default:
+                currentUpdateStep.updateFunction( currentTime );
+            }
+        }
+    }
+
+    //! Function to reset the times at which the environment was last updated
+    /*!
+     * Function to reset the times at which the environment was last updated. Updates that depend only on time (states
+     * and rotations from ephemerides) are not re-evaluated when the environment is updated repeatedly at the same time
+     * (e.g. by subsequent stages of an integrator). Calling this function forces all updates to be re-evaluated on the
+     * next call to updateEnvironment, and should be used when the environment models may have been modified (e.g. before
+     * a new propagation).
+     */
+    void resetUpdateTimes( )
+    {
+        for( unsigned int i = 0; i < updateSteps_.size( ); i++ )
+        {
+            updateSteps_[ i ].previousUpdateTime = TimeType( TUDAT_NAN );
+        }
+    }
+
+    //! Function to set the profiler in which the evaluation time of the environment updates is to be recorded
+    /*!
+     * Function to set the profiler in which the evaluation time of the environment updates is to be recorded. A scope is
+     * created for the setting of the integrated states in the environment, and for each update function (named by
+     * the type of environment update and the name of the associated body). Timing is only performed if
+     * TUDAT_BUILD_WITH_PROFILING is enabled.
+     * \param profiler Profiler in which the evaluation time is to be recorded (nullptr to disable)
+     * \param parentScopeIndex Index of the profiler scope in which the environment update scopes are nested (-1 if none)
+     */
+    void setPropagationProfiler( const std::shared_ptr< utilities::PropagationProfiler > profiler,
+                                 const int parentScopeIndex = -1 )
+    {
+        profiler_ = profiler;
+        integratedStateProfilingScope_ = -1;
+        updateFunctionProfilingScopes_.assign( updateSteps_.size( ), -1 );
+        if( profiler_ != nullptr )
+        {
+            integratedStateProfilingScope_ = profiler_->addScope( "integrated_state_update", parentScopeIndex );
+            for( unsigned int i = 0; i < updateSteps_.size( ); i++ )
+            {
+                updateFunctionProfilingScopes_[ i ] = profiler_->addScope(
+                            getEnvironmentModelToUpdateName( updateSteps_.at( i ).updateType ) + ":" +
+                            updateSteps_.at( i ).bodyName, parentScopeIndex );
+            }
         }
     }
 
 private:
 
+    //! Single update of the environment, as evaluated (in order) by updateEnvironment
+    struct EnvironmentUpdateStep
+    {
+        //! Constructor
+        /*!
+         * Constructor
+         * \param updateType Type of environment update
+         * \param bodyName Name of body for which the update is performed
+         * \param body Body for which the update is performed
+         * \param isTimeDependentOnly Boolean denoting whether the update depends on time only
+         * \param updateFunction Function performing the update (only for update types that are not evaluated directly
+         * on the body)
+         */
+        EnvironmentUpdateStep( const EnvironmentModelsToUpdate updateType,
+                               const std::string& bodyName,
+                               const std::shared_ptr< simulation_setup::Body > body,
+                               const bool isTimeDependentOnly,
+                               const std::function< void( const double ) > updateFunction = nullptr ):
+            updateType( updateType ), bodyName( bodyName ), body( body ), isTimeDependentOnly( isTimeDependentOnly ),
+            updateFunction( updateFunction ), previousUpdateTime( TUDAT_NAN ){ }
+
+        //! Type of environment update
+        EnvironmentModelsToUpdate updateType;
+
+        //! Name of body for which the update is performed
+        std::string bodyName;
+
+        //! Body for which the update is performed
+        std::shared_ptr< simulation_setup::Body > body;
+
+        //! Boolean denoting whether the update depends on time only (and need not be repeated at the same time)
+        bool isTimeDependentOnly;
+
+        //! Function performing the update (only for update types that are not evaluated directly on the body)
+        std::function< void( const double ) > updateFunction;
+
+        //! Time at which the update was last evaluated (NaN if none)
+        TimeType previousUpdateTime;
+    };
+
     //! Function to set numerically integrated states in environment.
     /*!
      * Function to set numerically integrated states in environment.  Note that these states must
@@ -148,21 +272,22 @@ private:
             case translational_state:
             {
                 // Set translational states for bodies provided as input.
-                for( unsigned int i = 0; i < integratedStates_[ translational_state ].size( ); i++ )
+                const std::vector< std::shared_ptr< simulation_setup::Body > >& bodiesWithIntegratedStates =
+                        integratedStateBodies_.at( translational_state );
+                for( unsigned int i = 0; i < bodiesWithIntegratedStates.size( ); i++ )
                 {
-                    bodyList_.at( integratedStates_[ translational_state ][ i ].first )->template
-                            setTemplatedState< StateScalarType >(
+                    bodiesWithIntegratedStates[ i ]->template setTemplatedState< StateScalarType >(
                                 integratedStateIterator_->second.segment( i * 6, 6 ) );
                 }
                 break;
             }
             case rotational_state:
             {
-                std::vector< std::pair< std::string, std::string > > bodiesWithIntegratedStates =
-                        integratedStates_.at( rotational_state );
+                const std::vector< std::shared_ptr< simulation_setup::Body > >& bodiesWithIntegratedStates =
+                        integratedStateBodies_.at( rotational_state );
                 for( unsigned int i = 0; i < bodiesWithIntegratedStates.size( ); i++ )
                 {
-                    bodyList_.at( bodiesWithIntegratedStates[ i ].first )->setCurrentRotationalStateToLocalFrame(
+                    bodiesWithIntegratedStates[ i ]->setCurrentRotationalStateToLocalFrame(
                                 integratedStateIterator_->second.segment( i * 7, 7 ).template cast< double >( ) );
                 }
                 break;
@@ -170,13 +295,12 @@ private:
             case body_mass_state:
             {
                 // Set mass for bodies provided as input.
-                std::vector< std::pair< std::string, std::string > > bodiesWithIntegratedMass =
-                        integratedStates_.at( body_mass_state );
+                const std::vector< std::shared_ptr< simulation_setup::Body > >& bodiesWithIntegratedMass =
+                        integratedStateBodies_.at( body_mass_state );
 
                 for( unsigned int i = 0; i < bodiesWithIntegratedMass.size( ); i++ )
                 {
-                    bodyList_.at( bodiesWithIntegratedMass[ i ].first )
-                            ->setConstantBodyMass( integratedStateIterator_->second( i ) );
+                    bodiesWithIntegratedMass[ i ]->setConstantBodyMass( integratedStateIterator_->second( i ) );
                 }
                 break;
             }
@@ -210,23 +334,21 @@ private:
             case translational_state:
             {
                 // Iterate over all integrated translational states.
-                std::vector< std::pair< std::string, std::string > > bodiesWithIntegratedStates =
-                        integratedStates_[ translational_state ];
+                const std::vector< std::shared_ptr< simulation_setup::Body > >& bodiesWithIntegratedStates =
+                        integratedStateBodies_.at( translational_state );
                 for( unsigned int i = 0; i < bodiesWithIntegratedStates.size( ); i++ )
                 {
-                    bodyList_.at( bodiesWithIntegratedStates[ i ].first )->
-                            template setStateFromEphemeris< StateScalarType, TimeType >( currentTime );
-
+                    bodiesWithIntegratedStates[ i ]->template setStateFromEphemeris< StateScalarType, TimeType >( currentTime );
                 }
                 break;
             }
             case rotational_state:
             {
-                std::vector< std::pair< std::string, std::string > > bodiesWithIntegratedStates =
-                        integratedStates_.at( rotational_state );
+                const std::vector< std::shared_ptr< simulation_setup::Body > >& bodiesWithIntegratedStates =
+                        integratedStateBodies_.at( rotational_state );
                 for( unsigned int i = 0; i < bodiesWithIntegratedStates.size( ); i++ )
                 {
-                    bodyList_.at( bodiesWithIntegratedStates[ i ].first )->template setCurrentRotationalStateToLocalFrameFromEphemeris< TimeType >(
+                    bodiesWithIntegratedStates[ i ]->template setCurrentRotationalStateToLocalFrameFromEphemeris< TimeType >(
                                 currentTime );
                 }
                 break;
@@ -234,13 +356,11 @@ private:
             case body_mass_state:
             {
                 // Iterate over all integrated masses.
-                std::vector< std::pair< std::string, std::string > > bodiesWithIntegratedStates =
-                        integratedStates_.at( body_mass_state );
+                const std::vector< std::shared_ptr< simulation_setup::Body > >& bodiesWithIntegratedStates =
+                        integratedStateBodies_.at( body_mass_state );
                 for( unsigned int i = 0; i < bodiesWithIntegratedStates.size( ); i++ )
                 {
-                    bodyList_.at( bodiesWithIntegratedStates[ i ].first )->
-                            updateMass( currentTime );
-
+                    bodiesWithIntegratedStates[ i ]->updateMass( currentTime );
                 }
                 break;
             }
@@ -251,143 +371,96 @@ private:
         }
     }
 
-    //! Function to set the order in which the updateFunctionVector_ is to be updated.
+    //! Function to retrieve the index of an update in updateSteps_
     /*!
-     *  Function to set the order in which the updateFunctionVector_ is to be updated. Order is determined recursively in
-     *  this function,  the variable iterationNumber keeps track of the number of nested calls to the function.
-     *  \param iterationNumber Number of subsequent calls to this funtion
+     *  Function to retrieve the index of an update in updateSteps_
+     *  \param updateType Type of environment update
+     *  \param bodyName Name of body for which the update is performed
+     *  \return Index of the update in updateSteps_ (-1 if the update is not performed)
      */
-    void setUpdateFunctionOrder( const int iterationNumber = 0 )
+    int getUpdateStepIndex( const EnvironmentModelsToUpdate updateType, const std::string& bodyName )
     {
-        bool rerunUpdateOrder = 0;
+        for( unsigned int i = 0; i < updateSteps_.size( ); i++ )
+        {
+            if( updateSteps_.at( i ).updateType == updateType && updateSteps_.at( i ).bodyName == bodyName )
+            {
+                return static_cast< int >( i );
+            }
+        }
+        return -1;
+    }
 
-        // Iterate over all update functions
-        for( unsigned int i = 0; i < updateFunctionVector_.size( ); i++ )
+    //! Function to set the order in which the updateSteps_ are to be evaluated.
+    /*!
+     *  Function to set the order in which the updateSteps_ are to be evaluated. By default, the updates are evaluated in
+     *  order of update type. The rotation of a body that is defined by an AerodynamicAngleCalculator depends on the
+     *  states and rotation of the central body, the state of the body itself, and its flight conditions, so that it must
+     *  be evaluated after those updates. The updates are sorted topologically according to these dependencies, retaining
+     *  the default order of all updates wherever possible.
+     */
+    void setUpdateFunctionOrder( )
+    {
+        // Determine dependencies of each update
+        std::vector< std::vector< int > > dependentUpdates( updateSteps_.size( ) );
+        std::vector< int > numberOfUnevaluatedDependencies( updateSteps_.size( ), 0 );
+        for( unsigned int i = 0; i < updateSteps_.size( ); i++ )
         {
-            // Check if environment model is rotational state.
-            if( updateFunctionVector_.at( i ).template get< 0 >( ) == body_rotational_state_update )
+            if( updateSteps_.at( i ).updateType == body_rotational_state_update &&
+                    updateSteps_.at( i ).body->getRotationalEphemeris( ) == nullptr )
             {
-                // Check id body has no rotational ephemeris (i.e. if rotation comes from iterationNumber ).
-                if( bodyList_.at( updateFunctionVector_.at( i ).template get< 1 >( ) )->getRotationalEphemeris( ) == nullptr )
+                std::shared_ptr< reference_frames::AerodynamicAngleCalculator > aerodynamicAngleCalculator =
+                        std::dynamic_pointer_cast< reference_frames::AerodynamicAngleCalculator >(
+                            updateSteps_.at( i ).body->getDependentOrientationCalculator( ) );
+                if( aerodynamicAngleCalculator != nullptr )
                 {
-                    // Check if DependentOrientationCalculator is an AerodynamicAngleCalculator.
-                    std::shared_ptr< reference_frames::DependentOrientationCalculator > dependentOrientationCalculator =
-                            bodyList_.at( updateFunctionVector_.at( i ).template get< 1 >( ) )->
-                            getDependentOrientationCalculator( );
-                    std::shared_ptr< reference_frames::AerodynamicAngleCalculator > aerodynamicAngleCalculator =
-                            std::dynamic_pointer_cast< reference_frames::AerodynamicAngleCalculator >(
-                                dependentOrientationCalculator );
-
-                    // Check if properties of AerodynamicAngleCalculator are such that a different update order is warranted.
-                    if( std::dynamic_pointer_cast< reference_frames::AerodynamicAngleCalculator >(
-                                dependentOrientationCalculator ) != nullptr )
+                    std::vector< int > dependencies =
+                    { getUpdateStepIndex( body_translational_state_update, aerodynamicAngleCalculator->getCentralBodyName( ) ),
+                      getUpdateStepIndex( body_rotational_state_update, aerodynamicAngleCalculator->getCentralBodyName( ) ),
+                      getUpdateStepIndex( body_translational_state_update, updateSteps_.at( i ).bodyName ),
+                      getUpdateStepIndex( vehicle_flight_conditions_update, updateSteps_.at( i ).bodyName ) };
+                    for( unsigned int j = 0; j < dependencies.size( ); j++ )
                     {
-                        unsigned int centralTranslationalUpdateIndex = 0;
-                        unsigned int centralRotationalUpdateIndex = 0;
-                        unsigned int vehicleTranslationalUpdateIndex = 0;
-                        unsigned int vehicleRotationalUpdateIndex = i;
-                        unsigned int flightCoditionsUpdateIndex = 0;
-
-                        bool centralTranslationalUpdateIndexSet = false;
-                        bool centralRotationalUpdateIndexSet = false;
-                        bool vehicleTranslationalUpdateIndexSet = false;
-                        bool flightConditionsUpdateIndexSet = false;
-
-                        // Check if the state or orientation of the central body of AerodynamicAngleCalculator is updated.
-                        for( unsigned int j = 0; j < updateFunctionVector_.size( ); j++ )
+                        if( dependencies.at( j ) >= 0 && dependencies.at( j ) != static_cast< int >( i ) )
                         {
-                            if( ( updateFunctionVector_.at( j ).template get< 0 >( ) == body_translational_state_update ) &&
-                                    ( updateFunctionVector_.at( j ).template get< 1 >( ) ==
-                                      aerodynamicAngleCalculator->getCentralBodyName( ) ) )
-                            {
-                                centralTranslationalUpdateIndex = j;
-                                centralTranslationalUpdateIndexSet = true;
-                            }
-
-                            if( ( updateFunctionVector_.at( j ).template get< 0 >( ) == body_rotational_state_update ) &&
-                                    ( updateFunctionVector_.at( j ).template get< 1 >( ) ==
-                                      aerodynamicAngleCalculator->getCentralBodyName( ) ) )
-                            {
-                                centralRotationalUpdateIndex = j;
-                                centralRotationalUpdateIndexSet = true;
-                            }
-
-                            if( ( updateFunctionVector_.at( j ).template get< 0 >( ) == body_translational_state_update ) &&
-                                    ( updateFunctionVector_.at( j ).template get< 1 >( ) ==
-                                      updateFunctionVector_.at( i ).template get< 1 >( ) ) )
-                            {
-                                vehicleTranslationalUpdateIndex = j;
-                                vehicleTranslationalUpdateIndexSet = true;
-                            }
-
-                            if( ( updateFunctionVector_.at( j ).template get< 0 >( ) == vehicle_flight_conditions_update ) &&
-                                    ( updateFunctionVector_.at( j ).template get< 1 >( ) ==
-                                      updateFunctionVector_.at( i ).template get< 1 >( ) ) )
-                            {
-                                flightCoditionsUpdateIndex = j;
-                                flightConditionsUpdateIndexSet = true;
-                            }
-                        }
-
-
-                        std::vector< int > indices;
-                        std::vector< boost::tuple< EnvironmentModelsToUpdate, std::string, std::function< void( const double ) > > > updatesToMove;
-
-                        if( centralTranslationalUpdateIndexSet )
-                        {
-                            indices.push_back( centralTranslationalUpdateIndex );
-                            updatesToMove.push_back( updateFunctionVector_.at( centralTranslationalUpdateIndex ) );
-                        }
-
-                        if( centralRotationalUpdateIndexSet )
-                        {
-                            indices.push_back( centralRotationalUpdateIndex );
-                            updatesToMove.push_back( updateFunctionVector_.at( centralRotationalUpdateIndex ) );
-                        }
-
-                        if( vehicleTranslationalUpdateIndexSet )
-                        {
-                            indices.push_back( vehicleTranslationalUpdateIndex );
-                            updatesToMove.push_back( updateFunctionVector_.at( vehicleTranslationalUpdateIndex ) );
-                        }
-
-                        if( flightConditionsUpdateIndexSet )
-                        {
-                            indices.push_back( flightCoditionsUpdateIndex );
-                            updatesToMove.push_back( updateFunctionVector_.at( flightCoditionsUpdateIndex ) );
-                        }
-
-                        indices.push_back( vehicleRotationalUpdateIndex );
-                        updatesToMove.push_back( updateFunctionVector_.at( vehicleRotationalUpdateIndex ) );
-                        std::vector< int > unorderedIndices = indices;
-                        std::sort( indices.begin( ), indices.end( ) );
-
-                        if( indices != unorderedIndices )
-                        {
-
-                            for( unsigned int k = 0; k < updatesToMove.size( ); k++ )
-                            {
-                                updateFunctionVector_[ indices.at( k ) ] = updatesToMove.at( k );
-                            }
-                            rerunUpdateOrder = true;
-                            break;
+                            dependentUpdates.at( dependencies.at( j ) ).push_back( i );
+                            numberOfUnevaluatedDependencies.at( i )++;
                         }
                     }
                 }
             }
         }
 
-        // Define escape condition in case of infinite loop.
-        if( iterationNumber > 10000 )
+        // Sort updates topologically, evaluating the first update (in default order) that has no unevaluated dependencies.
+        std::set< int > updatesWithoutDependencies;
+        for( unsigned int i = 0; i < updateSteps_.size( ); i++ )
+        {
+            if( numberOfUnevaluatedDependencies.at( i ) == 0 )
+            {
+                updatesWithoutDependencies.insert( i );
+            }
+        }
+
+        std::vector< EnvironmentUpdateStep > sortedUpdateSteps;
+        while( updatesWithoutDependencies.size( ) > 0 )
         {
-            throw std::runtime_error( "Error when finding update order; stuck in infinite loop" );
+            int currentUpdate = *updatesWithoutDependencies.begin( );
+            updatesWithoutDependencies.erase( updatesWithoutDependencies.begin( ) );
+            sortedUpdateSteps.push_back( updateSteps_.at( currentUpdate ) );
+
+            for( unsigned int j = 0; j < dependentUpdates.at( currentUpdate ).size( ); j++ )
+            {
+                if( --numberOfUnevaluatedDependencies.at( dependentUpdates.at( currentUpdate ).at( j ) ) == 0 )
+                {
+                    updatesWithoutDependencies.insert( dependentUpdates.at( currentUpdate ).at( j ) );
+                }
+            }
         }
 
-        // Rerun function if needed.
-        if( rerunUpdateOrder )
+        if( sortedUpdateSteps.size( ) != updateSteps_.size( ) )
         {
-            setUpdateFunctionOrder( iterationNumber + 1 );
+            throw std::runtime_error( "Error when finding environment update order; dependencies are circular" );
         }
+        updateSteps_ = sortedUpdateSteps;
     }
 
     //! Function to set the update functions for the environment from the required update settings.
@@ -398,8 +471,7 @@ private:
     void setUpdateFunctions( const std::map< EnvironmentModelsToUpdate,
                              std::vector< std::string > >& updateSettings )
     {
-        std::map< EnvironmentModelsToUpdate,
-                std::vector< std::pair< std::string, std::function< void( const double ) > > > > updateTimeFunctionList;
+        std::map< EnvironmentModelsToUpdate, std::vector< EnvironmentUpdateStep > > updateStepList;
 
         // Iterate over all required updates and set associated update function in lists
         for( std::map< EnvironmentModelsToUpdate,
@@ -445,23 +517,12 @@ private:
                             }
                         }
 
-                        // Add state update function to list.
+                        // Add state update to list (evaluated directly on body, depends on time only).
                         if( addUpdate == 1 )
                         {
-                            std::function< void( const TimeType ) > stateSetFunction =
-                                    std::bind(
-                                        &simulation_setup::Body
-                                            ::setStateFromEphemeris< StateScalarType, TimeType >,
-                                        bodyList_.at( currentBodies.at( i ) ), std::placeholders::_1 );
-
-                            updateTimeFunctionList[ body_translational_state_update ].push_back(
-                                        std::make_pair( currentBodies.at( i ), stateSetFunction ) );
-
-                            resetFunctionVector_.push_back(
-                                        boost::make_tuple(
-                                            body_translational_state_update, currentBodies.at( i ),
-                                            std::bind( &simulation_setup::Body::recomputeStateOnNextCall,
-                                                         bodyList_.at( currentBodies.at( i ) ) ) ) );
+                            updateStepList[ body_translational_state_update ].push_back(
+                                        EnvironmentUpdateStep( body_translational_state_update, currentBodies.at( i ),
+                                                               bodyList_.at( currentBodies.at( i ) ), true ) );
                         }
                         break;
                     }
@@ -488,12 +549,13 @@ private:
                             if(  ( bodyList_.at( currentBodies.at( i ) )->getRotationalEphemeris( ) != nullptr ) ||
                                  ( bodyList_.at( currentBodies.at( i ) )->getDependentOrientationCalculator( ) != nullptr ) )
                             {
-                                std::function< void( const TimeType ) > rotationalStateSetFunction =
-                                        std::bind( &simulation_setup::Body
-                                                     ::setCurrentRotationalStateToLocalFrameFromEphemeris< TimeType >,
-                                                     bodyList_.at( currentBodies.at( i ) ), std::placeholders::_1 );
-                                updateTimeFunctionList[ body_rotational_state_update ].push_back(
-                                            std::make_pair( currentBodies.at( i ), rotationalStateSetFunction ) );
+                                // Add rotation update to list (evaluated directly on body, depends on time only if
+                                // rotation is defined by a rotational ephemeris).
+                                updateStepList[ body_rotational_state_update ].push_back(
+                                            EnvironmentUpdateStep(
+                                                body_rotational_state_update, currentBodies.at( i ),
+                                                bodyList_.at( currentBodies.at( i ) ),
+                                                bodyList_.at( currentBodies.at( i ) )->getRotationalEphemeris( ) != nullptr ) );
 
                                 if( bodyList_.at( currentBodies.at( i ) )->getRotationalEphemeris( ) == nullptr )
                                 {
@@ -538,10 +600,9 @@ private:
 
                         if( addUpdate )
                         {
-                            updateTimeFunctionList[ body_mass_update ].push_back(
-                                        std::make_pair( currentBodies.at( i ),
-                                                        std::bind( &simulation_setup::Body::updateMass,
-                                                                     bodyList_.at( currentBodies.at( i ) ), std::placeholders::_1  ) ) );
+                            updateStepList[ body_mass_update ].push_back(
+                                        EnvironmentUpdateStep( body_mass_update, currentBodies.at( i ),
+                                                               bodyList_.at( currentBodies.at( i ) ), false ) );
                         }
                         break;
                     }
@@ -555,9 +616,10 @@ private:
                                 (  bodyList_.at( currentBodies.at( i ) )->getGravityFieldModel( ) );
                         if( gravityField != nullptr )
                         {
-                            updateTimeFunctionList[ spherical_harmonic_gravity_field_update ].push_back(
-                                        std::make_pair(
-                                            currentBodies.at( i ),
+                            updateStepList[ spherical_harmonic_gravity_field_update ].push_back(
+                                        EnvironmentUpdateStep(
+                                            spherical_harmonic_gravity_field_update, currentBodies.at( i ),
+                                            bodyList_.at( currentBodies.at( i ) ), false,
                                             std::bind( &gravitation
                                                          ::TimeDependentSphericalHarmonicsGravityField
                                                          ::update,
@@ -580,9 +642,10 @@ private:
                         {
                             // If vehicle has flight conditions, add flight conditions update
                             // function to update list.
-                            updateTimeFunctionList[ vehicle_flight_conditions_update ].push_back(
-                                        std::make_pair(
-                                            currentBodies.at( i ), std::bind(
+                            updateStepList[ vehicle_flight_conditions_update ].push_back(
+                                        EnvironmentUpdateStep(
+                                            vehicle_flight_conditions_update, currentBodies.at( i ),
+                                            bodyList_.at( currentBodies.at( i ) ), false, std::bind(
                                                 &aerodynamics::FlightConditions::updateConditions,
                                                 bodyList_.at( currentBodies.at( i ) )
                                                 ->getFlightConditions( ), std::placeholders::_1 ) ) );
@@ -629,13 +692,14 @@ private:
                              ::iterator iterator = radiationPressureInterfaces.begin( );
                              iterator != radiationPressureInterfaces.end( ); iterator++ )
                         {
-                            updateTimeFunctionList[ radiation_pressure_interface_update ].push_back(
-                                        std::make_pair( currentBodies.at( i ),
-                                                        std::bind(
-                                                            &electromagnetism
-                                                            ::RadiationPressureInterface
-                                                            ::updateInterface,
-                                                            iterator->second, std::placeholders::_1 ) ) );
+                            updateStepList[ radiation_pressure_interface_update ].push_back(
+                                        EnvironmentUpdateStep( radiation_pressure_interface_update, currentBodies.at( i ),
+                                                               bodyList_.at( currentBodies.at( i ) ), false,
+                                                               std::bind(
+                                                                   &electromagnetism
+                                                                   ::RadiationPressureInterface
+                                                                   ::updateInterface,
+                                                                   iterator->second, std::placeholders::_1 ) ) );
                         }
                         break;
                     }
@@ -644,23 +708,42 @@ private:
             }
         }
 
-        // Create list of update functions.
-        for( std::map< EnvironmentModelsToUpdate, std::vector< std::pair< std::string,
-             std::function< void( const double ) > > > >::iterator updateTimeIterator  = updateTimeFunctionList.begin( );
-             updateTimeIterator != updateTimeFunctionList.end( ); updateTimeIterator++ )
+        // Create list of updates, sorted by type of update.
+        for( auto updateStepIterator : updateStepList )
         {
-            for( unsigned int i = 0; i < updateTimeIterator->second.size( ); i++ )
-            {
-                updateFunctionVector_.push_back(
-                            boost::make_tuple( updateTimeIterator->first,  updateTimeIterator->second.at( i ).first,
-                                               updateTimeIterator->second.at( i ).second ) );
-            }
+            updateSteps_.insert( updateSteps_.end( ), updateStepIterator.second.begin( ), updateStepIterator.second.end( ) );
         }
 
         // Set update order of functions.
         setUpdateFunctionOrder( );
     }
 
+    //! Function to set the bodies of which the numerically integrated states are set in the environment
+    void setIntegratedStateBodies( )
+    {
+        integratedStateBodies_[ translational_state ];
+        integratedStateBodies_[ rotational_state ];
+        integratedStateBodies_[ body_mass_state ];
+        for( auto integratedStateIterator : integratedStates_ )
+        {
+            if( integratedStateIterator.first == translational_state ||
+                    integratedStateIterator.first == rotational_state ||
+                    integratedStateIterator.first == body_mass_state )
+            {
+                for( unsigned int i = 0; i < integratedStateIterator.second.size( ); i++ )
+                {
+                    if( bodyList_.count( integratedStateIterator.second.at( i ).first ) == 0 )
+                    {
+                        throw std::runtime_error( "Error when creating environment updater, could not find propagated body " +
+                                                  integratedStateIterator.second.at( i ).first );
+                    }
+                    integratedStateBodies_[ integratedStateIterator.first ].push_back(
+                                bodyList_.at( integratedStateIterator.second.at( i ).first ) );
+                }
+            }
+        }
+    }
+
     //! List of body objects, this list encompasses all environment object in the simulation.
     simulation_setup::SystemOfBodies bodyList_;
 
@@ -676,14 +759,26 @@ private:
     std::map< IntegratedStateType, std::vector< std::pair< std::string, std::string > > >
     integratedStates_;
 
-    //! List of time-dependent functions to call to update the environment.
-    std::vector< boost::tuple< EnvironmentModelsToUpdate, std::string, std::function< void( const double ) > > >
-    updateFunctionVector_;
+    //! List of updates of the environment, in the order in which they are to be evaluated.
+    std::vector< EnvironmentUpdateStep > updateSteps_;
+
+    //! Bodies for which the numerically integrated states are set in the environment, per state type (in same order as
+    //! integratedStates_)
+    std::map< IntegratedStateType, std::vector< std::shared_ptr< simulation_setup::Body > > > integratedStateBodies_;
 
     //! List of time-dependent functions to call to reset the time of the environment (to NaN signal recomputation for next
     //! time step).
     std::vector< boost::tuple< EnvironmentModelsToUpdate, std::string, std::function< void( ) > > > resetFunctionVector_;
 
+    //! Profiler in which the evaluation time of the environment updates is recorded (nullptr if none)
+    std::shared_ptr< utilities::PropagationProfiler > profiler_;
+
+    //! Index of the profiler scope of the setting of the integrated states in the environment
+    int integratedStateProfilingScope_ = -1;
+
+    //! Index of the profiler scope of each entry of updateSteps_
+    std::vector< int > updateFunctionProfilingScopes_;
+
 
 
 
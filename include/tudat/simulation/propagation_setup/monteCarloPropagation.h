@@ -0,0 +1,173 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_MONTECARLOPROPAGATION_H
+#define TUDAT_MONTECARLOPROPAGATION_H
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/parallelExecution.h"
+#include "tudat/simulation/propagation_setup/dynamicsSimulator.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Function to retrieve the final propagated state of a single-arc propagation
+/*!
+ *  Function to retrieve the final propagated state of a single-arc propagation, used as default output of
+ *  a Monte Carlo propagation (see propagateMonteCarloSamples).
+ *  \param dynamicsSimulator Simulator with which the propagation was performed
+ *  \return Final propagated state (converted to double precision)
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+Eigen::VectorXd getFinalPropagatedState( SingleArcDynamicsSimulator< StateScalarType, TimeType >& dynamicsSimulator )
+{
+    const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& numericalSolution =
+            dynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+    if( numericalSolution.size( ) == 0 )
+    {
+        throw std::runtime_error( "Error when retrieving final propagated state, no numerical solution found" );
+    }
+    return numericalSolution.rbegin( )->second.template cast< double >( );
+}
+
+//! Function to propagate the dynamics for a set of (randomly) dispersed samples, distributed over a number of threads
+/*!
+ *  Function to propagate the dynamics for a set of (randomly) dispersed samples, such as those generated by the functions
+ *  in math/statistics/randomSampling.h, distributed over a number of threads. Since the environment models store their
+ *  current state (e.g. Body states and rotations, interpolator look-up indices), a single environment cannot be used by
+ *  multiple propagations concurrently. Instead, an environment is created once for each thread (on the calling thread,
+ *  before starting the propagations) and reused for all samples that are propagated on that thread. For each sample,
+ *  the sampleSettingsFunction is called with the sample and the environment of the current thread. It must set all
+ *  dispersed properties of the environment (e.g. drag coefficient, atmosphere model parameters), as the environment retains
+ *  the values of the previous sample on that thread, and return the integrator and propagator settings (with its own
+ *  IntegratorSettings object, as it is modified during the propagation) for the sample. Calls to this function are
+ *  serialized, so that it may use models that are not thread-safe (e.g. Spice). The samples are dynamically distributed
+ *  over the threads (see utilities::executeTasksInParallel), so that propagations of unequal duration are balanced.
+ *  The propagation results are not set in the environment. Note that the environment models that are evaluated during
+ *  the propagation must be safe to evaluate concurrently (in particular, ephemerides that directly call Spice are not).
+ *  Results are equal to those of a sequential propagation of each sample in a newly created environment, provided that
+ *  all dispersed properties are set by the sampleSettingsFunction.
+ *  \param samples List of samples that are to be propagated (each entry defines the dispersed properties of one sample)
+ *  \param bodiesCreationFunction Function creating a new environment, called once per thread
+ *  \param sampleSettingsFunction Function that sets the dispersed properties of a sample in the environment (input 2), and
+ *  returns the integrator and propagator settings for the sample (input 1)
+ *  \param numberOfThreads Number of threads over which the samples are distributed (0 denotes all available threads)
+ *  \param resultFunction Function that computes the result of a single propagation, with the index of the sample and the
+ *  simulator with which it was propagated as input (final propagated state by default). Called on the worker thread.
+ *  \param outputFileName Name of file to which the results are written (none if empty). Each line contains the index of a
+ *  sample, followed by the entries of its result, in order of completion of the propagations.
+ *  \param storeResults Boolean denoting whether the results are to be returned by this function. Set to false when writing
+ *  the results of a large number of samples to a file, to prevent them from being retained in memory.
+ *  \return Result for each sample (in the order of the samples), or empty list if storeResults is false.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+std::vector< Eigen::VectorXd > propagateMonteCarloSamples(
+        const std::vector< Eigen::VectorXd >& samples,
+        const std::function< simulation_setup::SystemOfBodies( ) > bodiesCreationFunction,
+        const std::function< std::pair< std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > >,
+        std::shared_ptr< SingleArcPropagatorSettings< StateScalarType > > >(
+            const Eigen::VectorXd&, const simulation_setup::SystemOfBodies& ) > sampleSettingsFunction,
+        const unsigned int numberOfThreads = 0,
+        const std::function< Eigen::VectorXd( const unsigned int,
+                                              SingleArcDynamicsSimulator< StateScalarType, TimeType >& ) > resultFunction =
+        [ ]( const unsigned int, SingleArcDynamicsSimulator< StateScalarType, TimeType >& dynamicsSimulator )
+{ return getFinalPropagatedState( dynamicsSimulator ); },
+        const std::string& outputFileName = "",
+        const bool storeResults = true )
+{
+    unsigned int numberOfSamples = samples.size( );
+    unsigned int numberOfWorkers = ( numberOfThreads == 0 ) ? utilities::getNumberOfAvailableThreads( ) : numberOfThreads;
+    numberOfWorkers = std::max( std::min( numberOfWorkers, numberOfSamples ), 1U );
+
+    // Create environment for each thread
+    std::vector< simulation_setup::SystemOfBodies > threadBodies;
+    for( unsigned int i = 0; i < numberOfWorkers; i++ )
+    {
+        threadBodies.push_back( bodiesCreationFunction( ) );
+    }
+
+    std::ofstream outputFile;
+    if( outputFileName != "" )
+    {
+        outputFile.open( outputFileName );
+        if( !outputFile.is_open( ) )
+        {
+            throw std::runtime_error( "Error in Monte Carlo propagation, could not open output file " + outputFileName );
+        }
+        outputFile << std::setprecision( std::numeric_limits< double >::digits10 + 2 );
+    }
+
+    std::vector< Eigen::VectorXd > results;
+    if( storeResults )
+    {
+        results.resize( numberOfSamples );
+    }
+
+    std::mutex settingsMutex;
+    std::mutex outputMutex;
+    utilities::executeTasksInParallel(
+                numberOfSamples, numberOfWorkers,
+                [ & ]( const unsigned int sampleIndex, const unsigned int threadIndex )
+    {
+        // Set dispersed properties of sample in environment of current thread, and retrieve settings
+        std::pair< std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > >,
+                std::shared_ptr< SingleArcPropagatorSettings< StateScalarType > > > sampleSettings;
+        {
+            std::lock_guard< std::mutex > settingsLock( settingsMutex );
+            sampleSettings = sampleSettingsFunction( samples.at( sampleIndex ), threadBodies.at( threadIndex ) );
+        }
+
+        // Propagate sample and compute result
+        SingleArcDynamicsSimulator< StateScalarType, TimeType > dynamicsSimulator(
+                    threadBodies.at( threadIndex ), sampleSettings.first, sampleSettings.second, true, false, false );
+        Eigen::VectorXd sampleResult = resultFunction( sampleIndex, dynamicsSimulator );
+
+        if( storeResults )
+        {
+            results[ sampleIndex ] = sampleResult;
+        }
+
+        if( outputFileName != "" )
+        {
+            std::lock_guard< std::mutex > outputLock( outputMutex );
+            outputFile << sampleIndex;
+            for( int i = 0; i < sampleResult.rows( ); i++ )
+            {
+                outputFile << " " << sampleResult( i );
+            }
+            outputFile << std::endl;
+        }
+    } );
+
+    return results;
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_MONTECARLOPROPAGATION_H
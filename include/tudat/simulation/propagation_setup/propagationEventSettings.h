@@ -0,0 +1,112 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_PROPAGATIONEVENTSETTINGS_H
+#define TUDAT_PROPAGATIONEVENTSETTINGS_H
+
+#include <memory>
+#include <string>
+
+#include "tudat/math/root_finders/createRootFinder.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+class SingleDependentVariableSaveSettings;
+
+//! Enum listing the directions in which a crossing of an event value is detected
+enum PropagationEventCrossingDirection
+{
+    increasing_event_crossing = 0,
+    decreasing_event_crossing = 1,
+    any_event_crossing = 2
+};
+
+//! Class for defining an event that is to be detected during the propagation
+/*!
+ *  Class for defining an event that is to be detected during the propagation, without terminating the propagation. An
+ *  event occurs when a (scalar) dependent variable crosses a given value, for instance an altitude crossing, eclipse
+ *  entry/exit (shadow function crossing 0.5) or an apsis (radial velocity crossing zero). The events are located on the
+ *  dense output of the numerical integrator, so that the root finder only evaluates the state derivative (to update the
+ *  environment and compute the dependent variable) at interpolated states, and does not repeat any integration steps.
+ *  Note that an even number of crossings of the event value within a single integration step is not detected.
+ */
+class PropagationEventSettings
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param dependentVariableSettings Settings for (scalar) dependent variable that defines the event
+     * \param eventValue Value of the dependent variable at which the event occurs
+     * \param eventRootFinderSettings Settings to create root finder used to locate the event
+     * \param crossingDirection Direction(s) in which a crossing of the event value is detected
+     * \param eventName Name of the event (used to identify the event in the results)
+     */
+    PropagationEventSettings(
+            const std::shared_ptr< SingleDependentVariableSaveSettings > dependentVariableSettings,
+            const double eventValue,
+            const std::shared_ptr< root_finders::RootFinderSettings > eventRootFinderSettings,
+            const PropagationEventCrossingDirection crossingDirection = any_event_crossing,
+            const std::string& eventName = "" ):
+        dependentVariableSettings_( dependentVariableSettings ), eventValue_( eventValue ),
+        eventRootFinderSettings_( eventRootFinderSettings ), crossingDirection_( crossingDirection ),
+        eventName_( eventName )
+    {
+        if( eventRootFinderSettings_ == nullptr )
+        {
+            throw std::runtime_error( "Error when defining propagation event settings. Root finder not defined." );
+        }
+        if( root_finders::doesRootFinderRequireDerivatives( eventRootFinderSettings_ ) )
+        {
+            throw std::runtime_error( "Error when defining propagation event settings, requested root finder "
+                                      "requires derivatives; not available in state derivative model." );
+        }
+    }
+
+    //! Destructor
+    ~PropagationEventSettings( ){ }
+
+    //! Settings for (scalar) dependent variable that defines the event
+    std::shared_ptr< SingleDependentVariableSaveSettings > dependentVariableSettings_;
+
+    //! Value of the dependent variable at which the event occurs
+    double eventValue_;
+
+    //! Settings to create root finder used to locate the event
+    std::shared_ptr< root_finders::RootFinderSettings > eventRootFinderSettings_;
+
+    //! Direction(s) in which a crossing of the event value is detected
+    PropagationEventCrossingDirection crossingDirection_;
+
+    //! Name of the event (used to identify the event in the results)
+    std::string eventName_;
+};
+
+inline std::shared_ptr< PropagationEventSettings > propagationEventSettings(
+        const std::shared_ptr< SingleDependentVariableSaveSettings > dependentVariableSettings,
+        const double eventValue,
+        const std::shared_ptr< root_finders::RootFinderSettings > eventRootFinderSettings,
+        const PropagationEventCrossingDirection crossingDirection = any_event_crossing,
+        const std::string& eventName = "" )
+{
+    return std::make_shared< PropagationEventSettings >(
+                dependentVariableSettings, eventValue, eventRootFinderSettings, crossingDirection, eventName );
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_PROPAGATIONEVENTSETTINGS_H
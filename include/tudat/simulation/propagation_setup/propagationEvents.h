@@ -0,0 +1,311 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_PROPAGATIONEVENTS_H
+#define TUDAT_PROPAGATIONEVENTS_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/simulation/propagation_setup/propagationEventSettings.h"
+#include "tudat/simulation/propagation_setup/propagationOutput.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Class for evaluating the function that defines a single event during the propagation
+class PropagationEventCondition
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param variableRetrievalFunction Function returning the dependent variable that defines the event.
+     * \param eventValue Value of the dependent variable at which the event occurs
+     * \param eventRootFinderSettings Settings to create root finder used to locate the event
+     * \param crossingDirection Direction(s) in which a crossing of the event value is detected
+     * \param eventName Name of the event
+     */
+    PropagationEventCondition(
+            const std::function< double( ) > variableRetrievalFunction,
+            const double eventValue,
+            const std::shared_ptr< root_finders::RootFinderSettings > eventRootFinderSettings,
+            const PropagationEventCrossingDirection crossingDirection = any_event_crossing,
+            const std::string& eventName = "" ):
+        variableRetrievalFunction_( variableRetrievalFunction ), eventValue_( eventValue ),
+        eventRootFinderSettings_( eventRootFinderSettings ), crossingDirection_( crossingDirection ),
+        eventName_( eventName ){ }
+
+    //! Destructor
+    ~PropagationEventCondition( ){ }
+
+    //! Function to compute the current value of the event function
+    /*!
+     * Function to compute the current value of the event function, i.e. the difference between the dependent variable
+     * and the event value. The environment and state derivative models need to be updated to the current state and time
+     * before calling this function.
+     * \return Current value of the event function
+     */
+    double getEventFunctionValue( )
+    {
+        return variableRetrievalFunction_( ) - eventValue_;
+    }
+
+    //! Function to check whether the event function crosses zero (in the required direction) between two values
+    /*!
+     * Function to check whether the event function crosses zero (in the required direction, as a function of time)
+     * between two values of the event function
+     * \param previousValue Value of the event function at the start of the interval
+     * \param currentValue Value of the event function at the end of the interval
+     * \param propagationIsForwards Boolean denoting whether the propagation is forwards in time
+     * \return True if the event function crosses zero between the two values
+     */
+    bool isEventCrossing( const double previousValue, const double currentValue, const bool propagationIsForwards );
+
+    //! Function to retrieve settings to create root finder used to locate the event
+    std::shared_ptr< root_finders::RootFinderSettings > getEventRootFinderSettings( )
+    {
+        return eventRootFinderSettings_;
+    }
+
+    //! Function to retrieve the name of the event
+    std::string getEventName( )
+    {
+        return eventName_;
+    }
+
+private:
+
+    //! Function returning the dependent variable that defines the event.
+    std::function< double( ) > variableRetrievalFunction_;
+
+    //! Value of the dependent variable at which the event occurs
+    double eventValue_;
+
+    //! Settings to create root finder used to locate the event
+    std::shared_ptr< root_finders::RootFinderSettings > eventRootFinderSettings_;
+
+    //! Direction(s) in which a crossing of the event value is detected
+    PropagationEventCrossingDirection crossingDirection_;
+
+    //! Name of the event
+    std::string eventName_;
+};
+
+//! Class storing the details of a single event detected during the propagation
+/*!
+ *  Class storing the details of a single event detected during the propagation. If the event could not be located
+ *  within the integration step in which it occurs (e.g. because the root finder did not converge), the event is stored
+ *  as unresolved, with the time and state at the end of that step, and the start and end time of the step as the
+ *  interval that brackets the event.
+ */
+class PropagationEventOccurrence
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param eventIndex Index of the event in the list of event settings
+     * \param eventName Name of the event
+     * \param eventTime Time at which the event occurs (end of the bracketing interval if the event is unresolved)
+     * \param isEventFunctionIncreasing Boolean denoting whether the event function crosses the event value in increasing
+     * direction (as a function of time)
+     * \param eventState Propagated state (in the form used by the integrator) at the event (at the end of the
+     * bracketing interval if the event is unresolved)
+     * \param isEventResolved Boolean denoting whether the event was located within the bracketing interval
+     * \param bracketingInterval Start and end time of the integration step in which the event occurs
+     */
+    PropagationEventOccurrence( const unsigned int eventIndex,
+                                const std::string& eventName,
+                                const double eventTime,
+                                const bool isEventFunctionIncreasing,
+                                const Eigen::MatrixXd& eventState,
+                                const bool isEventResolved = true,
+                                const std::pair< double, double >& bracketingInterval =
+                                std::make_pair( TUDAT_NAN, TUDAT_NAN ) ):
+        eventIndex_( eventIndex ), eventName_( eventName ), eventTime_( eventTime ),
+        isEventFunctionIncreasing_( isEventFunctionIncreasing ), eventState_( eventState ),
+        isEventResolved_( isEventResolved ), bracketingInterval_( bracketingInterval ){ }
+
+    //! Index of the event in the list of event settings
+    unsigned int eventIndex_;
+
+    //! Name of the event
+    std::string eventName_;
+
+    //! Time at which the event occurs
+    double eventTime_;
+
+    //! Boolean denoting whether the event function crosses the event value in increasing direction (as a function of time)
+    bool isEventFunctionIncreasing_;
+
+    //! Propagated state (in the form used by the integrator) at the event
+    Eigen::MatrixXd eventState_;
+
+    //! Boolean denoting whether the event was located within the bracketing interval
+    bool isEventResolved_;
+
+    //! Start and end time of the integration step in which the event occurs
+    std::pair< double, double > bracketingInterval_;
+};
+
+//! Class for detecting a list of events during the propagation
+/*!
+ *  Class for detecting a list of events during the propagation. The values of all event functions are stored at the
+ *  end of each integration step, and the events for which the event function crosses zero are located (see
+ *  detectPropagationEvents in integrateEquations.h) and stored in this object, in order of their occurrence.
+ */
+class PropagationEventDetector
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param eventConditions List of objects used to evaluate the functions defining the events
+     */
+    PropagationEventDetector( const std::vector< std::shared_ptr< PropagationEventCondition > >& eventConditions ):
+        eventConditions_( eventConditions ){ }
+
+    //! Destructor
+    ~PropagationEventDetector( ){ }
+
+    //! Function to compute the current values of all event functions
+    /*!
+     * Function to compute the current values of all event functions. The environment and state derivative models need
+     * to be updated to the current state and time before calling this function.
+     * \return Current values of all event functions
+     */
+    std::vector< double > getEventFunctionValues( );
+
+    //! Function to reset the detector at the start of a propagation
+    /*!
+     * Function to reset the detector at the start of a propagation, removing all previously detected events and
+     * setting the values of the event functions at the initial state. The environment and state derivative models need
+     * to be updated to the initial state and time before calling this function.
+     */
+    void resetEventFunctionValues( );
+
+    //! Function to add the events detected in a single integration step
+    /*!
+     * Function to add the events detected in a single integration step, which are sorted by their time of occurrence.
+     * \param stepEventOccurrences Events detected in a single integration step
+     * \param propagationIsForwards Boolean denoting whether the propagation is forwards in time
+     */
+    void addEventOccurrences( std::vector< PropagationEventOccurrence > stepEventOccurrences,
+                              const bool propagationIsForwards );
+
+    //! Function to remove all detected events that occur after a given time
+    /*!
+     * Function to remove all detected events that occur after a given time (e.g. the exact termination time). Unresolved
+     * events are only removed if their bracketing interval starts after the given time.
+     * \param finalTime Time after which detected events are removed
+     * \param propagationIsForwards Boolean denoting whether the propagation is forwards in time
+     */
+    void removeEventOccurrencesAfterTime( const double finalTime, const bool propagationIsForwards );
+
+    //! Function to retrieve list of objects used to evaluate the functions defining the events
+    std::vector< std::shared_ptr< PropagationEventCondition > > getEventConditions( )
+    {
+        return eventConditions_;
+    }
+
+    //! Function to retrieve the values of the event functions at the end of the last processed integration step
+    std::vector< double > getPreviousEventFunctionValues( )
+    {
+        return previousEventFunctionValues_;
+    }
+
+    //! Function to set the values of the event functions at the end of the last processed integration step
+    void setPreviousEventFunctionValues( const std::vector< double >& previousEventFunctionValues )
+    {
+        previousEventFunctionValues_ = previousEventFunctionValues;
+    }
+
+    //! Function to retrieve all events detected during the propagation, in order of occurrence
+    std::vector< PropagationEventOccurrence > getEventOccurrences( )
+    {
+        return eventOccurrences_;
+    }
+
+private:
+
+    //! List of objects used to evaluate the functions defining the events
+    std::vector< std::shared_ptr< PropagationEventCondition > > eventConditions_;
+
+    //! Values of the event functions at the end of the last processed integration step
+    std::vector< double > previousEventFunctionValues_;
+
+    //! All events detected during the propagation, in order of occurrence
+    std::vector< PropagationEventOccurrence > eventOccurrences_;
+};
+
+//! Function to create the object used to detect events during the propagation from associated settings
+/*!
+ * Function to create the object used to detect events during the propagation from associated settings
+ * \param eventSettings List of settings for the events that are to be detected
+ * \param bodies List of body objects that contains all environment models
+ * \param stateDerivativeModels List of state derivative models used in simulations (sorted by dynamics type as key).
+ * \return Object used to detect events during the propagation (nullptr if no events are defined)
+ */
+template< typename StateScalarType = double , typename TimeType = double >
+std::shared_ptr< PropagationEventDetector > createPropagationEventDetector(
+        const std::vector< std::shared_ptr< PropagationEventSettings > >& eventSettings,
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::unordered_map< IntegratedStateType, std::vector< std::shared_ptr
+        < SingleStateTypeDerivative< StateScalarType, TimeType > > > >& stateDerivativeModels =
+        std::unordered_map< IntegratedStateType, std::vector< std::shared_ptr
+                < SingleStateTypeDerivative< StateScalarType, TimeType > > > >( ) )
+{
+    if( eventSettings.size( ) == 0 )
+    {
+        return nullptr;
+    }
+
+    std::vector< std::shared_ptr< PropagationEventCondition > > eventConditions;
+    for( unsigned int i = 0; i < eventSettings.size( ); i++ )
+    {
+        // Get dependent variable function
+        if( getDependentVariableSaveSize( eventSettings.at( i )->dependentVariableSettings_ ) != 1 )
+        {
+            throw std::runtime_error( "Error, cannot make propagation event from vector dependent variable" );
+        }
+        std::function< double( ) > dependentVariableFunction = getDoubleDependentVariableFunction(
+                    eventSettings.at( i )->dependentVariableSettings_, bodies, stateDerivativeModels );
+
+        std::string eventName = eventSettings.at( i )->eventName_;
+        if( eventName == "" )
+        {
+            eventName = getDependentVariableId( eventSettings.at( i )->dependentVariableSettings_ );
+        }
+
+        eventConditions.push_back(
+                    std::make_shared< PropagationEventCondition >(
+                        dependentVariableFunction, eventSettings.at( i )->eventValue_,
+                        eventSettings.at( i )->eventRootFinderSettings_, eventSettings.at( i )->crossingDirection_,
+                        eventName ) );
+    }
+    return std::make_shared< PropagationEventDetector >( eventConditions );
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_PROPAGATIONEVENTS_H
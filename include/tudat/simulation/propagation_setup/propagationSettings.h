@@ -27,6 +27,8 @@
 #include "tudat/astro/propagators/singleStateTypeDerivative.h"
 #include "tudat/astro/propagators/nBodyStateDerivative.h"
 #include "tudat/astro/propagators/rotationalMotionStateDerivative.h"
+#include "tudat/astro/propagators/propagationOutputSink.h"
+#include "tudat/simulation/propagation_setup/propagationEventSettings.h"
 #include "tudat/simulation/propagation_setup/propagationOutputSettings.h"
 #include "tudat/simulation/propagation_setup/propagationTerminationSettings.h"
 #include "tudat/simulation/propagation_setup/createAccelerationModels.h"
@@ -240,6 +242,146 @@ public:
         terminationSettings_ = terminationSettings;
     }
 
+    //! Function to retrieve whether the propagation history is stored in contiguous (columnar) form
+    /*!
+     * Function to retrieve whether the propagation history (states, dependent variables and computation times) is stored in
+     * contiguous (columnar) form during the propagation, instead of in maps.
+     * \return Boolean denoting whether the propagation history is stored in contiguous (columnar) form
+     */
+    bool getUseColumnarHistoryStorage( )
+    {
+        return useColumnarHistoryStorage_;
+    }
+
+    //! Function to set whether the propagation history is stored in contiguous (columnar) form
+    /*!
+     * Function to set whether the propagation history (states, dependent variables and computation times) is stored in
+     * contiguous (columnar) form during the propagation, instead of in maps. If set to true, the history is stored
+     * in utilities::ColumnarHistory objects (avoiding a separate memory allocation for each saved epoch), and the map
+     * representation of the history is only created when it is requested from the dynamics simulator.
+     * \param useColumnarHistoryStorage Boolean denoting whether the propagation history is stored in columnar form
+     */
+    void setUseColumnarHistoryStorage( const bool useColumnarHistoryStorage )
+    {
+        useColumnarHistoryStorage_ = useColumnarHistoryStorage;
+    }
+
+    //! Function to retrieve whether fixed-size state types are to be used in the numerical integration, where possible
+    /*!
+     * Function to retrieve whether fixed-size state types are to be used in the numerical integration, where possible
+     * \return Boolean denoting whether fixed-size state types are to be used in the numerical integration, where possible
+     */
+    bool getUseFixedSizeStatePropagation( )
+    {
+        return useFixedSizeStatePropagation_;
+    }
+
+    //! Function to set whether fixed-size state types are to be used in the numerical integration, where possible
+    /*!
+     * Function to set whether fixed-size state types are to be used in the numerical integration, where possible. If set
+     * to true, and a single translational state of size 6 (e.g. a single body using the Cowell propagator) is propagated,
+     * the numerical integrator operates on Eigen::Matrix< StateScalarType, 6, 1 > states (or 6x7 matrices when
+     * propagating the state transition matrix w.r.t. only the initial state), instead of dynamically sized matrices. For
+     * any other propagated state, this setting is ignored.
+     * \param useFixedSizeStatePropagation Boolean denoting whether fixed-size state types are to be used in the numerical
+     * integration, where possible
+     */
+    void setUseFixedSizeStatePropagation( const bool useFixedSizeStatePropagation )
+    {
+        useFixedSizeStatePropagation_ = useFixedSizeStatePropagation;
+    }
+
+    //! Function to retrieve whether the evaluation time of the models used in the propagation is to be recorded
+    /*!
+     * Function to retrieve whether the evaluation time of the models used in the propagation is to be recorded
+     * \return Boolean denoting whether the evaluation time of the models used in the propagation is to be recorded
+     */
+    bool getUsePropagationProfiling( )
+    {
+        return usePropagationProfiling_;
+    }
+
+    //! Function to set whether the evaluation time of the models used in the propagation is to be recorded
+    /*!
+     * Function to set whether the wall-clock time and number of calls of the models used in the propagation (state
+     * derivative models, acceleration/torque models and environment updates) are to be recorded. The results are
+     * retrieved from the dynamics simulator (see SingleArcDynamicsSimulator::getPropagationProfiler). Requires Tudat to be
+     * compiled with TUDAT_BUILD_WITH_PROFILING enabled.
+     * \param usePropagationProfiling Boolean denoting whether the evaluation time of the models used in the propagation is
+     * to be recorded
+     */
+    void setUsePropagationProfiling( const bool usePropagationProfiling )
+    {
+        usePropagationProfiling_ = usePropagationProfiling;
+    }
+
+    //! Function to add an object to which the propagation output is streamed during the propagation
+    /*!
+     * Function to add an object to which the state and dependent variables are streamed during the propagation, at each
+     * epoch at which the propagation results are saved. The output sink must derive from
+     * PropagationOutputSink< TimeType, StateScalarType >, with the time and state scalar type of the propagation.
+     * \param outputSink Object to which the propagation output is streamed
+     */
+    void addOutputSink( const std::shared_ptr< PropagationOutputSinkBase > outputSink )
+    {
+        outputSinks_.push_back( outputSink );
+    }
+
+    //! Function to retrieve the objects to which the propagation output is streamed during the propagation
+    /*!
+     * Function to retrieve the objects to which the propagation output is streamed during the propagation
+     * \return Objects to which the propagation output is streamed during the propagation
+     */
+    std::vector< std::shared_ptr< PropagationOutputSinkBase > > getOutputSinks( )
+    {
+        return outputSinks_;
+    }
+
+    //! Function to retrieve whether the propagation history is stored in memory
+    /*!
+     * Function to retrieve whether the propagation history is stored in memory
+     * \return Boolean denoting whether the propagation history is stored in memory
+     */
+    bool getStoreHistoryInMemory( )
+    {
+        return storeHistoryInMemory_;
+    }
+
+    //! Function to set whether the propagation history is stored in memory
+    /*!
+     * Function to set whether the propagation history (states, dependent variables and computation times) is stored in
+     * memory. If set to false, the propagation output is only available through the output sinks (see addOutputSink), so
+     * that the memory use of the propagation does not grow with the number of saved epochs, and the history retrieved
+     * from the dynamics simulator is empty.
+     * \param storeHistoryInMemory Boolean denoting whether the propagation history is stored in memory
+     */
+    void setStoreHistoryInMemory( const bool storeHistoryInMemory )
+    {
+        storeHistoryInMemory_ = storeHistoryInMemory;
+    }
+
+    //! Function to add an event that is to be detected during the propagation
+    /*!
+     * Function to add an event that is to be detected (without terminating the propagation) during the propagation. The
+     * detected events are retrieved from the dynamics simulator (see SingleArcDynamicsSimulator::getPropagationEvents).
+     * Requires an integrator that supports dense output.
+     * \param eventSettings Settings for the event that is to be detected
+     */
+    void addEventSettings( const std::shared_ptr< PropagationEventSettings > eventSettings )
+    {
+        eventSettings_.push_back( eventSettings );
+    }
+
+    //! Function to retrieve the settings for the events that are to be detected during the propagation
+    /*!
+     * Function to retrieve the settings for the events that are to be detected during the propagation
+     * \return Settings for the events that are to be detected during the propagation
+     */
+    std::vector< std::shared_ptr< PropagationEventSettings > > getEventSettings( )
+    {
+        return eventSettings_;
+    }
+
 protected:
 
     //!Type of state being propagated
@@ -255,6 +397,26 @@ protected:
     //! current state and time are to be printed to console (default never).
     double printInterval_;
 
+    //! Boolean denoting whether the propagation history is stored in contiguous (columnar) form (default false).
+    bool useColumnarHistoryStorage_ = false;
+
+    //! Boolean denoting whether fixed-size state types are to be used in the numerical integration, where
+    //! possible (default false).
+    bool useFixedSizeStatePropagation_ = false;
+
+    //! Boolean denoting whether the evaluation time of the models used in the propagation is to be recorded (default
+    //! false).
+    bool usePropagationProfiling_ = false;
+
+    //! Objects to which the propagation output is streamed during the propagation (default none).
+    std::vector< std::shared_ptr< PropagationOutputSinkBase > > outputSinks_;
+
+    //! Boolean denoting whether the propagation history is stored in memory (default true).
+    bool storeHistoryInMemory_ = true;
+
+    //! Settings for the events that are to be detected during the propagation (default none).
+    std::vector< std::shared_ptr< PropagationEventSettings > > eventSettings_;
+
 };
 
 //! Function to get the total size of multi-arc initial state vector
@@ -11,6 +11,7 @@
 #ifndef TUDAT_SETNUMERICALLYINTEGRATEDSTATES_H
 #define TUDAT_SETNUMERICALLYINTEGRATEDSTATES_H
 
+#include "tudat/basics/columnarHistory.h"
 #include "tudat/basics/utilities.h"
 #include "tudat/simulation/environment_setup/body.h"
 #include "tudat/astro/ephemerides/frameManager.h"
@@ -338,6 +339,99 @@ void resetIntegratedEphemerides(
                 equationsOfMotionNumericalSolution, integrationToEphemerisFrameFunctions );
 }
 
+//! Resets the ephemerides of the integrated bodies from the columnar numerical integration results.
+/*!
+ * Resets the ephemerides of the integrated bodies from the columnar numerical integration results. For bodies for which
+ * no frame translation is needed, and for which the ephemeris is a TabulatedCartesianEphemeris with the same time and
+ * state scalar types as the propagation, the new interpolator reads the states directly from the columnar storage (which
+ * it keeps alive). For all other bodies, the (translated) states of the body are extracted, and the ephemeris is reset
+ * in the same manner as by resetIntegratedEphemerides.
+ * \param bodies List of bodies used in simulations.
+ * \param equationsOfMotionNumericalSolution Columnar numerical solution of translational equations of motion, in
+ * Cartesian elements w.r.t. integratation origins.
+ * \param bodiesToIntegrate List of names of bodies which are numerically integrated (in the order in
+ * which they are in the entries of equationsOfMotionNumericalSolution.
+ * \param startIndexAndSize Pair with start index and total (contiguous) size of integrated states in entries of
+ * equationsOfMotionNumericalSolution
+ * \param ephemerisUpdateOrder Order in which to update the ephemeris objects (empty if arbitrary).
+ * \param integrationToEphemerisFrameFunctions Function to provide the states of the ephemeris
+ * origins of each body w.r.t. their respective integration origins.
+ */
+template< typename TimeType, typename StateScalarType >
+void resetIntegratedEphemeridesFromColumnarHistory(
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::shared_ptr< const utilities::ColumnarHistory< TimeType, StateScalarType > > equationsOfMotionNumericalSolution,
+        const std::vector< std::string >& bodiesToIntegrate,
+        const std::pair< unsigned int, unsigned int > startIndexAndSize,
+        std::vector< std::string > ephemerisUpdateOrder = std::vector< std::string >( ),
+        const std::map< std::string, std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >&
+        integrationToEphemerisFrameFunctions =
+        std::map< std::string, std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >( ) )
+{
+    // Set update order arbitrarily if no order is provided.
+    if( ephemerisUpdateOrder.size( ) == 0 )
+    {
+        ephemerisUpdateOrder = bodiesToIntegrate;
+    }
+    // Check input consistency
+    else if( ephemerisUpdateOrder.size( ) != bodiesToIntegrate.size( ) )
+    {
+        throw std::runtime_error( "Error when resetting ephemerides, input vectors have inconsistent size" );
+    }
+
+    if( static_cast< unsigned int >( equationsOfMotionNumericalSolution->getNumberOfRows( ) )
+            < startIndexAndSize.first + startIndexAndSize.second )
+    {
+        throw std::runtime_error( "Error when resetting ephemerides, input solution inconsistent with start index and size." );
+    }
+
+    if( startIndexAndSize.second != 6 * bodiesToIntegrate.size( ) )
+    {
+        throw std::runtime_error( "Error when resetting ephemerides, number of bodies inconsistent with input size." );
+    }
+
+    for( unsigned int i = 0; i < ephemerisUpdateOrder.size( ); i++ )
+    {
+        std::vector< std::string >::const_iterator bodyFindIterator = std::find(
+                    bodiesToIntegrate.begin( ), bodiesToIntegrate.end( ), ephemerisUpdateOrder.at( i ) );
+        if( bodyFindIterator == bodiesToIntegrate.end( ) )
+        {
+            throw std::runtime_error( "Error when creating and setting ephemeris after integration, cannot find body " +
+                                      ephemerisUpdateOrder.at( i ) );
+        }
+        int bodyIndex = std::distance( bodiesToIntegrate.begin( ), bodyFindIterator );
+        int bodyStartIndex = startIndexAndSize.first + 6 * bodyIndex;
+
+        std::shared_ptr< ephemerides::TabulatedCartesianEphemeris< StateScalarType, TimeType > > tabulatedEphemeris =
+                std::dynamic_pointer_cast< ephemerides::TabulatedCartesianEphemeris< StateScalarType, TimeType > >(
+                    bodies.at( ephemerisUpdateOrder.at( i ) )->getEphemeris( ) );
+        if( integrationToEphemerisFrameFunctions.count( ephemerisUpdateOrder.at( i ) ) == 0 && tabulatedEphemeris != nullptr )
+        {
+            tabulatedEphemeris->resetInterpolatorFromHistory( equationsOfMotionNumericalSolution, 6, bodyStartIndex );
+        }
+        else
+        {
+            // Extract (and translate) states of current body only
+            std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > integrationToEphemerisFrameFunction =
+                    ( integrationToEphemerisFrameFunctions.count( ephemerisUpdateOrder.at( i ) ) > 0 ) ?
+                        integrationToEphemerisFrameFunctions.at( ephemerisUpdateOrder.at( i ) ) : nullptr;
+
+            std::map< TimeType, Eigen::Matrix< StateScalarType, 6, 1 > > ephemerisInput;
+            for( unsigned int j = 0; j < equationsOfMotionNumericalSolution->size( ); j++ )
+            {
+                const TimeType currentTime = equationsOfMotionNumericalSolution->getTime( j );
+                ephemerisInput[ currentTime ] =
+                        equationsOfMotionNumericalSolution->getEntry( j ).block( bodyStartIndex, 0, 6, 1 );
+                if( integrationToEphemerisFrameFunction != nullptr )
+                {
+                    ephemerisInput[ currentTime ] -= integrationToEphemerisFrameFunction( currentTime );
+                }
+            }
+            resetIntegratedEphemerisOfBody( bodies, ephemerisInput, ephemerisUpdateOrder.at( i ) );
+        }
+    }
+}
+
 //! Resets the ephemerides of the integrated bodies from the numerical multi-arc integration results.
 /*!
  * Resets the ephemerides of the integrated bodies from the numerical multi-arc integration results, and
@@ -581,6 +675,42 @@ void resetIntegratedRotationalEphemerides(
     }
 }
 
+//! Resets the rotational ephemerides of a set of bodies from the columnar numerical integration results.
+/*!
+ * Resets the rotational ephemerides of a set of bodies from the columnar numerical integration results, and
+ * performs associated computation for ephemeris-dependent environment variables. The new interpolators read the
+ * rotational states directly from the columnar storage (which they keep alive).
+ * \param bodies List of bodies used in simulations.
+ * \param equationsOfMotionNumericalSolution Columnar numerical solution of rotational equations of motion
+ * \param bodiesToIntegrate List of names of bodies which are numerically integrated
+ * \param startIndexAndSize Pair with start index and total (contiguous) size of integrated states in entries of
+ * equationsOfMotionNumericalSolution
+ */
+template< typename TimeType, typename StateScalarType >
+void resetIntegratedRotationalEphemeridesFromColumnarHistory(
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::shared_ptr< const utilities::ColumnarHistory< TimeType, StateScalarType > > equationsOfMotionNumericalSolution,
+        const std::vector< std::string >& bodiesToIntegrate,
+        const std::pair< unsigned int, unsigned int > startIndexAndSize )
+{
+    typedef typename std::conditional< std::is_same< TimeType, double >::value, double, long double >::type
+            InterpolationScalarType;
+    for( unsigned int i = 0; i < bodiesToIntegrate.size( ); i++ )
+    {
+        resetIntegratedRotationalEphemerisOfBody< TimeType, StateScalarType >(
+                    bodies, interpolators::createStridedLagrangeInterpolatorFromHistory<
+                    TimeType, StateScalarType, 7, InterpolationScalarType >(
+                        equationsOfMotionNumericalSolution, startIndexAndSize.first + 7 * i, 6 ),
+                    bodiesToIntegrate.at( i ) );
+    }
+
+    // Having set new ephemerides, update body properties depending on ephemerides.
+    for( auto bodyIterator : bodies.getMap( )  )
+    {
+        bodyIterator.second->updateConstantEphemerisDependentMemberQuantities( );
+    }
+}
+
 //! Resets the mass models of the integrated bodies from the numerical integration results.
 /*!
  * Resets the mass models of the integrated bodies from the numerical integration results.
@@ -628,6 +758,47 @@ void resetIntegratedBodyMass(
     }
 }
 
+//! Resets the mass models of the integrated bodies from the columnar numerical integration results.
+/*!
+ * Resets the mass models of the integrated bodies from the columnar numerical integration results. Only the masses are
+ * extracted from the history.
+ * \param bodies List of bodies used in simulations.
+ * \param equationsOfMotionNumericalSolution Columnar numerical solution of the body masses.
+ * \param bodiesToIntegrate List of names of bodies for which mass is numerically integrated (in the order in
+ * which they are in the entries of equationsOfMotionNumericalSolution.
+ * \param startIndexAndSize Pair with start index and total (contiguous) size of integrated states in entries of
+ * equationsOfMotionNumericalSolution
+ */
+template< typename TimeType, typename StateScalarType >
+void resetIntegratedBodyMassFromColumnarHistory(
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::shared_ptr< const utilities::ColumnarHistory< TimeType, StateScalarType > > equationsOfMotionNumericalSolution,
+        const std::vector< std::string >& bodiesToIntegrate ,
+        const std::pair< unsigned int, unsigned int > startIndexAndSize )
+{
+    if( startIndexAndSize.second != bodiesToIntegrate.size( ) )
+    {
+        throw std::runtime_error( "Error when resetting body masses, number of bodies inconsistent with input size." );
+    }
+
+    for( unsigned int i = 0; i < bodiesToIntegrate.size( ); i++ )
+    {
+        std::map< double, double > currentBodyMassMap;
+        for( unsigned int j = 0; j < equationsOfMotionNumericalSolution->size( ); j++ )
+        {
+            currentBodyMassMap[ static_cast< double >( equationsOfMotionNumericalSolution->getTime( j ) ) ] =
+                    static_cast< double >( equationsOfMotionNumericalSolution->getEntry( j )( startIndexAndSize.first + i, 0 ) );
+        }
+
+        typedef interpolators::OneDimensionalInterpolator< double, double > LocalInterpolator;
+        bodies.at( bodiesToIntegrate.at( i ) )->setBodyMassFunction(
+                    std::bind(
+                        static_cast< double( LocalInterpolator::* )( const double ) >
+                        ( &LocalInterpolator::interpolate ),
+                        std::make_shared< interpolators::LagrangeInterpolatorDouble >( currentBodyMassMap, 6 ), std::placeholders::_1 ) );
+    }
+}
+
 //! Base class for settings how numerically integrated states are processed
 /*!
  *  Base class for defining settings on how numerically integrated states are to be processed in the
@@ -663,6 +834,19 @@ public:
             const std::map< TimeType, Eigen::Matrix< StateScalarType,
             Eigen::Dynamic, 1 > >& numericalSolution ) = 0;
     
+    //! Function that processes the entries of the stateType_ in the full columnar numericalSolution
+    /*!
+     * Function that processes the entries of the stateType_ in the full columnar numericalSolution. By default, the
+     * solution is converted to a map, and processed by processIntegratedStates. Derived classes may override this
+     * function to read the columnar storage directly.
+     * \param numericalSolution Full columnar numerical solution, in global representation.
+     */
+    virtual void processIntegratedColumnarStates(
+            const std::shared_ptr< const utilities::ColumnarHistory< TimeType, StateScalarType > > numericalSolution )
+    {
+        processIntegratedStates( numericalSolution->convertToMap( ) );
+    }
+
     virtual void processIntegratedMultiArcStates(
             const std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >& numericalSolution,
             const std::vector< double >& arcStartTimes ) = 0;
@@ -740,6 +924,21 @@ public:
                     bodies_, numericalSolution, bodiesToIntegrate_, this->startIndexAndSize_, ephemerisUpdateOrder_,
                     integrationToEphemerisFrameFunctions_ );
     }
+
+    //! Function processing single-arc columnar translational state, resetting bodies' ephemerides with new states
+    /*!
+     * Function processing single-arc columnar translational state, resetting bodies' ephemerides with new states in
+     * numericalSolution variable, reading the states directly from the columnar storage where possible.
+     * \param numericalSolution Full columnar numerical solution, in global representation (see
+     * convertToOutputSolution function in NBodyStateDerivative class.
+     */
+    void processIntegratedColumnarStates(
+            const std::shared_ptr< const utilities::ColumnarHistory< TimeType, StateScalarType > > numericalSolution )
+    {
+        resetIntegratedEphemeridesFromColumnarHistory< TimeType, StateScalarType >(
+                    bodies_, numericalSolution, bodiesToIntegrate_, this->startIndexAndSize_, ephemerisUpdateOrder_,
+                    integrationToEphemerisFrameFunctions_ );
+    }
     
     //! Function processing multi-arc translational state, resetting bodies' ephemerides with new states
     /*!
@@ -819,6 +1018,20 @@ public:
         resetIntegratedRotationalEphemerides< TimeType, StateScalarType >(
                     bodies_, numericalSolution, bodiesToIntegrate_, this->startIndexAndSize_ );
     }
+
+    //! Function processing rotational state in the full columnar numericalSolution
+    /*!
+     * Function that processes the entries of the rotational state in the full columnar numericalSolution, and updates
+     * the associated rotational ephemerides, which read the states directly from the columnar storage.
+     * \param numericalSolution Full columnar numerical solution, in global representation (see
+     * convertToOutputSolution function in RotationalMotionStateDerivative class.
+     */
+    void processIntegratedColumnarStates(
+            const std::shared_ptr< const utilities::ColumnarHistory< TimeType, StateScalarType > > numericalSolution )
+    {
+        resetIntegratedRotationalEphemeridesFromColumnarHistory< TimeType, StateScalarType >(
+                    bodies_, numericalSolution, bodiesToIntegrate_, this->startIndexAndSize_ );
+    }
     
     //! Function processing multi-arc rotational state, resetting bodies' ephemerides with new states
     /*!
@@ -885,6 +1098,18 @@ public:
     {
         resetIntegratedBodyMass( bodies_, numericalSolution, bodiesToIntegrate_, this->startIndexAndSize_ );
     }
+
+    //! Function processing mass state in the full columnar numericalSolution
+    /*!
+     * Function that processes the entries of the propagated mass in the full columnar numericalSolution, resetting
+     * bodies' mass models
+     * \param numericalSolution Full columnar numerical solution of state, in global representation.
+     */
+    void processIntegratedColumnarStates(
+            const std::shared_ptr< const utilities::ColumnarHistory< TimeType, StateScalarType > > numericalSolution )
+    {
+        resetIntegratedBodyMassFromColumnarHistory( bodies_, numericalSolution, bodiesToIntegrate_, this->startIndexAndSize_ );
+    }
     
     //! Function processing multi-arc translational mass, resetting bodies' mass models
     /*!
@@ -1217,6 +1442,31 @@ void resetIntegratedStates(
     }
 }
 
+//! Function resetting dynamical properties of environment from columnar numerical dynamics solution
+/*!
+ * Function to reset the dynamical properties of the environment from the columnar numerically integrated dynamics
+ * solution, without converting it to a map
+ * \param equationsOfMotionNumericalSolution Columnar solution produced by the numerical integration, in the
+ * 'conventional form'
+ * \sa SingleStateTypeDerivative::convertToOutputSolution
+ * \param integratedStateProcessors List of objects (per dynamics type) used to process integrated
+ * results into environment
+ */
+template< typename TimeType, typename StateScalarType >
+void resetIntegratedStates(
+        const std::shared_ptr< const utilities::ColumnarHistory< TimeType, StateScalarType > > equationsOfMotionNumericalSolution,
+        const std::map< IntegratedStateType, std::vector< std::shared_ptr<
+        IntegratedStateProcessor< TimeType, StateScalarType > > > >  integratedStateProcessors )
+{
+    for( auto updateIterator : integratedStateProcessors )
+    {
+        for( unsigned int i = 0; i < updateIterator.second.size( ); i++ )
+        {
+            updateIterator.second.at( i )->processIntegratedColumnarStates( equationsOfMotionNumericalSolution );
+        }
+    }
+}
+
 //! Function resetting dynamical properties of environment from numerical multi-arc dynamics solution
 /*!
  * Function to reset the dynamical properties of the environment from the numerically integrated multi-arc
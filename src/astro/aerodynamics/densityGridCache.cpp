@@ -0,0 +1,230 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "tudat/astro/aerodynamics/densityGridCache.h"
+
+namespace tudat
+{
+
+namespace aerodynamics
+{
+
+//! Constructor
+DensityGridCache::DensityGridCache( const DensityGridCacheSettings& settings ):
+    settings_( settings ), estimatedMaximumRelativeError_( TUDAT_NAN ), numberOfGridComputations_( 0 )
+{
+    int minimumNumberOfPoints = ( settings_.interpolationType == cubic_density_grid_interpolation ) ? 4 : 2;
+    if( settings_.numberOfAltitudePoints < minimumNumberOfPoints ||
+            settings_.numberOfLocalSolarTimePoints < minimumNumberOfPoints ||
+            settings_.numberOfLatitudePoints < minimumNumberOfPoints )
+    {
+        throw std::runtime_error( "Error when creating density grid, at least " + std::to_string( minimumNumberOfPoints ) +
+                                  " grid points are required in each direction for the selected interpolation type" );
+    }
+
+    if( !( settings_.maximumAltitude > settings_.minimumAltitude ) )
+    {
+        throw std::runtime_error( "Error when creating density grid, maximum altitude must exceed minimum altitude" );
+    }
+
+    if( settings_.numberOfErrorSamples < 0 )
+    {
+        throw std::runtime_error( "Error when creating density grid, number of error samples cannot be negative" );
+    }
+
+    altitudeStep_ = ( settings_.maximumAltitude - settings_.minimumAltitude ) /
+            static_cast< double >( settings_.numberOfAltitudePoints - 1 );
+    localSolarTimeStep_ = 24.0 / static_cast< double >( settings_.numberOfLocalSolarTimePoints );
+    latitudeStep_ = mathematical_constants::PI / static_cast< double >( settings_.numberOfLatitudePoints - 1 );
+}
+
+//! Function to compute an element of the Halton sequence (low-discrepancy sequence in [0,1))
+double getHaltonSequenceElement( int index, const int base )
+{
+    double element = 0.0;
+    double fraction = 1.0 / static_cast< double >( base );
+    while( index > 0 )
+    {
+        element += fraction * static_cast< double >( index % base );
+        index /= base;
+        fraction /= static_cast< double >( base );
+    }
+    return element;
+}
+
+//! Function to (re)compute the density at all grid points, for a density model that does not depend on time
+void DensityGridCache::computeGrid(
+        const std::function< double( const double, const double, const double ) >& densityFunction )
+{
+    computeGrid( [ & ]( const double altitude, const double localSolarTime, const double latitude, const double )
+    {
+        return densityFunction( altitude, localSolarTime, latitude );
+    }, 0.0 );
+}
+
+//! Function to (re)compute the density at all grid points
+void DensityGridCache::computeGrid(
+        const std::function< double( const double, const double, const double, const double ) >& densityFunction,
+        const double timeOffsetRange )
+{
+    int numberOfAltitudePoints = settings_.numberOfAltitudePoints;
+    int numberOfLocalSolarTimePoints = settings_.numberOfLocalSolarTimePoints;
+    int numberOfLatitudePoints = settings_.numberOfLatitudePoints;
+
+    // Compute density at grid points
+    logarithmOfDensity_.resize( numberOfAltitudePoints * numberOfLocalSolarTimePoints * numberOfLatitudePoints );
+    int currentIndex = 0;
+    for( int i = 0; i < numberOfAltitudePoints; i++ )
+    {
+        for( int j = 0; j < numberOfLocalSolarTimePoints; j++ )
+        {
+            for( int k = 0; k < numberOfLatitudePoints; k++ )
+            {
+                logarithmOfDensity_[ currentIndex ] = std::log( densityFunction(
+                            settings_.minimumAltitude + i * altitudeStep_,
+                            j * localSolarTimeStep_,
+                            -mathematical_constants::PI / 2.0 + k * latitudeStep_, 0.0 ) );
+                currentIndex++;
+            }
+        }
+    }
+    numberOfGridComputations_++;
+
+    // Estimate maximum error from model density at quasi-random points in altitude, local solar time, latitude and time
+    int numberOfErrorSamples = settings_.numberOfErrorSamples;
+    if( numberOfErrorSamples == 0 )
+    {
+        numberOfErrorSamples = ( numberOfAltitudePoints - 1 ) * numberOfLocalSolarTimePoints * ( numberOfLatitudePoints - 1 );
+    }
+
+    estimatedMaximumRelativeError_ = 0.0;
+    for( int i = 1; i <= numberOfErrorSamples; i++ )
+    {
+        double altitudeCoordinate = getHaltonSequenceElement( i, 2 ) * ( numberOfAltitudePoints - 1 );
+        double localSolarTimeCoordinate = getHaltonSequenceElement( i, 3 ) * numberOfLocalSolarTimePoints;
+        double latitudeCoordinate = getHaltonSequenceElement( i, 5 ) * ( numberOfLatitudePoints - 1 );
+        double timeOffset = ( getHaltonSequenceElement( i, 7 ) - 0.5 ) * timeOffsetRange;
+
+        double modelDensity = densityFunction(
+                    settings_.minimumAltitude + altitudeCoordinate * altitudeStep_,
+                    localSolarTimeCoordinate * localSolarTimeStep_,
+                    -mathematical_constants::PI / 2.0 + latitudeCoordinate * latitudeStep_,
+                    timeOffset );
+        double interpolatedDensity = std::exp( interpolateLogarithmOfDensity(
+                                                   altitudeCoordinate, localSolarTimeCoordinate, latitudeCoordinate ) );
+        estimatedMaximumRelativeError_ = std::max(
+                    estimatedMaximumRelativeError_, std::fabs( ( interpolatedDensity - modelDensity ) / modelDensity ) );
+    }
+
+    if( estimatedMaximumRelativeError_ > settings_.maximumRelativeError )
+    {
+        throw std::runtime_error( "Error when computing density grid, estimated maximum relative error " +
+                                  std::to_string( estimatedMaximumRelativeError_ ) + " exceeds allowed value " +
+                                  std::to_string( settings_.maximumRelativeError ) );
+    }
+}
+
+//! Function to interpolate the density from the grid
+double DensityGridCache::getDensity( const double altitude, const double localSolarTime, const double latitude ) const
+{
+    return std::exp( interpolateLogarithmOfDensity(
+                         ( altitude - settings_.minimumAltitude ) / altitudeStep_,
+                         localSolarTime / localSolarTimeStep_,
+                         ( latitude + mathematical_constants::PI / 2.0 ) / latitudeStep_ ) );
+}
+
+//! Function to compute the interpolation of the logarithm of the density at a (fractional) grid point
+double DensityGridCache::interpolateLogarithmOfDensity( const double altitudeCoordinate,
+                                                        const double localSolarTimeCoordinate,
+                                                        const double latitudeCoordinate ) const
+{
+    int altitudeIndices[ 4 ], localSolarTimeIndices[ 4 ], latitudeIndices[ 4 ];
+    double altitudeWeights[ 4 ], localSolarTimeWeights[ 4 ], latitudeWeights[ 4 ];
+
+    int stencilSize = getInterpolationStencil(
+                altitudeCoordinate, settings_.numberOfAltitudePoints, false, altitudeIndices, altitudeWeights );
+    getInterpolationStencil( localSolarTimeCoordinate, settings_.numberOfLocalSolarTimePoints, true,
+                             localSolarTimeIndices, localSolarTimeWeights );
+    getInterpolationStencil( latitudeCoordinate, settings_.numberOfLatitudePoints, false,
+                             latitudeIndices, latitudeWeights );
+
+    // Compute weighted sum of logarithm of density at stencil points
+    int numberOfLatitudePoints = settings_.numberOfLatitudePoints;
+    int altitudeStride = settings_.numberOfLocalSolarTimePoints * numberOfLatitudePoints;
+    double logarithmOfDensity = 0.0;
+    for( int i = 0; i < stencilSize; i++ )
+    {
+        for( int j = 0; j < stencilSize; j++ )
+        {
+            const double* currentDensities = logarithmOfDensity_.data( ) + altitudeIndices[ i ] * altitudeStride +
+                    localSolarTimeIndices[ j ] * numberOfLatitudePoints;
+            double latitudeSum = 0.0;
+            for( int k = 0; k < stencilSize; k++ )
+            {
+                latitudeSum += latitudeWeights[ k ] * currentDensities[ latitudeIndices[ k ] ];
+            }
+            logarithmOfDensity += altitudeWeights[ i ] * localSolarTimeWeights[ j ] * latitudeSum;
+        }
+    }
+    return logarithmOfDensity;
+}
+
+//! Function to compute the indices and weights of the grid points used for interpolation in a single direction
+int DensityGridCache::getInterpolationStencil( const double coordinate, const int numberOfPoints, const bool isPeriodic,
+                                               int indices[ 4 ], double weights[ 4 ] ) const
+{
+    // Determine grid cell in which evaluation point is located
+    double currentCoordinate = coordinate;
+    if( isPeriodic )
+    {
+        currentCoordinate -= numberOfPoints * std::floor( currentCoordinate / numberOfPoints );
+    }
+    else
+    {
+        currentCoordinate = std::min( std::max( currentCoordinate, 0.0 ), static_cast< double >( numberOfPoints - 1 ) );
+    }
+    int cellIndex = std::min( static_cast< int >( currentCoordinate ), isPeriodic ? numberOfPoints - 1 : numberOfPoints - 2 );
+
+    if( settings_.interpolationType == linear_density_grid_interpolation )
+    {
+        double localCoordinate = currentCoordinate - cellIndex;
+        indices[ 0 ] = cellIndex;
+        indices[ 1 ] = ( cellIndex + 1 ) % numberOfPoints;
+        weights[ 0 ] = 1.0 - localCoordinate;
+        weights[ 1 ] = localCoordinate;
+        return 2;
+    }
+    else
+    {
+        // Use four-point stencil around grid cell (shifted inwards at grid boundaries if not periodic)
+        int firstIndex = isPeriodic ? cellIndex - 1 : std::min( std::max( cellIndex - 1, 0 ), numberOfPoints - 4 );
+        double localCoordinate = currentCoordinate - firstIndex;
+        for( int i = 0; i < 4; i++ )
+        {
+            indices[ i ] = ( firstIndex + i + numberOfPoints ) % numberOfPoints;
+        }
+
+        // Compute cubic Lagrange interpolation weights for nodes at local coordinates 0, 1, 2, 3
+        weights[ 0 ] = -( localCoordinate - 1.0 ) * ( localCoordinate - 2.0 ) * ( localCoordinate - 3.0 ) / 6.0;
+        weights[ 1 ] = localCoordinate * ( localCoordinate - 2.0 ) * ( localCoordinate - 3.0 ) / 2.0;
+        weights[ 2 ] = -localCoordinate * ( localCoordinate - 1.0 ) * ( localCoordinate - 3.0 ) / 2.0;
+        weights[ 3 ] = localCoordinate * ( localCoordinate - 1.0 ) * ( localCoordinate - 2.0 ) / 6.0;
+        return 4;
+    }
+}
+
+} // namespace aerodynamics
+
+} // namespace tudat
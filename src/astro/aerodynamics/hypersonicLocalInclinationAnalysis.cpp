@@ -13,6 +13,7 @@
  *
  */
 
+#include <algorithm>
 #include <string>
 
 #include <boost/bind/bind.hpp>
@@ -26,6 +27,7 @@ using namespace boost::placeholders;
 
 #include <Eigen/Geometry>
 
+#include "tudat/basics/parallelExecution.h"
 #include "tudat/math/basic/mathematicalConstants.h"
 
 #include "tudat/astro/aerodynamics/aerodynamics.h"
@@ -178,14 +180,15 @@ HypersonicLocalInclinationAnalysis::HypersonicLocalInclinationAnalysis(
         const double referenceArea,
         const double referenceLength,
         const Eigen::Vector3d& momentReferencePoint,
-        const bool savePressureCoefficients )
+        const bool savePressureCoefficients,
+        const unsigned int numberOfThreads )
     : AerodynamicCoefficientGenerator< 3, 6 >(
           dataPointsOfIndependentVariables, referenceLength, referenceArea, referenceLength,
           momentReferencePoint, { mach_number_dependent, angle_of_attack_dependent, angle_of_sideslip_dependent },true, false ),
-      stagnationPressureCoefficient( 2.0 ),
       ratioOfSpecificHeats( 1.4 ),
       selectedMethods_( selectedMethods ),
-      savePressureCoefficients_( savePressureCoefficients )
+      savePressureCoefficients_( savePressureCoefficients ),
+      numberOfThreads_( numberOfThreads )
 {
     // Set geometry if it is a single surface.
     if ( std::dynamic_pointer_cast< SingleSurfaceGeometry > ( inputVehicleSurface ) !=
@@ -255,31 +258,35 @@ HypersonicLocalInclinationAnalysis::HypersonicLocalInclinationAnalysis(
         }
     }
 
-    // Allocate memory for panel inclinations and pressureCoefficient_.
-    inclination_.resize( vehicleParts_.size( ) );
-    pressureCoefficient_.resize( vehicleParts_.size( ) );
-    for ( unsigned int i = 0 ; i < vehicleParts_.size( ); i++ )
+    // Store panel properties of each part as flat arrays.
+    panelSurfaceNormals_.resize( vehicleParts_.size( ) );
+    panelAreas_.resize( vehicleParts_.size( ) );
+    panelMomentArmNormalProducts_.resize( vehicleParts_.size( ) );
+    for ( unsigned int k = 0 ; k < vehicleParts_.size( ); k++ )
     {
-        inclination_[ i ].resize( vehicleParts_[ i ]->getNumberOfLines( ) );
-        pressureCoefficient_[ i ].resize( vehicleParts_[ i ]->getNumberOfLines( ) );
-        for ( int j = 0 ; j < vehicleParts_[ i ]->getNumberOfLines( ) ; j++ )
+        int numberOfPanelsPerLine = vehicleParts_[ k ]->getNumberOfPoints( ) - 1;
+        int numberOfPanels = ( vehicleParts_[ k ]->getNumberOfLines( ) - 1 ) * numberOfPanelsPerLine;
+
+        panelSurfaceNormals_[ k ].resize( numberOfPanels, 3 );
+        panelAreas_[ k ].resize( numberOfPanels );
+        panelMomentArmNormalProducts_[ k ].resize( numberOfPanels, 3 );
+        for ( int i = 0 ; i < vehicleParts_[ k ]->getNumberOfLines( ) - 1 ; i++ )
         {
-            inclination_[ i ][ j ].resize( vehicleParts_[ i ]->getNumberOfPoints( ) );
-            pressureCoefficient_[ i ][ j ].resize( vehicleParts_[ i ]->getNumberOfPoints( ) );
+            for ( int j = 0 ; j < numberOfPanelsPerLine ; j++ )
+            {
+                int panelIndex = i * numberOfPanelsPerLine + j;
+                Eigen::Vector3d panelSurfaceNormal = vehicleParts_[ k ]->getPanelSurfaceNormal( i, j );
+
+                panelSurfaceNormals_[ k ].row( panelIndex ) = panelSurfaceNormal.transpose( );
+                panelAreas_[ k ]( panelIndex ) = vehicleParts_[ k ]->getPanelArea( i, j );
+                panelMomentArmNormalProducts_[ k ].row( panelIndex ) =
+                        ( vehicleParts_[ k ]->getPanelCentroid( i, j ) - momentReferencePoint_ ).cross(
+                            panelSurfaceNormal ).transpose( );
+            }
         }
     }
 
-    boost::array< int, 3 > numberOfPointsPerIndependentVariables;
-    for( int i = 0; i < 3; i++ )
-    {
-        numberOfPointsPerIndependentVariables[ i ] =
-                dataPointsOfIndependentVariables_[ i ].size( );
-    }
-
-    isCoefficientGenerated_.resize( numberOfPointsPerIndependentVariables );
-
-    std::fill( isCoefficientGenerated_.origin( ),
-               isCoefficientGenerated_.origin( ) + isCoefficientGenerated_.num_elements( ), 0 );
+    resetIndependentVariableContainers( );
 
     generateCoefficients( );
     createInterpolator( );
@@ -298,219 +305,268 @@ Vector6d HypersonicLocalInclinationAnalysis::getAerodynamicCoefficientsDataPoint
     return aerodynamicCoefficients_( independentVariables );
 }
 
-//! Generate aerodynamic database.
-void HypersonicLocalInclinationAnalysis::generateCoefficients( )
+//! Function to reset the Mach number data points, and regenerate the aerodynamic coefficients.
+void HypersonicLocalInclinationAnalysis::resetMachNumberPoints( const std::vector< double >& machNumberPoints )
+{
+    dataPointsOfIndependentVariables_[ 0 ] = machNumberPoints;
+    resetIndependentVariableContainers( );
+
+    generateCoefficients( );
+    createInterpolator( );
+}
+
+//! Function to retrieve the pressure coefficients of all panels at a given set of independent variables.
+std::vector< std::vector< std::vector< double > > > HypersonicLocalInclinationAnalysis::getPressureCoefficientList(
+        const boost::array< int, 3 > independentVariables )
 {
-    // Allocate variable to pass to coefficient determination for independent
-    // variable indices.
-    boost::array< int, 3 > independentVariableIndices;
+    if( !savePressureCoefficients_ )
+    {
+        throw std::runtime_error( "Error when retrieving pressure coefficients of local inclination analysis, "
+                                  "pressure coefficients are not saved" );
+    }
+
+    if( isCoefficientGenerated_( independentVariables ) == 0 )
+    {
+        determineVehicleCoefficients( independentVariables );
+    }
 
-    // Iterate over all combinations of independent variables.
-    for ( unsigned int i = 0 ; i < dataPointsOfIndependentVariables_[ 0 ].size( ) ; i++ )
+    // Convert pressure coefficients to part-line-point format.
+    const std::vector< Eigen::VectorXd >& pressureCoefficients = savedPressureCoefficients_( independentVariables );
+    std::vector< std::vector< std::vector< double > > > pressureCoefficientList( vehicleParts_.size( ) );
+    for ( unsigned int k = 0 ; k < vehicleParts_.size( ); k++ )
     {
-        independentVariableIndices[ 0 ] = i;
-        for ( unsigned  int j = 0 ; j < dataPointsOfIndependentVariables_[
-              1 ].size( ) ; j++ )
+        int numberOfPanelsPerLine = vehicleParts_[ k ]->getNumberOfPoints( ) - 1;
+        pressureCoefficientList[ k ].resize(
+                    vehicleParts_[ k ]->getNumberOfLines( ),
+                    std::vector< double >( vehicleParts_[ k ]->getNumberOfPoints( ), 0.0 ) );
+        for ( int i = 0 ; i < vehicleParts_[ k ]->getNumberOfLines( ) - 1 ; i++ )
         {
-            independentVariableIndices[ 1 ] = j;
-            for ( unsigned  int k = 0 ; k < dataPointsOfIndependentVariables_[
-                  2 ].size( ) ; k++ )
+            for ( int j = 0 ; j < numberOfPanelsPerLine ; j++ )
             {
-                independentVariableIndices[ 2 ] = k;
-
-                determineVehicleCoefficients( independentVariableIndices );
+                pressureCoefficientList[ k ][ i ][ j ] = pressureCoefficients.at( k )( i * numberOfPanelsPerLine + j );
             }
+        }
+    }
+    return pressureCoefficientList;
+}
+
+//! Function to (re)set the size of the containers with data at each set of independent variables.
+void HypersonicLocalInclinationAnalysis::resetIndependentVariableContainers( )
+{
+    boost::array< int, 3 > numberOfPointsPerIndependentVariables;
+    for( int i = 0; i < 3; i++ )
+    {
+        numberOfPointsPerIndependentVariables[ i ] =
+                dataPointsOfIndependentVariables_[ i ].size( );
+    }
 
+    aerodynamicCoefficients_.resize( numberOfPointsPerIndependentVariables );
+    isCoefficientGenerated_.resize( numberOfPointsPerIndependentVariables );
+    std::fill( isCoefficientGenerated_.origin( ),
+               isCoefficientGenerated_.origin( ) + isCoefficientGenerated_.num_elements( ), 0 );
+
+    if( savePressureCoefficients_ )
+    {
+        savedPressureCoefficients_.resize( numberOfPointsPerIndependentVariables );
+    }
+}
+
+//! Generate aerodynamic database.
+void HypersonicLocalInclinationAnalysis::generateCoefficients( )
+{
+    int numberOfMachPoints = dataPointsOfIndependentVariables_[ 0 ].size( );
+    int numberOfAngleOfAttackPoints = dataPointsOfIndependentVariables_[ 1 ].size( );
+    int numberOfAngleOfSideslipPoints = dataPointsOfIndependentVariables_[ 2 ].size( );
+    unsigned int numberOfWorkers = ( numberOfThreads_ == 0 ) ?
+                utilities::getNumberOfAvailableThreads( ) : numberOfThreads_;
+
+    // Determine attitudes for which the panel inclinations have not yet been computed.
+    std::vector< std::pair< double, double > > newAttitudes;
+    for ( int j = 0 ; j < numberOfAngleOfAttackPoints ; j++ )
+    {
+        for ( int k = 0 ; k < numberOfAngleOfSideslipPoints ; k++ )
+        {
+            std::pair< double, double > currentAttitude = std::make_pair(
+                        dataPointsOfIndependentVariables_[ 1 ][ j ], dataPointsOfIndependentVariables_[ 2 ][ k ] );
+            if( previouslyComputedInclinations_.count( currentAttitude ) == 0 &&
+                    std::find( newAttitudes.begin( ), newAttitudes.end( ), currentAttitude ) == newAttitudes.end( ) )
+            {
+                newAttitudes.push_back( currentAttitude );
+            }
         }
     }
+
+    // Compute panel inclinations for new attitudes, and add them to container.
+    std::vector< std::vector< Eigen::VectorXd > > newInclinations( newAttitudes.size( ) );
+    utilities::executeTasksInParallel(
+                newAttitudes.size( ), numberOfWorkers,
+                [ & ]( const unsigned int attitudeIndex, const unsigned int )
+    {
+        newInclinations[ attitudeIndex ] = computeInclinations(
+                    newAttitudes[ attitudeIndex ].first, newAttitudes[ attitudeIndex ].second );
+    } );
+    for( unsigned int i = 0; i < newAttitudes.size( ); i++ )
+    {
+        previouslyComputedInclinations_[ newAttitudes[ i ] ] = newInclinations[ i ];
+    }
+
+    // Compute coefficients for all combinations of independent variables (each task writing only to its own entries).
+    std::vector< std::vector< Eigen::VectorXd > > threadPressureCoefficients( numberOfWorkers );
+    utilities::executeTasksInParallel(
+                numberOfMachPoints * numberOfAngleOfAttackPoints * numberOfAngleOfSideslipPoints, numberOfWorkers,
+                [ & ]( const unsigned int taskIndex, const unsigned int threadIndex )
+    {
+        boost::array< int, 3 > independentVariableIndices;
+        independentVariableIndices[ 0 ] = taskIndex / ( numberOfAngleOfAttackPoints * numberOfAngleOfSideslipPoints );
+        independentVariableIndices[ 1 ] = ( taskIndex / numberOfAngleOfSideslipPoints ) % numberOfAngleOfAttackPoints;
+        independentVariableIndices[ 2 ] = taskIndex % numberOfAngleOfSideslipPoints;
+
+        std::vector< Eigen::VectorXd >& pressureCoefficients = threadPressureCoefficients[ threadIndex ];
+        aerodynamicCoefficients_( independentVariableIndices ) =
+                computeVehicleCoefficients( independentVariableIndices, pressureCoefficients );
+        if( savePressureCoefficients_ )
+        {
+            savedPressureCoefficients_( independentVariableIndices ) = pressureCoefficients;
+        }
+        isCoefficientGenerated_( independentVariableIndices ) = 1;
+    } );
 }
 
 //! Generate aerodynamic coefficients at a single set of independent variables.
 void HypersonicLocalInclinationAnalysis::determineVehicleCoefficients(
         const boost::array< int, 3 > independentVariableIndices )
 {
-    // Declare coefficients vector and initialize to zeros.
-    Vector6d coefficients = Vector6d::Zero( );
+    // Compute panel inclinations at current attitude, if required.
+    determineInclinations( dataPointsOfIndependentVariables_[ 1 ][ independentVariableIndices[ 1 ] ],
+                           dataPointsOfIndependentVariables_[ 2 ][ independentVariableIndices[ 2 ] ] );
 
-    // Loop over all vehicle parts, calculate aerodynamic coefficients and add
-    // to aerodynamicCoefficients_.
-    for ( unsigned int i = 0 ; i < vehicleParts_.size( ) ; i++ )
-    {
-        coefficients += determinePartCoefficients( i, independentVariableIndices );
-    }
+    std::vector< Eigen::VectorXd > pressureCoefficients;
+    aerodynamicCoefficients_( independentVariableIndices ) =
+            computeVehicleCoefficients( independentVariableIndices, pressureCoefficients );
 
     if( savePressureCoefficients_ )
     {
-        pressureCoefficientList_[ independentVariableIndices ] = pressureCoefficient_;
+        savedPressureCoefficients_( independentVariableIndices ) = pressureCoefficients;
     }
-
-    aerodynamicCoefficients_( independentVariableIndices ) = coefficients;
     isCoefficientGenerated_( independentVariableIndices ) = 1;
 }
 
-//! Determine aerodynamic coefficients of a single vehicle part.
-Vector6d HypersonicLocalInclinationAnalysis::determinePartCoefficients(
-        const int partNumber, const boost::array< int, 3 > independentVariableIndices )
+//! Compute aerodynamic coefficients at a single set of independent variables.
+Vector6d HypersonicLocalInclinationAnalysis::computeVehicleCoefficients(
+        const boost::array< int, 3 > independentVariableIndices,
+        std::vector< Eigen::VectorXd >& pressureCoefficients ) const
 {
-    // Declare and determine angles of attack and sideslip for analysis.
-    double angleOfAttack =  dataPointsOfIndependentVariables_[ 1 ]
-            [ independentVariableIndices[ 1 ] ];
+    // Retrieve Mach number and panel inclinations at current attitude.
+    double machNumber = dataPointsOfIndependentVariables_[ 0 ][ independentVariableIndices[ 0 ] ];
+    const std::vector< Eigen::VectorXd >& inclinations = previouslyComputedInclinations_.at(
+                std::make_pair( dataPointsOfIndependentVariables_[ 1 ][ independentVariableIndices[ 1 ] ],
+                                dataPointsOfIndependentVariables_[ 2 ][ independentVariableIndices[ 2 ] ] ) );
 
-    double angleOfSideslip =  dataPointsOfIndependentVariables_[ 2 ]
-            [ independentVariableIndices[ 2 ] ];
-
-    // Declare partCoefficient vector.
-    Vector6d partCoefficients = Vector6d::Zero( );
+    // Declare coefficients vector and initialize to zeros.
+    Vector6d coefficients = Vector6d::Zero( );
 
-    // Check whether the inclinations of the vehicle part have already been computed.
-    if ( previouslyComputedInclinations_.count( std::pair< double, double >(
-                                                    angleOfAttack, angleOfSideslip ) ) == 0 )
+    // Loop over all vehicle parts, calculate aerodynamic coefficients and add to total.
+    pressureCoefficients.resize( vehicleParts_.size( ) );
+    for ( unsigned int i = 0 ; i < vehicleParts_.size( ) ; i++ )
     {
-        // Determine panel inclinations for part.
-        determineInclinations( angleOfAttack, angleOfSideslip );
-
-        // Add panel inclinations to container
-        previouslyComputedInclinations_[ std::pair< double, double >(
-                    angleOfAttack, angleOfSideslip ) ] = inclination_;
+        coefficients += determinePartCoefficients( i, machNumber, inclinations[ i ], pressureCoefficients[ i ] );
     }
 
-    else
-    {
-        // Fetch inclinations from container
-        inclination_ = previouslyComputedInclinations_[ std::pair< double, double >(
-                    angleOfAttack, angleOfSideslip ) ];
-    }
+    return coefficients;
+}
+
+//! Determine aerodynamic coefficients of a single vehicle part.
+Vector6d HypersonicLocalInclinationAnalysis::determinePartCoefficients(
+        const int partNumber, const double machNumber, const Eigen::VectorXd& inclinations,
+        Eigen::VectorXd& pressureCoefficients ) const
+{
+    // Declare partCoefficient vector.
+    Vector6d partCoefficients = Vector6d::Zero( );
 
-    // Set pressureCoefficient_ array for given independent variables.
-    determinePressureCoefficients( partNumber, independentVariableIndices );
+    // Set pressure coefficients for given independent variables.
+    determinePressureCoefficients( partNumber, machNumber, inclinations, pressureCoefficients );
 
     // Calculate force coefficients from pressure coefficients.
-    partCoefficients.segment( 0, 3 ) = calculateForceCoefficients( partNumber );
+    partCoefficients.segment( 0, 3 ) = calculateForceCoefficients( partNumber, pressureCoefficients );
 
     // Calculate moment coefficients from pressure coefficients.
-    partCoefficients.segment( 3, 3 ) = calculateMomentCoefficients( partNumber );
+    partCoefficients.segment( 3, 3 ) = calculateMomentCoefficients( partNumber, pressureCoefficients );
 
     return partCoefficients;
 }
 
 //! Determine the pressure coefficients on a single vehicle part.
 void HypersonicLocalInclinationAnalysis::determinePressureCoefficients(
-        const int partNumber, const boost::array< int, 3 > independentVariableIndices )
+        const int partNumber, const double machNumber, const Eigen::VectorXd& inclinations,
+        Eigen::VectorXd& pressureCoefficients ) const
 {
-    // Retrieve Mach number.
-    double machNumber = dataPointsOfIndependentVariables_[ 0 ]
-            [ independentVariableIndices[ 0 ] ];
+    pressureCoefficients.setZero( inclinations.rows( ) );
 
-    // Determine stagnation point pressure coefficients. Value is computed once
-    // here to prevent its calculation in inner loop.
-    stagnationPressureCoefficient = computeStagnationPressure(
-                machNumber, ratioOfSpecificHeats );
-
-    updateCompressionPressures( machNumber, partNumber );
-    updateExpansionPressures( machNumber, partNumber );
+    updateCompressionPressures( machNumber, partNumber, inclinations, pressureCoefficients );
+    updateExpansionPressures( machNumber, partNumber, inclinations, pressureCoefficients );
 }
 
 //! Determine force coefficients from pressure coefficients.
 Eigen::Vector3d HypersonicLocalInclinationAnalysis::calculateForceCoefficients(
-        const int partNumber )
+        const int partNumber, const Eigen::VectorXd& pressureCoefficients ) const
 {
-    // Declare force coefficient vector and intialize to zeros.
-    Eigen::Vector3d forceCoefficients = Eigen::Vector3d::Zero( );
-
-    // Loop over all panels and add pressures, scaled by panel area, to force
-    // coefficients.
-    for ( int i = 0 ; i < vehicleParts_[ partNumber ]->getNumberOfLines( ) - 1 ; i++ )
-    {
-        for ( int j = 0 ; j < vehicleParts_[ partNumber ]->getNumberOfPoints( ) - 1 ; j++)
-        {
-            forceCoefficients -=
-                    pressureCoefficient_[ partNumber ][ i ][ j ] *
-                    vehicleParts_[ partNumber ]->getPanelArea( i, j ) *
-                    vehicleParts_[ partNumber ]->getPanelSurfaceNormal( i, j );
-        }
-    }
-
-    // Normalize result by reference area.
-    forceCoefficients /= referenceArea_;
-
-    return forceCoefficients;
+    // Sum pressures, scaled by panel area, in direction of panel normals, and normalize result by reference area.
+    return -panelSurfaceNormals_[ partNumber ].transpose( ) *
+            ( pressureCoefficients.cwiseProduct( panelAreas_[ partNumber ] ) ) / referenceArea_;
 }
 
 //! Determine moment coefficients from pressure coefficients.
 Eigen::Vector3d HypersonicLocalInclinationAnalysis::calculateMomentCoefficients(
-        const int partNumber )
+        const int partNumber, const Eigen::VectorXd& pressureCoefficients ) const
 {
-    // Declare moment coefficient vector and intialize to zeros.
-    Eigen::Vector3d momentCoefficients = Eigen::Vector3d::Zero( );
-
-    // Declare moment arm for panel moment determination.
-    Eigen::Vector3d referenceDistance;
-
-    // Loop over all panels and add moments due pressures.
-    for ( int i = 0 ; i < vehicleParts_[ partNumber ]->getNumberOfLines( ) - 1 ; i++ )
-    {
-        for ( int j = 0 ; j < vehicleParts_[ partNumber ]->getNumberOfPoints( ) - 1 ; j++ )
-        {
-            // Determine moment arm for given panel centroid.
-            referenceDistance = ( vehicleParts_[ partNumber ]->getPanelCentroid( i, j ) -
-                                  momentReferencePoint_ );
-
-            momentCoefficients -=
-                    pressureCoefficient_[ partNumber ][ i ][ j ] *
-                    vehicleParts_[ partNumber ]->getPanelArea( i, j ) *
-                    ( referenceDistance.cross( vehicleParts_[ partNumber ]->
-                                               getPanelSurfaceNormal( i, j ) ) );
-        }
-    }
-
-    // Scale result by reference length and area.
-    momentCoefficients /= ( referenceLength_ * referenceArea_ );
-
-    return momentCoefficients;
+    // Sum moments due to pressures, and scale result by reference length and area.
+    return -panelMomentArmNormalProducts_[ partNumber ].transpose( ) *
+            ( pressureCoefficients.cwiseProduct( panelAreas_[ partNumber ] ) ) /
+            ( referenceLength_ * referenceArea_ );
 }
 
-//! Determines the inclination angle of panels on a single part.
+//! Determines the inclination angle of panels on all parts, and stores them in container.
 void HypersonicLocalInclinationAnalysis::determineInclinations( const double angleOfAttack,
                                                                 const double angleOfSideslip )
 {
-    // Declare free-stream velocity vector.
-    Eigen::Vector3d freestreamVelocityDirection;
+    std::pair< double, double > currentAttitude = std::make_pair( angleOfAttack, angleOfSideslip );
+    if ( previouslyComputedInclinations_.count( currentAttitude ) == 0 )
+    {
+        previouslyComputedInclinations_[ currentAttitude ] = computeInclinations( angleOfAttack, angleOfSideslip );
+    }
+}
 
+//! Computes the inclination angle of panels on all parts.
+std::vector< Eigen::VectorXd > HypersonicLocalInclinationAnalysis::computeInclinations(
+        const double angleOfAttack, const double angleOfSideslip ) const
+{
     // Set freestream velocity vector in body frame.
-    double freestreamVelocityDirectionX = cos( angleOfAttack )* cos( angleOfSideslip );
-    double freestreamVelocityDirectionY = sin( angleOfSideslip );
-    double freestreamVelocityDirectionZ = sin( angleOfAttack ) * cos( angleOfSideslip );
-    freestreamVelocityDirection( 0 ) = freestreamVelocityDirectionX;
-    freestreamVelocityDirection( 1 ) = freestreamVelocityDirectionY;
-    freestreamVelocityDirection( 2 ) = freestreamVelocityDirectionZ;
-
-    // Declare cosine of inclination angle.
-    double cosineOfInclination;
+    Eigen::Vector3d freestreamVelocityDirection;
+    freestreamVelocityDirection( 0 ) = cos( angleOfAttack )* cos( angleOfSideslip );
+    freestreamVelocityDirection( 1 ) = sin( angleOfSideslip );
+    freestreamVelocityDirection( 2 ) = sin( angleOfAttack ) * cos( angleOfSideslip );
 
-    // Loop over all panels of given vehicle part and set inclination angles.
+    // Loop over all panels of all vehicle parts and set inclination angles.
+    std::vector< Eigen::VectorXd > inclinations( vehicleParts_.size( ) );
     for( unsigned int k = 0; k < vehicleParts_.size( ); k++ )
     {
-        for ( int i = 0 ; i < vehicleParts_[ k ]->getNumberOfLines( ) - 1 ; i++ )
-        {
-            for ( int j = 0 ; j < vehicleParts_[ k ]->getNumberOfPoints( ) - 1 ; j++ )
-            {
+        // Determine cosine of inclination angle from inner product between
+        // surface normal and free-stream direction.
+        inclinations[ k ] = panelSurfaceNormals_[ k ] * freestreamVelocityDirection;
 
-                // Determine cosine of inclination angle from inner product between
-                // surface normal and free-stream direction.
-                cosineOfInclination = vehicleParts_[ k ]->
-                        getPanelSurfaceNormal( i, j ).
-                        dot( freestreamVelocityDirection );
-
-                // Set inclination angle.
-                inclination_[ k ][ i ][ j ] = PI / 2.0 - acos( cosineOfInclination );
-            }
+        for( int i = 0; i < inclinations[ k ].rows( ); i++ )
+        {
+            inclinations[ k ]( i ) = PI / 2.0 - acos( inclinations[ k ]( i ) );
         }
     }
+    return inclinations;
 }
 
 //! Determine compression pressure coefficients on all parts.
 void HypersonicLocalInclinationAnalysis::updateCompressionPressures( const double machNumber,
-                                                                     const int partNumber )
+                                                                     const int partNumber,
+                                                                     const Eigen::VectorXd& inclinations,
+                                                                     Eigen::VectorXd& pressureCoefficients ) const
 {
     int method = selectedMethods_[ 0 ][ partNumber ];
 
@@ -527,7 +583,7 @@ void HypersonicLocalInclinationAnalysis::updateCompressionPressures( const doubl
     case 1:
         pressureFunction =
                 std::bind( aerodynamics::computeModifiedNewtonianPressureCoefficient, std::placeholders::_1,
-                           stagnationPressureCoefficient );
+                           computeStagnationPressure( machNumber, ratioOfSpecificHeats ) );
         break;
 
     case 2:
@@ -578,23 +634,21 @@ void HypersonicLocalInclinationAnalysis::updateCompressionPressures( const doubl
         break;
     }
 
-    for ( int i = 0 ; i < vehicleParts_[ partNumber ]->getNumberOfLines( ) - 1; i++ )
+    for ( int i = 0 ; i < inclinations.rows( ); i++ )
     {
-        for ( int j = 0 ; j < vehicleParts_[ partNumber ]->getNumberOfPoints( ) - 1 ; j++ )
+        if ( inclinations( i ) > 0 )
         {
-            if ( inclination_[ partNumber ][ i ][ j ] > 0 )
-            {
-                // If panel inclination is positive, calculate pressure coefficient.
-                pressureCoefficient_[ partNumber ][ i ][ j ] =
-                        pressureFunction( inclination_[ partNumber ][ i ][ j ] );
-            }
+            // If panel inclination is positive, calculate pressure coefficient.
+            pressureCoefficients( i ) = pressureFunction( inclinations( i ) );
         }
     }
 }
 
 //! Determines expansion pressure coefficients on all parts.
 void HypersonicLocalInclinationAnalysis::updateExpansionPressures( const double machNumber,
-                                                                   const int partNumber )
+                                                                   const int partNumber,
+                                                                   const Eigen::VectorXd& inclinations,
+                                                                   Eigen::VectorXd& pressureCoefficients ) const
 {
     // Get analysis method of part to analyze.
     int method = selectedMethods_[ 1 ][ partNumber ];
@@ -621,17 +675,13 @@ void HypersonicLocalInclinationAnalysis::updateExpansionPressures( const double
         }
 
         // Iterate over all panels on part.
-        for ( int i = 0 ; i < vehicleParts_[ partNumber ]->getNumberOfLines( ) - 1 ; i++ )
+        for ( int i = 0 ; i < inclinations.rows( ) ; i++ )
         {
-            for ( int j = 0 ; j < vehicleParts_[ partNumber ]->getNumberOfPoints( ) - 1 ; j++ )
+            if ( inclinations( i ) <= 0 )
             {
-                if ( inclination_[ partNumber ][ i ][ j ] <= 0 )
-                {
-                    // If panel inclination is negative, calculate pressure using
-                    // Van Dyke unified method.
-                    pressureCoefficient_[ partNumber ][ i ][ j ] =
-                            pressureFunction( );
-                }
+                // If panel inclination is negative, calculate pressure using
+                // Van Dyke unified method.
+                pressureCoefficients( i ) = pressureFunction( );
             }
         }
     }
@@ -670,17 +720,13 @@ void HypersonicLocalInclinationAnalysis::updateExpansionPressures( const double
         }
 
         // Iterate over all panels on part.
-        for ( int i = 0 ; i < vehicleParts_[ partNumber ]->getNumberOfLines( ) - 1 ; i++ )
+        for ( int i = 0 ; i < inclinations.rows( ) ; i++ )
         {
-            for ( int j = 0 ; j < vehicleParts_[ partNumber ]->getNumberOfPoints( ) - 1 ; j++ )
+            if ( inclinations( i ) <= 0 )
             {
-                if ( inclination_[ partNumber ][ i ][ j ] <= 0 )
-                {
-                    // If panel inclination is negative, calculate pressure using
-                    // Van Dyke unified method.
-                    pressureCoefficient_[ partNumber ][ i ][ j ] =
-                            pressureFunction( inclination_[ partNumber ][ i ][ j ] );
-                }
+                // If panel inclination is negative, calculate pressure using
+                // Van Dyke unified method.
+                pressureCoefficients( i ) = pressureFunction( inclinations( i ) );
             }
         }
     }
@@ -11,6 +11,7 @@
 #include "tudat/astro/aerodynamics/nrlmsise00Atmosphere.h"
 #include "tudat/math/basic/mathematicalConstants.h"
 #include <iostream>
+#include <stdexcept>
 
 //! Tudat library namespace.
 namespace tudat
@@ -116,6 +117,105 @@ void NRLMSISE00Atmosphere::computeProperties(
     }
 }
 
+//! Set grid of precomputed densities, from which the density is interpolated.
+void NRLMSISE00Atmosphere::setDensityGridCache(
+        const std::shared_ptr< DensityGridCacheSettings > densityGridCacheSettings )
+{
+    if( densityGridCacheSettings == nullptr )
+    {
+        densityGridCache_ = nullptr;
+    }
+    else
+    {
+        if( !( densityGridCacheSettings->inputUpdateInterval > 0.0 ) )
+        {
+            throw std::runtime_error( "Error when setting NRLMSISE00 density grid, input update interval must be positive" );
+        }
+        densityGridCache_ = std::make_shared< DensityGridCache >( *densityGridCacheSettings );
+    }
+    densityGridInputInterval_ = TUDAT_NAN;
+}
+
+//! Get density interpolated from the density grid cache.
+double NRLMSISE00Atmosphere::getDensityFromGrid(
+        const double altitude, const double longitude,
+        const double latitude, const double time )
+{
+    // Retrieve model input once per update interval (intervals start at 0h UT), and recompute grid if input has changed
+    const DensityGridCacheSettings& gridSettings = densityGridCache_->getSettings( );
+    double inputInterval = std::floor( ( time + 43200.0 ) / gridSettings.inputUpdateInterval );
+    if( !( inputInterval == densityGridInputInterval_ ) )
+    {
+        densityGridInputInterval_ = inputInterval;
+        NRLMSISE00Input currentInputData = nrlmsise00InputFunction_(
+                    0.5 * ( gridSettings.minimumAltitude + gridSettings.maximumAltitude ), 0.0, 0.0,
+                    ( inputInterval + 0.5 ) * gridSettings.inputUpdateInterval - 43200.0 );
+
+        if( !densityGridCache_->isGridComputed( ) ||
+                currentInputData.year != densityGridInputData_.year ||
+                currentInputData.dayOfTheYear != densityGridInputData_.dayOfTheYear ||
+                currentInputData.f107 != densityGridInputData_.f107 ||
+                currentInputData.f107a != densityGridInputData_.f107a ||
+                currentInputData.apDaily != densityGridInputData_.apDaily ||
+                currentInputData.apVector != densityGridInputData_.apVector ||
+                currentInputData.switches != densityGridInputData_.switches )
+        {
+            densityGridInputData_ = currentInputData;
+            densityGridCache_->computeGrid(
+                        [ this ]( const double gridAltitude, const double gridLocalSolarTime, const double gridLatitude,
+                                  const double gridTimeOffset )
+            {
+                // Compute longitude at which the local solar time is reached, at the time of day of the input (shifted
+                // by the time offset w.r.t. the epoch at which the input was retrieved). Since the grid is reused for all
+                // input update intervals of a day with the same input, the error is estimated over a full day.
+                NRLMSISE00Input gridInputData = densityGridInputData_;
+                gridInputData.localSolarTime = gridLocalSolarTime;
+                gridInputData.secondOfTheDay += gridTimeOffset;
+                gridInputData.secondOfTheDay -= 86400.0 * std::floor( gridInputData.secondOfTheDay / 86400.0 );
+                double gridLongitude = ( gridLocalSolarTime - gridInputData.secondOfTheDay / 3600.0 ) *
+                        mathematical_constants::PI / 12.0;
+                gridLongitude -= 2.0 * mathematical_constants::PI *
+                        std::floor( ( gridLongitude + mathematical_constants::PI ) / ( 2.0 * mathematical_constants::PI ) );
+                return computeDensityFromInput( gridInputData, gridAltitude, gridLongitude, gridLatitude );
+            }, 86400.0 );
+        }
+    }
+
+    // Compute local solar time, and interpolate density
+    double secondOfTheDay = time + 43200.0 - 86400.0 * std::floor( ( time + 43200.0 ) / 86400.0 );
+    return densityGridCache_->getDensity(
+                altitude, secondOfTheDay / 3600.0 + longitude / ( mathematical_constants::PI / 12.0 ), latitude );
+}
+
+//! Compute the density from the NRLMSISE00 model for given input data, without modifying the current properties.
+double NRLMSISE00Atmosphere::computeDensityFromInput(
+        const NRLMSISE00Input& inputData, const double altitude,
+        const double longitude, const double latitude )
+{
+    ap_array magneticIndices;
+    nrlmsise_flags flags;
+    nrlmsise_input input;
+    nrlmsise_output output;
+
+    std::copy( inputData.apVector.begin( ), inputData.apVector.end( ), magneticIndices.a );
+    std::copy( inputData.switches.begin( ), inputData.switches.end( ), flags.switches );
+
+    input.g_lat  = latitude * 180.0 / mathematical_constants::PI; // rad to deg
+    input.g_long = longitude * 180.0 / mathematical_constants::PI; // rad to deg
+    input.alt    = altitude * 1.0E-3; // m to km
+    input.year   = inputData.year;
+    input.doy    = inputData.dayOfTheYear;
+    input.sec    = inputData.secondOfTheDay;
+    input.lst    = inputData.localSolarTime;
+    input.f107   = inputData.f107;
+    input.f107A  = inputData.f107a;
+    input.ap     = inputData.apDaily;
+    input.ap_a   = &magneticIndices;
+
+    gtd7( &input, &flags, &output );
+    return output.d[ 5 ] * 1000.0; // GM/CM3 to kg/M3
+}
+
 //! Overloaded ostream to print class information.
 std::ostream& operator << ( std::ostream& stream,
                             NRLMSISE00Input& nrlmsiseInput ){
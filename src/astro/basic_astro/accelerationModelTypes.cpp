@@ -74,6 +74,9 @@ std::string getAccelerationModelName( const AvailableAcceleration accelerationTy
     case custom_acceleration:
         accelerationName = "custom acceleration";
         break;
+    case many_body_point_mass_gravity:
+        accelerationName = "many-body central gravity ";
+        break;
     default:
         std::string errorMessage = "Error, acceleration type " +
                 std::to_string( accelerationType ) +
@@ -179,6 +182,10 @@ AvailableAcceleration getAccelerationModelType(
     {
         accelerationType = custom_acceleration;
     }
+    else if( std::dynamic_pointer_cast< ManyBodyPointMassGravityAcceleration >( accelerationModel ) != nullptr )
+    {
+        accelerationType = many_body_point_mass_gravity;
+    }
     else
     {
         throw std::runtime_error(
@@ -58,6 +58,46 @@ Eigen::Quaterniond calculateRotationFromItrsToTirs(
                                Eigen::AngleAxisd( -yPolePosition, Eigen::Vector3d::UnitX( ) ) );
 }
 
+//! Calculate rotation matrix from ITRS to GCRS
+Eigen::Matrix3d calculateRotationMatrixFromItrsToGcrs(
+        const double celestialPoleXPosition, const double celestialPoleYPosition, const double cioLocator,
+        const double earthRotationAngle, const double xPolePosition, const double yPolePosition, const double tioLocator )
+{
+    // Set up rotation from CIRS to GCRS, excluding rotation over CIO locator
+    double xParameterSquared = celestialPoleXPosition * celestialPoleXPosition;
+    double yParameterSquared = celestialPoleYPosition * celestialPoleYPosition;
+    double xyCrossTerm = celestialPoleXPosition * celestialPoleYPosition;
+    double parameterA = 0.5 + 0.125 * ( xParameterSquared + yParameterSquared );
+
+    Eigen::Matrix3d cirsToGcrsRotation;
+    cirsToGcrsRotation << 1.0 - parameterA * xParameterSquared, -parameterA * xyCrossTerm, celestialPoleXPosition,
+            - parameterA * xyCrossTerm, 1.0 - parameterA * yParameterSquared, celestialPoleYPosition,
+            -celestialPoleXPosition, -celestialPoleYPosition, 1.0 - parameterA * ( xParameterSquared + yParameterSquared );
+
+    // Set up combined rotation about z-axis over CIO locator, Earth rotation angle and TIO locator
+    double zAxisRotationAngle = earthRotationAngle - cioLocator + tioLocator;
+    double cosineOfZAxisRotation = std::cos( zAxisRotationAngle );
+    double sineOfZAxisRotation = std::sin( zAxisRotationAngle );
+
+    Eigen::Matrix3d zAxisRotation;
+    zAxisRotation << cosineOfZAxisRotation, -sineOfZAxisRotation, 0.0,
+            sineOfZAxisRotation, cosineOfZAxisRotation, 0.0,
+            0.0, 0.0, 1.0;
+
+    // Set up rotation over polar motion (rotation about y-axis by -x_p, followed by rotation about x-axis by -y_p)
+    double cosineOfXPole = std::cos( xPolePosition );
+    double sineOfXPole = std::sin( xPolePosition );
+    double cosineOfYPole = std::cos( yPolePosition );
+    double sineOfYPole = std::sin( yPolePosition );
+
+    Eigen::Matrix3d polarMotionRotation;
+    polarMotionRotation << cosineOfXPole, sineOfXPole * sineOfYPole, -sineOfXPole * cosineOfYPole,
+            0.0, cosineOfYPole, sineOfYPole,
+            sineOfXPole, -cosineOfXPole * sineOfYPole, cosineOfXPole * cosineOfYPole;
+
+    return cirsToGcrsRotation * ( zAxisRotation * polarMotionRotation );
+}
+
 //! Function to create an EarthOrientationAnglesCalculator object, with default settings
 std::shared_ptr< EarthOrientationAnglesCalculator > createStandardEarthOrientationCalculator(
         const std::shared_ptr< EOPReader > eopReader )
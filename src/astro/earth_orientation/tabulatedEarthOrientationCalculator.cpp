@@ -0,0 +1,167 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "tudat/astro/earth_orientation/tabulatedEarthOrientationCalculator.h"
+#include "tudat/interface/sofa/earthOrientation.h"
+
+namespace tudat
+{
+
+namespace earth_orientation
+{
+
+//! Constructor, computes the tables of the earth orientation angles
+TabulatedEarthOrientationAnglesCalculator::TabulatedEarthOrientationAnglesCalculator(
+        const std::shared_ptr< EarthOrientationAnglesCalculator > earthOrientationCalculator,
+        const double intervalStart,
+        const double intervalEnd,
+        const double timeStep,
+        const basic_astrodynamics::TimeScales inputTimeScale,
+        const int numberOfInterpolationPoints ):
+    earthOrientationCalculator_( earthOrientationCalculator ),
+    inputTimeScale_( inputTimeScale ),
+    intervalStart_( intervalStart ),
+    intervalEnd_( intervalEnd ),
+    timeStep_( timeStep ),
+    numberOfInterpolationPoints_( numberOfInterpolationPoints )
+{
+    // Check input consistency
+    if( !( intervalEnd_ > intervalStart_ ) || !( timeStep_ > 0.0 ) )
+    {
+        throw std::runtime_error( "Error when creating tabulated Earth orientation, time interval or step is invalid" );
+    }
+
+    if( numberOfInterpolationPoints_ < 2 || numberOfInterpolationPoints_ % 2 != 0 )
+    {
+        throw std::runtime_error( "Error when creating tabulated Earth orientation, number of interpolation points must "
+                                  "be even and positive" );
+    }
+
+    if( inputTimeScale_ != basic_astrodynamics::tdb_scale && inputTimeScale_ != basic_astrodynamics::tt_scale &&
+            inputTimeScale_ != basic_astrodynamics::tai_scale )
+    {
+        throw std::runtime_error( "Error when creating tabulated Earth orientation, input time scale " +
+                                  std::to_string( inputTimeScale_ ) + " not supported" );
+    }
+
+    // Retrieve interpolators of daily IERS values
+    cipInGcrsCorrectionInterpolator_ =
+            earthOrientationCalculator_->getPrecessionNutationCalculator( )->getDailyCorrectionInterpolator( );
+    cipInItrsInterpolator_ = earthOrientationCalculator_->getPolarMotionCalculator( )->getDailyIersValueInterpolator( );
+    dailyUtcUt1CorrectionInterpolator_ =
+            earthOrientationCalculator_->getTerrestrialTimeScaleConverter( )->getDailyUtcUt1CorrectionInterpolator( );
+
+    std::shared_ptr< ShortPeriodEarthOrientationCorrectionCalculator< Eigen::Vector2d > > shortPeriodPolarMotionCalculator =
+            earthOrientationCalculator_->getPolarMotionCalculator( )->getShortPeriodPolarMotionCalculator( );
+    std::shared_ptr< ShortPeriodEarthOrientationCorrectionCalculator< double > > shortPeriodUt1CorrectionCalculator =
+            earthOrientationCalculator_->getTerrestrialTimeScaleConverter( )->getShortPeriodUt1CorrectionCalculator( );
+    basic_astrodynamics::IAUConventions precessionNutationTheory =
+            earthOrientationCalculator_->getPrecessionNutationCalculator( )->getPrecessionNutationTheory( );
+
+    // Tabulate smooth contributions to angles, with half the number of interpolation points outside interval on either side
+    int halfNumberOfPoints = numberOfInterpolationPoints_ / 2;
+    int numberOfIntervals = static_cast< int >( std::ceil( ( intervalEnd_ - intervalStart_ ) / timeStep_ ) );
+    int numberOfTabulatedTimes = numberOfIntervals + 2 * halfNumberOfPoints + 1;
+    firstTabulatedTime_ = intervalStart_ - halfNumberOfPoints * timeStep_;
+
+    tabulatedValues_.resize( 8, numberOfTabulatedTimes );
+    for( int i = 0; i < numberOfTabulatedTimes; i++ )
+    {
+        double currentTime = firstTabulatedTime_ + i * timeStep_;
+
+        // Compute difference between TAI and input time, and TT
+        double taiMinusInputTime;
+        if( inputTimeScale_ == basic_astrodynamics::tdb_scale )
+        {
+            taiMinusInputTime = -sofa_interface::getTDBminusTT( currentTime, 0.0, 0.0, 0.0 ) -
+                    basic_astrodynamics::TT_MINUS_TAI;
+        }
+        else if( inputTimeScale_ == basic_astrodynamics::tt_scale )
+        {
+            taiMinusInputTime = -basic_astrodynamics::TT_MINUS_TAI;
+        }
+        else
+        {
+            taiMinusInputTime = 0.0;
+        }
+        double terrestrialTime = ( currentTime + taiMinusInputTime ) + basic_astrodynamics::TT_MINUS_TAI;
+
+        // Compute nominal precession-nutation and short-period polar motion and UT1 variations
+        std::pair< Eigen::Vector2d, double > nominalCipPosition = sofa_interface::getPositionOfCipInGcrs(
+                    terrestrialTime, basic_astrodynamics::JULIAN_DAY_ON_J2000, precessionNutationTheory );
+
+        tabulatedValues_.block( 0, i, 2, 1 ) = nominalCipPosition.first;
+        tabulatedValues_( 2, i ) = nominalCipPosition.second;
+        tabulatedValues_.block( 3, i, 2, 1 ) = shortPeriodPolarMotionCalculator->getCorrections( terrestrialTime );
+        tabulatedValues_( 5, i ) = taiMinusInputTime;
+        tabulatedValues_( 6, i ) = shortPeriodUt1CorrectionCalculator->getCorrections( terrestrialTime );
+        tabulatedValues_( 7, i ) = getApproximateTioLocator( currentTime );
+    }
+
+    // Pre-compute denominators of Lagrange polynomials for equidistant points
+    lagrangeDenominators_.resize( numberOfInterpolationPoints_ );
+    for( int j = 0; j < numberOfInterpolationPoints_; j++ )
+    {
+        lagrangeDenominators_[ j ] = 1.0;
+        for( int k = 0; k < numberOfInterpolationPoints_; k++ )
+        {
+            if( k != j )
+            {
+                lagrangeDenominators_[ j ] *= static_cast< double >( j - k );
+            }
+        }
+    }
+    lagrangeWeights_.setZero( numberOfInterpolationPoints_ );
+    leftProducts_.resize( numberOfInterpolationPoints_ );
+    currentValues_.setConstant( TUDAT_NAN );
+}
+
+//! Function to interpolate the tabulated values at the given time
+bool TabulatedEarthOrientationAnglesCalculator::interpolateTabulatedValues( const double timeValue )
+{
+    if( !( timeValue >= intervalStart_ && timeValue <= intervalEnd_ ) )
+    {
+        return false;
+    }
+
+    // Find first point used for interpolation, such that time is in the central interval
+    int halfNumberOfPoints = numberOfInterpolationPoints_ / 2;
+    int firstIndex = static_cast< int >( std::floor( ( timeValue - firstTabulatedTime_ ) / timeStep_ ) ) -
+            ( halfNumberOfPoints - 1 );
+    firstIndex = std::min( std::max( firstIndex, 0 ),
+                           static_cast< int >( tabulatedValues_.cols( ) ) - numberOfInterpolationPoints_ );
+    double scaledTime = ( timeValue - ( firstTabulatedTime_ + firstIndex * timeStep_ ) ) / timeStep_;
+
+    // Compute Lagrange polynomials from products of (u - k) for k < j and k > j
+    double currentProduct = 1.0;
+    for( int j = 0; j < numberOfInterpolationPoints_; j++ )
+    {
+        leftProducts_[ j ] = currentProduct;
+        currentProduct *= ( scaledTime - static_cast< double >( j ) );
+    }
+    currentProduct = 1.0;
+    for( int j = numberOfInterpolationPoints_ - 1; j >= 0; j-- )
+    {
+        lagrangeWeights_( j ) = leftProducts_[ j ] * currentProduct / lagrangeDenominators_[ j ];
+        currentProduct *= ( scaledTime - static_cast< double >( j ) );
+    }
+
+    currentValues_.noalias( ) = tabulatedValues_.middleCols( firstIndex, numberOfInterpolationPoints_ ) * lagrangeWeights_;
+    return true;
+}
+
+} // namespace earth_orientation
+
+} // namespace tudat
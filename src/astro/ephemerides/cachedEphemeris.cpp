@@ -0,0 +1,155 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include "tudat/astro/ephemerides/cachedEphemeris.h"
+
+namespace tudat
+{
+
+namespace ephemerides
+{
+
+//! Constructor
+CachedEphemeris::CachedEphemeris( const std::shared_ptr< Ephemeris > baseEphemeris,
+                                  const unsigned int maximumCacheSize,
+                                  const double gridSpacing,
+                                  const unsigned int numberOfInterpolationNodes ):
+    Ephemeris( ( baseEphemeris == nullptr ) ? "" : baseEphemeris->getReferenceFrameOrigin( ),
+               ( baseEphemeris == nullptr ) ? "" : baseEphemeris->getReferenceFrameOrientation( ) ),
+    baseEphemeris_( baseEphemeris ), maximumCacheSize_( maximumCacheSize ),
+    gridSpacing_( gridSpacing ), numberOfInterpolationNodes_( numberOfInterpolationNodes ),
+    numberOfCacheHits_( 0 ), numberOfCacheMisses_( 0 )
+{
+    if( baseEphemeris_ == nullptr )
+    {
+        throw std::runtime_error( "Error when creating cached ephemeris, no ephemeris provided" );
+    }
+
+    if( maximumCacheSize_ == 0 )
+    {
+        throw std::runtime_error( "Error when creating cached ephemeris, maximum cache size must be positive" );
+    }
+
+    if( gridSpacing_ == gridSpacing_ )
+    {
+        if( !( gridSpacing_ > 0.0 ) )
+        {
+            throw std::runtime_error( "Error when creating cached ephemeris, grid spacing must be positive" );
+        }
+
+        if( numberOfInterpolationNodes_ < 2 )
+        {
+            throw std::runtime_error( "Error when creating cached ephemeris, at least 2 interpolation nodes required" );
+        }
+
+        if( maximumCacheSize_ < numberOfInterpolationNodes_ )
+        {
+            throw std::runtime_error( "Error when creating cached ephemeris, maximum cache size must be at least the "
+                                      "number of interpolation nodes" );
+        }
+    }
+}
+
+//! Get state from ephemeris.
+Eigen::Vector6d CachedEphemeris::getCartesianState( const double secondsSinceEpoch )
+{
+    if( gridSpacing_ == gridSpacing_ )
+    {
+        bool isStateCached = true;
+        Eigen::Vector6d currentState;
+
+        // Retrieve state directly if requested epoch is a grid epoch
+        const double scaledTime = secondsSinceEpoch / gridSpacing_;
+        const double nearestGridIndex = std::round( scaledTime );
+        if( scaledTime == nearestGridIndex )
+        {
+            currentState = getGridState( static_cast< long long >( nearestGridIndex ), isStateCached );
+        }
+        // Interpolate states at grid epochs surrounding requested epoch
+        else
+        {
+            const int numberOfNodes = static_cast< int >( numberOfInterpolationNodes_ );
+            const long long firstGridIndex =
+                    static_cast< long long >( std::floor( scaledTime ) ) - ( numberOfNodes - 1 ) / 2;
+
+            // Clear cache beforehand if it may overflow, so that all nodes remain valid during interpolation
+            if( gridStateCache_.size( ) + numberOfInterpolationNodes_ > maximumCacheSize_ )
+            {
+                gridStateCache_.clear( );
+            }
+
+            currentState.setZero( );
+            for( int i = 0; i < numberOfNodes; i++ )
+            {
+                double lagrangeCoefficient = 1.0;
+                for( int j = 0; j < numberOfNodes; j++ )
+                {
+                    if( j != i )
+                    {
+                        lagrangeCoefficient *= ( scaledTime - static_cast< double >( firstGridIndex + j ) ) /
+                                static_cast< double >( i - j );
+                    }
+                }
+                currentState += lagrangeCoefficient * getGridState( firstGridIndex + i, isStateCached );
+            }
+        }
+
+        if( isStateCached )
+        {
+            numberOfCacheHits_++;
+        }
+        return currentState;
+    }
+
+    std::unordered_map< double, Eigen::Vector6d >::const_iterator cacheIterator =
+            stateCache_.find( secondsSinceEpoch );
+    if( cacheIterator != stateCache_.end( ) )
+    {
+        numberOfCacheHits_++;
+        return cacheIterator->second;
+    }
+
+    numberOfCacheMisses_++;
+    if( stateCache_.size( ) >= maximumCacheSize_ )
+    {
+        stateCache_.clear( );
+    }
+
+    Eigen::Vector6d currentState = baseEphemeris_->getCartesianState( secondsSinceEpoch );
+    stateCache_[ secondsSinceEpoch ] = currentState;
+    return currentState;
+}
+
+//! Function to retrieve the state at a grid epoch from the cache, evaluating the wrapped ephemeris if needed
+const Eigen::Vector6d& CachedEphemeris::getGridState( const long long gridIndex, bool& isStateCached )
+{
+    std::unordered_map< long long, Eigen::Vector6d >::const_iterator cacheIterator = gridStateCache_.find( gridIndex );
+    if( cacheIterator != gridStateCache_.end( ) )
+    {
+        return cacheIterator->second;
+    }
+
+    numberOfCacheMisses_++;
+    isStateCached = false;
+    if( gridStateCache_.size( ) >= maximumCacheSize_ )
+    {
+        gridStateCache_.clear( );
+    }
+
+    return gridStateCache_[ gridIndex ] =
+            baseEphemeris_->getCartesianState( static_cast< double >( gridIndex ) * gridSpacing_ );
+}
+
+} // namespace ephemerides
+
+} // namespace tudat
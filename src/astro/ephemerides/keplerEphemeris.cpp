@@ -9,6 +9,10 @@
  *
  */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "tudat/astro/ephemerides/keplerEphemeris.h"
 #include "tudat/astro/basic_astro/astrodynamicsFunctions.h"
 #include "tudat/astro/basic_astro/convertMeanToEccentricAnomalies.h"
@@ -166,5 +170,82 @@ Eigen::Vector6d KeplerEphemeris::getCartesianState(
     return currentCartesianState;
 }
 
+//! Function to get states from ephemeris at a list of times.
+void KeplerEphemeris::getCartesianStates(
+        const std::vector< double >& times,
+        Eigen::Matrix< double, 6, Eigen::Dynamic >& states )
+{
+    using mathematical_constants::PI;
+
+    if( isOrbitHyperbolic_ )
+    {
+        Ephemeris::getCartesianStates( times, states );
+        return;
+    }
+
+    states.resize( 6, times.size( ) );
+
+    const double meanMotion = std::sqrt( centralBodyGravitationalParameter_ /
+                                         ( semiMajorAxis_ * semiMajorAxis_ * semiMajorAxis_ ) );
+    const double semiMinorAxisRatio = std::sqrt( 1.0 - eccentricity_ * eccentricity_ );
+    const double velocityScaling = std::sqrt( centralBodyGravitationalParameter_ * semiMajorAxis_ );
+    double tolerance = 10.0 * std::numeric_limits< double >::epsilon( );
+    if( std::fabs( eccentricity_ - 1.0 ) < 1.0E5 * std::numeric_limits< double >::epsilon( ) )
+    {
+        tolerance *= 2.5;
+    }
+    const Eigen::Matrix3d rotationFromOrbitalPlane = rotationFromOrbitalPlane_.toRotationMatrix( );
+
+    // Process times in blocks, so that all intermediate arrays remain in cache.
+    const int maximumBlockSize = 256;
+    Eigen::ArrayXd meanAnomalies, eccentricAnomalies, sineOfEccentricAnomalies, cosineOfEccentricAnomalies;
+    Eigen::Matrix< double, 2, Eigen::Dynamic > planarCoordinates;
+    for( int blockStart = 0; blockStart < static_cast< int >( times.size( ) ); blockStart += maximumBlockSize )
+    {
+        int blockSize = std::min( maximumBlockSize, static_cast< int >( times.size( ) ) - blockStart );
+
+        // Compute mean anomalies in range [0, 2 PI).
+        meanAnomalies = initialMeanAnomaly_ + meanMotion * (
+                    Eigen::Map< const Eigen::ArrayXd >( times.data( ) + blockStart, blockSize ) - epochOfInitialState_ );
+        meanAnomalies -= 2.0 * PI * ( meanAnomalies / ( 2.0 * PI ) ).floor( );
+
+        // Solve Kepler's equation for all mean anomalies simultaneously.
+        eccentricAnomalies = ( meanAnomalies > PI ).select( meanAnomalies - eccentricity_, meanAnomalies + eccentricity_ );
+        bool isConverged = false;
+        for( int i = 0; i < 20 && !isConverged; i++ )
+        {
+            sineOfEccentricAnomalies = eccentricAnomalies.sin( );
+            cosineOfEccentricAnomalies = eccentricAnomalies.cos( );
+            Eigen::ArrayXd eccentricAnomalyCorrections =
+                    ( eccentricAnomalies - eccentricity_ * sineOfEccentricAnomalies - meanAnomalies ) /
+                    ( 1.0 - eccentricity_ * cosineOfEccentricAnomalies );
+            eccentricAnomalies -= eccentricAnomalyCorrections;
+            isConverged = ( eccentricAnomalyCorrections.abs( ).maxCoeff( ) < tolerance );
+        }
+
+        if( !isConverged )
+        {
+            throw std::runtime_error( "Error in Kepler ephemeris, Kepler's equation did not converge for list of times" );
+        }
+        sineOfEccentricAnomalies = eccentricAnomalies.sin( );
+        cosineOfEccentricAnomalies = eccentricAnomalies.cos( );
+
+        // Compute position in orbital plane, and rotate to correct orientation.
+        planarCoordinates.resize( 2, blockSize );
+        planarCoordinates.row( 0 ) = semiMajorAxis_ * ( cosineOfEccentricAnomalies - eccentricity_ ).matrix( ).transpose( );
+        planarCoordinates.row( 1 ) = semiMajorAxis_ * semiMinorAxisRatio *
+                sineOfEccentricAnomalies.matrix( ).transpose( );
+        states.block( 0, blockStart, 3, blockSize ) = rotationFromOrbitalPlane.leftCols( 2 ) * planarCoordinates;
+
+        // Compute velocity in orbital plane, and rotate to correct orientation.
+        Eigen::ArrayXd velocityMagnitudeFactors =
+                velocityScaling / ( semiMajorAxis_ * ( 1.0 - eccentricity_ * cosineOfEccentricAnomalies ) );
+        planarCoordinates.row( 0 ) = -( velocityMagnitudeFactors * sineOfEccentricAnomalies ).matrix( ).transpose( );
+        planarCoordinates.row( 1 ) = semiMinorAxisRatio *
+                ( velocityMagnitudeFactors * cosineOfEccentricAnomalies ).matrix( ).transpose( );
+        states.block( 3, blockStart, 3, blockSize ) = rotationFromOrbitalPlane.leftCols( 2 ) * planarCoordinates;
+    }
+}
+
 } // namespace ephemerides
 } // namespace tudat
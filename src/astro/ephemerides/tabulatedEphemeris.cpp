@@ -20,11 +20,7 @@ template< >
 Eigen::Vector6d TabulatedCartesianEphemeris< double, double >::getCartesianState(
         const double ephemerisTime)
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( ephemerisTime );
+    return interpolateState( ephemerisTime );
 }
 
 //! Get cartesian state from ephemeris (in long double precision), for double StateScalarType
@@ -32,11 +28,7 @@ template< >
 Eigen::Matrix< long double, 6, 1 > TabulatedCartesianEphemeris< double, double >::getCartesianLongState(
         const double secondsSinceEpoch )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( secondsSinceEpoch ).cast< long double >( );
+    return interpolateState( secondsSinceEpoch ).cast< long double >( );
 }
 
 //! Get cartesian state from ephemeris (in double precision from Time input), for double StateScalarType
@@ -44,11 +36,7 @@ template< >
 Eigen::Vector6d TabulatedCartesianEphemeris< double, double >::getCartesianStateFromExtendedTime(
         const Time& time )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( time.getSeconds< double >( ) );
+    return interpolateState( time.getSeconds< double >( ) );
 }
 
 //! Get cartesian state from ephemeris (in long double precision from Time input), for double StateScalarType
@@ -56,11 +44,7 @@ template< >
 Eigen::Matrix< long double, 6, 1 > TabulatedCartesianEphemeris< double, double >::getCartesianLongStateFromExtendedTime(
         const Time& time )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( time.getSeconds< double >( ) ).cast< long double >( );
+    return interpolateState( time.getSeconds< double >( ) ).cast< long double >( );
 }
 
 
@@ -72,11 +56,7 @@ template< >
 Eigen::Vector6d TabulatedCartesianEphemeris< long double, double >::getCartesianState(
         const double ephemerisTime )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( ephemerisTime ).cast< double >( );
+    return interpolateState( ephemerisTime ).cast< double >( );
 }
 
 //! Get cartesian state from ephemeris (in long double precision), for long double StateScalarType
@@ -84,11 +64,7 @@ template< >
 Eigen::Matrix< long double, 6, 1 > TabulatedCartesianEphemeris< long double, double >::getCartesianLongState(
         const double secondsSinceEpoch )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( secondsSinceEpoch );
+    return interpolateState( secondsSinceEpoch );
 }
 
 //! Get cartesian state from ephemeris (in double precision from Time input), for double StateScalarType
@@ -96,11 +72,7 @@ template< >
 Eigen::Vector6d TabulatedCartesianEphemeris< long double, double >::getCartesianStateFromExtendedTime(
         const Time& time )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( time.getSeconds< double >( ) ).cast< double >( );
+    return interpolateState( time.getSeconds< double >( ) ).cast< double >( );
 }
 
 //! Get cartesian state from ephemeris (in long double precision from Time input), for double StateScalarType
@@ -108,11 +80,7 @@ template< >
 Eigen::Matrix< long double, 6, 1 > TabulatedCartesianEphemeris< long double, double >::getCartesianLongStateFromExtendedTime(
         const Time& time )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( time.getSeconds< double >( ) );
+    return interpolateState( time.getSeconds< double >( ) );
 }
 
 
@@ -121,11 +89,7 @@ template< >
 Eigen::Vector6d TabulatedCartesianEphemeris< double, Time >::getCartesianState(
         const double ephemerisTime )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( Time( ephemerisTime ) );
+    return interpolateState( Time( ephemerisTime ) );
 }
 
 //! Get cartesian state from ephemeris (in long double precision), for double StateScalarType
@@ -133,11 +97,7 @@ template< >
 Eigen::Matrix< long double, 6, 1 > TabulatedCartesianEphemeris< double, Time >::getCartesianLongState(
         const double secondsSinceEpoch )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( Time( secondsSinceEpoch ) ).cast< long double >( );
+    return interpolateState( Time( secondsSinceEpoch ) ).cast< long double >( );
 }
 
 //! Get cartesian state from ephemeris (in double precision from Time input).
@@ -145,11 +105,7 @@ template< >
 Eigen::Vector6d TabulatedCartesianEphemeris< double, Time >::getCartesianStateFromExtendedTime(
         const Time& time )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( time );
+    return interpolateState( time );
 }
 
 //! Get cartesian state from ephemeris (in long double precision from Time input).
@@ -157,11 +113,7 @@ template< >
 Eigen::Matrix< long double, 6, 1 > TabulatedCartesianEphemeris< double, Time >::getCartesianLongStateFromExtendedTime(
         const Time& time )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( time ).cast< long double >( );
+    return interpolateState( time ).cast< long double >( );
 }
 
 
@@ -171,11 +123,7 @@ template< >
 Eigen::Vector6d TabulatedCartesianEphemeris< long double, Time >::getCartesianState(
         const double ephemerisTime )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( Time( ephemerisTime ) ).cast< double >( );
+    return interpolateState( Time( ephemerisTime ) ).cast< double >( );
 }
 
 //! Get cartesian state from ephemeris (in long double precision), for long double StateScalarType
@@ -183,11 +131,7 @@ template< >
 Eigen::Matrix< long double, 6, 1 > TabulatedCartesianEphemeris< long double, Time >::getCartesianLongState(
         const double secondsSinceEpoch )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( Time( secondsSinceEpoch ) );
+    return interpolateState( Time( secondsSinceEpoch ) );
 }
 
 //! Get cartesian state from ephemeris (in double precision from Time input).
@@ -195,11 +139,7 @@ template< >
 Eigen::Vector6d TabulatedCartesianEphemeris< long double, Time >::getCartesianStateFromExtendedTime(
         const Time& time )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( time ).cast< double >( );
+    return interpolateState( time ).cast< double >( );
 }
 
 //! Get cartesian state from ephemeris (in long double precision from Time input).
@@ -207,11 +147,7 @@ template< >
 Eigen::Matrix< long double, 6, 1 > TabulatedCartesianEphemeris< long double, Time >::getCartesianLongStateFromExtendedTime(
         const Time& time )
 {
-    if( interpolator_ == nullptr )
-    {
-        throw std::runtime_error( "Error when calling TabulatedCartesianEphemeris, no state interpolator defined" );
-    }
-    return interpolator_->interpolate( time );
+    return interpolateState( time );
 }
 
 
@@ -264,6 +200,35 @@ std::pair< double, double > getTabulatedEphemerisSafeInterval( const std::shared
     return safeInterval;
 }
 
+//! Function to set whether a tabulated ephemeris caches the states of its most recent queries
+void setTabulatedEphemerisQueryCache( const std::shared_ptr< Ephemeris > ephemeris, const bool useQueryCache )
+{
+    if( std::dynamic_pointer_cast< TabulatedCartesianEphemeris< double, double > >( ephemeris ) != nullptr )
+    {
+        std::dynamic_pointer_cast< TabulatedCartesianEphemeris< double, double > >(
+                    ephemeris )->setUseQueryCache( useQueryCache );
+    }
+    else if( std::dynamic_pointer_cast< TabulatedCartesianEphemeris< long double, double > >( ephemeris ) != nullptr )
+    {
+        std::dynamic_pointer_cast< TabulatedCartesianEphemeris< long double, double > >(
+                    ephemeris )->setUseQueryCache( useQueryCache );
+    }
+    else if ( std::dynamic_pointer_cast< TabulatedCartesianEphemeris< long double, Time > >( ephemeris ) != nullptr )
+    {
+        std::dynamic_pointer_cast< TabulatedCartesianEphemeris< long double, Time > >(
+                    ephemeris )->setUseQueryCache( useQueryCache );
+    }
+    else if( std::dynamic_pointer_cast< TabulatedCartesianEphemeris< double, Time > >( ephemeris ) != nullptr )
+    {
+        std::dynamic_pointer_cast< TabulatedCartesianEphemeris< double, Time > >(
+                    ephemeris )->setUseQueryCache( useQueryCache );
+    }
+    else
+    {
+        throw std::runtime_error( "Error when setting tabulated ephemeris query cache, input is not a tabulated ephemeris" );
+    }
+}
+
 
 } // namespace ephemerides
 
@@ -0,0 +1,631 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Hoots, F.R., Roehrich, R.L. Models for Propagation of NORAD Element Sets, Spacetrack Report No. 3, 1980.
+ *      Vallado, D.A., Crawford, P., Hujsak, R., Kelso, T.S. Revisiting Spacetrack Report #3, AIAA 2006-6753, 2006.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include "tudat/basics/parallelExecution.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+#include "tudat/interface/spice/spiceInterface.h"
+
+#include "tudat/astro/ephemerides/tleCatalogue.h"
+
+namespace tudat
+{
+namespace ephemerides
+{
+
+//! Typedef for array of values of a quantity for each lane (object) of the TLE catalogue propagator.
+typedef Eigen::Array< double, SGP4_BATCH_LANE_WIDTH, 1 > Sgp4LaneArray;
+
+//! Typedef for array of flags for each lane (object) of the TLE catalogue propagator.
+typedef Eigen::Array< bool, SGP4_BATCH_LANE_WIDTH, 1 > Sgp4LaneMask;
+
+//! Number of objects in a single task of the thread pool.
+constexpr int SGP4_BATCH_TASK_SIZE = 256 * SGP4_BATCH_LANE_WIDTH;
+
+//! WGS-72 constants used by SGP4, identical to those used by TleEphemeris (through Spice).
+constexpr double SGP4_J2 = 1.082616E-3;
+constexpr double SGP4_J3 = -2.53881E-6;
+constexpr double SGP4_J4 = -1.65597E-6;
+constexpr double SGP4_KE = 7.43669161E-2;
+constexpr double SGP4_EARTH_RADIUS = 6378.135;
+constexpr double SGP4_Q0 = 120.0;
+constexpr double SGP4_S0 = 78.0;
+
+//! Minimum orbital period (in minutes) for which the deep-space (SDP4) model is required.
+constexpr double SGP4_DEEP_SPACE_PERIOD_LIMIT = 225.0;
+
+//! SGP4 elements and coefficients, stored in the columns of TleCatalogue::sgp4Coefficients_.
+enum Sgp4Coefficients
+{
+    sgp4_epoch,
+    sgp4_b_star,
+    sgp4_inclination,
+    sgp4_right_ascension,
+    sgp4_argument_of_perigee,
+    sgp4_mean_anomaly,
+    sgp4_eccentricity,
+    sgp4_mean_motion,
+    sgp4_semi_major_axis,
+    sgp4_is_simplified,
+    sgp4_cosine_inclination,
+    sgp4_sine_inclination,
+    sgp4_con41,
+    sgp4_x1mth2,
+    sgp4_x7thm1,
+    sgp4_eta,
+    sgp4_delmo,
+    sgp4_sinmao,
+    sgp4_cc1,
+    sgp4_cc4,
+    sgp4_cc5,
+    sgp4_d2,
+    sgp4_d3,
+    sgp4_d4,
+    sgp4_t2cof,
+    sgp4_t3cof,
+    sgp4_t4cof,
+    sgp4_t5cof,
+    sgp4_mdot,
+    sgp4_argpdot,
+    sgp4_nodedot,
+    sgp4_nodecf,
+    sgp4_omgcof,
+    sgp4_xmcof,
+    sgp4_aycof,
+    sgp4_xlcof,
+    number_of_sgp4_coefficients
+};
+
+//! Function to compute the un-Kozai'd (Brouwer) mean motion from the TLE (Kozai) mean motion.
+double computeUnKozaiMeanMotion( const double meanMotion, const double eccentricity, const double inclination )
+{
+    const double cosineOfInclination = std::cos( inclination );
+    const double betaSquared = 1.0 - eccentricity * eccentricity;
+    const double semiMajorAxisKozai = std::pow( SGP4_KE / meanMotion, 2.0 / 3.0 );
+    const double d1 = 0.75 * SGP4_J2 * ( 3.0 * cosineOfInclination * cosineOfInclination - 1.0 ) /
+            ( std::sqrt( betaSquared ) * betaSquared );
+    double delta = d1 / ( semiMajorAxisKozai * semiMajorAxisKozai );
+    const double semiMajorAxis = semiMajorAxisKozai * (
+                1.0 - delta * delta - delta * ( 1.0 / 3.0 + 134.0 * delta * delta / 81.0 ) );
+    delta = d1 / ( semiMajorAxis * semiMajorAxis );
+    return meanMotion / ( 1.0 + delta );
+}
+
+//! Function to compute the SGP4 coefficients of a single near-Earth object (sgp4init of Vallado et al., 2006).
+void computeSgp4Coefficients( const Tle& tle, Eigen::Ref< Eigen::ArrayXd > coefficients )
+{
+    const double eccentricity = tle.getEccentricity( );
+    const double inclination = tle.getInclination( );
+    const double argumentOfPerigee = tle.getArgOfPerigee( );
+    const double meanAnomaly = tle.getMeanAnomaly( );
+    const double bStar = tle.getBStar( );
+    const double meanMotion = computeUnKozaiMeanMotion( tle.getMeanMotion( ), eccentricity, inclination );
+
+    const double j3OverJ2 = SGP4_J3 / SGP4_J2;
+    const double cosio = std::cos( inclination );
+    const double sinio = std::sin( inclination );
+    const double cosio2 = cosio * cosio;
+    const double omeosq = 1.0 - eccentricity * eccentricity;
+    const double rteosq = std::sqrt( omeosq );
+    const double ao = std::pow( SGP4_KE / meanMotion, 2.0 / 3.0 );
+    const double po = ao * omeosq;
+    const double con42 = 1.0 - 5.0 * cosio2;
+    const double con41 = -con42 - cosio2 - cosio2;
+    const double pinvsq = 1.0 / ( po * po );
+    const double perigeeRadius = ao * ( 1.0 - eccentricity );
+
+    // Simplified drag model for perigee below 220 km
+    const bool isSimplified = ( perigeeRadius < ( 220.0 / SGP4_EARTH_RADIUS + 1.0 ) );
+
+    // Modify atmospheric density parameters for perigee below 156 km
+    double sfour = SGP4_S0 / SGP4_EARTH_RADIUS + 1.0;
+    double qzms24 = std::pow( ( SGP4_Q0 - SGP4_S0 ) / SGP4_EARTH_RADIUS, 4 );
+    const double perigeeAltitude = ( perigeeRadius - 1.0 ) * SGP4_EARTH_RADIUS;
+    if( perigeeAltitude < 156.0 )
+    {
+        sfour = ( perigeeAltitude < 98.0 ) ? 20.0 : perigeeAltitude - SGP4_S0;
+        qzms24 = std::pow( ( SGP4_Q0 - sfour ) / SGP4_EARTH_RADIUS, 4 );
+        sfour = sfour / SGP4_EARTH_RADIUS + 1.0;
+    }
+
+    const double tsi = 1.0 / ( ao - sfour );
+    const double eta = ao * eccentricity * tsi;
+    const double etasq = eta * eta;
+    const double eeta = eccentricity * eta;
+    const double psisq = std::fabs( 1.0 - etasq );
+    const double coef = qzms24 * std::pow( tsi, 4 );
+    const double coef1 = coef / std::pow( psisq, 3.5 );
+    const double cc2 = coef1 * meanMotion * (
+                ao * ( 1.0 + 1.5 * etasq + eeta * ( 4.0 + etasq ) ) +
+                0.375 * SGP4_J2 * tsi / psisq * con41 * ( 8.0 + 3.0 * etasq * ( 8.0 + etasq ) ) );
+    const double cc1 = bStar * cc2;
+    const double cc3 = ( eccentricity > 1.0E-4 ) ?
+                -2.0 * coef * tsi * j3OverJ2 * meanMotion * sinio / eccentricity : 0.0;
+    const double x1mth2 = 1.0 - cosio2;
+    const double cc4 = 2.0 * meanMotion * coef1 * ao * omeosq * (
+                eta * ( 2.0 + 0.5 * etasq ) + eccentricity * ( 0.5 + 2.0 * etasq ) -
+                SGP4_J2 * tsi / ( ao * psisq ) * (
+                    -3.0 * con41 * ( 1.0 - 2.0 * eeta + etasq * ( 1.5 - 0.5 * eeta ) ) +
+                    0.75 * x1mth2 * ( 2.0 * etasq - eeta * ( 1.0 + etasq ) ) * std::cos( 2.0 * argumentOfPerigee ) ) );
+    const double cc5 = 2.0 * coef1 * ao * omeosq * ( 1.0 + 2.75 * ( etasq + eeta ) + eeta * etasq );
+
+    // Secular rates due to J2 and J4
+    const double cosio4 = cosio2 * cosio2;
+    const double temp1 = 1.5 * SGP4_J2 * pinvsq * meanMotion;
+    const double temp2 = 0.5 * temp1 * SGP4_J2 * pinvsq;
+    const double temp3 = -0.46875 * SGP4_J4 * pinvsq * pinvsq * meanMotion;
+    const double xhdot1 = -temp1 * cosio;
+
+    coefficients( sgp4_mdot ) = meanMotion + 0.5 * temp1 * rteosq * con41 +
+            0.0625 * temp2 * rteosq * ( 13.0 - 78.0 * cosio2 + 137.0 * cosio4 );
+    coefficients( sgp4_argpdot ) = -0.5 * temp1 * con42 + 0.0625 * temp2 * ( 7.0 - 114.0 * cosio2 + 395.0 * cosio4 ) +
+            temp3 * ( 3.0 - 36.0 * cosio2 + 49.0 * cosio4 );
+    coefficients( sgp4_nodedot ) = xhdot1 + ( 0.5 * temp2 * ( 4.0 - 19.0 * cosio2 ) +
+                                              2.0 * temp3 * ( 3.0 - 7.0 * cosio2 ) ) * cosio;
+    coefficients( sgp4_nodecf ) = 3.5 * omeosq * xhdot1 * cc1;
+    coefficients( sgp4_omgcof ) = bStar * cc3 * std::cos( argumentOfPerigee );
+    coefficients( sgp4_xmcof ) = ( eccentricity > 1.0E-4 ) ? -2.0 / 3.0 * coef * bStar / eeta : 0.0;
+    coefficients( sgp4_t2cof ) = 1.5 * cc1;
+
+    // Long-period periodic coefficients (avoiding division by zero for an inclination of 180 degrees)
+    const double onePlusCosio = ( std::fabs( cosio + 1.0 ) > 1.5E-12 ) ? ( 1.0 + cosio ) : 1.5E-12;
+    coefficients( sgp4_xlcof ) = -0.25 * j3OverJ2 * sinio * ( 3.0 + 5.0 * cosio ) / onePlusCosio;
+    coefficients( sgp4_aycof ) = -0.5 * j3OverJ2 * sinio;
+
+    // Higher-order drag terms, only for the full (non-simplified) model
+    double d2 = 0.0, d3 = 0.0, d4 = 0.0, t3cof = 0.0, t4cof = 0.0, t5cof = 0.0;
+    if( !isSimplified )
+    {
+        const double cc1sq = cc1 * cc1;
+        d2 = 4.0 * ao * tsi * cc1sq;
+        const double temp = d2 * tsi * cc1 / 3.0;
+        d3 = ( 17.0 * ao + sfour ) * temp;
+        d4 = 0.5 * temp * ao * tsi * ( 221.0 * ao + 31.0 * sfour ) * cc1;
+        t3cof = d2 + 2.0 * cc1sq;
+        t4cof = 0.25 * ( 3.0 * d3 + cc1 * ( 12.0 * d2 + 10.0 * cc1sq ) );
+        t5cof = 0.2 * ( 3.0 * d4 + 12.0 * cc1 * d3 + 6.0 * d2 * d2 + 15.0 * cc1sq * ( 2.0 * d2 + cc1sq ) );
+    }
+
+    coefficients( sgp4_epoch ) = tle.getEpoch( );
+    coefficients( sgp4_b_star ) = bStar;
+    coefficients( sgp4_inclination ) = inclination;
+    coefficients( sgp4_right_ascension ) = tle.getRightAscension( );
+    coefficients( sgp4_argument_of_perigee ) = argumentOfPerigee;
+    coefficients( sgp4_mean_anomaly ) = meanAnomaly;
+    coefficients( sgp4_eccentricity ) = eccentricity;
+    coefficients( sgp4_mean_motion ) = meanMotion;
+    coefficients( sgp4_semi_major_axis ) = ao;
+    coefficients( sgp4_is_simplified ) = isSimplified ? 1.0 : 0.0;
+    coefficients( sgp4_cosine_inclination ) = cosio;
+    coefficients( sgp4_sine_inclination ) = sinio;
+    coefficients( sgp4_con41 ) = con41;
+    coefficients( sgp4_x1mth2 ) = x1mth2;
+    coefficients( sgp4_x7thm1 ) = 7.0 * cosio2 - 1.0;
+    coefficients( sgp4_eta ) = eta;
+    coefficients( sgp4_delmo ) = std::pow( 1.0 + eta * std::cos( meanAnomaly ), 3 );
+    coefficients( sgp4_sinmao ) = std::sin( meanAnomaly );
+    coefficients( sgp4_cc1 ) = cc1;
+    coefficients( sgp4_cc4 ) = cc4;
+    coefficients( sgp4_cc5 ) = cc5;
+    coefficients( sgp4_d2 ) = d2;
+    coefficients( sgp4_d3 ) = d3;
+    coefficients( sgp4_d4 ) = d4;
+    coefficients( sgp4_t3cof ) = t3cof;
+    coefficients( sgp4_t4cof ) = t4cof;
+    coefficients( sgp4_t5cof ) = t5cof;
+}
+
+//! Compute value modulo 2 pi for each lane, with the sign of the input (as std::fmod).
+Sgp4LaneArray computeLaneModuloTwoPi( const Sgp4LaneArray& values )
+{
+    return values.unaryExpr( [ ]( const double value )
+    {
+        return std::fmod( value, 2.0 * mathematical_constants::PI );
+    } );
+}
+
+//! Compute the TEME positions and velocities (in km and km/s) of a lane of near-Earth objects using SGP4.
+/*!
+ * Compute the TEME positions and velocities (in km and km/s) of a lane of near-Earth objects using SGP4, following the
+ * near-Earth branch of sgp4 of Vallado et al. (2006). The Kepler equation is solved by masked Newton iterations, which
+ * terminate when all lanes have converged.
+ * \param sgp4Coefficients SGP4 coefficients of all near-Earth objects.
+ * \param laneStart Index of the first object in the lane.
+ * \param secondsSinceEpoch Seconds since J2000 epoch at which the states are to be computed.
+ * \param positions Positions for each lane (rows x, y, z). [Output]
+ * \param velocities Velocities for each lane (rows x, y, z). [Output]
+ * \return Flags indicating for which lanes the model was evaluated successfully.
+ */
+Sgp4LaneMask propagateLaneSgp4( const Eigen::ArrayXXd& sgp4Coefficients,
+                                const int laneStart,
+                                const double secondsSinceEpoch,
+                                Eigen::Array< double, 3, SGP4_BATCH_LANE_WIDTH >& positions,
+                                Eigen::Array< double, 3, SGP4_BATCH_LANE_WIDTH >& velocities )
+{
+    auto coefficient = [ & ]( const int coefficientIndex ) -> Sgp4LaneArray
+    {
+        return sgp4Coefficients.col( coefficientIndex ).segment< SGP4_BATCH_LANE_WIDTH >( laneStart );
+    };
+
+    const Sgp4LaneArray meanMotion = coefficient( sgp4_mean_motion );
+    const Sgp4LaneArray bStar = coefficient( sgp4_b_star );
+    const Sgp4LaneArray eta = coefficient( sgp4_eta );
+    const Sgp4LaneArray cc1 = coefficient( sgp4_cc1 );
+    const Sgp4LaneMask isSimplified = coefficient( sgp4_is_simplified ) > 0.5;
+
+    // Time since TLE epoch in minutes
+    const Sgp4LaneArray t = ( secondsSinceEpoch - coefficient( sgp4_epoch ) ) / 60.0;
+    const Sgp4LaneArray t2 = t * t;
+
+    // Update for secular gravity and atmospheric drag
+    const Sgp4LaneArray xmdf = coefficient( sgp4_mean_anomaly ) + coefficient( sgp4_mdot ) * t;
+    const Sgp4LaneArray argpdf = coefficient( sgp4_argument_of_perigee ) + coefficient( sgp4_argpdot ) * t;
+    Sgp4LaneArray nodem = coefficient( sgp4_right_ascension ) + coefficient( sgp4_nodedot ) * t +
+            coefficient( sgp4_nodecf ) * t2;
+
+    // Higher-order drag terms (set to zero for objects using the simplified model)
+    const Sgp4LaneArray t3 = t2 * t;
+    const Sgp4LaneArray t4 = t3 * t;
+    const Sgp4LaneArray delomg = coefficient( sgp4_omgcof ) * t;
+    const Sgp4LaneArray delm = coefficient( sgp4_xmcof ) * ( ( 1.0 + eta * xmdf.cos( ) ).cube( ) -
+                                                             coefficient( sgp4_delmo ) );
+    const Sgp4LaneArray higherOrderCorrection = isSimplified.select( Sgp4LaneArray::Zero( ), delomg + delm );
+    Sgp4LaneArray mm = xmdf + higherOrderCorrection;
+    Sgp4LaneArray argpm = argpdf - higherOrderCorrection;
+
+    const Sgp4LaneArray tempa = 1.0 - cc1 * t - coefficient( sgp4_d2 ) * t2 - coefficient( sgp4_d3 ) * t3 -
+            coefficient( sgp4_d4 ) * t4;
+    const Sgp4LaneArray tempe = bStar * coefficient( sgp4_cc4 ) * t + isSimplified.select(
+                Sgp4LaneArray::Zero( ), bStar * coefficient( sgp4_cc5 ) * ( mm.sin( ) - coefficient( sgp4_sinmao ) ) );
+    const Sgp4LaneArray templ = coefficient( sgp4_t2cof ) * t2 + coefficient( sgp4_t3cof ) * t3 +
+            t4 * ( coefficient( sgp4_t4cof ) + t * coefficient( sgp4_t5cof ) );
+
+    Sgp4LaneMask isValid = meanMotion > 0.0;
+    const Sgp4LaneArray am = coefficient( sgp4_semi_major_axis ) * tempa.square( );
+    const Sgp4LaneArray nm = SGP4_KE / ( am * am.sqrt( ) );
+    Sgp4LaneArray em = coefficient( sgp4_eccentricity ) - tempe;
+    isValid = isValid && ( em < 1.0 ) && ( em >= -0.001 );
+    em = em.max( 1.0E-6 );
+
+    mm += meanMotion * templ;
+    const Sgp4LaneArray xlm = computeLaneModuloTwoPi( mm + argpm + nodem );
+    nodem = computeLaneModuloTwoPi( nodem );
+    argpm = computeLaneModuloTwoPi( argpm );
+    mm = computeLaneModuloTwoPi( xlm - argpm - nodem );
+
+    // Long-period periodics
+    const Sgp4LaneArray axnl = em * argpm.cos( );
+    Sgp4LaneArray temp = 1.0 / ( am * ( 1.0 - em.square( ) ) );
+    const Sgp4LaneArray aynl = em * argpm.sin( ) + temp * coefficient( sgp4_aycof );
+    const Sgp4LaneArray xl = mm + argpm + nodem + temp * coefficient( sgp4_xlcof ) * axnl;
+
+    // Solve Kepler's equation, stopping the iterations of each lane when it has converged
+    const Sgp4LaneArray u = computeLaneModuloTwoPi( xl - nodem );
+    Sgp4LaneArray eo1 = u;
+    Sgp4LaneArray sineo1 = Sgp4LaneArray::Zero( );
+    Sgp4LaneArray coseo1 = Sgp4LaneArray::Ones( );
+    Sgp4LaneArray tem5 = Sgp4LaneArray::Constant( 9999.9 );
+    for( unsigned int i = 0; i < 10; i++ )
+    {
+        const Sgp4LaneMask isIterating = tem5.abs( ) >= 1.0E-12;
+        if( !isIterating.any( ) )
+        {
+            break;
+        }
+
+        const Sgp4LaneArray currentSine = eo1.sin( );
+        const Sgp4LaneArray currentCosine = eo1.cos( );
+        const Sgp4LaneArray step = ( ( u - aynl * currentCosine + axnl * currentSine - eo1 ) /
+                                     ( 1.0 - currentCosine * axnl - currentSine * aynl ) ).max( -0.95 ).min( 0.95 );
+
+        sineo1 = isIterating.select( currentSine, sineo1 );
+        coseo1 = isIterating.select( currentCosine, coseo1 );
+        tem5 = isIterating.select( step, tem5 );
+        eo1 = isIterating.select( eo1 + step, eo1 );
+    }
+
+    // Short-period preliminary quantities
+    const Sgp4LaneArray ecose = axnl * coseo1 + aynl * sineo1;
+    const Sgp4LaneArray esine = axnl * sineo1 - aynl * coseo1;
+    const Sgp4LaneArray el2 = axnl.square( ) + aynl.square( );
+    const Sgp4LaneArray pl = am * ( 1.0 - el2 );
+    isValid = isValid && ( pl >= 0.0 );
+
+    const Sgp4LaneArray rl = am * ( 1.0 - ecose );
+    const Sgp4LaneArray rdotl = am.sqrt( ) * esine / rl;
+    const Sgp4LaneArray rvdotl = pl.sqrt( ) / rl;
+    const Sgp4LaneArray betal = ( 1.0 - el2 ).sqrt( );
+    temp = esine / ( 1.0 + betal );
+    const Sgp4LaneArray sinu = am / rl * ( sineo1 - aynl - axnl * temp );
+    const Sgp4LaneArray cosu = am / rl * ( coseo1 - axnl + aynl * temp );
+    Sgp4LaneArray su = sinu.binaryExpr( cosu, [ ]( const double sine, const double cosine )
+    {
+        return std::atan2( sine, cosine );
+    } );
+    const Sgp4LaneArray sin2u = ( cosu + cosu ) * sinu;
+    const Sgp4LaneArray cos2u = 1.0 - 2.0 * sinu.square( );
+    temp = 1.0 / pl;
+    const Sgp4LaneArray temp1 = 0.5 * SGP4_J2 * temp;
+    const Sgp4LaneArray temp2 = temp1 * temp;
+
+    // Update for short-period periodics
+    const Sgp4LaneArray con41 = coefficient( sgp4_con41 );
+    const Sgp4LaneArray x1mth2 = coefficient( sgp4_x1mth2 );
+    const Sgp4LaneArray cosio = coefficient( sgp4_cosine_inclination );
+    const Sgp4LaneArray mrt = rl * ( 1.0 - 1.5 * temp2 * betal * con41 ) + 0.5 * temp1 * x1mth2 * cos2u;
+    su -= 0.25 * temp2 * coefficient( sgp4_x7thm1 ) * sin2u;
+    const Sgp4LaneArray xnode = nodem + 1.5 * temp2 * cosio * sin2u;
+    const Sgp4LaneArray xinc = coefficient( sgp4_inclination ) +
+            1.5 * temp2 * cosio * coefficient( sgp4_sine_inclination ) * cos2u;
+    const Sgp4LaneArray mvt = rdotl - nm * temp1 * x1mth2 * sin2u / SGP4_KE;
+    const Sgp4LaneArray rvdot = rvdotl + nm * temp1 * ( x1mth2 * cos2u + 1.5 * con41 ) / SGP4_KE;
+
+    // Orientation vectors
+    const Sgp4LaneArray sinsu = su.sin( );
+    const Sgp4LaneArray cossu = su.cos( );
+    const Sgp4LaneArray snod = xnode.sin( );
+    const Sgp4LaneArray cnod = xnode.cos( );
+    const Sgp4LaneArray sini = xinc.sin( );
+    const Sgp4LaneArray cosi = xinc.cos( );
+    const Sgp4LaneArray xmx = -snod * cosi;
+    const Sgp4LaneArray xmy = cnod * cosi;
+
+    Eigen::Array< double, 3, SGP4_BATCH_LANE_WIDTH > unitVectorU, unitVectorV;
+    unitVectorU.row( 0 ) = ( xmx * sinsu + cnod * cossu ).transpose( );
+    unitVectorU.row( 1 ) = ( xmy * sinsu + snod * cossu ).transpose( );
+    unitVectorU.row( 2 ) = ( sini * sinsu ).transpose( );
+    unitVectorV.row( 0 ) = ( xmx * cossu - cnod * sinsu ).transpose( );
+    unitVectorV.row( 1 ) = ( xmy * cossu - snod * sinsu ).transpose( );
+    unitVectorV.row( 2 ) = ( sini * cossu ).transpose( );
+
+    // Position and velocity (in km and km/s)
+    const double velocityUnit = SGP4_EARTH_RADIUS * SGP4_KE / 60.0;
+    for( int i = 0; i < 3; i++ )
+    {
+        positions.row( i ) = SGP4_EARTH_RADIUS * ( mrt.transpose( ) * unitVectorU.row( i ) );
+        velocities.row( i ) = velocityUnit * ( mvt.transpose( ) * unitVectorU.row( i ) +
+                                               rvdot.transpose( ) * unitVectorV.row( i ) );
+    }
+
+    // Objects with a radius below one Earth radius have decayed
+    return isValid && ( mrt >= 1.0 );
+}
+
+//! Constructor.
+TleCatalogue::TleCatalogue( const std::vector< std::shared_ptr< Tle > >& tles,
+                            const std::vector< int >& objectIds,
+                            const std::string& referenceFrameOrientation ):
+    tles_( tles ), objectIds_( objectIds ), referenceFrameOrientation_( referenceFrameOrientation )
+{
+    if( referenceFrameOrientation_ != "TEME" && referenceFrameOrientation_ != "J2000" &&
+            referenceFrameOrientation_ != "ECLIPJ2000" )
+    {
+        throw std::runtime_error( "Error when creating TLE catalogue, frame orientation " + referenceFrameOrientation_ +
+                                  " is not supported." );
+    }
+
+    if( objectIds_.size( ) == 0 )
+    {
+        for( unsigned int i = 0; i < tles_.size( ); i++ )
+        {
+            objectIds_.push_back( static_cast< int >( i ) );
+        }
+    }
+    else if( objectIds_.size( ) != tles_.size( ) )
+    {
+        throw std::runtime_error( "Error when creating TLE catalogue, number of object ids (" +
+                                  std::to_string( objectIds_.size( ) ) + ") is inconsistent with number of TLEs (" +
+                                  std::to_string( tles_.size( ) ) + ")." );
+    }
+
+    initializeNearEarthObjects( );
+}
+
+//! Function to perform the SGP4 initialization of all near-Earth objects.
+void TleCatalogue::initializeNearEarthObjects( )
+{
+    // Classify objects, based on the orbital period corresponding to the un-Kozai'd mean motion
+    for( unsigned int i = 0; i < tles_.size( ); i++ )
+    {
+        if( tles_.at( i ) == nullptr )
+        {
+            throw std::runtime_error( "Error when creating TLE catalogue, TLE of object " +
+                                      std::to_string( objectIds_.at( i ) ) + " is not defined." );
+        }
+
+        const double meanMotion = computeUnKozaiMeanMotion(
+                    tles_.at( i )->getMeanMotion( ), tles_.at( i )->getEccentricity( ),
+                    tles_.at( i )->getInclination( ) );
+        if( 2.0 * mathematical_constants::PI / meanMotion >= SGP4_DEEP_SPACE_PERIOD_LIMIT )
+        {
+            deepSpaceObjectIndices_.push_back( i );
+        }
+        else
+        {
+            nearEarthObjectIndices_.push_back( i );
+        }
+    }
+
+    // Compute SGP4 coefficients of near-Earth objects, padding the last lane with copies of the last object
+    const int numberOfNearEarthObjects = static_cast< int >( nearEarthObjectIndices_.size( ) );
+    const int numberOfLanes = ( numberOfNearEarthObjects + SGP4_BATCH_LANE_WIDTH - 1 ) / SGP4_BATCH_LANE_WIDTH;
+    sgp4Coefficients_.resize( numberOfLanes * SGP4_BATCH_LANE_WIDTH, number_of_sgp4_coefficients );
+    Eigen::ArrayXd objectCoefficients = Eigen::ArrayXd::Zero( number_of_sgp4_coefficients );
+    for( int i = 0; i < sgp4Coefficients_.rows( ); i++ )
+    {
+        if( i < numberOfNearEarthObjects )
+        {
+            computeSgp4Coefficients( *tles_.at( nearEarthObjectIndices_.at( i ) ), objectCoefficients );
+        }
+        sgp4Coefficients_.row( i ) = objectCoefficients.transpose( );
+    }
+}
+
+//! Function to compute the Cartesian states of all objects in the catalogue at a given epoch.
+unsigned int TleCatalogue::getCartesianStates( const double secondsSinceEpoch,
+                                               Eigen::Matrix< double, Eigen::Dynamic, 6 >& cartesianStates,
+                                               const unsigned int numberOfThreads )
+{
+    cartesianStates.resize( tles_.size( ), 6 );
+    for( unsigned int i = 0; i < deepSpaceObjectIndices_.size( ); i++ )
+    {
+        cartesianStates.row( deepSpaceObjectIndices_.at( i ) ).setConstant(
+                    std::numeric_limits< double >::quiet_NaN( ) );
+    }
+
+    // Compute rotation from TEME to the requested frame once for all objects (including conversion from km to m)
+    Eigen::Matrix3d rotationMatrix = Eigen::Matrix3d::Identity( );
+    if( referenceFrameOrientation_ != "TEME" )
+    {
+        rotationMatrix = getRotationMatrixFromTemeToJ2000( secondsSinceEpoch );
+        if( referenceFrameOrientation_ == "ECLIPJ2000" )
+        {
+            rotationMatrix = spice_interface::computeRotationQuaternionBetweenFrames(
+                        "J2000", "ECLIPJ2000", secondsSinceEpoch ).toRotationMatrix( ) * rotationMatrix;
+        }
+    }
+    const Eigen::Array< double, 3, 3 > scaledRotationMatrix = 1.0E3 * rotationMatrix.array( );
+
+    // Propagate near-Earth objects in blocks of SGP4_BATCH_TASK_SIZE objects per task
+    std::atomic< unsigned int > numberOfFailedObjects( deepSpaceObjectIndices_.size( ) );
+    const int numberOfNearEarthObjects = static_cast< int >( nearEarthObjectIndices_.size( ) );
+    const int numberOfTasks = ( numberOfNearEarthObjects + SGP4_BATCH_TASK_SIZE - 1 ) / SGP4_BATCH_TASK_SIZE;
+    utilities::executeTasksInParallel(
+                numberOfTasks, numberOfThreads, [ & ]( const unsigned int taskIndex, const unsigned int )
+    {
+        Eigen::Array< double, 3, SGP4_BATCH_LANE_WIDTH > positions, velocities;
+        unsigned int numberOfFailedObjectsInTask = 0;
+
+        const int taskEnd = std::min( static_cast< int >( taskIndex + 1 ) * SGP4_BATCH_TASK_SIZE,
+                                      numberOfNearEarthObjects );
+        for( int laneStart = taskIndex * SGP4_BATCH_TASK_SIZE; laneStart < taskEnd;
+             laneStart += SGP4_BATCH_LANE_WIDTH )
+        {
+            const Sgp4LaneMask isStateComputed = propagateLaneSgp4(
+                        sgp4Coefficients_, laneStart, secondsSinceEpoch, positions, velocities );
+
+            // Rotate to requested frame, and store states in order of input
+            const int numberOfActiveLanes = std::min( SGP4_BATCH_LANE_WIDTH, taskEnd - laneStart );
+            for( int i = 0; i < 3; i++ )
+            {
+                const Eigen::Array< double, 1, SGP4_BATCH_LANE_WIDTH > rotatedPosition =
+                        scaledRotationMatrix( i, 0 ) * positions.row( 0 ) +
+                        scaledRotationMatrix( i, 1 ) * positions.row( 1 ) +
+                        scaledRotationMatrix( i, 2 ) * positions.row( 2 );
+                const Eigen::Array< double, 1, SGP4_BATCH_LANE_WIDTH > rotatedVelocity =
+                        scaledRotationMatrix( i, 0 ) * velocities.row( 0 ) +
+                        scaledRotationMatrix( i, 1 ) * velocities.row( 1 ) +
+                        scaledRotationMatrix( i, 2 ) * velocities.row( 2 );
+                for( int j = 0; j < numberOfActiveLanes; j++ )
+                {
+                    const int objectIndex = nearEarthObjectIndices_[ laneStart + j ];
+                    cartesianStates( objectIndex, i ) = rotatedPosition( j );
+                    cartesianStates( objectIndex, i + 3 ) = rotatedVelocity( j );
+                }
+            }
+
+            for( int j = 0; j < numberOfActiveLanes; j++ )
+            {
+                if( !isStateComputed( j ) )
+                {
+                    cartesianStates.row( nearEarthObjectIndices_[ laneStart + j ] ).setConstant(
+                                std::numeric_limits< double >::quiet_NaN( ) );
+                    numberOfFailedObjectsInTask++;
+                }
+            }
+        }
+        numberOfFailedObjects += numberOfFailedObjectsInTask;
+    } );
+
+    return numberOfFailedObjects;
+}
+
+//! Function to parse the NORAD catalogue number from the first line of a TLE (including the Alpha-5 format).
+int getNoradCatalogueNumber( const std::string& tleLine1 )
+{
+    const std::string catalogueNumberString = tleLine1.substr( 2, 5 );
+    const char firstCharacter = static_cast< char >( std::toupper( catalogueNumberString.at( 0 ) ) );
+    if( std::isalpha( firstCharacter ) )
+    {
+        // Alpha-5 format: first digit replaced by a letter (A = 10, ..., Z = 33), skipping I and O
+        if( firstCharacter == 'I' || firstCharacter == 'O' )
+        {
+            throw std::runtime_error( "Error, invalid Alpha-5 catalogue number " + catalogueNumberString );
+        }
+        int leadingNumber = 10 + ( firstCharacter - 'A' );
+        if( firstCharacter > 'I' )
+        {
+            leadingNumber--;
+        }
+        if( firstCharacter > 'O' )
+        {
+            leadingNumber--;
+        }
+        return leadingNumber * 10000 + std::stoi( catalogueNumberString.substr( 1 ) );
+    }
+    return std::stoi( catalogueNumberString );
+}
+
+//! Function to read a catalogue of two-line element sets from a text file.
+std::shared_ptr< TleCatalogue > readTleCatalogue( const std::string& fileName,
+                                                  const std::string& referenceFrameOrientation )
+{
+    std::ifstream tleFile( fileName );
+    if( !tleFile.good( ) )
+    {
+        throw std::runtime_error( "Error when reading TLE catalogue, file " + fileName + " could not be opened." );
+    }
+
+    std::vector< std::shared_ptr< Tle > > tles;
+    std::vector< int > objectIds;
+    std::string line, firstLine;
+    while( std::getline( tleFile, line ) )
+    {
+        // Remove trailing whitespace and carriage returns
+        line.erase( std::find_if( line.rbegin( ), line.rend( ), [ ]( const unsigned char character )
+        {
+            return !std::isspace( character );
+        } ).base( ), line.end( ) );
+
+        // Name lines (three-line format) and empty lines are skipped
+        if( line.compare( 0, 2, "1 " ) == 0 )
+        {
+            firstLine = line;
+        }
+        else if( line.compare( 0, 2, "2 " ) == 0 )
+        {
+            if( firstLine.empty( ) )
+            {
+                throw std::runtime_error( "Error when reading TLE catalogue from " + fileName +
+                                          ", second line found without first line: " + line );
+            }
+            tles.push_back( std::make_shared< Tle >( firstLine + "\n" + line ) );
+            objectIds.push_back( getNoradCatalogueNumber( firstLine ) );
+            firstLine.clear( );
+        }
+    }
+
+    return std::make_shared< TleCatalogue >( tles, objectIds, referenceFrameOrientation );
+}
+
+} // namespace ephemerides
+} // namespace tudat
@@ -49,31 +49,10 @@ namespace ephemerides
         const Eigen::Vector6d cartesianStateAtEpochTEME =
                 spice_interface::getCartesianStateFromTleAtEpoch( secondsSinceEpoch, tle_ );
 
-		Eigen::Vector3d positionTEME = cartesianStateAtEpochTEME.head( 3 );
-		Eigen::Vector3d velocityTEME = cartesianStateAtEpochTEME.tail( 3 );
-
-		// First, rotate to the True Of Date (TOD) frame.
-		double equationOfEquinoxes = sofa_interface::calculateEquationOfEquinoxes( secondsSinceEpoch );
-
-		// Rotate around pole (z-axis)
-		Eigen::AngleAxisd rotationObject = Eigen::AngleAxisd( equationOfEquinoxes, Eigen::Vector3d::UnitZ( ) );
-		Eigen::Vector3d positionTOD = rotationObject.toRotationMatrix( ) * positionTEME;
-		Eigen::Vector3d velocityTOD = rotationObject.toRotationMatrix( ) * velocityTEME;
-
-		// These angles (zeta, z, and theta) do not really have descriptive names. For a description of the precession geometry and these angles,
-		// see pages 226-228 and figure 3-31 in Vallado (2013).
-		double precessionAngleModToGcrfZeta;
-		double precessionAngleModToGcrfZ;
-		double precessionAngleModToGcrfTheta;
-		sofa_interface::getPrecessionAngles(precessionAngleModToGcrfZeta, precessionAngleModToGcrfZ, precessionAngleModToGcrfTheta,
-				secondsSinceEpoch );
-
-		// Now that we have our state vector in the TOD frame, we need to obtain the combined precession + nutation matrix from Sofa
-		// (according to the 1976/1980 model)
-		Eigen::Matrix3d precessionNutationMatrix = sofa_interface::getPrecessionNutationMatrix( secondsSinceEpoch );
-		// Multiply by inverted matrix to get to J2000
-		Eigen::Vector3d  positionJ2000 = precessionNutationMatrix.transpose( ) * positionTOD;
-		Eigen::Vector3d  velocityJ2000 = precessionNutationMatrix.transpose( ) * velocityTOD;
+		// Rotate to J2000 through the True Of Date (TOD) frame
+		const Eigen::Matrix3d temeToJ2000RotationMatrix = getRotationMatrixFromTemeToJ2000( secondsSinceEpoch );
+		Eigen::Vector3d  positionJ2000 = temeToJ2000RotationMatrix * cartesianStateAtEpochTEME.head( 3 );
+		Eigen::Vector3d  velocityJ2000 = temeToJ2000RotationMatrix * cartesianStateAtEpochTEME.tail( 3 );
 
 		if( referenceFrameOrientation_ == "J2000" )
 		{
@@ -99,6 +78,19 @@ namespace ephemerides
 		return cartesianStateAtEpochTEME;
 	}
 
+	Eigen::Matrix3d getRotationMatrixFromTemeToJ2000( const double secondsSinceEpoch )
+	{
+		// First, rotate to the True Of Date (TOD) frame, around pole (z-axis)
+		double equationOfEquinoxes = sofa_interface::calculateEquationOfEquinoxes( secondsSinceEpoch );
+		Eigen::Matrix3d temeToTodRotationMatrix =
+				Eigen::AngleAxisd( equationOfEquinoxes, Eigen::Vector3d::UnitZ( ) ).toRotationMatrix( );
+
+		// Then, multiply by inverted combined precession + nutation matrix from Sofa (according to the 1976/1980 model)
+		// to get to J2000. For a description of the precession geometry, see pages 226-228 and figure 3-31 in Vallado (2013).
+		Eigen::Matrix3d precessionNutationMatrix = sofa_interface::getPrecessionNutationMatrix( secondsSinceEpoch );
+		return precessionNutationMatrix.transpose( ) * temeToTodRotationMatrix;
+	}
+
 	Tle::Tle( const std::string& lines )
 	{
 		// First of all, the TLE lines to be checked for validity: they shall not be empty, contain more than 69 characters
@@ -179,7 +171,7 @@ namespace ephemerides
 		bStar_ = bStar * std::pow( 10, bStarExp - 5 );
 
 		// Convert angles to radians
-		inclination_ = unit_conversions::convertDegreesToRadians( std::stod( line2.substr( 8, 7 ) ) );
+		inclination_ = unit_conversions::convertDegreesToRadians( std::stod( line2.substr( 8, 8 ) ) );
 		rightAscension_ = unit_conversions::convertDegreesToRadians( std::stod( line2.substr( 17, 8 ) ) );
 
 		std::string eccentricityString = "0." + line2.substr( 26, 7 );
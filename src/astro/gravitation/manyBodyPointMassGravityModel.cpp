@@ -0,0 +1,144 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include "tudat/astro/gravitation/centralGravityModel.h"
+#include "tudat/astro/gravitation/manyBodyPointMassGravityModel.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Constructor
+ManyBodyPointMassGravityKernel::ManyBodyPointMassGravityKernel(
+        const std::function< void( Eigen::MatrixX3d& ) > undergoingBodyPositionsFunction,
+        const int numberOfUndergoingBodies,
+        const std::vector< std::function< void( Eigen::Vector3d& ) > >& exertingBodyPositionFunctions,
+        const std::vector< std::function< double( ) > >& exertingBodyGravitationalParameterFunctions,
+        const std::vector< bool >& isThirdBodyAcceleration,
+        const std::function< void( Eigen::Vector3d& ) > centralBodyPositionFunction,
+        const int centralBodyIndex,
+        const std::vector< std::function< double( ) > >& undergoingBodyGravitationalParameterFunctions ):
+    undergoingBodyPositionsFunction_( undergoingBodyPositionsFunction ),
+    numberOfUndergoingBodies_( numberOfUndergoingBodies ),
+    exertingBodyPositionFunctions_( exertingBodyPositionFunctions ),
+    exertingBodyGravitationalParameterFunctions_( exertingBodyGravitationalParameterFunctions ),
+    isThirdBodyAcceleration_( isThirdBodyAcceleration ),
+    centralBodyPositionFunction_( centralBodyPositionFunction ),
+    centralBodyIndex_( centralBodyIndex ),
+    undergoingBodyGravitationalParameterFunctions_( undergoingBodyGravitationalParameterFunctions ),
+    useMutualAttraction_( false ),
+    currentTime_( TUDAT_NAN )
+{
+    // Check input consistency
+    if( exertingBodyPositionFunctions_.size( ) != exertingBodyGravitationalParameterFunctions_.size( ) ||
+            exertingBodyPositionFunctions_.size( ) != isThirdBodyAcceleration_.size( ) )
+    {
+        throw std::runtime_error( "Error when creating many-body point mass gravity model, "
+                                  "input for bodies exerting acceleration is inconsistent" );
+    }
+
+    if( centralBodyIndex_ >= static_cast< int >( exertingBodyPositionFunctions_.size( ) ) )
+    {
+        throw std::runtime_error( "Error when creating many-body point mass gravity model, central body index is "
+                                  "inconsistent" );
+    }
+
+    if( undergoingBodyGravitationalParameterFunctions_.size( ) > 0 )
+    {
+        if( static_cast< int >( undergoingBodyGravitationalParameterFunctions_.size( ) ) != numberOfUndergoingBodies_ )
+        {
+            throw std::runtime_error( "Error when creating many-body point mass gravity model, "
+                                      "input for bodies undergoing acceleration is inconsistent" );
+        }
+
+        for( unsigned int i = 0; i < undergoingBodyGravitationalParameterFunctions_.size( ); i++ )
+        {
+            if( undergoingBodyGravitationalParameterFunctions_.at( i ) != nullptr )
+            {
+                useMutualAttraction_ = true;
+            }
+        }
+    }
+
+    // Pre-allocate all blocks
+    undergoingBodyPositions_.setZero( numberOfUndergoingBodies_, 3 );
+    relativePositions_.setZero( numberOfUndergoingBodies_, 3 );
+    cubedDistances_.setZero( numberOfUndergoingBodies_ );
+    mutualGravitationalParameters_.setZero( numberOfUndergoingBodies_ );
+    currentAccelerations_.resize( exertingBodyPositionFunctions_.size( ),
+                                  Eigen::MatrixX3d::Constant( numberOfUndergoingBodies_, 3, TUDAT_NAN ) );
+}
+
+//! Function to update the accelerations on all bodies due to all bodies
+void ManyBodyPointMassGravityKernel::updateMembers( const double currentTime )
+{
+    if( !( currentTime_ == currentTime ) )
+    {
+        // Retrieve positions of all bodies undergoing acceleration, and of central body
+        undergoingBodyPositionsFunction_( undergoingBodyPositions_ );
+
+        Eigen::Vector3d centralBodyPosition = Eigen::Vector3d::Zero( );
+        centralBodyPositionFunction_( centralBodyPosition );
+
+        Eigen::Vector3d exertingBodyPosition;
+        for( unsigned int j = 0; j < exertingBodyPositionFunctions_.size( ); j++ )
+        {
+            // Retrieve properties of body exerting acceleration
+            exertingBodyPositionFunctions_[ j ]( exertingBodyPosition );
+            double gravitationalParameter = exertingBodyGravitationalParameterFunctions_[ j ]( );
+
+            // Compute distances of all bodies to body exerting acceleration
+            relativePositions_ = undergoingBodyPositions_.rowwise( ) - exertingBodyPosition.transpose( );
+            cubedDistances_ = ( relativePositions_.col( 0 ).array( ).square( ) +
+                                relativePositions_.col( 1 ).array( ).square( ) +
+                                relativePositions_.col( 2 ).array( ).square( ) ).sqrt( );
+            cubedDistances_ = cubedDistances_ * cubedDistances_ * cubedDistances_;
+
+            // Compute direct accelerations, adding gravitational parameter of body undergoing acceleration for the
+            // central body, if required
+            Eigen::MatrixX3d& currentAccelerations = currentAccelerations_[ j ];
+            if( useMutualAttraction_ && static_cast< int >( j ) == centralBodyIndex_ )
+            {
+                for( int i = 0; i < numberOfUndergoingBodies_; i++ )
+                {
+                    mutualGravitationalParameters_( i ) = gravitationalParameter +
+                            ( ( undergoingBodyGravitationalParameterFunctions_[ i ] != nullptr ) ?
+                                  undergoingBodyGravitationalParameterFunctions_[ i ]( ) : 0.0 );
+                }
+                for( int k = 0; k < 3; k++ )
+                {
+                    currentAccelerations.col( k ).array( ) =
+                            ( -mutualGravitationalParameters_ * relativePositions_.col( k ).array( ) ) / cubedDistances_;
+                }
+            }
+            else
+            {
+                for( int k = 0; k < 3; k++ )
+                {
+                    currentAccelerations.col( k ).array( ) =
+                            ( -gravitationalParameter * relativePositions_.col( k ).array( ) ) / cubedDistances_;
+                }
+            }
+
+            // Subtract acceleration of central body for third-body accelerations
+            if( isThirdBodyAcceleration_[ j ] )
+            {
+                currentAccelerations.rowwise( ) -= computeGravitationalAcceleration(
+                            centralBodyPosition, gravitationalParameter, exertingBodyPosition ).transpose( );
+            }
+        }
+
+        currentTime_ = currentTime;
+    }
+}
+
+} // namespace gravitation
+} // namespace tudat
@@ -0,0 +1,462 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "tudat/astro/gravitation/sphericalHarmonicsAccelerationKernel.h"
+#include "tudat/math/basic/coordinateConversions.h"
+
+namespace tudat
+{
+
+namespace gravitation
+{
+
+//! Constructor
+SphericalHarmonicsAccelerationKernel::SphericalHarmonicsAccelerationKernel(
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients ):
+    numberOfDegrees_( -1 ), numberOfOrders_( -1 ), numberOfRecursionOrders_( -1 )
+{
+    resetCoefficients( cosineHarmonicCoefficients, sineHarmonicCoefficients );
+}
+
+//! Function to reset the coefficients of the gravity field
+void SphericalHarmonicsAccelerationKernel::resetCoefficients(
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients )
+{
+    if( ( cosineHarmonicCoefficients.rows( ) != sineHarmonicCoefficients.rows( ) ) ||
+            ( cosineHarmonicCoefficients.cols( ) != sineHarmonicCoefficients.cols( ) ) )
+    {
+        throw std::runtime_error( "Error when setting spherical harmonic acceleration kernel coefficients, cosine (" +
+                                  std::to_string( cosineHarmonicCoefficients.rows( ) ) + "x" +
+                                  std::to_string( cosineHarmonicCoefficients.cols( ) ) + ") and sine (" +
+                                  std::to_string( sineHarmonicCoefficients.rows( ) ) + "x" +
+                                  std::to_string( sineHarmonicCoefficients.cols( ) ) + ") sizes are inconsistent" );
+    }
+
+    if( cosineHarmonicCoefficients.rows( ) == 0 || cosineHarmonicCoefficients.cols( ) == 0 )
+    {
+        throw std::runtime_error( "Error when setting spherical harmonic acceleration kernel coefficients, no coefficients provided" );
+    }
+
+    // Orders above the maximum degree do not contribute
+    const int numberOfDegrees = static_cast< int >( cosineHarmonicCoefficients.rows( ) );
+    const int numberOfOrders = std::min(
+                static_cast< int >( cosineHarmonicCoefficients.cols( ) ), numberOfDegrees );
+
+    if( numberOfDegrees != numberOfDegrees_ || numberOfOrders != numberOfOrders_ )
+    {
+        numberOfDegrees_ = numberOfDegrees;
+        numberOfOrders_ = numberOfOrders;
+        resetRecursionMultipliers( );
+    }
+
+    // Pack coefficients per order, ordered by degree
+    for( int order = 0; order < numberOfOrders_; order++ )
+    {
+        const int segmentLength = numberOfDegrees_ - order;
+        packedCosineCoefficients_.segment( orderStartIndices_.at( order ), segmentLength ) =
+                cosineHarmonicCoefficients.col( order ).segment( order, segmentLength );
+        packedSineCoefficients_.segment( orderStartIndices_.at( order ), segmentLength ) =
+                sineHarmonicCoefficients.col( order ).segment( order, segmentLength );
+    }
+}
+
+//! Function to compute the recursion multipliers and allocate the scratch buffers for the current field size
+void SphericalHarmonicsAccelerationKernel::resetRecursionMultipliers( )
+{
+    // Set start indices of packed data for each order. The recursion multipliers are also required for order
+    // numberOfOrders_ (if below the maximum degree), since its Legendre functions enter the derivatives of the highest
+    // order; the coefficients for this order are zero.
+    numberOfRecursionOrders_ = std::min( numberOfOrders_ + 1, numberOfDegrees_ );
+    orderStartIndices_.resize( numberOfRecursionOrders_ + 1 );
+    orderStartIndices_[ 0 ] = 0;
+    for( int order = 0; order < numberOfRecursionOrders_; order++ )
+    {
+        orderStartIndices_[ order + 1 ] = orderStartIndices_[ order ] + ( numberOfDegrees_ - order );
+    }
+    const int numberOfPackedEntries = orderStartIndices_[ numberOfRecursionOrders_ ];
+
+    packedCosineCoefficients_.setZero( numberOfPackedEntries );
+    packedSineCoefficients_.setZero( numberOfPackedEntries );
+    packedFirstRecursionMultipliers_.setZero( numberOfPackedEntries );
+    packedSecondRecursionMultipliers_.setZero( numberOfPackedEntries );
+    packedDerivativeMultipliers_.setZero( numberOfPackedEntries );
+    packedDegreePlusOne_.setZero( numberOfPackedEntries );
+
+    for( int order = 0; order < numberOfRecursionOrders_; order++ )
+    {
+        const double m = static_cast< double >( order );
+        for( int degree = order; degree < numberOfDegrees_; degree++ )
+        {
+            const double n = static_cast< double >( degree );
+            const int packedIndex = orderStartIndices_[ order ] + ( degree - order );
+
+            // Column-wise recursion P_{n,m} = a_{n,m} * t * P_{n-1,m} - b_{n,m} * P_{n-2,m} (for n > m)
+            if( degree > order )
+            {
+                const double commonFactor = std::sqrt( ( 2.0 * n + 1.0 ) / ( ( n + m ) * ( n - m ) ) );
+                packedFirstRecursionMultipliers_[ packedIndex ] = commonFactor * std::sqrt( 2.0 * n - 1.0 );
+                if( degree > order + 1 )
+                {
+                    packedSecondRecursionMultipliers_[ packedIndex ] = commonFactor * std::sqrt(
+                                ( n + m - 1.0 ) * ( n - m - 1.0 ) / ( 2.0 * n - 3.0 ) );
+                }
+            }
+
+            // Normalization of P_{n,m+1} term in derivative w.r.t. sine of latitude
+            packedDerivativeMultipliers_[ packedIndex ] = std::sqrt( ( n + m + 1.0 ) * ( n - m ) );
+            if( order == 0 )
+            {
+                packedDerivativeMultipliers_[ packedIndex ] *= std::sqrt( 0.5 );
+            }
+
+            packedDegreePlusOne_[ packedIndex ] = n + 1.0;
+        }
+    }
+
+    // Sectoral recursion P_{m,m} = f_m * cos(latitude) * P_{m-1,m-1}, computed up to order numberOfOrders_ (which is
+    // needed for the derivative of the highest order)
+    sectoralRecursionMultipliers_.resize( numberOfOrders_ + 1 );
+    sectoralRecursionMultipliers_[ 0 ] = 1.0;
+    for( int order = 1; order <= numberOfOrders_; order++ )
+    {
+        const double m = static_cast< double >( order );
+        sectoralRecursionMultipliers_[ order ] = ( order == 1 ) ?
+                    std::sqrt( 3.0 ) : std::sqrt( ( 2.0 * m + 1.0 ) / ( 2.0 * m ) );
+    }
+
+    // Allocate scratch buffers
+    radiusRatioPowers_.setZero( numberOfDegrees_ );
+    currentOrderLegendreFunctions_.setZero( numberOfDegrees_ );
+    nextOrderLegendreFunctions_.setZero( numberOfDegrees_ );
+    weightedLegendreFunctions_.setZero( numberOfDegrees_ );
+    radialWeightedLegendreFunctions_.setZero( numberOfDegrees_ );
+    weightedLegendreDerivatives_.setZero( numberOfDegrees_ );
+
+    batchRadiusRatioPowers_.setZero( BATCH_BLOCK_SIZE, numberOfDegrees_ );
+    batchCurrentOrderLegendreFunctions_.setZero( BATCH_BLOCK_SIZE, numberOfDegrees_ );
+    batchNextOrderLegendreFunctions_.setZero( BATCH_BLOCK_SIZE, numberOfDegrees_ );
+    batchWeightedLegendreFunctions_.setZero( BATCH_BLOCK_SIZE, numberOfDegrees_ );
+    batchRadialWeightedLegendreFunctions_.setZero( BATCH_BLOCK_SIZE, numberOfDegrees_ );
+    batchWeightedLegendreDerivatives_.setZero( BATCH_BLOCK_SIZE, numberOfDegrees_ );
+}
+
+//! Function to compute the (geodesy-normalized) associated Legendre functions of a single order, for all degrees
+void SphericalHarmonicsAccelerationKernel::computeLegendreFunctionsOfOrder(
+        const int order,
+        const double sectoralValue,
+        const double sineOfLatitude,
+        Eigen::VectorXd& legendreFunctions )
+{
+    if( order >= numberOfDegrees_ )
+    {
+        return;
+    }
+
+    legendreFunctions[ order ] = sectoralValue;
+    if( order + 1 >= numberOfDegrees_ )
+    {
+        return;
+    }
+
+    const double* firstMultipliers = packedFirstRecursionMultipliers_.data( ) + orderStartIndices_[ order ] - order;
+    const double* secondMultipliers = packedSecondRecursionMultipliers_.data( ) + orderStartIndices_[ order ] - order;
+
+    legendreFunctions[ order + 1 ] = firstMultipliers[ order + 1 ] * sineOfLatitude * sectoralValue;
+    for( int degree = order + 2; degree < numberOfDegrees_; degree++ )
+    {
+        legendreFunctions[ degree ] =
+                firstMultipliers[ degree ] * sineOfLatitude * legendreFunctions[ degree - 1 ] -
+                secondMultipliers[ degree ] * legendreFunctions[ degree - 2 ];
+    }
+}
+
+//! Function to compute the (geodesy-normalized) associated Legendre functions of a single order for a block of positions
+void SphericalHarmonicsAccelerationKernel::computeLegendreFunctionsOfOrderBlock(
+        const int order,
+        const Eigen::Array< double, BATCH_BLOCK_SIZE, 1 >& sectoralValues,
+        Eigen::Array< double, BATCH_BLOCK_SIZE, Eigen::Dynamic >& legendreFunctions )
+{
+    if( order >= numberOfDegrees_ )
+    {
+        return;
+    }
+
+    legendreFunctions.col( order ) = sectoralValues;
+    if( order + 1 >= numberOfDegrees_ )
+    {
+        return;
+    }
+
+    const double* firstMultipliers = packedFirstRecursionMultipliers_.data( ) + orderStartIndices_[ order ] - order;
+    const double* secondMultipliers = packedSecondRecursionMultipliers_.data( ) + orderStartIndices_[ order ] - order;
+
+    legendreFunctions.col( order + 1 ) = firstMultipliers[ order + 1 ] * batchSinesOfLatitude_ * sectoralValues;
+    for( int degree = order + 2; degree < numberOfDegrees_; degree++ )
+    {
+        legendreFunctions.col( degree ) =
+                firstMultipliers[ degree ] * batchSinesOfLatitude_ * legendreFunctions.col( degree - 1 ) -
+                secondMultipliers[ degree ] * legendreFunctions.col( degree - 2 );
+    }
+}
+
+//! Function to compute the gradient of the potential in spherical coordinates (radius, latitude, longitude)
+Eigen::Vector3d SphericalHarmonicsAccelerationKernel::computeSphericalGradient(
+        const double radius,
+        const double sineOfLatitude,
+        const double cosineOfLatitude,
+        const double cosineOfLongitude,
+        const double sineOfLongitude,
+        const double preMultiplier,
+        const double radiusRatio )
+{
+    // Compute powers (degree + 1) of radius ratio
+    radiusRatioPowers_[ 0 ] = radiusRatio;
+    for( int degree = 1; degree < numberOfDegrees_; degree++ )
+    {
+        radiusRatioPowers_[ degree ] = radiusRatioPowers_[ degree - 1 ] * radiusRatio;
+    }
+
+    const double latitudeRatio = sineOfLatitude / cosineOfLatitude;
+
+    double radialSum = 0.0;
+    double latitudeSum = 0.0;
+    double longitudeSum = 0.0;
+
+    double sectoralValue = 1.0;
+    double cosineOfOrderLongitude = 1.0;
+    double sineOfOrderLongitude = 0.0;
+
+    computeLegendreFunctionsOfOrder( 0, sectoralValue, sineOfLatitude, currentOrderLegendreFunctions_ );
+    for( int order = 0; order < numberOfOrders_; order++ )
+    {
+        const int segmentLength = numberOfDegrees_ - order;
+        const int startIndex = orderStartIndices_[ order ];
+
+        // Compute Legendre functions of next order (required for derivatives)
+        sectoralValue *= sectoralRecursionMultipliers_[ order + 1 ] * cosineOfLatitude;
+        computeLegendreFunctionsOfOrder( order + 1, sectoralValue, sineOfLatitude, nextOrderLegendreFunctions_ );
+        nextOrderLegendreFunctions_[ order ] = 0.0;
+
+        // Compute Legendre functions (and cos(latitude) times their derivatives) multiplied by radius ratio powers
+        auto currentFunctions = currentOrderLegendreFunctions_.segment( order, segmentLength );
+        auto radiusPowers = radiusRatioPowers_.segment( order, segmentLength );
+        auto weightedFunctions = weightedLegendreFunctions_.head( segmentLength );
+        auto radialWeightedFunctions = radialWeightedLegendreFunctions_.head( segmentLength );
+        auto weightedDerivatives = weightedLegendreDerivatives_.head( segmentLength );
+
+        weightedFunctions.array( ) = currentFunctions.array( ) * radiusPowers.array( );
+        radialWeightedFunctions.array( ) =
+                weightedFunctions.array( ) * packedDegreePlusOne_.segment( startIndex, segmentLength ).array( );
+        weightedDerivatives.array( ) = (
+                    packedDerivativeMultipliers_.segment( startIndex, segmentLength ).array( ) *
+                    nextOrderLegendreFunctions_.segment( order, segmentLength ).array( ) -
+                    ( static_cast< double >( order ) * latitudeRatio ) * currentFunctions.array( ) ) *
+                radiusPowers.array( );
+
+        // Sum over degrees for current order
+        auto cosineCoefficients = packedCosineCoefficients_.segment( startIndex, segmentLength );
+        auto sineCoefficients = packedSineCoefficients_.segment( startIndex, segmentLength );
+
+        radialSum += radialWeightedFunctions.dot( cosineCoefficients ) * cosineOfOrderLongitude +
+                radialWeightedFunctions.dot( sineCoefficients ) * sineOfOrderLongitude;
+        latitudeSum += weightedDerivatives.dot( cosineCoefficients ) * cosineOfOrderLongitude +
+                weightedDerivatives.dot( sineCoefficients ) * sineOfOrderLongitude;
+        longitudeSum += static_cast< double >( order ) * (
+                    weightedFunctions.dot( sineCoefficients ) * cosineOfOrderLongitude -
+                    weightedFunctions.dot( cosineCoefficients ) * sineOfOrderLongitude );
+
+        // Update trigonometric functions of multiple of longitude
+        const double previousCosineOfOrderLongitude = cosineOfOrderLongitude;
+        cosineOfOrderLongitude = cosineOfOrderLongitude * cosineOfLongitude - sineOfOrderLongitude * sineOfLongitude;
+        sineOfOrderLongitude = sineOfOrderLongitude * cosineOfLongitude + previousCosineOfOrderLongitude * sineOfLongitude;
+
+        currentOrderLegendreFunctions_.swap( nextOrderLegendreFunctions_ );
+    }
+
+    return ( Eigen::Vector3d( ) << -preMultiplier / radius * radialSum,
+             preMultiplier * latitudeSum,
+             preMultiplier * longitudeSum ).finished( );
+}
+
+//! Function to compute the gradients of the potential in spherical coordinates for a block of positions
+void SphericalHarmonicsAccelerationKernel::computeSphericalGradientBlock(
+        const double preMultiplier,
+        Eigen::Matrix< double, 3, BATCH_BLOCK_SIZE >& sphericalGradients )
+{
+    // Compute powers (degree + 1) of radius ratio
+    batchRadiusRatioPowers_.col( 0 ) = batchRadiusRatios_;
+    for( int degree = 1; degree < numberOfDegrees_; degree++ )
+    {
+        batchRadiusRatioPowers_.col( degree ) = batchRadiusRatioPowers_.col( degree - 1 ) * batchRadiusRatios_;
+    }
+
+    const BlockValues latitudeRatios = batchSinesOfLatitude_ / batchCosinesOfLatitude_;
+
+    BlockValues radialSums = BlockValues::Zero( );
+    BlockValues latitudeSums = BlockValues::Zero( );
+    BlockValues longitudeSums = BlockValues::Zero( );
+
+    BlockValues sectoralValues = BlockValues::Ones( );
+    BlockValues cosinesOfOrderLongitude = BlockValues::Ones( );
+    BlockValues sinesOfOrderLongitude = BlockValues::Zero( );
+
+    // Sums over degree of a single order, for each position
+    Eigen::Matrix< double, BATCH_BLOCK_SIZE, 1 > cosineSum;
+    Eigen::Matrix< double, BATCH_BLOCK_SIZE, 1 > sineSum;
+
+    computeLegendreFunctionsOfOrderBlock( 0, sectoralValues, batchCurrentOrderLegendreFunctions_ );
+    for( int order = 0; order < numberOfOrders_; order++ )
+    {
+        const int segmentLength = numberOfDegrees_ - order;
+        const int startIndex = orderStartIndices_[ order ];
+
+        // Compute Legendre functions of next order (required for derivatives)
+        sectoralValues *= sectoralRecursionMultipliers_[ order + 1 ] * batchCosinesOfLatitude_;
+        computeLegendreFunctionsOfOrderBlock( order + 1, sectoralValues, batchNextOrderLegendreFunctions_ );
+        batchNextOrderLegendreFunctions_.col( order ).setZero( );
+
+        // Compute Legendre functions (and cos(latitude) times their derivatives) multiplied by radius ratio powers
+        auto currentFunctions = batchCurrentOrderLegendreFunctions_.middleCols( order, segmentLength );
+        auto radiusPowers = batchRadiusRatioPowers_.middleCols( order, segmentLength );
+        auto weightedFunctions = batchWeightedLegendreFunctions_.leftCols( segmentLength );
+        auto radialWeightedFunctions = batchRadialWeightedLegendreFunctions_.leftCols( segmentLength );
+        auto weightedDerivatives = batchWeightedLegendreDerivatives_.leftCols( segmentLength );
+
+        weightedFunctions = currentFunctions * radiusPowers;
+        radialWeightedFunctions.matrix( ).noalias( ) =
+                weightedFunctions.matrix( ) * packedDegreePlusOne_.segment( startIndex, segmentLength ).asDiagonal( );
+        weightedDerivatives.matrix( ).noalias( ) =
+                batchNextOrderLegendreFunctions_.middleCols( order, segmentLength ).matrix( ) *
+                packedDerivativeMultipliers_.segment( startIndex, segmentLength ).asDiagonal( );
+        weightedDerivatives = ( weightedDerivatives -
+                                currentFunctions.colwise( ) * ( static_cast< double >( order ) * latitudeRatios ) ) *
+                radiusPowers;
+
+        // Sum over degrees for current order, for all positions simultaneously
+        auto cosineCoefficients = packedCosineCoefficients_.segment( startIndex, segmentLength );
+        auto sineCoefficients = packedSineCoefficients_.segment( startIndex, segmentLength );
+
+        cosineSum.noalias( ) = radialWeightedFunctions.matrix( ) * cosineCoefficients;
+        sineSum.noalias( ) = radialWeightedFunctions.matrix( ) * sineCoefficients;
+        radialSums += cosineSum.array( ) * cosinesOfOrderLongitude + sineSum.array( ) * sinesOfOrderLongitude;
+
+        cosineSum.noalias( ) = weightedDerivatives.matrix( ) * cosineCoefficients;
+        sineSum.noalias( ) = weightedDerivatives.matrix( ) * sineCoefficients;
+        latitudeSums += cosineSum.array( ) * cosinesOfOrderLongitude + sineSum.array( ) * sinesOfOrderLongitude;
+
+        cosineSum.noalias( ) = weightedFunctions.matrix( ) * cosineCoefficients;
+        sineSum.noalias( ) = weightedFunctions.matrix( ) * sineCoefficients;
+        longitudeSums += static_cast< double >( order ) * (
+                    sineSum.array( ) * cosinesOfOrderLongitude - cosineSum.array( ) * sinesOfOrderLongitude );
+
+        // Update trigonometric functions of multiple of longitude
+        const BlockValues previousCosinesOfOrderLongitude = cosinesOfOrderLongitude;
+        cosinesOfOrderLongitude = cosinesOfOrderLongitude * batchCosinesOfLongitude_ -
+                sinesOfOrderLongitude * batchSinesOfLongitude_;
+        sinesOfOrderLongitude = sinesOfOrderLongitude * batchCosinesOfLongitude_ +
+                previousCosinesOfOrderLongitude * batchSinesOfLongitude_;
+
+        batchCurrentOrderLegendreFunctions_.swap( batchNextOrderLegendreFunctions_ );
+    }
+
+    sphericalGradients.row( 0 ) = ( -preMultiplier * radialSums / batchRadii_ ).matrix( ).transpose( );
+    sphericalGradients.row( 1 ) = ( preMultiplier * latitudeSums ).matrix( ).transpose( );
+    sphericalGradients.row( 2 ) = ( preMultiplier * longitudeSums ).matrix( ).transpose( );
+}
+
+//! Function to compute the gravitational acceleration at a single position
+Eigen::Vector3d SphericalHarmonicsAccelerationKernel::computeAcceleration(
+        const Eigen::Vector3d& bodyFixedPosition,
+        const double gravitationalParameter,
+        const double referenceRadius,
+        const Eigen::Matrix3d& accelerationRotation )
+{
+    const double radius = bodyFixedPosition.norm( );
+    const double equatorialDistance = std::sqrt(
+                bodyFixedPosition.x( ) * bodyFixedPosition.x( ) + bodyFixedPosition.y( ) * bodyFixedPosition.y( ) );
+
+    double cosineOfLongitude = 1.0;
+    double sineOfLongitude = 0.0;
+    if( equatorialDistance > 0.0 )
+    {
+        cosineOfLongitude = bodyFixedPosition.x( ) / equatorialDistance;
+        sineOfLongitude = bodyFixedPosition.y( ) / equatorialDistance;
+    }
+
+    const Eigen::Vector3d sphericalGradient = computeSphericalGradient(
+                radius, bodyFixedPosition.z( ) / radius, equatorialDistance / radius,
+                cosineOfLongitude, sineOfLongitude, gravitationalParameter / referenceRadius, referenceRadius / radius );
+
+    return accelerationRotation * (
+                coordinate_conversions::getSphericalToCartesianGradientMatrix( bodyFixedPosition ) * sphericalGradient );
+}
+
+//! Function to compute the gravitational acceleration at a list of positions
+void SphericalHarmonicsAccelerationKernel::computeAccelerations(
+        const Eigen::Matrix3Xd& bodyFixedPositions,
+        const double gravitationalParameter,
+        const double referenceRadius,
+        Eigen::Matrix3Xd& accelerations )
+{
+    const int numberOfPositions = static_cast< int >( bodyFixedPositions.cols( ) );
+    accelerations.resize( 3, numberOfPositions );
+
+    Eigen::Matrix< double, 3, BATCH_BLOCK_SIZE > sphericalGradients;
+    for( int blockStart = 0; blockStart < numberOfPositions; blockStart += BATCH_BLOCK_SIZE )
+    {
+        // Set spherical coordinates of positions in block (final block is padded with its last position)
+        const int blockSize = std::min( BATCH_BLOCK_SIZE, numberOfPositions - blockStart );
+        for( int i = 0; i < BATCH_BLOCK_SIZE; i++ )
+        {
+            const Eigen::Vector3d position = bodyFixedPositions.col( blockStart + std::min( i, blockSize - 1 ) );
+            const double radius = position.norm( );
+            const double equatorialDistance = std::sqrt( position.x( ) * position.x( ) + position.y( ) * position.y( ) );
+
+            batchRadii_[ i ] = radius;
+            batchSinesOfLatitude_[ i ] = position.z( ) / radius;
+            batchCosinesOfLatitude_[ i ] = equatorialDistance / radius;
+            batchCosinesOfLongitude_[ i ] = ( equatorialDistance > 0.0 ) ? position.x( ) / equatorialDistance : 1.0;
+            batchSinesOfLongitude_[ i ] = ( equatorialDistance > 0.0 ) ? position.y( ) / equatorialDistance : 0.0;
+            batchRadiusRatios_[ i ] = referenceRadius / radius;
+        }
+
+        computeSphericalGradientBlock( gravitationalParameter / referenceRadius, sphericalGradients );
+
+        for( int i = 0; i < blockSize; i++ )
+        {
+            accelerations.col( blockStart + i ) =
+                    coordinate_conversions::getSphericalToCartesianGradientMatrix(
+                        Eigen::Vector3d( bodyFixedPositions.col( blockStart + i ) ) ) * sphericalGradients.col( i );
+        }
+    }
+}
+
+//! Function to compute the gravitational acceleration at a list of positions
+Eigen::Matrix3Xd SphericalHarmonicsAccelerationKernel::computeAccelerations(
+        const Eigen::Matrix3Xd& bodyFixedPositions,
+        const double gravitationalParameter,
+        const double referenceRadius )
+{
+    Eigen::Matrix3Xd accelerations;
+    computeAccelerations( bodyFixedPositions, gravitationalParameter, referenceRadius, accelerations );
+    return accelerations;
+}
+
+} // namespace gravitation
+
+} // namespace tudat
@@ -56,6 +56,7 @@ void TimeDependentSphericalHarmonicsGravityField::update( const double time )
         // Add correction of this iteration to current coefficients.
         correctionFunctions_[ i ]( time, sineCoefficients_, cosineCoefficients_ );
     }
+    coefficientUpdateCounter_++;
 }
 
 } // namespace gravitation
@@ -0,0 +1,415 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Izzo, D. Revisiting Lambert's problem, Celestial Mechanics and Dynamical Astronomy, 121:1-15, 2015.
+ *      Izzo, D. lambert_problem.cpp, pykep.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+#include "tudat/basics/parallelExecution.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+
+#include "tudat/astro/mission_segments/batchLambertRoutines.h"
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+//! Typedef for array of values of a quantity for each lane (problem) of the batch Lambert solver.
+typedef Eigen::Array< double, LAMBERT_BATCH_LANE_WIDTH, 1 > LambertLaneArray;
+
+//! Typedef for array of flags for each lane (problem) of the batch Lambert solver.
+typedef Eigen::Array< bool, LAMBERT_BATCH_LANE_WIDTH, 1 > LambertLaneMask;
+
+//! Typedef for array of Cartesian vectors for each lane (row) of the batch Lambert solver.
+typedef Eigen::Array< double, LAMBERT_BATCH_LANE_WIDTH, 3 > LambertLaneVectors;
+
+//! Number of Lambert problems in a single task of the thread pool.
+constexpr int LAMBERT_BATCH_TASK_SIZE = 256 * LAMBERT_BATCH_LANE_WIDTH;
+
+//! Compute cross product of vectors for each lane.
+LambertLaneVectors computeLaneCrossProducts( const LambertLaneVectors& first, const LambertLaneVectors& second )
+{
+    LambertLaneVectors crossProduct;
+    crossProduct.col( 0 ) = first.col( 1 ) * second.col( 2 ) - first.col( 2 ) * second.col( 1 );
+    crossProduct.col( 1 ) = first.col( 2 ) * second.col( 0 ) - first.col( 0 ) * second.col( 2 );
+    crossProduct.col( 2 ) = first.col( 0 ) * second.col( 1 ) - first.col( 1 ) * second.col( 0 );
+    return crossProduct;
+}
+
+//! Compute norm of vectors for each lane.
+LambertLaneArray computeLaneNorms( const LambertLaneVectors& vectors )
+{
+    return ( vectors.col( 0 ).square( ) + vectors.col( 1 ).square( ) + vectors.col( 2 ).square( ) ).sqrt( );
+}
+
+//! Compute hypergeometric function 2F1(3, 1, 5/2, z) for each lane (series converges for |z| < 1).
+LambertLaneArray computeLaneHypergeometricFunction( const LambertLaneArray& zParameter, const double tolerance )
+{
+    LambertLaneArray sum = LambertLaneArray::Ones( );
+    LambertLaneArray term = LambertLaneArray::Ones( );
+    int j = 0;
+    while( ( term.abs( ) > tolerance ).any( ) && j < 1000 )
+    {
+        term *= ( 3.0 + j ) * ( 1.0 + j ) / ( 2.5 + j ) / ( j + 1.0 ) * zParameter;
+        sum += term;
+        j++;
+    }
+    return sum;
+}
+
+//! Compute non-dimensional time-of-flight from x-variable for each lane (zero revolutions), as in Izzo (2015).
+/*!
+ * Compute non-dimensional time-of-flight from x-variable for each lane (zero revolutions), as in Izzo (2015). The
+ * Battin series is used close to x = 1, the Lagrange equation slightly further from x = 1, and Lancaster's expression
+ * elsewhere. Lancaster's expression is evaluated for all lanes; the others only if required for any of the lanes.
+ */
+LambertLaneArray computeLaneTimesOfFlight( const LambertLaneArray& xParameter, const LambertLaneArray& lambdaParameter )
+{
+    const double battinRegion = 0.01;
+    const double lagrangeRegion = 0.2;
+
+    LambertLaneArray distanceToParabolic = ( xParameter - 1.0 ).abs( );
+    LambertLaneArray squaredLambda = lambdaParameter.square( );
+    LambertLaneArray eParameter = xParameter.square( ) - 1.0;
+    LambertLaneArray zParameter = ( 1.0 + squaredLambda * eParameter ).sqrt( );
+
+    // Lancaster's expression
+    LambertLaneArray yParameter = eParameter.abs( ).sqrt( );
+    LambertLaneArray gParameter = xParameter * zParameter - lambdaParameter * eParameter;
+    LambertLaneArray ellipticD = gParameter.max( -1.0 ).min( 1.0 ).acos( );
+    LambertLaneArray hyperbolicD = ( yParameter * ( zParameter - lambdaParameter * xParameter ) + gParameter ).log( );
+    LambertLaneArray timesOfFlight = ( xParameter - lambdaParameter * zParameter -
+                                       ( eParameter < 0.0 ).select( ellipticD, hyperbolicD ) / yParameter ) / eParameter;
+
+    // Battin series
+    LambertLaneMask isBattinRegion = distanceToParabolic < battinRegion;
+    if( isBattinRegion.any( ) )
+    {
+        LambertLaneArray etaParameter = zParameter - lambdaParameter * xParameter;
+        LambertLaneArray seriesParameter = isBattinRegion.select(
+                    0.5 * ( 1.0 - lambdaParameter - xParameter * etaParameter ), 0.0 );
+        LambertLaneArray qParameter = 4.0 / 3.0 * computeLaneHypergeometricFunction( seriesParameter, 1.0E-11 );
+        timesOfFlight = isBattinRegion.select(
+                    ( etaParameter.cube( ) * qParameter + 4.0 * lambdaParameter * etaParameter ) / 2.0, timesOfFlight );
+    }
+
+    // Lagrange equation
+    LambertLaneMask isLagrangeRegion = ( distanceToParabolic < lagrangeRegion ) && ( !isBattinRegion );
+    if( isLagrangeRegion.any( ) )
+    {
+        LambertLaneArray semiMajorAxis = 1.0 / ( 1.0 - xParameter.square( ) );
+        LambertLaneArray absoluteSemiMajorAxis = semiMajorAxis.abs( );
+        LambertLaneArray betaSineArgument = ( squaredLambda / absoluteSemiMajorAxis ).sqrt( );
+
+        LambertLaneArray ellipticAlpha = 2.0 * xParameter.max( -1.0 ).min( 1.0 ).acos( );
+        LambertLaneArray ellipticBeta = 2.0 * betaSineArgument.min( 1.0 ).asin( );
+        LambertLaneArray hyperbolicAlpha = 2.0 * ( xParameter + ( xParameter.square( ) - 1.0 ).max( 0.0 ).sqrt( ) ).log( );
+        LambertLaneArray hyperbolicBeta = 2.0 * ( betaSineArgument + ( betaSineArgument.square( ) + 1.0 ).sqrt( ) ).log( );
+        ellipticBeta = ( lambdaParameter < 0.0 ).select( -ellipticBeta, ellipticBeta );
+        hyperbolicBeta = ( lambdaParameter < 0.0 ).select( -hyperbolicBeta, hyperbolicBeta );
+
+        LambertLaneArray ellipticTimeOfFlight = absoluteSemiMajorAxis * absoluteSemiMajorAxis.sqrt( ) * (
+                    ( ellipticAlpha - ellipticAlpha.sin( ) ) - ( ellipticBeta - ellipticBeta.sin( ) ) ) / 2.0;
+        LambertLaneArray hyperbolicTimeOfFlight = absoluteSemiMajorAxis * absoluteSemiMajorAxis.sqrt( ) * (
+                    ( hyperbolicBeta - hyperbolicBeta.sinh( ) ) - ( hyperbolicAlpha - hyperbolicAlpha.sinh( ) ) ) / 2.0;
+        timesOfFlight = isLagrangeRegion.select(
+                    ( semiMajorAxis > 0.0 ).select( ellipticTimeOfFlight, hyperbolicTimeOfFlight ), timesOfFlight );
+    }
+
+    return timesOfFlight;
+}
+
+//! Solve zero-revolution Lambert problems for a single set of lanes, using Izzo's (2015) algorithm.
+/*!
+ * Solve zero-revolution Lambert problems for a single set of lanes, using Izzo's (2015) algorithm.
+ * \return Flags denoting for which lanes a solution was found.
+ */
+LambertLaneMask solveLaneLambertProblemsIzzo(
+        const LambertLaneVectors& positionsAtDeparture,
+        const LambertLaneVectors& positionsAtArrival,
+        const LambertLaneArray& timesOfFlight,
+        const LambertLaneArray& gravitationalParameters,
+        LambertLaneVectors& velocitiesAtDeparture,
+        LambertLaneVectors& velocitiesAtArrival,
+        const bool isRetrograde,
+        const double convergenceTolerance,
+        const unsigned int maximumNumberOfIterations )
+{
+    // Compute transfer geometry
+    LambertLaneArray radiusAtDeparture = computeLaneNorms( positionsAtDeparture );
+    LambertLaneArray radiusAtArrival = computeLaneNorms( positionsAtArrival );
+    LambertLaneArray chord = computeLaneNorms( positionsAtArrival - positionsAtDeparture );
+    LambertLaneArray semiPerimeter = ( radiusAtDeparture + radiusAtArrival + chord ) / 2.0;
+
+    LambertLaneVectors radialUnitVectorsAtDeparture = positionsAtDeparture.colwise( ) / radiusAtDeparture;
+    LambertLaneVectors radialUnitVectorsAtArrival = positionsAtArrival.colwise( ) / radiusAtArrival;
+    LambertLaneVectors angularMomentumUnitVectors =
+            computeLaneCrossProducts( radialUnitVectorsAtDeparture, radialUnitVectorsAtArrival );
+    LambertLaneArray sineOfTransferAngle = computeLaneNorms( angularMomentumUnitVectors );
+    angularMomentumUnitVectors.colwise( ) /= sineOfTransferAngle;
+
+    // Determine direction of motion: long-way transfer if angular momentum has negative z-component (for prograde motion)
+    LambertLaneArray directionSign = ( angularMomentumUnitVectors.col( 2 ) < 0.0 ).select(
+                LambertLaneArray::Constant( -1.0 ), LambertLaneArray::Constant( 1.0 ) );
+    if( isRetrograde )
+    {
+        directionSign = -directionSign;
+    }
+
+    LambertLaneArray lambdaParameter = directionSign * ( 1.0 - chord / semiPerimeter ).max( 0.0 ).sqrt( );
+    LambertLaneVectors transverseUnitVectorsAtDeparture =
+            computeLaneCrossProducts( angularMomentumUnitVectors, radialUnitVectorsAtDeparture ).colwise( ) * directionSign;
+    LambertLaneVectors transverseUnitVectorsAtArrival =
+            computeLaneCrossProducts( angularMomentumUnitVectors, radialUnitVectorsAtArrival ).colwise( ) * directionSign;
+
+    LambertLaneArray normalizedTimesOfFlight =
+            ( 2.0 * gravitationalParameters / semiPerimeter.cube( ) ).sqrt( ) * timesOfFlight;
+
+    // Compute initial guess of x-variable
+    LambertLaneArray squaredLambda = lambdaParameter.square( );
+    LambertLaneArray cubedLambda = squaredLambda * lambdaParameter;
+    LambertLaneArray parabolicTimeOfFlight = 2.0 / 3.0 * ( 1.0 - cubedLambda );
+    LambertLaneArray minimumEnergyTimeOfFlight =
+            lambdaParameter.acos( ) + lambdaParameter * ( 1.0 - squaredLambda ).sqrt( );
+
+    LambertLaneArray xParameter = ( normalizedTimesOfFlight >= minimumEnergyTimeOfFlight ).select(
+                -( normalizedTimesOfFlight - minimumEnergyTimeOfFlight ) /
+                ( normalizedTimesOfFlight - minimumEnergyTimeOfFlight + 4.0 ),
+                ( normalizedTimesOfFlight <= parabolicTimeOfFlight ).select(
+                    parabolicTimeOfFlight * ( parabolicTimeOfFlight - normalizedTimesOfFlight ) /
+                    ( 2.0 / 5.0 * ( 1.0 - squaredLambda * cubedLambda ) * normalizedTimesOfFlight ) + 1.0,
+                    ( ( normalizedTimesOfFlight / minimumEnergyTimeOfFlight ).log( ) * std::log( 2.0 ) /
+                      ( parabolicTimeOfFlight / minimumEnergyTimeOfFlight ).log( ) ).exp( ) - 1.0 ) );
+
+    // Perform Householder iterations, stopping iterations for lanes that have converged
+    LambertLaneMask isLaneActive = LambertLaneMask::Constant( true );
+    unsigned int numberOfIterations = 0;
+    while( isLaneActive.any( ) && numberOfIterations < maximumNumberOfIterations )
+    {
+        LambertLaneArray timeOfFlightError =
+                computeLaneTimesOfFlight( xParameter, lambdaParameter ) - normalizedTimesOfFlight;
+
+        // Compute derivatives of time-of-flight w.r.t. x
+        LambertLaneArray oneMinusSquaredX = 1.0 - xParameter.square( );
+        LambertLaneArray yParameter = ( 1.0 - squaredLambda * oneMinusSquaredX ).sqrt( );
+        LambertLaneArray cubedY = yParameter.cube( );
+        LambertLaneArray firstDerivative = ( 3.0 * ( timeOfFlightError + normalizedTimesOfFlight ) * xParameter - 2.0 +
+                                             2.0 * cubedLambda * xParameter / yParameter ) / oneMinusSquaredX;
+        LambertLaneArray secondDerivative = ( 3.0 * ( timeOfFlightError + normalizedTimesOfFlight ) +
+                                              5.0 * xParameter * firstDerivative +
+                                              2.0 * ( 1.0 - squaredLambda ) * cubedLambda / cubedY ) / oneMinusSquaredX;
+        LambertLaneArray thirdDerivative = ( 7.0 * xParameter * secondDerivative + 8.0 * firstDerivative -
+                                             6.0 * ( 1.0 - squaredLambda ) * squaredLambda * cubedLambda * xParameter /
+                                             ( cubedY * yParameter.square( ) ) ) / oneMinusSquaredX;
+
+        LambertLaneArray squaredFirstDerivative = firstDerivative.square( );
+        LambertLaneArray newXParameter = xParameter - timeOfFlightError *
+                ( squaredFirstDerivative - timeOfFlightError * secondDerivative / 2.0 ) /
+                ( firstDerivative * ( squaredFirstDerivative - timeOfFlightError * secondDerivative ) +
+                  thirdDerivative * timeOfFlightError.square( ) / 6.0 );
+
+        // Update only lanes that have not yet converged (NaN values are considered converged, and are caught below)
+        LambertLaneArray xParameterChange = ( newXParameter - xParameter ).abs( );
+        xParameter = isLaneActive.select( newXParameter, xParameter );
+        isLaneActive = isLaneActive && ( xParameterChange > convergenceTolerance );
+        numberOfIterations++;
+    }
+
+    // Reconstruct velocities
+    LambertLaneArray gammaParameter = ( gravitationalParameters * semiPerimeter / 2.0 ).sqrt( );
+    LambertLaneArray rhoParameter = ( radiusAtDeparture - radiusAtArrival ) / chord;
+    LambertLaneArray sigmaParameter = ( 1.0 - rhoParameter.square( ) ).sqrt( );
+    LambertLaneArray yParameter = ( 1.0 - squaredLambda + squaredLambda * xParameter.square( ) ).sqrt( );
+
+    LambertLaneArray radialVelocityAtDeparture =
+            gammaParameter * ( ( lambdaParameter * yParameter - xParameter ) -
+                               rhoParameter * ( lambdaParameter * yParameter + xParameter ) ) / radiusAtDeparture;
+    LambertLaneArray radialVelocityAtArrival =
+            -gammaParameter * ( ( lambdaParameter * yParameter - xParameter ) +
+                                rhoParameter * ( lambdaParameter * yParameter + xParameter ) ) / radiusAtArrival;
+    LambertLaneArray transverseVelocity =
+            gammaParameter * sigmaParameter * ( yParameter + lambdaParameter * xParameter );
+
+    velocitiesAtDeparture = radialUnitVectorsAtDeparture.colwise( ) * radialVelocityAtDeparture +
+            transverseUnitVectorsAtDeparture.colwise( ) * ( transverseVelocity / radiusAtDeparture );
+    velocitiesAtArrival = radialUnitVectorsAtArrival.colwise( ) * radialVelocityAtArrival +
+            transverseUnitVectorsAtArrival.colwise( ) * ( transverseVelocity / radiusAtArrival );
+
+    // Set velocities to NaN for lanes without (converged) solution, or with undefined transfer plane (collinear positions)
+    LambertLaneMask isSolutionFound = ( !isLaneActive ) && ( timesOfFlight > 0.0 ) &&
+            ( sineOfTransferAngle > 1.0E-12 ) &&
+            ( computeLaneNorms( velocitiesAtDeparture ) + computeLaneNorms( velocitiesAtArrival ) ).isFinite( );
+    for( int i = 0; i < LAMBERT_BATCH_LANE_WIDTH; i++ )
+    {
+        if( !isSolutionFound( i ) )
+        {
+            velocitiesAtDeparture.row( i ).setConstant( TUDAT_NAN );
+            velocitiesAtArrival.row( i ).setConstant( TUDAT_NAN );
+        }
+    }
+    return isSolutionFound;
+}
+
+//! Solve a batch of zero-revolution Lambert problems using Izzo's (2015) algorithm.
+unsigned int solveLambertProblemsIzzo(
+        const Eigen::Ref< const Eigen::Matrix< double, Eigen::Dynamic, 3 > >& cartesianPositionsAtDeparture,
+        const Eigen::Ref< const Eigen::Matrix< double, Eigen::Dynamic, 3 > >& cartesianPositionsAtArrival,
+        const Eigen::Ref< const Eigen::VectorXd >& timesOfFlight,
+        const Eigen::Ref< const Eigen::VectorXd >& gravitationalParameters,
+        Eigen::Matrix< double, Eigen::Dynamic, 3 >& cartesianVelocitiesAtDeparture,
+        Eigen::Matrix< double, Eigen::Dynamic, 3 >& cartesianVelocitiesAtArrival,
+        const bool isRetrograde,
+        const double convergenceTolerance,
+        const unsigned int maximumNumberOfIterations,
+        const unsigned int numberOfThreads )
+{
+    // Check input consistency
+    const int numberOfProblems = cartesianPositionsAtDeparture.rows( );
+    if( cartesianPositionsAtArrival.rows( ) != numberOfProblems || timesOfFlight.rows( ) != numberOfProblems )
+    {
+        throw std::runtime_error( "Error when solving batch of Lambert problems, number of positions at departure (" +
+                                  std::to_string( numberOfProblems ) + "), positions at arrival (" +
+                                  std::to_string( cartesianPositionsAtArrival.rows( ) ) + ") and times of flight (" +
+                                  std::to_string( timesOfFlight.rows( ) ) + ") are inconsistent" );
+    }
+
+    const bool isGravitationalParameterConstant = ( gravitationalParameters.rows( ) == 1 );
+    if( !isGravitationalParameterConstant && gravitationalParameters.rows( ) != numberOfProblems )
+    {
+        throw std::runtime_error( "Error when solving batch of Lambert problems, number of gravitational parameters (" +
+                                  std::to_string( gravitationalParameters.rows( ) ) + ") is inconsistent" );
+    }
+
+    cartesianVelocitiesAtDeparture.resize( numberOfProblems, 3 );
+    cartesianVelocitiesAtArrival.resize( numberOfProblems, 3 );
+
+    // Solve problems in blocks of LAMBERT_BATCH_TASK_SIZE problems per task
+    std::atomic< unsigned int > numberOfFailedProblems( 0 );
+    const int numberOfTasks = ( numberOfProblems + LAMBERT_BATCH_TASK_SIZE - 1 ) / LAMBERT_BATCH_TASK_SIZE;
+    utilities::executeTasksInParallel(
+                numberOfTasks, numberOfThreads, [ & ]( const unsigned int taskIndex, const unsigned int )
+    {
+        LambertLaneVectors positionsAtDeparture, positionsAtArrival, velocitiesAtDeparture, velocitiesAtArrival;
+        LambertLaneArray laneTimesOfFlight, laneGravitationalParameters;
+        unsigned int numberOfFailedProblemsInTask = 0;
+
+        const int taskEnd = std::min( static_cast< int >( taskIndex + 1 ) * LAMBERT_BATCH_TASK_SIZE, numberOfProblems );
+        for( int laneStart = taskIndex * LAMBERT_BATCH_TASK_SIZE; laneStart < taskEnd;
+             laneStart += LAMBERT_BATCH_LANE_WIDTH )
+        {
+            // Load lanes, padding the last lanes with copies of the last problem
+            const int numberOfActiveLanes = std::min( LAMBERT_BATCH_LANE_WIDTH, taskEnd - laneStart );
+            for( int i = 0; i < LAMBERT_BATCH_LANE_WIDTH; i++ )
+            {
+                int problemIndex = laneStart + std::min( i, numberOfActiveLanes - 1 );
+                positionsAtDeparture.row( i ) = cartesianPositionsAtDeparture.row( problemIndex ).array( );
+                positionsAtArrival.row( i ) = cartesianPositionsAtArrival.row( problemIndex ).array( );
+                laneTimesOfFlight( i ) = timesOfFlight( problemIndex );
+                laneGravitationalParameters( i ) =
+                        gravitationalParameters( isGravitationalParameterConstant ? 0 : problemIndex );
+            }
+
+            LambertLaneMask isSolutionFound = solveLaneLambertProblemsIzzo(
+                        positionsAtDeparture, positionsAtArrival, laneTimesOfFlight, laneGravitationalParameters,
+                        velocitiesAtDeparture, velocitiesAtArrival, isRetrograde, convergenceTolerance,
+                        maximumNumberOfIterations );
+
+            cartesianVelocitiesAtDeparture.middleRows( laneStart, numberOfActiveLanes ) =
+                    velocitiesAtDeparture.topRows( numberOfActiveLanes ).matrix( );
+            cartesianVelocitiesAtArrival.middleRows( laneStart, numberOfActiveLanes ) =
+                    velocitiesAtArrival.topRows( numberOfActiveLanes ).matrix( );
+            numberOfFailedProblemsInTask += numberOfActiveLanes -
+                    isSolutionFound.head( numberOfActiveLanes ).count( );
+        }
+        numberOfFailedProblems += numberOfFailedProblemsInTask;
+    } );
+
+    return numberOfFailedProblems;
+}
+
+//! Compute the departure and arrival excess velocities of Lambert transfers for a grid of departure and arrival times.
+unsigned int computeLambertTransferGridExcessVelocities(
+        const std::shared_ptr< ephemerides::Ephemeris > departureBodyEphemeris,
+        const std::shared_ptr< ephemerides::Ephemeris > arrivalBodyEphemeris,
+        const std::vector< double >& departureTimes,
+        const std::vector< double >& arrivalTimes,
+        const double centralBodyGravitationalParameter,
+        Eigen::MatrixXd& departureExcessVelocities,
+        Eigen::MatrixXd& arrivalExcessVelocities,
+        const unsigned int numberOfThreads,
+        const bool isRetrograde )
+{
+    // Compute body states once per epoch
+    Eigen::Matrix< double, 6, Eigen::Dynamic > departureBodyStates, arrivalBodyStates;
+    departureBodyEphemeris->getCartesianStates( departureTimes, departureBodyStates );
+    arrivalBodyEphemeris->getCartesianStates( arrivalTimes, arrivalBodyStates );
+
+    const int numberOfDepartureTimes = departureTimes.size( );
+    const int numberOfArrivalTimes = arrivalTimes.size( );
+    departureExcessVelocities.resize( numberOfDepartureTimes, numberOfArrivalTimes );
+    arrivalExcessVelocities.resize( numberOfDepartureTimes, numberOfArrivalTimes );
+
+    // Solve Lambert problems for each departure time as a separate task
+    std::atomic< unsigned int > numberOfFailedProblems( 0 );
+    utilities::executeTasksInParallel(
+                numberOfDepartureTimes, numberOfThreads, [ & ]( const unsigned int departureIndex, const unsigned int )
+    {
+        LambertLaneVectors positionsAtDeparture, positionsAtArrival, velocitiesAtDeparture, velocitiesAtArrival;
+        LambertLaneVectors departureBodyVelocities, arrivalBodyVelocities;
+        LambertLaneArray laneTimesOfFlight;
+        const LambertLaneArray laneGravitationalParameters = LambertLaneArray::Constant( centralBodyGravitationalParameter );
+        unsigned int numberOfFailedProblemsInTask = 0;
+
+        for( int i = 0; i < LAMBERT_BATCH_LANE_WIDTH; i++ )
+        {
+            positionsAtDeparture.row( i ) = departureBodyStates.block( 0, departureIndex, 3, 1 ).transpose( ).array( );
+            departureBodyVelocities.row( i ) = departureBodyStates.block( 3, departureIndex, 3, 1 ).transpose( ).array( );
+        }
+
+        for( int laneStart = 0; laneStart < numberOfArrivalTimes; laneStart += LAMBERT_BATCH_LANE_WIDTH )
+        {
+            // Load lanes, padding the last lanes with copies of the last arrival time
+            const int numberOfActiveLanes = std::min( LAMBERT_BATCH_LANE_WIDTH, numberOfArrivalTimes - laneStart );
+            for( int i = 0; i < LAMBERT_BATCH_LANE_WIDTH; i++ )
+            {
+                int arrivalIndex = laneStart + std::min( i, numberOfActiveLanes - 1 );
+                positionsAtArrival.row( i ) = arrivalBodyStates.block( 0, arrivalIndex, 3, 1 ).transpose( ).array( );
+                arrivalBodyVelocities.row( i ) = arrivalBodyStates.block( 3, arrivalIndex, 3, 1 ).transpose( ).array( );
+                laneTimesOfFlight( i ) = arrivalTimes.at( arrivalIndex ) - departureTimes.at( departureIndex );
+            }
+
+            LambertLaneMask isSolutionFound = solveLaneLambertProblemsIzzo(
+                        positionsAtDeparture, positionsAtArrival, laneTimesOfFlight, laneGravitationalParameters,
+                        velocitiesAtDeparture, velocitiesAtArrival, isRetrograde, 1.0E-5, 15 );
+
+            departureExcessVelocities.block( departureIndex, laneStart, 1, numberOfActiveLanes ) =
+                    computeLaneNorms( velocitiesAtDeparture - departureBodyVelocities ).head(
+                        numberOfActiveLanes ).matrix( ).transpose( );
+            arrivalExcessVelocities.block( departureIndex, laneStart, 1, numberOfActiveLanes ) =
+                    computeLaneNorms( velocitiesAtArrival - arrivalBodyVelocities ).head(
+                        numberOfActiveLanes ).matrix( ).transpose( );
+            numberOfFailedProblemsInTask += ( ( !isSolutionFound ) && ( laneTimesOfFlight > 0.0 ) ).head(
+                        numberOfActiveLanes ).count( );
+        }
+        numberOfFailedProblems += numberOfFailedProblemsInTask;
+    } );
+
+    return numberOfFailedProblems;
+}
+
+} // namespace mission_segments
+} // namespace tudat
@@ -1,3 +1,4 @@
+#include "tudat/basics/parallelExecution.h"
 #include "tudat/astro/mission_segments/createTransferTrajectory.h"
 
 namespace tudat
@@ -455,10 +456,11 @@ std::shared_ptr< TransferTrajectory > createTransferTrajectory(
     std::vector< std::shared_ptr< TransferLeg > > legs;
     std::vector< std::shared_ptr< TransferNode > > nodes;
 
-
+    std::vector< bool > nodesComputeOutgoingVelocity =
+            getTransferNodesComputingOutgoingVelocity( legSettings, nodeSettings );
     for( unsigned int i = 0; i < legSettings.size( ); i++ )
     {
-        if( legRequiresInputFromNode.at( legSettings.at( i )->legType_ ) )
+        if( nodesComputeOutgoingVelocity.at( i ) )
         {
             nodes.push_back(
                         createTransferNode(
@@ -486,86 +488,77 @@ std::shared_ptr< TransferTrajectory > createTransferTrajectory(
         }
     }
 
-    if( nodeSettings.at( legSettings.size( ) )->nodeType_ == capture_and_insertion )
+    nodes.push_back(
+                createTransferNode(
+                    bodyMap, nodeSettings.at( legSettings.size( ) ),
+                    nodeIds.at( legSettings.size( ) ),
+                    legs.at( legSettings.size( ) -  1 ), nullptr,
+                    nodesComputeOutgoingVelocity.at( legSettings.size( ) ) ) );
+
+    return std::make_shared< TransferTrajectory >( legs, nodes );
+
+}
+
+
+std::vector< std::shared_ptr< TransferTrajectory > > createTransferTrajectoriesPerThread(
+        const std::function< simulation_setup::SystemOfBodies( ) > bodiesCreationFunction,
+        const std::vector< std::shared_ptr< TransferLegSettings > >& legSettings,
+        const std::vector< std::shared_ptr< TransferNodeSettings > >& nodeSettings,
+        const std::vector< std::string >& nodeIds,
+        const std::string& centralBody,
+        const unsigned int numberOfThreads )
+{
+    unsigned int numberOfTrajectories =
+            ( numberOfThreads == 0 ) ? utilities::getNumberOfAvailableThreads( ) : numberOfThreads;
+
+    std::vector< std::shared_ptr< TransferTrajectory > > transferTrajectories;
+    for( unsigned int i = 0; i < numberOfTrajectories; i++ )
     {
-        nodes.push_back(
-                    createTransferNode(
-                        bodyMap, nodeSettings.at( legSettings.size( ) ),
-                        nodeIds.at( legSettings.size( ) ),
-                        legs.at( legSettings.size( ) -  1 ), nullptr, false ) );
+        transferTrajectories.push_back(
+                    createTransferTrajectory(
+                        bodiesCreationFunction( ), legSettings, nodeSettings, nodeIds, centralBody ) );
     }
-    else
+    return transferTrajectories;
+}
+
+std::vector< bool > getTransferNodesComputingOutgoingVelocity(
+        const std::vector< std::shared_ptr< TransferLegSettings > >& legSettings,
+        const std::vector< std::shared_ptr< TransferNodeSettings > >& nodeSettings )
+{
+    if( legSettings.size( ) + 1 != nodeSettings.size( ) )
     {
-        nodes.push_back(
-                    createTransferNode(
-                        bodyMap, nodeSettings.at( legSettings.size( ) ),
-                        nodeIds.at( legSettings.size( ) ),
-                        legs.at( legSettings.size( ) -  1 ), nullptr, true ) );
+        throw std::runtime_error( "Error when making transfer trajectory, number of legs ( "
+                                  + std::to_string( legSettings.size( ) ) +
+                                  " ) and number of nodes ( "
+                                  + std::to_string( nodeSettings.size( ) ) +
+                                  " ) are incompatible" );
     }
 
-    return std::make_shared< TransferTrajectory >( legs, nodes );
-
+    // Node computes outgoing velocity if outgoing leg requires it as input, final node unless it is a capture node
+    std::vector< bool > nodesComputeOutgoingVelocity;
+    for( unsigned int i = 0; i < legSettings.size( ); i++ )
+    {
+        nodesComputeOutgoingVelocity.push_back( legRequiresInputFromNode.at( legSettings.at( i )->legType_ ) );
+    }
+    nodesComputeOutgoingVelocity.push_back( nodeSettings.at( legSettings.size( ) )->nodeType_ != capture_and_insertion );
+    return nodesComputeOutgoingVelocity;
 }
 
-
 void getParameterVectorDecompositionIndices(
         const std::vector< std::shared_ptr< TransferLegSettings > >& legSettings,
         const std::vector< std::shared_ptr< TransferNodeSettings > >& nodeSettings,
         std::vector< std::pair< int, int > >& legParameterIndices,
         std::vector< std::pair< int, int > >& nodeParameterIndices )
 {
-    // First N parameters are times/TOFs
-    int currentParameterIndex = nodeSettings.size( );
-
-    for( unsigned int i = 0; i < nodeSettings.size( ); i++ )
+    std::vector< TransferLegTypes > legTypes;
+    for( unsigned int i = 0; i < legSettings.size( ); i++ )
     {
-        switch( nodeSettings.at( i )->nodeType_  )
-        {
-        case swingby:
-            if( legRequiresInputFromNode.at( legSettings.at( i )->legType_ ) )
-            {
-                nodeParameterIndices.push_back( std::make_pair( currentParameterIndex, 3 ) );
-                currentParameterIndex += 3;
-            }
-            else
-            {
-                nodeParameterIndices.push_back( std::make_pair( currentParameterIndex, 0 ) );
-            }
-            break;
-        case escape_and_departure:
-            if( legRequiresInputFromNode.at( legSettings.at( i )->legType_ ) )
-            {
-                nodeParameterIndices.push_back( std::make_pair( currentParameterIndex, 3 ) );
-                currentParameterIndex += 3;
-            }
-            else
-            {
-                nodeParameterIndices.push_back( std::make_pair( currentParameterIndex, 0 ) );
-            }
-            break;
-        case capture_and_insertion:
-            nodeParameterIndices.push_back( std::make_pair( currentParameterIndex, 0 ) );
-            break;
-        }
-
-        if( i != legSettings.size( ) )
-        {
-            switch( legSettings.at( i )->legType_  )
-            {
-            case unpowered_unperturbed_leg:
-                legParameterIndices.push_back( std::make_pair( currentParameterIndex, 0 ) );
-                break;
-            case dsm_position_based_leg:
-                legParameterIndices.push_back( std::make_pair( currentParameterIndex, 4 ) );
-                currentParameterIndex += 4;
-                break;
-            case dsm_velocity_based_leg:
-                legParameterIndices.push_back( std::make_pair( currentParameterIndex, 1 ) );
-                currentParameterIndex += 1;
-                break;
-            }
-        }
+        legTypes.push_back( legSettings.at( i )->legType_ );
     }
+
+    getParameterVectorDecompositionIndices(
+                legTypes, getTransferNodesComputingOutgoingVelocity( legSettings, nodeSettings ),
+                legParameterIndices, nodeParameterIndices );
 }
 
 void printTransferParameterDefinition(
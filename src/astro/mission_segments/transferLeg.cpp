@@ -15,7 +15,7 @@ TransferLeg::TransferLeg(
     departureBodyEphemeris_( departureBodyEphemeris ), arrivalBodyEphemeris_( arrivalBodyEphemeris ),
     legType_( legType ), legParameters_( Eigen::VectorXd::Zero( 0 ) ){ }
 
-void TransferLeg::updateLegParameters( const Eigen::VectorXd legParameters )
+void TransferLeg::updateLegParameters( const Eigen::VectorXd& legParameters )
 {
     legParameters_ = legParameters;
     computeTransfer( );
@@ -11,7 +11,7 @@ TransferNode::TransferNode(
         const TransferNodeTypes nodeType ):
     nodeEphemeris_( nodeEphemeris ), nodeType_( nodeType ), nodeParameters_( Eigen::VectorXd::Zero( 0 ) ){ }
 
-void TransferNode::updateNodeParameters( const Eigen::VectorXd nodeParameters )
+void TransferNode::updateNodeParameters( const Eigen::VectorXd& nodeParameters )
 {
     nodeParameters_ = nodeParameters;
     computeNode( );
@@ -1,3 +1,5 @@
+#include "tudat/basics/parallelExecution.h"
+
 #include "tudat/astro/mission_segments/transferTrajectory.h"
 
 namespace tudat
@@ -6,57 +8,174 @@ namespace tudat
 namespace mission_segments
 {
 
+int getNumberOfTransferLegFreeParameters( const TransferLegTypes legType )
+{
+    int numberOfLegFreeParameters = 0;
+    switch( legType )
+    {
+    case unpowered_unperturbed_leg:
+        numberOfLegFreeParameters = 0;
+        break;
+    case dsm_position_based_leg:
+        numberOfLegFreeParameters = 4;
+        break;
+    case dsm_velocity_based_leg:
+        numberOfLegFreeParameters = 1;
+        break;
+    default:
+        throw std::runtime_error( "Error when getting number of free parameters of transfer leg, leg type not recognized" );
+    }
+    return numberOfLegFreeParameters;
+}
+
+int getParameterVectorDecompositionIndices(
+        const std::vector< TransferLegTypes >& legTypes,
+        const std::vector< bool >& nodesComputeOutgoingVelocity,
+        std::vector< std::pair< int, int > >& legParameterIndices,
+        std::vector< std::pair< int, int > >& nodeParameterIndices )
+{
+    if( legTypes.size( ) + 1 != nodesComputeOutgoingVelocity.size( ) )
+    {
+        throw std::runtime_error( "Error when making transfer trajectory, number of legs ( "
+                                  + std::to_string( legTypes.size( ) ) +
+                                  " ) and number of nodes ( "
+                                  + std::to_string( nodesComputeOutgoingVelocity.size( ) ) +
+                                  " ) are incompatible" );
+    }
+
+    legParameterIndices.clear( );
+    nodeParameterIndices.clear( );
+
+    // First parameters are node time and times of flight, followed by free parameters of nodes and legs
+    int currentParameterIndex = nodesComputeOutgoingVelocity.size( );
+    for( unsigned int i = 0; i < nodesComputeOutgoingVelocity.size( ); i++ )
+    {
+        int numberOfNodeFreeParameters = ( nodesComputeOutgoingVelocity.at( i ) ? 3 : 0 );
+        nodeParameterIndices.push_back( std::make_pair( currentParameterIndex, numberOfNodeFreeParameters ) );
+        currentParameterIndex += numberOfNodeFreeParameters;
+
+        if( i != legTypes.size( ) )
+        {
+            int numberOfLegFreeParameters = getNumberOfTransferLegFreeParameters( legTypes.at( i ) );
+            legParameterIndices.push_back( std::make_pair( currentParameterIndex, numberOfLegFreeParameters ) );
+            currentParameterIndex += numberOfLegFreeParameters;
+        }
+    }
+    return currentParameterIndex;
+}
+
 
 void TransferTrajectory::evaluateTrajectory(
         const std::vector< double >& nodeTimes,
         const std::vector< Eigen::VectorXd >& legFreeParameters,
         const std::vector< Eigen::VectorXd >& nodeFreeParameters )
+{
+    for( unsigned int i = 0; i < legs_.size( ); i++ )
+    {
+        getLegTotalParameters(
+                    nodeTimes, legFreeParameters.at( i ), i, legTotalParameters_.at( i ) );
+    }
+
+    for( unsigned int i = 0; i < nodes_.size( ); i++ )
+    {
+        getNodeTotalParameters(
+                    nodeTimes, nodeFreeParameters.at( i ), i, nodeTotalParameters_.at( i ) );
+    }
+
+    updateLegsAndNodes( );
+}
+
+void TransferTrajectory::evaluateTrajectory( const Eigen::Ref< const Eigen::VectorXd >& trajectoryParameters )
+{
+    if( trajectoryParameters.rows( ) != numberOfTrajectoryParameters_ )
+    {
+        throw std::runtime_error( "Error when evaluating transfer trajectory, number of trajectory parameters ( "
+                                  + std::to_string( trajectoryParameters.rows( ) ) +
+                                  " ) is inconsistent with expected number ( "
+                                  + std::to_string( numberOfTrajectoryParameters_ ) + " )" );
+    }
+
+    // Retrieve node times from departure time and times of flight
+    nodeTimes_[ 0 ] = trajectoryParameters( 0 );
+    for( unsigned int i = 1; i < nodes_.size( ); i++ )
+    {
+        nodeTimes_[ i ] = nodeTimes_[ i - 1 ] + trajectoryParameters( i );
+    }
+
+    for( unsigned int i = 0; i < legs_.size( ); i++ )
+    {
+        getLegTotalParameters(
+                    nodeTimes_, trajectoryParameters.segment(
+                        legFreeParameterIndices_[ i ].first, legFreeParameterIndices_[ i ].second ),
+                    i, legTotalParameters_[ i ] );
+    }
+
+    for( unsigned int i = 0; i < nodes_.size( ); i++ )
+    {
+        getNodeTotalParameters(
+                    nodeTimes_, trajectoryParameters.segment(
+                        nodeFreeParameterIndices_[ i ].first, nodeFreeParameterIndices_[ i ].second ),
+                    i, nodeTotalParameters_[ i ] );
+    }
+
+    updateLegsAndNodes( );
+}
+
+void TransferTrajectory::updateLegsAndNodes( )
 {
     totalDeltaV_ = 0.0;
     totalTimeOfFlight_ = 0.0;
 
-    Eigen::VectorXd legTotalParameters;
-    Eigen::VectorXd nodeTotalParameters;
-
     for( unsigned int i = 0; i < legs_.size( ); i++ )
     {
         if( !nodes_.at( i )->nodeComputesOutgoingVelocity( ) )
         {
-            getLegTotalParameters(
-                        nodeTimes, legFreeParameters.at( i ), i, legTotalParameters );
-            legs_.at( i )->updateLegParameters( legTotalParameters );
+            legs_.at( i )->updateLegParameters( legTotalParameters_.at( i ) );
             totalDeltaV_ += legs_.at( i )->getLegDeltaV( );
             totalTimeOfFlight_ += legs_.at( i )->getLegTimeOfFlight( );
 
-            getNodeTotalParameters(
-                        nodeTimes, nodeFreeParameters.at( i ), i, nodeTotalParameters );
-            nodes_.at( i )->updateNodeParameters( nodeTotalParameters );
+            nodes_.at( i )->updateNodeParameters( nodeTotalParameters_.at( i ) );
             totalDeltaV_ += nodes_.at( i )->getNodeDeltaV( );
         }
         else
         {
-            getNodeTotalParameters(
-                        nodeTimes, nodeFreeParameters.at( i ), i, nodeTotalParameters );
-            nodes_.at( i )->updateNodeParameters( nodeTotalParameters );
+            nodes_.at( i )->updateNodeParameters( nodeTotalParameters_.at( i ) );
             totalDeltaV_ += nodes_.at( i )->getNodeDeltaV( );
 
-            getLegTotalParameters(
-                        nodeTimes, legFreeParameters.at( i ), i, legTotalParameters );
-            legs_.at( i )->updateLegParameters( legTotalParameters );
+            legs_.at( i )->updateLegParameters( legTotalParameters_.at( i ) );
             totalDeltaV_ += legs_.at( i )->getLegDeltaV( );
             totalTimeOfFlight_ += legs_.at( i )->getLegTimeOfFlight( );
         }
     }
 
-    getNodeTotalParameters(
-                nodeTimes, nodeFreeParameters.at( legs_.size( ) ), legs_.size( ), nodeTotalParameters );
-
-    nodes_.at( legs_.size( ) )->updateNodeParameters( nodeTotalParameters );
+    nodes_.at( legs_.size( ) )->updateNodeParameters( nodeTotalParameters_.at( legs_.size( ) ) );
 
     totalDeltaV_ += nodes_.at( legs_.size( ) )->getNodeDeltaV( );
     isComputed_ = true;
 }
 
+void TransferTrajectory::setTrajectoryParameterIndices( )
+{
+    std::vector< TransferLegTypes > legTypes;
+    for( unsigned int i = 0; i < legs_.size( ); i++ )
+    {
+        legTypes.push_back( legs_.at( i )->getTransferLegType( ) );
+    }
+
+    std::vector< bool > nodesComputeOutgoingVelocity;
+    for( unsigned int i = 0; i < nodes_.size( ); i++ )
+    {
+        nodesComputeOutgoingVelocity.push_back( nodes_.at( i )->nodeComputesOutgoingVelocity( ) );
+    }
+
+    numberOfTrajectoryParameters_ = getParameterVectorDecompositionIndices(
+                legTypes, nodesComputeOutgoingVelocity, legFreeParameterIndices_, nodeFreeParameterIndices_ );
+
+    nodeTimes_.resize( nodes_.size( ) );
+    legTotalParameters_.resize( legs_.size( ) );
+    nodeTotalParameters_.resize( nodes_.size( ) );
+}
+
 double TransferTrajectory::getTotalDeltaV( )
 {
     if( isComputed_ )
@@ -149,7 +268,7 @@ void TransferTrajectory::getStatesAlongTrajectoryPerLeg(
 
 void TransferTrajectory::getLegTotalParameters(
         const std::vector< double >& nodeTimes,
-        const Eigen::VectorXd& legFreeParameters,
+        const Eigen::Ref< const Eigen::VectorXd >& legFreeParameters,
         const int legIndex,
         Eigen::VectorXd& legTotalParameters )
 {
@@ -178,7 +297,7 @@ void TransferTrajectory::getLegTotalParameters(
 
 void TransferTrajectory::getNodeTotalParameters(
         const std::vector< double >& nodeTimes,
-        const Eigen::VectorXd& nodeFreeParameters,
+        const Eigen::Ref< const Eigen::VectorXd >& nodeFreeParameters,
         const int nodeIndex,
         Eigen::VectorXd& nodeTotalParameters )
 {
@@ -225,6 +344,27 @@ void TransferTrajectory::getNodeTotalParameters(
     }
 }
 
+void evaluateTransferTrajectoryPopulation(
+        const std::vector< std::shared_ptr< TransferTrajectory > >& transferTrajectoriesPerThread,
+        const Eigen::Ref< const Eigen::MatrixXd >& trajectoryParameters,
+        Eigen::VectorXd& totalDeltaV )
+{
+    if( transferTrajectoriesPerThread.size( ) == 0 )
+    {
+        throw std::runtime_error( "Error when evaluating population of transfer trajectories, no trajectory objects provided" );
+    }
+
+    totalDeltaV.resize( trajectoryParameters.cols( ) );
+    utilities::executeTasksInParallel(
+                trajectoryParameters.cols( ), transferTrajectoriesPerThread.size( ),
+                [ & ]( const unsigned int individualIndex, const unsigned int threadIndex )
+    {
+        const std::shared_ptr< TransferTrajectory >& transferTrajectory = transferTrajectoriesPerThread.at( threadIndex );
+        transferTrajectory->evaluateTrajectory( trajectoryParameters.col( individualIndex ) );
+        totalDeltaV( individualIndex ) = transferTrajectory->getTotalDeltaV( );
+    } );
+}
+
 } // namespace mission_segments
 
 } // namespace tudat
@@ -0,0 +1,48 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include "tudat/astro/orbit_determination/acceleration_partials/customAccelerationPartial.h"
+
+namespace tudat
+{
+
+namespace acceleration_partials
+{
+
+//! Constructor
+CustomAccelerationPartial::CustomAccelerationPartial(
+        const std::shared_ptr< basic_astrodynamics::CustomAccelerationModel > customAcceleration,
+        const std::string acceleratedBody,
+        const std::string acceleratingBody ):
+    AccelerationPartial( acceleratedBody, acceleratingBody, basic_astrodynamics::custom_acceleration ),
+    customAcceleration_( customAcceleration )
+{
+    if( !customAcceleration_->isAccelerationDifferentiable( ) )
+    {
+        throw std::runtime_error( "Error when creating custom acceleration partial for " + acceleratedBody +
+                                  ", acceleration function is not differentiable" );
+    }
+    currentAccelerationStatePartials_.setZero( );
+}
+
+//! Function for updating partial w.r.t. the bodies' states
+void CustomAccelerationPartial::update( const double currentTime )
+{
+    if( !( currentTime_ == currentTime ) )
+    {
+        customAcceleration_->updateMembers( currentTime );
+        customAcceleration_->computeAccelerationStatePartial( currentAccelerationStatePartials_ );
+        currentTime_ = currentTime;
+    }
+}
+
+} // namespace acceleration_partials
+
+} // namespace tudat
@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <stdexcept>
 #include "tudat/astro/propagators/environmentUpdateTypes.h"
 
 namespace tudat
@@ -60,6 +61,37 @@ void addEnvironmentUpdates( std::map< propagators::EnvironmentModelsToUpdate,
     }
 }
 
+//! Function to get a string representing a 'named identification' of an environment update type
+std::string getEnvironmentModelToUpdateName( const EnvironmentModelsToUpdate environmentModelToUpdate )
+{
+    std::string updateName;
+    switch( environmentModelToUpdate )
+    {
+    case body_translational_state_update:
+        updateName = "body_translational_state_update";
+        break;
+    case body_rotational_state_update:
+        updateName = "body_rotational_state_update";
+        break;
+    case body_mass_update:
+        updateName = "body_mass_update";
+        break;
+    case spherical_harmonic_gravity_field_update:
+        updateName = "spherical_harmonic_gravity_field_update";
+        break;
+    case vehicle_flight_conditions_update:
+        updateName = "vehicle_flight_conditions_update";
+        break;
+    case radiation_pressure_interface_update:
+        updateName = "radiation_pressure_interface_update";
+        break;
+    default:
+        throw std::runtime_error( "Error, did not recognize environment update type " +
+                                  std::to_string( environmentModelToUpdate ) + " when getting name" );
+    }
+    return updateName;
+}
+
 
 }
 
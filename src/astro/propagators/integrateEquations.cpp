@@ -18,7 +18,10 @@ Eigen::MatrixXd, double, double >(
         const std::function< void( Eigen::MatrixXd& ) > statePostProcessingFunction,
         const int saveFrequency,
         const double printInterval,
-        const std::chrono::steady_clock::time_point initialClockTime );
+        const std::chrono::steady_clock::time_point initialClockTime,
+        const double denseOutputInterval,
+        const std::shared_ptr< PropagationEventDetector > eventDetector,
+        const std::function< void( const double ) > stepCompletionFunction );
 
 template std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrator<
 Eigen::VectorXd, double, double >(
@@ -32,7 +35,10 @@ Eigen::VectorXd, double, double >(
         const std::function< void( Eigen::VectorXd& ) > statePostProcessingFunction,
         const int saveFrequency,
         const double printInterval,
-        const std::chrono::steady_clock::time_point initialClockTime );
+        const std::chrono::steady_clock::time_point initialClockTime,
+        const double denseOutputInterval,
+        const std::shared_ptr< PropagationEventDetector > eventDetector,
+        const std::function< void( const double ) > stepCompletionFunction );
 
 } // namespace propagators
 
@@ -77,6 +77,14 @@ std::vector< std::function< double( ) > > removeCentralGravityAccelerations(
                             " on " + bodiesToIntegrate.at( i ) + ",) not yet supported";
                     throw std::runtime_error( errorMessage );
                 }
+                else if( currentAccelerationType == many_body_point_mass_gravity )
+                {
+                    std::string errorMessage =
+                            "Error when removing central body point gravity term, removal of many-body point mass gravity (of " +
+                            centralBodies.at( i ) +
+                            " on " + bodiesToIntegrate.at( i ) + ",) not yet supported";
+                    throw std::runtime_error( errorMessage );
+                }
             }
 
             // If no or multiple central acceleration candidates were found, give error.
@@ -89,6 +89,35 @@ int getGeneralizedAccelerationSize( const IntegratedStateType stateType )
     return accelerationSize;
 }
 
+//! Function to get a string representing a 'named identification' of a state type
+std::string getIntegratedStateTypeName( const IntegratedStateType stateType )
+{
+    std::string stateTypeName;
+    switch( stateType )
+    {
+    case hybrid:
+        stateTypeName = "hybrid";
+        break;
+    case translational_state:
+        stateTypeName = "translational_state";
+        break;
+    case rotational_state:
+        stateTypeName = "rotational_state";
+        break;
+    case body_mass_state:
+        stateTypeName = "body_mass_state";
+        break;
+    case custom_state:
+        stateTypeName = "custom_state";
+        break;
+    default:
+        std::string errorMessage =
+                "Did not recognize state type " + std::to_string( stateType ) + "when getting name";
+       throw std::runtime_error( errorMessage );
+    }
+    return stateTypeName;
+}
+
 
 template class SingleStateTypeDerivative< double, double >;
 
@@ -28,14 +28,37 @@ namespace propagators
 
 template< typename StateScalarType >
 void VariationalEquations::getBodyInitialStatePartialMatrix(
-        const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic >& stateTransitionAndSensitivityMatrices,
+        const Eigen::Ref< const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > >
+        stateTransitionAndSensitivityMatrices,
         Eigen::Block< Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > > currentMatrixDerivative )
 {
     setBodyStatePartialMatrix( );
 
-    // Add partials of body positions and velocities.
-    currentMatrixDerivative.block( 0, 0, totalDynamicalStateSize_, numberOfParameterValues_ ) =
-            ( variationalMatrix_.template cast< StateScalarType >( ) * stateTransitionAndSensitivityMatrices );
+    // Add partials of body positions and velocities: copy rows for identity row blocks
+    for( unsigned int i = 0; i < identityRowBlocks_.size( ); i++ )
+    {
+        currentMatrixDerivative.block( identityRowBlocks_[ i ][ 0 ], 0, identityRowBlocks_[ i ][ 2 ], numberOfParameterValues_ ) =
+                stateTransitionAndSensitivityMatrices.block(
+                    identityRowBlocks_[ i ][ 1 ], 0, identityRowBlocks_[ i ][ 2 ], numberOfParameterValues_ );
+    }
+
+    // Add partials of body positions and velocities: multiply potentially non-zero blocks of variational matrix
+    for( unsigned int i = 0; i < sparseRowBlocks_.size( ); i++ )
+    {
+        int startRow = sparseRowBlocks_[ i ].first.first;
+        int numberOfRows = sparseRowBlocks_[ i ].first.second;
+        currentMatrixDerivative.block( startRow, 0, numberOfRows, numberOfParameterValues_ ).setZero( );
+
+        const std::vector< std::pair< int, int > >& columnRanges = sparseRowBlocks_[ i ].second;
+        for( unsigned int j = 0; j < columnRanges.size( ); j++ )
+        {
+            currentMatrixDerivative.block( startRow, 0, numberOfRows, numberOfParameterValues_ ).noalias( ) +=
+                    variationalMatrix_.block( startRow, columnRanges[ j ].first, numberOfRows, columnRanges[ j ].second ).
+                    template cast< StateScalarType >( ) *
+                    stateTransitionAndSensitivityMatrices.block(
+                        columnRanges[ j ].first, 0, columnRanges[ j ].second, numberOfParameterValues_ );
+        }
+    }
 
     if( couplingEntriesToSuppress_ > 0 )
     {
@@ -54,8 +77,15 @@ void VariationalEquations::getBodyInitialStatePartialMatrix(
 //! Calculates matrix containing partial derivatives of state derivatives w.r.t. body state.
 void VariationalEquations::setBodyStatePartialMatrix( )
 {
-    // Initialize partial matrix
-    variationalMatrix_.setZero( );
+    // Initialize potentially non-zero entries of partial matrix (other entries are always zero)
+    for( unsigned int i = 0; i < sparseRowBlocks_.size( ); i++ )
+    {
+        for( unsigned int j = 0; j < sparseRowBlocks_[ i ].second.size( ); j++ )
+        {
+            variationalMatrix_.block( sparseRowBlocks_[ i ].first.first, sparseRowBlocks_[ i ].second[ j ].first,
+                                      sparseRowBlocks_[ i ].first.second, sparseRowBlocks_[ i ].second[ j ].second ).setZero( );
+        }
+    }
 
     if( dynamicalStatesToEstimate_.count( propagators::translational_state ) > 0 )
     {
@@ -68,7 +98,7 @@ void VariationalEquations::setBodyStatePartialMatrix( )
 
     if( dynamicalStatesToEstimate_.count( propagators::rotational_state ) > 0 )
     {
-        Eigen::VectorXd rotationalStates = currentStatesPerTypeInConventionalRepresentation_.at(
+        const Eigen::VectorXd& rotationalStates = currentStatesPerTypeInConventionalRepresentation_.at(
                     propagators::rotational_state );
 
         int startIndex = stateTypeStartIndices_.at( propagators::rotational_state );
@@ -81,29 +111,12 @@ void VariationalEquations::setBodyStatePartialMatrix( )
         }
     }
 
-    // Iterate over all bodies undergoing accelerations for which initial condition is to be estimated.
-    for( std::map< IntegratedStateType, std::vector< std::multimap< std::pair< int, int >,
-         std::function< void( Eigen::Block< Eigen::MatrixXd > ) > > > >::iterator
-         typeIterator = statePartialList_.begin( ); typeIterator != statePartialList_.end( ); typeIterator++ )
+    // Add partials w.r.t. current states, as determined by setStatePartialFunctionList( )
+    for( unsigned int i = 0; i < statePartialFunctionList_.size( ); i++ )
     {
-        int startIndex = stateTypeStartIndices_.at( typeIterator->first );
-        int currentStateSize = getSingleIntegrationSize( typeIterator->first );
-        int entriesToSkipPerEntry = currentStateSize - getGeneralizedAccelerationSize( typeIterator->first );
-
-        for( unsigned int i = 0; i < typeIterator->second.size( ); i++ )
-        {
-            // Iterate over all bodies exerting an acceleration on this body.
-            for( statePartialIterator_ = typeIterator->second.at( i ).begin( );
-                 statePartialIterator_ != typeIterator->second.at( i ).end( );
-                 statePartialIterator_++ )
-            {
-                statePartialIterator_->second(
-                            variationalMatrix_.block(
-                                startIndex + entriesToSkipPerEntry + i* currentStateSize, statePartialIterator_->first.first,
-                                currentStateSize - entriesToSkipPerEntry, statePartialIterator_->first.second ) );
-
-            }
-        }
+        const std::array< int, 4 >& blockIndices = statePartialFunctionList_[ i ].first;
+        statePartialFunctionList_[ i ].second(
+                    variationalMatrix_.block( blockIndices[ 0 ], blockIndices[ 1 ], blockIndices[ 2 ], blockIndices[ 3 ] ) );
     }
 
     for( unsigned int i = 0; i < statePartialAdditionIndices_.size( ); i++ )
@@ -114,9 +127,11 @@ void VariationalEquations::setBodyStatePartialMatrix( )
 
     for( unsigned int i = 0; i < inertiaTensorsForMultiplication_.size( ); i++ )
     {
-        variationalMatrix_.block( inertiaTensorsForMultiplication_.at( i ).first, 0, 3, totalDynamicalStateSize_ ) =
+        scaledStatePartials_.noalias( ) =
                 ( inertiaTensorsForMultiplication_.at( i ).second( ).inverse( ) ) *
-                variationalMatrix_.block( inertiaTensorsForMultiplication_.at( i ).first, 0, 3, totalDynamicalStateSize_ ).eval( );
+                variationalMatrix_.block( inertiaTensorsForMultiplication_.at( i ).first, 0, 3, totalDynamicalStateSize_ );
+        variationalMatrix_.block( inertiaTensorsForMultiplication_.at( i ).first, 0, 3, totalDynamicalStateSize_ ) =
+                scaledStatePartials_;
     }
 
 }
@@ -139,7 +154,7 @@ void VariationalEquations::clearPartials( )
     }
 }
 
-//! Function (called by constructor) to set up the statePartialList_ member from the state derivative partials
+//! Function (called by constructor) to set up the statePartialFunctionList_ member from the state derivative partials
 void VariationalEquations::setStatePartialFunctionList( )
 {
     std::pair< std::function< void( Eigen::Block< Eigen::MatrixXd > ) >, int > currentDerivativeFunction;
@@ -152,6 +167,10 @@ void VariationalEquations::setStatePartialFunctionList( )
          stateDerivativeTypeIterator_ != stateDerivativePartialList_.end( );
          stateDerivativeTypeIterator_++ )
     {
+        int startIndex = stateTypeStartIndices_.at( stateDerivativeTypeIterator_->first );
+        int currentStateSize = getSingleIntegrationSize( stateDerivativeTypeIterator_->first );
+        int entriesToSkipPerEntry = currentStateSize - getGeneralizedAccelerationSize( stateDerivativeTypeIterator_->first );
+
         // Iterate over all bodies undergoing 'accelerations' for which initial state is to be estimated.
         for( unsigned int i = 0; i < stateDerivativeTypeIterator_->second.size( ); i++ )
         {
@@ -187,19 +206,147 @@ void VariationalEquations::setStatePartialFunctionList( )
                     }
                 }
             }
-            statePartialList_[ stateDerivativeTypeIterator_->first ].push_back( currentBodyPartialList );
+
+            // Add partial functions of current body (sorted by column) to list, with block of variational matrix to
+            // which they are to be added.
+            for( auto partialIterator = currentBodyPartialList.begin( ); partialIterator != currentBodyPartialList.end( );
+                 partialIterator++ )
+            {
+                statePartialFunctionList_.push_back(
+                            std::make_pair( std::array< int, 4 >(
+                            { startIndex + entriesToSkipPerEntry + static_cast< int >( i ) * currentStateSize,
+                              partialIterator->first.first,
+                              currentStateSize - entriesToSkipPerEntry, partialIterator->first.second } ),
+                                            partialIterator->second ) );
+            }
         }
     }
 }
 
+//! Function (called by constructor) to determine the sparsity structure of the variational matrix.
+void VariationalEquations::setVariationalMatrixSparsity( )
+{
+    // Determine potentially non-zero entries of variational matrix, with identity blocks of translational state separately
+    Eigen::MatrixXi identityEntries = Eigen::MatrixXi::Zero( totalDynamicalStateSize_, totalDynamicalStateSize_ );
+    Eigen::MatrixXi nonIdentityEntries = Eigen::MatrixXi::Zero( totalDynamicalStateSize_, totalDynamicalStateSize_ );
+
+    if( dynamicalStatesToEstimate_.count( propagators::translational_state ) > 0 )
+    {
+        int startIndex = stateTypeStartIndices_.at( propagators::translational_state );
+        for( unsigned int i = 0; i < dynamicalStatesToEstimate_.at( propagators::translational_state ).size( ); i++ )
+        {
+            identityEntries.block( startIndex + i * 6, startIndex + i * 6 + 3, 3, 3 ).setIdentity( );
+        }
+    }
+
+    if( dynamicalStatesToEstimate_.count( propagators::rotational_state ) > 0 )
+    {
+        int startIndex = stateTypeStartIndices_.at( propagators::rotational_state );
+        for( unsigned int i = 0; i < dynamicalStatesToEstimate_.at( propagators::rotational_state ).size( ); i++ )
+        {
+            nonIdentityEntries.block( startIndex + i * 7, startIndex + i * 7, 4, 7 ).setOnes( );
+        }
+    }
+
+    for( unsigned int i = 0; i < statePartialFunctionList_.size( ); i++ )
+    {
+        const std::array< int, 4 >& blockIndices = statePartialFunctionList_[ i ].first;
+        nonIdentityEntries.block( blockIndices[ 0 ], blockIndices[ 1 ], blockIndices[ 2 ], blockIndices[ 3 ] ).setOnes( );
+    }
+
+    // Add entries filled by frame scaling and inertia tensor scaling (in same order as in setBodyStatePartialMatrix)
+    for( unsigned int i = 0; i < statePartialAdditionIndices_.size( ); i++ )
+    {
+        nonIdentityEntries.block( 0, statePartialAdditionIndices_.at( i ).second, totalDynamicalStateSize_, 3 ) =
+                nonIdentityEntries.block( 0, statePartialAdditionIndices_.at( i ).second, totalDynamicalStateSize_, 3 ).cwiseMax(
+                    nonIdentityEntries.block( 0, statePartialAdditionIndices_.at( i ).first, totalDynamicalStateSize_, 3 ).cwiseMax(
+                        identityEntries.block( 0, statePartialAdditionIndices_.at( i ).first, totalDynamicalStateSize_, 3 ) ) );
+    }
+
+    for( unsigned int i = 0; i < inertiaTensorsForMultiplication_.size( ); i++ )
+    {
+        int startRow = inertiaTensorsForMultiplication_.at( i ).first;
+        Eigen::RowVectorXi scaledEntries =
+                nonIdentityEntries.block( startRow, 0, 3, totalDynamicalStateSize_ ).cwiseMax(
+                    identityEntries.block( startRow, 0, 3, totalDynamicalStateSize_ ) ).colwise( ).maxCoeff( );
+        nonIdentityEntries.block( startRow, 0, 3, totalDynamicalStateSize_ ) = scaledEntries.replicate( 3, 1 );
+    }
+
+    Eigen::MatrixXi nonZeroEntries = identityEntries.cwiseMax( nonIdentityEntries );
+
+    // Determine which rows are rows of the identity matrix (-1 if not)
+    std::vector< int > identityColumns( totalDynamicalStateSize_, -1 );
+    for( int i = 0; i < totalDynamicalStateSize_; i++ )
+    {
+        if( nonIdentityEntries.row( i ).maxCoeff( ) == 0 && identityEntries.row( i ).sum( ) == 1 )
+        {
+            Eigen::Index identityColumn;
+            identityEntries.row( i ).maxCoeff( &identityColumn );
+            identityColumns[ i ] = static_cast< int >( identityColumn );
+        }
+    }
+
+    // Divide rows into blocks of identity rows, and blocks of rows with equal sparsity
+    identityRowBlocks_.clear( );
+    sparseRowBlocks_.clear( );
+    int blockStartRow = 0;
+    for( int i = 1; i <= totalDynamicalStateSize_; i++ )
+    {
+        bool isBlockEnd = ( i == totalDynamicalStateSize_ );
+        if( !isBlockEnd )
+        {
+            if( identityColumns[ blockStartRow ] >= 0 )
+            {
+                isBlockEnd = ( identityColumns[ i ] != identityColumns[ blockStartRow ] + ( i - blockStartRow ) );
+            }
+            else
+            {
+                isBlockEnd = ( identityColumns[ i ] >= 0 || nonZeroEntries.row( i ) != nonZeroEntries.row( blockStartRow ) );
+            }
+        }
+
+        if( isBlockEnd )
+        {
+            if( identityColumns[ blockStartRow ] >= 0 )
+            {
+                identityRowBlocks_.push_back( { { blockStartRow, identityColumns[ blockStartRow ], i - blockStartRow } } );
+            }
+            else
+            {
+                // Find ranges of consecutive non-zero columns
+                std::vector< std::pair< int, int > > columnRanges;
+                int j = 0;
+                while( j < totalDynamicalStateSize_ )
+                {
+                    if( nonZeroEntries( blockStartRow, j ) != 0 )
+                    {
+                        int rangeStart = j;
+                        while( j < totalDynamicalStateSize_ && nonZeroEntries( blockStartRow, j ) != 0 )
+                        {
+                            j++;
+                        }
+                        columnRanges.push_back( std::make_pair( rangeStart, j - rangeStart ) );
+                    }
+                    else
+                    {
+                        j++;
+                    }
+                }
+                sparseRowBlocks_.push_back(
+                            std::make_pair( std::make_pair( blockStartRow, i - blockStartRow ), columnRanges ) );
+            }
+            blockStartRow = i;
+        }
+    }
+}
 
 template void VariationalEquations::getBodyInitialStatePartialMatrix< double >(
-const Eigen::Matrix< double, Eigen::Dynamic, Eigen::Dynamic >& stateTransitionAndSensitivityMatrices,
+const Eigen::Ref< const Eigen::Matrix< double, Eigen::Dynamic, Eigen::Dynamic > > stateTransitionAndSensitivityMatrices,
 Eigen::Block< Eigen::Matrix< double, Eigen::Dynamic, Eigen::Dynamic > > currentMatrixDerivative );
 
 //#if( TUDAT_BUILD_WITH_EXTENDED_PRECISION_PROPAGATION_TOOLS )
 template void VariationalEquations::getBodyInitialStatePartialMatrix< long double >(
-const Eigen::Matrix< long double, Eigen::Dynamic, Eigen::Dynamic >& stateTransitionAndSensitivityMatrices,
+const Eigen::Ref< const Eigen::Matrix< long double, Eigen::Dynamic, Eigen::Dynamic > > stateTransitionAndSensitivityMatrices,
 Eigen::Block< Eigen::Matrix< long double, Eigen::Dynamic, Eigen::Dynamic > > currentMatrixDerivative );
 //#endif
 
@@ -0,0 +1,107 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+#include "tudat/basics/propagationProfiler.h"
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Function to register a scope that is to be timed
+int PropagationProfiler::addScope( const std::string& scopeName, const int parentScopeIndex )
+{
+    if( parentScopeIndex >= getNumberOfScopes( ) )
+    {
+        throw std::runtime_error( "Error when adding profiling scope " + scopeName + ", parent scope does not exist." );
+    }
+
+    // Remove characters with special meaning in folded stack format
+    std::string scopeNameToUse = scopeName;
+    std::replace( scopeNameToUse.begin( ), scopeNameToUse.end( ), ';', '_' );
+    std::replace( scopeNameToUse.begin( ), scopeNameToUse.end( ), ' ', '_' );
+
+    std::string scopePath = ( parentScopeIndex < 0 ) ?
+                scopeNameToUse : ( scopePaths_.at( parentScopeIndex ) + ";" + scopeNameToUse );
+
+    // Return existing scope, if any
+    std::vector< std::string >::iterator scopeIterator =
+            std::find( scopePaths_.begin( ), scopePaths_.end( ), scopePath );
+    if( scopeIterator != scopePaths_.end( ) )
+    {
+        return static_cast< int >( std::distance( scopePaths_.begin( ), scopeIterator ) );
+    }
+
+    scopePaths_.push_back( scopePath );
+    parentScopeIndices_.push_back( parentScopeIndex );
+    numberOfCalls_.push_back( 0 );
+    totalWallTimes_.push_back( 0.0 );
+    return getNumberOfScopes( ) - 1;
+}
+
+//! Function to reset the number of calls and wall-clock times of all scopes to zero
+void PropagationProfiler::resetStatistics( )
+{
+    std::fill( numberOfCalls_.begin( ), numberOfCalls_.end( ), 0 );
+    std::fill( totalWallTimes_.begin( ), totalWallTimes_.end( ), 0.0 );
+}
+
+//! Function to retrieve the number of calls and total wall-clock time of all scopes
+std::map< std::string, std::pair< unsigned long, double > > PropagationProfiler::getProfilingResults( ) const
+{
+    std::map< std::string, std::pair< unsigned long, double > > profilingResults;
+    for( unsigned int i = 0; i < scopePaths_.size( ); i++ )
+    {
+        profilingResults[ scopePaths_.at( i ) ] = std::make_pair( numberOfCalls_.at( i ), totalWallTimes_.at( i ) );
+    }
+    return profilingResults;
+}
+
+//! Function to write the profiling results as folded stacks
+void PropagationProfiler::writeFoldedStacks( std::ostream& outputStream ) const
+{
+    // Compute time spent in each scope, excluding directly nested scopes
+    std::vector< double > selfWallTimes = totalWallTimes_;
+    for( unsigned int i = 0; i < scopePaths_.size( ); i++ )
+    {
+        if( parentScopeIndices_.at( i ) >= 0 )
+        {
+            selfWallTimes.at( parentScopeIndices_.at( i ) ) -= totalWallTimes_.at( i );
+        }
+    }
+
+    for( unsigned int i = 0; i < scopePaths_.size( ); i++ )
+    {
+        long selfWallTimeInMicroseconds = std::max( 0L, std::lround( selfWallTimes.at( i ) * 1.0E6 ) );
+        outputStream << scopePaths_.at( i ) << " " << selfWallTimeInMicroseconds << std::endl;
+    }
+}
+
+//! Function to write the profiling results as folded stacks to a file
+void PropagationProfiler::writeFoldedStacks( const std::string& fileName ) const
+{
+    std::ofstream outputFile( fileName.c_str( ) );
+    if( !outputFile.good( ) )
+    {
+        throw std::runtime_error( "Error when writing profiling results, could not open file " + fileName );
+    }
+    writeFoldedStacks( outputFile );
+}
+
+} // namespace utilities
+
+} // namespace tudat
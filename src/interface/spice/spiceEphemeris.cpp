@@ -92,5 +92,29 @@ Eigen::Vector6d SpiceEphemeris::getCartesianState(
     return cartesianStateAtEpoch;
 }
 
+//! Get Cartesian states from ephemeris at a list of times.
+void SpiceEphemeris::getCartesianStates( const std::vector< double >& times,
+                                         Eigen::Matrix< double, 6, Eigen::Dynamic >& states )
+{
+    // Calculate ephemeris times at which cartesian states are to be determined.
+    if( referenceDayOffSet_ == 0.0 )
+    {
+        spice_interface::getBodyCartesianStatesAtEpochs(
+                    targetBodyName_, referenceFrameOrigin_, referenceFrameOrientation_,
+                    aberrationCorrections_, times, states );
+    }
+    else
+    {
+        std::vector< double > ephemerisTimes( times.size( ) );
+        for( unsigned int i = 0; i < times.size( ); i++ )
+        {
+            ephemerisTimes[ i ] = times[ i ] + referenceDayOffSet_;
+        }
+        spice_interface::getBodyCartesianStatesAtEpochs(
+                    targetBodyName_, referenceFrameOrigin_, referenceFrameOrientation_,
+                    aberrationCorrections_, ephemerisTimes, states );
+    }
+}
+
 } // namespace ephemerides
 } // namespace tudat
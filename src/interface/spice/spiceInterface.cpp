@@ -68,6 +68,37 @@ Vector6d getBodyCartesianStateAtEpoch(
                 cartesianStateVector);
 }
 
+//! Get Cartesian states of a body at a list of epochs, as observed from another body.
+void getBodyCartesianStatesAtEpochs(
+        const std::string &targetBodyName, const std::string &observerBodyName,
+        const std::string &referenceFrameName, const std::string &aberrationCorrections,
+        const std::vector< double > &ephemerisTimes, Eigen::Matrix< double, 6, Eigen::Dynamic > &states) {
+
+    for (unsigned int i = 0; i < ephemerisTimes.size(); i++) {
+        if( !( ephemerisTimes[i] == ephemerisTimes[i] )  )
+        {
+            throw std::invalid_argument( "Error when retrieving Cartesian states from Spice, input time is " +
+                                         std::to_string(ephemerisTimes[i]) );
+        }
+    }
+
+    // Call Spice function to calculate state for each epoch, writing directly into the (column-major) output buffer.
+    states.resize(6, ephemerisTimes.size());
+    const char* targetBodyNameString = targetBodyName.c_str();
+    const char* observerBodyNameString = observerBodyName.c_str();
+    const char* referenceFrameNameString = referenceFrameName.c_str();
+    const char* aberrationCorrectionsString = aberrationCorrections.c_str();
+    double lightTime;
+    for (unsigned int i = 0; i < ephemerisTimes.size(); i++) {
+        spkezr_c(targetBodyNameString, ephemerisTimes[i], referenceFrameNameString,
+                 aberrationCorrectionsString, observerBodyNameString, states.col(i).data(),
+                 &lightTime);
+    }
+
+    // Convert from km(/s) to m(/s).
+    states *= 1000.0;
+}
+
 //! Get Cartesian position of a body, as observed from another body.
 Eigen::Vector3d getBodyCartesianPositionAtEpoch(const std::string &targetBodyName,
                                                 const std::string &observerBodyName,
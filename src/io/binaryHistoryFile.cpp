@@ -0,0 +1,348 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <boost/filesystem.hpp>
+
+#include "tudat/io/binaryHistoryFile.h"
+
+namespace tudat
+{
+
+namespace input_output
+{
+
+//! Identifier at the start of each binary history file
+static const char BINARY_HISTORY_FILE_IDENTIFIER[ 8 ] = { 'T', 'U', 'D', 'A', 'T', 'B', 'H', 'F' };
+
+//! Version of the binary history file format
+static const std::uint32_t BINARY_HISTORY_FILE_VERSION = 1;
+
+//! Value written to the header to detect files written on platforms with different byte order
+static const std::uint32_t BINARY_HISTORY_BYTE_ORDER_MARK = 0x01020304;
+
+//! Alignment (in bytes) of the start of the first record in a binary history file
+static const std::uint64_t BINARY_HISTORY_DATA_ALIGNMENT = 64;
+
+//! Function to retrieve the identifier of double type in a binary history file
+template< >
+BinaryHistoryDataType getBinaryHistoryDataType< double >( )
+{
+    return double_history_data;
+}
+
+//! Function to retrieve the identifier of long double type in a binary history file
+template< >
+BinaryHistoryDataType getBinaryHistoryDataType< long double >( )
+{
+    return long_double_history_data;
+}
+
+//! Function to retrieve the identifier of Time type in a binary history file
+template< >
+BinaryHistoryDataType getBinaryHistoryDataType< Time >( )
+{
+    return tudat_time_history_data;
+}
+
+//! Function to retrieve the name of a time or value type in a binary history file (for error messages)
+std::string getBinaryHistoryDataTypeName( const BinaryHistoryDataType dataType )
+{
+    switch( dataType )
+    {
+    case double_history_data:
+        return "double";
+    case long_double_history_data:
+        return "long double";
+    case tudat_time_history_data:
+        return "Time";
+    default:
+        throw std::runtime_error( "Error, binary history data type " + std::to_string( dataType ) + " not recognized" );
+    }
+}
+
+//! Function to retrieve the number of bytes used to store a single time or value entry in a binary history file
+unsigned int getBinaryHistoryDataTypeSize( const BinaryHistoryDataType dataType )
+{
+    switch( dataType )
+    {
+    case double_history_data:
+        return sizeof( double );
+    case long_double_history_data:
+        return sizeof( long double );
+    case tudat_time_history_data:
+        return sizeof( std::int64_t ) + sizeof( long double );
+    default:
+        throw std::runtime_error( "Error, binary history data type " + std::to_string( dataType ) + " not recognized" );
+    }
+}
+
+//! Function to round a size up to a multiple of a given alignment
+std::uint64_t roundUpToAlignment( const std::uint64_t size, const std::uint64_t alignment )
+{
+    return ( ( size + alignment - 1 ) / alignment ) * alignment;
+}
+
+//! Function to compute the size (in bytes) of a length-prefixed string in the header of a binary history file
+std::uint64_t getHeaderStringSize( const std::string& headerString )
+{
+    return sizeof( std::uint32_t ) + headerString.size( );
+}
+
+//! Constructor
+BinaryHistoryFileHeader::BinaryHistoryFileHeader( const BinaryHistoryDataType timeDataType,
+                                                  const BinaryHistoryDataType valueDataType,
+                                                  const unsigned int numberOfColumns,
+                                                  const std::vector< std::string >& columnNames,
+                                                  const std::vector< std::string >& columnUnits ):
+    timeDataType( timeDataType ), valueDataType( valueDataType ), numberOfColumns( numberOfColumns ),
+    columnNames( columnNames ), columnUnits( columnUnits )
+{
+    if( valueDataType == tudat_time_history_data )
+    {
+        throw std::runtime_error( "Error when creating binary history file header, Time is not supported as value type" );
+    }
+
+    if( numberOfColumns == 0 )
+    {
+        throw std::runtime_error( "Error when creating binary history file header, number of columns must be non-zero" );
+    }
+
+    if( this->columnNames.size( ) == 0 )
+    {
+        this->columnNames.resize( numberOfColumns );
+    }
+    else if( this->columnNames.size( ) != numberOfColumns )
+    {
+        throw std::runtime_error( "Error when creating binary history file header, number of column names (" +
+                                  std::to_string( this->columnNames.size( ) ) + ") is inconsistent with number of columns (" +
+                                  std::to_string( numberOfColumns ) + ")" );
+    }
+
+    if( this->columnUnits.size( ) == 0 )
+    {
+        this->columnUnits.resize( numberOfColumns );
+    }
+    else if( this->columnUnits.size( ) != numberOfColumns )
+    {
+        throw std::runtime_error( "Error when creating binary history file header, number of column units (" +
+                                  std::to_string( this->columnUnits.size( ) ) + ") is inconsistent with number of columns (" +
+                                  std::to_string( numberOfColumns ) + ")" );
+    }
+
+    // Determine layout of records, such that the time and all values are aligned to their size, as is every record
+    std::uint64_t valueSize = getBinaryHistoryDataTypeSize( valueDataType );
+    std::uint64_t recordAlignment = std::max(
+                valueSize, static_cast< std::uint64_t >( timeDataType == double_history_data ?
+                                                             sizeof( double ) : sizeof( long double ) ) );
+    valueOffset = roundUpToAlignment( getBinaryHistoryDataTypeSize( timeDataType ), valueSize );
+    recordSize = roundUpToAlignment( valueOffset + numberOfColumns * valueSize, recordAlignment );
+
+    // Determine size of header
+    std::uint64_t headerSize = sizeof( BINARY_HISTORY_FILE_IDENTIFIER ) + 6 * sizeof( std::uint32_t ) +
+            3 * sizeof( std::uint64_t );
+    for( unsigned int i = 0; i < numberOfColumns; i++ )
+    {
+        headerSize += getHeaderStringSize( this->columnNames.at( i ) ) + getHeaderStringSize( this->columnUnits.at( i ) );
+    }
+    dataOffset = roundUpToAlignment( headerSize, BINARY_HISTORY_DATA_ALIGNMENT );
+}
+
+//! Function to write a single entry of the header of a binary history file
+template< typename EntryType >
+void writeHeaderEntry( std::ostream& fileStream, const EntryType entry )
+{
+    fileStream.write( reinterpret_cast< const char* >( &entry ), sizeof( EntryType ) );
+}
+
+//! Function to write a length-prefixed string to the header of a binary history file
+void writeHeaderString( std::ostream& fileStream, const std::string& headerString )
+{
+    writeHeaderEntry( fileStream, static_cast< std::uint32_t >( headerString.size( ) ) );
+    fileStream.write( headerString.data( ), headerString.size( ) );
+}
+
+//! Function to write the header of a binary history file to a stream
+void writeBinaryHistoryFileHeader( std::ostream& fileStream, const BinaryHistoryFileHeader& header )
+{
+    std::streampos headerStart = fileStream.tellp( );
+
+    fileStream.write( BINARY_HISTORY_FILE_IDENTIFIER, sizeof( BINARY_HISTORY_FILE_IDENTIFIER ) );
+    writeHeaderEntry( fileStream, BINARY_HISTORY_FILE_VERSION );
+    writeHeaderEntry( fileStream, BINARY_HISTORY_BYTE_ORDER_MARK );
+    writeHeaderEntry( fileStream, static_cast< std::uint32_t >( sizeof( long double ) ) );
+    writeHeaderEntry( fileStream, static_cast< std::uint32_t >( header.timeDataType ) );
+    writeHeaderEntry( fileStream, static_cast< std::uint32_t >( header.valueDataType ) );
+    writeHeaderEntry( fileStream, static_cast< std::uint32_t >( header.numberOfColumns ) );
+    writeHeaderEntry( fileStream, header.dataOffset );
+    writeHeaderEntry( fileStream, header.recordSize );
+    writeHeaderEntry( fileStream, header.valueOffset );
+    for( unsigned int i = 0; i < header.numberOfColumns; i++ )
+    {
+        writeHeaderString( fileStream, header.columnNames.at( i ) );
+        writeHeaderString( fileStream, header.columnUnits.at( i ) );
+    }
+
+    // Pad header with zeros up to start of first record
+    std::uint64_t headerSize = static_cast< std::uint64_t >( fileStream.tellp( ) - headerStart );
+    std::vector< char > padding( header.dataOffset - headerSize, 0 );
+    fileStream.write( padding.data( ), padding.size( ) );
+
+    if( !fileStream )
+    {
+        throw std::runtime_error( "Error when writing binary history file header" );
+    }
+}
+
+//! Class to sequentially read entries from the header of a binary history file, with checks on the size of the file
+class BinaryHistoryHeaderParser
+{
+public:
+
+    BinaryHistoryHeaderParser( const char* fileData, const std::uint64_t fileSize, const std::string& fileName ):
+        fileData_( fileData ), fileSize_( fileSize ), fileName_( fileName ), currentPosition_( 0 ){ }
+
+    void readBytes( void* destination, const std::uint64_t numberOfBytes )
+    {
+        if( currentPosition_ + numberOfBytes > fileSize_ )
+        {
+            throw std::runtime_error( "Error when reading binary history file " + fileName_ + ", header is incomplete" );
+        }
+        std::memcpy( destination, fileData_ + currentPosition_, numberOfBytes );
+        currentPosition_ += numberOfBytes;
+    }
+
+    template< typename EntryType >
+    EntryType readEntry( )
+    {
+        EntryType entry;
+        readBytes( &entry, sizeof( EntryType ) );
+        return entry;
+    }
+
+    std::string readString( )
+    {
+        std::uint32_t stringSize = readEntry< std::uint32_t >( );
+        if( currentPosition_ + stringSize > fileSize_ )
+        {
+            throw std::runtime_error( "Error when reading binary history file " + fileName_ + ", header is incomplete" );
+        }
+        std::string headerString( fileData_ + currentPosition_, stringSize );
+        currentPosition_ += stringSize;
+        return headerString;
+    }
+
+    std::uint64_t getCurrentPosition( )
+    {
+        return currentPosition_;
+    }
+
+private:
+
+    const char* fileData_;
+
+    std::uint64_t fileSize_;
+
+    std::string fileName_;
+
+    std::uint64_t currentPosition_;
+};
+
+//! Function to parse the header of a binary history file
+BinaryHistoryFileHeader parseBinaryHistoryFileHeader(
+        const char* fileData, const std::uint64_t fileSize, const std::string& fileName )
+{
+    BinaryHistoryHeaderParser headerParser( fileData, fileSize, fileName );
+
+    char fileIdentifier[ sizeof( BINARY_HISTORY_FILE_IDENTIFIER ) ];
+    headerParser.readBytes( fileIdentifier, sizeof( fileIdentifier ) );
+    if( std::memcmp( fileIdentifier, BINARY_HISTORY_FILE_IDENTIFIER, sizeof( fileIdentifier ) ) != 0 )
+    {
+        throw std::runtime_error( "Error when reading binary history file " + fileName + ", file is not a binary history file" );
+    }
+
+    std::uint32_t fileVersion = headerParser.readEntry< std::uint32_t >( );
+    if( fileVersion != BINARY_HISTORY_FILE_VERSION )
+    {
+        throw std::runtime_error( "Error when reading binary history file " + fileName + ", file format version " +
+                                  std::to_string( fileVersion ) + " is not supported" );
+    }
+
+    if( headerParser.readEntry< std::uint32_t >( ) != BINARY_HISTORY_BYTE_ORDER_MARK )
+    {
+        throw std::runtime_error( "Error when reading binary history file " + fileName +
+                                  ", file was written on a platform with different byte order" );
+    }
+
+    std::uint32_t sizeOfLongDouble = headerParser.readEntry< std::uint32_t >( );
+
+    BinaryHistoryFileHeader header;
+    header.timeDataType = static_cast< BinaryHistoryDataType >( headerParser.readEntry< std::uint32_t >( ) );
+    header.valueDataType = static_cast< BinaryHistoryDataType >( headerParser.readEntry< std::uint32_t >( ) );
+    if( header.timeDataType > tudat_time_history_data || header.valueDataType > long_double_history_data )
+    {
+        throw std::runtime_error( "Error when reading binary history file " + fileName + ", data types not recognized" );
+    }
+
+    if( sizeOfLongDouble != sizeof( long double ) && ( header.timeDataType != double_history_data ||
+                                                       header.valueDataType != double_history_data ) )
+    {
+        throw std::runtime_error( "Error when reading binary history file " + fileName +
+                                  ", file was written on a platform with different long double representation" );
+    }
+
+    header.numberOfColumns = headerParser.readEntry< std::uint32_t >( );
+    header.dataOffset = headerParser.readEntry< std::uint64_t >( );
+    header.recordSize = headerParser.readEntry< std::uint64_t >( );
+    header.valueOffset = headerParser.readEntry< std::uint64_t >( );
+    for( unsigned int i = 0; i < header.numberOfColumns; i++ )
+    {
+        header.columnNames.push_back( headerParser.readString( ) );
+        header.columnUnits.push_back( headerParser.readString( ) );
+    }
+
+    // Check consistency of record layout with that computed from data types
+    BinaryHistoryFileHeader expectedHeader(
+                header.timeDataType, header.valueDataType, header.numberOfColumns, header.columnNames, header.columnUnits );
+    if( header.dataOffset != expectedHeader.dataOffset || header.recordSize != expectedHeader.recordSize ||
+            header.valueOffset != expectedHeader.valueOffset || header.dataOffset > fileSize )
+    {
+        throw std::runtime_error( "Error when reading binary history file " + fileName + ", header is inconsistent" );
+    }
+
+    return header;
+}
+
+//! Constructor
+BinaryHistoryFileReader::BinaryHistoryFileReader( const std::string& fileName ):
+    fileName_( fileName )
+{
+    if( !boost::filesystem::exists( fileName_ ) )
+    {
+        throw std::runtime_error( "Error when reading binary history file " + fileName_ + ", file does not exist" );
+    }
+
+    std::uint64_t fileSize = boost::filesystem::file_size( fileName_ );
+    if( fileSize == 0 )
+    {
+        throw std::runtime_error( "Error when reading binary history file " + fileName_ + ", file is empty" );
+    }
+
+    fileMapping_ = boost::interprocess::file_mapping( fileName_.c_str( ), boost::interprocess::read_only );
+    mappedRegion_ = boost::interprocess::mapped_region( fileMapping_, boost::interprocess::read_only );
+    fileData_ = static_cast< const char* >( mappedRegion_.get_address( ) );
+
+    header_ = parseBinaryHistoryFileHeader( fileData_, fileSize, fileName_ );
+    numberOfEpochs_ = static_cast< unsigned int >( ( fileSize - header_.dataOffset ) / header_.recordSize );
+}
+
+} // namespace input_output
+
+} // namespace tudat
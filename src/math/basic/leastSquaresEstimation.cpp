@@ -11,10 +11,13 @@
 
 #include <cmath>
 #include <iostream>
+#include <string>
 
+#include <Eigen/Cholesky>
 #include <Eigen/LU>
 
 #include "tudat/basics/utilities.h"
+#include "tudat/math/basic/mathematicalConstants.h"
 #include "tudat/math/basic/leastSquaresEstimation.h"
 
 namespace tudat
@@ -57,6 +60,61 @@ Eigen::VectorXd solveSystemOfEquationsWithSvd( const Eigen::MatrixXd matrixToInv
     return svdDecomposition.solve( rightHandSideVector );
 }
 
+//! Solve system of normal equations, using a given decomposition, checking condition number in the process
+Eigen::VectorXd solveNormalEquations( const Eigen::MatrixXd& matrixToInvert,
+                                      const Eigen::VectorXd& rightHandSideVector,
+                                      const NormalEquationsSolutionMethod solutionMethod,
+                                      const bool checkConditionNumber,
+                                      const double maximumAllowedConditionNumber )
+{
+    Eigen::VectorXd solution;
+    double reciprocalConditionNumber = TUDAT_NAN;
+    switch( solutionMethod )
+    {
+    case svd_normal_equations_solution:
+        return solveSystemOfEquationsWithSvd(
+                    matrixToInvert, rightHandSideVector, checkConditionNumber, maximumAllowedConditionNumber );
+    case cholesky_normal_equations_solution:
+    {
+        Eigen::LLT< Eigen::MatrixXd > choleskyDecomposition( matrixToInvert );
+        if( choleskyDecomposition.info( ) != Eigen::Success )
+        {
+            throw std::runtime_error( "Error when solving normal equations with Cholesky decomposition, matrix is not positive definite" );
+        }
+        solution = choleskyDecomposition.solve( rightHandSideVector );
+        if( checkConditionNumber )
+        {
+            reciprocalConditionNumber = choleskyDecomposition.rcond( );
+        }
+        break;
+    }
+    case ldlt_normal_equations_solution:
+    {
+        Eigen::LDLT< Eigen::MatrixXd > ldltDecomposition( matrixToInvert );
+        if( ldltDecomposition.info( ) != Eigen::Success )
+        {
+            throw std::runtime_error( "Error when solving normal equations with LDLT decomposition, decomposition failed" );
+        }
+        solution = ldltDecomposition.solve( rightHandSideVector );
+        if( checkConditionNumber )
+        {
+            reciprocalConditionNumber = ldltDecomposition.rcond( );
+        }
+        break;
+    }
+    default:
+        throw std::runtime_error( "Error when solving normal equations, solution method " +
+                                  std::to_string( solutionMethod ) + " not recognized" );
+    }
+
+    if( checkConditionNumber && ( 1.0 / reciprocalConditionNumber > maximumAllowedConditionNumber ) )
+    {
+        std::cerr << "Warning when performing least squares, condition number (estimate) is "
+                  << 1.0 / reciprocalConditionNumber << std::endl;
+    }
+    return solution;
+}
+
 //! Function to multiply information matrix by diagonal weights matrix
 Eigen::MatrixXd multiplyInformationMatrixByDiagonalWeightMatrix(
         const Eigen::MatrixXd& informationMatrix,
@@ -93,26 +151,20 @@ Eigen::MatrixXd calculateInverseOfUpdatedCovarianceMatrix(
                 Eigen::MatrixXd::Zero( informationMatrix.cols( ), informationMatrix.cols( ) ) );
 }
 
-//! Function to perform an iteration least squares estimation from information matrix, weights and residuals and a priori
-//! information
-std::pair< Eigen::VectorXd, Eigen::MatrixXd > performLeastSquaresAdjustmentFromInformationMatrix(
-        const Eigen::MatrixXd& informationMatrix,
-        const Eigen::VectorXd& observationResiduals,
-        const Eigen::VectorXd& diagonalOfWeightMatrix,
+//! Function to perform an iteration of least squares estimation from the normal equations and a priori information
+std::pair< Eigen::VectorXd, Eigen::MatrixXd > performLeastSquaresAdjustmentFromNormalEquations(
+        const Eigen::MatrixXd& normalMatrix,
+        const Eigen::VectorXd& normalRightHandSide,
         const Eigen::MatrixXd& inverseOfAPrioriCovarianceMatrix,
+        const NormalEquationsSolutionMethod solutionMethod,
         const bool checkConditionNumber,
         const double maximumAllowedConditionNumber,
         const Eigen::MatrixXd& constraintMultiplier,
         const Eigen::VectorXd& constraintRightHandside )
 {
-//    std::cout<<"Residuals "<<observationResiduals.transpose( )<<std::endl;
-//    std::cout<<"Weight diag. "<<diagonalOfWeightMatrix.transpose( )<<std::endl;
-//    std::cout<<"Partials "<<informationMatrix.transpose( )<<std::endl;
-
-    Eigen::VectorXd rightHandSide = informationMatrix.transpose( ) *
-            ( diagonalOfWeightMatrix.cwiseProduct( observationResiduals ) );
-    Eigen::MatrixXd inverseOfCovarianceMatrix = calculateInverseOfUpdatedCovarianceMatrix(
-                informationMatrix, diagonalOfWeightMatrix, inverseOfAPrioriCovarianceMatrix );
+    Eigen::VectorXd rightHandSide = normalRightHandSide;
+    Eigen::MatrixXd inverseOfCovarianceMatrix = inverseOfAPrioriCovarianceMatrix + normalMatrix;
+    NormalEquationsSolutionMethod solutionMethodToUse = solutionMethod;
 
     // Add constraints to inverse covariance matrix if required
     if( constraintMultiplier.rows( ) != 0 )
@@ -122,7 +174,7 @@ std::pair< Eigen::VectorXd, Eigen::MatrixXd > performLeastSquaresAdjustmentFromI
             throw std::runtime_error( "Error when performing constrained least-squares, constraints are incompatible" );
         }
 
-        if( constraintMultiplier.cols( ) != informationMatrix.cols( ) )
+        if( constraintMultiplier.cols( ) != normalMatrix.cols( ) )
         {
             throw std::runtime_error( "Error when performing constrained least-squares, constraints are incompatible with partials" );
         }
@@ -141,15 +193,40 @@ std::pair< Eigen::VectorXd, Eigen::MatrixXd > performLeastSquaresAdjustmentFromI
 
         rightHandSide.conservativeResize( numberOfParameters + numberOfConstraints );
         rightHandSide.segment( numberOfParameters, numberOfConstraints ) = constraintRightHandside;
-    }
 
-//    std::cout<<"RHS "<<rightHandSide.transpose( )<<std::endl;
-//    std::cout<<"Inv cov "<<inverseOfCovarianceMatrix<<std::endl;
+        // Constrained system is indefinite
+        if( solutionMethodToUse == cholesky_normal_equations_solution )
+        {
+            solutionMethodToUse = ldlt_normal_equations_solution;
+        }
+    }
 
-    return std::make_pair( solveSystemOfEquationsWithSvd(
-                               inverseOfCovarianceMatrix, rightHandSide, checkConditionNumber, maximumAllowedConditionNumber ),
+    return std::make_pair( solveNormalEquations(
+                               inverseOfCovarianceMatrix, rightHandSide, solutionMethodToUse,
+                               checkConditionNumber, maximumAllowedConditionNumber ),
                            inverseOfCovarianceMatrix );
+}
+
+//! Function to perform an iteration least squares estimation from information matrix, weights and residuals and a priori
+//! information
+std::pair< Eigen::VectorXd, Eigen::MatrixXd > performLeastSquaresAdjustmentFromInformationMatrix(
+        const Eigen::MatrixXd& informationMatrix,
+        const Eigen::VectorXd& observationResiduals,
+        const Eigen::VectorXd& diagonalOfWeightMatrix,
+        const Eigen::MatrixXd& inverseOfAPrioriCovarianceMatrix,
+        const bool checkConditionNumber,
+        const double maximumAllowedConditionNumber,
+        const Eigen::MatrixXd& constraintMultiplier,
+        const Eigen::VectorXd& constraintRightHandside,
+        const NormalEquationsSolutionMethod solutionMethod )
+{
+    Eigen::VectorXd rightHandSide = informationMatrix.transpose( ) *
+            ( diagonalOfWeightMatrix.cwiseProduct( observationResiduals ) );
 
+    return performLeastSquaresAdjustmentFromNormalEquations(
+                calculateInverseOfUpdatedCovarianceMatrix( informationMatrix, diagonalOfWeightMatrix ),
+                rightHandSide, inverseOfAPrioriCovarianceMatrix, solutionMethod,
+                checkConditionNumber, maximumAllowedConditionNumber, constraintMultiplier, constraintRightHandside );
 }
 
 //! Function to perform an iteration least squares estimation from information matrix, weights and residuals
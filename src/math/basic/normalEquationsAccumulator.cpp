@@ -0,0 +1,510 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <Eigen/Cholesky>
+#include <Eigen/SVD>
+
+#include "tudat/math/basic/normalEquationsAccumulator.h"
+
+namespace tudat
+{
+
+namespace linear_algebra
+{
+
+//! Constructor
+NormalEquationsAccumulator::NormalEquationsAccumulator(
+        const int numberOfParameters,
+        const std::vector< std::vector< std::pair< int, int > > >& localParameterBlocks ):
+    numberOfParameters_( numberOfParameters ), numberOfObservations_( 0 )
+{
+    localParameterSetPerParameter_.resize( numberOfParameters_, -1 );
+    blockIndexPerParameter_.resize( numberOfParameters_, -1 );
+
+    // Set indices of local parameters
+    localParameterIndices_.resize( localParameterBlocks.size( ) );
+    for( unsigned int i = 0; i < localParameterBlocks.size( ); i++ )
+    {
+        for( unsigned int j = 0; j < localParameterBlocks.at( i ).size( ); j++ )
+        {
+            int startIndex = localParameterBlocks.at( i ).at( j ).first;
+            int blockSize = localParameterBlocks.at( i ).at( j ).second;
+            if( startIndex < 0 || blockSize < 0 || ( startIndex + blockSize ) > numberOfParameters_ )
+            {
+                throw std::runtime_error( "Error when creating normal equations accumulator, local parameter block (" +
+                                          std::to_string( startIndex ) + ", " + std::to_string( blockSize ) +
+                                          ") is incompatible with number of parameters " +
+                                          std::to_string( numberOfParameters_ ) );
+            }
+
+            for( int k = startIndex; k < startIndex + blockSize; k++ )
+            {
+                if( localParameterSetPerParameter_.at( k ) != -1 )
+                {
+                    throw std::runtime_error( "Error when creating normal equations accumulator, parameter " +
+                                              std::to_string( k ) + " is in multiple local parameter blocks" );
+                }
+                localParameterSetPerParameter_[ k ] = i;
+                blockIndexPerParameter_[ k ] = localParameterIndices_.at( i ).size( );
+                localParameterIndices_[ i ].push_back( k );
+            }
+        }
+    }
+
+    // Set indices of global parameters
+    for( int i = 0; i < numberOfParameters_; i++ )
+    {
+        if( localParameterSetPerParameter_.at( i ) == -1 )
+        {
+            blockIndexPerParameter_[ i ] = globalParameterIndices_.size( );
+            globalParameterIndices_.push_back( i );
+        }
+    }
+
+    resetNormalEquations( );
+}
+
+//! Function to reset the accumulated normal equations to zero
+void NormalEquationsAccumulator::resetNormalEquations( )
+{
+    const int numberOfGlobalParameters = globalParameterIndices_.size( );
+    globalNormalMatrix_.setZero( numberOfGlobalParameters, numberOfGlobalParameters );
+    globalRightHandSide_.setZero( numberOfGlobalParameters );
+
+    mixedNormalMatrices_.resize( localParameterIndices_.size( ) );
+    localNormalMatrices_.resize( localParameterIndices_.size( ) );
+    localRightHandSides_.resize( localParameterIndices_.size( ) );
+    for( unsigned int i = 0; i < localParameterIndices_.size( ); i++ )
+    {
+        const int numberOfLocalParameters = localParameterIndices_.at( i ).size( );
+        mixedNormalMatrices_[ i ].setZero( numberOfGlobalParameters, numberOfLocalParameters );
+        localNormalMatrices_[ i ].setZero( numberOfLocalParameters, numberOfLocalParameters );
+        localRightHandSides_[ i ].setZero( numberOfLocalParameters );
+    }
+
+    minimumPartials_.setConstant( numberOfParameters_, std::numeric_limits< double >::infinity( ) );
+    maximumPartials_.setConstant( numberOfParameters_, -std::numeric_limits< double >::infinity( ) );
+
+    numberOfObservations_ = 0;
+}
+
+//! Function to add the contribution of a block of observations to the normal equations
+void NormalEquationsAccumulator::addObservations( const Eigen::MatrixXd& partials,
+                                                  const Eigen::VectorXd& residuals,
+                                                  const Eigen::VectorXd& diagonalOfWeightMatrix )
+{
+    if( partials.cols( ) != numberOfParameters_ )
+    {
+        throw std::runtime_error( "Error when adding observations to normal equations, number of partials (" +
+                                  std::to_string( partials.cols( ) ) + ") is inconsistent with number of parameters (" +
+                                  std::to_string( numberOfParameters_ ) + ")" );
+    }
+
+    if( partials.rows( ) != residuals.rows( ) || partials.rows( ) != diagonalOfWeightMatrix.rows( ) )
+    {
+        throw std::runtime_error( "Error when adding observations to normal equations, number of partials, residuals and weights is inconsistent" );
+    }
+
+    if( partials.rows( ) == 0 )
+    {
+        return;
+    }
+
+    // Update extrema of partials, for normalization
+    minimumPartials_ = minimumPartials_.cwiseMin( partials.colwise( ).minCoeff( ).transpose( ) );
+    maximumPartials_ = maximumPartials_.cwiseMax( partials.colwise( ).maxCoeff( ).transpose( ) );
+
+    if( localParameterIndices_.size( ) == 0 )
+    {
+        addObservationRows( partials, residuals, diagonalOfWeightMatrix, 0, partials.rows( ), -1 );
+    }
+    else
+    {
+        // Add contiguous ranges of rows that depend on the same set of local parameters
+        int currentRangeStart = 0;
+        int currentRangeLocalSet = -2;
+        for( int i = 0; i < partials.rows( ); i++ )
+        {
+            // Determine on which set of local parameters the current row depends
+            int currentRowLocalSet = -1;
+            for( unsigned int j = 0; j < localParameterIndices_.size( ); j++ )
+            {
+                for( unsigned int k = 0; k < localParameterIndices_.at( j ).size( ); k++ )
+                {
+                    if( partials( i, localParameterIndices_.at( j ).at( k ) ) != 0.0 )
+                    {
+                        if( currentRowLocalSet != -1 && currentRowLocalSet != static_cast< int >( j ) )
+                        {
+                            throw std::runtime_error(
+                                        "Error when adding observations to normal equations, observation depends on local parameter sets " +
+                                        std::to_string( currentRowLocalSet ) + " and " + std::to_string( j ) );
+                        }
+                        currentRowLocalSet = j;
+                        break;
+                    }
+                }
+            }
+
+            if( currentRowLocalSet != currentRangeLocalSet )
+            {
+                if( i > currentRangeStart )
+                {
+                    addObservationRows( partials, residuals, diagonalOfWeightMatrix,
+                                        currentRangeStart, i - currentRangeStart, currentRangeLocalSet );
+                }
+                currentRangeStart = i;
+                currentRangeLocalSet = currentRowLocalSet;
+            }
+        }
+        addObservationRows( partials, residuals, diagonalOfWeightMatrix,
+                            currentRangeStart, partials.rows( ) - currentRangeStart, currentRangeLocalSet );
+    }
+
+    numberOfObservations_ += partials.rows( );
+}
+
+//! Function to add the contribution of a range of rows, all with the same set of local parameters, to the normal equations
+void NormalEquationsAccumulator::addObservationRows( const Eigen::MatrixXd& partials,
+                                                     const Eigen::VectorXd& residuals,
+                                                     const Eigen::VectorXd& diagonalOfWeightMatrix,
+                                                     const int startRow,
+                                                     const int numberOfRows,
+                                                     const int localParameterSet )
+{
+    // Retrieve partials w.r.t. global parameters
+    if( localParameterIndices_.size( ) == 0 )
+    {
+        globalPartials_ = partials.block( startRow, 0, numberOfRows, numberOfParameters_ );
+    }
+    else
+    {
+        globalPartials_.resize( numberOfRows, globalParameterIndices_.size( ) );
+        for( unsigned int i = 0; i < globalParameterIndices_.size( ); i++ )
+        {
+            globalPartials_.col( i ) = partials.block( startRow, globalParameterIndices_.at( i ), numberOfRows, 1 );
+        }
+    }
+    weightedGlobalPartials_ = diagonalOfWeightMatrix.segment( startRow, numberOfRows ).asDiagonal( ) * globalPartials_;
+
+    // Add contribution of global parameters
+    globalNormalMatrix_.noalias( ) += weightedGlobalPartials_.transpose( ) * globalPartials_;
+    globalRightHandSide_.noalias( ) += weightedGlobalPartials_.transpose( ) * residuals.segment( startRow, numberOfRows );
+
+    // Add contribution of local parameters
+    if( localParameterSet >= 0 )
+    {
+        const std::vector< int >& currentLocalIndices = localParameterIndices_.at( localParameterSet );
+        localPartials_.resize( numberOfRows, currentLocalIndices.size( ) );
+        for( unsigned int i = 0; i < currentLocalIndices.size( ); i++ )
+        {
+            localPartials_.col( i ) = partials.block( startRow, currentLocalIndices.at( i ), numberOfRows, 1 );
+        }
+
+        mixedNormalMatrices_[ localParameterSet ].noalias( ) += weightedGlobalPartials_.transpose( ) * localPartials_;
+        localNormalMatrices_[ localParameterSet ].noalias( ) += localPartials_.transpose( ) * (
+                    diagonalOfWeightMatrix.segment( startRow, numberOfRows ).asDiagonal( ) * localPartials_ );
+        localRightHandSides_[ localParameterSet ].noalias( ) += localPartials_.transpose( ) * (
+                    diagonalOfWeightMatrix.segment( startRow, numberOfRows ).cwiseProduct(
+                        residuals.segment( startRow, numberOfRows ) ) );
+    }
+}
+
+//! Function to retrieve the terms by which the parameters are normalized
+Eigen::VectorXd NormalEquationsAccumulator::getParameterNormalization( )
+{
+    Eigen::VectorXd normalizationTerms = Eigen::VectorXd::Ones( numberOfParameters_ );
+    if( numberOfObservations_ > 0 )
+    {
+        for( int i = 0; i < numberOfParameters_; i++ )
+        {
+            if( std::fabs( minimumPartials_( i ) ) > maximumPartials_( i ) )
+            {
+                normalizationTerms( i ) = minimumPartials_( i );
+            }
+            else
+            {
+                normalizationTerms( i ) = maximumPartials_( i );
+            }
+            if( normalizationTerms( i ) == 0.0 )
+            {
+                normalizationTerms( i ) = 1.0;
+            }
+        }
+    }
+    return normalizationTerms;
+}
+
+//! Function to retrieve the full (dense) normal equations
+void NormalEquationsAccumulator::getNormalEquations( Eigen::MatrixXd& normalMatrix,
+                                                     Eigen::VectorXd& normalRightHandSide,
+                                                     const Eigen::VectorXd& parameterNormalization )
+{
+    normalMatrix.setZero( numberOfParameters_, numberOfParameters_ );
+    normalRightHandSide.setZero( numberOfParameters_ );
+
+    // Set global contributions
+    for( unsigned int i = 0; i < globalParameterIndices_.size( ); i++ )
+    {
+        for( unsigned int j = 0; j < globalParameterIndices_.size( ); j++ )
+        {
+            normalMatrix( globalParameterIndices_.at( i ), globalParameterIndices_.at( j ) ) = globalNormalMatrix_( i, j );
+        }
+        normalRightHandSide( globalParameterIndices_.at( i ) ) = globalRightHandSide_( i );
+    }
+
+    // Set local contributions
+    for( unsigned int k = 0; k < localParameterIndices_.size( ); k++ )
+    {
+        const std::vector< int >& currentLocalIndices = localParameterIndices_.at( k );
+        for( unsigned int i = 0; i < currentLocalIndices.size( ); i++ )
+        {
+            for( unsigned int j = 0; j < globalParameterIndices_.size( ); j++ )
+            {
+                normalMatrix( globalParameterIndices_.at( j ), currentLocalIndices.at( i ) ) =
+                        mixedNormalMatrices_.at( k )( j, i );
+                normalMatrix( currentLocalIndices.at( i ), globalParameterIndices_.at( j ) ) =
+                        mixedNormalMatrices_.at( k )( j, i );
+            }
+            for( unsigned int j = 0; j < currentLocalIndices.size( ); j++ )
+            {
+                normalMatrix( currentLocalIndices.at( i ), currentLocalIndices.at( j ) ) =
+                        localNormalMatrices_.at( k )( i, j );
+            }
+            normalRightHandSide( currentLocalIndices.at( i ) ) = localRightHandSides_.at( k )( i );
+        }
+    }
+
+    // Normalize parameters
+    if( parameterNormalization.rows( ) > 0 )
+    {
+        if( parameterNormalization.rows( ) != numberOfParameters_ )
+        {
+            throw std::runtime_error( "Error when retrieving normal equations, size of normalization is inconsistent" );
+        }
+        const Eigen::VectorXd inverseNormalization = parameterNormalization.cwiseInverse( );
+        normalMatrix = inverseNormalization.asDiagonal( ) * normalMatrix * inverseNormalization.asDiagonal( );
+        normalRightHandSide = normalRightHandSide.cwiseProduct( inverseNormalization );
+    }
+}
+
+//! Function to retrieve the normalized normal equations in block form, including a priori information
+bool NormalEquationsAccumulator::getNormalizedBlockNormalEquations(
+        const Eigen::VectorXd& parameterNormalization,
+        const Eigen::MatrixXd& inverseOfAPrioriCovarianceMatrix,
+        Eigen::MatrixXd& globalNormalMatrix,
+        Eigen::VectorXd& globalRightHandSide,
+        std::vector< Eigen::MatrixXd >& mixedNormalMatrices,
+        std::vector< Eigen::MatrixXd >& localNormalMatrices,
+        std::vector< Eigen::VectorXd >& localRightHandSides )
+{
+    const Eigen::VectorXd inverseNormalization = parameterNormalization.cwiseInverse( );
+    Eigen::VectorXd globalInverseNormalization = Eigen::VectorXd( globalParameterIndices_.size( ) );
+    for( unsigned int i = 0; i < globalParameterIndices_.size( ); i++ )
+    {
+        globalInverseNormalization( i ) = inverseNormalization( globalParameterIndices_.at( i ) );
+    }
+
+    globalNormalMatrix = globalInverseNormalization.asDiagonal( ) * globalNormalMatrix_ *
+            globalInverseNormalization.asDiagonal( );
+    globalRightHandSide = globalRightHandSide_.cwiseProduct( globalInverseNormalization );
+
+    mixedNormalMatrices.resize( localParameterIndices_.size( ) );
+    localNormalMatrices.resize( localParameterIndices_.size( ) );
+    localRightHandSides.resize( localParameterIndices_.size( ) );
+    for( unsigned int k = 0; k < localParameterIndices_.size( ); k++ )
+    {
+        Eigen::VectorXd localInverseNormalization = Eigen::VectorXd( localParameterIndices_.at( k ).size( ) );
+        for( unsigned int i = 0; i < localParameterIndices_.at( k ).size( ); i++ )
+        {
+            localInverseNormalization( i ) = inverseNormalization( localParameterIndices_.at( k ).at( i ) );
+        }
+
+        mixedNormalMatrices[ k ] = globalInverseNormalization.asDiagonal( ) * mixedNormalMatrices_.at( k ) *
+                localInverseNormalization.asDiagonal( );
+        localNormalMatrices[ k ] = localInverseNormalization.asDiagonal( ) * localNormalMatrices_.at( k ) *
+                localInverseNormalization.asDiagonal( );
+        localRightHandSides[ k ] = localRightHandSides_.at( k ).cwiseProduct( localInverseNormalization );
+    }
+
+    // Add a priori information to blocks
+    for( int i = 0; i < numberOfParameters_; i++ )
+    {
+        for( int j = 0; j < numberOfParameters_; j++ )
+        {
+            const double currentEntry = inverseOfAPrioriCovarianceMatrix( i, j );
+            if( currentEntry == 0.0 )
+            {
+                continue;
+            }
+
+            const int firstSet = localParameterSetPerParameter_.at( i );
+            const int secondSet = localParameterSetPerParameter_.at( j );
+            const int firstIndex = blockIndexPerParameter_.at( i );
+            const int secondIndex = blockIndexPerParameter_.at( j );
+            if( firstSet == -1 && secondSet == -1 )
+            {
+                globalNormalMatrix( firstIndex, secondIndex ) += currentEntry;
+            }
+            else if( firstSet == -1 )
+            {
+                mixedNormalMatrices[ secondSet ]( firstIndex, secondIndex ) += currentEntry;
+            }
+            else if( secondSet == -1 )
+            {
+                // Corresponding entry is added from symmetric counterpart
+                continue;
+            }
+            else if( firstSet == secondSet )
+            {
+                localNormalMatrices[ firstSet ]( firstIndex, secondIndex ) += currentEntry;
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//! Function to solve a (small) system of equations for multiple right-hand sides, using a given decomposition
+Eigen::MatrixXd solveLocalNormalEquations(
+        const Eigen::MatrixXd& matrixToInvert,
+        const Eigen::MatrixXd& rightHandSides,
+        const NormalEquationsSolutionMethod solutionMethod )
+{
+    switch( solutionMethod )
+    {
+    case svd_normal_equations_solution:
+        return matrixToInvert.jacobiSvd( Eigen::ComputeThinU | Eigen::ComputeThinV ).solve( rightHandSides );
+    case cholesky_normal_equations_solution:
+    {
+        Eigen::LLT< Eigen::MatrixXd > choleskyDecomposition( matrixToInvert );
+        if( choleskyDecomposition.info( ) != Eigen::Success )
+        {
+            throw std::runtime_error( "Error when reducing normal equations with Cholesky decomposition, local normal matrix is not positive definite" );
+        }
+        return choleskyDecomposition.solve( rightHandSides );
+    }
+    case ldlt_normal_equations_solution:
+    {
+        Eigen::LDLT< Eigen::MatrixXd > ldltDecomposition( matrixToInvert );
+        if( ldltDecomposition.info( ) != Eigen::Success )
+        {
+            throw std::runtime_error( "Error when reducing normal equations with LDLT decomposition, decomposition failed" );
+        }
+        return ldltDecomposition.solve( rightHandSides );
+    }
+    default:
+        throw std::runtime_error( "Error when reducing normal equations, solution method " +
+                                  std::to_string( solutionMethod ) + " not recognized" );
+    }
+}
+
+//! Function to perform an iteration of least squares estimation from the accumulated normal equations
+std::pair< Eigen::VectorXd, Eigen::MatrixXd > NormalEquationsAccumulator::performLeastSquaresAdjustment(
+        const Eigen::VectorXd& parameterNormalization,
+        const Eigen::MatrixXd& inverseOfAPrioriCovarianceMatrix,
+        const NormalEquationsSolutionMethod solutionMethod,
+        const bool checkConditionNumber,
+        const double maximumAllowedConditionNumber,
+        const Eigen::MatrixXd& constraintMultiplier,
+        const Eigen::VectorXd& constraintRightHandside )
+{
+    const Eigen::VectorXd normalizationToUse = ( parameterNormalization.rows( ) == 0 ) ?
+                Eigen::VectorXd::Ones( numberOfParameters_ ) : parameterNormalization;
+
+    if( normalizationToUse.rows( ) != numberOfParameters_ ||
+            inverseOfAPrioriCovarianceMatrix.rows( ) != numberOfParameters_ ||
+            inverseOfAPrioriCovarianceMatrix.cols( ) != numberOfParameters_ )
+    {
+        throw std::runtime_error( "Error when performing least squares adjustment from normal equations, input sizes are inconsistent" );
+    }
+
+    Eigen::MatrixXd normalMatrix;
+    Eigen::VectorXd normalRightHandSide;
+
+    // Eliminate local parameters, if possible
+    if( localParameterIndices_.size( ) > 0 && constraintMultiplier.rows( ) == 0 )
+    {
+        Eigen::MatrixXd globalNormalMatrix;
+        Eigen::VectorXd globalRightHandSide;
+        std::vector< Eigen::MatrixXd > mixedNormalMatrices;
+        std::vector< Eigen::MatrixXd > localNormalMatrices;
+        std::vector< Eigen::VectorXd > localRightHandSides;
+
+        if( getNormalizedBlockNormalEquations(
+                    normalizationToUse, inverseOfAPrioriCovarianceMatrix, globalNormalMatrix, globalRightHandSide,
+                    mixedNormalMatrices, localNormalMatrices, localRightHandSides ) )
+        {
+            const int numberOfGlobalParameters = globalParameterIndices_.size( );
+
+            // Compute Schur complement of local-local blocks
+            std::vector< Eigen::MatrixXd > localSolutions( localParameterIndices_.size( ) );
+            Eigen::MatrixXd reducedNormalMatrix = globalNormalMatrix;
+            Eigen::VectorXd reducedRightHandSide = globalRightHandSide;
+            for( unsigned int k = 0; k < localParameterIndices_.size( ); k++ )
+            {
+                Eigen::MatrixXd currentRightHandSides = Eigen::MatrixXd(
+                            localNormalMatrices.at( k ).rows( ), numberOfGlobalParameters + 1 );
+                currentRightHandSides.leftCols( numberOfGlobalParameters ) = mixedNormalMatrices.at( k ).transpose( );
+                currentRightHandSides.rightCols( 1 ) = localRightHandSides.at( k );
+
+                localSolutions[ k ] = solveLocalNormalEquations(
+                            localNormalMatrices.at( k ), currentRightHandSides, solutionMethod );
+
+                reducedNormalMatrix.noalias( ) -=
+                        mixedNormalMatrices.at( k ) * localSolutions.at( k ).leftCols( numberOfGlobalParameters );
+                reducedRightHandSide.noalias( ) -=
+                        mixedNormalMatrices.at( k ) * localSolutions.at( k ).rightCols( 1 );
+            }
+
+            // Solve reduced normal equations for global parameters, and back-substitute local parameters
+            Eigen::VectorXd globalSolution = solveNormalEquations(
+                        reducedNormalMatrix, reducedRightHandSide, solutionMethod,
+                        checkConditionNumber, maximumAllowedConditionNumber );
+
+            Eigen::VectorXd solution = Eigen::VectorXd::Zero( numberOfParameters_ );
+            for( int i = 0; i < numberOfGlobalParameters; i++ )
+            {
+                solution( globalParameterIndices_.at( i ) ) = globalSolution( i );
+            }
+            for( unsigned int k = 0; k < localParameterIndices_.size( ); k++ )
+            {
+                Eigen::VectorXd localSolution = localSolutions.at( k ).rightCols( 1 ) -
+                        localSolutions.at( k ).leftCols( numberOfGlobalParameters ) * globalSolution;
+                for( unsigned int i = 0; i < localParameterIndices_.at( k ).size( ); i++ )
+                {
+                    solution( localParameterIndices_.at( k ).at( i ) ) = localSolution( i );
+                }
+            }
+
+            getNormalEquations( normalMatrix, normalRightHandSide, normalizationToUse );
+            return std::make_pair( solution, inverseOfAPrioriCovarianceMatrix + normalMatrix );
+        }
+    }
+
+    // Solve full normal equations
+    getNormalEquations( normalMatrix, normalRightHandSide, normalizationToUse );
+    return performLeastSquaresAdjustmentFromNormalEquations(
+                normalMatrix, normalRightHandSide, inverseOfAPrioriCovarianceMatrix, solutionMethod,
+                checkConditionNumber, maximumAllowedConditionNumber, constraintMultiplier, constraintRightHandside );
+}
+
+} // namespace linear_algebra
+
+} // namespace tudat
@@ -12,9 +12,17 @@
  *      Fehlberg, E. Classical Fifth-, Sixth-, Seventh-, and Eighth-Order Runge-Kutta Formulas With
  *          Stepsize Control, Marshall Spaceflight Center, NASA TR R-278, 1968.
  *      Montenbruck, O., Gill, E. Satellite Orbits: Models, Methods, Applications, Springer, 2005.
+ *      Hairer, E., Norsett, S.P., Wanner, G. Solving Ordinary Differential Equations I, 2nd Edition, Springer, 1993.
+ *      Enright, W.H., Jackson, K.R., Norsett, S.P., Thomsen, P.G. Interpolants for Runge-Kutta Formulas,
+ *          ACM Transactions on Mathematical Software 12(3), 1986.
  *
  *    Notes
  *      The naming of the coefficient sets follows (Montenbruck and Gill, 2005).
+ *      The dense output coefficients are solutions of the order conditions of the continuous extension (Hairer et al.,
+ *      1993, Section II.6), for which the free parameters are chosen such that the dense output is continuously
+ *      differentiable over the step boundaries, and the leading error term is minimized. Where the stages of a
+ *      coefficient set do not admit a continuous extension of the same order as the integrated estimate, additional
+ *      stages are evaluated at the dense output of lower order (bootstrapping, Enright et al., 1986).
  *
  */
 
@@ -85,6 +93,38 @@ void initializeRungeKuttaFehlberg45Coefficients( RungeKuttaCoefficients&
     rungeKuttaFehlberg45Coefficients.bCoefficients( 1, 3 ) = 28561.0 / 56430.0;
     rungeKuttaFehlberg45Coefficients.bCoefficients( 1, 4 ) = -9.0 / 50.0;
     rungeKuttaFehlberg45Coefficients.bCoefficients( 1, 5 ) = 2.0 / 55.0;
+
+    // Define dense output coefficients, giving a continuous extension of order 4 of the integrated estimate.
+    rungeKuttaFehlberg45Coefficients.denseOutputOrder = 4;
+
+    // Define a-coefficients of the additional stages that are used for the dense output (w.r.t. all preceding stages).
+    // The first additional stage is the state derivative at the end of the step.
+    rungeKuttaFehlberg45Coefficients.denseOutputACoefficients = Eigen::MatrixXd::Zero( 1, 6 );
+    rungeKuttaFehlberg45Coefficients.denseOutputACoefficients.block( 0, 0, 1, 6 ) =
+            rungeKuttaFehlberg45Coefficients.bCoefficients.row( 0 );
+
+    // Define c-coefficients of the additional stages that are used for the dense output.
+    rungeKuttaFehlberg45Coefficients.denseOutputCCoefficients = Eigen::VectorXd::Zero( 1 );
+    rungeKuttaFehlberg45Coefficients.denseOutputCCoefficients( 0 ) = 1.0;
+
+    // Define coefficients of the polynomial weights of the dense output, with one row per stage (regular stages
+    // followed by additional stages) and one column per power of theta (from 1 to 5).
+    rungeKuttaFehlberg45Coefficients.denseOutputBCoefficients = Eigen::MatrixXd( 7, 5 );
+    rungeKuttaFehlberg45Coefficients.denseOutputBCoefficients <<
+            1.0, -2.5004928593228755, 2.507473656845102,
+            -0.9347650320178733, 0.04352497523638773,
+            0.0, 0.0, 0.0,
+            0.0, 0.0,
+            0.0, 4.9456633818942946, -8.164768680098785,
+            4.237186590733007, -0.46915341728485305,
+            0.0, -3.4988063224927055, 8.681405307390643,
+            -4.189734727225194, -0.4575328736571476,
+            0.0, 1.1964514128752952, -2.8795230040485986,
+            1.1696917694713118, 0.3133798217019917,
+            0.0, -1.6428156129540088, 3.8554127199116386,
+            -2.782378600961251, 0.5697814940036212,
+            0.0, 1.5, -4.0,
+            2.5, 0.0;
 }
 
 //! Initialize RKF56 coefficients.
@@ -158,6 +198,53 @@ void initializeRungeKuttaFehlberg56Coefficients( RungeKuttaCoefficients&
     rungeKuttaFehlberg56Coefficients.bCoefficients( 1, 4 ) = 125.0 / 768.0;
     rungeKuttaFehlberg56Coefficients.bCoefficients( 1, 6 ) = 5.0 / 66.0;
     rungeKuttaFehlberg56Coefficients.bCoefficients( 1, 7 ) = 5.0 / 66.0;
+
+    // Define dense output coefficients, giving a continuous extension of order 5 of the integrated estimate.
+    rungeKuttaFehlberg56Coefficients.denseOutputOrder = 5;
+
+    // Define a-coefficients of the additional stages that are used for the dense output (w.r.t. all preceding stages).
+    // The first additional stage is the state derivative at the end of the step.
+    rungeKuttaFehlberg56Coefficients.denseOutputACoefficients = Eigen::MatrixXd::Zero( 2, 9 );
+    rungeKuttaFehlberg56Coefficients.denseOutputACoefficients.block( 0, 0, 1, 8 ) =
+            rungeKuttaFehlberg56Coefficients.bCoefficients.row( 0 );
+    rungeKuttaFehlberg56Coefficients.denseOutputACoefficients( 1, 0 ) = 0.1200177098443843;
+    rungeKuttaFehlberg56Coefficients.denseOutputACoefficients( 1, 2 ) = 0.37675886035470296;
+    rungeKuttaFehlberg56Coefficients.denseOutputACoefficients( 1, 3 ) = 0.04490256155144558;
+    rungeKuttaFehlberg56Coefficients.denseOutputACoefficients( 1, 4 ) = -0.0020143870327558075;
+    rungeKuttaFehlberg56Coefficients.denseOutputACoefficients( 1, 5 ) = 0.04539093378479493;
+    rungeKuttaFehlberg56Coefficients.denseOutputACoefficients( 1, 6 ) = -0.03587218388176384;
+    rungeKuttaFehlberg56Coefficients.denseOutputACoefficients( 1, 7 ) = -0.05954865875799632;
+    rungeKuttaFehlberg56Coefficients.denseOutputACoefficients( 1, 8 ) = 0.0103651641371882;
+
+    // Define c-coefficients of the additional stages that are used for the dense output.
+    rungeKuttaFehlberg56Coefficients.denseOutputCCoefficients = Eigen::VectorXd::Zero( 2 );
+    rungeKuttaFehlberg56Coefficients.denseOutputCCoefficients( 0 ) = 1.0;
+    rungeKuttaFehlberg56Coefficients.denseOutputCCoefficients( 1 ) = 1.0 / 2.0;
+
+    // Define coefficients of the polynomial weights of the dense output, with one row per stage (regular stages
+    // followed by additional stages) and one column per power of theta (from 1 to 6).
+    rungeKuttaFehlberg56Coefficients.denseOutputBCoefficients = Eigen::MatrixXd( 10, 6 );
+    rungeKuttaFehlberg56Coefficients.denseOutputBCoefficients <<
+            1.0, -4.594417391860672, 8.337408201627758,
+            -6.635126570179584, 2.1200731029185826, -0.14720817583941737,
+            0.0, 0.0, 0.0,
+            0.0, 0.0, 0.0,
+            0.0, 8.7890625, -25.568181818181817,
+            26.76669034090909, -9.588068181818182, 0.0,
+            0.0, 2.8125, -11.25,
+            15.46875, -6.75, 0.0,
+            0.0, 0.9765625, -5.208333333333333,
+            8.30078125, -3.90625, 0.0,
+            0.0, 1.756434880866601, -5.2648645256449695,
+            5.492004111638598, -1.7606087152632357, -0.14720817583941737,
+            0.0, 0.5162923918606717, -0.795741534961091,
+            0.1898140701795844, -0.057573102918582426, 0.14720817583941737,
+            0.0, -1.756434880866601, 3.7497130104934544,
+            -2.0829132025476884, -0.057573102918582426, 0.14720817583941737,
+            0.0, -0.5, 4.0,
+            -7.5, 4.0, 0.0,
+            0.0, -8.0, 32.0,
+            -40.0, 16.0, 0.0;
 }
 
 //! Initialize RKF78 coefficients.
@@ -281,6 +368,107 @@ void initializeRungeKuttaFehlberg78Coefficients( RungeKuttaCoefficients&
     rungeKuttaFehlberg78Coefficients.bCoefficients( 1, 11 ) = 41.0 / 840.0;
     rungeKuttaFehlberg78Coefficients.bCoefficients( 1, 12 ) =
             rungeKuttaFehlberg78Coefficients.bCoefficients( 1, 11 );
+
+    // Define dense output coefficients, giving a continuous extension of order 7 of the integrated estimate.
+    rungeKuttaFehlberg78Coefficients.denseOutputOrder = 7;
+
+    // Define a-coefficients of the additional stages that are used for the dense output (w.r.t. all preceding stages).
+    // The first additional stage is the state derivative at the end of the step.
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients = Eigen::MatrixXd::Zero( 5, 17 );
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients.block( 0, 0, 1, 13 ) =
+            rungeKuttaFehlberg78Coefficients.bCoefficients.row( 0 );
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 1, 0 ) = 0.14349500080028213;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 1, 5 ) = -0.004527065915906916;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 1, 6 ) = 0.00331748069494042;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 1, 7 ) = 0.21915146494070062;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 1, 8 ) = -0.0015232752242845058;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 1, 9 ) = 0.062017577801848585;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 1, 10 ) = 0.01527874957506964;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 1, 11 ) = -0.08747011775742902;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 1, 12 ) = 0.008730640619553278;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 1, 13 ) = -0.025137122201440883;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 2, 0 ) = 0.13761756401367106;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 2, 5 ) = 0.28250048990789733;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 2, 6 ) = 0.013639035861258083;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 2, 7 ) = 0.25067607289829513;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 2, 8 ) = 0.017754262198706645;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 2, 9 ) = 0.03256907701352146;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 2, 10 ) = -0.0008219452936941296;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 2, 11 ) = -0.08803888480536223;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 2, 12 ) = -0.02970911486699566;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 2, 13 ) = 0.028257887517146776;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 2, 14 ) = 0.022222222222222223;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 3, 0 ) = 0.16353542947137412;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 3, 5 ) = 0.08601190476190476;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 3, 6 ) = -0.006696428571428571;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 3, 7 ) = 0.21830357142857143;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 3, 8 ) = 0.0026785714285714286;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 3, 9 ) = 0.016741071428571428;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 3, 10 ) = 0.006647393657877591;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 3, 11 ) = -0.10877352470946935;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 3, 12 ) = -0.009697988895972828;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 3, 13 ) = 0.0046875;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 3, 14 ) = 0.1265625;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 4, 0 ) = 0.12796102042916113;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 4, 5 ) = 0.022846912202380953;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 4, 6 ) = -0.002950613839285714;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 4, 7 ) = 0.2185337611607143;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 4, 8 ) = -0.0018519810267857142;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 4, 9 ) = 0.011990792410714286;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 4, 10 ) = 0.007040976707584202;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 4, 11 ) = -0.07403500666428017;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 4, 12 ) = 0.0031594511197967504;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 4, 13 ) = -0.0093017578125;
+    rungeKuttaFehlberg78Coefficients.denseOutputACoefficients( 4, 14 ) = -0.0533935546875;
+
+    // Define c-coefficients of the additional stages that are used for the dense output.
+    rungeKuttaFehlberg78Coefficients.denseOutputCCoefficients = Eigen::VectorXd::Zero( 5 );
+    rungeKuttaFehlberg78Coefficients.denseOutputCCoefficients( 0 ) = 1.0;
+    rungeKuttaFehlberg78Coefficients.denseOutputCCoefficients( 1 ) = 1.0 / 3.0;
+    rungeKuttaFehlberg78Coefficients.denseOutputCCoefficients( 2 ) = 2.0 / 3.0;
+    rungeKuttaFehlberg78Coefficients.denseOutputCCoefficients( 3 ) = 1.0 / 2.0;
+    rungeKuttaFehlberg78Coefficients.denseOutputCCoefficients( 4 ) = 1.0 / 4.0;
+
+    // Define coefficients of the polynomial weights of the dense output, with one row per stage (regular stages
+    // followed by additional stages) and one column per power of theta (from 1 to 8).
+    rungeKuttaFehlberg78Coefficients.denseOutputBCoefficients = Eigen::MatrixXd( 18, 8 );
+    rungeKuttaFehlberg78Coefficients.denseOutputBCoefficients <<
+            1.0, -9.54761824339762, 45.36083983292459, -107.48615918393976,
+            133.23015553063289, -83.30623068656189, 20.738618003223134, 0.05920427092818959,
+            0.0, 0.0, 0.0, 0.0,
+            0.0, 0.0, 0.0, 0.0,
+            0.0, 0.0, 0.0, 0.0,
+            0.0, 0.0, 0.0, 0.0,
+            0.0, 0.0, 0.0, 0.0,
+            0.0, 0.0, 0.0, 0.0,
+            0.0, 0.0, 0.0, 0.0,
+            0.0, 0.0, 0.0, 0.0,
+            0.0, 19.04, -127.84, 360.4,
+            -514.08, 365.38666666666666, -102.58285714285714, 0.0,
+            0.0, 2.16, -21.36, 84.6,
+            -159.12, 140.88, -46.902857142857144, 0.0,
+            0.0, 28.08, -181.68, 487.8,
+            -657.36, 439.44, -116.02285714285715, 0.0,
+            0.0, 1.08, -7.68, 23.175,
+            -35.46, 26.94, -8.022857142857143, 0.0,
+            0.0, 2.7, -17.7, 48.375,
+            -66.6, 45.6, -12.342857142857143, 0.0,
+            0.0, 4.9223817566023795, -28.09249350040874, 71.96384081606024,
+            -96.10984446936713, 64.48710264677145, -17.181381996776867, 0.05920427092818959,
+            0.0, 1.6376182433976207, -14.000839832924592, 39.76115918393975,
+            -52.310155530632876, 33.09289735322856, -8.121475146080277, -0.05920427092818959,
+            0.0, -5.742381756602379, 31.645826833742074, -75.03884081606024,
+            89.54984446936713, -51.91376931343811, 11.558524853919723, -0.05920427092818959,
+            0.0, 0.5066666666666667, -0.4177777777777778, -9.6,
+            31.186666666666667, -35.43555555555555, 13.76, 0.0,
+            0.0, 0.0, 0.0, 0.0,
+            0.0, 0.0, 0.0, 0.0,
+            0.0, -7.29, 68.04, -255.15,
+            451.98, -374.22, 116.64, 0.0,
+            0.0, -10.24, 44.373333333333335, -54.4,
+            1.28, 34.346666666666664, -15.36, 0.0,
+            0.0, -27.30666666666667, 209.35111111111112, -614.4,
+            873.8133333333334, -605.2977777777778, 163.84, 0.0;
 }
 
 //! Initialize RK87 (Dormand and Prince) coefficients.
@@ -409,6 +597,123 @@ void initializerungeKutta87DormandPrinceCoefficients(
     rungeKutta87DormandPrinceCoefficients.bCoefficients( 1, 10 ) = 118820643.0 / 751138087.0;
     rungeKutta87DormandPrinceCoefficients.bCoefficients( 1, 11 ) = -528747749.0 / 2220607170.0;
     rungeKutta87DormandPrinceCoefficients.bCoefficients( 1, 12 ) = 1.0 / 4.0;
+
+    // Define dense output coefficients, giving a continuous extension of order 7 of the integrated estimate.
+    rungeKutta87DormandPrinceCoefficients.denseOutputOrder = 7;
+
+    // Define a-coefficients of the additional stages that are used for the dense output (w.r.t. all preceding stages).
+    // The first additional stage is the state derivative at the end of the step.
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients = Eigen::MatrixXd::Zero( 5, 17 );
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients.block( 0, 0, 1, 13 ) =
+            rungeKutta87DormandPrinceCoefficients.bCoefficients.row( 1 );
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 0 ) = 0.052837880946818544;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 1 ) = 3.660802519854165e-16;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 2 ) = 1.4739580515508015e-15;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 3 ) = 1.6681047621078158e-15;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 4 ) = 1.059041230270529e-16;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 5 ) = 0.07664676432903363;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 6 ) = 0.19900647303343239;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 7 ) = 0.10636098055755082;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 8 ) = -0.1440139706915945;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 9 ) = 0.031156038936226607;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 10 ) = 0.02973528118488306;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 11 ) = -0.030307601106321327;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 12 ) = 0.034750057981904406;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 1, 13 ) = -0.022838571838603883;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 0 ) = 0.0407965087876696;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 1 ) = 1.0769512735424611e-16;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 2 ) = -4.4154472606382267e-16;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 3 ) = 2.453993241610503e-16;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 4 ) = 3.097623320677787e-16;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 5 ) = -0.045324862723594615;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 6 ) = 0.24141829012024274;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 7 ) = 0.4979484778738069;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 8 ) = -0.2952339983457136;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 9 ) = 0.21232611244821697;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 10 ) = -0.01191863990479711;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 11 ) = 0.006703258626898121;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 12 ) = -0.030528589955430764;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 13 ) = 0.028257887517146554;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 2, 14 ) = 0.02222222222222169;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 0 ) = 0.046001904721296345;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 1 ) = 4.107565313394085e-17;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 2 ) = 4.4859712216042374e-17;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 3 ) = -6.831170126852298e-16;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 4 ) = 2.1931945620604024e-17;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 5 ) = -0.03262116147322216;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 6 ) = 0.21335416895329556;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 7 ) = 0.24432338400668716;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 8 ) = -0.17299597283427667;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 9 ) = 0.08154176376909655;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 10 ) = -0.011271158597606225;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 11 ) = 0.024952081603444295;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 12 ) = -0.024535010148714058;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 13 ) = 0.004687499999999983;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 3, 14 ) = 0.1265624999999998;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 0 ) = 0.046055415146197806;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 1 ) = -1.453354941392381e-17;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 2 ) = 3.442400804563917e-16;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 3 ) = -1.93586907385053e-16;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 4 ) = -8.130340006434591e-17;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 5 ) = 0.02937298578935646;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 6 ) = 0.20776557055831296;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 7 ) = 0.05171719105165248;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 8 ) = -0.0459476403782214;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 9 ) = 0.01482045169193781;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 10 ) = -0.0006692872042042034;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 11 ) = 0.01182636793089703;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 12 ) = -0.002245742085929341;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 13 ) = -0.009301757812499926;
+    rungeKutta87DormandPrinceCoefficients.denseOutputACoefficients( 4, 14 ) = -0.05339355468749973;
+
+    // Define c-coefficients of the additional stages that are used for the dense output.
+    rungeKutta87DormandPrinceCoefficients.denseOutputCCoefficients = Eigen::VectorXd::Zero( 5 );
+    rungeKutta87DormandPrinceCoefficients.denseOutputCCoefficients( 0 ) = 1.0;
+    rungeKutta87DormandPrinceCoefficients.denseOutputCCoefficients( 1 ) = 1.0 / 3.0;
+    rungeKutta87DormandPrinceCoefficients.denseOutputCCoefficients( 2 ) = 2.0 / 3.0;
+    rungeKutta87DormandPrinceCoefficients.denseOutputCCoefficients( 3 ) = 1.0 / 2.0;
+    rungeKutta87DormandPrinceCoefficients.denseOutputCCoefficients( 4 ) = 1.0 / 4.0;
+
+    // Define coefficients of the polynomial weights of the dense output, with one row per stage (regular stages
+    // followed by additional stages) and one column per power of theta (from 1 to 8).
+    rungeKutta87DormandPrinceCoefficients.denseOutputBCoefficients = Eigen::MatrixXd( 18, 8 );
+    rungeKutta87DormandPrinceCoefficients.denseOutputBCoefficients <<
+            1.0, -8.588398102855704, 35.603274252385596, -78.67338714635247,
+            94.92164103584466, -59.000094284224, 14.776811330662348, 0.0019004056810884864,
+            0.0, -1.7293606333241445e-15, 1.7464622156876663e-14, -6.280706944830935e-14,
+            1.120577859872243e-13, -9.547577293153062e-14, 3.08072502069642e-14, -1.4475312652458558e-16,
+            0.0, 6.220833246373317e-15, -1.0613047632658884e-13, 5.681935487702855e-13,
+            -1.229731453324455e-12, 1.180531369467037e-12, -4.1414342923098975e-13, -7.955997582301548e-16,
+            0.0, 1.2630695064818164e-13, -1.3362684052076444e-12, 5.449726150238128e-12,
+            -1.0429802495197603e-11, 9.324228499590954e-12, -3.1194143051357108e-12, 1.0380883785505095e-15,
+            0.0, 1.3354855497495923e-14, -9.201505724640995e-14, 2.7075516143490685e-13,
+            -4.0502290941755314e-13, 3.0324321342388937e-13, -9.004917197898726e-14, -5.1447754527498554e-17,
+            0.0, 12.857028303452534, -88.73185131458003, 252.72709477593597,
+            -365.60264927320424, 263.3986031078573, -74.82416937654895, 0.12049144847625756,
+            0.0, 25.229529284071045, -162.47739186341127, 433.994405316553,
+            -581.0332696164394, 385.5092244010643, -100.97197514878297, -0.0112095658535097,
+            0.0, 5.9285001833487865, -33.6117434061419, 86.36733639221187,
+            -107.5891130639006, 65.53038121588705, -15.646967523079123, -0.2748831289228776,
+            0.0, 2.4568663709954457, -16.833514722451028, 34.840068505358275,
+            -32.214856964442, 9.919439851621682, 0.7937156444199858, 0.27852170068341503,
+            0.0, 6.475579746448459, -49.53053744219244, 167.20562008745782,
+            -280.9214569731921, 230.47222229131867, -72.91884103324392, -0.12202364567429319,
+            0.0, 0.8934221420698583, -11.561360820540889, 51.76427144251007,
+            -104.17112365155712, 95.9473540554155, -32.7266518158335, 0.012276130446210377,
+            0.0, -2.273063588535424, 25.463046600361064, -105.87323070998677,
+            205.14948915590065, -184.8769557711439, 62.21663913391679, -0.044034359265297224,
+            0.0, 1.350535661005736, -19.666587950101288, 91.19782133632978,
+            -186.79866064903837, 173.70649179889324, -59.578561211518085, 0.03896101442900907,
+            0.0, 0.5066666666666997, -0.4177777777780762, -9.599999999998888,
+            31.186666666664642, -35.43555555555378, 13.759999999999406, 1.042473073118712e-16,
+            0.0, 2.758461897053046e-13, -2.3955201206640512e-12, 8.681764408939108e-12,
+            -1.54952296995403e-11, 1.3344564897367297e-11, -4.402903303669071e-12, 5.234628185728603e-16,
+            0.0, -7.290000000000172, 68.04000000000143, -255.15000000000495,
+            451.9800000000086, -374.2200000000073, 116.64000000000237, -5.126634133710345e-16,
+            0.0, -10.240000000000434, 44.37333333333691, -54.40000000001239,
+            1.2800000000214917, 34.34666666664846, -15.359999999994026, -1.2424953723839815e-15,
+            0.0, -27.306666666667248, 209.35111111111584, -614.4000000000162,
+            873.8133333333612, -605.2977777778012, 163.84000000000765, -1.7542430320238772e-15;
 }
 
 //! Get coefficients for a specified coefficient set
@@ -206,7 +206,13 @@ std::shared_ptr< aerodynamics::AtmosphereModel > createAtmosphereModel(
                 std::bind( &tudat::aerodynamics::nrlmsiseInputFunction,
                            std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4,
                            solarActivityData, false, TUDAT_NAN );
-        atmosphereModel = std::make_shared< aerodynamics::NRLMSISE00Atmosphere >( inputFunction );
+        std::shared_ptr< aerodynamics::NRLMSISE00Atmosphere > nrlmsise00Atmosphere =
+                std::make_shared< aerodynamics::NRLMSISE00Atmosphere >( inputFunction );
+        if( nrlmsise00AtmosphereSettings != nullptr )
+        {
+            nrlmsise00Atmosphere->setDensityGridCache( nrlmsise00AtmosphereSettings->getDensityGridCacheSettings( ) );
+        }
+        atmosphereModel = nrlmsise00Atmosphere;
         break;
     }
 #endif
@@ -193,10 +193,25 @@ std::shared_ptr< ephemerides::RotationalEphemeris > createRotationModel(
             std::shared_ptr< earth_orientation::EarthOrientationAnglesCalculator > earthOrientationCalculator =
                     std::make_shared< earth_orientation::EarthOrientationAnglesCalculator >(
                         polarMotionCalculator, precessionNutationCalculator, terrestrialTimeScaleConverter );
-            rotationalEphemeris = std::make_shared< ephemerides::GcrsToItrsRotationModel >(
+            std::shared_ptr< ephemerides::GcrsToItrsRotationModel > gcrsToItrsRotationModel =
+                    std::make_shared< ephemerides::GcrsToItrsRotationModel >(
                         earthOrientationCalculator, gcrsToItrsRotationSettings->getInputTimeScale( ),
                         gcrsToItrsRotationSettings->getOriginalFrame( ) );
 
+            // Precompute earth orientation angles, if required
+            if( gcrsToItrsRotationSettings->getTabulateEarthOrientationAngles( ) )
+            {
+                gcrsToItrsRotationModel->setTabulatedAnglesCalculator(
+                            std::make_shared< earth_orientation::TabulatedEarthOrientationAnglesCalculator >(
+                                earthOrientationCalculator,
+                                gcrsToItrsRotationSettings->getTabulationStartTime( ),
+                                gcrsToItrsRotationSettings->getTabulationEndTime( ),
+                                gcrsToItrsRotationSettings->getTabulationTimeStep( ),
+                                gcrsToItrsRotationSettings->getInputTimeScale( ),
+                                gcrsToItrsRotationSettings->getNumberOfInterpolationPoints( ) ) );
+            }
+            rotationalEphemeris = gcrsToItrsRotationModel;
+
             break;
         }
 
@@ -384,6 +384,9 @@ createSphericalHarmonicsGravityAcceleration(
                     std::bind( &Body::getPositionByReference, bodyExertingAcceleration, std::placeholders::_1 ),
                       std::bind( &Body::getCurrentRotationToGlobalFrame,
                                  bodyExertingAcceleration ), useCentralBodyFixedFrame );
+            accelerationModel->setCoefficientUpdateCounterFunction(
+                        std::bind( &SphericalHarmonicsGravityField::getCoefficientUpdateCounter,
+                                   sphericalHarmonicsGravityField ) );
         }
     }
     return accelerationModel;
@@ -872,9 +875,20 @@ std::shared_ptr< SolarSailAcceleration > createSolarSailAccelerationModel(
 
 }
 
+//! Function to compute the state of one body w.r.t. another
+Eigen::Vector6d getRelativeBodyState(
+        const std::shared_ptr< Body > body,
+        const std::shared_ptr< Body > referenceBody )
+{
+    return body->getState( ) - referenceBody->getState( );
+}
+
 std::shared_ptr< basic_astrodynamics::CustomAccelerationModel > createCustomAccelerationModel(
         const std::shared_ptr< AccelerationSettings > accelerationSettings,
-        const std::string& nameOfBodyUndergoingAcceleration )
+        const std::shared_ptr< Body > bodyUndergoingAcceleration,
+        const std::shared_ptr< Body > bodyExertingAcceleration,
+        const std::string& nameOfBodyUndergoingAcceleration,
+        const std::string& nameOfBodyExertingAcceleration )
 {
     std::shared_ptr< CustomAccelerationSettings > customAccelerationSettings =
             std::dynamic_pointer_cast< CustomAccelerationSettings >(
@@ -884,8 +898,25 @@ std::shared_ptr< basic_astrodynamics::CustomAccelerationModel > createCustomAcce
         throw std::runtime_error( "Error, expected custom acceleration settings when making acceleration model on " +
                                   nameOfBodyUndergoingAcceleration  );
     }
-    return std::make_shared< CustomAccelerationModel >( customAccelerationSettings->accelerationFunction_ );
 
+    if( customAccelerationSettings->stateDependentAccelerationFunction_ == nullptr )
+    {
+        return std::make_shared< CustomAccelerationModel >( customAccelerationSettings->accelerationFunction_ );
+    }
+    else
+    {
+        // State-dependent custom acceleration is defined w.r.t. the body exerting the acceleration
+        if( nameOfBodyUndergoingAcceleration == nameOfBodyExertingAcceleration )
+        {
+            throw std::runtime_error( "Error when making state-dependent custom acceleration on " +
+                                      nameOfBodyUndergoingAcceleration + ", body exerting acceleration must be different "
+                                      "from body undergoing acceleration" );
+        }
+        return std::make_shared< CustomAccelerationModel >(
+                    customAccelerationSettings->stateDependentAccelerationFunction_,
+                    customAccelerationSettings->differentiableAccelerationFunction_,
+                    std::bind( &getRelativeBodyState, bodyUndergoingAcceleration, bodyExertingAcceleration ) );
+    }
 }
 
 //! Function to create an orbiter relativistic correction acceleration model
@@ -1310,6 +1341,204 @@ std::shared_ptr< propulsion::MomentumWheelDesaturationThrustAcceleration > creat
                 desaturationAccelerationSettings->maneuverRiseTime_ );
 }
 
+//! Function to create point mass gravity accelerations on a set of bodies due to a set of bodies, evaluated in one pass
+std::vector< std::vector< std::shared_ptr< gravitation::ManyBodyPointMassGravityAcceleration > > >
+createManyBodyPointMassGravityAccelerationModels(
+        const std::vector< std::shared_ptr< Body > >& bodiesUndergoingAcceleration,
+        const std::vector< std::shared_ptr< Body > >& bodiesExertingAcceleration,
+        const std::vector< std::string >& namesOfBodiesUndergoingAcceleration,
+        const std::vector< std::string >& namesOfBodiesExertingAcceleration,
+        const std::shared_ptr< Body > centralBody,
+        const std::string& nameOfCentralBody )
+{
+    if( bodiesUndergoingAcceleration.size( ) != namesOfBodiesUndergoingAcceleration.size( ) ||
+            bodiesExertingAcceleration.size( ) != namesOfBodiesExertingAcceleration.size( ) )
+    {
+        throw std::runtime_error( "Error when making many-body point mass gravity accelerations, input sizes are inconsistent" );
+    }
+
+    // Retrieve properties of bodies exerting acceleration, and determine which accelerations are third-body accelerations
+    bool isCentralBodyInertial = ephemerides::isFrameInertial( nameOfCentralBody );
+    bool isAnyAccelerationThirdBody = false;
+    int centralBodyIndex = -1;
+
+    std::vector< std::function< void( Eigen::Vector3d& ) > > exertingBodyPositionFunctions;
+    std::vector< std::function< double( ) > > exertingBodyGravitationalParameterFunctions;
+    std::vector< bool > isThirdBodyAcceleration;
+    for( unsigned int j = 0; j < bodiesExertingAcceleration.size( ); j++ )
+    {
+        if( bodiesExertingAcceleration.at( j )->getGravityFieldModel( ) == nullptr )
+        {
+            throw std::runtime_error(
+                        "Error, gravity field model not set when making many-body point mass gravitational acceleration "
+                        "of " + namesOfBodiesExertingAcceleration.at( j ) );
+        }
+        exertingBodyPositionFunctions.push_back(
+                    std::bind( &Body::getPositionByReference, bodiesExertingAcceleration.at( j ), std::placeholders::_1 ) );
+        exertingBodyGravitationalParameterFunctions.push_back(
+                    std::bind( &gravitation::GravityFieldModel::getGravitationalParameter,
+                               bodiesExertingAcceleration.at( j )->getGravityFieldModel( ) ) );
+
+        if( namesOfBodiesExertingAcceleration.at( j ) == nameOfCentralBody )
+        {
+            centralBodyIndex = j;
+            isThirdBodyAcceleration.push_back( false );
+        }
+        else
+        {
+            isThirdBodyAcceleration.push_back( !isCentralBodyInertial );
+            isAnyAccelerationThirdBody = isAnyAccelerationThirdBody || !isCentralBodyInertial;
+        }
+    }
+
+    // Use sum of gravitational parameters for direct acceleration due to central body, if available
+    std::vector< std::function< double( ) > > undergoingBodyGravitationalParameterFunctions(
+                bodiesUndergoingAcceleration.size( ) );
+    if( centralBodyIndex >= 0 )
+    {
+        for( unsigned int i = 0; i < bodiesUndergoingAcceleration.size( ); i++ )
+        {
+            if( bodiesUndergoingAcceleration.at( i )->getGravityFieldModel( ) != nullptr )
+            {
+                undergoingBodyGravitationalParameterFunctions[ i ] =
+                        std::bind( &gravitation::GravityFieldModel::getGravitationalParameter,
+                                   bodiesUndergoingAcceleration.at( i )->getGravityFieldModel( ) );
+            }
+        }
+    }
+
+    std::function< void( Eigen::Vector3d& ) > centralBodyPositionFunction =
+            [ ]( Eigen::Vector3d& input ){ input = Eigen::Vector3d::Zero( ); };
+    if( isAnyAccelerationThirdBody )
+    {
+        if( centralBody == nullptr )
+        {
+            throw std::runtime_error( "Error when making many-body point mass gravity accelerations, central body " +
+                                      nameOfCentralBody + " not found." );
+        }
+        centralBodyPositionFunction =
+                std::bind( &Body::getPositionByReference, centralBody, std::placeholders::_1 );
+    }
+
+    // Create kernel, retrieving positions of all bodies undergoing acceleration in a single block
+    std::vector< std::shared_ptr< Body > > undergoingBodies = bodiesUndergoingAcceleration;
+    std::shared_ptr< gravitation::ManyBodyPointMassGravityKernel > accelerationKernel =
+            std::make_shared< gravitation::ManyBodyPointMassGravityKernel >(
+                [ = ]( Eigen::MatrixX3d& positions )
+    {
+        for( unsigned int i = 0; i < undergoingBodies.size( ); i++ )
+        {
+            positions.row( i ) = undergoingBodies[ i ]->getPosition( ).transpose( );
+        }
+    }, static_cast< int >( bodiesUndergoingAcceleration.size( ) ), exertingBodyPositionFunctions,
+                exertingBodyGravitationalParameterFunctions, isThirdBodyAcceleration, centralBodyPositionFunction,
+                centralBodyIndex, undergoingBodyGravitationalParameterFunctions );
+
+    // Create acceleration models for each pair of bodies
+    std::vector< std::vector< std::shared_ptr< gravitation::ManyBodyPointMassGravityAcceleration > > > accelerationModels;
+    accelerationModels.resize( bodiesUndergoingAcceleration.size( ) );
+    for( unsigned int i = 0; i < bodiesUndergoingAcceleration.size( ); i++ )
+    {
+        for( unsigned int j = 0; j < bodiesExertingAcceleration.size( ); j++ )
+        {
+            accelerationModels[ i ].push_back(
+                        std::make_shared< gravitation::ManyBodyPointMassGravityAcceleration >(
+                            accelerationKernel, i, j, nameOfCentralBody ) );
+        }
+    }
+    return accelerationModels;
+}
+
+//! Function to create all many-body point mass gravity accelerations from a list of acceleration settings
+std::map< std::pair< std::string, std::string >, std::shared_ptr< gravitation::ManyBodyPointMassGravityAcceleration > >
+createManyBodyPointMassGravityAccelerationModels(
+        const SystemOfBodies& bodies,
+        const SelectedAccelerationList& orderedAccelerationPerBody,
+        const std::map< std::string, std::string >& centralBodies )
+{
+    // Group bodies undergoing acceleration by central body and list of bodies exerting acceleration
+    std::map< std::pair< std::string, std::vector< std::string > >, std::vector< std::string > > undergoingBodiesPerGroup;
+    for( auto bodyIterator : orderedAccelerationPerBody )
+    {
+        std::vector< std::string > exertingBodies;
+        for( unsigned int i = 0; i < bodyIterator.second.size( ); i++ )
+        {
+            if( bodyIterator.second.at( i ).second->accelerationType_ == many_body_point_mass_gravity )
+            {
+                exertingBodies.push_back( bodyIterator.second.at( i ).first );
+            }
+        }
+
+        if( exertingBodies.size( ) > 0 )
+        {
+            std::sort( exertingBodies.begin( ), exertingBodies.end( ) );
+            if( std::adjacent_find( exertingBodies.begin( ), exertingBodies.end( ) ) != exertingBodies.end( ) )
+            {
+                throw std::runtime_error( "Error when making many-body point mass gravity accelerations, multiple "
+                                          "accelerations due to same body requested on " + bodyIterator.first );
+            }
+            undergoingBodiesPerGroup[ std::make_pair( centralBodies.at( bodyIterator.first ), exertingBodies ) ].
+                    push_back( bodyIterator.first );
+        }
+    }
+
+    // Create accelerations for each group
+    std::map< std::pair< std::string, std::string >, std::shared_ptr< gravitation::ManyBodyPointMassGravityAcceleration > >
+            accelerationModels;
+    for( auto groupIterator : undergoingBodiesPerGroup )
+    {
+        std::string centralBodyName = groupIterator.first.first;
+        std::vector< std::string > namesOfBodiesExertingAcceleration = groupIterator.first.second;
+        std::vector< std::string > namesOfBodiesUndergoingAcceleration = groupIterator.second;
+
+        std::vector< std::shared_ptr< Body > > bodiesUndergoingAcceleration;
+        for( unsigned int i = 0; i < namesOfBodiesUndergoingAcceleration.size( ); i++ )
+        {
+            if( bodies.count( namesOfBodiesUndergoingAcceleration.at( i ) ) == 0 )
+            {
+                throw std::runtime_error(
+                            "Error when making many-body point mass gravity accelerations, requested forces acting on body " +
+                            namesOfBodiesUndergoingAcceleration.at( i ) + ", but no such body found in map of bodies" );
+            }
+            bodiesUndergoingAcceleration.push_back( bodies.at( namesOfBodiesUndergoingAcceleration.at( i ) ) );
+        }
+
+        std::vector< std::shared_ptr< Body > > bodiesExertingAcceleration;
+        for( unsigned int j = 0; j < namesOfBodiesExertingAcceleration.size( ); j++ )
+        {
+            if( bodies.count( namesOfBodiesExertingAcceleration.at( j ) ) == 0 )
+            {
+                throw std::runtime_error(
+                            "Error when making many-body point mass gravity accelerations, requested forces due to body " +
+                            namesOfBodiesExertingAcceleration.at( j ) + ", but no such body found in map of bodies" );
+            }
+            bodiesExertingAcceleration.push_back( bodies.at( namesOfBodiesExertingAcceleration.at( j ) ) );
+        }
+
+        std::shared_ptr< Body > centralBody;
+        if( bodies.count( centralBodyName ) > 0 )
+        {
+            centralBody = bodies.at( centralBodyName );
+        }
+
+        std::vector< std::vector< std::shared_ptr< gravitation::ManyBodyPointMassGravityAcceleration > > >
+                groupAccelerationModels = createManyBodyPointMassGravityAccelerationModels(
+                    bodiesUndergoingAcceleration, bodiesExertingAcceleration,
+                    namesOfBodiesUndergoingAcceleration, namesOfBodiesExertingAcceleration,
+                    centralBody, centralBodyName );
+        for( unsigned int i = 0; i < namesOfBodiesUndergoingAcceleration.size( ); i++ )
+        {
+            for( unsigned int j = 0; j < namesOfBodiesExertingAcceleration.size( ); j++ )
+            {
+                accelerationModels[ std::make_pair( namesOfBodiesUndergoingAcceleration.at( i ),
+                                                    namesOfBodiesExertingAcceleration.at( j ) ) ] =
+                        groupAccelerationModels.at( i ).at( j );
+            }
+        }
+    }
+    return accelerationModels;
+}
+
 //! Function to create acceleration model object.
 std::shared_ptr< AccelerationModel< Eigen::Vector3d > > createAccelerationModel(
         const std::shared_ptr< Body > bodyUndergoingAcceleration,
@@ -1422,7 +1651,16 @@ std::shared_ptr< AccelerationModel< Eigen::Vector3d > > createAccelerationModel(
     case custom_acceleration:
         accelerationModelPointer = createCustomAccelerationModel(
                     accelerationSettings,
-                    nameOfBodyUndergoingAcceleration );
+                    bodyUndergoingAcceleration,
+                    bodyExertingAcceleration,
+                    nameOfBodyUndergoingAcceleration,
+                    nameOfBodyExertingAcceleration );
+        break;
+    case many_body_point_mass_gravity:
+        accelerationModelPointer = createManyBodyPointMassGravityAccelerationModels(
+                    { bodyUndergoingAcceleration }, { bodyExertingAcceleration },
+                    { nameOfBodyUndergoingAcceleration }, { nameOfBodyExertingAcceleration },
+                    centralBody, nameOfCentralBody ).at( 0 ).at( 0 );
         break;
     default:
         throw std::runtime_error(
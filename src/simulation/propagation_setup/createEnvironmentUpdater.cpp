@@ -481,6 +481,26 @@ createTranslationalEquationsOfMotionEnvironmentUpdaterSettings(
                     break;
                 case custom_acceleration:
                     break;
+                case many_body_point_mass_gravity:
+                {
+                    std::shared_ptr< gravitation::ManyBodyPointMassGravityAcceleration >
+                            manyBodyAcceleration = std::dynamic_pointer_cast<
+                            gravitation::ManyBodyPointMassGravityAcceleration >(
+                                accelerationModelIterator->second.at( i ) );
+                    if( manyBodyAcceleration == nullptr )
+                    {
+                        throw std::runtime_error(
+                                    std::string( "Error, incompatible input (ManyBodyPointMassGravityAcceleration) to" )
+                                    + std::string(  "createTranslationalEquationsOfMotionEnvironmentUpdaterSettings" ) );
+                    }
+                    else if( manyBodyAcceleration->getIsThirdBodyAcceleration( ) &&
+                             translationalAccelerationModels.count( manyBodyAcceleration->getCentralBodyName( ) ) == 0 )
+                    {
+                        singleAccelerationUpdateNeeds[ body_translational_state_update ].push_back(
+                                    manyBodyAcceleration->getCentralBodyName( ) );
+                    }
+                    break;
+                }
                 default:
                     throw std::runtime_error( std::string( "Error when setting acceleration model update needs, model type not recognized: " ) +
                                               std::to_string( currentAccelerationModelType ) );
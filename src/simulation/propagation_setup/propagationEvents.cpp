@@ -0,0 +1,94 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+
+#include "tudat/simulation/propagation_setup/propagationEvents.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Function to check whether the event function crosses zero (in the required direction) between two values
+bool PropagationEventCondition::isEventCrossing(
+        const double previousValue, const double currentValue, const bool propagationIsForwards )
+{
+    // Check if event function changes sign (a zero at the start of the interval was detected in the previous interval)
+    if( !( ( previousValue < 0.0 && currentValue >= 0.0 ) || ( previousValue > 0.0 && currentValue <= 0.0 ) ) )
+    {
+        return false;
+    }
+
+    // Check direction of crossing, as a function of time
+    bool isIncreasing = ( ( currentValue > previousValue ) == propagationIsForwards );
+    switch( crossingDirection_ )
+    {
+    case increasing_event_crossing:
+        return isIncreasing;
+    case decreasing_event_crossing:
+        return !isIncreasing;
+    case any_event_crossing:
+        return true;
+    default:
+        throw std::runtime_error( "Error when checking propagation event crossing, direction not recognized" );
+    }
+}
+
+//! Function to compute the current values of all event functions
+std::vector< double > PropagationEventDetector::getEventFunctionValues( )
+{
+    std::vector< double > eventFunctionValues;
+    eventFunctionValues.reserve( eventConditions_.size( ) );
+    for( unsigned int i = 0; i < eventConditions_.size( ); i++ )
+    {
+        eventFunctionValues.push_back( eventConditions_.at( i )->getEventFunctionValue( ) );
+    }
+    return eventFunctionValues;
+}
+
+//! Function to reset the detector at the start of a propagation
+void PropagationEventDetector::resetEventFunctionValues( )
+{
+    eventOccurrences_.clear( );
+    previousEventFunctionValues_ = getEventFunctionValues( );
+}
+
+//! Function to add the events detected in a single integration step
+void PropagationEventDetector::addEventOccurrences(
+        std::vector< PropagationEventOccurrence > stepEventOccurrences, const bool propagationIsForwards )
+{
+    std::stable_sort( stepEventOccurrences.begin( ), stepEventOccurrences.end( ),
+                      [ = ]( const PropagationEventOccurrence& firstEvent, const PropagationEventOccurrence& secondEvent )
+    {
+        return propagationIsForwards ? ( firstEvent.eventTime_ < secondEvent.eventTime_ ) :
+                                       ( firstEvent.eventTime_ > secondEvent.eventTime_ );
+    } );
+    eventOccurrences_.insert( eventOccurrences_.end( ), stepEventOccurrences.begin( ), stepEventOccurrences.end( ) );
+}
+
+//! Function to remove all detected events that occur after a given time
+void PropagationEventDetector::removeEventOccurrencesAfterTime( const double finalTime, const bool propagationIsForwards )
+{
+    eventOccurrences_.erase(
+                std::remove_if( eventOccurrences_.begin( ), eventOccurrences_.end( ),
+                                [ = ]( const PropagationEventOccurrence& eventOccurrence )
+    {
+        // Unresolved events may occur anywhere in their bracketing interval
+        double earliestEventTime = eventOccurrence.isEventResolved_ ?
+                    eventOccurrence.eventTime_ : eventOccurrence.bracketingInterval_.first;
+        return propagationIsForwards ? ( earliestEventTime > finalTime ) : ( earliestEventTime < finalTime );
+    } ), eventOccurrences_.end( ) );
+}
+
+} // namespace propagators
+
+} // namespace tudat
@@ -16,6 +16,7 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 
+
 #include <boost/array.hpp>
 #include <boost/make_shared.hpp>
 #include <memory>
@@ -392,6 +393,111 @@ BOOST_AUTO_TEST_CASE( testApolloCapsule )
                        toleranceAerodynamicCoefficients5 );
 }
 
+//! Test parallel generation of Apollo capsule coefficients, and incremental regeneration for new Mach number points.
+BOOST_AUTO_TEST_CASE( testParallelAndIncrementalCoefficientGeneration )
+{
+    // Generate coefficients sequentially and concurrently.
+    std::shared_ptr< HypersonicLocalInclinationAnalysis > serialCoefficientInterface =
+            unit_tests::getApolloCoefficientInterface( 1 );
+    std::shared_ptr< HypersonicLocalInclinationAnalysis > parallelCoefficientInterface =
+            unit_tests::getApolloCoefficientInterface( 4 );
+
+    int numberOfMachPoints = serialCoefficientInterface->getNumberOfValuesOfIndependentVariable( 0 );
+    int numberOfAngleOfAttackPoints = serialCoefficientInterface->getNumberOfValuesOfIndependentVariable( 1 );
+    int numberOfAngleOfSideslipPoints = serialCoefficientInterface->getNumberOfValuesOfIndependentVariable( 2 );
+
+    // Check that concurrently generated coefficients are identical to sequentially generated coefficients.
+    boost::array< int, 3 > independentVariables;
+    for( int i = 0; i < numberOfMachPoints; i++ )
+    {
+        for( int j = 0; j < numberOfAngleOfAttackPoints; j++ )
+        {
+            for( int k = 0; k < numberOfAngleOfSideslipPoints; k++ )
+            {
+                independentVariables = { { i, j, k } };
+                Vector6d serialCoefficients =
+                        serialCoefficientInterface->getAerodynamicCoefficientsDataPoint( independentVariables );
+                Vector6d parallelCoefficients =
+                        parallelCoefficientInterface->getAerodynamicCoefficientsDataPoint( independentVariables );
+                for( int l = 0; l < 6; l++ )
+                {
+                    BOOST_CHECK_EQUAL( serialCoefficients( l ), parallelCoefficients( l ) );
+                }
+            }
+        }
+    }
+
+    // Compare to coefficients computed with (nested container-based) implementation prior to panel data flattening.
+    std::vector< boost::array< int, 3 > > referenceIndependentVariables =
+    { { { 5, 6, 0 } }, { { 0, 0, 1 } }, { { 3, 10, 1 } }, { { 2, 14, 0 } } };
+    std::vector< Vector6d > referenceCoefficients( 4 );
+    referenceCoefficients[ 0 ] << -1.5809104718174321, -4.0649833434384503e-17, -2.5940176241138271e-17,
+            -3.9960926461543935e-18, 0.055329441556346642, 1.8579167356410817e-17;
+    referenceCoefficients[ 1 ] << -1.2780861072594383, -0.0052230447655297225, 0.1513075029266478,
+            -0.0001827985551695075, 0.09732767553720563, 0.0018440027885634075;
+    referenceCoefficients[ 2 ] << -1.4200478254894249, -0.0039585428485510322, -0.077653826480912708,
+            -0.00013854292769368469, 0.0059908757498391653, 0.0022316760911277466;
+    referenceCoefficients[ 3 ] << -0.99049533569898895, -9.3285598460696479e-18, -0.15880283345994634,
+            7.4718812615226701e-19, -0.028333459132318297, 2.3429292723704664e-17;
+    for( unsigned int i = 0; i < referenceIndependentVariables.size( ); i++ )
+    {
+        Vector6d parallelCoefficients =
+                parallelCoefficientInterface->getAerodynamicCoefficientsDataPoint( referenceIndependentVariables.at( i ) );
+        for( int l = 0; l < 6; l++ )
+        {
+            BOOST_CHECK_SMALL( parallelCoefficients( l ) - referenceCoefficients.at( i )( l ), 1.0E-13 );
+        }
+    }
+
+    // Reset Mach number points, and check that panel inclinations are reused.
+    unsigned int numberOfInclinationSets = parallelCoefficientInterface->getNumberOfComputedInclinationSets( );
+    BOOST_CHECK_EQUAL( numberOfInclinationSets, numberOfAngleOfAttackPoints * numberOfAngleOfSideslipPoints );
+
+    std::vector< double > originalMachNumberPoints = parallelCoefficientInterface->getDataPointsOfIndependentVariables( ).at( 0 );
+    std::vector< double > newMachNumberPoints = { originalMachNumberPoints.at( 1 ), 6.0, originalMachNumberPoints.at( 4 ) };
+    parallelCoefficientInterface->resetMachNumberPoints( newMachNumberPoints );
+
+    BOOST_CHECK_EQUAL( parallelCoefficientInterface->getNumberOfComputedInclinationSets( ), numberOfInclinationSets );
+    BOOST_CHECK_EQUAL( parallelCoefficientInterface->getNumberOfValuesOfIndependentVariable( 0 ), 3 );
+
+    // Check regenerated coefficients, and interpolator, at Mach number points of original analysis.
+    std::vector< double > independentVariablesVector( 3 );
+    for( int j = 0; j < numberOfAngleOfAttackPoints; j++ )
+    {
+        for( int k = 0; k < numberOfAngleOfSideslipPoints; k++ )
+        {
+            for( int i = 0; i < 2; i++ )
+            {
+                Vector6d serialCoefficients = serialCoefficientInterface->getAerodynamicCoefficientsDataPoint(
+                            { { ( i == 0 ) ? 1 : 4, j, k } } );
+                Vector6d resetCoefficients = parallelCoefficientInterface->getAerodynamicCoefficientsDataPoint(
+                            { { 2 * i, j, k } } );
+
+                independentVariablesVector[ 0 ] = newMachNumberPoints.at( 2 * i );
+                independentVariablesVector[ 1 ] = parallelCoefficientInterface->getIndependentVariablePoint( 1, j );
+                independentVariablesVector[ 2 ] = parallelCoefficientInterface->getIndependentVariablePoint( 2, k );
+                parallelCoefficientInterface->updateCurrentCoefficients( independentVariablesVector );
+                Vector6d interpolatedCoefficients = parallelCoefficientInterface->getCurrentAerodynamicCoefficients( );
+
+                for( int l = 0; l < 6; l++ )
+                {
+                    BOOST_CHECK_EQUAL( serialCoefficients( l ), resetCoefficients( l ) );
+                    BOOST_CHECK_SMALL( interpolatedCoefficients( l ) - resetCoefficients( l ), 1.0E-14 );
+                }
+            }
+
+            // Check that coefficients at new Mach number are between those at adjacent Mach numbers
+            Vector6d newMachNumberCoefficients = parallelCoefficientInterface->getAerodynamicCoefficientsDataPoint(
+                        { { 1, j, k } } );
+            BOOST_CHECK( ( newMachNumberCoefficients( 0 ) -
+                           serialCoefficientInterface->getAerodynamicCoefficientsDataPoint( { { 1, j, k } } )( 0 ) ) *
+                         ( newMachNumberCoefficients( 0 ) -
+                           serialCoefficientInterface->getAerodynamicCoefficientsDataPoint( { { 4, j, k } } )( 0 ) )
+                         <= 0.0 );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -0,0 +1,163 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+#include <boost/test/unit_test.hpp>
+
+#include "tudat/astro/aerodynamics/densityGridCache.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace aerodynamics;
+using mathematical_constants::PI;
+
+BOOST_AUTO_TEST_SUITE( test_density_grid_cache )
+
+//! Analytical density model, with scale height depending on latitude and diurnal variation
+double getTestDensity( const double altitude, const double localSolarTime, const double latitude )
+{
+    double scaleHeight = 60.0E3 * ( 1.0 + 0.1 * std::cos( 2.0 * latitude ) );
+    return 1.0E-12 * std::exp( -( altitude - 400.0E3 ) / scaleHeight ) *
+            ( 1.0 + 0.3 * std::cos( 2.0 * PI * ( localSolarTime - 14.0 ) / 24.0 ) ) *
+            ( 1.0 + 0.05 * std::sin( latitude ) );
+}
+
+//! Analytical density model of getTestDensity, with additional variation with time at constant local solar time
+double getTimeDependentTestDensity( const double altitude, const double localSolarTime, const double latitude,
+                                    const double timeOffset )
+{
+    return getTestDensity( altitude, localSolarTime, latitude ) *
+            ( 1.0 + 0.002 * std::sin( 2.0 * PI * timeOffset / 86400.0 + latitude ) );
+}
+
+//! Function to determine the maximum relative error of a density grid at a set of points that are independent of those
+//! used by the grid to estimate its error
+double getSampledMaximumRelativeError(
+        const DensityGridCache& densityGrid,
+        const std::function< double( const double, const double, const double, const double ) > densityFunction,
+        const double timeOffsetRange )
+{
+    double maximumRelativeError = 0.0;
+    for( int i = 0; i < 20000; i++ )
+    {
+        double altitude = 300.0E3 + 300.0E3 * std::fmod( i * 0.6180339887, 1.0 );
+        double localSolarTime = 24.0 * std::fmod( i * 0.4142135624, 1.0 );
+        double latitude = -PI / 2.0 + PI * std::fmod( i * 0.7320508076, 1.0 );
+        double timeOffset = timeOffsetRange * ( std::fmod( i * 0.2360679775, 1.0 ) - 0.5 );
+        maximumRelativeError = std::max(
+                    maximumRelativeError, std::fabs(
+                        densityGrid.getDensity( altitude, localSolarTime, latitude ) /
+                        densityFunction( altitude, localSolarTime, latitude, timeOffset ) - 1.0 ) );
+    }
+    return maximumRelativeError;
+}
+
+BOOST_AUTO_TEST_CASE( testDensityGridInterpolation )
+{
+    double linearError = TUDAT_NAN;
+    for( int interpolationType = 0; interpolationType < 2; interpolationType++ )
+    {
+        DensityGridCache densityGrid( DensityGridCacheSettings(
+                                          300.0E3, 600.0E3, 31, 24, 37,
+                                          static_cast< DensityGridInterpolationType >( interpolationType ) ) );
+        BOOST_CHECK( !densityGrid.isGridComputed( ) );
+        densityGrid.computeGrid( &getTestDensity );
+        BOOST_CHECK( densityGrid.isGridComputed( ) );
+        BOOST_CHECK_EQUAL( densityGrid.getNumberOfGridComputations( ), 1 );
+
+        // Check that density is reproduced at grid points
+        for( int i = 0; i < 31; i += 5 )
+        {
+            for( int j = 0; j < 24; j += 5 )
+            {
+                for( int k = 0; k < 37; k += 6 )
+                {
+                    double altitude = 300.0E3 + i * 10.0E3;
+                    double localSolarTime = static_cast< double >( j );
+                    double latitude = -PI / 2.0 + k * PI / 36.0;
+                    BOOST_CHECK_CLOSE_FRACTION( densityGrid.getDensity( altitude, localSolarTime, latitude ),
+                                                getTestDensity( altitude, localSolarTime, latitude ), 1.0E-13 );
+                }
+            }
+        }
+
+        // Check that the actual error at independent points is consistent with the estimated maximum error
+        double maximumRelativeError = densityGrid.getEstimatedMaximumRelativeError( );
+        double sampledMaximumRelativeError = getSampledMaximumRelativeError(
+                    densityGrid, [ ]( const double altitude, const double localSolarTime, const double latitude,
+                                      const double ){ return getTestDensity( altitude, localSolarTime, latitude ); },
+                    0.0 );
+        BOOST_CHECK( maximumRelativeError > 0.0 );
+        BOOST_CHECK_SMALL( sampledMaximumRelativeError, 1.05 * maximumRelativeError );
+        BOOST_CHECK( sampledMaximumRelativeError > 0.9 * maximumRelativeError );
+
+        // Check periodicity in local solar time
+        BOOST_CHECK_CLOSE_FRACTION( densityGrid.getDensity( 450.0E3, 23.7, 0.3 ),
+                                    densityGrid.getDensity( 450.0E3, -0.3, 0.3 ), 1.0E-14 );
+        BOOST_CHECK_CLOSE_FRACTION( densityGrid.getDensity( 450.0E3, 23.7, 0.3 ),
+                                    densityGrid.getDensity( 450.0E3, 47.7, 0.3 ), 1.0E-14 );
+
+        BOOST_CHECK( densityGrid.isAltitudeInGrid( 300.0E3 ) );
+        BOOST_CHECK( !densityGrid.isAltitudeInGrid( 299.0E3 ) );
+        BOOST_CHECK( !densityGrid.isAltitudeInGrid( 601.0E3 ) );
+
+        // Check that cubic interpolation is more accurate than linear interpolation
+        if( interpolationType == 0 )
+        {
+            linearError = maximumRelativeError;
+        }
+        else
+        {
+            BOOST_CHECK( maximumRelativeError < 0.1 * linearError );
+        }
+    }
+
+    // Check that the estimated error includes the time variation of the model, when the grid is used over a time interval
+    for( int interpolationType = 0; interpolationType < 2; interpolationType++ )
+    {
+        DensityGridCache densityGrid( DensityGridCacheSettings(
+                                          300.0E3, 600.0E3, 31, 24, 37,
+                                          static_cast< DensityGridInterpolationType >( interpolationType ) ) );
+        densityGrid.computeGrid( &getTimeDependentTestDensity, 86400.0 );
+
+        double maximumRelativeError = densityGrid.getEstimatedMaximumRelativeError( );
+        double sampledMaximumRelativeError = getSampledMaximumRelativeError(
+                    densityGrid, &getTimeDependentTestDensity, 86400.0 );
+        BOOST_CHECK( maximumRelativeError > 0.002 );
+        BOOST_CHECK_SMALL( sampledMaximumRelativeError, 1.05 * maximumRelativeError );
+        BOOST_CHECK( sampledMaximumRelativeError > 0.9 * maximumRelativeError );
+    }
+
+    // Check that exceeding the maximum allowed interpolation error is detected
+    DensityGridCache inaccurateDensityGrid( DensityGridCacheSettings(
+                                                300.0E3, 600.0E3, 4, 4, 4, linear_density_grid_interpolation, 1.0E-4 ) );
+    BOOST_CHECK_THROW( inaccurateDensityGrid.computeGrid( &getTestDensity ), std::runtime_error );
+
+    // Check that insufficient number of grid points is detected
+    BOOST_CHECK_THROW( DensityGridCache( DensityGridCacheSettings( 300.0E3, 600.0E3, 3 ) ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -1137,6 +1137,48 @@ BOOST_AUTO_TEST_CASE( test_nrlmise_FullFileLoad )
 
 }
 
+//! Test density interpolated from grid of precomputed densities against density computed directly from model
+BOOST_AUTO_TEST_CASE( test_nrlmise_DensityGridCache )
+{
+    std::string spaceWeatherFilePath = tudat::paths::getTudatTestDataPath( ) + "/sw19571001.txt";
+    tudat::input_output::solar_activity::SolarActivityDataMap solarActivityData =
+            tudat::input_output::solar_activity::readSolarActivityData( spaceWeatherFilePath );
+
+    std::function< tudat::aerodynamics::NRLMSISE00Input( double, double, double, double ) > inputFunction =
+            std::bind( &tudat::aerodynamics::nrlmsiseInputFunction, std::placeholders::_1, std::placeholders::_2,
+                       std::placeholders::_3, std::placeholders::_4, solarActivityData, false, TUDAT_NAN );
+
+    tudat::aerodynamics::NRLMSISE00Atmosphere atmosphereModel( inputFunction );
+    atmosphereModel.setDensityGridCache(
+                std::make_shared< tudat::aerodynamics::DensityGridCacheSettings >( 300.0E3, 600.0E3, 31 ) );
+
+    // Compare interpolated and model density during a single day (for which the model input is constant), and check that
+    // the actual error is consistent with the estimated maximum error of the grid
+    double julianDate = tudat::basic_astrodynamics::convertCalendarDateToJulianDay< double >( 2015, 3, 17, 0, 0, 0.0 );
+    double startTime = tudat::basic_astrodynamics::convertJulianDayToSecondsSinceEpoch(
+                julianDate, tudat::basic_astrodynamics::JULIAN_DAY_ON_J2000 );
+    for( int i = 0; i < 100; i++ )
+    {
+        double time = startTime + 863.0 * i;
+        double altitude = 300.0E3 + 3.0E3 * i;
+        double longitude = -PI + 2.0 * PI * std::fmod( i * 0.618034, 1.0 );
+        double latitude = -PI / 2.0 + PI * std::fmod( i * 0.414214, 1.0 );
+
+        double interpolatedDensity = atmosphereModel.getDensity( altitude, longitude, latitude, time );
+        double modelDensity = atmosphereModel.getReferenceDensity( altitude, longitude, latitude, time );
+        BOOST_CHECK_SMALL( interpolatedDensity / modelDensity - 1.0,
+                           1.1 * atmosphereModel.getDensityGridCache( )->getEstimatedMaximumRelativeError( ) );
+    }
+    BOOST_CHECK_EQUAL( atmosphereModel.getDensityGridCache( )->getNumberOfGridComputations( ), 1 );
+    BOOST_CHECK( atmosphereModel.getDensityGridCache( )->getEstimatedMaximumRelativeError( ) > 0.0 );
+
+    // Check that grid is recomputed for the next day, and model is used outside grid
+    atmosphereModel.getDensity( 400.0E3, 0.0, 0.0, startTime + 86400.0 + 3600.0 );
+    BOOST_CHECK_EQUAL( atmosphereModel.getDensityGridCache( )->getNumberOfGridComputations( ), 2 );
+    BOOST_CHECK_EQUAL( atmosphereModel.getDensity( 200.0E3, 0.1, 0.2, startTime ),
+                       atmosphereModel.getReferenceDensity( 200.0E3, 0.1, 0.2, startTime ) );
+}
+
 }
 
 } // namespace unit_tests
@@ -0,0 +1,190 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+#include "tudat/basics/testMacros.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+
+#include "tudat/astro/earth_orientation/earthOrientationCalculator.h"
+#include "tudat/astro/earth_orientation/tabulatedEarthOrientationCalculator.h"
+#include "tudat/astro/ephemerides/itrsToGcrsRotationModel.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace earth_orientation;
+
+BOOST_AUTO_TEST_SUITE( test_tabulated_earth_orientation )
+
+//! Conversion from arc seconds to radians
+const double arcSecondToRadian = 4.848136811095359935899141E-6;
+
+//! Upper bound of interpolation error in the earth orientation angles (see TabulatedEarthOrientationAnglesCalculator)
+const double angleInterpolationTolerance = 0.005E-6 * arcSecondToRadian;
+
+//! Upper bound of the rate of change of the UT1-dependent (short-period polar motion) terms in the angles
+const double maximumAngleRateFromUt1 = 0.5E-3 * arcSecondToRadian * 4.0 * mathematical_constants::PI / 86400.0;
+
+//! Function to compute the maximum round-off error in UT1 (double precision) at given time
+double getUt1RoundOffTolerance( const double time )
+{
+    return 2.0 * ( std::nextafter( time, std::numeric_limits< double >::infinity( ) ) - time ) + 1.0E-9;
+}
+
+//! Function to compute the tolerance for an earth orientation angle: interpolation error, and round-off of UT1 and angle
+double getAngleTolerance( const double time, const double angle )
+{
+    return angleInterpolationTolerance + maximumAngleRateFromUt1 * getUt1RoundOffTolerance( time ) +
+            10.0 * std::numeric_limits< double >::epsilon( ) * std::fabs( angle );
+}
+
+//! Test whether the tabulated earth orientation angles are equal to those computed directly, to within interpolation error
+BOOST_AUTO_TEST_CASE( testTabulatedEarthOrientationAngles )
+{
+    std::shared_ptr< EarthOrientationAnglesCalculator > earthOrientationCalculator =
+            createStandardEarthOrientationCalculator( );
+
+    // Tabulate angles over 3 days (including a day boundary of the IERS daily values)
+    double intervalStart = 3.8E8;
+    double intervalEnd = intervalStart + 3.0 * 86400.0;
+    for( basic_astrodynamics::TimeScales timeScale : { basic_astrodynamics::tdb_scale, basic_astrodynamics::tt_scale } )
+    {
+        std::shared_ptr< TabulatedEarthOrientationAnglesCalculator > tabulatedCalculator =
+                std::make_shared< TabulatedEarthOrientationAnglesCalculator >(
+                    earthOrientationCalculator, intervalStart, intervalEnd, 3600.0, timeScale );
+
+        // Compare angles at times not coinciding with tabulated times
+        for( int i = 0; i <= 1000; i++ )
+        {
+            double testTime = intervalStart + i * ( intervalEnd - intervalStart ) / 1000.0 + ( ( i % 2 == 0 ) ? 0.0 : 0.123 );
+            testTime = std::min( testTime, intervalEnd );
+
+            double tioLocator;
+            std::pair< Eigen::Vector5d, double > tabulatedAngles =
+                    tabulatedCalculator->getRotationAnglesAndTioLocatorFromItrsToGcrs< double >( testTime, tioLocator );
+            std::pair< Eigen::Vector5d, double > directAngles =
+                    earthOrientationCalculator->getRotationAnglesFromItrsToGcrs< double >( testTime, timeScale );
+
+            for( int j = 0; j < 5; j++ )
+            {
+                BOOST_CHECK_SMALL( std::fabs( tabulatedAngles.first( j ) - directAngles.first( j ) ),
+                                   getAngleTolerance( testTime, directAngles.first( j ) ) );
+            }
+            BOOST_CHECK_SMALL( std::fabs( tioLocator - getApproximateTioLocator( testTime ) ),
+                               getAngleTolerance( testTime, tioLocator ) );
+            BOOST_CHECK_SMALL( std::fabs( tabulatedAngles.second - directAngles.second ),
+                               getUt1RoundOffTolerance( testTime ) );
+
+            // Check UT1 in extended precision
+            std::pair< Eigen::Vector5d, Time > tabulatedAnglesExtended =
+                    tabulatedCalculator->getRotationAnglesFromItrsToGcrs< Time >( testTime );
+            std::pair< Eigen::Vector5d, Time > directAnglesExtended =
+                    earthOrientationCalculator->getRotationAnglesFromItrsToGcrs< Time >( testTime, timeScale );
+            BOOST_CHECK_SMALL( std::fabs( static_cast< double >( tabulatedAnglesExtended.second - directAnglesExtended.second ) ),
+                               1.0E-9 );
+        }
+
+        // Check that angles are computed directly outside of tabulated interval
+        std::pair< Eigen::Vector5d, double > tabulatedAngles =
+                tabulatedCalculator->getRotationAnglesFromItrsToGcrs< double >( intervalEnd + 1.0 );
+        std::pair< Eigen::Vector5d, double > directAngles =
+                earthOrientationCalculator->getRotationAnglesFromItrsToGcrs< double >( intervalEnd + 1.0, timeScale );
+        for( int j = 0; j < 5; j++ )
+        {
+            BOOST_CHECK_EQUAL( tabulatedAngles.first( j ), directAngles.first( j ) );
+        }
+        BOOST_CHECK_EQUAL( tabulatedAngles.second, directAngles.second );
+    }
+
+    // Check that unsupported input is rejected
+    BOOST_CHECK_THROW( TabulatedEarthOrientationAnglesCalculator(
+                           earthOrientationCalculator, intervalStart, intervalEnd, 3600.0, basic_astrodynamics::utc_scale ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( TabulatedEarthOrientationAnglesCalculator(
+                           earthOrientationCalculator, intervalStart, intervalEnd, 3600.0, basic_astrodynamics::tdb_scale, 7 ),
+                       std::runtime_error );
+}
+
+//! Test accuracy of rotation model with tabulated angles, compared to direct computation
+BOOST_AUTO_TEST_CASE( testTabulatedEarthOrientationRotationModel )
+{
+    std::shared_ptr< EarthOrientationAnglesCalculator > earthOrientationCalculator =
+            createStandardEarthOrientationCalculator( );
+
+    double intervalStart = 3.8E8;
+    double intervalEnd = intervalStart + 86400.0;
+
+    std::shared_ptr< ephemerides::GcrsToItrsRotationModel > directRotationModel =
+            std::make_shared< ephemerides::GcrsToItrsRotationModel >( earthOrientationCalculator );
+    std::shared_ptr< ephemerides::GcrsToItrsRotationModel > tabulatedRotationModel =
+            std::make_shared< ephemerides::GcrsToItrsRotationModel >( earthOrientationCalculator );
+
+    tabulatedRotationModel->setTabulatedAnglesCalculator(
+                std::make_shared< TabulatedEarthOrientationAnglesCalculator >(
+                    earthOrientationCalculator, intervalStart, intervalEnd ) );
+
+    // Compute rotations at 10000 times with both models
+    int numberOfTestTimes = 10000;
+    std::vector< Eigen::Quaterniond > directRotations;
+    std::vector< Eigen::Quaterniond > tabulatedRotations;
+
+    for( int i = 0; i < numberOfTestTimes; i++ )
+    {
+        directRotations.push_back( directRotationModel->getRotationToBaseFrame(
+                                       intervalStart + 86400.0 * static_cast< double >( i ) / numberOfTestTimes ) );
+    }
+    for( int i = 0; i < numberOfTestTimes; i++ )
+    {
+        tabulatedRotations.push_back( tabulatedRotationModel->getRotationToBaseFrame(
+                                          intervalStart + 86400.0 * static_cast< double >( i ) / numberOfTestTimes ) );
+    }
+
+    // Check rotations: difference due to interpolation of angles (UT1 interpolation error included in UT1 tolerance),
+    // in addition to round-off of UT1 and of the rotation
+    double earthRotationRate = 2.0 * mathematical_constants::PI / 86400.0 * 1.00273781191135448;
+    for( int i = 0; i < numberOfTestTimes; i++ )
+    {
+        double testTime = intervalStart + 86400.0 * static_cast< double >( i ) / numberOfTestTimes;
+        double rotationDifference = directRotations.at( i ).angularDistance( tabulatedRotations.at( i ) );
+        BOOST_CHECK_SMALL( rotationDifference, angleInterpolationTolerance +
+                           earthRotationRate * getUt1RoundOffTolerance( testTime ) + 1.0E-15 );
+
+        if( i % 100 == 0 )
+        {
+            Eigen::Matrix3d directRotationRate = directRotationModel->getDerivativeOfRotationToBaseFrame( testTime );
+            Eigen::Matrix3d tabulatedRotationRate = tabulatedRotationModel->getDerivativeOfRotationToBaseFrame( testTime );
+            BOOST_CHECK_SMALL( ( directRotationRate - tabulatedRotationRate ).cwiseAbs( ).maxCoeff( ),
+                               earthRotationRate * ( angleInterpolationTolerance +
+                                                     earthRotationRate * getUt1RoundOffTolerance( testTime ) + 1.0E-15 ) );
+        }
+    }
+
+    // Check that inconsistent tabulated angles are rejected
+    BOOST_CHECK_THROW( tabulatedRotationModel->setTabulatedAnglesCalculator(
+                           std::make_shared< TabulatedEarthOrientationAnglesCalculator >(
+                               earthOrientationCalculator, intervalStart, intervalEnd, 3600.0,
+                               basic_astrodynamics::tt_scale ) ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
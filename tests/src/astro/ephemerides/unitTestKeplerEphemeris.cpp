@@ -103,6 +103,42 @@ BOOST_AUTO_TEST_CASE( testKeplerEphemerisHyperbolic )
     }
 }
 
+//! Test 3: Comparison of states of KeplerEphemeris evaluated at a list of times with states evaluated at single times.
+BOOST_AUTO_TEST_CASE( testKeplerEphemerisBatchEvaluation )
+{
+    const double earthGravitationalParameter = 398600.4415e9;
+
+    // Create list of (unsorted) times, covering multiple orbits and multiple blocks of the batch evaluation
+    std::vector< double > evaluationTimes;
+    for( int i = 0; i < 1000; i++ )
+    {
+        evaluationTimes.push_back( -2.0E5 + 5.0E5 * std::fmod( i * 0.6180339887, 1.0 ) );
+    }
+
+    // Test elliptical orbits with low and high eccentricity, and hyperbolic orbit
+    std::vector< Eigen::Vector6d > initialKeplerianStates;
+    initialKeplerianStates.push_back( ( Eigen::Vector6d( ) << 7000.0E3, 0.01, 0.5, 1.0, 2.0, 3.0 ).finished( ) );
+    initialKeplerianStates.push_back( ( Eigen::Vector6d( ) << 40000.0E3, 0.95, 1.2, 0.3, -1.0, 0.1 ).finished( ) );
+    initialKeplerianStates.push_back( ( Eigen::Vector6d( ) << -30000.0E3, 1.5, 0.2, 0.4, 0.6, 0.8 ).finished( ) );
+
+    Eigen::Matrix< double, 6, Eigen::Dynamic > batchStates;
+    for( unsigned int i = 0; i < initialKeplerianStates.size( ); i++ )
+    {
+        ephemerides::KeplerEphemeris keplerEphemeris(
+                    initialKeplerianStates.at( i ), 1.0E3, earthGravitationalParameter );
+        keplerEphemeris.getCartesianStates( evaluationTimes, batchStates );
+        BOOST_CHECK_EQUAL( batchStates.cols( ), static_cast< int >( evaluationTimes.size( ) ) );
+
+        for( unsigned int j = 0; j < evaluationTimes.size( ); j++ )
+        {
+            Eigen::Vector6d singleState = keplerEphemeris.getCartesianState( evaluationTimes.at( j ) );
+            Eigen::Vector6d currentBatchState = batchStates.col( j );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( singleState.segment( 0, 3 ), currentBatchState.segment( 0, 3 ), 1.0E-11 );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( singleState.segment( 3, 3 ), currentBatchState.segment( 3, 3 ), 1.0E-11 );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
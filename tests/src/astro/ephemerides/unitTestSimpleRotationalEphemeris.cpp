@@ -322,6 +322,31 @@ BOOST_AUTO_TEST_CASE( testSimpleRotationalEphemeris )
     }
 }
 
+// Check evaluation of rotations at a list of times.
+BOOST_AUTO_TEST_CASE( testSimpleRotationalEphemerisBatchEvaluation )
+{
+    SimpleRotationalEphemeris rotationalEphemeris(
+                convertDegreesToRadians( 272.76 ), convertDegreesToRadians( 67.16 ), convertDegreesToRadians( 160.20 ),
+                convertDegreesToRadians( -1.4813688 ) / physical_constants::JULIAN_DAY, 0.0, "ECLIPJ2000", "IAU_Venus" );
+
+    std::vector< double > evaluationTimes;
+    for( int i = 0; i < 100; i++ )
+    {
+        evaluationTimes.push_back( -1.0E8 + 2.0E6 * static_cast< double >( i ) );
+    }
+
+    Eigen::Matrix< double, 4, Eigen::Dynamic > rotations;
+    rotationalEphemeris.getRotationsToBaseFrame( evaluationTimes, rotations );
+    BOOST_CHECK_EQUAL( rotations.cols( ), 100 );
+    for( unsigned int i = 0; i < evaluationTimes.size( ); i++ )
+    {
+        Eigen::Vector4d expectedRotation = linear_algebra::convertQuaternionToVectorFormat(
+                    rotationalEphemeris.getRotationToBaseFrame( evaluationTimes.at( i ) ) );
+        Eigen::Vector4d currentRotation = rotations.col( i );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedRotation, currentRotation, 0.0 );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -174,6 +174,170 @@ BOOST_AUTO_TEST_CASE( testTabulatedEphemeris )
 
 }
 
+//! Test the query cache of the tabulated ephemeris
+BOOST_AUTO_TEST_CASE( testTabulatedEphemerisQueryCache )
+{
+    using namespace ephemerides;
+
+    // Create tabulated ephemeris from (arbitrary) analytical state history
+    std::map< double, Eigen::Vector6d > stateHistoryMap;
+    for( int i = 0; i < 1000; i++ )
+    {
+        double currentTime = static_cast< double >( i ) * 100.0;
+        stateHistoryMap[ currentTime ] = ( Eigen::Vector6d( ) <<
+                                           std::sin( 1.0E-4 * currentTime ), std::cos( 1.0E-4 * currentTime ),
+                                           1.0E-3 * currentTime, std::cos( 2.0E-4 * currentTime ), 2.0, -1.0 ).finished( );
+    }
+    std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > > stateInterpolator =
+            std::make_shared< interpolators::LagrangeInterpolator< double, Eigen::Vector6d > >( stateHistoryMap, 8 );
+    std::shared_ptr< TabulatedCartesianEphemeris< > > tabulatedEphemeris =
+            std::make_shared< TabulatedCartesianEphemeris< > >( stateInterpolator, "SSB", "J2000" );
+
+    BOOST_CHECK_EQUAL( tabulatedEphemeris->getUseQueryCache( ), false );
+    tabulatedEphemeris->setUseQueryCache( true );
+
+    // Query ephemeris at repeated times, and check results and hit/miss counters
+    std::vector< double > queryTimes = { 5.0E3, 5.0E3, 5.0E3 - 1.0E-3, 5.0E3, 2.0E4, 3.0E4, 4.0E4, 5.0E3 - 1.0E-3, 5.0E4, 5.0E3 };
+    std::vector< bool > expectedHit = { false, true, false, true, false, false, false, true, false, false };
+    unsigned long expectedNumberOfHits = 0;
+    for( unsigned int i = 0; i < queryTimes.size( ); i++ )
+    {
+        Eigen::Vector6d ephemerisState = tabulatedEphemeris->getCartesianState( queryTimes.at( i ) );
+        Eigen::Vector6d interpolatorState = stateInterpolator->interpolate( queryTimes.at( i ) );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( interpolatorState, ephemerisState, 0.0 );
+
+        expectedNumberOfHits += expectedHit.at( i );
+        BOOST_CHECK_EQUAL( tabulatedEphemeris->getNumberOfQueryCacheHits( ), expectedNumberOfHits );
+        BOOST_CHECK_EQUAL( tabulatedEphemeris->getNumberOfQueryCacheMisses( ), i + 1 - expectedNumberOfHits );
+    }
+
+    // Check that cache is cleared when interpolator is reset
+    std::map< double, Eigen::Vector6d > shiftedStateHistoryMap;
+    for( auto stateIterator : stateHistoryMap )
+    {
+        shiftedStateHistoryMap[ stateIterator.first ] = stateIterator.second + Eigen::Vector6d::Constant( 1.0 );
+    }
+    std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > > shiftedStateInterpolator =
+            std::make_shared< interpolators::LagrangeInterpolator< double, Eigen::Vector6d > >( shiftedStateHistoryMap, 8 );
+    tabulatedEphemeris->resetInterpolator( shiftedStateInterpolator );
+    BOOST_CHECK_EQUAL( tabulatedEphemeris->getNumberOfQueryCacheHits( ), 0 );
+
+    Eigen::Vector6d ephemerisState = tabulatedEphemeris->getCartesianState( queryTimes.at( 0 ) );
+    Eigen::Vector6d interpolatorState = shiftedStateInterpolator->interpolate( queryTimes.at( 0 ) );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( interpolatorState, ephemerisState, 0.0 );
+    BOOST_CHECK_EQUAL( tabulatedEphemeris->getNumberOfQueryCacheMisses( ), 1 );
+}
+
+//! Test the evaluation of the tabulated ephemeris at a list of times
+BOOST_AUTO_TEST_CASE( testTabulatedEphemerisBatchEvaluation )
+{
+    using namespace ephemerides;
+
+    // Create tabulated ephemeris from (arbitrary) analytical state history
+    std::map< double, Eigen::Vector6d > stateHistoryMap;
+    for( int i = 0; i < 1000; i++ )
+    {
+        double currentTime = static_cast< double >( i ) * 100.0;
+        stateHistoryMap[ currentTime ] = ( Eigen::Vector6d( ) <<
+                                           std::sin( 1.0E-4 * currentTime ), std::cos( 1.0E-4 * currentTime ),
+                                           1.0E-3 * currentTime, std::cos( 2.0E-4 * currentTime ), 2.0, -1.0 ).finished( );
+    }
+    std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > > stateInterpolator =
+            std::make_shared< interpolators::LagrangeInterpolator< double, Eigen::Vector6d > >( stateHistoryMap, 8 );
+    std::shared_ptr< TabulatedCartesianEphemeris< > > tabulatedEphemeris =
+            std::make_shared< TabulatedCartesianEphemeris< > >( stateInterpolator, "SSB", "J2000" );
+
+    // Create sorted and unsorted lists of times
+    std::vector< double > sortedTimes;
+    std::vector< double > unsortedTimes;
+    for( int i = 0; i < 500; i++ )
+    {
+        sortedTimes.push_back( 1000.0 + 190.0 * static_cast< double >( i ) + 0.37 );
+        unsortedTimes.push_back( 1000.0 + 95000.0 * std::fmod( i * 0.6180339887, 1.0 ) );
+    }
+
+    // Check that states at list of times are identical to states at single times, with and without query cache
+    Eigen::Matrix< double, 6, Eigen::Dynamic > batchStates;
+    for( unsigned int useCache = 0; useCache < 2; useCache++ )
+    {
+        tabulatedEphemeris->setUseQueryCache( useCache );
+        for( const std::vector< double >& evaluationTimes : { sortedTimes, unsortedTimes } )
+        {
+            tabulatedEphemeris->getCartesianStates( evaluationTimes, batchStates );
+            BOOST_CHECK_EQUAL( batchStates.cols( ), static_cast< int >( evaluationTimes.size( ) ) );
+            for( unsigned int i = 0; i < evaluationTimes.size( ); i++ )
+            {
+                Eigen::Vector6d singleState = tabulatedEphemeris->getCartesianState( evaluationTimes.at( i ) );
+                Eigen::Vector6d currentBatchState = batchStates.col( i );
+                TUDAT_CHECK_MATRIX_CLOSE_FRACTION( singleState, currentBatchState, 0.0 );
+            }
+        }
+    }
+}
+
+//! Test the reset of the tabulated ephemeris from a columnar history, which is read without copying the states
+BOOST_AUTO_TEST_CASE( testTabulatedEphemerisFromColumnarHistory )
+{
+    using namespace ephemerides;
+
+    // Create (arbitrary) analytical state history, with additional rows before and after the state in each entry
+    std::map< double, Eigen::Vector6d > stateHistoryMap;
+    std::shared_ptr< utilities::ColumnarHistory< double, double > > increasingHistory =
+            std::make_shared< utilities::ColumnarHistory< double, double > >( );
+    std::shared_ptr< utilities::ColumnarHistory< double, double > > decreasingHistory =
+            std::make_shared< utilities::ColumnarHistory< double, double > >( );
+    for( int i = 0; i < 1000; i++ )
+    {
+        double currentTime = static_cast< double >( i ) * 100.0;
+        stateHistoryMap[ currentTime ] = ( Eigen::Vector6d( ) <<
+                                           std::sin( 1.0E-4 * currentTime ), std::cos( 1.0E-4 * currentTime ),
+                                           1.0E-3 * currentTime, std::cos( 2.0E-4 * currentTime ), 2.0, -1.0 ).finished( );
+        Eigen::VectorXd currentEntry = Eigen::VectorXd::Constant( 9, TUDAT_NAN );
+        currentEntry.segment( 2, 6 ) = stateHistoryMap.at( currentTime );
+        increasingHistory->addEntry( currentTime, currentEntry );
+    }
+    for( auto stateIterator = stateHistoryMap.rbegin( ); stateIterator != stateHistoryMap.rend( ); stateIterator++ )
+    {
+        Eigen::VectorXd currentEntry = Eigen::VectorXd::Constant( 9, TUDAT_NAN );
+        currentEntry.segment( 2, 6 ) = stateIterator->second;
+        decreasingHistory->addEntry( stateIterator->first, currentEntry );
+    }
+
+    interpolators::LagrangeInterpolator< double, Eigen::Vector6d > referenceInterpolator( stateHistoryMap, 8 );
+    for( std::shared_ptr< utilities::ColumnarHistory< double, double > > stateHistory :
+    { increasingHistory, decreasingHistory } )
+    {
+        std::shared_ptr< TabulatedCartesianEphemeris< > > tabulatedEphemeris =
+                std::make_shared< TabulatedCartesianEphemeris< > >(
+                    std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > >( ), "SSB", "J2000" );
+        long historyUseCount = stateHistory.use_count( );
+        tabulatedEphemeris->resetInterpolatorFromHistory( stateHistory, 8, 2 );
+
+        // Check that states are not copied, and that history is kept alive by ephemeris
+        BOOST_CHECK_EQUAL( tabulatedEphemeris->getInterpolator( )->getDependentValues( ).size( ), 0 );
+        BOOST_CHECK_EQUAL( stateHistory.use_count( ), historyUseCount + 1 );
+
+        // Check states at data points, and compare states between data points to Lagrange interpolator
+        for( int i = 0; i < 999; i++ )
+        {
+            double currentTime = static_cast< double >( i ) * 100.0;
+            Eigen::Vector6d ephemerisState = tabulatedEphemeris->getCartesianState( currentTime );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( stateHistoryMap.at( currentTime ), ephemerisState, 0.0 );
+
+            if( i >= 4 && i < 995 )
+            {
+                ephemerisState = tabulatedEphemeris->getCartesianState( currentTime + 37.0 );
+                Eigen::Vector6d interpolatorState = referenceInterpolator.interpolate( currentTime + 37.0 );
+                TUDAT_CHECK_MATRIX_CLOSE_FRACTION( interpolatorState, ephemerisState, 1.0E-12 );
+            }
+        }
+
+        // Check that edges of the domain are excluded from safe interpolation interval
+        BOOST_CHECK_EQUAL( tabulatedEphemeris->getSafeInterpolationInterval( ).first, 500.0 );
+        BOOST_CHECK_EQUAL( tabulatedEphemeris->getSafeInterpolationInterval( ).second, 99400.0 );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -0,0 +1,209 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Vallado, D.A., Crawford, P., Hujsak, R., Kelso, T.S. Revisiting Spacetrack Report #3, AIAA 2006-6753, 2006.
+ *
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cstdio>
+#include <fstream>
+
+#include <boost/test/tools/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "tudat/basics/testMacros.h"
+#include "tudat/interface/spice/spiceInterface.h"
+
+#include "tudat/astro/ephemerides/tleCatalogue.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::ephemerides;
+
+BOOST_AUTO_TEST_SUITE( test_tle_catalogue )
+
+//! Near-Earth two line element set from Vallado (2013), page 234
+const std::string nearEarthElements =
+        "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753\n"
+        "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667";
+
+//! Test the SGP4 states computed by the catalogue against the verification states of Vallado et al. (2006).
+BOOST_AUTO_TEST_CASE( testTleCatalogueVerificationStates )
+{
+    std::shared_ptr< Tle > tle = std::make_shared< Tle >( nearEarthElements );
+    TleCatalogue catalogue( { tle }, { 5 }, "TEME" );
+    BOOST_CHECK_EQUAL( catalogue.getNearEarthObjectIndices( ).size( ), 1 );
+    BOOST_CHECK_EQUAL( catalogue.getDeepSpaceObjectIndices( ).size( ), 0 );
+
+    // Verification states (TEME, in km and km/s) at 0, 360 and 4320 minutes after the TLE epoch
+    std::vector< double > minutesSinceTleEpoch = { 0.0, 360.0, 4320.0 };
+    Eigen::Matrix< double, 3, 6 > verificationStates;
+    verificationStates <<
+            7022.46529266, -1400.08296755, 0.03995155, 1.893841015, 6.405893759, 4.534807250,
+            -7154.03120202, -3783.17682504, -3536.19412294, 4.741887409, -4.151817765, -2.093935425,
+            -9060.47373569, 4658.70952502, 813.68673153, -2.232832783, -4.110453490, -3.157345433;
+
+    Eigen::Matrix< double, Eigen::Dynamic, 6 > cartesianStates;
+    for( unsigned int i = 0; i < minutesSinceTleEpoch.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( catalogue.getCartesianStates(
+                               tle->getEpoch( ) + 60.0 * minutesSinceTleEpoch.at( i ), cartesianStates ), 0 );
+        for( unsigned int j = 0; j < 3; j++ )
+        {
+            BOOST_CHECK_SMALL( cartesianStates( 0, j ) - 1.0E3 * verificationStates( i, j ), 1.0E-2 );
+            BOOST_CHECK_SMALL( cartesianStates( 0, j + 3 ) - 1.0E3 * verificationStates( i, j + 3 ), 1.0E-5 );
+        }
+    }
+}
+
+//! Test the conversion of the catalogue states to the J2000 frame, and compare to the TleEphemeris (Spice) states.
+BOOST_AUTO_TEST_CASE( testTleCatalogueFrameConversion )
+{
+    std::shared_ptr< Tle > tle = std::make_shared< Tle >( nearEarthElements );
+    const double evaluationTime = 3.0 * physical_constants::JULIAN_DAY + tle->getEpoch( );
+
+    Eigen::Matrix< double, Eigen::Dynamic, 6 > temeStates, j2000States;
+    TleCatalogue( { tle }, { 5 }, "TEME" ).getCartesianStates( evaluationTime, temeStates );
+    TleCatalogue( { tle }, { 5 }, "J2000" ).getCartesianStates( evaluationTime, j2000States );
+
+    // Check consistency of rotation
+    Eigen::Matrix3d temeToJ2000RotationMatrix = getRotationMatrixFromTemeToJ2000( evaluationTime );
+    Eigen::Vector3d expectedPosition = temeToJ2000RotationMatrix * temeStates.block( 0, 0, 1, 3 ).transpose( );
+    Eigen::Vector3d expectedVelocity = temeToJ2000RotationMatrix * temeStates.block( 0, 3, 1, 3 ).transpose( );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( Eigen::Vector3d( j2000States.block( 0, 0, 1, 3 ).transpose( ) ),
+                                       expectedPosition, 1.0E-14 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( Eigen::Vector3d( j2000States.block( 0, 3, 1, 3 ).transpose( ) ),
+                                       expectedVelocity, 1.0E-14 );
+
+    // Compare to position and velocity vectors as found in Vallado, with same tolerance as TleEphemeris test
+    Eigen::Vector3d verificationPosition, verificationVelocity;
+    verificationPosition << -9059941.3786, 4659697.2000, 813958.8875;
+    verificationVelocity << -2233.348094, -4110.136162, -3157.394074;
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( Eigen::Vector3d( j2000States.block( 0, 0, 1, 3 ).transpose( ) ),
+                                       verificationPosition, 5.0e-5 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( Eigen::Vector3d( j2000States.block( 0, 3, 1, 3 ).transpose( ) ),
+                                       verificationVelocity, 5.0e-6 );
+
+    // Compare to TleEphemeris
+    Eigen::Vector6d ephemerisState = TleEphemeris( "Earth", "J2000", tle ).getCartesianState( evaluationTime );
+    BOOST_CHECK_SMALL( ( ephemerisState.segment( 0, 3 ) - j2000States.block( 0, 0, 1, 3 ).transpose( ) ).norm( ) /
+                       ephemerisState.segment( 0, 3 ).norm( ), 1.0E-5 );
+    BOOST_CHECK_SMALL( ( ephemerisState.segment( 3, 3 ) - j2000States.block( 0, 3, 1, 3 ).transpose( ) ).norm( ) /
+                       ephemerisState.segment( 3, 3 ).norm( ), 1.0E-5 );
+}
+
+//! Test reading of a catalogue from file, and the classification of near-Earth and deep-space objects.
+BOOST_AUTO_TEST_CASE( testTleCatalogueFromFile )
+{
+    // Write catalogue in three-line format (with carriage returns on one line), including an Alpha-5 catalogue number
+    std::string fileName = "tleCatalogueTest.txt";
+    {
+        std::ofstream tleFile( fileName );
+        tleFile << "MOLNIYA 2-14\n"
+                << "1 08195U 75081A   06176.33215444  .00000099  00000-0  11873-3 0   813\n"
+                << "2 08195  64.1586 279.0717 6877146 264.7651  20.2257  2.00491383225656\n"
+                << "VANGUARD 1\r\n"
+                << "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753\r\n"
+                << "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667\r\n"
+                << "\n"
+                << "ALPHA-5 COPY\n"
+                << "1 A0005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753\n"
+                << "2 A0005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667\n";
+    }
+    std::shared_ptr< TleCatalogue > catalogue = readTleCatalogue( fileName, "TEME" );
+    std::remove( fileName.c_str( ) );
+
+    BOOST_CHECK_EQUAL( catalogue->getNumberOfObjects( ), 3 );
+    BOOST_CHECK_EQUAL( catalogue->getObjectIds( ).at( 0 ), 8195 );
+    BOOST_CHECK_EQUAL( catalogue->getObjectIds( ).at( 1 ), 5 );
+    BOOST_CHECK_EQUAL( catalogue->getObjectIds( ).at( 2 ), 100005 );
+    BOOST_CHECK_EQUAL( catalogue->getDeepSpaceObjectIndices( ).size( ), 1 );
+    BOOST_CHECK_EQUAL( catalogue->getDeepSpaceObjectIndices( ).at( 0 ), 0 );
+    BOOST_CHECK_EQUAL( catalogue->getNearEarthObjectIndices( ).size( ), 2 );
+
+    // Deep-space object is not propagated, near-Earth objects are identical
+    Eigen::Matrix< double, Eigen::Dynamic, 6 > cartesianStates;
+    const double evaluationTime = catalogue->getTles( ).at( 1 )->getEpoch( ) + 3600.0;
+    BOOST_CHECK_EQUAL( catalogue->getCartesianStates( evaluationTime, cartesianStates ), 1 );
+    for( unsigned int j = 0; j < 6; j++ )
+    {
+        BOOST_CHECK( cartesianStates( 0, j ) != cartesianStates( 0, j ) );
+        BOOST_CHECK_EQUAL( cartesianStates( 1, j ), cartesianStates( 2, j ) );
+    }
+}
+
+//! Test propagation of a larger catalogue over multiple threads, and compare to propagation of the individual objects.
+BOOST_AUTO_TEST_CASE( testTleCatalogueBatchPropagation )
+{
+    // Create catalogue of low Earth orbits, with a range of drag coefficients (including simplified drag model)
+    std::shared_ptr< Tle > referenceTle = std::make_shared< Tle >( nearEarthElements );
+    std::vector< std::shared_ptr< Tle > > tles;
+    const int numberOfObjects = 1031;
+    for( int i = 0; i < numberOfObjects; i++ )
+    {
+        double fraction = static_cast< double >( i ) / numberOfObjects;
+        tles.push_back( std::make_shared< Tle >(
+                            referenceTle->getEpoch( ) + 3600.0 * fraction, 1.0E-5 + 2.0E-4 * fraction,
+                            mathematical_constants::PI * fraction, 2.0 * mathematical_constants::PI * fraction,
+                            1.0E-5 + 0.02 * fraction, 5.0 * fraction, 3.0 * fraction,
+                            ( 14.0 + 1.6 * fraction ) * 2.0 * mathematical_constants::PI / 1440.0 ) );
+    }
+
+    // Add strongly decaying object
+    tles.push_back( std::make_shared< Tle >(
+                        referenceTle->getEpoch( ), 0.5, 1.0, 0.0, 1.0E-3, 0.0, 0.0,
+                        16.3 * 2.0 * mathematical_constants::PI / 1440.0 ) );
+
+    TleCatalogue catalogue( tles );
+    const double evaluationTime = referenceTle->getEpoch( ) + 10.0 * physical_constants::JULIAN_DAY;
+
+    Eigen::Matrix< double, Eigen::Dynamic, 6 > singleThreadStates, multiThreadStates, objectStates;
+    BOOST_CHECK_EQUAL( catalogue.getCartesianStates( evaluationTime, singleThreadStates, 1 ), 1 );
+    BOOST_CHECK_EQUAL( catalogue.getCartesianStates( evaluationTime, multiThreadStates, 3 ), 1 );
+    BOOST_CHECK( singleThreadStates.bottomRows( 1 ).hasNaN( ) );
+    BOOST_CHECK( !singleThreadStates.topRows( numberOfObjects ).hasNaN( ) );
+
+    for( int i = 0; i < numberOfObjects; i++ )
+    {
+        TleCatalogue( { tles.at( i ) } ).getCartesianStates( evaluationTime, objectStates );
+        for( unsigned int j = 0; j < 6; j++ )
+        {
+            BOOST_CHECK_EQUAL( singleThreadStates( i, j ), multiThreadStates( i, j ) );
+            BOOST_CHECK_CLOSE_FRACTION( singleThreadStates( i, j ), objectStates( 0, j ), 1.0E-12 );
+        }
+    }
+
+    // Compute states in TEME frame, for comparison with Spice
+    Eigen::Matrix< double, Eigen::Dynamic, 6 > temeStates;
+    TleCatalogue temeCatalogue( tles, std::vector< int >( ), "TEME" );
+    BOOST_CHECK_EQUAL( temeCatalogue.getCartesianStates( evaluationTime, temeStates ), 1 );
+
+    // Check consistency with Spice
+    Eigen::Vector6d spiceState;
+    for( int i = 0; i < numberOfObjects; i++ )
+    {
+        spiceState = spice_interface::getCartesianStateFromTleAtEpoch( evaluationTime, tles.at( i ) );
+        BOOST_CHECK_SMALL( ( spiceState.segment( 0, 3 ) - temeStates.block( i, 0, 1, 3 ).transpose( ) ).norm( ) /
+                           spiceState.segment( 0, 3 ).norm( ), 1.0E-5 );
+        BOOST_CHECK_SMALL( ( spiceState.segment( 3, 3 ) - temeStates.block( i, 3, 1, 3 ).transpose( ) ).norm( ) /
+                           spiceState.segment( 3, 3 ).norm( ), 1.0E-5 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,234 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/testMacros.h"
+#include "tudat/astro/basic_astro/orbitalElementConversions.h"
+#include "tudat/astro/basic_astro/unitConversions.h"
+#include "tudat/astro/gravitation/manyBodyPointMassGravityModel.h"
+#include "tudat/simulation/environment_setup/createBodies.h"
+#include "tudat/simulation/propagation_setup/createAccelerationModels.h"
+#include "tudat/simulation/propagation_setup/dynamicsSimulator.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace tudat::gravitation;
+using namespace tudat::propagators;
+using namespace tudat::simulation_setup;
+using namespace tudat::numerical_integrators;
+using namespace tudat::orbital_element_conversions;
+
+BOOST_AUTO_TEST_SUITE( test_many_body_point_mass_gravity )
+
+//! Gravitational parameter of the Earth used in the tests
+const double earthGravitationalParameter = 3.986004418E14;
+
+//! Function to create the (Spice-independent) environment for the tests, with a given number of debris objects
+SystemOfBodies createManyBodyTestBodies( const int numberOfDebris )
+{
+    BodyListSettings bodySettings = BodyListSettings( "SSB", "ECLIPJ2000" );
+    bodySettings.addSettings( "Sun" );
+    bodySettings.at( "Sun" )->ephemerisSettings = std::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ), "SSB", "ECLIPJ2000" );
+    bodySettings.at( "Sun" )->gravityFieldSettings = std::make_shared< CentralGravityFieldSettings >( 1.32712440018E20 );
+
+    bodySettings.addSettings( "Earth" );
+    bodySettings.at( "Earth" )->ephemerisSettings = std::make_shared< KeplerEphemerisSettings >(
+                ( Eigen::Vector6d( ) << 1.496E11, 0.0167, 0.0, 0.3, 0.2, 0.1 ).finished( ), 0.0, 1.32712440018E20,
+                "SSB", "ECLIPJ2000" );
+    bodySettings.at( "Earth" )->gravityFieldSettings = std::make_shared< CentralGravityFieldSettings >(
+                earthGravitationalParameter );
+
+    bodySettings.addSettings( "Moon" );
+    bodySettings.at( "Moon" )->ephemerisSettings = std::make_shared< KeplerEphemerisSettings >(
+                ( Eigen::Vector6d( ) << 3.844E8, 0.055, 0.09, 1.0, 0.5, 2.0 ).finished( ), 0.0, earthGravitationalParameter,
+                "Earth", "ECLIPJ2000" );
+    bodySettings.at( "Moon" )->gravityFieldSettings = std::make_shared< CentralGravityFieldSettings >( 4.9048695E12 );
+
+    SystemOfBodies bodies = createSystemOfBodies( bodySettings );
+    for( int i = 0; i < numberOfDebris; i++ )
+    {
+        bodies.createEmptyBody( "Debris" + std::to_string( i ) );
+    }
+    return bodies;
+}
+
+//! Function to retrieve the initial Cartesian state of a debris object w.r.t. the Earth
+Eigen::Vector6d getDebrisInitialState( const int debrisIndex )
+{
+    Eigen::Vector6d initialKeplerianState;
+    initialKeplerianState << 7000.0E3 + 250.0E3 * debrisIndex, 0.001 + 0.01 * debrisIndex,
+            unit_conversions::convertDegreesToRadians( 10.0 + 7.0 * debrisIndex ), 0.3 * debrisIndex,
+            0.5 + 0.2 * debrisIndex, 0.7 * debrisIndex;
+    return convertKeplerianToCartesianElements( initialKeplerianState, earthGravitationalParameter );
+}
+
+//! Test whether the accelerations computed by the many-body kernel are equal to those of the per-pair models
+BOOST_AUTO_TEST_CASE( testManyBodyPointMassGravityAccelerations )
+{
+    const int numberOfDebris = 25;
+    const double testTime = 1.0E5;
+    SystemOfBodies bodies = createManyBodyTestBodies( numberOfDebris );
+
+    // Give one of the debris objects a gravity field, to test use of sum of gravitational parameters
+    bodies.at( "Debris3" )->setGravityFieldModel( std::make_shared< GravityFieldModel >( 1.0E10 ) );
+
+    // Set states of all bodies
+    bodies.at( "Sun" )->setState( Eigen::Vector6d::Zero( ) );
+    bodies.at( "Earth" )->setState( bodies.at( "Earth" )->getEphemeris( )->getCartesianState( testTime ) );
+    bodies.at( "Moon" )->setState( bodies.at( "Earth" )->getState( ) +
+                                   bodies.at( "Moon" )->getEphemeris( )->getCartesianState( testTime ) );
+    for( int i = 0; i < numberOfDebris; i++ )
+    {
+        bodies.at( "Debris" + std::to_string( i ) )->setState(
+                    bodies.at( "Earth" )->getState( ) + getDebrisInitialState( i ) );
+    }
+
+    // Test with central body Earth (direct Earth acceleration; third-body Sun and Moon accelerations) and inertial
+    // central body (direct accelerations only)
+    std::vector< std::string > exertingBodies = { "Earth", "Moon", "Sun" };
+    for( std::string centralBody : { "Earth", "SSB" } )
+    {
+        SelectedAccelerationMap accelerationMap;
+        std::map< std::string, std::string > centralBodies;
+        for( int i = 0; i < numberOfDebris; i++ )
+        {
+            std::string debrisName = "Debris" + std::to_string( i );
+            for( std::string exertingBody : exertingBodies )
+            {
+                accelerationMap[ debrisName ][ exertingBody ].push_back( manyBodyPointMassGravityAcceleration( ) );
+            }
+            centralBodies[ debrisName ] = centralBody;
+        }
+        basic_astrodynamics::AccelerationMap accelerationModels =
+                createAccelerationModelsMap( bodies, accelerationMap, centralBodies );
+
+        std::shared_ptr< ManyBodyPointMassGravityKernel > accelerationKernel;
+        for( int i = 0; i < numberOfDebris; i++ )
+        {
+            std::string debrisName = "Debris" + std::to_string( i );
+            for( std::string exertingBody : exertingBodies )
+            {
+                // Check type of created model, and that kernel is shared by all models
+                BOOST_CHECK_EQUAL( accelerationModels.at( debrisName ).at( exertingBody ).size( ), 1 );
+                std::shared_ptr< basic_astrodynamics::AccelerationModel3d > manyBodyAcceleration =
+                        accelerationModels.at( debrisName ).at( exertingBody ).at( 0 );
+                BOOST_CHECK_EQUAL( basic_astrodynamics::getAccelerationModelType( manyBodyAcceleration ),
+                                   basic_astrodynamics::many_body_point_mass_gravity );
+
+                std::shared_ptr< ManyBodyPointMassGravityKernel > currentKernel =
+                        std::dynamic_pointer_cast< ManyBodyPointMassGravityAcceleration >(
+                            manyBodyAcceleration )->getAccelerationKernel( );
+                if( accelerationKernel == nullptr )
+                {
+                    accelerationKernel = currentKernel;
+                }
+                BOOST_CHECK( currentKernel == accelerationKernel );
+
+                // Create equivalent per-pair model, and compare accelerations
+                std::shared_ptr< basic_astrodynamics::AccelerationModel3d > perPairAcceleration =
+                        createAccelerationModel(
+                            bodies.at( debrisName ), bodies.at( exertingBody ), pointMassGravityAcceleration( ),
+                            debrisName, exertingBody,
+                            ( centralBody == "SSB" ) ? nullptr : bodies.at( centralBody ), centralBody, bodies );
+                BOOST_CHECK_EQUAL( basic_astrodynamics::getAccelerationModelType( perPairAcceleration ),
+                                   ( ( centralBody == exertingBody || centralBody == "SSB" ) ?
+                                         basic_astrodynamics::point_mass_gravity :
+                                         basic_astrodynamics::third_body_point_mass_gravity ) );
+
+                Eigen::Vector3d manyBodyAccelerationVector =
+                        basic_astrodynamics::updateAndGetAcceleration( manyBodyAcceleration, testTime );
+                Eigen::Vector3d perPairAccelerationVector =
+                        basic_astrodynamics::updateAndGetAcceleration( perPairAcceleration, testTime );
+
+                // Compare to within round-off of the direct acceleration (third-body accelerations are a small
+                // difference of two large terms)
+                double directAccelerationNorm =
+                        bodies.at( exertingBody )->getGravityFieldModel( )->getGravitationalParameter( ) /
+                        ( bodies.at( debrisName )->getPosition( ) - bodies.at( exertingBody )->getPosition( ) ).squaredNorm( );
+                for( unsigned int k = 0; k < 3; k++ )
+                {
+                    BOOST_CHECK_SMALL( manyBodyAccelerationVector( k ) - perPairAccelerationVector( k ),
+                                       8.0 * std::numeric_limits< double >::epsilon( ) * directAccelerationNorm );
+                }
+            }
+        }
+    }
+}
+
+//! Test whether propagation with the many-body kernel reproduces propagation with the per-pair models
+BOOST_AUTO_TEST_CASE( testManyBodyPointMassGravityPropagation )
+{
+    const int numberOfDebris = 10;
+
+    std::vector< Eigen::VectorXd > finalStates;
+    for( int useManyBodyModel = 0; useManyBodyModel < 2; useManyBodyModel++ )
+    {
+        SystemOfBodies bodies = createManyBodyTestBodies( numberOfDebris );
+
+        // Create accelerations of Earth, Moon and Sun on all debris objects
+        SelectedAccelerationMap accelerationMap;
+        std::vector< std::string > bodiesToPropagate;
+        std::vector< std::string > centralBodies;
+        Eigen::VectorXd initialState = Eigen::VectorXd::Zero( 6 * numberOfDebris );
+        for( int i = 0; i < numberOfDebris; i++ )
+        {
+            std::string debrisName = "Debris" + std::to_string( i );
+            for( std::string exertingBody : { "Earth", "Moon", "Sun" } )
+            {
+                accelerationMap[ debrisName ][ exertingBody ].push_back(
+                            useManyBodyModel ? manyBodyPointMassGravityAcceleration( ) :
+                                               pointMassGravityAcceleration( ) );
+            }
+            bodiesToPropagate.push_back( debrisName );
+            centralBodies.push_back( "Earth" );
+            initialState.segment( 6 * i, 6 ) = getDebrisInitialState( i );
+        }
+
+        std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+                std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                    centralBodies, createAccelerationModelsMap(
+                        bodies, accelerationMap, bodiesToPropagate, centralBodies ),
+                    bodiesToPropagate, initialState,
+                    std::make_shared< PropagationTimeTerminationSettings >( 86400.0 ) );
+        std::shared_ptr< IntegratorSettings< > > integratorSettings =
+                std::make_shared< IntegratorSettings< > >( rungeKutta4, 0.0, 30.0 );
+
+        SingleArcDynamicsSimulator< > dynamicsSimulator( bodies, integratorSettings, propagatorSettings );
+        finalStates.push_back( dynamicsSimulator.getEquationsOfMotionNumericalSolution( ).rbegin( )->second );
+    }
+
+    for( int i = 0; i < numberOfDebris; i++ )
+    {
+        BOOST_CHECK_SMALL( ( finalStates.at( 1 ) - finalStates.at( 0 ) ).segment( 6 * i, 3 ).norm( ), 1.0E-4 );
+        BOOST_CHECK_SMALL( ( finalStates.at( 1 ) - finalStates.at( 0 ) ).segment( 6 * i + 3, 3 ).norm( ), 1.0E-7 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -26,6 +26,7 @@
 #define BOOST_TEST_MAIN
 
 #include <cmath>
+#include <cstdlib>
 #include <limits>
 
 #include <boost/lambda/lambda.hpp>
@@ -34,9 +35,12 @@
 #include <boost/test/unit_test.hpp>
 
 #include <Eigen/Core>
+#include <Eigen/Geometry>
 
 #include "tudat/basics/testMacros.h"
 
+#include "tudat/astro/gravitation/sphericalHarmonicsAccelerationKernel.h"
+#include "tudat/astro/gravitation/sphericalHarmonicsGravityField.h"
 #include "tudat/astro/gravitation/sphericalHarmonicsGravityModel.h"
 #include "tudat/math/basic/sphericalHarmonics.h"
 
@@ -298,6 +302,128 @@ BOOST_AUTO_TEST_CASE( test_SphericalHarmonicsGravitationalAccelerationWrapperCla
 
     // Check if expected result matches computed result.
     TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, acceleration, 1.0e-15 );
+
+    // Recompute acceleration with order-major acceleration kernel, and check against expected result.
+    earthGravity->setUseAccelerationKernel( true );
+    earthGravity->updateMembers( );
+    BOOST_CHECK_EQUAL( earthGravity->getUseAccelerationKernel( ), true );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, earthGravity->getAcceleration( ), 1.0e-14 );
+
+    // Create acceleration model, using acceleration kernel, that retrieves coefficients from gravity field
+    std::shared_ptr< SphericalHarmonicsGravityField > gravityField = std::make_shared< SphericalHarmonicsGravityField >(
+                gravitationalParameter, planetaryRadius, cosineCoefficients, sineCoefficients );
+    int numberOfCoefficientRetrievals = 0;
+    SphericalHarmonicsGravitationalAccelerationModelPointer fieldEarthGravity
+            = std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                [ & ]( Eigen::Vector3d& input ){ input = position; },
+                [ = ]( ){ return gravitationalParameter; }, planetaryRadius,
+                [ & ]( ){ numberOfCoefficientRetrievals++; return gravityField->getCosineCoefficients( ); },
+                [ = ]( ){ return gravityField->getSineCoefficients( ); } );
+    fieldEarthGravity->setCoefficientUpdateCounterFunction(
+                [ = ]( ){ return gravityField->getCoefficientUpdateCounter( ); } );
+    fieldEarthGravity->setUseAccelerationKernel( true );
+    fieldEarthGravity->updateMembers( 0.0 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, fieldEarthGravity->getAcceleration( ), 1.0e-14 );
+
+    // Check that unmodified coefficients are not retrieved (and repacked) again when updating
+    const int numberOfInitialCoefficientRetrievals = numberOfCoefficientRetrievals;
+    fieldEarthGravity->updateMembers( 0.5 );
+    BOOST_CHECK_EQUAL( numberOfCoefficientRetrievals, numberOfInitialCoefficientRetrievals );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, fieldEarthGravity->getAcceleration( ), 1.0e-14 );
+
+    // Modify coefficients through gravity field, and check that the kernel uses the modified coefficients
+    Eigen::MatrixXd modifiedCosineCoefficients = cosineCoefficients;
+    modifiedCosineCoefficients( 2, 0 ) *= 2.0;
+    gravityField->setCosineCoefficients( modifiedCosineCoefficients );
+    BOOST_CHECK_EQUAL( gravityField->getCoefficientUpdateCounter( ), 1 );
+
+    fieldEarthGravity->updateMembers( 1.0 );
+    BOOST_CHECK_EQUAL( numberOfCoefficientRetrievals, numberOfInitialCoefficientRetrievals + 1 );
+    std::shared_ptr< basic_mathematics::SphericalHarmonicsCache > sphericalHarmonicsCache =
+            std::make_shared< basic_mathematics::SphericalHarmonicsCache >( 6, 7 );
+    std::map< std::pair< int, int >, Eigen::Vector3d > accelerationPerTerm;
+    Eigen::Vector3d modifiedExpectedAcceleration = computeGeodesyNormalizedGravitationalAccelerationSum(
+                position, gravitationalParameter, planetaryRadius, modifiedCosineCoefficients, sineCoefficients,
+                sphericalHarmonicsCache, accelerationPerTerm, false );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( modifiedExpectedAcceleration, fieldEarthGravity->getAcceleration( ), 1.0e-14 );
+    BOOST_CHECK( ( modifiedExpectedAcceleration - expectedAcceleration ).norm( ) > 1.0E-4 );
+}
+
+// Check order-major acceleration kernel against reference (cache-based) implementation, for single and batch evaluation.
+BOOST_AUTO_TEST_CASE( test_SphericalHarmonicsAccelerationKernel )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double planetaryRadius = 6378137.0;
+
+    // Test full field, field truncated at lower order than degree, and high-degree field
+    for( unsigned int test = 0; test < 3; test++ )
+    {
+        const int numberOfDegrees = ( test < 2 ) ? 61 : 361;
+        const int numberOfOrders = ( test == 1 ) ? 31 : numberOfDegrees;
+
+        // Generate arbitrary coefficients, with magnitude decreasing with degree
+        std::srand( 42 );
+        Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( numberOfDegrees, numberOfOrders );
+        Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( numberOfDegrees, numberOfOrders );
+        cosineCoefficients( 0, 0 ) = 1.0;
+        for( int degree = 2; degree < numberOfDegrees; degree++ )
+        {
+            for( int order = 0; ( order <= degree ) && ( order < numberOfOrders ); order++ )
+            {
+                cosineCoefficients( degree, order ) = 1.0E-5 / ( degree * degree ) *
+                        static_cast< double >( std::rand( ) ) / RAND_MAX;
+                if( order > 0 )
+                {
+                    sineCoefficients( degree, order ) = 1.0E-5 / ( degree * degree ) *
+                            static_cast< double >( std::rand( ) ) / RAND_MAX;
+                }
+            }
+        }
+
+        // Define positions at various latitudes/longitudes
+        Eigen::Matrix3Xd positions = Eigen::Matrix3Xd( 3, 5 );
+        positions.col( 0 ) << 7.0e6, 8.0e6, 9.0e6;
+        positions.col( 1 ) << -6.9e6, 1.0e5, -2.0e5;
+        positions.col( 2 ) << 1.0e5, -2.0e5, 7.1e6;
+        positions.col( 3 ) << -3.0e6, -4.0e6, 5.0e6;
+        positions.col( 4 ) << 2.0e7, -1.0e7, -8.0e6;
+
+        // Add arbitrary positions, such that the batch evaluation uses multiple (and an incomplete) blocks
+        const int numberOfRandomPositions = 2 * SphericalHarmonicsAccelerationKernel::BATCH_BLOCK_SIZE + 3;
+        positions.conservativeResize( 3, 5 + numberOfRandomPositions );
+        for( int i = 5; i < positions.cols( ); i++ )
+        {
+            Eigen::Vector3d direction = Eigen::Vector3d::Random( );
+            positions.col( i ) = ( 6.6e6 + 1.0e6 * static_cast< double >( std::rand( ) ) / RAND_MAX ) *
+                    direction.normalized( );
+        }
+
+        const Eigen::Matrix3d accelerationRotation =
+                Eigen::AngleAxisd( 0.3, Eigen::Vector3d::UnitZ( ) ).toRotationMatrix( );
+
+        SphericalHarmonicsAccelerationKernel accelerationKernel( cosineCoefficients, sineCoefficients );
+        std::shared_ptr< basic_mathematics::SphericalHarmonicsCache > sphericalHarmonicsCache =
+                std::make_shared< basic_mathematics::SphericalHarmonicsCache >( numberOfDegrees, numberOfOrders + 1 );
+        std::map< std::pair< int, int >, Eigen::Vector3d > accelerationPerTerm;
+
+        Eigen::Matrix3Xd batchAccelerations = accelerationKernel.computeAccelerations(
+                    positions, gravitationalParameter, planetaryRadius );
+        for( int i = 0; i < positions.cols( ); i++ )
+        {
+            Eigen::Vector3d referenceAcceleration = computeGeodesyNormalizedGravitationalAccelerationSum(
+                        positions.col( i ), gravitationalParameter, planetaryRadius,
+                        cosineCoefficients, sineCoefficients, sphericalHarmonicsCache,
+                        accelerationPerTerm, false, accelerationRotation );
+            Eigen::Vector3d kernelAcceleration = accelerationKernel.computeAcceleration(
+                        positions.col( i ), gravitationalParameter, planetaryRadius, accelerationRotation );
+
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( referenceAcceleration, kernelAcceleration, 1.0e-13 );
+            Eigen::Vector3d batchAcceleration = accelerationRotation * batchAccelerations.col( i );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( batchAcceleration, kernelAcceleration, 1.0e-14 );
+        }
+    }
 }
 
 BOOST_AUTO_TEST_SUITE_END( )
@@ -0,0 +1,285 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/basic_astro/keplerPropagator.h"
+#include "tudat/astro/basic_astro/orbitalElementConversions.h"
+#include "tudat/astro/ephemerides/keplerEphemeris.h"
+#include "tudat/astro/mission_segments/batchLambertRoutines.h"
+#include "tudat/astro/mission_segments/lambertRoutines.h"
+#include "tudat/basics/testMacros.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace mission_segments;
+
+BOOST_AUTO_TEST_SUITE( test_batch_lambert_routines )
+
+//! Gravitational parameter of the Sun.
+const double sunGravitationalParameter = 1.32712440018E20;
+
+//! Astronomical unit.
+const double astronomicalUnit = 1.495978707E11;
+
+//! Function to compute the position at arrival by propagating the Lambert solution from departure
+Eigen::Vector3d propagateLambertSolution( const Eigen::Vector3d& positionAtDeparture,
+                                          const Eigen::Vector3d& velocityAtDeparture,
+                                          const double timeOfFlight,
+                                          const double gravitationalParameter )
+{
+    Eigen::Vector6d cartesianState;
+    cartesianState << positionAtDeparture, velocityAtDeparture;
+    Eigen::Vector6d finalKeplerianState = orbital_element_conversions::propagateKeplerOrbit(
+                orbital_element_conversions::convertCartesianToKeplerianElements(
+                    cartesianState, gravitationalParameter ), timeOfFlight, gravitationalParameter );
+    return orbital_element_conversions::convertKeplerianToCartesianElements(
+                finalKeplerianState, gravitationalParameter ).segment( 0, 3 );
+}
+
+//! Function to generate a set of random heliocentric Lambert problems (elliptical and hyperbolic transfers)
+void generateLambertProblems( const int numberOfProblems,
+                              Eigen::Matrix< double, Eigen::Dynamic, 3 >& positionsAtDeparture,
+                              Eigen::Matrix< double, Eigen::Dynamic, 3 >& positionsAtArrival,
+                              Eigen::VectorXd& timesOfFlight )
+{
+    std::mt19937 randomNumberGenerator( 42 );
+    std::uniform_real_distribution< double > radiusDistribution( 0.5 * astronomicalUnit, 5.0 * astronomicalUnit );
+    std::uniform_real_distribution< double > angleDistribution( 0.0, 2.0 * mathematical_constants::PI );
+    std::uniform_real_distribution< double > latitudeDistribution( -0.3, 0.3 );
+    std::uniform_real_distribution< double > timeOfFlightDistribution( 10.0 * 86400.0, 1500.0 * 86400.0 );
+
+    positionsAtDeparture.resize( numberOfProblems, 3 );
+    positionsAtArrival.resize( numberOfProblems, 3 );
+    timesOfFlight.resize( numberOfProblems );
+    for( int i = 0; i < numberOfProblems; i++ )
+    {
+        for( int j = 0; j < 2; j++ )
+        {
+            double radius = radiusDistribution( randomNumberGenerator );
+            double longitude = angleDistribution( randomNumberGenerator );
+            double latitude = latitudeDistribution( randomNumberGenerator );
+            Eigen::Vector3d position = radius * Eigen::Vector3d(
+                        std::cos( latitude ) * std::cos( longitude ),
+                        std::cos( latitude ) * std::sin( longitude ), std::sin( latitude ) );
+            ( j == 0 ? positionsAtDeparture : positionsAtArrival ).row( i ) = position.transpose( );
+        }
+        timesOfFlight( i ) = timeOfFlightDistribution( randomNumberGenerator );
+    }
+}
+
+//! Test batch Lambert solver against scalar solver, and by propagating the solutions.
+BOOST_AUTO_TEST_CASE( testBatchLambertSolver )
+{
+    // Create problems (number not a multiple of the lane width, to test padding of last lanes)
+    const int numberOfProblems = 2003;
+    Eigen::Matrix< double, Eigen::Dynamic, 3 > positionsAtDeparture, positionsAtArrival;
+    Eigen::VectorXd timesOfFlight;
+    generateLambertProblems( numberOfProblems, positionsAtDeparture, positionsAtArrival, timesOfFlight );
+
+    // Add very short time-of-flight (hyperbolic transfer)
+    timesOfFlight( 0 ) = 5.0 * 86400.0;
+
+    for( bool isRetrograde : { false, true } )
+    {
+        Eigen::Matrix< double, Eigen::Dynamic, 3 > velocitiesAtDeparture, velocitiesAtArrival;
+        unsigned int numberOfFailedProblems = solveLambertProblemsIzzo(
+                    positionsAtDeparture, positionsAtArrival, timesOfFlight,
+                    Eigen::VectorXd::Constant( 1, sunGravitationalParameter ),
+                    velocitiesAtDeparture, velocitiesAtArrival, isRetrograde );
+        BOOST_CHECK_EQUAL( numberOfFailedProblems, 0 );
+        BOOST_CHECK_EQUAL( velocitiesAtDeparture.rows( ), numberOfProblems );
+
+        for( int i = 0; i < numberOfProblems; i++ )
+        {
+            Eigen::Vector3d velocityAtDeparture = velocitiesAtDeparture.row( i ).transpose( );
+            Eigen::Vector3d velocityAtArrival = velocitiesAtArrival.row( i ).transpose( );
+
+            // Compare with scalar solver
+            Eigen::Vector3d scalarVelocityAtDeparture, scalarVelocityAtArrival;
+            solveLambertProblemIzzo( positionsAtDeparture.row( i ).transpose( ), positionsAtArrival.row( i ).transpose( ),
+                                     timesOfFlight( i ), sunGravitationalParameter,
+                                     scalarVelocityAtDeparture, scalarVelocityAtArrival, isRetrograde );
+            BOOST_CHECK_SMALL( ( velocityAtDeparture - scalarVelocityAtDeparture ).norm( ) /
+                               scalarVelocityAtDeparture.norm( ), 1.0E-8 );
+            BOOST_CHECK_SMALL( ( velocityAtArrival - scalarVelocityAtArrival ).norm( ) /
+                               scalarVelocityAtArrival.norm( ), 1.0E-8 );
+
+            // Check direction of motion
+            Eigen::Vector3d angularMomentum = positionsAtDeparture.row( i ).transpose( ).cross( velocityAtDeparture );
+            BOOST_CHECK_EQUAL( angularMomentum.z( ) < 0.0, isRetrograde );
+
+            // Check that arrival position is reached (to within precision of Kepler propagation of strongly hyperbolic orbits)
+            if( i % 10 == 0 )
+            {
+                Eigen::Vector3d propagatedPosition = propagateLambertSolution(
+                            positionsAtDeparture.row( i ).transpose( ), velocityAtDeparture, timesOfFlight( i ),
+                            sunGravitationalParameter );
+                BOOST_CHECK_SMALL( ( propagatedPosition - positionsAtArrival.row( i ).transpose( ) ).norm( ) /
+                                   positionsAtArrival.row( i ).norm( ), 1.0E-7 );
+            }
+        }
+
+        // Check that multithreaded results are identical
+        Eigen::Matrix< double, Eigen::Dynamic, 3 > multiThreadVelocitiesAtDeparture, multiThreadVelocitiesAtArrival;
+        solveLambertProblemsIzzo( positionsAtDeparture, positionsAtArrival, timesOfFlight,
+                                  Eigen::VectorXd::Constant( numberOfProblems, sunGravitationalParameter ),
+                                  multiThreadVelocitiesAtDeparture, multiThreadVelocitiesAtArrival, isRetrograde,
+                                  1.0E-5, 15, 4 );
+        BOOST_CHECK_EQUAL( ( multiThreadVelocitiesAtDeparture - velocitiesAtDeparture ).cwiseAbs( ).maxCoeff( ), 0.0 );
+        BOOST_CHECK_EQUAL( ( multiThreadVelocitiesAtArrival - velocitiesAtArrival ).cwiseAbs( ).maxCoeff( ), 0.0 );
+    }
+}
+
+//! Test handling of invalid problems by batch Lambert solver.
+BOOST_AUTO_TEST_CASE( testBatchLambertSolverInvalidInput )
+{
+    Eigen::Matrix< double, Eigen::Dynamic, 3 > positionsAtDeparture, positionsAtArrival;
+    Eigen::VectorXd timesOfFlight;
+    generateLambertProblems( 6, positionsAtDeparture, positionsAtArrival, timesOfFlight );
+
+    // Set non-positive times-of-flight and collinear positions
+    timesOfFlight( 1 ) = 0.0;
+    timesOfFlight( 2 ) = -86400.0;
+    positionsAtArrival.row( 4 ) = -2.0 * positionsAtDeparture.row( 4 );
+
+    Eigen::Matrix< double, Eigen::Dynamic, 3 > velocitiesAtDeparture, velocitiesAtArrival;
+    unsigned int numberOfFailedProblems = solveLambertProblemsIzzo(
+                positionsAtDeparture, positionsAtArrival, timesOfFlight,
+                Eigen::VectorXd::Constant( 1, sunGravitationalParameter ), velocitiesAtDeparture, velocitiesAtArrival );
+    BOOST_CHECK_EQUAL( numberOfFailedProblems, 3 );
+    for( int i = 0; i < 6; i++ )
+    {
+        bool isProblemInvalid = ( i == 1 || i == 2 || i == 4 );
+        BOOST_CHECK_EQUAL( velocitiesAtDeparture.row( i ).array( ).isNaN( ).all( ), isProblemInvalid );
+        BOOST_CHECK_EQUAL( velocitiesAtArrival.row( i ).array( ).isNaN( ).all( ), isProblemInvalid );
+    }
+
+    // Check inconsistent input sizes
+    BOOST_CHECK_THROW( solveLambertProblemsIzzo(
+                           positionsAtDeparture, positionsAtArrival.topRows( 5 ), timesOfFlight,
+                           Eigen::VectorXd::Constant( 1, sunGravitationalParameter ),
+                           velocitiesAtDeparture, velocitiesAtArrival ), std::runtime_error );
+    BOOST_CHECK_THROW( solveLambertProblemsIzzo(
+                           positionsAtDeparture, positionsAtArrival, timesOfFlight,
+                           Eigen::VectorXd::Constant( 2, sunGravitationalParameter ),
+                           velocitiesAtDeparture, velocitiesAtArrival ), std::runtime_error );
+}
+
+//! Test grid of excess velocities between two bodies (porkchop plot), and compare computation time with scalar solver.
+BOOST_AUTO_TEST_CASE( testLambertTransferGrid )
+{
+    using namespace ephemerides;
+
+    // Create approximate Earth and Mars ephemerides
+    Eigen::Vector6d earthKeplerianElements, marsKeplerianElements;
+    earthKeplerianElements << 1.0 * astronomicalUnit, 0.0167, 0.0, 1.80, 0.0, 6.24;
+    marsKeplerianElements << 1.524 * astronomicalUnit, 0.0934, 1.85 * mathematical_constants::PI / 180.0,
+            5.00, 0.865, 0.338;
+    std::shared_ptr< Ephemeris > earthEphemeris = std::make_shared< KeplerEphemeris >(
+                earthKeplerianElements, 0.0, sunGravitationalParameter, "Sun", "ECLIPJ2000" );
+    std::shared_ptr< Ephemeris > marsEphemeris = std::make_shared< KeplerEphemeris >(
+                marsKeplerianElements, 0.0, sunGravitationalParameter, "Sun", "ECLIPJ2000" );
+
+    // Create grid of departure and arrival times, including arrival times before departure times
+    std::vector< double > departureTimes, arrivalTimes;
+    for( int i = 0; i < 101; i++ )
+    {
+        departureTimes.push_back( i * 4.0 * 86400.0 );
+    }
+    for( int i = 0; i < 203; i++ )
+    {
+        arrivalTimes.push_back( 300.0 * 86400.0 + i * 3.0 * 86400.0 );
+    }
+
+    Eigen::MatrixXd departureExcessVelocities, arrivalExcessVelocities;
+    unsigned int numberOfFailedProblems = computeLambertTransferGridExcessVelocities(
+                earthEphemeris, marsEphemeris, departureTimes, arrivalTimes, sunGravitationalParameter,
+                departureExcessVelocities, arrivalExcessVelocities );
+    BOOST_CHECK_EQUAL( numberOfFailedProblems, 0 );
+    BOOST_CHECK_EQUAL( departureExcessVelocities.rows( ), 101 );
+    BOOST_CHECK_EQUAL( departureExcessVelocities.cols( ), 203 );
+
+    // Compute grid with scalar solver
+    Eigen::MatrixXd scalarDepartureExcessVelocities = Eigen::MatrixXd::Constant( 101, 203, TUDAT_NAN );
+    Eigen::MatrixXd scalarArrivalExcessVelocities = Eigen::MatrixXd::Constant( 101, 203, TUDAT_NAN );
+    for( unsigned int i = 0; i < departureTimes.size( ); i++ )
+    {
+        Eigen::Vector6d earthState = earthEphemeris->getCartesianState( departureTimes.at( i ) );
+        for( unsigned int j = 0; j < arrivalTimes.size( ); j++ )
+        {
+            if( arrivalTimes.at( j ) > departureTimes.at( i ) )
+            {
+                Eigen::Vector6d marsState = marsEphemeris->getCartesianState( arrivalTimes.at( j ) );
+                Eigen::Vector3d velocityAtDeparture, velocityAtArrival;
+                solveLambertProblemIzzo( earthState.segment( 0, 3 ), marsState.segment( 0, 3 ),
+                                         arrivalTimes.at( j ) - departureTimes.at( i ), sunGravitationalParameter,
+                                         velocityAtDeparture, velocityAtArrival );
+                scalarDepartureExcessVelocities( i, j ) = ( velocityAtDeparture - earthState.segment( 3, 3 ) ).norm( );
+                scalarArrivalExcessVelocities( i, j ) = ( velocityAtArrival - marsState.segment( 3, 3 ) ).norm( );
+            }
+        }
+    }
+
+    // Compare results (absolute tolerance in m/s)
+    int numberOfValidEntries = 0;
+    for( unsigned int i = 0; i < departureTimes.size( ); i++ )
+    {
+        for( unsigned int j = 0; j < arrivalTimes.size( ); j++ )
+        {
+            bool isTransferValid = arrivalTimes.at( j ) > departureTimes.at( i );
+            BOOST_CHECK_EQUAL( std::isnan( departureExcessVelocities( i, j ) ), !isTransferValid );
+            BOOST_CHECK_EQUAL( std::isnan( arrivalExcessVelocities( i, j ) ), !isTransferValid );
+            if( isTransferValid )
+            {
+                BOOST_CHECK_SMALL( departureExcessVelocities( i, j ) - scalarDepartureExcessVelocities( i, j ), 1.0E-3 );
+                BOOST_CHECK_SMALL( arrivalExcessVelocities( i, j ) - scalarArrivalExcessVelocities( i, j ), 1.0E-3 );
+                numberOfValidEntries++;
+            }
+        }
+    }
+    BOOST_CHECK( numberOfValidEntries > 15000 );
+
+    // Check that multithreaded results are identical
+    Eigen::MatrixXd multiThreadDepartureExcessVelocities, multiThreadArrivalExcessVelocities;
+    computeLambertTransferGridExcessVelocities(
+                earthEphemeris, marsEphemeris, departureTimes, arrivalTimes, sunGravitationalParameter,
+                multiThreadDepartureExcessVelocities, multiThreadArrivalExcessVelocities, 4 );
+    for( unsigned int i = 0; i < departureTimes.size( ); i++ )
+    {
+        for( unsigned int j = 0; j < arrivalTimes.size( ); j++ )
+        {
+            if( arrivalTimes.at( j ) > departureTimes.at( i ) )
+            {
+                BOOST_CHECK_EQUAL( multiThreadDepartureExcessVelocities( i, j ), departureExcessVelocities( i, j ) );
+                BOOST_CHECK_EQUAL( multiThreadArrivalExcessVelocities( i, j ), arrivalExcessVelocities( i, j ) );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -17,6 +17,7 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 
+#include <random>
 #include <vector>
 
 #include <boost/make_shared.hpp>
@@ -374,6 +375,122 @@ BOOST_AUTO_TEST_CASE( testMGA1DSMVFTrajectory2 )
 }
 
 
+//! Test evaluation of trajectory from single parameter vector, and concurrent evaluation of population of trajectories
+BOOST_AUTO_TEST_CASE( testTransferTrajectoryPopulationEvaluation )
+{
+    // Create settings for Cassini 2 trajectory (MGA-1DSM velocity formulation)
+    std::vector< std::string > bodyOrder = { "Earth", "Venus", "Venus",  "Earth", "Jupiter", "Saturn" };
+    std::vector< std::shared_ptr< TransferLegSettings > > transferLegSettings;
+    std::vector< std::shared_ptr< TransferNodeSettings > > transferNodeSettings;
+    getMgaTransferTrajectorySettingsWithVelocityBasedDsm(
+                transferLegSettings, transferNodeSettings, bodyOrder,
+                std::make_pair( std::numeric_limits< double >::infinity( ), 0.0 ),
+                std::make_pair( std::numeric_limits< double >::infinity( ), 0.0 ) );
+
+    simulation_setup::SystemOfBodies bodies = createSimplifiedSystemOfBodies( );
+    std::shared_ptr< TransferTrajectory > transferTrajectory = createTransferTrajectory(
+                bodies, transferLegSettings, transferNodeSettings, bodyOrder, "Sun" );
+
+    // Define node times and free parameters
+    double JD = physical_constants::JULIAN_DAY;
+    std::vector< double > timesOfFlight = { 167.378952534645 * JD, 424.028254165204 * JD, 53.2897409769205 * JD,
+                                            589.766954923325 * JD, 2200.00000000000 * JD };
+    std::vector< double > nodeTimes = { ( -779.046753814506 - 0.5 ) * JD };
+    for( unsigned int i = 0; i < timesOfFlight.size( ); i++ )
+    {
+        nodeTimes.push_back( nodeTimes.at( i ) + timesOfFlight.at( i ) );
+    }
+
+    std::vector< Eigen::VectorXd > transferLegFreeParameters = {
+        ( Eigen::VectorXd( 1 ) << 0.769483451363201 ).finished( ),
+        ( Eigen::VectorXd( 1 ) << 0.513289529822621 ).finished( ),
+        ( Eigen::VectorXd( 1 ) << 0.0274175362264024 ).finished( ),
+        ( Eigen::VectorXd( 1 ) << 0.263985256705873 ).finished( ),
+        ( Eigen::VectorXd( 1 ) << 0.599984695281461 ).finished( ) };
+    std::vector< Eigen::VectorXd > transferNodeFreeParameters = {
+        ( Eigen::VectorXd( 3 ) << 3259.11446832345, 0.525976214695235 * 2 * 3.14159265358979,
+          std::acos(  2 * 0.38086496458657 - 1 ) - 3.14159265358979 / 2 ).finished( ),
+        ( Eigen::VectorXd( 3 ) << 1.34877968657176 * 6.052e6, -1.5937371121191, 0.0  ).finished( ),
+        ( Eigen::VectorXd( 3 ) << 1.05 * 6.052e6, -1.95952512232447, 0.0  ).finished( ),
+        ( Eigen::VectorXd( 3 ) << 1.30730278372017 * 6.378e6, -1.55498859283059, 0.0  ).finished( ),
+        ( Eigen::VectorXd( 3 ) << 69.8090142993495 * 7.1492e7, -1.5134625299674, 0.0  ).finished( ),
+        Eigen::VectorXd( 0 ) };
+
+    // Create single vector of trajectory parameters, using indices from getParameterVectorDecompositionIndices
+    std::vector< std::pair< int, int > > legParameterIndices, nodeParameterIndices;
+    getParameterVectorDecompositionIndices(
+                transferLegSettings, transferNodeSettings, legParameterIndices, nodeParameterIndices );
+
+    BOOST_CHECK_EQUAL( transferTrajectory->getNumberOfTrajectoryParameters( ), 26 );
+    Eigen::VectorXd trajectoryParameters = Eigen::VectorXd::Zero( 26 );
+    trajectoryParameters( 0 ) = nodeTimes.at( 0 );
+    for( unsigned int i = 0; i < timesOfFlight.size( ); i++ )
+    {
+        trajectoryParameters( i + 1 ) = timesOfFlight.at( i );
+        trajectoryParameters.segment( legParameterIndices.at( i ).first, legParameterIndices.at( i ).second ) =
+                transferLegFreeParameters.at( i );
+    }
+    for( unsigned int i = 0; i < nodeParameterIndices.size( ); i++ )
+    {
+        trajectoryParameters.segment( nodeParameterIndices.at( i ).first, nodeParameterIndices.at( i ).second ) =
+                transferNodeFreeParameters.at( i );
+    }
+
+    // Check that evaluation from single parameter vector is identical to evaluation from separate parameters
+    transferTrajectory->evaluateTrajectory(
+                nodeTimes, transferLegFreeParameters, transferNodeFreeParameters );
+    double nominalDeltaV = transferTrajectory->getTotalDeltaV( );
+    transferTrajectory->evaluateTrajectory( Eigen::VectorXd( 1.01 * trajectoryParameters ) );
+    transferTrajectory->evaluateTrajectory( trajectoryParameters );
+    BOOST_CHECK_EQUAL( transferTrajectory->getTotalDeltaV( ), nominalDeltaV );
+    BOOST_CHECK_CLOSE_FRACTION( transferTrajectory->getTotalTimeOfFlight( ),
+                                nodeTimes.back( ) - nodeTimes.front( ), 1.0E-14 );
+    BOOST_CHECK_CLOSE_FRACTION( 8385.15784516116, nominalDeltaV, 1.0E-3 );
+
+    BOOST_CHECK_THROW( transferTrajectory->evaluateTrajectory( trajectoryParameters.segment( 0, 25 ) ),
+                       std::runtime_error );
+
+    // Create population by perturbing the nominal parameters
+    int populationSize = 1000;
+    Eigen::MatrixXd populationParameters = trajectoryParameters.replicate( 1, populationSize );
+    std::mt19937 randomNumberGenerator( 42 );
+    std::uniform_real_distribution< double > perturbationDistribution( -0.01, 0.01 );
+    for( int i = 1; i < populationSize; i++ )
+    {
+        for( int j = 0; j < populationParameters.rows( ); j++ )
+        {
+            populationParameters( j, i ) *= ( 1.0 + perturbationDistribution( randomNumberGenerator ) );
+        }
+    }
+
+    // Evaluate population sequentially
+    Eigen::VectorXd sequentialDeltaV = Eigen::VectorXd::Zero( populationSize );
+    for( int i = 0; i < populationSize; i++ )
+    {
+        transferTrajectory->evaluateTrajectory( populationParameters.col( i ) );
+        sequentialDeltaV( i ) = transferTrajectory->getTotalDeltaV( );
+    }
+
+    // Evaluate population concurrently, and check that results are identical
+    int numberOfThreads = 4;
+    std::vector< std::shared_ptr< TransferTrajectory > > transferTrajectoriesPerThread =
+            createTransferTrajectoriesPerThread(
+                [ ]( ){ return createSimplifiedSystemOfBodies( ); },
+                transferLegSettings, transferNodeSettings, bodyOrder, "Sun", numberOfThreads );
+    BOOST_CHECK_EQUAL( transferTrajectoriesPerThread.size( ), numberOfThreads );
+
+    Eigen::VectorXd populationDeltaV;
+    evaluateTransferTrajectoryPopulation( transferTrajectoriesPerThread, populationParameters, populationDeltaV );
+
+    BOOST_CHECK_EQUAL( populationDeltaV.rows( ), populationSize );
+    BOOST_CHECK_EQUAL( populationDeltaV( 0 ), nominalDeltaV );
+    for( int i = 0; i < populationSize; i++ )
+    {
+        BOOST_CHECK_EQUAL( populationDeltaV( i ), sequentialDeltaV( i ) );
+    }
+}
+
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -403,6 +403,128 @@ BOOST_AUTO_TEST_CASE( testObservationNoiseModels )
         }
 }
 
+//! Test whether observations simulated in parallel (with a separate environment per thread) are identical to sequential results
+BOOST_AUTO_TEST_CASE( testParallelObservationSimulation )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    double initialEphemerisTime = double( 1.0E7 );
+    double finalEphemerisTime = double( 1.0E7 + 1.0 * physical_constants::JULIAN_DAY );
+
+    // Create one environment (with tabulated ephemerides, and a rotation model that does not call Spice) per thread
+    const unsigned int numberOfThreads = 3;
+    BodyListSettings bodySettings =
+            getDefaultBodySettings( { "Earth", "Moon" }, initialEphemerisTime - 3600.0, finalEphemerisTime + 3600.0 );
+    bodySettings.at( "Earth" )->rotationModelSettings = std::make_shared< SimpleRotationModelSettings >(
+                "ECLIPJ2000", "IAU_Earth",
+                spice_interface::computeRotationQuaternionBetweenFrames(
+                    "ECLIPJ2000", "IAU_Earth", initialEphemerisTime ),
+                initialEphemerisTime, 2.0 * mathematical_constants::PI /
+                ( physical_constants::JULIAN_DAY ) );
+    std::vector< std::string > groundStationNames = { "Station1", "Station2", "Station3" };
+    std::vector< SystemOfBodies > threadBodies;
+    for( unsigned int i = 0; i < numberOfThreads; i++ )
+    {
+        threadBodies.push_back( createSystemOfBodies( bodySettings ) );
+        createGroundStation( threadBodies.at( i ).at( "Earth" ), "Station1", ( Eigen::Vector3d( ) << 0.0, 0.35, 0.0 ).finished( ), geodetic_position );
+        createGroundStation( threadBodies.at( i ).at( "Earth" ), "Station2", ( Eigen::Vector3d( ) << 0.0, -0.55, 2.0 ).finished( ), geodetic_position );
+        createGroundStation( threadBodies.at( i ).at( "Earth" ), "Station3", ( Eigen::Vector3d( ) << 0.0, 0.05, 4.0 ).finished( ), geodetic_position );
+    }
+
+    // Define link ends and observation models
+    std::map< ObservableType, std::vector< LinkEnds > > linkEndsPerObservable;
+    for( unsigned int i = 0; i < groundStationNames.size( ); i++ )
+    {
+        LinkEnds linkEnds;
+        linkEnds[ receiver ] = std::make_pair( "Earth", groundStationNames.at( i ) );
+        linkEnds[ transmitter ] = std::make_pair( "Moon", "" );
+        linkEndsPerObservable[ one_way_range ].push_back( linkEnds );
+        linkEndsPerObservable[ one_way_doppler ].push_back( linkEnds );
+        linkEndsPerObservable[ angular_position ].push_back( linkEnds );
+    }
+
+    std::vector< std::shared_ptr< ObservationModelSettings > > observationSettingsList;
+    for( auto linkEndIterator : linkEndsPerObservable )
+    {
+        for( unsigned int i = 0; i < linkEndIterator.second.size( ); i++ )
+        {
+            observationSettingsList.push_back( std::make_shared< ObservationModelSettings >(
+                                                   linkEndIterator.first, linkEndIterator.second.at( i ) ) );
+        }
+    }
+
+    std::vector< std::vector< std::shared_ptr< ObservationSimulatorBase< double, double > > > > threadObservationSimulators;
+    for( unsigned int i = 0; i < numberOfThreads; i++ )
+    {
+        threadObservationSimulators.push_back( createObservationSimulators( observationSettingsList, threadBodies.at( i ) ) );
+    }
+
+    // Define observation times, simulation settings and elevation angle constraints
+    std::vector< double > observationTimes;
+    for( unsigned int i = 0; i < 2000; i++ )
+    {
+        observationTimes.push_back( initialEphemerisTime + 1000.0 + static_cast< double >( i ) * 30.0 );
+    }
+
+    std::vector< std::shared_ptr< ObservationSimulationSettings< double > > > measurementSimulationInput;
+    for( auto linkEndIterator : linkEndsPerObservable )
+    {
+        for( unsigned int i = 0; i < linkEndIterator.second.size( ); i++ )
+        {
+            measurementSimulationInput.push_back(
+                        std::make_shared< TabulatedObservationSimulationSettings< > >(
+                            linkEndIterator.first, linkEndIterator.second.at( i ), observationTimes, receiver,
+                            elevationAngleViabilitySettings(
+                                std::vector< std::pair< std::string, std::string > >(
+                                    { std::make_pair( "Earth", groundStationNames.at( i ) ) } ), 0.1 ) ) );
+        }
+    }
+
+    for( unsigned int test = 0; test < 2; test++ )
+    {
+        // Add (seeded) random noise in second test, to check that noise is added in same order
+        std::function< double( const double ) > noiseFunction;
+        if( test == 1 )
+        {
+            noiseFunction = std::bind( &utilities::evaluateFunctionWithoutInputArgumentDependency< double, const double >,
+                                       createBoostContinuousRandomVariableGeneratorFunction(
+                                           normal_boost_distribution, { 0.0, 1.0 }, 0.0 ), std::placeholders::_1 );
+            addNoiseFunctionToObservationSimulationSettings( measurementSimulationInput, noiseFunction );
+        }
+        std::shared_ptr< ObservationCollection< > > sequentialObservations = simulateObservations< double, double >(
+                    measurementSimulationInput, threadObservationSimulators.at( 0 ), threadBodies.at( 0 ) );
+
+        if( test == 1 )
+        {
+            noiseFunction = std::bind( &utilities::evaluateFunctionWithoutInputArgumentDependency< double, const double >,
+                                       createBoostContinuousRandomVariableGeneratorFunction(
+                                           normal_boost_distribution, { 0.0, 1.0 }, 0.0 ), std::placeholders::_1 );
+            clearNoiseFunctionFromObservationSimulationSettings( measurementSimulationInput );
+            addNoiseFunctionToObservationSimulationSettings( measurementSimulationInput, noiseFunction );
+        }
+        std::shared_ptr< ObservationCollection< > > parallelObservations = simulateObservations< double, double >(
+                    measurementSimulationInput, threadObservationSimulators, threadBodies, 150 );
+
+        for( auto linkEndIterator : linkEndsPerObservable )
+        {
+            for( unsigned int i = 0; i < linkEndIterator.second.size( ); i++ )
+            {
+                std::shared_ptr< SingleObservationSet< > > sequentialSet =
+                        sequentialObservations->getObservations( ).at( linkEndIterator.first ).at( linkEndIterator.second.at( i ) ).at( 0 );
+                std::shared_ptr< SingleObservationSet< > > parallelSet =
+                        parallelObservations->getObservations( ).at( linkEndIterator.first ).at( linkEndIterator.second.at( i ) ).at( 0 );
+
+                // Check that viability constraint removed part of the observations
+                BOOST_CHECK( sequentialSet->getObservationTimes( ).size( ) > 0 );
+                BOOST_CHECK( sequentialSet->getObservationTimes( ).size( ) < observationTimes.size( ) );
+
+                BOOST_CHECK( sequentialSet->getObservationTimes( ) == parallelSet->getObservationTimes( ) );
+                BOOST_CHECK( sequentialSet->getObservationsVector( ) == parallelSet->getObservationsVector( ) );
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 }
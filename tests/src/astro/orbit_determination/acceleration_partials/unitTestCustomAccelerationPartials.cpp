@@ -0,0 +1,250 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "tudat/basics/testMacros.h"
+#include "tudat/math/basic/linearAlgebra.h"
+#include "tudat/astro/orbit_determination/acceleration_partials/customAccelerationPartial.h"
+#include "tudat/astro/orbit_determination/acceleration_partials/numericalAccelerationPartial.h"
+#include "tudat/simulation/estimation_setup/createAccelerationPartials.h"
+#include "tudat/simulation/propagation_setup/createAccelerationModels.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::simulation_setup;
+using namespace tudat::acceleration_partials;
+using namespace tudat::basic_astrodynamics;
+
+BOOST_AUTO_TEST_SUITE( test_custom_acceleration_partials )
+
+//! Point mass gravity acceleration, as function of relative state, templated on scalar type
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 3, 1 > computePointMassGravity(
+        const Eigen::Matrix< ScalarType, 6, 1 >& relativeState,
+        const double gravitationalParameter )
+{
+    Eigen::Matrix< ScalarType, 3, 1 > relativePosition = relativeState.segment( 0, 3 );
+    ScalarType distance = relativePosition.norm( );
+    Eigen::Matrix< ScalarType, 3, 1 > acceleration =
+            -gravitationalParameter * relativePosition / ( distance * distance * distance );
+    return acceleration;
+}
+
+//! Drag acceleration in exponential atmosphere co-rotating with central body, templated on scalar type
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 3, 1 > computeExponentialAtmosphereDrag(
+        const Eigen::Matrix< ScalarType, 6, 1 >& relativeState,
+        const double referenceDensity, const double referenceRadius, const double scaleHeight,
+        const double ballisticCoefficient, const Eigen::Vector3d& rotationRate )
+{
+    Eigen::Matrix< ScalarType, 3, 1 > relativePosition = relativeState.segment( 0, 3 );
+    Eigen::Matrix< ScalarType, 3, 1 > airspeedVelocity =
+            relativeState.segment( 3, 3 ) - rotationRate.cast< ScalarType >( ).cross( relativePosition );
+    ScalarType density = referenceDensity * exp( -( relativePosition.norm( ) - referenceRadius ) / scaleHeight );
+    Eigen::Matrix< ScalarType, 3, 1 > acceleration =
+            -0.5 * ballisticCoefficient * density * airspeedVelocity.norm( ) * airspeedVelocity;
+    return acceleration;
+}
+
+//! Constant thrust acceleration along the velocity vector, templated on scalar type
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 3, 1 > computeTangentialThrust(
+        const Eigen::Matrix< ScalarType, 6, 1 >& relativeState,
+        const double thrustAcceleration )
+{
+    Eigen::Matrix< ScalarType, 3, 1 > relativeVelocity = relativeState.segment( 3, 3 );
+    Eigen::Matrix< ScalarType, 3, 1 > acceleration = thrustAcceleration * relativeVelocity / relativeVelocity.norm( );
+    return acceleration;
+}
+
+//! Function to compute the partials of an acceleration w.r.t. the state of the accelerated body from a partial object
+Eigen::Matrix< double, 3, 6 > getAcceleratedBodyStatePartial(
+        const std::shared_ptr< AccelerationPartial > accelerationPartial,
+        const double time )
+{
+    Eigen::MatrixXd statePartial = Eigen::MatrixXd::Zero( 3, 6 );
+    accelerationPartial->resetTime( );
+    accelerationPartial->update( time );
+    accelerationPartial->wrtPositionOfAcceleratedBody( statePartial.block( 0, 0, 3, 6 ), true, 0, 0 );
+    accelerationPartial->wrtVelocityOfAcceleratedBody( statePartial.block( 0, 0, 3, 6 ), true, 0, 3 );
+    return statePartial;
+}
+
+//! Function to compute the partials of an acceleration w.r.t. the state of the accelerated body by central differences
+Eigen::Matrix< double, 3, 6 > getNumericalAcceleratedBodyStatePartial(
+        const std::shared_ptr< AccelerationModel3d > accelerationModel,
+        const std::shared_ptr< Body > acceleratedBody,
+        const Eigen::Vector6d& nominalState,
+        const double time )
+{
+    Eigen::Matrix< double, 3, 6 > statePartial;
+    std::function< void( Eigen::Vector6d ) > stateSetFunction =
+            std::bind( &Body::setState, acceleratedBody, std::placeholders::_1 );
+    statePartial.block( 0, 0, 3, 3 ) = calculateAccelerationWrtStatePartials(
+                stateSetFunction, accelerationModel, nominalState, Eigen::Vector3d::Constant( 1.0 ), 0,
+                emptyFunction, time );
+    statePartial.block( 0, 3, 3, 3 ) = calculateAccelerationWrtStatePartials(
+                stateSetFunction, accelerationModel, nominalState, Eigen::Vector3d::Constant( 1.0E-3 ), 3,
+                emptyFunction, time );
+    acceleratedBody->setState( nominalState );
+    return statePartial;
+}
+
+//! Compare state partials of custom accelerations computed by automatic differentiation with analytical and numerical
+//! partials
+BOOST_AUTO_TEST_CASE( testCustomAccelerationPartials )
+{
+    // Create bodies
+    double earthGravitationalParameter = 3.986004418E14;
+    std::shared_ptr< Body > earth = std::make_shared< Body >( );
+    std::shared_ptr< Body > vehicle = std::make_shared< Body >( );
+    earth->setGravityFieldModel( std::make_shared< gravitation::GravityFieldModel >( earthGravitationalParameter ) );
+
+    SystemOfBodies bodies;
+    bodies.addBody( earth, "Earth" );
+    bodies.addBody( vehicle, "Vehicle" );
+
+    Eigen::Vector6d earthState;
+    earthState << 1.4E11, -2.1E10, 3.0E9, 4.1E3, 2.8E4, -1.2E3;
+    Eigen::Vector6d vehicleRelativeState;
+    vehicleRelativeState << 6.6E6, -1.3E6, 4.5E5, 1.2E3, 7.1E3, 2.4E3;
+    Eigen::Vector6d vehicleState = earthState + vehicleRelativeState;
+    earth->setState( earthState );
+    vehicle->setState( vehicleState );
+
+    double testTime = 1.0E6;
+
+    // Define settings of custom accelerations
+    double referenceDensity = 3.6E-10;
+    double referenceRadius = 6.378E6;
+    double scaleHeight = 7.0E4;
+    double ballisticCoefficient = 2.2 * 4.0 / 500.0;
+    Eigen::Vector3d earthRotationRate = Eigen::Vector3d::UnitZ( ) * 7.292115E-5;
+    double thrustAcceleration = 1.0E-4;
+
+    std::vector< std::shared_ptr< AccelerationSettings > > customAccelerationSettings;
+    customAccelerationSettings.push_back(
+                differentiableCustomAccelerationSettings(
+                    [ = ]( const double, const auto& state ){ return computePointMassGravity( state, earthGravitationalParameter ); } ) );
+    customAccelerationSettings.push_back(
+                differentiableCustomAccelerationSettings(
+                    [ = ]( const double, const auto& state ){
+        return computeExponentialAtmosphereDrag(
+                    state, referenceDensity, referenceRadius, scaleHeight, ballisticCoefficient, earthRotationRate ); } ) );
+    customAccelerationSettings.push_back(
+                differentiableCustomAccelerationSettings(
+                    [ = ]( const double, const auto& state ){ return computeTangentialThrust( state, thrustAcceleration ); } ) );
+
+    // Compute analytical partials: use existing partial object for point mass gravity, and manually derived for others.
+    std::shared_ptr< gravitation::CentralGravitationalAccelerationModel3d > centralGravity =
+            createCentralGravityAcceleratioModel( vehicle, earth, "Vehicle", "Earth", false );
+    std::shared_ptr< AccelerationPartial > centralGravityPartial = createAnalyticalAccelerationPartial(
+                centralGravity, std::make_pair( "Vehicle", vehicle ), std::make_pair( "Earth", earth ), bodies );
+
+    std::vector< std::function< Eigen::Matrix< double, 3, 6 >( ) > > analyticalPartialFunctions;
+    analyticalPartialFunctions.push_back( [ = ]( )
+    {
+        return getAcceleratedBodyStatePartial( centralGravityPartial, testTime );
+    } );
+    analyticalPartialFunctions.push_back( [ = ]( )
+    {
+        Eigen::Vector6d relativeState = vehicle->getState( ) - earth->getState( );
+        Eigen::Vector3d relativePosition = relativeState.segment( 0, 3 );
+        Eigen::Vector3d airspeedVelocity = relativeState.segment( 3, 3 ) - earthRotationRate.cross( relativePosition );
+        double airspeed = airspeedVelocity.norm( );
+        double density = referenceDensity * std::exp( -( relativePosition.norm( ) - referenceRadius ) / scaleHeight );
+        Eigen::Vector3d acceleration = -0.5 * ballisticCoefficient * density * airspeed * airspeedVelocity;
+
+        Eigen::Matrix< double, 3, 6 > statePartial;
+        statePartial.block( 0, 3, 3, 3 ) = -0.5 * ballisticCoefficient * density * (
+                    airspeed * Eigen::Matrix3d::Identity( ) + airspeedVelocity * airspeedVelocity.transpose( ) / airspeed );
+        statePartial.block( 0, 0, 3, 3 ) =
+                -acceleration * relativePosition.transpose( ) / ( scaleHeight * relativePosition.norm( ) ) -
+                statePartial.block( 0, 3, 3, 3 ) * linear_algebra::getCrossProductMatrix( earthRotationRate );
+        return statePartial;
+    } );
+    analyticalPartialFunctions.push_back( [ = ]( )
+    {
+        Eigen::Vector3d relativeVelocity = vehicle->getState( ).segment( 3, 3 ) - earth->getState( ).segment( 3, 3 );
+        double speed = relativeVelocity.norm( );
+        Eigen::Matrix< double, 3, 6 > statePartial = Eigen::Matrix< double, 3, 6 >::Zero( );
+        statePartial.block( 0, 3, 3, 3 ) = thrustAcceleration / speed * (
+                    Eigen::Matrix3d::Identity( ) - relativeVelocity * relativeVelocity.transpose( ) / ( speed * speed ) );
+        return statePartial;
+    } );
+
+    std::vector< double > tolerances = { 1.0E-14, 1.0E-13, 1.0E-14 };
+    for( unsigned int i = 0; i < customAccelerationSettings.size( ); i++ )
+    {
+        // Create custom acceleration and its partial
+        std::shared_ptr< AccelerationModel3d > customAcceleration = createAccelerationModel(
+                    vehicle, earth, customAccelerationSettings.at( i ), "Vehicle", "Earth" );
+        std::shared_ptr< AccelerationPartial > customAccelerationPartial = createAnalyticalAccelerationPartial(
+                    customAcceleration, std::make_pair( "Vehicle", vehicle ), std::make_pair( "Earth", earth ), bodies );
+        BOOST_CHECK( std::dynamic_pointer_cast< CustomAccelerationPartial >( customAccelerationPartial ) != nullptr );
+
+        // Compute partials using automatic differentiation, analytically and numerically
+        Eigen::Matrix< double, 3, 6 > automaticDifferentiationPartial =
+                getAcceleratedBodyStatePartial( customAccelerationPartial, testTime );
+        Eigen::Matrix< double, 3, 6 > analyticalPartial = analyticalPartialFunctions.at( i )( );
+        Eigen::Matrix< double, 3, 6 > numericalPartial =
+                getNumericalAcceleratedBodyStatePartial( customAcceleration, vehicle, vehicleState, testTime );
+
+        // Check value of acceleration
+        if( i == 0 )
+        {
+            BOOST_CHECK_SMALL( ( updateAndGetAcceleration< Eigen::Vector3d >( customAcceleration, testTime ) -
+                                 updateAndGetAcceleration< Eigen::Vector3d >( centralGravity, testTime ) ).norm( ),
+                               1.0E-15 * centralGravity->getAcceleration( ).norm( ) );
+        }
+
+        // Check partials w.r.t. state of accelerated body
+        double partialScale = analyticalPartial.cwiseAbs( ).maxCoeff( );
+        double automaticDifferentiationError = ( automaticDifferentiationPartial - analyticalPartial ).cwiseAbs( ).maxCoeff( );
+        double numericalError = ( numericalPartial - analyticalPartial ).cwiseAbs( ).maxCoeff( );
+        BOOST_CHECK_SMALL( automaticDifferentiationError, tolerances.at( i ) * partialScale );
+        BOOST_CHECK_SMALL( numericalError, 1.0E-5 * partialScale );
+
+        // Check partials w.r.t. state of body exerting acceleration
+        Eigen::MatrixXd exertingBodyPartial = Eigen::MatrixXd::Zero( 3, 6 );
+        customAccelerationPartial->wrtPositionOfAcceleratingBody( exertingBodyPartial.block( 0, 0, 3, 6 ), true, 0, 0 );
+        customAccelerationPartial->wrtVelocityOfAcceleratingBody( exertingBodyPartial.block( 0, 0, 3, 6 ), true, 0, 3 );
+        BOOST_CHECK_SMALL( ( exertingBodyPartial + automaticDifferentiationPartial ).cwiseAbs( ).maxCoeff( ),
+                           std::numeric_limits< double >::min( ) );
+    }
+
+    // Check that non-differentiable custom acceleration yields no partial, and that state-dependent acceleration requires
+    // different body exerting acceleration
+    std::shared_ptr< AccelerationModel3d > nonDifferentiableAcceleration = createAccelerationModel(
+                vehicle, earth, stateDependentCustomAccelerationSettings(
+                    [ = ]( const double, const Eigen::Vector6d& state ){
+        return computeTangentialThrust( state, thrustAcceleration ); } ), "Vehicle", "Earth" );
+    BOOST_CHECK( createAnalyticalAccelerationPartial(
+                     nonDifferentiableAcceleration, std::make_pair( "Vehicle", vehicle ),
+                     std::make_pair( "Earth", earth ), bodies ) == nullptr );
+    BOOST_CHECK_THROW( createAccelerationModel(
+                           vehicle, vehicle, customAccelerationSettings.at( 2 ), "Vehicle", "Vehicle" ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -16,6 +16,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <Eigen/Eigenvalues>
+
 #include "tudat/basics/testMacros.h"
 
 #include "tudat/simulation/estimation_setup/orbitDeterminationTestCases.h"
@@ -170,6 +172,149 @@ BOOST_AUTO_TEST_CASE( test_CovarianceAsFunctionOfTime )
     }
 }
 
+//! Test whether the estimation with accumulated normal equations (computing the observation partials per block of
+//! observation times) gives the same parameter corrections and covariance as the estimation from the full matrix of
+//! observation partials
+BOOST_AUTO_TEST_CASE( test_NormalEquationsAccumulationInEstimation )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    // Create bodies
+    std::vector< std::string > bodyNames = { "Earth", "Mars", "Sun", "Moon" };
+    double initialEphemerisTime = 1.0E7;
+    double finalEphemerisTime = 2.0E7;
+    double integrationStep = 900.0;
+    BodyListSettings bodySettings = getDefaultBodySettings(
+                bodyNames, initialEphemerisTime - 10.0 * integrationStep, finalEphemerisTime + 10.0 * integrationStep );
+    bodySettings.at( "Moon" )->ephemerisSettings->resetFrameOrigin( "Sun" );
+    SystemOfBodies bodies = createSystemOfBodies( bodySettings );
+
+    // Define accelerations and propagation settings for Earth
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Earth" ][ "Sun" ].push_back( std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+    accelerationMap[ "Earth" ][ "Moon" ].push_back( std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+    accelerationMap[ "Earth" ][ "Mars" ].push_back( std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+    std::map< std::string, std::string > centralBodyMap = { { "Earth", "SSB" } };
+    AccelerationMap accelerationModelMap = createAccelerationModelsMap( bodies, accelerationMap, centralBodyMap );
+
+    // Estimate initial state of Earth and gravitational parameter of Moon
+    std::vector< std::shared_ptr< EstimatableParameterSettings > > parameterNames;
+    parameterNames.push_back( std::make_shared< InitialTranslationalStateEstimatableParameterSettings< double > >(
+                                  "Earth", propagators::getInitialStateOfBody< double, double >(
+                                      "Earth", "SSB", bodies, initialEphemerisTime ), "SSB" ) );
+    parameterNames.push_back( std::make_shared< EstimatableParameterSettings >( "Moon", gravitational_parameter ) );
+    std::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > parametersToEstimate =
+            createParametersToEstimate< double >( parameterNames, bodies );
+
+    std::shared_ptr< IntegratorSettings< double > > integratorSettings =
+            std::make_shared< IntegratorSettings< double > >(
+                rungeKutta4, initialEphemerisTime - 4.0 * integrationStep, integrationStep );
+    std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+            std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                std::vector< std::string >{ "SSB" }, accelerationModelMap, std::vector< std::string >{ "Earth" },
+                getInitialStateVectorOfBodiesToEstimate( parametersToEstimate ),
+                finalEphemerisTime + 4.0 * integrationStep );
+
+    // Define one-way range observations from Earth to Mars
+    LinkEnds linkEnds;
+    linkEnds[ transmitter ] = std::make_pair( "Earth", "" );
+    linkEnds[ receiver ] = std::make_pair( "Mars", "" );
+    std::vector< std::shared_ptr< ObservationModelSettings > > observationSettingsList;
+    observationSettingsList.push_back( std::make_shared< ObservationModelSettings >( one_way_range, linkEnds ) );
+
+    OrbitDeterminationManager< double, double > orbitDeterminationManager(
+                bodies, parametersToEstimate, observationSettingsList, integratorSettings, propagatorSettings );
+
+    // Simulate observations
+    std::vector< double > observationTimes;
+    for( double observationTime = initialEphemerisTime + 1.0E5; observationTime < finalEphemerisTime - 1.0E5;
+         observationTime += 3000.0 )
+    {
+        observationTimes.push_back( observationTime );
+    }
+    std::vector< std::shared_ptr< ObservationSimulationSettings< double > > > measurementSimulationInput;
+    measurementSimulationInput.push_back(
+                std::make_shared< TabulatedObservationSimulationSettings< > >(
+                    one_way_range, linkEnds, observationTimes, transmitter ) );
+    std::shared_ptr< ObservationCollection< double, double > > simulatedObservations =
+            simulateObservations< double, double >(
+                measurementSimulationInput, orbitDeterminationManager.getObservationSimulators( ), bodies );
+
+    // Perturb parameters
+    Eigen::VectorXd truthParameters = parametersToEstimate->template getFullParameterValues< double >( );
+    Eigen::VectorXd initialParameterEstimate = truthParameters + getDefaultInitialParameterPerturbation( );
+
+    // Estimate parameters from full matrix of partials (index 0), and from normal equations accumulated in blocks of
+    // 1000 observation times, solved by SVD (index 1) and Cholesky decomposition (index 2)
+    std::vector< std::shared_ptr< PodOutput< double > > > podOutputs;
+    for( unsigned int i = 0; i < 3; i++ )
+    {
+        parametersToEstimate->resetParameterValues( initialParameterEstimate );
+
+        std::shared_ptr< PodInput< double, double > > podInput =
+                std::make_shared< PodInput< double, double > >(
+                    simulatedObservations, initialParameterEstimate.rows( ) );
+        podInput->defineEstimationSettings( true, true, false, false, true );
+        if( i > 0 )
+        {
+            podInput->defineNormalEquationsSettings(
+                        true, ( i == 1 ) ? linear_algebra::svd_normal_equations_solution :
+                                           linear_algebra::cholesky_normal_equations_solution, false, 1000 );
+        }
+
+        podOutputs.push_back( orbitDeterminationManager.estimateParameters(
+                                  podInput, std::make_shared< EstimationConvergenceChecker >( 3 ) ) );
+    }
+
+    Eigen::VectorXd formalErrors = podOutputs.at( 0 )->getFormalErrorVector( );
+    Eigen::MatrixXd covariance = podOutputs.at( 0 )->getUnnormalizedCovarianceMatrix( );
+    Eigen::MatrixXd inverseCovariance = podOutputs.at( 0 )->getUnnormalizedInverseCovarianceMatrix( );
+
+    // Round-off in the normal equations is amplified in the covariance by (at most) the condition number
+    Eigen::VectorXd normalizedEigenvalues = Eigen::SelfAdjointEigenSolver< Eigen::MatrixXd >(
+                podOutputs.at( 0 )->getNormalizedInverseCovarianceMatrix( ) ).eigenvalues( );
+    double conditionNumber = normalizedEigenvalues.maxCoeff( ) / normalizedEigenvalues.minCoeff( );
+    std::vector< Eigen::VectorXd > parameterHistory = podOutputs.at( 0 )->parameterHistory_;
+    BOOST_CHECK( parameterHistory.size( ) > 1 );
+    for( unsigned int i = 1; i < 3; i++ )
+    {
+        // Check parameter corrections in each iteration: first correction to within round-off, subsequent corrections
+        // (which are at the level of the formal errors) to well below the formal errors
+        std::vector< Eigen::VectorXd > currentParameterHistory = podOutputs.at( i )->parameterHistory_;
+        BOOST_CHECK_EQUAL( currentParameterHistory.size( ), parameterHistory.size( ) );
+        for( unsigned int j = 1; j < std::min( parameterHistory.size( ), currentParameterHistory.size( ) ); j++ )
+        {
+            Eigen::VectorXd parameterCorrection = parameterHistory.at( j ) - parameterHistory.at( j - 1 );
+            Eigen::VectorXd currentParameterCorrection = currentParameterHistory.at( j ) - currentParameterHistory.at( j - 1 );
+            for( int k = 0; k < parameterCorrection.rows( ); k++ )
+            {
+                BOOST_CHECK_SMALL( std::fabs( currentParameterCorrection( k ) - parameterCorrection( k ) ),
+                                   ( ( j == 1 ) ? 1.0E-8 * std::fabs( parameterCorrection( k ) ) : 0.0 ) +
+                                   1.0E-3 * formalErrors( k ) );
+            }
+        }
+
+        // Check final estimate, inverse covariance and covariance
+        Eigen::MatrixXd currentCovariance = podOutputs.at( i )->getUnnormalizedCovarianceMatrix( );
+        Eigen::MatrixXd currentInverseCovariance = podOutputs.at( i )->getUnnormalizedInverseCovarianceMatrix( );
+        for( int k = 0; k < covariance.rows( ); k++ )
+        {
+            BOOST_CHECK_SMALL( std::fabs( podOutputs.at( i )->parameterEstimate_( k ) - podOutputs.at( 0 )->parameterEstimate_( k ) ),
+                               1.0E-3 * formalErrors( k ) );
+            for( int l = 0; l < covariance.cols( ); l++ )
+            {
+                BOOST_CHECK_SMALL( std::fabs( currentInverseCovariance( k, l ) - inverseCovariance( k, l ) ),
+                                   1.0E-10 * std::sqrt( inverseCovariance( k, k ) * inverseCovariance( l, l ) ) );
+                BOOST_CHECK_SMALL( std::fabs( currentCovariance( k, l ) - covariance( k, l ) ),
+                                   1.0E-10 * conditionNumber * formalErrors( k ) * formalErrors( l ) );
+            }
+        }
+
+        // Check that the information matrix is not stored when accumulating normal equations
+        BOOST_CHECK_EQUAL( podOutputs.at( i )->normalizedInformationMatrix_.rows( ), 0 );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 }
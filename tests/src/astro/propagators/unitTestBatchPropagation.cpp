@@ -0,0 +1,305 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/testMacros.h"
+#include "tudat/astro/basic_astro/orbitalElementConversions.h"
+#include "tudat/astro/basic_astro/unitConversions.h"
+#include "tudat/astro/ephemerides/cachedEphemeris.h"
+#include "tudat/astro/ephemerides/keplerEphemeris.h"
+#include "tudat/simulation/environment_setup/createBodies.h"
+#include "tudat/simulation/propagation_setup/batchPropagation.h"
+#include "tudat/simulation/propagation_setup/createAccelerationModels.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace tudat::propagators;
+using namespace tudat::simulation_setup;
+using namespace tudat::numerical_integrators;
+using namespace tudat::orbital_element_conversions;
+
+BOOST_AUTO_TEST_SUITE( test_batch_propagation )
+
+//! Gravitational parameter of the Earth used in the tests
+const double earthGravitationalParameter = 3.986004418E14;
+
+//! Number of objects (first half propagated with fixed step size, second half with variable step size)
+const unsigned int numberOfObjects = 12;
+
+//! Function to create the (Spice-independent) environment for the batch propagation test
+SystemOfBodies createBatchTestBodies( )
+{
+    BodyListSettings bodySettings = BodyListSettings( "Earth", "ECLIPJ2000" );
+    bodySettings.addSettings( "Earth" );
+    bodySettings.at( "Earth" )->ephemerisSettings = std::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ), "Earth", "ECLIPJ2000" );
+    bodySettings.at( "Earth" )->gravityFieldSettings = std::make_shared< CentralGravityFieldSettings >(
+                earthGravitationalParameter );
+
+    bodySettings.addSettings( "Sun" );
+    bodySettings.at( "Sun" )->ephemerisSettings = std::make_shared< KeplerEphemerisSettings >(
+                ( Eigen::Vector6d( ) << 1.496E11, 0.0167, 0.4, 0.3, 0.2, 0.1 ).finished( ), 0.0, 1.32712440018E20,
+                "Earth", "ECLIPJ2000" );
+    bodySettings.at( "Sun" )->gravityFieldSettings = std::make_shared< CentralGravityFieldSettings >( 1.32712440018E20 );
+
+    bodySettings.addSettings( "Moon" );
+    bodySettings.at( "Moon" )->ephemerisSettings = std::make_shared< KeplerEphemerisSettings >(
+                ( Eigen::Vector6d( ) << 3.844E8, 0.055, 0.09, 1.0, 0.5, 2.0 ).finished( ), 0.0, earthGravitationalParameter,
+                "Earth", "ECLIPJ2000" );
+    bodySettings.at( "Moon" )->gravityFieldSettings = std::make_shared< CentralGravityFieldSettings >( 4.9048695E12 );
+
+    SystemOfBodies bodies = createSystemOfBodies( bodySettings );
+    bodies.createEmptyBody( "Object" );
+    return bodies;
+}
+
+//! Function to retrieve the settings for the propagation of a single object
+std::pair< std::shared_ptr< IntegratorSettings< > >, std::shared_ptr< SingleArcPropagatorSettings< double > > >
+getBatchTestSettings( const unsigned int objectIndex, const SystemOfBodies& bodies )
+{
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Object" ][ "Earth" ].push_back( pointMassGravityAcceleration( ) );
+    accelerationMap[ "Object" ][ "Moon" ].push_back( pointMassGravityAcceleration( ) );
+    accelerationMap[ "Object" ][ "Sun" ].push_back( pointMassGravityAcceleration( ) );
+    std::vector< std::string > bodiesToPropagate = { "Object" };
+    std::vector< std::string > centralBodies = { "Earth" };
+
+    Eigen::Vector6d initialKeplerianState;
+    initialKeplerianState << 7000.0E3 + 500.0E3 * objectIndex, 0.001 + 0.01 * objectIndex,
+            unit_conversions::convertDegreesToRadians( 10.0 + 7.0 * objectIndex ), 0.3 * objectIndex,
+            0.5 + 0.2 * objectIndex, 0.7 * objectIndex;
+    Eigen::VectorXd initialState = convertKeplerianToCartesianElements(
+                initialKeplerianState, earthGravitationalParameter );
+
+    std::shared_ptr< IntegratorSettings< > > integratorSettings;
+    if( objectIndex < numberOfObjects / 2 )
+    {
+        integratorSettings = std::make_shared< IntegratorSettings< > >( rungeKutta4, 0.0, 30.0 );
+    }
+    else
+    {
+        integratorSettings = std::make_shared< RungeKuttaVariableStepSizeSettings< > >(
+                    0.0, 30.0, RungeKuttaCoefficients::rungeKuttaFehlberg78, 1.0E-4, 3600.0, 1.0E-12, 1.0E-12 );
+    }
+
+    return std::make_pair(
+                integratorSettings,
+                std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                    centralBodies, createAccelerationModelsMap(
+                        bodies, accelerationMap, bodiesToPropagate, centralBodies ),
+                    bodiesToPropagate, initialState, 3.0 * 3600.0 ) );
+}
+
+//! Test whether the cached ephemeris reproduces the wrapped ephemeris, and retrieves states from its cache
+BOOST_AUTO_TEST_CASE( testCachedEphemeris )
+{
+    std::shared_ptr< ephemerides::Ephemeris > keplerEphemeris = std::make_shared< ephemerides::KeplerEphemeris >(
+                ( Eigen::Vector6d( ) << 3.844E8, 0.055, 0.09, 1.0, 0.5, 2.0 ).finished( ), 0.0,
+                earthGravitationalParameter, "Earth", "J2000" );
+    std::shared_ptr< ephemerides::CachedEphemeris > cachedEphemeris =
+            std::make_shared< ephemerides::CachedEphemeris >( keplerEphemeris, 5 );
+
+    BOOST_CHECK_EQUAL( cachedEphemeris->getReferenceFrameOrigin( ), "Earth" );
+    BOOST_CHECK_EQUAL( cachedEphemeris->getReferenceFrameOrientation( ), "J2000" );
+
+    // Evaluate at 4 distinct times, twice
+    for( int i = 0; i < 2; i++ )
+    {
+        for( int j = 0; j < 4; j++ )
+        {
+            double currentTime = 1000.0 * j;
+            Eigen::Vector6d cachedState = cachedEphemeris->getCartesianState( currentTime );
+            Eigen::Vector6d expectedState = keplerEphemeris->getCartesianState( currentTime );
+            for( int k = 0; k < 6; k++ )
+            {
+                BOOST_CHECK_EQUAL( cachedState( k ), expectedState( k ) );
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL( cachedEphemeris->getNumberOfCacheMisses( ), 4 );
+    BOOST_CHECK_EQUAL( cachedEphemeris->getNumberOfCacheHits( ), 4 );
+    BOOST_CHECK_EQUAL( cachedEphemeris->getCurrentCacheSize( ), 4 );
+
+    // Check that cache is cleared when full
+    cachedEphemeris->getCartesianState( 5000.0 );
+    BOOST_CHECK_EQUAL( cachedEphemeris->getCurrentCacheSize( ), 5 );
+    cachedEphemeris->getCartesianState( 6000.0 );
+    BOOST_CHECK_EQUAL( cachedEphemeris->getCurrentCacheSize( ), 1 );
+    cachedEphemeris->getCartesianState( 0.0 );
+    BOOST_CHECK_EQUAL( cachedEphemeris->getNumberOfCacheMisses( ), 7 );
+
+    cachedEphemeris->clearCache( );
+    cachedEphemeris->resetCacheStatistics( );
+    BOOST_CHECK_EQUAL( cachedEphemeris->getCurrentCacheSize( ), 0 );
+    BOOST_CHECK_EQUAL( cachedEphemeris->getNumberOfCacheMisses( ), 0 );
+    BOOST_CHECK_EQUAL( cachedEphemeris->getNumberOfCacheHits( ), 0 );
+
+    // Create cached ephemeris that interpolates states from a grid with 600 s spacing
+    std::shared_ptr< ephemerides::CachedEphemeris > gridEphemeris =
+            std::make_shared< ephemerides::CachedEphemeris >( keplerEphemeris, 100000, 600.0, 8 );
+    BOOST_CHECK_EQUAL( gridEphemeris->getGridSpacing( ), 600.0 );
+
+    // Check that states at grid epochs are not interpolated
+    for( int i = -2; i < 3; i++ )
+    {
+        Eigen::Vector6d cachedState = gridEphemeris->getCartesianState( 600.0 * i );
+        Eigen::Vector6d expectedState = keplerEphemeris->getCartesianState( 600.0 * i );
+        for( int k = 0; k < 6; k++ )
+        {
+            BOOST_CHECK_EQUAL( cachedState( k ), expectedState( k ) );
+        }
+    }
+    BOOST_CHECK_EQUAL( gridEphemeris->getNumberOfCacheMisses( ), 5 );
+    BOOST_CHECK_EQUAL( gridEphemeris->getNumberOfCacheHits( ), 0 );
+
+    // Check interpolated states at arbitrary epochs (grid epochs -3 to 4 required for first epoch)
+    for( double currentTime = 1.0; currentTime < 6000.0; currentTime += 37.3 )
+    {
+        Eigen::Vector6d cachedState = gridEphemeris->getCartesianState( currentTime );
+        Eigen::Vector6d expectedState = keplerEphemeris->getCartesianState( currentTime );
+        for( int k = 0; k < 3; k++ )
+        {
+            BOOST_CHECK_SMALL( cachedState( k ) - expectedState( k ), 1.0E-5 );
+            BOOST_CHECK_SMALL( cachedState( k + 3 ) - expectedState( k + 3 ), 1.0E-10 );
+        }
+        if( currentTime == 1.0 )
+        {
+            BOOST_CHECK_EQUAL( gridEphemeris->getNumberOfCacheMisses( ), 8 );
+            BOOST_CHECK_EQUAL( gridEphemeris->getCurrentCacheSize( ), 8 );
+        }
+    }
+
+    // Check that the wrapped ephemeris is evaluated only once per grid epoch (-3 to 13), so that only the first
+    // of the 161 interpolated states, and those requiring grid epochs 5 to 13, are not fully retrieved from the cache
+    BOOST_CHECK_EQUAL( gridEphemeris->getNumberOfCacheMisses( ), 17 );
+    BOOST_CHECK_EQUAL( gridEphemeris->getCurrentCacheSize( ), 17 );
+    BOOST_CHECK_EQUAL( gridEphemeris->getNumberOfCacheHits( ), 161 - 10 );
+
+    BOOST_CHECK_THROW( ephemerides::CachedEphemeris( keplerEphemeris, 100000, -600.0 ), std::runtime_error );
+    BOOST_CHECK_THROW( ephemerides::CachedEphemeris( keplerEphemeris, 4, 600.0, 8 ), std::runtime_error );
+}
+
+//! Test whether batch propagation reproduces propagations in a new environment per object
+BOOST_AUTO_TEST_CASE( testBatchPropagation )
+{
+    // Propagate each object in a new environment
+    std::vector< Eigen::VectorXd > expectedResults;
+    for( unsigned int i = 0; i < numberOfObjects; i++ )
+    {
+        SystemOfBodies bodies = createBatchTestBodies( );
+        auto objectSettings = getBatchTestSettings( i, bodies );
+        SingleArcDynamicsSimulator< > dynamicsSimulator( bodies, objectSettings.first, objectSettings.second );
+        expectedResults.push_back( getFinalPropagatedState( dynamicsSimulator ) );
+    }
+
+    // Propagate objects in batch, for various numbers of threads and block sizes
+    std::vector< std::string > sharedEphemerisBodies = { "Sun", "Moon" };
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 4; numberOfThreads += 3 )
+    {
+        for( unsigned int blockSize : { 1, 5, 64 } )
+        {
+            std::vector< Eigen::VectorXd > results = propagateSingleArcBatch< double, double >(
+                        numberOfObjects, &createBatchTestBodies, &getBatchTestSettings, sharedEphemerisBodies,
+                        TUDAT_NAN, numberOfThreads, blockSize );
+
+            BOOST_CHECK_EQUAL( results.size( ), numberOfObjects );
+            for( unsigned int i = 0; i < numberOfObjects; i++ )
+            {
+                for( int j = 0; j < 6; j++ )
+                {
+                    BOOST_CHECK_EQUAL( results.at( i )( j ), expectedResults.at( i )( j ) );
+                }
+            }
+        }
+    }
+
+    // Propagate all objects in a single block, with states of shared ephemerides cached at exact epochs and on a
+    // grid with 60 s spacing, and retrieve number of Moon ephemeris evaluations after each object
+    std::vector< std::vector< unsigned long > > numberOfCacheMisses;
+    std::vector< std::vector< unsigned long > > numberOfCacheHits;
+    std::vector< std::vector< Eigen::VectorXd > > singleBlockResults;
+    for( double gridSpacing : { TUDAT_NAN, 60.0 } )
+    {
+        numberOfCacheMisses.push_back( std::vector< unsigned long >( ) );
+        numberOfCacheHits.push_back( std::vector< unsigned long >( ) );
+        singleBlockResults.push_back(
+                    propagateSingleArcBatch< double, double >(
+                        numberOfObjects, &createBatchTestBodies, &getBatchTestSettings, sharedEphemerisBodies,
+                        gridSpacing, 1, numberOfObjects,
+                        [ & ]( const unsigned int, SingleArcDynamicsSimulator< >& dynamicsSimulator )
+        {
+            std::shared_ptr< ephemerides::CachedEphemeris > moonEphemeris =
+                    std::dynamic_pointer_cast< ephemerides::CachedEphemeris >(
+                        dynamicsSimulator.getSystemOfBodies( ).at( "Moon" )->getEphemeris( ) );
+            numberOfCacheMisses.back( ).push_back( moonEphemeris->getNumberOfCacheMisses( ) );
+            numberOfCacheHits.back( ).push_back( moonEphemeris->getNumberOfCacheHits( ) );
+            return getFinalPropagatedState( dynamicsSimulator );
+        } ) );
+    }
+
+    // Check that, at exact epochs, the Moon ephemeris is evaluated only for the first of the fixed step size objects
+    BOOST_CHECK( numberOfCacheMisses.at( 0 ).at( 0 ) > 0 );
+    for( unsigned int i = 1; i < numberOfObjects / 2; i++ )
+    {
+        BOOST_CHECK_EQUAL( numberOfCacheMisses.at( 0 ).at( i ), numberOfCacheMisses.at( 0 ).at( 0 ) );
+        BOOST_CHECK( numberOfCacheHits.at( 0 ).at( i ) > numberOfCacheHits.at( 0 ).at( i - 1 ) );
+    }
+
+    for( unsigned int i = 0; i < numberOfObjects; i++ )
+    {
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( singleBlockResults.at( 0 ).at( i ), expectedResults.at( i ), 0.0 );
+    }
+
+    // Check that, on the grid, the Moon ephemeris is evaluated at most once per grid epoch (propagation of 3 hours,
+    // plus at most one step of 1 hour beyond the final time, with 8 interpolation nodes), so that the variable step
+    // size objects require (almost) no new evaluations, and the number of evaluations is reduced by at least an order
+    // of magnitude w.r.t. exact epochs
+    unsigned long exactEpochVariableStepMisses =
+            numberOfCacheMisses.at( 0 ).back( ) - numberOfCacheMisses.at( 0 ).at( numberOfObjects / 2 - 1 );
+    unsigned long gridVariableStepMisses =
+            numberOfCacheMisses.at( 1 ).back( ) - numberOfCacheMisses.at( 1 ).at( numberOfObjects / 2 - 1 );
+    BOOST_CHECK( numberOfCacheMisses.at( 1 ).back( ) <= 4 * 60 + 8 );
+    BOOST_CHECK( 10 * numberOfCacheMisses.at( 1 ).back( ) < numberOfCacheMisses.at( 0 ).back( ) );
+    BOOST_CHECK( 10 * ( gridVariableStepMisses + 1 ) < exactEpochVariableStepMisses );
+
+    // Check that the interpolation error is negligible w.r.t. the integration error
+    for( unsigned int i = 0; i < numberOfObjects; i++ )
+    {
+        for( int j = 0; j < 3; j++ )
+        {
+            BOOST_CHECK_SMALL( singleBlockResults.at( 1 ).at( i )( j ) - expectedResults.at( i )( j ), 1.0E-6 );
+            BOOST_CHECK_SMALL( singleBlockResults.at( 1 ).at( i )( j + 3 ) - expectedResults.at( i )( j + 3 ), 1.0E-9 );
+        }
+    }
+
+    // Check that an empty batch is propagated without error
+    BOOST_CHECK_EQUAL( ( propagateSingleArcBatch< double, double >(
+                             0, &createBatchTestBodies, &getBatchTestSettings, sharedEphemerisBodies ).size( ) ), 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
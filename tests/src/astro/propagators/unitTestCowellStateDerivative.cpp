@@ -11,11 +11,13 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 
+#include <limits>
 #include <string>
 
 #include <boost/make_shared.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include "tudat/basics/testMacros.h"
 #include "tudat/math/basic/linearAlgebra.h"
 #include "tudat/astro/basic_astro/physicalConstants.h"
 #include "tudat/astro/basic_astro/orbitalElementConversions.h"
@@ -447,6 +449,38 @@ void testCowellPropagationOfKeplerOrbit( )
         SingleArcDynamicsSimulator< StateScalarType, TimeType > dynamicsSimulator(
                     bodies, integratorSettings, propagatorSettings, true, false, true );
 
+        // Repeat propagation with fixed-size state types in the integrator, and check that results are unchanged
+        propagatorSettings->setUseFixedSizeStatePropagation( true );
+        SingleArcDynamicsSimulator< StateScalarType, TimeType > fixedSizeDynamicsSimulator(
+                    bodies, integratorSettings, propagatorSettings, true, false, false );
+        propagatorSettings->setUseFixedSizeStatePropagation( false );
+
+        std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > stateHistory =
+                dynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+        std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > fixedSizeStateHistory =
+                fixedSizeDynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+        BOOST_CHECK_EQUAL( stateHistory.size( ), fixedSizeStateHistory.size( ) );
+        for( auto stateIterator : stateHistory )
+        {
+            BOOST_CHECK_EQUAL( fixedSizeStateHistory.count( stateIterator.first ), 1 );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                        stateIterator.second, fixedSizeStateHistory.at( stateIterator.first ),
+                        ( 10.0 * std::numeric_limits< StateScalarType >::epsilon( ) ) );
+        }
+
+        // Check that cumulative number of function evaluations is saved once per step, and identical for both runs
+        std::map< TimeType, unsigned int > functionEvaluations =
+                dynamicsSimulator.getCumulativeNumberOfFunctionEvaluations( );
+        BOOST_CHECK_EQUAL( functionEvaluations.size( ), stateHistory.size( ) );
+        for( auto evaluationIterator = std::next( functionEvaluations.begin( ) );
+             evaluationIterator != functionEvaluations.end( ); evaluationIterator++ )
+        {
+            BOOST_CHECK( evaluationIterator->second > std::prev( evaluationIterator )->second );
+        }
+        BOOST_CHECK_EQUAL( functionEvaluations.rbegin( )->second,
+                           dynamicsSimulator.getDynamicsStateDerivative( )->getNumberOfFunctionEvaluations( ) );
+        BOOST_CHECK( functionEvaluations == fixedSizeDynamicsSimulator.getCumulativeNumberOfFunctionEvaluations( ) );
+
         Eigen::Matrix< StateScalarType, 6, 1  > initialKeplerElements =
             orbital_element_conversions::convertCartesianToKeplerianElements< StateScalarType >(
                 Eigen::Matrix< StateScalarType, 6, 1  >( systemInitialState ), effectiveGravitationalParameter );
@@ -0,0 +1,192 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <memory>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/testMacros.h"
+#include "tudat/astro/propagators/integrateEquations.h"
+#include "tudat/math/integrators/rungeKuttaVariableStepSizeIntegrator.h"
+#include "tudat/simulation/propagation_setup/propagationTermination.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+
+BOOST_AUTO_TEST_SUITE( test_dense_output_propagation )
+
+//! Function to compute the state derivative of a harmonic oscillator (x'' = -x), counting the number of evaluations
+Eigen::VectorXd computeOscillatorStateDerivative( const double time, const Eigen::VectorXd& state, int& numberOfEvaluations )
+{
+    numberOfEvaluations++;
+    return ( Eigen::VectorXd( 2 ) << state( 1 ), -state( 0 ) ).finished( );
+}
+
+//! Function to post-process the state of the harmonic oscillator, reversing the state if the position is negative (as an
+//! analogue of the switching of attitude representations, where the state is replaced by an equivalent one).
+void postProcessOscillatorState( Eigen::VectorXd& state )
+{
+    if( state( 0 ) < 0.0 )
+    {
+        state = -state;
+    }
+}
+
+//! Function to propagate a harmonic oscillator, using the dense output or a limited maximum step size to obtain the results
+//! at a fixed interval.
+std::map< double, Eigen::VectorXd > propagateOscillator(
+        const double propagationDirection, const bool terminateExactly, const bool useDenseOutput,
+        const double outputInterval, int& numberOfEvaluations,
+        std::map< double, Eigen::VectorXd >& dependentVariableHistory,
+        const bool postProcessState = false )
+{
+    double initialTime = 0.3 * propagationDirection;
+    Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << std::cos( initialTime ), -std::sin( initialTime ) ).finished( );
+
+    numberOfEvaluations = 0;
+    std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd, double > > integrator =
+            std::make_shared< RungeKuttaVariableStepSizeIntegrator< double, Eigen::VectorXd, Eigen::VectorXd, double > >(
+                RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg78 ),
+                std::bind( &computeOscillatorStateDerivative, std::placeholders::_1, std::placeholders::_2,
+                           std::ref( numberOfEvaluations ) ),
+                initialTime, initialState, 1.0E-6, useDenseOutput ? 100.0 : outputInterval,
+                Eigen::VectorXd::Constant( 2, 1.0E-12 ), Eigen::VectorXd::Constant( 2, 1.0E-12 ) );
+
+    std::shared_ptr< PropagationTerminationCondition > terminationCondition =
+            std::make_shared< FixedTimePropagationTerminationCondition >(
+                20.05 * propagationDirection, propagationDirection > 0.0, terminateExactly );
+
+    std::map< double, Eigen::VectorXd > stateHistory;
+    std::map< double, double > computationTimeHistory;
+    integrateEquationsFromIntegrator< Eigen::VectorXd, double, double >(
+                integrator, 0.1 * propagationDirection, terminationCondition, stateHistory, dependentVariableHistory,
+                computationTimeHistory, [ = ]( ){ return Eigen::VectorXd::Zero( 1 ); },
+                postProcessState ? &postProcessOscillatorState : std::function< void( Eigen::VectorXd& ) >( ), 1, TUDAT_NAN,
+                std::chrono::steady_clock::now( ), useDenseOutput ? outputInterval : TUDAT_NAN );
+    return stateHistory;
+}
+
+//! Function to compute the error of a propagated state of the harmonic oscillator w.r.t. the analytical solution
+double getOscillatorStateError( const double time, const Eigen::VectorXd& state, const bool postProcessState )
+{
+    Eigen::VectorXd analyticalState = ( Eigen::VectorXd( 2 ) << std::cos( time ), -std::sin( time ) ).finished( );
+    if( postProcessState )
+    {
+        postProcessOscillatorState( analyticalState );
+    }
+    return ( state - analyticalState ).cwiseAbs( ).maxCoeff( );
+}
+
+//! Test propagation with results saved at fixed interval using dense output of integrator
+BOOST_AUTO_TEST_CASE( testDenseOutputPropagation )
+{
+    double outputInterval = 0.5;
+    for( int direction = 0; direction < 2; direction++ )
+    {
+        double propagationDirection = ( direction == 0 ) ? 1.0 : -1.0;
+        for( int exactTermination = 0; exactTermination < 2; exactTermination++ )
+        {
+            for( int postProcessState = 0; postProcessState < 2; postProcessState++ )
+            {
+                int numberOfEvaluations = 0;
+                std::map< double, Eigen::VectorXd > dependentVariableHistory;
+                std::map< double, Eigen::VectorXd > stateHistory = propagateOscillator(
+                            propagationDirection, exactTermination, true, outputInterval, numberOfEvaluations,
+                            dependentVariableHistory, postProcessState );
+
+                // Check that initial time, and all multiples of the output interval up to final time, are saved
+                BOOST_CHECK_EQUAL( stateHistory.size( ), 42 );
+                BOOST_CHECK_EQUAL( dependentVariableHistory.size( ), stateHistory.size( ) );
+                double initialTime = ( direction == 0 ) ? stateHistory.begin( )->first : stateHistory.rbegin( )->first;
+                double finalTime = ( direction == 0 ) ? stateHistory.rbegin( )->first : stateHistory.begin( )->first;
+                BOOST_CHECK_EQUAL( initialTime, 0.3 * propagationDirection );
+                if( exactTermination )
+                {
+                    BOOST_CHECK_CLOSE_FRACTION( finalTime, 20.05 * propagationDirection, 1.0E-12 );
+                }
+                else
+                {
+                    BOOST_CHECK( propagationDirection * ( finalTime - 20.05 * propagationDirection ) >= 0.0 );
+                }
+
+                // Retrieve maximum error of the states at the integration steps (without dense output or step size
+                // restriction), which is the same for the dense output results, up to the integrator tolerance
+                std::map< double, Eigen::VectorXd > integrationStepStateHistory = propagateOscillator(
+                            propagationDirection, exactTermination, false, 100.0, numberOfEvaluations,
+                            dependentVariableHistory, postProcessState );
+                double maximumIntegrationStepError = 0.0;
+                for( auto stateIterator : integrationStepStateHistory )
+                {
+                    maximumIntegrationStepError = std::max(
+                                maximumIntegrationStepError,
+                                getOscillatorStateError( stateIterator.first, stateIterator.second, postProcessState ) );
+                }
+
+                for( auto stateIterator : stateHistory )
+                {
+                    double currentTime = stateIterator.first;
+                    if( currentTime != initialTime && currentTime != finalTime )
+                    {
+                        BOOST_CHECK_SMALL( std::remainder( currentTime, outputInterval ), 1.0E-14 );
+                    }
+                    BOOST_CHECK_SMALL( getOscillatorStateError( currentTime, stateIterator.second, postProcessState ),
+                                       maximumIntegrationStepError + 2.0E-12 );
+                    if( postProcessState )
+                    {
+                        BOOST_CHECK( stateIterator.second( 0 ) >= 0.0 );
+                    }
+                }
+            }
+
+            // Check that dense output requires fewer function evaluations than restricting the step size, for an
+            // output interval that is small w.r.t. the step size of the integrator
+            double shortOutputInterval = 0.02;
+            int numberOfDenseOutputEvaluations = 0;
+            std::map< double, Eigen::VectorXd > dependentVariableHistory;
+            std::map< double, Eigen::VectorXd > stateHistory = propagateOscillator(
+                        propagationDirection, exactTermination, true, shortOutputInterval, numberOfDenseOutputEvaluations,
+                        dependentVariableHistory );
+            int numberOfRestrictedStepEvaluations = 0;
+            std::map< double, Eigen::VectorXd > restrictedStepStateHistory = propagateOscillator(
+                        propagationDirection, exactTermination, false, shortOutputInterval,
+                        numberOfRestrictedStepEvaluations, dependentVariableHistory );
+            BOOST_CHECK( numberOfDenseOutputEvaluations < numberOfRestrictedStepEvaluations );
+            if( exactTermination )
+            {
+                Eigen::VectorXd finalState = ( direction == 0 ) ?
+                            stateHistory.rbegin( )->second : stateHistory.begin( )->second;
+                Eigen::VectorXd restrictedStepFinalState = ( direction == 0 ) ?
+                            restrictedStepStateHistory.rbegin( )->second : restrictedStepStateHistory.begin( )->second;
+                TUDAT_CHECK_MATRIX_CLOSE_FRACTION( finalState, restrictedStepFinalState, 1.0E-10 );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
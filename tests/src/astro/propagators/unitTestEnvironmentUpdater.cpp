@@ -188,6 +188,20 @@ BOOST_AUTO_TEST_CASE( test_centralGravityEnvironmentUpdate )
                         bodies.at( "Moon" )->getState( ),
                         bodies.at( "Moon" )->getEphemeris( )->getCartesianState( 0.5 * testTime ),
                         std::numeric_limits< double >::epsilon( ) );
+
+            // Check that ephemeris state is not recomputed when updating repeatedly at the same time, unless update times
+            // are reset.
+            updater->updateEnvironment( testTime, integratedStateToSet );
+            bodies.at( "Earth" )->setState( Eigen::Vector6d::Zero( ) );
+            updater->updateEnvironment( testTime, integratedStateToSet );
+            BOOST_CHECK_EQUAL( bodies.at( "Earth" )->getState( ).norm( ), 0.0 );
+
+            updater->resetUpdateTimes( );
+            updater->updateEnvironment( testTime, integratedStateToSet );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                        bodies.at( "Earth" )->getState( ),
+                        bodies.at( "Earth" )->getEphemeris( )->getCartesianState( testTime ),
+                        std::numeric_limits< double >::epsilon( ) );
         }
 
         // Test third body acceleration updates.
@@ -32,6 +32,8 @@
 #include "tudat/simulation/environment_setup/createBodies.h"
 #include "tudat/simulation/estimation_setup/createNumericalSimulator.h"
 #include "tudat/math/integrators/createNumericalIntegrator.h"
+#include "tudat/math/interpolators/lagrangeInterpolator.h"
+#include "tudat/math/interpolators/stridedLagrangeInterpolator.h"
 
 
 namespace tudat
@@ -248,6 +250,90 @@ BOOST_AUTO_TEST_CASE( testEnckePopagatorForSphericalHarmonicCentralBodies )
                 std::map< double, Eigen::VectorXd > stateHistory = dynamicsSimulator.getEquationsOfMotionNumericalSolution( );
                 std::map< double, Eigen::VectorXd > dependentVariableHistory = dynamicsSimulator.getDependentVariableHistory( );
 
+                // Repeat propagation with columnar history storage, and check that results are identical
+                propagatorSettings->setUseColumnarHistoryStorage( true );
+                SingleArcDynamicsSimulator< double > columnarDynamicsSimulator(
+                            bodies, integratorSettings, propagatorSettings, true, false, false );
+                propagatorSettings->setUseColumnarHistoryStorage( false );
+
+                const utilities::ColumnarHistory< double, double >& columnarStateHistory =
+                        columnarDynamicsSimulator.getEquationsOfMotionColumnarSolution( );
+                BOOST_CHECK_EQUAL( columnarStateHistory.size( ), stateHistory.size( ) );
+                BOOST_CHECK_EQUAL( columnarDynamicsSimulator.getDependentVariableColumnarHistory( ).size( ),
+                                   dependentVariableHistory.size( ) );
+                BOOST_CHECK_EQUAL( columnarStateHistory.getNumberOfRows( ), 6 );
+                for( unsigned int i = 0; i < columnarStateHistory.size( ); i++ )
+                {
+                    BOOST_CHECK_EQUAL( stateHistory.count( columnarStateHistory.getTime( i ) ), 1 );
+                }
+
+                std::map< double, Eigen::VectorXd > columnarStateHistoryMap =
+                        columnarDynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+                std::map< double, Eigen::VectorXd > columnarDependentVariableHistoryMap =
+                        columnarDynamicsSimulator.getDependentVariableHistory( );
+                BOOST_CHECK_EQUAL( columnarStateHistoryMap.size( ), stateHistory.size( ) );
+                BOOST_CHECK_EQUAL( columnarDependentVariableHistoryMap.size( ), dependentVariableHistory.size( ) );
+                for( auto stateIterator : stateHistory )
+                {
+                    for( int j = 0; j < 6; j++ )
+                    {
+                        BOOST_CHECK_EQUAL( columnarStateHistoryMap.at( stateIterator.first )( j ),
+                                           stateIterator.second( j ) );
+                    }
+                    BOOST_CHECK_EQUAL( columnarDependentVariableHistoryMap.at( stateIterator.first )( 0 ),
+                                       dependentVariableHistory.at( stateIterator.first )( 0 ) );
+                }
+
+                // Repeat propagation with columnar history storage, setting the result in the environment, and check that the
+                // ephemeris reads the columnar history directly
+                if( simulationCase == 0 )
+                {
+                    bodies.at( "Vehicle" )->setEphemeris( std::make_shared< ephemerides::TabulatedCartesianEphemeris< > >(
+                                std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > >( ),
+                                "Earth", "ECLIPJ2000" ) );
+                    propagatorSettings->setUseColumnarHistoryStorage( true );
+                    SingleArcDynamicsSimulator< double > settingDynamicsSimulator(
+                                bodies, integratorSettings, propagatorSettings, true, false, true );
+                    propagatorSettings->setUseColumnarHistoryStorage( false );
+
+                    std::shared_ptr< ephemerides::TabulatedCartesianEphemeris< > > vehicleEphemeris =
+                            std::dynamic_pointer_cast< ephemerides::TabulatedCartesianEphemeris< > >(
+                                bodies.at( "Vehicle" )->getEphemeris( ) );
+                    typedef interpolators::StridedLagrangeInterpolator< double, double, 6 > StridedInterpolator;
+                    BOOST_CHECK( std::dynamic_pointer_cast< StridedInterpolator >( vehicleEphemeris->getInterpolator( ) ) != nullptr );
+                    BOOST_CHECK_EQUAL( vehicleEphemeris->getInterpolator( )->getDependentValues( ).size( ), 0 );
+                    BOOST_CHECK_EQUAL( settingDynamicsSimulator.getEquationsOfMotionColumnarSolution( ).size( ),
+                                       stateHistory.size( ) );
+
+                    // Compare ephemeris at data points and between (interior) data points to Lagrange interpolator
+                    std::map< double, Eigen::Vector6d > vehicleStateHistory;
+                    for( auto stateIterator : stateHistory )
+                    {
+                        vehicleStateHistory[ stateIterator.first ] = stateIterator.second;
+                    }
+                    interpolators::LagrangeInterpolator< double, Eigen::Vector6d > referenceInterpolator(
+                                vehicleStateHistory, 6 );
+                    int dataPointIndex = 0;
+                    for( auto stateIterator = vehicleStateHistory.begin( ); stateIterator != vehicleStateHistory.end( );
+                         stateIterator++, dataPointIndex++ )
+                    {
+                        Eigen::Vector6d ephemerisState = vehicleEphemeris->getCartesianState( stateIterator->first );
+                        for( int j = 0; j < 6; j++ )
+                        {
+                            BOOST_CHECK_EQUAL( ephemerisState( j ), stateIterator->second( j ) );
+                        }
+
+                        if( dataPointIndex > 3 && dataPointIndex < static_cast< int >( vehicleStateHistory.size( ) ) - 4 )
+                        {
+                            double testTime = ( stateIterator->first + std::next( stateIterator )->first ) / 2.0;
+                            Eigen::Vector6d stateDifference =
+                                    vehicleEphemeris->getCartesianState( testTime ) - referenceInterpolator.interpolate( testTime );
+                            BOOST_CHECK_SMALL( stateDifference.segment( 0, 3 ).norm( ), 1.0E-6 );
+                            BOOST_CHECK_SMALL( stateDifference.segment( 3, 3 ).norm( ), 1.0E-9 );
+                        }
+                    }
+                }
+
                 // Sanity check: altitude limit not violated on first step
                 BOOST_CHECK_EQUAL( ( vehicleInitialState.segment( 0, 3 ).norm( ) - 8.7E6 ) < 100.0, true );
 
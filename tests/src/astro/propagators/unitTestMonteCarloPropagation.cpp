@@ -0,0 +1,180 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/testMacros.h"
+#include "tudat/astro/basic_astro/orbitalElementConversions.h"
+#include "tudat/astro/basic_astro/unitConversions.h"
+#include "tudat/math/statistics/randomSampling.h"
+#include "tudat/simulation/environment_setup/createBodies.h"
+#include "tudat/simulation/propagation_setup/createAccelerationModels.h"
+#include "tudat/simulation/propagation_setup/monteCarloPropagation.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace tudat::propagators;
+using namespace tudat::simulation_setup;
+using namespace tudat::numerical_integrators;
+using namespace tudat::orbital_element_conversions;
+
+BOOST_AUTO_TEST_SUITE( test_monte_carlo_propagation )
+
+//! Function to create the (Spice-independent) environment for the Monte Carlo propagation test
+SystemOfBodies createMonteCarloTestBodies( )
+{
+    BodyListSettings bodySettings = BodyListSettings( "Earth", "ECLIPJ2000" );
+    bodySettings.addSettings( "Earth" );
+    bodySettings.at( "Earth" )->ephemerisSettings = std::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ), "Earth", "ECLIPJ2000" );
+    bodySettings.at( "Earth" )->gravityFieldSettings = std::make_shared< CentralGravityFieldSettings >( 3.986004418E14 );
+    bodySettings.at( "Earth" )->atmosphereSettings = std::make_shared< ExponentialAtmosphereSettings >(
+                aerodynamics::earth );
+    bodySettings.at( "Earth" )->shapeModelSettings = std::make_shared< SphericalBodyShapeSettings >( 6378.0E3 );
+    bodySettings.at( "Earth" )->rotationModelSettings = std::make_shared< SimpleRotationModelSettings >(
+                "ECLIPJ2000", "IAU_Earth", Eigen::Quaterniond::Identity( ), 0.0, 7.2921E-5 );
+
+    SystemOfBodies bodies = createSystemOfBodies( bodySettings );
+    bodies.createEmptyBody( "Vehicle" );
+    bodies.at( "Vehicle" )->setConstantBodyMass( 400.0 );
+    return bodies;
+}
+
+//! Function to set the dispersed drag coefficient (sample entry 0) and initial position (sample entries 1-3) of the vehicle
+std::pair< std::shared_ptr< IntegratorSettings< > >, std::shared_ptr< SingleArcPropagatorSettings< double > > >
+getMonteCarloTestSettings( const Eigen::VectorXd& sample, const SystemOfBodies& bodies )
+{
+    // Reset flight conditions, which are linked to the aerodynamic coefficients of the previous sample
+    bodies.at( "Vehicle" )->setFlightConditions( nullptr );
+    bodies.at( "Vehicle" )->setAerodynamicCoefficientInterface(
+                createAerodynamicCoefficientInterface(
+                    std::make_shared< ConstantAerodynamicCoefficientSettings >(
+                        4.0, sample( 0 ) * Eigen::Vector3d::UnitX( ), true, true ), "Vehicle" ) );
+
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back(
+                std::make_shared< AccelerationSettings >( basic_astrodynamics::point_mass_gravity ) );
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back(
+                std::make_shared< AccelerationSettings >( basic_astrodynamics::aerodynamic ) );
+    std::vector< std::string > bodiesToPropagate = { "Vehicle" };
+    std::vector< std::string > centralBodies = { "Earth" };
+
+    Eigen::Vector6d initialKeplerianState;
+    initialKeplerianState << 6378.0E3 + 250.0E3, 0.001, unit_conversions::convertDegreesToRadians( 51.6 ),
+            0.0, 0.0, 0.0;
+    Eigen::VectorXd initialState = convertKeplerianToCartesianElements( initialKeplerianState, 3.986004418E14 );
+    initialState.segment( 0, 3 ) += sample.segment( 1, 3 );
+
+    return std::make_pair(
+                std::make_shared< IntegratorSettings< > >( rungeKutta4, 0.0, 10.0 ),
+                std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                    centralBodies, createAccelerationModelsMap(
+                        bodies, accelerationMap, bodiesToPropagate, centralBodies ),
+                    bodiesToPropagate, initialState, 3600.0 ) );
+}
+
+// Test whether Monte Carlo propagation with per-thread environments reproduces propagations in a new environment per sample
+BOOST_AUTO_TEST_CASE( testMonteCarloPropagation )
+{
+    // Generate samples of drag coefficient and initial position offset
+    Eigen::VectorXd lowerBound = ( Eigen::VectorXd( 4 ) << 1.5, -100.0, -100.0, -100.0 ).finished( );
+    Eigen::VectorXd upperBound = ( Eigen::VectorXd( 4 ) << 2.5, 100.0, 100.0, 100.0 ).finished( );
+    std::vector< Eigen::VectorXd > samples = statistics::generateUniformRandomSample(
+                42, 12, lowerBound, upperBound );
+
+    // Propagate each sample in a new environment
+    std::vector< Eigen::VectorXd > expectedResults;
+    for( unsigned int i = 0; i < samples.size( ); i++ )
+    {
+        SystemOfBodies bodies = createMonteCarloTestBodies( );
+        auto sampleSettings = getMonteCarloTestSettings( samples.at( i ), bodies );
+        SingleArcDynamicsSimulator< > dynamicsSimulator( bodies, sampleSettings.first, sampleSettings.second );
+        expectedResults.push_back( getFinalPropagatedState( dynamicsSimulator ) );
+    }
+
+    // Check that the dispersions influence the results
+    BOOST_CHECK( ( expectedResults.at( 0 ) - expectedResults.at( 1 ) ).norm( ) > 1.0 );
+
+    // Propagate samples sequentially and concurrently, with results returned and written to file
+    const boost::filesystem::path outputFilePath = boost::filesystem::temp_directory_path( ) /
+            boost::filesystem::unique_path( "monteCarloPropagationTestOutput-%%%%-%%%%.dat" );
+    const std::string outputFileName = outputFilePath.string( );
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 4; numberOfThreads += 3 )
+    {
+        std::vector< Eigen::VectorXd > results = propagateMonteCarloSamples< double, double >(
+                    samples, &createMonteCarloTestBodies, &getMonteCarloTestSettings, numberOfThreads,
+                    [ ]( const unsigned int, SingleArcDynamicsSimulator< >& dynamicsSimulator )
+        { return getFinalPropagatedState( dynamicsSimulator ); },
+        outputFileName );
+
+        BOOST_CHECK_EQUAL( results.size( ), samples.size( ) );
+        for( unsigned int i = 0; i < samples.size( ); i++ )
+        {
+            for( int j = 0; j < 6; j++ )
+            {
+                BOOST_CHECK_EQUAL( results.at( i )( j ), expectedResults.at( i )( j ) );
+            }
+        }
+
+        // Check that each sample is written to the output file exactly once
+        std::map< unsigned int, Eigen::VectorXd > fileResults;
+        std::ifstream outputFile( outputFileName );
+        std::string currentLine;
+        while( std::getline( outputFile, currentLine ) )
+        {
+            std::istringstream lineStream( currentLine );
+            unsigned int sampleIndex;
+            Eigen::VectorXd sampleResult = Eigen::VectorXd( 6 );
+            lineStream >> sampleIndex;
+            for( int j = 0; j < 6; j++ )
+            {
+                lineStream >> sampleResult( j );
+            }
+            BOOST_CHECK_EQUAL( fileResults.count( sampleIndex ), 0 );
+            fileResults[ sampleIndex ] = sampleResult;
+        }
+        BOOST_CHECK_EQUAL( fileResults.size( ), samples.size( ) );
+        for( auto resultIterator : fileResults )
+        {
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                        resultIterator.second, expectedResults.at( resultIterator.first ), 1.0E-15 );
+        }
+    }
+
+    // Check that results are not retained when requested
+    std::vector< Eigen::VectorXd > results = propagateMonteCarloSamples< double, double >(
+                samples, &createMonteCarloTestBodies, &getMonteCarloTestSettings, 2,
+                [ ]( const unsigned int, SingleArcDynamicsSimulator< >& dynamicsSimulator )
+    { return getFinalPropagatedState( dynamicsSimulator ); }, outputFileName, false );
+    BOOST_CHECK_EQUAL( results.size( ), 0 );
+
+    boost::filesystem::remove( outputFilePath );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -243,6 +243,126 @@ BOOST_AUTO_TEST_CASE( testKeplerMultiArcDynamics )
     }
 }
 
+//! Test whether concurrent propagation of arcs (each in its own environment) gives results identical to sequential propagation
+BOOST_AUTO_TEST_CASE( testConcurrentMultiArcDynamics )
+{
+    //Load spice kernels.
+    spice_interface::loadStandardSpiceKernels( );
+
+    std::vector< std::string > bodyNames;
+    bodyNames.push_back( "Earth" );
+    bodyNames.push_back( "Moon" );
+
+    // Specify initial time
+    double initialEphemerisTime = 1.0E7;
+    double finalEphemerisTime = 2.0E7;
+    double maximumTimeStep = 3600.0;
+    double buffer = 5.0 * maximumTimeStep;
+
+    // Define function to create environment
+    BodyListSettings bodySettings =
+            getDefaultBodySettings( bodyNames, initialEphemerisTime - buffer, finalEphemerisTime + buffer );
+    std::dynamic_pointer_cast< InterpolatedSpiceEphemerisSettings >( bodySettings.at( "Moon" )->ephemerisSettings )->
+            resetFrameOrigin( "Earth" );
+    bodySettings.at( "Moon" )->ephemerisSettings->resetMakeMultiArcEphemeris( true );
+    bodySettings.at( "Earth" )->ephemerisSettings = std::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ) );
+
+    // Set accelerations between bodies that are to be taken into account.
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Moon" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+    std::vector< std::string > bodiesToIntegrate = { "Moon" };
+    std::vector< std::string > centralBodies = { "Earth" };
+
+    // Define arcs
+    std::vector< double > integrationArcStarts, integrationArcEnds;
+    double arcDuration = 1.0E6;
+    double currentStartTime = initialEphemerisTime + 1.0E4;
+    while( currentStartTime + arcDuration < finalEphemerisTime - 1.0E4 )
+    {
+        integrationArcStarts.push_back( currentStartTime );
+        integrationArcEnds.push_back( currentStartTime + arcDuration );
+        currentStartTime += arcDuration - 1.0E4;
+    }
+    unsigned int numberOfIntegrationArcs = integrationArcStarts.size( );
+
+    std::vector< std::map< double, Eigen::VectorXd > > sequentialResults;
+    for( unsigned int testCase = 0; testCase < 3; testCase++ )
+    {
+        // Create environment in which results are set, and separate environment for each arc
+        SystemOfBodies bodies = createSystemOfBodies( bodySettings );
+        std::vector< SystemOfBodies > arcBodies;
+
+        std::vector< std::shared_ptr< SingleArcPropagatorSettings< double > > > arcPropagationSettingsList;
+        std::vector< std::shared_ptr< IntegratorSettings< > > > integratorSettingsList;
+        for( unsigned int i = 0; i < numberOfIntegrationArcs; i++ )
+        {
+            arcBodies.push_back( ( testCase == 0 ) ? bodies : createSystemOfBodies( bodySettings ) );
+
+            Eigen::VectorXd arcInitialState = spice_interface::getBodyCartesianStateAtEpoch(
+                        "Moon", "Earth", "ECLIPJ2000", "NONE", integrationArcStarts.at( i ) );
+            arcPropagationSettingsList.push_back(
+                        std::make_shared< TranslationalStatePropagatorSettings< double > >
+                        ( centralBodies, createAccelerationModelsMap(
+                              arcBodies.at( i ), accelerationMap, bodiesToIntegrate, centralBodies ),
+                          bodiesToIntegrate, arcInitialState, integrationArcEnds.at( i ) ) );
+            integratorSettingsList.push_back(
+                        std::make_shared< RungeKuttaVariableStepSizeSettings< > >
+                        ( integrationArcStarts.at( i ), 120.0, RungeKuttaCoefficients::rungeKuttaFehlberg78,
+                          1.0E-3, 3600.0, 1.0E-12, 1.0E-12 ) );
+        }
+
+        // Propagate with a single environment (case 0), or separate environment per arc, sequentially (case 1)
+        // and concurrently (case 2)
+        MultiArcDynamicsSimulator< > dynamicsSimulator(
+                    bodies, arcBodies, integratorSettingsList,
+                    std::make_shared< MultiArcPropagatorSettings< double > >( arcPropagationSettingsList ),
+                    ( testCase == 2 ) ? 4 : 1 );
+
+        std::vector< std::map< double, Eigen::VectorXd > > currentResults =
+                dynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+        BOOST_CHECK_EQUAL( currentResults.size( ), numberOfIntegrationArcs );
+
+        if( testCase == 0 )
+        {
+            sequentialResults = currentResults;
+        }
+        else
+        {
+            // Check if results are identical to those of sequential propagation
+            for( unsigned int i = 0; i < numberOfIntegrationArcs; i++ )
+            {
+                BOOST_CHECK_EQUAL( currentResults.at( i ).size( ), sequentialResults.at( i ).size( ) );
+                auto sequentialIterator = sequentialResults.at( i ).begin( );
+                for( auto stateIterator : currentResults.at( i ) )
+                {
+                    BOOST_CHECK_EQUAL( stateIterator.first, sequentialIterator->first );
+                    for( int j = 0; j < 6; j++ )
+                    {
+                        BOOST_CHECK_EQUAL( stateIterator.second( j ), sequentialIterator->second( j ) );
+                    }
+                    sequentialIterator++;
+                }
+            }
+        }
+
+        // Check if results are set in environment
+        for( unsigned int i = 0; i < numberOfIntegrationArcs; i++ )
+        {
+            auto testIterator = currentResults.at( i ).begin( );
+            std::advance( testIterator, currentResults.at( i ).size( ) / 2 );
+            Eigen::Vector6d stateDifference =
+                    bodies.at( "Moon" )->getEphemeris( )->getCartesianState( testIterator->first ) -
+                    Eigen::Vector6d( testIterator->second );
+            for( int j = 0; j < 3; j++ )
+            {
+                BOOST_CHECK_SMALL( stateDifference( j ), 1.0E-6 );
+                BOOST_CHECK_SMALL( stateDifference( j + 3 ), 1.0E-12 );
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 }
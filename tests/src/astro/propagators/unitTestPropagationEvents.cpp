@@ -0,0 +1,358 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/testMacros.h"
+#include "tudat/astro/basic_astro/astrodynamicsFunctions.h"
+#include "tudat/astro/basic_astro/orbitalElementConversions.h"
+#include "tudat/astro/basic_astro/unitConversions.h"
+#include "tudat/astro/propagators/integrateEquations.h"
+#include "tudat/math/integrators/rungeKuttaVariableStepSizeIntegrator.h"
+#include "tudat/simulation/environment_setup/createBodies.h"
+#include "tudat/simulation/propagation_setup/createAccelerationModels.h"
+#include "tudat/simulation/propagation_setup/dynamicsSimulator.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace tudat::propagators;
+using namespace tudat::simulation_setup;
+using namespace tudat::numerical_integrators;
+using namespace tudat::orbital_element_conversions;
+
+BOOST_AUTO_TEST_SUITE( test_propagation_events )
+
+//! Harmonic oscillator (x'' = -x) model, storing the last state at which the state derivative is evaluated
+class OscillatorModel
+{
+public:
+
+    Eigen::VectorXd computeStateDerivative( const double time, const Eigen::VectorXd& state )
+    {
+        numberOfEvaluations_++;
+        currentState_ = state;
+        return ( Eigen::VectorXd( 2 ) << state( 1 ), -state( 0 ) ).finished( );
+    }
+
+    int numberOfEvaluations_ = 0;
+
+    Eigen::VectorXd currentState_;
+};
+
+//! Function to create integrator for harmonic oscillator, starting at t = 0.3
+std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd, double > > createOscillatorIntegrator(
+        const std::shared_ptr< OscillatorModel > oscillatorModel )
+{
+    double initialTime = 0.3;
+    return std::make_shared< RungeKuttaVariableStepSizeIntegrator< double, Eigen::VectorXd, Eigen::VectorXd, double > >(
+                RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg78 ),
+                std::bind( &OscillatorModel::computeStateDerivative, oscillatorModel,
+                           std::placeholders::_1, std::placeholders::_2 ),
+                initialTime, ( Eigen::VectorXd( 2 ) << std::cos( initialTime ), -std::sin( initialTime ) ).finished( ),
+                1.0E-6, 100.0, Eigen::VectorXd::Constant( 2, 1.0E-12 ), Eigen::VectorXd::Constant( 2, 1.0E-12 ) );
+}
+
+//! Test locating an exact dependent variable termination condition on the dense output of the integrator
+BOOST_AUTO_TEST_CASE( testDenseOutputTermination )
+{
+    std::vector< double > finalTimes;
+    std::vector< int > numberOfEvaluations;
+    for( int useDenseOutput = 0; useDenseOutput < 2; useDenseOutput++ )
+    {
+        std::shared_ptr< OscillatorModel > oscillatorModel = std::make_shared< OscillatorModel >( );
+        std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd, double > > integrator =
+                createOscillatorIntegrator( oscillatorModel );
+        if( useDenseOutput )
+        {
+            integrator->setUseDenseOutput( true );
+        }
+
+        // Terminate when x < -0.5, i.e. at t = 2 pi / 3
+        std::shared_ptr< PropagationTerminationCondition > terminationCondition =
+                std::make_shared< SingleVariableLimitPropagationTerminationCondition >(
+                    nullptr, [ = ]( ){ return oscillatorModel->currentState_( 0 ); }, -0.5, true, true,
+                    root_finders::bisectionRootFinderSettings( TUDAT_NAN, 1.0E-12, TUDAT_NAN, 100 ) );
+
+        std::map< double, Eigen::VectorXd > stateHistory, dependentVariableHistory;
+        std::map< double, double > computationTimeHistory;
+        integrateEquationsFromIntegrator< Eigen::VectorXd, double, double >(
+                    integrator, 0.1, terminationCondition, stateHistory, dependentVariableHistory,
+                    computationTimeHistory, std::function< Eigen::VectorXd( ) >( ),
+                    std::function< void( Eigen::VectorXd& ) >( ), 1 );
+
+        finalTimes.push_back( stateHistory.rbegin( )->first );
+        numberOfEvaluations.push_back( oscillatorModel->numberOfEvaluations_ );
+        BOOST_CHECK_SMALL( stateHistory.rbegin( )->first - 2.0 * mathematical_constants::PI / 3.0, 1.0E-10 );
+        BOOST_CHECK_SMALL( stateHistory.rbegin( )->second( 0 ) + 0.5, 1.0E-10 );
+    }
+
+    // Check that the dense output requires (far) fewer state derivative evaluations
+    BOOST_CHECK_SMALL( finalTimes.at( 1 ) - finalTimes.at( 0 ), 1.0E-10 );
+    BOOST_CHECK( 3 * numberOfEvaluations.at( 1 ) < numberOfEvaluations.at( 0 ) );
+}
+
+//! Test detecting multiple events on the dense output of the integrator
+BOOST_AUTO_TEST_CASE( testOscillatorEvents )
+{
+    std::shared_ptr< OscillatorModel > oscillatorModel = std::make_shared< OscillatorModel >( );
+    std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd, double > > integrator =
+            createOscillatorIntegrator( oscillatorModel );
+
+    // Detect all crossings of x = 0 (t = pi / 2 + k pi) and increasing crossings of v = 0 (t = pi + 2 k pi)
+    std::vector< std::shared_ptr< PropagationEventCondition > > eventConditions;
+    eventConditions.push_back( std::make_shared< PropagationEventCondition >(
+                                   [ = ]( ){ return oscillatorModel->currentState_( 0 ); }, 0.0,
+                                   root_finders::bisectionRootFinderSettings( TUDAT_NAN, 1.0E-12, TUDAT_NAN, 100 ),
+                                   any_event_crossing, "Position" ) );
+    eventConditions.push_back( std::make_shared< PropagationEventCondition >(
+                                   [ = ]( ){ return oscillatorModel->currentState_( 1 ); }, 0.0,
+                                   root_finders::bisectionRootFinderSettings( TUDAT_NAN, 1.0E-12, TUDAT_NAN, 100 ),
+                                   increasing_event_crossing, "Velocity" ) );
+    std::shared_ptr< PropagationEventDetector > eventDetector =
+            std::make_shared< PropagationEventDetector >( eventConditions );
+
+    std::map< double, Eigen::VectorXd > stateHistory, dependentVariableHistory;
+    std::map< double, double > computationTimeHistory;
+    integrateEquationsFromIntegrator< Eigen::VectorXd, double, double >(
+                integrator, 0.1, std::make_shared< FixedTimePropagationTerminationCondition >( 20.05, true, true ),
+                stateHistory, dependentVariableHistory, computationTimeHistory,
+                std::function< Eigen::VectorXd( ) >( ), std::function< void( Eigen::VectorXd& ) >( ), 1, TUDAT_NAN,
+                std::chrono::steady_clock::now( ), TUDAT_NAN, eventDetector );
+
+    // Check number, order and times of events (events after the exact final time are removed). The errors in the event
+    // times and states are of the order of the integration error, as the events are located on the dense output.
+    std::vector< PropagationEventOccurrence > eventOccurrences = eventDetector->getEventOccurrences( );
+    BOOST_CHECK_EQUAL( eventOccurrences.size( ), 9 );
+
+    int numberOfPositionEvents = 0, numberOfVelocityEvents = 0;
+    for( unsigned int i = 0; i < eventOccurrences.size( ); i++ )
+    {
+        double eventTime = eventOccurrences.at( i ).eventTime_;
+        if( i > 0 )
+        {
+            BOOST_CHECK( eventTime > eventOccurrences.at( i - 1 ).eventTime_ );
+        }
+        BOOST_CHECK( eventTime < 20.05 );
+
+        if( eventOccurrences.at( i ).eventIndex_ == 0 )
+        {
+            BOOST_CHECK_EQUAL( eventOccurrences.at( i ).eventName_, "Position" );
+            BOOST_CHECK_SMALL( eventTime - ( mathematical_constants::PI / 2.0 +
+                                             numberOfPositionEvents * mathematical_constants::PI ), 1.0E-11 );
+            BOOST_CHECK_EQUAL( eventOccurrences.at( i ).isEventFunctionIncreasing_, ( numberOfPositionEvents % 2 == 1 ) );
+            BOOST_CHECK_SMALL( eventOccurrences.at( i ).eventState_( 0 ), 1.0E-11 );
+            numberOfPositionEvents++;
+        }
+        else
+        {
+            BOOST_CHECK_EQUAL( eventOccurrences.at( i ).eventName_, "Velocity" );
+            BOOST_CHECK_SMALL( eventTime - ( mathematical_constants::PI +
+                                             2.0 * numberOfVelocityEvents * mathematical_constants::PI ), 1.0E-11 );
+            BOOST_CHECK( eventOccurrences.at( i ).isEventFunctionIncreasing_ );
+            BOOST_CHECK_SMALL( eventOccurrences.at( i ).eventState_( 0 ) + 1.0, 1.0E-10 );
+            numberOfVelocityEvents++;
+        }
+    }
+    BOOST_CHECK_EQUAL( numberOfPositionEvents, 6 );
+    BOOST_CHECK_EQUAL( numberOfVelocityEvents, 3 );
+}
+
+//! Test storing events that cannot be located by the root finder as unresolved, with the bracketing integration step
+BOOST_AUTO_TEST_CASE( testUnresolvedOscillatorEvents )
+{
+    std::vector< std::vector< PropagationEventOccurrence > > eventOccurrencesPerCase;
+    for( int limitRootFinderIterations = 0; limitRootFinderIterations < 2; limitRootFinderIterations++ )
+    {
+        std::shared_ptr< OscillatorModel > oscillatorModel = std::make_shared< OscillatorModel >( );
+        std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd, double > > integrator =
+                createOscillatorIntegrator( oscillatorModel );
+
+        // Detect all crossings of x = 0, with root finder that fails (after 2 iterations) if iterations are limited
+        std::vector< std::shared_ptr< PropagationEventCondition > > eventConditions;
+        eventConditions.push_back( std::make_shared< PropagationEventCondition >(
+                                       [ = ]( ){ return oscillatorModel->currentState_( 0 ); }, 0.0,
+                                       root_finders::bisectionRootFinderSettings(
+                                           TUDAT_NAN, 1.0E-12, TUDAT_NAN, limitRootFinderIterations ? 2 : 100 ),
+                                       any_event_crossing, "Position" ) );
+        std::shared_ptr< PropagationEventDetector > eventDetector =
+                std::make_shared< PropagationEventDetector >( eventConditions );
+
+        std::map< double, Eigen::VectorXd > stateHistory, dependentVariableHistory;
+        std::map< double, double > computationTimeHistory;
+        integrateEquationsFromIntegrator< Eigen::VectorXd, double, double >(
+                    integrator, 0.1, std::make_shared< FixedTimePropagationTerminationCondition >( 20.05, true, false ),
+                    stateHistory, dependentVariableHistory, computationTimeHistory,
+                    std::function< Eigen::VectorXd( ) >( ), std::function< void( Eigen::VectorXd& ) >( ), 1, TUDAT_NAN,
+                    std::chrono::steady_clock::now( ), TUDAT_NAN, eventDetector );
+        eventOccurrencesPerCase.push_back( eventDetector->getEventOccurrences( ) );
+
+        // Check that bracketing intervals are integration steps
+        for( unsigned int i = 0; i < eventOccurrencesPerCase.back( ).size( ); i++ )
+        {
+            PropagationEventOccurrence eventOccurrence = eventOccurrencesPerCase.back( ).at( i );
+            BOOST_CHECK_EQUAL( eventOccurrence.isEventResolved_, !limitRootFinderIterations );
+            BOOST_CHECK( stateHistory.count( eventOccurrence.bracketingInterval_.first ) > 0 );
+            BOOST_CHECK( stateHistory.count( eventOccurrence.bracketingInterval_.second ) > 0 );
+            BOOST_CHECK( eventOccurrence.bracketingInterval_.first < eventOccurrence.eventTime_ );
+            BOOST_CHECK( eventOccurrence.bracketingInterval_.second >= eventOccurrence.eventTime_ );
+
+            // Check that unresolved events are saved at end of step
+            if( limitRootFinderIterations )
+            {
+                BOOST_CHECK_EQUAL( eventOccurrence.eventTime_, eventOccurrence.bracketingInterval_.second );
+                TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                            eventOccurrence.eventState_, stateHistory.at( eventOccurrence.bracketingInterval_.second ),
+                            std::numeric_limits< double >::epsilon( ) );
+            }
+        }
+    }
+
+    // Check that all events are retained when unresolved, with the same bracketing interval and direction
+    BOOST_CHECK_EQUAL( eventOccurrencesPerCase.at( 0 ).size( ), 6 );
+    BOOST_CHECK_EQUAL( eventOccurrencesPerCase.at( 0 ).size( ), eventOccurrencesPerCase.at( 1 ).size( ) );
+    for( unsigned int i = 0; i < eventOccurrencesPerCase.at( 0 ).size( ); i++ )
+    {
+        BOOST_CHECK( eventOccurrencesPerCase.at( 0 ).at( i ).bracketingInterval_ ==
+                     eventOccurrencesPerCase.at( 1 ).at( i ).bracketingInterval_ );
+        BOOST_CHECK_EQUAL( eventOccurrencesPerCase.at( 0 ).at( i ).isEventFunctionIncreasing_,
+                           eventOccurrencesPerCase.at( 1 ).at( i ).isEventFunctionIncreasing_ );
+    }
+}
+
+//! Test detecting events in a full propagation, compared to analytical Kepler orbit
+BOOST_AUTO_TEST_CASE( testKeplerOrbitEvents )
+{
+    const double gravitationalParameter = 3.986004418E14;
+
+    // Create environment
+    BodyListSettings bodySettings = BodyListSettings( "Earth", "ECLIPJ2000" );
+    bodySettings.addSettings( "Earth" );
+    bodySettings.at( "Earth" )->ephemerisSettings = std::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ), "Earth", "ECLIPJ2000" );
+    bodySettings.at( "Earth" )->gravityFieldSettings = std::make_shared< CentralGravityFieldSettings >(
+                gravitationalParameter );
+    SystemOfBodies bodies = createSystemOfBodies( bodySettings );
+    bodies.createEmptyBody( "Vehicle" );
+
+    // Create propagator settings, for (approximately) three orbits
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back(
+                std::make_shared< AccelerationSettings >( basic_astrodynamics::point_mass_gravity ) );
+    std::vector< std::string > bodiesToPropagate = { "Vehicle" };
+    std::vector< std::string > centralBodies = { "Earth" };
+
+    Eigen::Vector6d initialKeplerianState;
+    initialKeplerianState << 7000.0E3, 0.05, unit_conversions::convertDegreesToRadians( 51.6 ), 0.3, 1.2, 0.1;
+    double orbitalPeriod = basic_astrodynamics::computeKeplerOrbitalPeriod(
+                initialKeplerianState( semiMajorAxisIndex ), gravitationalParameter );
+
+    std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+            std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                centralBodies, createAccelerationModelsMap( bodies, accelerationMap, bodiesToPropagate, centralBodies ),
+                bodiesToPropagate, convertKeplerianToCartesianElements( initialKeplerianState, gravitationalParameter ),
+                std::make_shared< PropagationTimeTerminationSettings >( 3.0 * orbitalPeriod, true ) );
+
+    // Detect all crossings of the semi-major axis distance, and increasing crossings of 7200 km
+    std::shared_ptr< SingleDependentVariableSaveSettings > distanceSettings =
+            std::make_shared< SingleDependentVariableSaveSettings >(
+                relative_distance_dependent_variable, "Vehicle", "Earth" );
+    propagatorSettings->addEventSettings(
+                propagationEventSettings( distanceSettings, 7000.0E3,
+                                          root_finders::bisectionRootFinderSettings( TUDAT_NAN, 1.0E-6, TUDAT_NAN, 100 ) ) );
+    propagatorSettings->addEventSettings(
+                propagationEventSettings( distanceSettings, 7200.0E3,
+                                          root_finders::bisectionRootFinderSettings( TUDAT_NAN, 1.0E-6, TUDAT_NAN, 100 ),
+                                          increasing_event_crossing, "Distance 7200 km" ) );
+
+    std::shared_ptr< IntegratorSettings< > > integratorSettings =
+            std::make_shared< RungeKuttaVariableStepSizeSettingsScalarTolerances< > >(
+                0.0, 10.0, RungeKuttaCoefficients::rungeKuttaFehlberg78, 1.0E-3, 1000.0, 1.0E-12, 1.0E-12 );
+
+    SingleArcDynamicsSimulator< > dynamicsSimulator(
+                bodies, integratorSettings, propagatorSettings, true, false, false );
+    std::vector< PropagationEventOccurrence > eventOccurrences = dynamicsSimulator.getPropagationEvents( );
+
+    // Compute analytical times at which distance is crossed (within each orbit)
+    double eccentricity = initialKeplerianState( eccentricityIndex );
+    double semiMajorAxis = initialKeplerianState( semiMajorAxisIndex );
+    double meanMotion = basic_astrodynamics::computeKeplerMeanMotion( semiMajorAxis, gravitationalParameter );
+    double initialMeanAnomaly = convertEllipticalEccentricAnomalyToMeanAnomaly(
+                convertTrueAnomalyToEllipticalEccentricAnomaly( initialKeplerianState( trueAnomalyIndex ), eccentricity ),
+                eccentricity );
+    std::function< std::vector< double >( const double ) > getCrossingTimes = [ & ]( const double distance )
+    {
+        double crossingTrueAnomaly = std::acos( ( semiMajorAxis * ( 1.0 - eccentricity * eccentricity ) / distance - 1.0 ) /
+                                                eccentricity );
+        std::vector< double > crossingTimes;
+        for( double trueAnomaly : { crossingTrueAnomaly, 2.0 * mathematical_constants::PI - crossingTrueAnomaly } )
+        {
+            double meanAnomaly = convertEllipticalEccentricAnomalyToMeanAnomaly(
+                        convertTrueAnomalyToEllipticalEccentricAnomaly( trueAnomaly, eccentricity ), eccentricity );
+            double crossingTime = basic_mathematics::computeModulo(
+                        meanAnomaly - initialMeanAnomaly, 2.0 * mathematical_constants::PI ) / meanMotion;
+            crossingTimes.push_back( crossingTime );
+        }
+        return crossingTimes;
+    };
+
+    // Check detected events against analytical times
+    std::vector< double > semiMajorAxisCrossingTimes = getCrossingTimes( 7000.0E3 );
+    std::vector< double > increasingCrossingTimes = getCrossingTimes( 7200.0E3 );
+    BOOST_CHECK_EQUAL( eventOccurrences.size( ), 9 );
+    for( unsigned int i = 0; i < eventOccurrences.size( ); i++ )
+    {
+        double eventTime = eventOccurrences.at( i ).eventTime_;
+        double timeInOrbit = basic_mathematics::computeModulo( eventTime, orbitalPeriod );
+
+        // Check that event is at one of the analytical crossings
+        double minimumTimeDifference = TUDAT_NAN;
+        std::vector< double > analyticalTimes = ( eventOccurrences.at( i ).eventIndex_ == 0 ) ?
+                    semiMajorAxisCrossingTimes : std::vector< double >( { increasingCrossingTimes.at( 0 ) } );
+        for( double analyticalTime : analyticalTimes )
+        {
+            double timeDifference = std::fabs( timeInOrbit - analyticalTime );
+            if( !( minimumTimeDifference <= timeDifference ) )
+            {
+                minimumTimeDifference = timeDifference;
+            }
+        }
+        BOOST_CHECK_SMALL( minimumTimeDifference, 1.0E-4 );
+
+        // Check state at event
+        BOOST_CHECK_SMALL( eventOccurrences.at( i ).eventState_.block( 0, 0, 3, 1 ).norm( ) -
+                           ( ( eventOccurrences.at( i ).eventIndex_ == 0 ) ? 7000.0E3 : 7200.0E3 ), 1.0E-3 );
+        if( eventOccurrences.at( i ).eventIndex_ == 1 )
+        {
+            BOOST_CHECK_EQUAL( eventOccurrences.at( i ).eventName_, "Distance 7200 km" );
+            BOOST_CHECK( eventOccurrences.at( i ).isEventFunctionIncreasing_ );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,291 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/testMacros.h"
+#include "tudat/astro/basic_astro/keplerPropagator.h"
+#include "tudat/astro/basic_astro/orbitalElementConversions.h"
+#include "tudat/astro/basic_astro/unitConversions.h"
+#include "tudat/io/binaryHistoryFile.h"
+#include "tudat/simulation/environment_setup/createBodies.h"
+#include "tudat/simulation/propagation_setup/createAccelerationModels.h"
+#include "tudat/simulation/propagation_setup/dynamicsSimulator.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace tudat::propagators;
+using namespace tudat::simulation_setup;
+using namespace tudat::numerical_integrators;
+using namespace tudat::orbital_element_conversions;
+
+BOOST_AUTO_TEST_SUITE( test_propagation_output_sink )
+
+//! Gravitational parameter of the central body used in the tests
+const double testGravitationalParameter = 3.986004418E14;
+
+//! Function to create the (Spice-independent) environment for the output sink tests
+SystemOfBodies createOutputSinkTestBodies( )
+{
+    BodyListSettings bodySettings = BodyListSettings( "Earth", "ECLIPJ2000" );
+    bodySettings.addSettings( "Earth" );
+    bodySettings.at( "Earth" )->ephemerisSettings = std::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ), "Earth", "ECLIPJ2000" );
+    bodySettings.at( "Earth" )->gravityFieldSettings = std::make_shared< CentralGravityFieldSettings >(
+                testGravitationalParameter );
+
+    SystemOfBodies bodies = createSystemOfBodies( bodySettings );
+    bodies.createEmptyBody( "Vehicle" );
+    return bodies;
+}
+
+//! Function to retrieve the initial Keplerian state of the vehicle
+Eigen::Vector6d getOutputSinkTestInitialKeplerianState( )
+{
+    Eigen::Vector6d initialKeplerianState;
+    initialKeplerianState << 7000.0E3, 0.05, unit_conversions::convertDegreesToRadians( 51.6 ), 0.3, 1.2, 0.1;
+    return initialKeplerianState;
+}
+
+//! Function to create the propagator settings for the output sink tests (propagating exactly to t = 7200 s)
+std::shared_ptr< TranslationalStatePropagatorSettings< double > > getOutputSinkTestPropagatorSettings(
+        const SystemOfBodies& bodies )
+{
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back(
+                std::make_shared< AccelerationSettings >( basic_astrodynamics::point_mass_gravity ) );
+    std::vector< std::string > bodiesToPropagate = { "Vehicle" };
+    std::vector< std::string > centralBodies = { "Earth" };
+
+    std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > > dependentVariables;
+    dependentVariables.push_back( std::make_shared< SingleDependentVariableSaveSettings >(
+                                      relative_distance_dependent_variable, "Vehicle", "Earth" ) );
+    dependentVariables.push_back( std::make_shared< SingleDependentVariableSaveSettings >(
+                                      keplerian_state_dependent_variable, "Vehicle", "Earth" ) );
+
+    return std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                centralBodies, createAccelerationModelsMap( bodies, accelerationMap, bodiesToPropagate, centralBodies ),
+                bodiesToPropagate, convertKeplerianToCartesianElements(
+                    getOutputSinkTestInitialKeplerianState( ), testGravitationalParameter ),
+                std::make_shared< PropagationTimeTerminationSettings >( 7200.0, true ), cowell,
+                std::make_shared< DependentVariableSaveSettings >( dependentVariables, false ) );
+}
+
+//! Function to create the integrator settings for the output sink tests
+std::shared_ptr< IntegratorSettings< > > getOutputSinkTestIntegratorSettings( )
+{
+    return std::make_shared< RungeKuttaVariableStepSizeSettingsScalarTolerances< > >(
+                0.0, 10.0, RungeKuttaCoefficients::rungeKuttaFehlberg78, 1.0E-3, 1000.0, 1.0E-12, 1.0E-12 );
+}
+
+//! Test whether the output streamed to the built-in output sinks is consistent with the in-memory propagation history
+BOOST_AUTO_TEST_CASE( testPropagationOutputSinks )
+{
+    SystemOfBodies bodies = createOutputSinkTestBodies( );
+
+    // Propagate without output sinks
+    std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+            getOutputSinkTestPropagatorSettings( bodies );
+    SingleArcDynamicsSimulator< > dynamicsSimulator(
+                bodies, getOutputSinkTestIntegratorSettings( ), propagatorSettings, true, false, false );
+    std::map< double, Eigen::VectorXd > stateHistory = dynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+    std::map< double, Eigen::VectorXd > dependentVariableHistory = dynamicsSimulator.getDependentVariableHistory( );
+    std::map< int, std::string > dependentVariableIds = dynamicsSimulator.getDependentVariableIds( );
+    BOOST_CHECK_EQUAL( stateHistory.rbegin( )->first, 7200.0 );
+
+    // Repeat propagation with all built-in output sinks
+    std::shared_ptr< RingBufferOutputSink< > > fullOutputSink =
+            std::make_shared< RingBufferOutputSink< > >( 1000000 );
+    std::shared_ptr< RingBufferOutputSink< > > limitedOutputSink =
+            std::make_shared< RingBufferOutputSink< > >( 10 );
+    std::shared_ptr< RingBufferOutputSink< > > decimatedOutputSink =
+            std::make_shared< RingBufferOutputSink< > >( 1000000 );
+    std::shared_ptr< RingBufferOutputSink< > > fixedIntervalOutputSink =
+            std::make_shared< RingBufferOutputSink< > >( 1000000 );
+    std::shared_ptr< RunningStatisticsOutputSink< > > statisticsOutputSink =
+            std::make_shared< RunningStatisticsOutputSink< > >( );
+    int numberOfCustomSinkCalls = 0;
+    bool isCustomSinkFinalized = false;
+    std::string fileName = "propagationOutputSinkTest.dat";
+
+    propagatorSettings->addOutputSink( fullOutputSink );
+    propagatorSettings->addOutputSink( limitedOutputSink );
+    propagatorSettings->addOutputSink( std::make_shared< DecimatingOutputSink< > >( 5, decimatedOutputSink ) );
+    propagatorSettings->addOutputSink( std::make_shared< FixedIntervalOutputSink< > >( 60.0, fixedIntervalOutputSink ) );
+    propagatorSettings->addOutputSink( statisticsOutputSink );
+    propagatorSettings->addOutputSink( std::make_shared< BinaryFileOutputSink< > >( fileName, 16 ) );
+    propagatorSettings->addOutputSink( std::make_shared< CustomOutputSink< > >(
+                                           [ & ]( const double, const Eigen::VectorXd&, const Eigen::VectorXd& )
+    { numberOfCustomSinkCalls++; }, [ & ]( ){ isCustomSinkFinalized = true; } ) );
+
+    SingleArcDynamicsSimulator< > streamingDynamicsSimulator(
+                bodies, getOutputSinkTestIntegratorSettings( ), propagatorSettings, true, false, false );
+
+    // Check that in-memory history is unaffected by output sinks
+    BOOST_CHECK( streamingDynamicsSimulator.getEquationsOfMotionNumericalSolution( ) == stateHistory );
+    BOOST_CHECK( streamingDynamicsSimulator.getDependentVariableHistory( ) == dependentVariableHistory );
+
+    // Check that all epochs are passed to output sinks exactly once (including the final epoch at exact termination)
+    BOOST_CHECK( fullOutputSink->getStateHistory( ) == stateHistory );
+    BOOST_CHECK( fullOutputSink->getDependentVariableHistory( ) == dependentVariableHistory );
+    BOOST_CHECK_EQUAL( numberOfCustomSinkCalls, stateHistory.size( ) );
+    BOOST_CHECK( isCustomSinkFinalized );
+
+    // Check that only most recent epochs are retained in ring buffer
+    BOOST_CHECK_EQUAL( limitedOutputSink->size( ), 10 );
+    BOOST_CHECK( limitedOutputSink->getStateHistory( ).begin( )->second ==
+                 std::next( stateHistory.begin( ), stateHistory.size( ) - 10 )->second );
+    BOOST_CHECK_EQUAL( limitedOutputSink->getStateHistory( ).rbegin( )->first, 7200.0 );
+
+    // Check that every 5th epoch, and the final epoch, are passed through decimating output sink
+    std::map< double, Eigen::VectorXd > decimatedStateHistory = decimatedOutputSink->getStateHistory( );
+    unsigned int expectedNumberOfDecimatedEpochs = 0;
+    int epochIndex = 0;
+    for( auto stateIterator : stateHistory )
+    {
+        if( epochIndex % 5 == 0 || epochIndex == static_cast< int >( stateHistory.size( ) ) - 1 )
+        {
+            BOOST_CHECK( decimatedStateHistory.at( stateIterator.first ) == stateIterator.second );
+            expectedNumberOfDecimatedEpochs++;
+        }
+        else
+        {
+            BOOST_CHECK_EQUAL( decimatedStateHistory.count( stateIterator.first ), 0 );
+        }
+        epochIndex++;
+    }
+    BOOST_CHECK_EQUAL( decimatedStateHistory.size( ), expectedNumberOfDecimatedEpochs );
+
+    // Check that fixed interval output is at multiples of output interval, and consistent with analytical solution
+    std::map< double, Eigen::VectorXd > fixedIntervalStateHistory = fixedIntervalOutputSink->getStateHistory( );
+    std::map< double, Eigen::VectorXd > fixedIntervalDependentVariableHistory =
+            fixedIntervalOutputSink->getDependentVariableHistory( );
+    BOOST_CHECK_EQUAL( fixedIntervalStateHistory.size( ), 121 );
+    epochIndex = 0;
+    for( auto stateIterator : fixedIntervalStateHistory )
+    {
+        BOOST_CHECK_EQUAL( stateIterator.first, 60.0 * static_cast< double >( epochIndex ) );
+
+        Eigen::Vector6d analyticalState = convertKeplerianToCartesianElements(
+                    propagateKeplerOrbit( getOutputSinkTestInitialKeplerianState( ), stateIterator.first,
+                                          testGravitationalParameter ), testGravitationalParameter );
+        for( int i = 0; i < 3; i++ )
+        {
+            BOOST_CHECK_SMALL( std::fabs( stateIterator.second( i ) - analyticalState( i ) ), 1.0E-2 );
+            BOOST_CHECK_SMALL( std::fabs( stateIterator.second( i + 3 ) - analyticalState( i + 3 ) ), 1.0E-5 );
+        }
+        BOOST_CHECK_CLOSE_FRACTION( fixedIntervalDependentVariableHistory.at( stateIterator.first )( 0 ),
+                                    stateIterator.second.segment( 0, 3 ).norm( ), 1.0E-10 );
+        epochIndex++;
+    }
+
+    // Check running statistics against statistics computed from in-memory history
+    BOOST_CHECK_EQUAL( statisticsOutputSink->getNumberOfSteps( ), stateHistory.size( ) );
+    double meanDistance = 0.0, minimumDistance = TUDAT_NAN, maximumDistance = TUDAT_NAN;
+    for( auto variableIterator : dependentVariableHistory )
+    {
+        double currentDistance = variableIterator.second( 0 );
+        meanDistance += currentDistance / static_cast< double >( dependentVariableHistory.size( ) );
+        minimumDistance = ( variableIterator.first == 0.0 ) ? currentDistance : std::min( minimumDistance, currentDistance );
+        maximumDistance = ( variableIterator.first == 0.0 ) ? currentDistance : std::max( maximumDistance, currentDistance );
+    }
+    BOOST_CHECK_EQUAL( statisticsOutputSink->getMean( ).rows( ), 13 );
+    BOOST_CHECK_CLOSE_FRACTION( statisticsOutputSink->getMean( )( 6 ), meanDistance, 1.0E-12 );
+    BOOST_CHECK_EQUAL( statisticsOutputSink->getMinimum( )( 6 ), minimumDistance );
+    BOOST_CHECK_EQUAL( statisticsOutputSink->getMaximum( )( 6 ), maximumDistance );
+    BOOST_CHECK_SMALL( statisticsOutputSink->getStandardDeviation( )( 7 ), 1.0E-3 );
+
+    // Check binary file output
+    input_output::BinaryHistoryFileReader fileReader( fileName );
+    BOOST_CHECK_EQUAL( fileReader.getNumberOfEpochs( ), stateHistory.size( ) );
+    BOOST_CHECK_EQUAL( fileReader.getNumberOfColumns( ), 13 );
+    BOOST_CHECK_EQUAL( fileReader.getHeader( ).columnNames.at( 6 ), dependentVariableIds.at( 0 ) + " [0]" );
+    BOOST_CHECK_EQUAL( fileReader.getHeader( ).columnNames.at( 12 ), dependentVariableIds.at( 1 ) + " [5]" );
+    epochIndex = 0;
+    for( auto stateIterator : stateHistory )
+    {
+        BOOST_CHECK_EQUAL( fileReader.getTime< double >( epochIndex ), stateIterator.first );
+        Eigen::VectorXd fileValues = fileReader.getValues< double >( epochIndex );
+        BOOST_CHECK( fileValues.segment( 0, 6 ) == stateIterator.second );
+        BOOST_CHECK( fileValues.segment( 6, 7 ) == dependentVariableHistory.at( stateIterator.first ) );
+        epochIndex++;
+    }
+}
+
+//! Test propagation with output sinks, without storing the propagation history in memory
+BOOST_AUTO_TEST_CASE( testPropagationOutputSinksWithoutMemory )
+{
+    SystemOfBodies bodies = createOutputSinkTestBodies( );
+
+    std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+            getOutputSinkTestPropagatorSettings( bodies );
+    SingleArcDynamicsSimulator< > dynamicsSimulator(
+                bodies, getOutputSinkTestIntegratorSettings( ), propagatorSettings, true, false, false );
+
+    // Propagate with only a decimated output sink, and without in-memory history
+    std::shared_ptr< RingBufferOutputSink< > > decimatedOutputSink = std::make_shared< RingBufferOutputSink< > >( 1000000 );
+    propagatorSettings->addOutputSink( std::make_shared< DecimatingOutputSink< > >( 10, decimatedOutputSink, false ) );
+    propagatorSettings->setStoreHistoryInMemory( false );
+    SingleArcDynamicsSimulator< > streamingDynamicsSimulator(
+                bodies, getOutputSinkTestIntegratorSettings( ), propagatorSettings, true, false, false );
+
+    BOOST_CHECK_EQUAL( streamingDynamicsSimulator.getEquationsOfMotionNumericalSolution( ).size( ), 0 );
+    BOOST_CHECK_EQUAL( streamingDynamicsSimulator.getDependentVariableHistory( ).size( ), 0 );
+    BOOST_CHECK_EQUAL( streamingDynamicsSimulator.getCumulativeComputationTimeHistory( ).size( ), 0 );
+    BOOST_CHECK_EQUAL( streamingDynamicsSimulator.getPropagationTerminationReason( )->getPropagationTerminationReason( ),
+                       termination_condition_reached );
+
+    std::map< double, Eigen::VectorXd > stateHistory = dynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+    std::map< double, Eigen::VectorXd > decimatedStateHistory = decimatedOutputSink->getStateHistory( );
+    BOOST_CHECK_EQUAL( decimatedStateHistory.size( ), ( stateHistory.size( ) + 9 ) / 10 );
+    for( auto stateIterator : decimatedStateHistory )
+    {
+        BOOST_CHECK( stateHistory.at( stateIterator.first ) == stateIterator.second );
+    }
+
+    // Check that setting integrated result is not possible without in-memory history
+    BOOST_CHECK_THROW( SingleArcDynamicsSimulator< >(
+                           bodies, getOutputSinkTestIntegratorSettings( ), propagatorSettings, true, false, true ),
+                       std::runtime_error );
+
+    // Check that columnar history storage can not be combined with output streaming
+    propagatorSettings->setStoreHistoryInMemory( true );
+    propagatorSettings->setUseColumnarHistoryStorage( true );
+    BOOST_CHECK_THROW( SingleArcDynamicsSimulator< >(
+                           bodies, getOutputSinkTestIntegratorSettings( ), propagatorSettings, true, false, false ),
+                       std::runtime_error );
+    propagatorSettings->setUseColumnarHistoryStorage( false );
+
+    // Check that output sink with incompatible state scalar type is detected
+    propagatorSettings->addOutputSink( std::make_shared< RunningStatisticsOutputSink< double, long double > >( ) );
+    BOOST_CHECK_THROW( SingleArcDynamicsSimulator< >(
+                           bodies, getOutputSinkTestIntegratorSettings( ), propagatorSettings, true, false, false ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -1169,6 +1169,36 @@ BOOST_AUTO_TEST_CASE( testMassRateVariationalEquations )
         std::map< double, Eigen::VectorXd > integrationResult =
                 variationalEquationsSimulator.getDynamicsSimulator( )->getEquationsOfMotionNumericalSolution( );
 
+        // For translational dynamics only, check that propagation with fixed-size state types gives the same results
+        if( test == 0 )
+        {
+            propagatorSettings->setUseFixedSizeStatePropagation( true );
+            SingleArcVariationalEquationsSolver< > fixedSizeVariationalEquationsSimulator(
+                        bodies, integratorSettings, propagatorSettings, parametersToEstimate, true,
+                        std::shared_ptr< numerical_integrators::IntegratorSettings< double > >( ), false, true );
+            propagatorSettings->setUseFixedSizeStatePropagation( false );
+
+            std::map< double, Eigen::MatrixXd > fixedSizeStateTransitionResult =
+                    fixedSizeVariationalEquationsSimulator.getNumericalVariationalEquationsSolution( ).at( 0 );
+            std::map< double, Eigen::VectorXd > fixedSizeIntegrationResult =
+                    fixedSizeVariationalEquationsSimulator.getDynamicsSimulator( )->getEquationsOfMotionNumericalSolution( );
+
+            BOOST_CHECK_EQUAL( fixedSizeStateTransitionResult.size( ), stateTransitionResult.size( ) );
+            BOOST_CHECK_EQUAL( fixedSizeIntegrationResult.size( ), integrationResult.size( ) );
+            for( auto matrixIterator : stateTransitionResult )
+            {
+                Eigen::MatrixXd matrixDifference =
+                        matrixIterator.second - fixedSizeStateTransitionResult.at( matrixIterator.first );
+                BOOST_CHECK_SMALL( matrixDifference.cwiseAbs( ).maxCoeff( ) /
+                                   matrixIterator.second.cwiseAbs( ).maxCoeff( ), 1.0E-14 );
+
+                Eigen::VectorXd stateDifference =
+                        integrationResult.at( matrixIterator.first ) - fixedSizeIntegrationResult.at( matrixIterator.first );
+                BOOST_CHECK_SMALL( stateDifference.cwiseAbs( ).maxCoeff( ) /
+                                   integrationResult.at( matrixIterator.first ).cwiseAbs( ).maxCoeff( ), 1.0E-14 );
+            }
+        }
+
         if( test == 0 )
         {
             finalStateTransitionTranslationalOnly = stateTransitionResult.rbegin( )->second;
@@ -1204,6 +1234,332 @@ BOOST_AUTO_TEST_CASE( testMassRateVariationalEquations )
 }
 
 
+
+//! Partial derivative model for test, adding constant partials w.r.t. states of given bodies and w.r.t. given parameter
+class ConstantTestStateDerivativePartial: public orbit_determination::StateDerivativePartial
+{
+public:
+    ConstantTestStateDerivativePartial(
+            const std::string& acceleratedBody,
+            const std::map< std::pair< std::string, IntegratedStateType >, Eigen::MatrixXd >& statePartials,
+            const std::shared_ptr< EstimatableParameter< double > > parameter = nullptr,
+            const Eigen::MatrixXd& parameterPartial = Eigen::MatrixXd::Zero( 3, 1 ),
+            const IntegratedStateType stateDerivativeType = translational_state ):
+        orbit_determination::StateDerivativePartial( stateDerivativeType, std::make_pair( acceleratedBody, "" ) ),
+        statePartials_( statePartials ), parameter_( parameter ), parameterPartial_( parameterPartial ){ }
+
+    std::pair< std::function< void( Eigen::Block< Eigen::MatrixXd > ) >, int >
+    getDerivativeFunctionWrtStateOfIntegratedBody(
+            const std::pair< std::string, std::string >& stateReferencePoint,
+            const propagators::IntegratedStateType integratedStateType )
+    {
+        if( statePartials_.count( std::make_pair( stateReferencePoint.first, integratedStateType ) ) > 0 )
+        {
+            Eigen::MatrixXd statePartial = statePartials_.at( std::make_pair( stateReferencePoint.first, integratedStateType ) );
+            return std::make_pair( std::function< void( Eigen::Block< Eigen::MatrixXd > ) >(
+                                       [ = ]( Eigen::Block< Eigen::MatrixXd > partialMatrix ){ partialMatrix += statePartial; } ), 3 );
+        }
+        return std::make_pair( std::function< void( Eigen::Block< Eigen::MatrixXd > ) >( ), 0 );
+    }
+
+    bool isStateDerivativeDependentOnIntegratedAdditionalStateTypes(
+            const std::pair< std::string, std::string >& stateReferencePoint,
+            const propagators::IntegratedStateType integratedStateType )
+    {
+        return false;
+    }
+
+    using orbit_determination::StateDerivativePartial::getParameterPartialFunction;
+
+    std::pair< std::function< void( Eigen::MatrixXd& ) >, int > getParameterPartialFunction(
+            std::shared_ptr< EstimatableParameter< double > > parameter )
+    {
+        if( parameter == parameter_ )
+        {
+            Eigen::MatrixXd parameterPartial = parameterPartial_;
+            return std::make_pair( std::function< void( Eigen::MatrixXd& ) >(
+                                       [ = ]( Eigen::MatrixXd& partialMatrix ){ partialMatrix = parameterPartial; } ), 1 );
+        }
+        return std::make_pair( std::function< void( Eigen::MatrixXd& ) >( ), 0 );
+    }
+
+    void update( const double currentTime ){ }
+
+private:
+    std::map< std::pair< std::string, IntegratedStateType >, Eigen::MatrixXd > statePartials_;
+
+    std::shared_ptr< EstimatableParameter< double > > parameter_;
+
+    Eigen::MatrixXd parameterPartial_;
+};
+
+//! Parameter for test, with no physical meaning
+class TestDoubleParameter: public EstimatableParameter< double >
+{
+public:
+    TestDoubleParameter( ): EstimatableParameter< double >( constant_drag_coefficient, "Vehicle" ), parameterValue_( 1.0 ){ }
+
+    double getParameterValue( ){ return parameterValue_; }
+
+    void setParameterValue( const double parameterValue ){ parameterValue_ = parameterValue; }
+
+    int getParameterSize( ){ return 1; }
+
+private:
+    double parameterValue_;
+};
+
+//! Test the evaluation of the variational equations, using the sparsity of the variational matrix, against a dense product
+BOOST_AUTO_TEST_CASE( testSparseVariationalEquationEvaluation )
+{
+    // Estimate states of Moon and vehicle w.r.t. Earth, and Earth w.r.t. barycenter
+    std::vector< std::string > bodiesToEstimate = { "Moon", "Earth", "Vehicle" };
+    std::vector< std::string > centralBodies = { "Earth", "SSB", "Earth" };
+    std::vector< std::shared_ptr< EstimatableParameter< Eigen::VectorXd > > > initialStateParameters;
+    for( unsigned int i = 0; i < bodiesToEstimate.size( ); i++ )
+    {
+        initialStateParameters.push_back( std::make_shared< InitialTranslationalStateParameter< double > >(
+                                              bodiesToEstimate.at( i ), Eigen::VectorXd::Zero( 6 ), centralBodies.at( i ) ) );
+    }
+    std::shared_ptr< EstimatableParameter< double > > testParameter = std::make_shared< TestDoubleParameter >( );
+    std::shared_ptr< EstimatableParameterSet< double > > parametersToEstimate =
+            std::make_shared< EstimatableParameterSet< double > >(
+                std::vector< std::shared_ptr< EstimatableParameter< double > > >( { testParameter } ),
+                std::vector< std::shared_ptr< EstimatableParameter< Eigen::VectorXd > > >( ), initialStateParameters );
+
+    // Define partials: Moon and Earth depend on each other's state, vehicle depends on Earth's state (but not vice versa)
+    std::map< std::pair< int, int >, Eigen::MatrixXd > statePartials;
+    statePartials[ std::make_pair( 0, 0 ) ] = Eigen::MatrixXd::Random( 3, 6 );
+    statePartials[ std::make_pair( 0, 1 ) ] = Eigen::MatrixXd::Random( 3, 6 );
+    statePartials[ std::make_pair( 1, 1 ) ] = Eigen::MatrixXd::Random( 3, 6 );
+    statePartials[ std::make_pair( 1, 0 ) ] = Eigen::MatrixXd::Random( 3, 6 );
+    statePartials[ std::make_pair( 2, 2 ) ] = Eigen::MatrixXd::Random( 3, 6 );
+    statePartials[ std::make_pair( 2, 1 ) ] = Eigen::MatrixXd::Random( 3, 6 );
+    Eigen::MatrixXd parameterPartial = Eigen::MatrixXd::Random( 3, 1 );
+
+    orbit_determination::StateDerivativePartialsMap partialsMap;
+    partialsMap.resize( bodiesToEstimate.size( ) );
+    for( auto partialIterator : statePartials )
+    {
+        std::map< std::pair< std::string, IntegratedStateType >, Eigen::MatrixXd > currentStatePartials;
+        currentStatePartials[ std::make_pair( bodiesToEstimate.at( partialIterator.first.second ), translational_state ) ] =
+                partialIterator.second;
+        if( partialIterator.first == std::make_pair( 2, 2 ) )
+        {
+            partialsMap.at( partialIterator.first.first ).push_back(
+                        std::make_shared< ConstantTestStateDerivativePartial >(
+                            bodiesToEstimate.at( partialIterator.first.first ), currentStatePartials,
+                            testParameter, parameterPartial ) );
+        }
+        else
+        {
+            partialsMap.at( partialIterator.first.first ).push_back(
+                        std::make_shared< ConstantTestStateDerivativePartial >(
+                            bodiesToEstimate.at( partialIterator.first.first ), currentStatePartials ) );
+        }
+    }
+
+    std::map< IntegratedStateType, orbit_determination::StateDerivativePartialsMap > stateDerivativePartials;
+    stateDerivativePartials[ translational_state ] = partialsMap;
+    std::map< IntegratedStateType, int > stateTypeStartIndices;
+    stateTypeStartIndices[ translational_state ] = 0;
+
+    VariationalEquations variationalEquations(
+                stateDerivativePartials, parametersToEstimate, stateTypeStartIndices );
+
+    // Compute expected variational matrix
+    Eigen::MatrixXd expectedVariationalMatrix = Eigen::MatrixXd::Zero( 18, 18 );
+    for( int i = 0; i < 3; i++ )
+    {
+        expectedVariationalMatrix.block( 6 * i, 6 * i + 3, 3, 3 ).setIdentity( );
+    }
+    for( auto partialIterator : statePartials )
+    {
+        expectedVariationalMatrix.block( 6 * partialIterator.first.first + 3, 6 * partialIterator.first.second, 3, 6 ) +=
+                partialIterator.second;
+    }
+    expectedVariationalMatrix.block( 0, 6, 18, 3 ) += expectedVariationalMatrix.block( 0, 0, 18, 3 );
+    expectedVariationalMatrix.block( 0, 6, 18, 3 ) += expectedVariationalMatrix.block( 0, 12, 18, 3 );
+
+    // Check sparsity structure: position rows are identity rows, Earth acceleration is independent of vehicle state
+    std::vector< std::array< int, 3 > > identityRowBlocks = variationalEquations.getIdentityRowBlocks( );
+    BOOST_CHECK_EQUAL( identityRowBlocks.size( ), 3 );
+    for( unsigned int i = 0; i < identityRowBlocks.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( identityRowBlocks.at( i )[ 0 ], 6 * i );
+        BOOST_CHECK_EQUAL( identityRowBlocks.at( i )[ 1 ], 6 * i + 3 );
+        BOOST_CHECK_EQUAL( identityRowBlocks.at( i )[ 2 ], 3 );
+    }
+    std::vector< std::pair< std::pair< int, int >, std::vector< std::pair< int, int > > > > sparseRowBlocks =
+            variationalEquations.getSparseRowBlocks( );
+    BOOST_CHECK_EQUAL( sparseRowBlocks.size( ), 3 );
+    BOOST_CHECK_EQUAL( sparseRowBlocks.at( 1 ).first.first, 9 );
+    BOOST_CHECK_EQUAL( sparseRowBlocks.at( 1 ).first.second, 3 );
+    BOOST_CHECK_EQUAL( sparseRowBlocks.at( 1 ).second.size( ), 1 );
+    BOOST_CHECK_EQUAL( sparseRowBlocks.at( 1 ).second.at( 0 ).first, 0 );
+    BOOST_CHECK_EQUAL( sparseRowBlocks.at( 1 ).second.at( 0 ).second, 12 );
+
+    // Evaluate variational equations twice (to check resetting of matrices), and compare to dense product
+    std::unordered_map< IntegratedStateType, Eigen::VectorXd > currentStates;
+    currentStates[ translational_state ] = Eigen::VectorXd::Zero( 18 );
+    Eigen::MatrixXd stateTransitionAndSensitivityMatrix = Eigen::MatrixXd::Random( 18, 19 );
+    Eigen::MatrixXd variationalEquationsDerivative = Eigen::MatrixXd::Constant( 18, 19, TUDAT_NAN );
+    for( int i = 0; i < 2; i++ )
+    {
+        variationalEquations.updatePartials< double >( 0.0, currentStates );
+        variationalEquations.evaluateVariationalEquations< double >(
+                    0.0, stateTransitionAndSensitivityMatrix, variationalEquationsDerivative.block( 0, 0, 18, 19 ) );
+    }
+
+    Eigen::MatrixXd expectedDerivative = expectedVariationalMatrix * stateTransitionAndSensitivityMatrix;
+    expectedDerivative.block( 15, 18, 3, 1 ) += parameterPartial;
+
+    BOOST_CHECK_SMALL( ( variationalEquations.getVariationalMatrix( ) - expectedVariationalMatrix ).cwiseAbs( ).maxCoeff( ),
+                       1.0E-15 );
+    BOOST_CHECK_SMALL( ( variationalEquationsDerivative - expectedDerivative ).cwiseAbs( ).maxCoeff( ), 1.0E-14 );
+    for( int i = 0; i < 3; i++ )
+    {
+        BOOST_CHECK_EQUAL( ( variationalEquationsDerivative.block( 6 * i, 0, 3, 19 ) -
+                             stateTransitionAndSensitivityMatrix.block( 6 * i + 3, 0, 3, 19 ) ).cwiseAbs( ).maxCoeff( ), 0.0 );
+    }
+}
+
+//! Test the evaluation of the variational equations, using the sparsity of the variational matrix, against a dense product,
+//! for coupled translational-rotational dynamics
+BOOST_AUTO_TEST_CASE( testSparseCoupledVariationalEquationEvaluation )
+{
+    // Estimate translational states of vehicle w.r.t. Earth and Earth w.r.t. barycenter, and rotational state of vehicle
+    Eigen::Matrix3d inertiaTensor;
+    inertiaTensor << 1500.0, -20.0, 35.0,
+            -20.0, 2200.0, 10.0,
+            35.0, 10.0, 2700.0;
+    Eigen::VectorXd rotationalState = Eigen::VectorXd::Zero( 7 );
+    rotationalState.segment( 0, 4 ) = Eigen::Vector4d( 0.3, -0.5, 0.2, 0.7 ).normalized( );
+    rotationalState.segment( 4, 3 ) = Eigen::Vector3d( 1.0E-3, -2.0E-3, 5.0E-3 );
+
+    std::vector< std::shared_ptr< EstimatableParameter< Eigen::VectorXd > > > initialStateParameters;
+    initialStateParameters.push_back( std::make_shared< InitialTranslationalStateParameter< double > >(
+                                          "Earth", Eigen::VectorXd::Zero( 6 ), "SSB" ) );
+    initialStateParameters.push_back( std::make_shared< InitialTranslationalStateParameter< double > >(
+                                          "Vehicle", Eigen::VectorXd::Zero( 6 ), "Earth" ) );
+    initialStateParameters.push_back( std::make_shared< InitialRotationalStateParameter< double > >(
+                                          "Vehicle", rotationalState, [ = ]( ){ return inertiaTensor; } ) );
+    std::shared_ptr< EstimatableParameter< double > > testParameter = std::make_shared< TestDoubleParameter >( );
+    std::shared_ptr< EstimatableParameterSet< double > > parametersToEstimate =
+            std::make_shared< EstimatableParameterSet< double > >(
+                std::vector< std::shared_ptr< EstimatableParameter< double > > >( { testParameter } ),
+                std::vector< std::shared_ptr< EstimatableParameter< Eigen::VectorXd > > >( ), initialStateParameters );
+
+    // Define partials: Earth acceleration depends on Earth state only, vehicle acceleration depends on Earth state and on
+    // vehicle translational and rotational state, vehicle angular acceleration depends on vehicle translational and
+    // rotational state, and on test parameter
+    Eigen::MatrixXd earthPartial = Eigen::MatrixXd::Random( 3, 6 );
+    Eigen::MatrixXd vehicleWrtEarthPartial = Eigen::MatrixXd::Random( 3, 6 );
+    Eigen::MatrixXd vehicleWrtVehiclePartial = Eigen::MatrixXd::Random( 3, 6 );
+    Eigen::MatrixXd vehicleWrtRotationPartial = Eigen::MatrixXd::Random( 3, 7 );
+    Eigen::MatrixXd rotationWrtRotationPartial = Eigen::MatrixXd::Random( 3, 7 );
+    Eigen::MatrixXd rotationWrtVehiclePartial = Eigen::MatrixXd::Random( 3, 6 );
+    Eigen::MatrixXd parameterPartial = Eigen::MatrixXd::Random( 3, 1 );
+
+    std::map< std::pair< std::string, IntegratedStateType >, Eigen::MatrixXd > currentStatePartials;
+    orbit_determination::StateDerivativePartialsMap translationalPartialsMap;
+    translationalPartialsMap.resize( 2 );
+    currentStatePartials[ std::make_pair( "Earth", translational_state ) ] = earthPartial;
+    translationalPartialsMap.at( 0 ).push_back(
+                std::make_shared< ConstantTestStateDerivativePartial >( "Earth", currentStatePartials ) );
+
+    currentStatePartials.clear( );
+    currentStatePartials[ std::make_pair( "Earth", translational_state ) ] = vehicleWrtEarthPartial;
+    translationalPartialsMap.at( 1 ).push_back(
+                std::make_shared< ConstantTestStateDerivativePartial >( "Vehicle", currentStatePartials ) );
+    currentStatePartials.clear( );
+    currentStatePartials[ std::make_pair( "Vehicle", translational_state ) ] = vehicleWrtVehiclePartial;
+    currentStatePartials[ std::make_pair( "Vehicle", rotational_state ) ] = vehicleWrtRotationPartial;
+    translationalPartialsMap.at( 1 ).push_back(
+                std::make_shared< ConstantTestStateDerivativePartial >( "Vehicle", currentStatePartials ) );
+
+    currentStatePartials.clear( );
+    currentStatePartials[ std::make_pair( "Vehicle", translational_state ) ] = rotationWrtVehiclePartial;
+    currentStatePartials[ std::make_pair( "Vehicle", rotational_state ) ] = rotationWrtRotationPartial;
+    orbit_determination::StateDerivativePartialsMap rotationalPartialsMap;
+    rotationalPartialsMap.resize( 1 );
+    rotationalPartialsMap.at( 0 ).push_back(
+                std::make_shared< ConstantTestStateDerivativePartial >(
+                    "Vehicle", currentStatePartials, testParameter, parameterPartial, rotational_state ) );
+
+    std::map< IntegratedStateType, orbit_determination::StateDerivativePartialsMap > stateDerivativePartials;
+    stateDerivativePartials[ translational_state ] = translationalPartialsMap;
+    stateDerivativePartials[ rotational_state ] = rotationalPartialsMap;
+    std::map< IntegratedStateType, int > stateTypeStartIndices;
+    stateTypeStartIndices[ translational_state ] = 0;
+    stateTypeStartIndices[ rotational_state ] = 12;
+
+    VariationalEquations variationalEquations(
+                stateDerivativePartials, parametersToEstimate, stateTypeStartIndices );
+
+    // Compute expected variational matrix: kinematic blocks, partials, addition of vehicle position partials to Earth
+    // position partials (vehicle estimated w.r.t. Earth), and scaling of angular acceleration rows by inverse inertia tensor
+    Eigen::MatrixXd expectedVariationalMatrix = Eigen::MatrixXd::Zero( 19, 19 );
+    expectedVariationalMatrix.block( 0, 3, 3, 3 ).setIdentity( );
+    expectedVariationalMatrix.block( 6, 9, 3, 3 ).setIdentity( );
+    expectedVariationalMatrix.block( 12, 12, 4, 4 ) =
+            getQuaterionToQuaternionRateMatrix( rotationalState.segment( 4, 3 ) );
+    expectedVariationalMatrix.block( 12, 16, 4, 3 ) =
+            getAngularVelocityToQuaternionRateMatrix( rotationalState.segment( 0, 4 ) );
+    expectedVariationalMatrix.block( 3, 0, 3, 6 ) += earthPartial;
+    expectedVariationalMatrix.block( 9, 0, 3, 6 ) += vehicleWrtEarthPartial;
+    expectedVariationalMatrix.block( 9, 6, 3, 6 ) += vehicleWrtVehiclePartial;
+    expectedVariationalMatrix.block( 9, 12, 3, 7 ) += vehicleWrtRotationPartial;
+    expectedVariationalMatrix.block( 16, 6, 3, 6 ) += rotationWrtVehiclePartial;
+    expectedVariationalMatrix.block( 16, 12, 3, 7 ) += rotationWrtRotationPartial;
+    expectedVariationalMatrix.block( 0, 0, 19, 3 ) += expectedVariationalMatrix.block( 0, 6, 19, 3 );
+    expectedVariationalMatrix.block( 16, 0, 3, 19 ) =
+            inertiaTensor.inverse( ) * expectedVariationalMatrix.block( 16, 0, 3, 19 );
+
+    // Check sparsity structure: kinematic rows of rotational state, and inertia tensor scaling of angular acceleration rows
+    std::vector< std::array< int, 3 > > identityRowBlocks = variationalEquations.getIdentityRowBlocks( );
+    BOOST_CHECK_EQUAL( identityRowBlocks.size( ), 2 );
+    std::vector< std::pair< std::pair< int, int >, std::vector< std::pair< int, int > > > > sparseRowBlocks =
+            variationalEquations.getSparseRowBlocks( );
+    BOOST_CHECK_EQUAL( sparseRowBlocks.size( ), 4 );
+    if( sparseRowBlocks.size( ) == 4 )
+    {
+        BOOST_CHECK_EQUAL( sparseRowBlocks.at( 2 ).first.first, 12 );
+        BOOST_CHECK_EQUAL( sparseRowBlocks.at( 2 ).first.second, 4 );
+        BOOST_CHECK_EQUAL( sparseRowBlocks.at( 2 ).second.size( ), 1 );
+        BOOST_CHECK_EQUAL( sparseRowBlocks.at( 2 ).second.at( 0 ).first, 12 );
+        BOOST_CHECK_EQUAL( sparseRowBlocks.at( 2 ).second.at( 0 ).second, 7 );
+
+        BOOST_CHECK_EQUAL( sparseRowBlocks.at( 3 ).first.first, 16 );
+        BOOST_CHECK_EQUAL( sparseRowBlocks.at( 3 ).first.second, 3 );
+        BOOST_CHECK_EQUAL( sparseRowBlocks.at( 3 ).second.size( ), 2 );
+        BOOST_CHECK_EQUAL( sparseRowBlocks.at( 3 ).second.at( 0 ).first, 0 );
+        BOOST_CHECK_EQUAL( sparseRowBlocks.at( 3 ).second.at( 0 ).second, 3 );
+        BOOST_CHECK_EQUAL( sparseRowBlocks.at( 3 ).second.at( 1 ).first, 6 );
+        BOOST_CHECK_EQUAL( sparseRowBlocks.at( 3 ).second.at( 1 ).second, 13 );
+    }
+
+    // Evaluate variational equations twice (to check resetting of matrices), and compare to dense product
+    std::unordered_map< IntegratedStateType, Eigen::VectorXd > currentStates;
+    currentStates[ translational_state ] = Eigen::VectorXd::Zero( 12 );
+    currentStates[ rotational_state ] = rotationalState;
+    Eigen::MatrixXd stateTransitionAndSensitivityMatrix = Eigen::MatrixXd::Random( 19, 20 );
+    Eigen::MatrixXd variationalEquationsDerivative = Eigen::MatrixXd::Constant( 19, 20, TUDAT_NAN );
+    for( int i = 0; i < 2; i++ )
+    {
+        variationalEquations.updatePartials< double >( 0.0, currentStates );
+        variationalEquations.evaluateVariationalEquations< double >(
+                    0.0, stateTransitionAndSensitivityMatrix, variationalEquationsDerivative.block( 0, 0, 19, 20 ) );
+    }
+
+    Eigen::MatrixXd expectedDerivative = expectedVariationalMatrix * stateTransitionAndSensitivityMatrix;
+    expectedDerivative.block( 16, 19, 3, 1 ) += inertiaTensor.inverse( ) * parameterPartial;
+
+    BOOST_CHECK_SMALL( ( variationalEquations.getVariationalMatrix( ) - expectedVariationalMatrix ).cwiseAbs( ).maxCoeff( ),
+                       1.0E-15 );
+    BOOST_CHECK_SMALL( ( variationalEquationsDerivative - expectedDerivative ).cwiseAbs( ).maxCoeff( ), 1.0E-14 );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 }
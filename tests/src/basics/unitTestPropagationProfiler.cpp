@@ -0,0 +1,94 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <tudat/basics/propagationProfiler.h>
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace utilities;
+
+BOOST_AUTO_TEST_SUITE( test_propagation_profiler )
+
+//! Test registration of scopes, accumulation of calls and folded stack output
+BOOST_AUTO_TEST_CASE( testPropagationProfiler )
+{
+    PropagationProfiler profiler;
+
+    // Register scopes, and check that special characters are removed and existing scopes are reused
+    int rootScope = profiler.addScope( "state_derivative" );
+    int environmentScope = profiler.addScope( "environment update", rootScope );
+    int accelerationScope = profiler.addScope( "central_gravity:Earth->Vehicle;1", rootScope );
+    BOOST_CHECK_EQUAL( profiler.addScope( "environment_update", rootScope ), environmentScope );
+    BOOST_CHECK_EQUAL( profiler.getNumberOfScopes( ), 3 );
+    BOOST_CHECK_EQUAL( profiler.getScopePath( environmentScope ), "state_derivative;environment_update" );
+    BOOST_CHECK_EQUAL( profiler.getScopePath( accelerationScope ), "state_derivative;central_gravity:Earth->Vehicle_1" );
+    BOOST_CHECK_THROW( profiler.addScope( "invalid", 3 ), std::runtime_error );
+
+    // Add calls
+    profiler.addCall( rootScope, 1.0 );
+    profiler.addCall( rootScope, 0.5 );
+    profiler.addCall( environmentScope, 0.25 );
+    profiler.addCall( environmentScope, 0.25 );
+    profiler.addCall( accelerationScope, 0.5 );
+    profiler.addWallTime( accelerationScope, 0.25 );
+
+    std::map< std::string, std::pair< unsigned long, double > > profilingResults = profiler.getProfilingResults( );
+    BOOST_CHECK_EQUAL( profilingResults.size( ), 3 );
+    BOOST_CHECK_EQUAL( profilingResults.at( "state_derivative" ).first, 2 );
+    BOOST_CHECK_EQUAL( profilingResults.at( "state_derivative" ).second, 1.5 );
+    BOOST_CHECK_EQUAL( profilingResults.at( "state_derivative;environment_update" ).first, 2 );
+    BOOST_CHECK_EQUAL( profilingResults.at( "state_derivative;environment_update" ).second, 0.5 );
+    BOOST_CHECK_EQUAL( profilingResults.at( "state_derivative;central_gravity:Earth->Vehicle_1" ).first, 1 );
+    BOOST_CHECK_EQUAL( profilingResults.at( "state_derivative;central_gravity:Earth->Vehicle_1" ).second, 0.75 );
+
+    // Check folded stacks (self time in microseconds)
+    std::ostringstream foldedStacks;
+    profiler.writeFoldedStacks( foldedStacks );
+    BOOST_CHECK_EQUAL( foldedStacks.str( ),
+                       "state_derivative 250000\n"
+                       "state_derivative;environment_update 500000\n"
+                       "state_derivative;central_gravity:Earth->Vehicle_1 750000\n" );
+
+    // Check timing of scope, and that no timing is done without profiler
+    {
+        ProfiledScope timedScope( &profiler, environmentScope );
+        ProfiledScope untimedScope( nullptr, environmentScope );
+    }
+    BOOST_CHECK_EQUAL( profiler.getProfilingResults( ).at( "state_derivative;environment_update" ).first, 3 );
+    BOOST_CHECK( profiler.getProfilingResults( ).at( "state_derivative;environment_update" ).second >= 0.5 );
+
+    // Check reset
+    profiler.resetStatistics( );
+    profilingResults = profiler.getProfilingResults( );
+    BOOST_CHECK_EQUAL( profilingResults.size( ), 3 );
+    for( auto it : profilingResults )
+    {
+        BOOST_CHECK_EQUAL( it.second.first, 0 );
+        BOOST_CHECK_EQUAL( it.second.second, 0.0 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -492,6 +492,52 @@ BOOST_AUTO_TEST_CASE( testSpiceWrappers_7 )
     BOOST_CHECK_EQUAL( spiceKernelsLoaded, 0 );
 }
 
+// Test 8: Evaluating states at a list of times.
+BOOST_AUTO_TEST_CASE( testSpiceWrappers_8 )
+{
+    using namespace spice_interface;
+    using namespace ephemerides;
+
+    spice_interface::loadStandardSpiceKernels( );
+
+    std::vector< double > ephemerisTimes;
+    for( int i = 0; i < 50; i++ )
+    {
+        ephemerisTimes.push_back( 1.0E6 * static_cast< double >( i ) );
+    }
+
+    // Check interface function against single-epoch function.
+    Eigen::Matrix< double, 6, Eigen::Dynamic > batchStates;
+    getBodyCartesianStatesAtEpochs( "Moon", "Earth", "J2000", "NONE", ephemerisTimes, batchStates );
+    BOOST_CHECK_EQUAL( batchStates.cols( ), 50 );
+    for( unsigned int i = 0; i < ephemerisTimes.size( ); i++ )
+    {
+        Eigen::Vector6d singleState = getBodyCartesianStateAtEpoch(
+                    "Moon", "Earth", "J2000", "NONE", ephemerisTimes.at( i ) );
+        Eigen::Vector6d currentBatchState = batchStates.col( i );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( singleState, currentBatchState, 0.0 );
+    }
+
+    // Check ephemeris (with and without reference day offset) against single-epoch evaluation.
+    for( double referenceDayOffset : { 0.0, 5.0 } )
+    {
+        SpiceEphemeris spiceEphemeris( "Moon", "Earth", false, false, false, "J2000",
+                                       basic_astrodynamics::JULIAN_DAY_ON_J2000 + referenceDayOffset );
+        spiceEphemeris.getCartesianStates( ephemerisTimes, batchStates );
+        for( unsigned int i = 0; i < ephemerisTimes.size( ); i++ )
+        {
+            Eigen::Vector6d singleState = spiceEphemeris.getCartesianState( ephemerisTimes.at( i ) );
+            Eigen::Vector6d currentBatchState = batchStates.col( i );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( singleState, currentBatchState, 1.0E-15 );
+        }
+    }
+
+    // Check that NaN input is detected.
+    ephemerisTimes.push_back( TUDAT_NAN );
+    BOOST_CHECK_THROW( getBodyCartesianStatesAtEpochs( "Moon", "Earth", "J2000", "NONE", ephemerisTimes, batchStates ),
+                       std::invalid_argument );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -0,0 +1,272 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/basicTypedefs.h"
+#include "tudat/basics/testMacros.h"
+#include "tudat/astro/ephemerides/tabulatedEphemeris.h"
+#include "tudat/io/binaryHistoryFile.h"
+#include "tudat/math/interpolators/lagrangeInterpolator.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace input_output;
+
+BOOST_AUTO_TEST_SUITE( test_binary_history_file )
+
+//! Function to create an (arbitrary) state history for testing
+template< typename TimeType, typename ScalarType >
+std::map< TimeType, Eigen::Matrix< ScalarType, 6, 1 > > getTestStateHistory( const int numberOfEpochs )
+{
+    std::map< TimeType, Eigen::Matrix< ScalarType, 6, 1 > > stateHistory;
+    for( int i = 0; i < numberOfEpochs; i++ )
+    {
+        TimeType currentTime = TimeType( 1.0E8 + static_cast< double >( i ) * 60.0 + 1.0 / 3.0 );
+        ScalarType scalarTime = static_cast< ScalarType >( i ) * 60.0;
+        stateHistory[ currentTime ] = ( Eigen::Matrix< ScalarType, 6, 1 >( ) <<
+                                        std::sin( 1.0E-3 * scalarTime ), std::cos( 1.0E-3 * scalarTime ),
+                                        1.0E-3 * scalarTime, std::cos( 2.0E-3 * scalarTime ), 2.0 / 3.0, -1.0 ).finished( );
+    }
+    return stateHistory;
+}
+
+//! Function to get a (unique) name of a temporary file for testing
+std::string getTemporaryTestFileName( const std::string& fileNameModel )
+{
+    return ( boost::filesystem::temp_directory_path( ) / boost::filesystem::unique_path( fileNameModel ) ).string( );
+}
+
+//! Test writing and reading binary history files for all combinations of data types
+BOOST_AUTO_TEST_CASE( testBinaryHistoryFileDataTypes )
+{
+    std::string fileName = getTemporaryTestFileName( "binaryHistoryFileTest-%%%%-%%%%.dat" );
+    std::vector< std::string > columnNames = { "x", "y", "z", "vx", "vy", "vz" };
+    std::vector< std::string > columnUnits = { "m", "m", "m", "m/s", "m/s", "m/s" };
+
+    // Double time and double values
+    {
+        std::map< double, Eigen::Vector6d > stateHistory = getTestStateHistory< double, double >( 2500 );
+        writeHistoryToBinaryFile( stateHistory, fileName, columnNames, columnUnits );
+
+        BinaryHistoryFileReader fileReader( fileName );
+        BOOST_CHECK_EQUAL( fileReader.getNumberOfEpochs( ), 2500 );
+        BOOST_CHECK_EQUAL( fileReader.getNumberOfColumns( ), 6 );
+        BOOST_CHECK_EQUAL( fileReader.getHeader( ).timeDataType, double_history_data );
+        BOOST_CHECK_EQUAL( fileReader.getHeader( ).valueDataType, double_history_data );
+        for( unsigned int i = 0; i < columnNames.size( ); i++ )
+        {
+            BOOST_CHECK_EQUAL( fileReader.getHeader( ).columnNames.at( i ), columnNames.at( i ) );
+            BOOST_CHECK_EQUAL( fileReader.getHeader( ).columnUnits.at( i ), columnUnits.at( i ) );
+        }
+
+        // Check values at epochs, and time history of columns
+        int epochIndex = 0;
+        for( auto stateIterator : stateHistory )
+        {
+            BOOST_CHECK_EQUAL( fileReader.getTime< double >( epochIndex ), stateIterator.first );
+            Eigen::VectorXd currentValues = fileReader.getValues< double >( epochIndex );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( currentValues, stateIterator.second, 0.0 );
+            for( unsigned int j = 0; j < 6; j++ )
+            {
+                BOOST_CHECK_EQUAL( fileReader.getColumn< double >( j )( epochIndex ), stateIterator.second( j ) );
+            }
+            epochIndex++;
+        }
+
+        std::map< double, Eigen::Vector6d > readStateHistory = fileReader.getHistory< double, Eigen::Vector6d >( );
+        BOOST_CHECK( readStateHistory == stateHistory );
+
+        // Check that incorrect requests are detected
+        BOOST_CHECK_THROW( fileReader.getValues< long double >( 0 ), std::runtime_error );
+        BOOST_CHECK_THROW( fileReader.getValues< double >( 2500 ), std::runtime_error );
+        BOOST_CHECK_THROW( fileReader.getColumn< double >( 6 ), std::runtime_error );
+        BOOST_CHECK_THROW( ( fileReader.getHistory< double, Eigen::Vector3d >( ) ), std::runtime_error );
+    }
+
+    // Time time and long double values
+    {
+        std::map< Time, Eigen::Matrix< long double, 6, 1 > > stateHistory = getTestStateHistory< Time, long double >( 100 );
+        writeHistoryToBinaryFile( stateHistory, fileName );
+
+        BinaryHistoryFileReader fileReader( fileName );
+        BOOST_CHECK_EQUAL( fileReader.getNumberOfEpochs( ), 100 );
+        BOOST_CHECK_EQUAL( fileReader.getHeader( ).timeDataType, tudat_time_history_data );
+        BOOST_CHECK_EQUAL( fileReader.getHeader( ).valueDataType, long_double_history_data );
+        BOOST_CHECK_EQUAL( fileReader.getHeader( ).columnNames.at( 0 ), "" );
+
+        std::map< Time, Eigen::Matrix< long double, 6, 1 > > readStateHistory =
+                fileReader.getHistory< Time, Eigen::Matrix< long double, 6, 1 > >( );
+        BOOST_CHECK_EQUAL( readStateHistory.size( ), stateHistory.size( ) );
+        auto readStateIterator = readStateHistory.begin( );
+        for( auto stateIterator : stateHistory )
+        {
+            BOOST_CHECK( readStateIterator->first == stateIterator.first );
+            BOOST_CHECK( readStateIterator->second == stateIterator.second );
+            readStateIterator++;
+        }
+
+        // Check conversion of times and values to double precision
+        std::vector< double > doubleTimes;
+        std::vector< Eigen::VectorXd > doubleStates;
+        fileReader.getHistoryVectors( doubleTimes, doubleStates );
+        BOOST_CHECK_EQUAL( doubleTimes.at( 10 ), static_cast< double >( std::next( stateHistory.begin( ), 10 )->first ) );
+        BOOST_CHECK_EQUAL( doubleStates.at( 10 )( 4 ),
+                           static_cast< double >( std::next( stateHistory.begin( ), 10 )->second( 4 ) ) );
+    }
+
+    // Long double time and double matrix values
+    {
+        std::map< long double, Eigen::Matrix3d > matrixHistory;
+        for( int i = 0; i < 10; i++ )
+        {
+            matrixHistory[ static_cast< long double >( i ) / 3.0L ] = Eigen::Matrix3d::Random( );
+        }
+        writeHistoryToBinaryFile( matrixHistory, fileName );
+
+        BinaryHistoryFileReader fileReader( fileName );
+        BOOST_CHECK_EQUAL( fileReader.getNumberOfColumns( ), 9 );
+        std::map< long double, Eigen::Matrix3d > readMatrixHistory = fileReader.getHistory< long double, Eigen::Matrix3d >( );
+        BOOST_CHECK( readMatrixHistory == matrixHistory );
+
+        // Check that values at single epoch are stored in column-major order
+        BOOST_CHECK_EQUAL( fileReader.getValues< double >( 3 )( 5 ), std::next( matrixHistory.begin( ), 3 )->second( 2, 1 ) );
+    }
+
+    boost::filesystem::remove( fileName );
+}
+
+//! Test streaming output to a binary history file, and use of the file as input to an interpolator
+BOOST_AUTO_TEST_CASE( testBinaryHistoryFileStreaming )
+{
+    std::string fileName = getTemporaryTestFileName( "binaryHistoryFileStreamingTest-%%%%-%%%%.dat" );
+    std::map< double, Eigen::Vector6d > stateHistory = getTestStateHistory< double, double >( 1000 );
+
+    // Write history one epoch at a time, with small buffer, and check that file is readable during writing
+    {
+        BinaryHistoryFileWriter< double, double > fileWriter( fileName, 6, { }, { }, 64 );
+        int epochIndex = 0;
+        for( auto stateIterator : stateHistory )
+        {
+            fileWriter.writeEpoch( stateIterator.first, stateIterator.second );
+            epochIndex++;
+            if( epochIndex == 100 )
+            {
+                BOOST_CHECK_EQUAL( fileWriter.getNumberOfEpochs( ), 100 );
+                BinaryHistoryFileReader intermediateFileReader( fileName );
+                BOOST_CHECK_EQUAL( intermediateFileReader.getNumberOfEpochs( ), 64 );
+            }
+        }
+        BOOST_CHECK_THROW( fileWriter.writeEpoch( 0.0, Eigen::Vector3d::Zero( ) ), std::runtime_error );
+    }
+
+    // Append incomplete record, which is to be ignored
+    {
+        std::ofstream fileStream( fileName, std::ios::out | std::ios::binary | std::ios::app );
+        fileStream.write( "incomplete", 10 );
+    }
+
+    {
+        std::shared_ptr< BinaryHistoryFileReader > fileReader = std::make_shared< BinaryHistoryFileReader >( fileName );
+        BOOST_CHECK_EQUAL( fileReader->getNumberOfEpochs( ), 1000 );
+
+        // Check view of values at all epochs
+        auto valueBlock = fileReader->getValueBlock< double >( );
+        BOOST_CHECK_EQUAL( valueBlock.rows( ), 6 );
+        BOOST_CHECK_EQUAL( valueBlock.cols( ), 1000 );
+        BOOST_CHECK_EQUAL( valueBlock( 2, 10 ), std::next( stateHistory.begin( ), 10 )->second( 2 ) );
+        BOOST_CHECK( valueBlock.data( ) == fileReader->getValues< double >( 0 ).data( ) );
+
+        // Create interpolator (reading directly from the mapped file), ephemeris, and interpolator from original history
+        std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > > fileInterpolator =
+                createLagrangeInterpolatorFromBinaryHistoryFile< double, double, 6 >( fileReader, 8 );
+        ephemerides::TabulatedCartesianEphemeris< double, double > fileEphemeris( fileInterpolator );
+        interpolators::LagrangeInterpolator< double, Eigen::Vector6d > mapInterpolator( stateHistory, 8 );
+
+        // Check that interpolator keeps file reader alive, and does not copy the values
+        BOOST_CHECK_EQUAL( fileReader.use_count( ), 2 );
+        BOOST_CHECK_EQUAL( fileInterpolator->getDependentValues( ).size( ), 0 );
+
+        // Compare results
+        for( int i = 0; i < 100; i++ )
+        {
+            double currentTime = 1.0E8 + 1000.0 + 500.0 * static_cast< double >( i );
+            Eigen::Vector6d mapState = mapInterpolator.interpolate( currentTime );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( fileInterpolator->interpolate( currentTime ), mapState, 1.0E-14 );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( fileEphemeris.getCartesianState( currentTime ), mapState, 1.0E-14 );
+        }
+
+        // Check interpolation of subset of columns
+        std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector3d > > velocityInterpolator =
+                createLagrangeInterpolatorFromBinaryHistoryFile< double, double, 3 >( fileReader, 8, 3 );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( velocityInterpolator->interpolate( 1.0E8 + 1234.5 ),
+                                           Eigen::Vector3d( mapInterpolator.interpolate( 1.0E8 + 1234.5 ).segment( 3, 3 ) ),
+                                           1.0E-14 );
+        BOOST_CHECK_THROW( ( createLagrangeInterpolatorFromBinaryHistoryFile< double, double, 6 >( fileReader, 8, 1 ) ),
+                           std::runtime_error );
+        BOOST_CHECK_THROW( ( createLagrangeInterpolatorFromBinaryHistoryFile< double, long double, 6 >( fileReader, 8 ) ),
+                           std::runtime_error );
+    }
+
+    // Write history in reverse order (as for backward propagation), and check interpolator from file
+    {
+        {
+            BinaryHistoryFileWriter< double, double > fileWriter( fileName, 6 );
+            for( auto stateIterator = stateHistory.rbegin( ); stateIterator != stateHistory.rend( ); stateIterator++ )
+            {
+                fileWriter.writeEpoch( stateIterator->first, stateIterator->second );
+            }
+        }
+
+        std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > > fileInterpolator =
+                createLagrangeInterpolatorFromBinaryHistoryFile< double, double, 6 >(
+                    std::make_shared< BinaryHistoryFileReader >( fileName ), 8 );
+        interpolators::LagrangeInterpolator< double, Eigen::Vector6d > mapInterpolator( stateHistory, 8 );
+        for( int i = 0; i < 100; i++ )
+        {
+            double currentTime = 1.0E8 + 1000.0 + 500.0 * static_cast< double >( i );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( fileInterpolator->interpolate( currentTime ),
+                                               mapInterpolator.interpolate( currentTime ), 1.0E-14 );
+        }
+    }
+
+    // Check that invalid files are detected
+    {
+        std::ofstream fileStream( fileName, std::ios::out | std::ios::binary | std::ios::trunc );
+        fileStream << "0.0 1.0 2.0 3.0 4.0 5.0 6.0" << std::endl;
+    }
+    BOOST_CHECK_THROW( BinaryHistoryFileReader invalidFileReader( fileName ), std::runtime_error );
+    BOOST_CHECK_THROW( BinaryHistoryFileReader missingFileReader( "nonExistentBinaryHistoryFile.dat" ), std::runtime_error );
+
+    boost::filesystem::remove( fileName );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,134 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <functional>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/testMacros.h"
+#include "tudat/math/basic/dualNumber.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace automatic_differentiation;
+
+BOOST_AUTO_TEST_SUITE( test_dual_number )
+
+//! Check derivatives of elementary functions against their analytical derivatives
+BOOST_AUTO_TEST_CASE( testDualNumberElementaryFunctions )
+{
+    typedef DualNumber< 1 > Dual;
+
+    std::vector< std::pair< std::function< Dual( const Dual& ) >, std::function< double( const double ) > > >
+            functionsAndDerivatives;
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return sqrt( x ); },
+                                         [ ]( const double x ){ return 0.5 / std::sqrt( x ); } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return cbrt( x ); },
+                                         [ ]( const double x ){ return 1.0 / ( 3.0 * std::pow( x, 2.0 / 3.0 ) ); } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return exp( x ); },
+                                         [ ]( const double x ){ return std::exp( x ); } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return log( x ); },
+                                         [ ]( const double x ){ return 1.0 / x; } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return sin( x ); },
+                                         [ ]( const double x ){ return std::cos( x ); } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return cos( x ); },
+                                         [ ]( const double x ){ return -std::sin( x ); } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return tan( x ); },
+                                         [ ]( const double x ){ return 1.0 / ( std::cos( x ) * std::cos( x ) ); } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return asin( x ); },
+                                         [ ]( const double x ){ return 1.0 / std::sqrt( 1.0 - x * x ); } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return acos( x ); },
+                                         [ ]( const double x ){ return -1.0 / std::sqrt( 1.0 - x * x ); } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return atan( x ); },
+                                         [ ]( const double x ){ return 1.0 / ( 1.0 + x * x ); } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return tanh( x ); },
+                                         [ ]( const double x ){ return 1.0 / ( std::cosh( x ) * std::cosh( x ) ); } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return pow( x, 3.5 ); },
+                                         [ ]( const double x ){ return 3.5 * std::pow( x, 2.5 ); } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return pow( 2.0, x ); },
+                                         [ ]( const double x ){ return std::pow( 2.0, x ) * std::log( 2.0 ); } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return pow( x, x ); },
+                                         [ ]( const double x ){ return std::pow( x, x ) * ( std::log( x ) + 1.0 ); } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return 1.0 / ( x * x ) - 3.0 * x + 2.0; },
+                                         [ ]( const double x ){ return -2.0 / ( x * x * x ) - 3.0; } } );
+    functionsAndDerivatives.push_back( { [ ]( const Dual& x ){ return ( x + 1.0 ) / ( x - 2.0 ); },
+                                         [ ]( const double x ){ return -3.0 / ( ( x - 2.0 ) * ( x - 2.0 ) ); } } );
+
+    for( double testValue : { 0.1, 0.35, 0.8 } )
+    {
+        for( unsigned int i = 0; i < functionsAndDerivatives.size( ); i++ )
+        {
+            Dual result = functionsAndDerivatives.at( i ).first( Dual( testValue, 0 ) );
+            BOOST_CHECK_CLOSE_FRACTION( result.getDerivatives( )( 0 ),
+                                        functionsAndDerivatives.at( i ).second( testValue ),
+                                        4.0 * std::numeric_limits< double >::epsilon( ) );
+        }
+    }
+
+    // Check atan2 and abs, including sign changes
+    for( double angle : { 0.3, 2.0, -1.0, -2.5 } )
+    {
+        Dual x( std::cos( angle ), 0 );
+        Dual y( std::sin( angle ) );
+        Dual result = atan2( y, x );
+        BOOST_CHECK_CLOSE_FRACTION( result.getValue( ), angle, 4.0 * std::numeric_limits< double >::epsilon( ) );
+        BOOST_CHECK_CLOSE_FRACTION( result.getDerivatives( )( 0 ), -std::sin( angle ),
+                                    4.0 * std::numeric_limits< double >::epsilon( ) );
+        BOOST_CHECK_EQUAL( abs( x ).getDerivatives( )( 0 ), ( std::cos( angle ) < 0.0 ) ? -1.0 : 1.0 );
+    }
+}
+
+//! Check Jacobian of a vector function evaluated with Eigen matrices of dual numbers
+BOOST_AUTO_TEST_CASE( testDualNumberJacobian )
+{
+    // Point mass gravity, with position and gravitational parameter as independent variables
+    auto gravityFunction = [ ]( const Eigen::Matrix< DualNumber< 4 >, 4, 1 >& input )
+    {
+        Eigen::Matrix< DualNumber< 4 >, 3, 1 > position = input.segment( 0, 3 );
+        DualNumber< 4 > distance = position.norm( );
+        Eigen::Matrix< DualNumber< 4 >, 3, 1 > acceleration = -input( 3 ) * position / ( distance * distance * distance );
+        return acceleration;
+    };
+
+    Eigen::Vector4d input;
+    input << 7.0E6, -1.2E6, 3.4E5, 3.986004418E14;
+
+    Eigen::Vector3d acceleration;
+    Eigen::Matrix< double, 3, 4 > jacobian;
+    computeValueAndJacobian< 4, 3 >( gravityFunction, input, acceleration, jacobian );
+
+    // Compute analytical value and partials
+    Eigen::Vector3d position = input.segment( 0, 3 );
+    double distance = position.norm( );
+    Eigen::Vector3d expectedAcceleration = -input( 3 ) * position / ( distance * distance * distance );
+    Eigen::Matrix< double, 3, 4 > expectedJacobian;
+    expectedJacobian.block( 0, 0, 3, 3 ) = -input( 3 ) / ( distance * distance * distance ) * (
+                Eigen::Matrix3d::Identity( ) - 3.0 * position * position.transpose( ) / ( distance * distance ) );
+    expectedJacobian.block( 0, 3, 3, 1 ) = -position / ( distance * distance * distance );
+
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( acceleration, expectedAcceleration, 1.0E-15 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( jacobian, expectedJacobian, 1.0E-14 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,190 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/testMacros.h"
+#include "tudat/math/basic/leastSquaresEstimation.h"
+#include "tudat/math/basic/normalEquationsAccumulator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace linear_algebra;
+
+BOOST_AUTO_TEST_SUITE( test_normal_equations )
+
+//! Function to normalize the columns of a matrix, in the same manner as done in the OrbitDeterminationManager
+Eigen::VectorXd normalizeColumns( Eigen::MatrixXd& matrix )
+{
+    Eigen::VectorXd normalizationTerms = Eigen::VectorXd( matrix.cols( ) );
+    for( int i = 0; i < matrix.cols( ); i++ )
+    {
+        double minimum = matrix.col( i ).minCoeff( );
+        double maximum = matrix.col( i ).maxCoeff( );
+        normalizationTerms( i ) = ( std::fabs( minimum ) > maximum ) ? minimum : maximum;
+        if( normalizationTerms( i ) == 0.0 )
+        {
+            normalizationTerms( i ) = 1.0;
+        }
+        matrix.col( i ) /= normalizationTerms( i );
+    }
+    return normalizationTerms;
+}
+
+// Check accumulation of normal equations per block of observations against solution from full information matrix
+BOOST_AUTO_TEST_CASE( testDenseNormalEquationsAccumulation )
+{
+    std::srand( 1 );
+    const int numberOfObservations = 300;
+    const int numberOfParameters = 8;
+
+    Eigen::MatrixXd informationMatrix = Eigen::MatrixXd::Random( numberOfObservations, numberOfParameters );
+    informationMatrix.col( 3 ) *= 1.0E4;
+    informationMatrix.col( 5 ) *= 1.0E-3;
+    Eigen::VectorXd residuals = Eigen::VectorXd::Random( numberOfObservations );
+    Eigen::VectorXd weights = Eigen::VectorXd::Random( numberOfObservations ).cwiseAbs( ) +
+            Eigen::VectorXd::Constant( numberOfObservations, 0.1 );
+    Eigen::MatrixXd inverseAPrioriCovariance = Eigen::MatrixXd::Zero( numberOfParameters, numberOfParameters );
+    inverseAPrioriCovariance.diagonal( ) = Eigen::VectorXd::Constant( numberOfParameters, 0.5 );
+
+    // Accumulate normal equations in blocks of unequal size
+    NormalEquationsAccumulator normalEquations( numberOfParameters );
+    std::vector< int > blockBoundaries = { 0, 1, 57, 200, numberOfObservations };
+    for( unsigned int i = 0; i < blockBoundaries.size( ) - 1; i++ )
+    {
+        int blockSize = blockBoundaries.at( i + 1 ) - blockBoundaries.at( i );
+        normalEquations.addObservations(
+                    informationMatrix.block( blockBoundaries.at( i ), 0, blockSize, numberOfParameters ),
+                    residuals.segment( blockBoundaries.at( i ), blockSize ),
+                    weights.segment( blockBoundaries.at( i ), blockSize ) );
+    }
+    BOOST_CHECK_EQUAL( normalEquations.getNumberOfObservations( ), numberOfObservations );
+
+    // Check normalization
+    Eigen::MatrixXd normalizedInformationMatrix = informationMatrix;
+    Eigen::VectorXd expectedNormalization = normalizeColumns( normalizedInformationMatrix );
+    Eigen::VectorXd normalization = normalEquations.getParameterNormalization( );
+    for( int i = 0; i < numberOfParameters; i++ )
+    {
+        BOOST_CHECK_EQUAL( normalization( i ), expectedNormalization( i ) );
+    }
+
+    // Check normal equations
+    Eigen::MatrixXd normalMatrix;
+    Eigen::VectorXd normalRightHandSide;
+    normalEquations.getNormalEquations( normalMatrix, normalRightHandSide, normalization );
+    Eigen::MatrixXd expectedNormalMatrix = calculateInverseOfUpdatedCovarianceMatrix(
+                normalizedInformationMatrix, weights );
+    Eigen::VectorXd expectedNormalRightHandSide =
+            normalizedInformationMatrix.transpose( ) * weights.cwiseProduct( residuals );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedNormalMatrix, normalMatrix, 1.0E-12 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedNormalRightHandSide, normalRightHandSide, 1.0E-12 );
+
+    // Check solution for each decomposition
+    std::pair< Eigen::VectorXd, Eigen::MatrixXd > expectedSolution = performLeastSquaresAdjustmentFromInformationMatrix(
+                normalizedInformationMatrix, residuals, weights, inverseAPrioriCovariance );
+    for( unsigned int method = 0; method < 3; method++ )
+    {
+        std::pair< Eigen::VectorXd, Eigen::MatrixXd > solution = normalEquations.performLeastSquaresAdjustment(
+                    normalization, inverseAPrioriCovariance, static_cast< NormalEquationsSolutionMethod >( method ) );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedSolution.first, solution.first, 1.0E-10 );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedSolution.second, solution.second, 1.0E-12 );
+
+        std::pair< Eigen::VectorXd, Eigen::MatrixXd > fullSolution = performLeastSquaresAdjustmentFromInformationMatrix(
+                    normalizedInformationMatrix, residuals, weights, inverseAPrioriCovariance, 1, 1.0E8,
+                    Eigen::MatrixXd( 0, 0 ), Eigen::VectorXd( 0 ), static_cast< NormalEquationsSolutionMethod >( method ) );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedSolution.first, fullSolution.first, 1.0E-10 );
+    }
+}
+
+// Check reduction of local parameters from normal equations (Schur complement) against full solution
+BOOST_AUTO_TEST_CASE( testLocalParameterReduction )
+{
+    std::srand( 2 );
+    const int numberOfLocalSets = 4;
+    const int observationsPerSet = 40;
+    const int numberOfGlobalObservations = 10;
+    const int numberOfParameters = 3 + 3 * numberOfLocalSets;
+
+    // Define local parameter sets: parameters 3-14, with each set consisting of two separate blocks
+    std::vector< std::vector< std::pair< int, int > > > localParameterBlocks;
+    for( int i = 0; i < numberOfLocalSets; i++ )
+    {
+        localParameterBlocks.push_back(
+        { std::make_pair( 3 + 2 * i, 2 ), std::make_pair( 3 + 2 * numberOfLocalSets + i, 1 ) } );
+    }
+
+    // Create information matrix with observations depending on global parameters, and (at most) one set of local parameters
+    const int numberOfObservations = numberOfLocalSets * observationsPerSet + numberOfGlobalObservations;
+    Eigen::MatrixXd informationMatrix = Eigen::MatrixXd::Zero( numberOfObservations, numberOfParameters );
+    informationMatrix.leftCols( 3 ) = Eigen::MatrixXd::Random( numberOfObservations, 3 );
+    for( int i = 0; i < numberOfLocalSets; i++ )
+    {
+        for( unsigned int j = 0; j < localParameterBlocks.at( i ).size( ); j++ )
+        {
+            informationMatrix.block( i * observationsPerSet, localParameterBlocks.at( i ).at( j ).first,
+                                     observationsPerSet, localParameterBlocks.at( i ).at( j ).second ) =
+                    1.0E3 * Eigen::MatrixXd::Random( observationsPerSet, localParameterBlocks.at( i ).at( j ).second );
+        }
+    }
+    Eigen::VectorXd residuals = Eigen::VectorXd::Random( numberOfObservations );
+    Eigen::VectorXd weights = Eigen::VectorXd::Constant( numberOfObservations, 4.0 );
+    Eigen::MatrixXd inverseAPrioriCovariance = Eigen::MatrixXd::Zero( numberOfParameters, numberOfParameters );
+    inverseAPrioriCovariance.diagonal( ) = Eigen::VectorXd::Constant( numberOfParameters, 0.1 );
+    inverseAPrioriCovariance( 0, 4 ) = inverseAPrioriCovariance( 4, 0 ) = 0.01;
+
+    NormalEquationsAccumulator normalEquations( numberOfParameters, localParameterBlocks );
+    BOOST_CHECK_EQUAL( normalEquations.getNumberOfLocalParameterSets( ), numberOfLocalSets );
+    normalEquations.addObservations( informationMatrix.topRows( 70 ), residuals.head( 70 ), weights.head( 70 ) );
+    normalEquations.addObservations( informationMatrix.bottomRows( numberOfObservations - 70 ),
+                                     residuals.tail( numberOfObservations - 70 ),
+                                     weights.tail( numberOfObservations - 70 ) );
+
+    Eigen::MatrixXd normalizedInformationMatrix = informationMatrix;
+    Eigen::VectorXd normalization = normalizeColumns( normalizedInformationMatrix );
+
+    std::pair< Eigen::VectorXd, Eigen::MatrixXd > expectedSolution = performLeastSquaresAdjustmentFromInformationMatrix(
+                normalizedInformationMatrix, residuals, weights, inverseAPrioriCovariance );
+    for( unsigned int method = 0; method < 3; method++ )
+    {
+        std::pair< Eigen::VectorXd, Eigen::MatrixXd > solution = normalEquations.performLeastSquaresAdjustment(
+                    normalEquations.getParameterNormalization( ), inverseAPrioriCovariance,
+                    static_cast< NormalEquationsSolutionMethod >( method ) );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedSolution.first, solution.first, 1.0E-10 );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedSolution.second, solution.second, 1.0E-12 );
+    }
+
+    // Check that observation depending on two sets of local parameters is rejected
+    Eigen::MatrixXd invalidPartials = Eigen::MatrixXd::Zero( 1, numberOfParameters );
+    invalidPartials( 0, 3 ) = 1.0;
+    invalidPartials( 0, 5 ) = 1.0;
+    BOOST_CHECK_THROW( normalEquations.addObservations(
+                           invalidPartials, Eigen::VectorXd::Zero( 1 ), Eigen::VectorXd::Ones( 1 ) ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
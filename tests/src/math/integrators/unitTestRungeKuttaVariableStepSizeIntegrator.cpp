@@ -35,9 +35,13 @@
 #include "tudat/basics/testMacros.h"
 #include "tudat/math/integrators/numericalIntegratorTestFunctions.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <limits>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 namespace tudat
 {
@@ -314,6 +318,166 @@ BOOST_AUTO_TEST_CASE( testVariableStepIntegrateToFunction )
     BOOST_CHECK_CLOSE_FRACTION( fixedStepIntegratedValue.x( ), integratedValue.x( ), 1.0E-10 );
 }
 
+//! Function to compute the state derivative of a harmonic oscillator (x'' = -x), counting the number of evaluations
+Eigen::VectorXd computeHarmonicOscillatorStateDerivative(
+        const double time, const Eigen::VectorXd& state, int& numberOfEvaluations )
+{
+    numberOfEvaluations++;
+    return ( Eigen::VectorXd( 2 ) << state( 1 ), -state( 0 ) ).finished( );
+}
+
+//! Function to compute the analytical solution of the harmonic oscillator (x'' = -x), from a given initial state
+Eigen::VectorXd computeHarmonicOscillatorSolution(
+        const double initialTime, const Eigen::VectorXd& initialState, const double time )
+{
+    const double timeSinceInitialTime = time - initialTime;
+    return ( Eigen::VectorXd( 2 ) <<
+             initialState( 0 ) * std::cos( timeSinceInitialTime ) + initialState( 1 ) * std::sin( timeSinceInitialTime ),
+             -initialState( 0 ) * std::sin( timeSinceInitialTime ) + initialState( 1 ) * std::cos( timeSinceInitialTime ) ).finished( );
+}
+
+//! Test dense output of the variable step-size integrator.
+BOOST_AUTO_TEST_CASE( testDenseOutput )
+{
+    using namespace numerical_integrators;
+
+    std::vector< RungeKuttaCoefficients::CoefficientSets > coefficientSets =
+    { RungeKuttaCoefficients::rungeKuttaFehlberg45, RungeKuttaCoefficients::rungeKuttaFehlberg56,
+      RungeKuttaCoefficients::rungeKuttaFehlberg78, RungeKuttaCoefficients::rungeKutta87DormandPrince };
+
+    const Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << 1.0, 0.0 ).finished( );
+    for( unsigned int i = 0; i < coefficientSets.size( ); i++ )
+    {
+        const RungeKuttaCoefficients& coefficients = RungeKuttaCoefficients::get( coefficientSets.at( i ) );
+        int numberOfEvaluations = 0;
+        std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+                std::bind( &computeHarmonicOscillatorStateDerivative, std::placeholders::_1, std::placeholders::_2,
+                           std::ref( numberOfEvaluations ) );
+
+        // Check order of dense output: maximum error within a single step of fixed size (w.r.t. the analytical
+        // solution) should decrease by a factor 2^( q + 1 ) when halving the step size, for dense output of order q.
+        std::vector< double > maximumDenseOutputErrors;
+        for( double stepSize = 1.0; stepSize > 0.2; stepSize /= 2.0 )
+        {
+            RungeKuttaVariableStepSizeIntegratorXd integrator(
+                        coefficients, stateDerivativeFunction, 0.0, initialState, 1.0E-6, 10.0,
+                        Eigen::VectorXd::Constant( 2, 1.0E-10 ), Eigen::VectorXd::Constant( 2, 1.0E-10 ) );
+            integrator.setStepSizeControl( false );
+            integrator.setUseDenseOutput( true );
+            integrator.performIntegrationStep( stepSize );
+
+            double maximumDenseOutputError = 0.0;
+            for( int j = 1; j < 10; j++ )
+            {
+                double currentTime = stepSize * static_cast< double >( j ) / 10.0;
+                maximumDenseOutputError = std::max(
+                            maximumDenseOutputError,
+                            ( integrator.getDenseOutputState( currentTime ) -
+                              computeHarmonicOscillatorSolution( 0.0, initialState, currentTime ) ).cwiseAbs( ).maxCoeff( ) );
+            }
+            maximumDenseOutputErrors.push_back( maximumDenseOutputError );
+        }
+        const double expectedErrorRatio = std::pow( 2.0, coefficients.denseOutputOrder + 1 );
+        for( unsigned int j = 1; j < maximumDenseOutputErrors.size( ); j++ )
+        {
+            double errorRatio = maximumDenseOutputErrors.at( j - 1 ) / maximumDenseOutputErrors.at( j );
+            BOOST_CHECK( errorRatio > 0.75 * expectedErrorRatio );
+            BOOST_CHECK( errorRatio < 1.5 * expectedErrorRatio );
+        }
+
+        // Check dense output in propagation with step size control, with and without modification of the state after
+        // each step (as done for the switching of attitude representations).
+        const double tolerance = 1.0E-10;
+        for( int modifyState = 0; modifyState < 2; modifyState++ )
+        {
+            std::vector< int > numberOfEvaluationsPerCase = { 0, 0 };
+            std::vector< int > numberOfStepsPerCase = { 0, 0 };
+            std::vector< Eigen::VectorXd > finalStates;
+            for( int useDenseOutput = 0; useDenseOutput < 2; useDenseOutput++ )
+            {
+                numberOfEvaluations = 0;
+                RungeKuttaVariableStepSizeIntegratorXd integrator(
+                            coefficients, stateDerivativeFunction, 0.0, initialState, 1.0E-6, 10.0,
+                            Eigen::VectorXd::Constant( 2, tolerance ), Eigen::VectorXd::Constant( 2, tolerance ) );
+                BOOST_CHECK_THROW( integrator.getDenseOutputState( 0.0 ), std::runtime_error );
+                if( useDenseOutput )
+                {
+                    integrator.setUseDenseOutput( true );
+                    BOOST_CHECK_THROW( integrator.getDenseOutputState( 0.0 ), std::runtime_error );
+                }
+
+                double stepSize = 0.1;
+                while( integrator.getCurrentIndependentVariable( ) < 20.0 )
+                {
+                    Eigen::VectorXd integratedState = integrator.performIntegrationStep( stepSize );
+                    stepSize = integrator.getNextStepSize( );
+                    numberOfStepsPerCase.at( useDenseOutput )++;
+
+                    // Modify state, allowing rollback (reverses the direction of motion, which is again a solution)
+                    if( modifyState )
+                    {
+                        integrator.modifyCurrentState( -integratedState, true );
+                    }
+
+                    // Check dense output within step w.r.t. the solution from the state at the start of the step, which
+                    // is within the tolerance for all steps (including the first ones)
+                    if( useDenseOutput )
+                    {
+                        double stepStart = integrator.getPreviousIndependentVariable( );
+                        double stepEnd = integrator.getCurrentIndependentVariable( );
+                        Eigen::VectorXd stepStartState = integrator.getPreviousState( );
+                        for( int j = 0; j <= 10; j++ )
+                        {
+                            double currentTime = stepStart + ( stepEnd - stepStart ) * static_cast< double >( j ) / 10.0;
+                            Eigen::VectorXd denseOutputState = integrator.getDenseOutputState( currentTime );
+                            BOOST_CHECK_SMALL( ( denseOutputState - computeHarmonicOscillatorSolution(
+                                                     stepStart, stepStartState, currentTime ) ).cwiseAbs( ).maxCoeff( ),
+                                               2.0 * tolerance );
+                        }
+
+                        // Check that dense output reproduces integrated state (before modification) at step boundaries
+                        BOOST_CHECK( integrator.getDenseOutputState( stepStart ) == stepStartState );
+                        BOOST_CHECK( integrator.getDenseOutputState( stepEnd ) == integratedState );
+
+                        // Check that dense output can only be requested in last step
+                        BOOST_CHECK_THROW( integrator.getDenseOutputState( stepEnd + 1.0 ), std::runtime_error );
+                        BOOST_CHECK_THROW( integrator.getDenseOutputState( stepStart - 1.0 ), std::runtime_error );
+                    }
+                }
+                finalStates.push_back( integrator.getCurrentState( ) );
+                numberOfEvaluationsPerCase.at( useDenseOutput ) = numberOfEvaluations;
+
+                // Check that dense output is unavailable after modifying the state without allowing rollback
+                if( useDenseOutput )
+                {
+                    integrator.modifyCurrentState( integrator.getCurrentState( ) );
+                    BOOST_CHECK_THROW( integrator.getDenseOutputState( integrator.getCurrentIndependentVariable( ) ),
+                                       std::runtime_error );
+                }
+            }
+
+            // Check that integration is not affected by dense output
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( finalStates.at( 0 ), finalStates.at( 1 ),
+                                               std::numeric_limits< double >::epsilon( ) );
+            BOOST_CHECK_EQUAL( numberOfStepsPerCase.at( 0 ), numberOfStepsPerCase.at( 1 ) );
+
+            // Check number of additional function evaluations: the state derivative at the end of each step is reused
+            // as the first stage of the next step, unless the state was modified.
+            const int numberOfAdditionalStages = coefficients.denseOutputCCoefficients.rows( );
+            if( modifyState )
+            {
+                BOOST_CHECK_EQUAL( numberOfEvaluationsPerCase.at( 1 ) - numberOfEvaluationsPerCase.at( 0 ),
+                                   numberOfStepsPerCase.at( 1 ) * numberOfAdditionalStages );
+            }
+            else
+            {
+                BOOST_CHECK( numberOfEvaluationsPerCase.at( 1 ) - numberOfEvaluationsPerCase.at( 0 ) <=
+                             numberOfStepsPerCase.at( 1 ) * ( numberOfAdditionalStages - 1 ) + 1 );
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests